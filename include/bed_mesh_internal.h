@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "bed_mesh_rasterizer.h"
 #include "bed_mesh_renderer.h"
+#include "bed_mesh_surface.h"
 
 #include <array>
 #include <vector>
@@ -93,6 +95,18 @@ struct bed_mesh_renderer {
     std::vector<std::vector<int>> projected_screen_x; // [row][col] → screen X coordinate
     std::vector<std::vector<int>> projected_screen_y; // [row][col] → screen Y coordinate
 
+    // ===== Software Surface Rasterizer =====
+    // Mesh quads are rasterized into this canvas-sized ARGB8888 buffer with a
+    // depth buffer, then drawn as one image (see render_mesh_surface())
+    lv_draw_buf_t* surface_buf = nullptr;
+    helix::mesh::SpanRasterizer surface_raster;
+
+    // Bicubic-upsampled surface drawn by the rasterizer in place of the mesh
+    // quads. Heights are resampled only in set_mesh_data() and when the factor
+    // changes; world positions and colors follow generate_mesh_quads()
+    helix::mesh::MeshSurface surface;
+    int upsample_factor = helix::mesh::SURFACE_DEFAULT_UPSAMPLE;
+
     // ===== Adaptive Render Mode (Phase 4) =====
 
     // Render mode control
@@ -11,12 +11,19 @@
  * - Solid color fills
  * - Per-vertex gradient interpolation
  * - Adaptive segment counts for performance optimization
+ * - A depth-buffered span rasterizer that writes straight into an ARGB8888
+ *   draw buffer (SpanRasterizer)
  *
- * Uses LVGL's draw layer API for hardware-accelerated rendering.
+ * The fill_triangle_* functions use LVGL's draw layer API; SpanRasterizer
+ * bypasses it so a whole mesh costs one image draw.
  */
 
 #include <lvgl/lvgl.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace helix {
 namespace mesh {
 
@@ -75,5 +82,88 @@ void fill_triangle_gradient(lv_layer_t* layer, int x1, int y1, lv_color_t c1, in
                             lv_color_t c2, int x3, int y3, lv_color_t c3,
                             lv_opa_t opacity = MESH_TRIANGLE_OPACITY);
 
+// ========== Span Rasterizer ==========
+
+/// Depth of the far plane in a SpanRasterizer depth buffer (cleared value)
+constexpr uint16_t RASTER_DEPTH_FAR = 0xFFFF;
+
+/**
+ * @brief Map a camera depth into the 16-bit depth buffer range
+ *
+ * @param depth Camera-space depth (larger = further away)
+ * @param near_depth Smallest depth in the scene
+ * @param far_depth Largest depth in the scene
+ * @return 0 for near_depth up to RASTER_DEPTH_FAR - 1 for far_depth
+ */
+uint16_t quantize_depth(double depth, double near_depth, double far_depth);
+
+/// Triangle corner for SpanRasterizer
+struct RasterVertex {
+    int x;            ///< Pixel X relative to the target buffer
+    int y;            ///< Pixel Y relative to the target buffer
+    uint16_t depth;   ///< From quantize_depth() (smaller = nearer)
+    lv_color_t color; ///< Interpolated across the triangle (Gouraud)
+};
+
+/**
+ * @brief Scanline triangle rasterizer with a 16-bit depth buffer
+ *
+ * Writes Gouraud-shaded spans directly into an ARGB8888 pixel buffer, so a
+ * mesh can be drawn in any order and handed to LVGL as a single image instead
+ * of one lv_draw_rect per span. Edges and attributes are walked in fixed
+ * point; the per-pixel loops are branch-free so the compiler can vectorize them.
+ *
+ * Pixel centers sit on integer coordinates, with a top-left fill rule: a
+ * pixel on an edge shared by two triangles is drawn by exactly one of them,
+ * so translucent quads split into triangles show no seam.
+ *
+ * @code
+ *   SpanRasterizer raster;
+ *   raster.begin(buf->data, w, h, buf->header.stride, clip);
+ *   raster.fill_triangle(a, b, c, LV_OPA_COVER);  // Opaque: depth test + write
+ *   raster.fill_triangle(d, e, f, LV_OPA_20);     // Translucent: depth test only
+ * @endcode
+ */
+class SpanRasterizer {
+  public:
+    /**
+     * @brief Start a frame on a pixel buffer
+     *
+     * Clears the pixels and depth inside @p clip to transparent and
+     * RASTER_DEPTH_FAR. Pixels outside @p clip are never touched.
+     *
+     * @param pixels First byte of an ARGB8888 buffer (4-byte aligned)
+     * @param width Buffer width in pixels
+     * @param height Buffer height in pixels
+     * @param stride Bytes per row
+     * @param clip Area to draw in, in buffer coordinates (inclusive)
+     */
+    void begin(uint8_t* pixels, int width, int height, int stride, const lv_area_t& clip);
+
+    /**
+     * @brief Fill a triangle (any winding)
+     *
+     * Opaque triangles replace nearer pixels and update the depth buffer.
+     * Translucent ones blend over pixels they are in front of without writing
+     * depth, so draw them after all opaque geometry.
+     */
+    void fill_triangle(const RasterVertex& a, const RasterVertex& b, const RasterVertex& c,
+                       lv_opa_t opacity = MESH_TRIANGLE_OPACITY);
+
+    /// Pixels that passed the depth test since begin()
+    size_t pixels_drawn() const {
+        return pixels_drawn_;
+    }
+
+  private:
+    uint8_t* pixels_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    int stride_ = 0;
+    lv_area_t clip_{0, 0, -1, -1};
+    std::vector<uint16_t> depth_; ///< width_ * height_, row-major
+    size_t pixels_drawn_ = 0;
+};
+
 } // namespace mesh
 } // namespace helix
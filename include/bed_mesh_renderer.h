@@ -462,6 +462,18 @@ double bed_mesh_renderer_get_zero_plane_offset(bed_mesh_renderer_t* renderer);
  */
 void bed_mesh_renderer_set_z_display_offset(bed_mesh_renderer_t* renderer, double offset_mm);
 
+/**
+ * @brief Set how finely the 3D surface is resampled between probe points
+ *
+ * The probe grid is upsampled with bicubic interpolation into factor x factor
+ * sub-cells per probe cell, once per mesh (not per frame). Values are clamped
+ * to 1..8; 1 draws the probe grid as is.
+ *
+ * @param renderer Renderer instance
+ * @param factor Sub-cells per probe cell along each axis (default: 3)
+ */
+void bed_mesh_renderer_set_upsample_factor(bed_mesh_renderer_t* renderer, int factor);
+
 #ifdef __cplusplus
 }
 #endif
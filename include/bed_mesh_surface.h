@@ -0,0 +1,140 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "bed_mesh_renderer.h" // For bed_mesh_view_state_t
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file bed_mesh_surface.h
+ * @brief Cached, bicubic-upsampled bed mesh surface for the span rasterizer
+ *
+ * The probe grid is resampled once per mesh (or upsample factor) change,
+ * placed in world space and colored whenever the renderer regenerates its
+ * quads (bounds, Z scale or color range change), and only projected per
+ * frame. Projection is one affine transform plus a perspective divide per
+ * vertex, run over packed float arrays so the compiler can vectorize it.
+ *
+ * Vertices are row-major: vertex (row, col) is at index row * cols() + col,
+ * and row 0 is mesh row 0 (the front edge).
+ */
+
+namespace helix {
+namespace mesh {
+
+/// Default upsampling factor (sub-cells per probe cell along each axis)
+constexpr int SURFACE_DEFAULT_UPSAMPLE = 3;
+
+/// Largest accepted upsampling factor
+constexpr int SURFACE_MAX_UPSAMPLE = 8;
+
+/**
+ * @brief Upsample a probe grid with bicubic (Catmull-Rom) interpolation
+ *
+ * The result has (rows - 1) * factor + 1 rows and (cols - 1) * factor + 1
+ * columns and passes through every probe point. Beyond the grid edges the
+ * spline is extended linearly, so planar meshes stay exactly planar.
+ *
+ * @param mesh Heights as mesh[row][col] (all rows the same length)
+ * @param factor Sub-cells per probe cell (clamped to 1..SURFACE_MAX_UPSAMPLE)
+ * @param out_rows Receives the number of rows
+ * @param out_cols Receives the number of columns
+ * @return Heights, row-major (empty for a grid smaller than 2x2)
+ */
+std::vector<float> upsample_mesh_bicubic(const std::vector<std::vector<double>>& mesh,
+                                         int factor, int* out_rows, int* out_cols);
+
+/**
+ * @brief Upsampled mesh surface with world-space and per-frame screen-space arrays
+ */
+class MeshSurface {
+  public:
+    /**
+     * @brief Resample the probe heights (mesh data or factor changed)
+     *
+     * Invalidates the world-space placement until place() is called.
+     */
+    void set_heights(const std::vector<std::vector<double>>& mesh, int factor);
+
+    /**
+     * @brief Compute world positions and colors from the resampled heights
+     *
+     * X and Y are linear in the column and row index, so only the world
+     * coordinates of the grid corners are needed.
+     *
+     * @param x_first, x_last World X of column 0 and of the last column
+     * @param y_first, y_last World Y of row 0 and of the last row
+     * @param z_center, z_scale As for mesh_z_to_world_z()
+     * @param color_min, color_max As for bed_mesh_gradient_height_to_color()
+     */
+    void place(double x_first, double x_last, double y_first, double y_last, double z_center,
+               double z_scale, double color_min, double color_max);
+
+    /**
+     * @brief Project every vertex for the current view
+     *
+     * Matches bed_mesh_projection_project_3d_to_2d() (screen coordinates
+     * include the center and layer offsets).
+     */
+    void project(const bed_mesh_view_state_t& view, int canvas_width, int canvas_height);
+
+    /// True once set_heights() and place() have both run
+    bool is_ready() const {
+        return placed_ && !heights_.empty();
+    }
+
+    void clear();
+
+    int rows() const {
+        return rows_;
+    }
+    int cols() const {
+        return cols_;
+    }
+    int factor() const {
+        return factor_;
+    }
+    size_t vertex_count() const {
+        return heights_.size();
+    }
+
+    // Packed per-vertex arrays (vertex_count() entries each)
+    const std::vector<lv_color_t>& colors() const {
+        return colors_;
+    }
+    const std::vector<int32_t>& screen_x() const {
+        return screen_x_;
+    }
+    const std::vector<int32_t>& screen_y() const {
+        return screen_y_;
+    }
+    /// Camera-space depth from the last project() (larger = further)
+    const std::vector<float>& depths() const {
+        return depth_;
+    }
+
+  private:
+    int rows_ = 0;
+    int cols_ = 0;
+    int factor_ = 0;
+    bool placed_ = false;
+    std::vector<float> heights_; ///< Resampled probe heights (mm)
+
+    // World space (set by place())
+    std::vector<float> world_x_;
+    std::vector<float> world_y_;
+    std::vector<float> world_z_;
+    std::vector<lv_color_t> colors_;
+
+    // Screen space (set by project())
+    std::vector<int32_t> screen_x_;
+    std::vector<int32_t> screen_y_;
+    std::vector<float> depth_;
+};
+
+} // namespace mesh
+} // namespace helix
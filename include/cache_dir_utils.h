@@ -0,0 +1,32 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace helix {
+
+/**
+ * @brief Total size in bytes of the regular files in a cache directory
+ *
+ * Files that vanish or cannot be read while the directory is scanned are
+ * skipped, so a concurrent delete never inflates the total.
+ */
+size_t cache_directory_size(const std::string& dir);
+
+/**
+ * @brief Delete least-recently-used files until a cache directory fits its limit
+ *
+ * Caches touch a file's mtime when they load it, so the oldest mtime is the
+ * least recently used. Never throws; files that cannot be read or removed
+ * are left alone.
+ *
+ * @param keep File never removed (e.g. the one just stored), even if it is the oldest
+ * @return Number of files removed
+ */
+size_t evict_least_recent_files(const std::string& dir, size_t max_size,
+                                const std::string& keep = {});
+
+} // namespace helix
@@ -32,6 +32,7 @@ enum class TimeFormat { HOUR_12 = 0, HOUR_24 = 1 };
  * - time_format (12H/24H)
  * - printer_image (config-only, no subject)
  * - bed_mesh_show_zero_plane (config-only, no subject)
+ * - bed_mesh_upsample (config-only, no subject)
  *
  * Thread safety: Single-threaded, main LVGL thread only.
  */
@@ -167,6 +168,9 @@ class DisplaySettingsManager {
     /** @brief Get bed mesh zero plane visibility */
     bool get_bed_mesh_show_zero_plane() const;
 
+    /** @brief Get bed mesh surface upsampling factor (1-8, default 3) */
+    int get_bed_mesh_upsample_factor() const;
+
     // =========================================================================
     // DISPLAY DIM OPTIONS (for dropdown population)
     // =========================================================================
@@ -119,6 +119,16 @@ class EnvironmentConfig {
      */
     static bool get_benchmark_mode();
 
+    /**
+     * @brief Get the Moonraker frame log path from HELIX_RECORD_FRAMES
+     *
+     * When set, every inbound Moonraker WebSocket frame is recorded to this
+     * file for later replay (see moonraker_frame_log.h).
+     *
+     * @return File path, or nullopt if not set or empty
+     */
+    static std::optional<std::string> get_frame_record_path();
+
     /**
      * @brief Get data directory override from HELIX_DATA_DIR
      *
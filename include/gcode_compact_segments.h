@@ -0,0 +1,199 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_compact_segments.h
+ * @brief Packed struct-of-arrays storage for one layer's toolpath segments
+ *
+ * @pattern Append-only builder; read back through a forward iterator that
+ *          decodes into a ToolpathSegment
+ * @threading Immutable once built; concurrent readers are safe
+ * @gotchas XY is quantized to XY_QUANTUM_MM, and layer_index is not stored
+ */
+
+#pragma once
+
+#include "gcode_parser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Compact, read-only segment list for a single layer
+ *
+ * A ToolpathSegment is ~80 bytes, including a std::string that heap-allocates
+ * for long object names. Consecutive segments almost always chain (each starts
+ * where the previous ended), so this stores, per segment:
+ *
+ * - the end point as an int16 XY delta from the start, on a 5 µm grid
+ * - flag bits (extrusion, start jump, long move, Z change)
+ * - tool and object ids as small integers; object names (and their file-wide
+ *   ObjectId) are interned per layer
+ * - width in µm and the extrusion amount
+ *
+ * That is 14 bytes per segment. Starts that do not chain, deltas that do not
+ * fit in int16 and Z changes go to small side tables.
+ *
+ * Iterating yields `const ToolpathSegment&`, so code written for
+ * `std::vector<ToolpathSegment>` works unchanged in range-for loops:
+ * @code
+ *   CompactSegments packed;
+ *   for (const auto& seg : parsed_layer.segments) {
+ *       packed.push_back(seg);
+ *   }
+ *   packed.shrink_to_fit();
+ *   for (const auto& seg : packed) {
+ *       draw(seg.start, seg.end);
+ *   }
+ * @endcode
+ */
+class CompactSegments {
+  public:
+    /// XY grid step in mm (slicers emit 3 decimals; 5 µm is far below line width)
+    static constexpr float XY_QUANTUM_MM = 0.005f;
+
+    /// Bytes per chained segment in the per-segment arrays
+    static constexpr size_t BYTES_PER_SEGMENT = 14;
+
+    /// Forward iterator decoding one segment at a time
+    class const_iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ToolpathSegment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ToolpathSegment*;
+        using reference = const ToolpathSegment&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return current_;
+        }
+        pointer operator->() const {
+            return &current_;
+        }
+
+        const_iterator& operator++() {
+            ++index_;
+            decode();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return index_ == other.index_;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return index_ != other.index_;
+        }
+
+      private:
+        friend class CompactSegments;
+        const_iterator(const CompactSegments* owner, size_t index);
+        void decode();
+
+        const CompactSegments* owner_{nullptr};
+        size_t index_{0};
+        size_t anchor_pos_{0}; ///< Next entry in owner_->anchors_
+        size_t z_pos_{0};      ///< Next entry in owner_->z_values_
+        int32_t x_{0};         ///< Previous end, grid units
+        int32_t y_{0};
+        float z_{0.0f};
+        uint16_t object_slot_{0}; ///< object_ entry of current_ (0 = none)
+        ToolpathSegment current_;
+    };
+
+    CompactSegments() = default;
+
+    /// Pack an existing segment list
+    explicit CompactSegments(const std::vector<ToolpathSegment>& segments);
+
+    /**
+     * @brief Append a segment
+     *
+     * XY is rounded to XY_QUANTUM_MM; Z, width (to 1 µm) and extrusion amount
+     * are kept. Tool indices are clamped to 0-255.
+     */
+    void push_back(const ToolpathSegment& segment);
+
+    /// Reserve space for @p count segments
+    void reserve(size_t count);
+
+    /// Release unused capacity (call once the layer is complete)
+    void shrink_to_fit();
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, size());
+    }
+
+    size_t size() const {
+        return flags_.size();
+    }
+    bool empty() const {
+        return flags_.empty();
+    }
+
+    /// Distinct object names in this layer
+    const std::vector<std::string>& object_names() const {
+        return object_names_;
+    }
+
+    /// Decode into a plain vector (for code that needs random access)
+    std::vector<ToolpathSegment> to_vector() const;
+
+    /// Heap bytes used by this layer, including object names
+    size_t memory_bytes() const;
+
+  private:
+    enum Flag : uint8_t {
+        EXTRUSION = 1 << 0,
+        START_JUMP = 1 << 1, ///< Start XY does not chain; read from anchors_
+        LONG_MOVE = 1 << 2,  ///< End XY too far for int16; read from anchors_
+        START_Z = 1 << 3,    ///< Start Z differs from previous end; read from z_values_
+        END_Z = 1 << 4,      ///< End Z differs from start; read from z_values_
+    };
+
+    struct Anchor {
+        int32_t x;
+        int32_t y;
+    };
+
+    uint16_t intern_object(const std::string& name, ObjectId id);
+
+    // One entry per segment
+    std::vector<uint8_t> flags_;
+    std::vector<int16_t> dx_;
+    std::vector<int16_t> dy_;
+    std::vector<uint8_t> tool_;
+    std::vector<uint16_t> object_; ///< 1-based index into object_names_, 0 = none
+    std::vector<uint16_t> width_um_;
+    std::vector<float> extrusion_;
+
+    // Side tables, consumed in segment order
+    std::vector<Anchor> anchors_;
+    std::vector<float> z_values_;
+    std::vector<std::string> object_names_;
+    std::vector<ObjectId> object_ids_; ///< ToolpathSegment::object_id per object_names_ entry
+
+    // Builder state: last encoded end point
+    int32_t last_x_{0};
+    int32_t last_y_{0};
+    float last_z_{0.0f};
+    uint16_t last_object_{0};
+};
+
+} // namespace gcode
+} // namespace helix
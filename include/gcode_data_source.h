@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -81,17 +84,24 @@ class GCodeDataSource {
         return "";
     }
 
+    /**
+     * @brief Whether indexable_file_path() is a throwaway copy
+     *
+     * A temporary copy has a new name on every open and is deleted with the
+     * source, so on-disk caches keyed on its path would never be hit again.
+     */
+    virtual bool indexable_file_is_temporary() const {
+        return false;
+    }
+
     /**
      * @brief Ensure the source is ready for indexing
      *
      * For sources that may need preparation before indexing (e.g., downloading
      * a remote file), this method performs that preparation.
      *
-     * For local files and memory sources, this is a no-op (returns true).
-     * For Moonraker sources, downloads the file to a temp location because
-     * the layer indexer requires filesystem access for memory-mapped parsing.
-     * This happens even if range requests are supported - range requests are
-     * used for streaming, but indexing needs a local file.
+     * No built-in source needs this: sources without a local file are indexed
+     * from stream_chunks() while the data arrives.
      *
      * @return true if the source is now ready for indexing
      */
@@ -99,6 +109,23 @@ class GCodeDataSource {
         return true;
     }
 
+    /// Receives one chunk at @p offset; return false to stop streaming
+    using ChunkCallback = std::function<bool(const char* data, size_t size, uint64_t offset)>;
+
+    /**
+     * @brief Read the whole source front to back, one chunk at a time
+     *
+     * Used to build the layer index from sources without a local file. Chunks
+     * are delivered in file order and not kept. The default implementation
+     * reads consecutive read_range() chunks.
+     *
+     * @param on_chunk Receives each chunk; return false to stop
+     * @param keep_running Polled between chunks; streaming stops when false
+     * @return true if every byte up to file_size() was delivered
+     */
+    virtual bool stream_chunks(const ChunkCallback& on_chunk,
+                               const std::atomic<bool>& keep_running);
+
     /**
      * @brief Read a single line starting at offset
      *
@@ -167,6 +194,22 @@ class FileDataSource : public GCodeDataSource {
     uint64_t size_{0};
 };
 
+/**
+ * @brief Retry policy and chunk size for MoonrakerDataSource::stream_chunks()
+ */
+struct RangeStreamOptions {
+    uint32_t chunk_bytes = 1024 * 1024;         ///< Bytes per Range request
+    int max_retries = 5;                        ///< Consecutive failures before giving up
+    std::chrono::milliseconds retry_delay{500}; ///< Multiplied by the attempt number
+
+    /// Limit for one Range request. A request cannot be interrupted, so this
+    /// is also how long stopping a stream can take.
+    std::chrono::seconds request_timeout{3};
+
+    /// A request that times out or drops is retried at half the size, down to this
+    uint32_t min_chunk_bytes = 64 * 1024;
+};
+
 /**
  * @brief Data source for Moonraker HTTP API
  *
@@ -176,6 +219,15 @@ class FileDataSource : public GCodeDataSource {
  *
  * The fallback behavior is transparent - callers don't need to
  * handle it differently.
+ *
+ * stream_chunks() downloads the file as consecutive Range requests over one
+ * keep-alive connection, so the layer index can be built while the file
+ * arrives and no local copy is written. A dropped connection is retried from
+ * the last byte received, with smaller requests on a slow link so that each
+ * one stays within RangeStreamOptions::request_timeout.
+ *
+ * The constructor makes one blocking metadata request; construct it off the
+ * UI thread.
  */
 class MoonrakerDataSource : public GCodeDataSource {
   public:
@@ -199,7 +251,18 @@ class MoonrakerDataSource : public GCodeDataSource {
     std::string source_name() const override;
     bool is_valid() const override;
     std::string indexable_file_path() const override;
-    bool ensure_indexable() override;
+    bool indexable_file_is_temporary() const override {
+        return fallback_source_ != nullptr; // Timestamped download, removed in the destructor
+    }
+    bool stream_chunks(const ChunkCallback& on_chunk,
+                       const std::atomic<bool>& keep_running) override;
+
+    /**
+     * @brief Set chunk size and retry policy for stream_chunks()
+     */
+    void set_stream_options(const RangeStreamOptions& options) {
+        stream_options_ = options;
+    }
 
     /**
      * @brief Force download of entire file to temp storage
@@ -254,13 +317,25 @@ class MoonrakerDataSource : public GCodeDataSource {
      */
     std::vector<char> http_range_request(uint64_t offset, uint32_t length);
 
+    /// Outcome of one stream_ranges() pass
+    enum class RangeStreamResult { COMPLETE, STOPPED, FAILED, NO_RANGE_SUPPORT };
+
+    /**
+     * @brief Deliver [offset, size_) as Range requests on one connection
+     * @param offset In: first byte to fetch. Out: first byte not yet delivered
+     */
+    RangeStreamResult stream_ranges(const ChunkCallback& on_chunk,
+                                    const std::atomic<bool>& keep_running, uint64_t& offset);
+
     std::string moonraker_url_;
     std::string gcode_path_;
     uint64_t size_{0};
-    bool range_support_probed_{false};
-    bool range_support_{false};
+    // Atomic: stream_chunks() learns these while layers load on other threads
+    std::atomic<bool> range_support_probed_{false};
+    std::atomic<bool> range_support_{false};
     bool metadata_fetched_{false};
     bool valid_{false};
+    RangeStreamOptions stream_options_;
 
     // Fallback to local temp file if range requests don't work
     std::unique_ptr<FileDataSource> fallback_source_;
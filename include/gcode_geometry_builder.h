@@ -9,8 +9,10 @@
 
 #include "gcode_parser.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <optional>
@@ -309,6 +311,18 @@ struct SimplificationOptions {
  * 4. Assign colors (Z-height gradient or custom)
  * 5. Compute surface normals (horizontal for flat ribbons)
  * 6. Index vertices (share vertices between adjacent segments)
+ *
+ * Large files are built in parallel: layers are split into contiguous ranges
+ * of roughly equal segment count, steps 2-6 run per range on its own thread,
+ * and the ranges are merged in layer order. Palettes come out in the same
+ * order as a single-threaded build; only vertex sharing across a range seam
+ * is lost (one extra end cap per seam).
+ *
+ * With a batch callback set, the layers are built in waves from the bottom
+ * up, each wave covering about as many segments as all earlier ones together,
+ * and a copy of the geometry built so far is published after every wave but
+ * the last. Already-published layers never change, so a renderer can keep
+ * what it uploaded and add only the new layers.
  */
 class GeometryBuilder {
   public:
@@ -436,6 +450,39 @@ class GeometryBuilder {
         return budget_exceeded_;
     }
 
+    /// Fewest segments worth a build thread of their own
+    static constexpr size_t MIN_SEGMENTS_PER_THREAD = 20000;
+
+    /// Segments in the first published wave of a progressive build
+    static constexpr size_t FIRST_BATCH_SEGMENTS = 50000;
+
+    /**
+     * @brief Receives layers [0, layers_built) of a build still in progress
+     *
+     * Called on the thread running build(). The geometry is a copy the
+     * callback owns; it has no prepared buffers.
+     */
+    using BatchCallback =
+        std::function<void(std::unique_ptr<RibbonGeometry> partial, size_t layers_built)>;
+
+    /**
+     * @brief Publish partial geometry while build() runs (nullptr to disable)
+     * @param callback Receives each batch
+     * @param first_batch_segments Size of the first wave; later waves double the total
+     */
+    void set_batch_callback(BatchCallback callback,
+                            size_t first_batch_segments = FIRST_BATCH_SEGMENTS) {
+        batch_callback_ = std::move(callback);
+        first_batch_segments_ = std::max<size_t>(1, first_batch_segments);
+    }
+
+    /**
+     * @brief Limit the threads used by build() (0 = one per core, 1 = single-threaded)
+     */
+    void set_max_threads(unsigned threads) {
+        max_threads_ = threads;
+    }
+
     /**
      * @brief Set tool color palette for multi-color prints
      * @param palette Vector of hex color strings (e.g., ["#ED1C24", "#00C1AE"])
@@ -448,10 +495,33 @@ class GeometryBuilder {
     }
 
   private:
+    struct LayerRangeBuild;  ///< One thread's share of build() (defined in the .cpp)
+    struct SharedBuildState; ///< Budget accounting shared by all threads of a build
+
+    /**
+     * @brief Build layers [first_layer, end_layer) into @p out
+     *
+     * Runs on a worker thread: reads only configuration members and writes
+     * only @p out and @p shared.
+     */
+    void build_layer_range(const ParsedGCodeFile& gcode, size_t first_layer, size_t end_layer,
+                           const SimplificationOptions& options, SharedBuildState& shared,
+                           LayerRangeBuild& out);
+
+    /// Append a finished range to @p geometry, remapping palette and vertex indices
+    void append_layer_range(RibbonGeometry& geometry, LayerRangeBuild& range);
+
+    /// Copy of layers [0, end_layer) of a geometry being built, for the batch callback
+    std::unique_ptr<RibbonGeometry> snapshot(const RibbonGeometry& geometry,
+                                             size_t end_layer) const;
+
     // Palette management
     uint16_t add_to_normal_palette(RibbonGeometry& geometry, const glm::vec3& normal);
     uint8_t add_to_color_palette(RibbonGeometry& geometry, uint32_t color_rgb);
 
+    /// Index of an already-quantized normal, adding it if new
+    static uint16_t intern_normal(RibbonGeometry& geometry, const glm::vec3& quantized);
+
     // Simplification pipeline
     std::vector<ToolpathSegment> simplify_segments(const std::vector<ToolpathSegment>& segments,
                                                    const SimplificationOptions& options);
@@ -511,6 +581,9 @@ class GeometryBuilder {
     std::vector<std::string> tool_color_palette_; ///< Hex colors per tool (multi-color prints)
     int tube_sides_ = 16;                         ///< Tube cross-section sides (valid: 4, 8, 16)
 
+    unsigned max_threads_ = 0;      ///< Build threads (0 = one per core)
+    BatchCallback batch_callback_;  ///< Progressive build listener (empty = disabled)
+    size_t first_batch_segments_ = FIRST_BATCH_SEGMENTS;
     int budget_tube_sides_ = 0;     ///< Override tube_sides from budget (0 = use config)
     size_t budget_limit_bytes_ = 0; ///< Memory ceiling (0 = unlimited)
     bool budget_exceeded_ = false;  ///< Set to true if build aborted due to budget
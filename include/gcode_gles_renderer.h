@@ -214,6 +214,8 @@ class GCodeGLESRenderer {
     void set_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry,
                                const std::string& filename);
     void set_prebuilt_coarse_geometry(std::unique_ptr<RibbonGeometry> geometry);
+    /// Replace geometry with a grown copy of it (progressive load); keeps uploaded layer VBOs
+    void extend_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry);
 
     // ====== Statistics ======
 
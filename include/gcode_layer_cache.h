@@ -3,17 +3,22 @@
 
 #pragma once
 
+#include "gcode_compact_segments.h"
 #include "gcode_parser.h"
 #include "memory_utils.h"
 
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <queue>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace helix {
 namespace gcode {
@@ -29,6 +34,14 @@ class GCodeDataSource;
  * viewing large G-code files (10MB+) on memory-constrained devices.
  *
  * Thread-safe for concurrent access from UI and background loading threads.
+ * Layers are parsed outside the cache lock, so a slow load never blocks hits
+ * on other layers; a request for a layer that is already being loaded waits
+ * for that load instead of starting a second one.
+ *
+ * prefetch_async() hands neighbouring layers to a background loader thread,
+ * nearest first and favouring the direction the user is scrubbing in. Each
+ * call replaces the queued requests of the previous one, so fast scrubbing
+ * never builds up a backlog of layers that are no longer wanted.
  *
  * Usage:
  * @code
@@ -39,7 +52,8 @@ class GCodeDataSource;
  *   }
  * @endcode
  *
- * Memory usage: ~80 bytes per segment + cache bookkeeping
+ * Layers are stored as CompactSegments (~14 bytes per segment instead of ~80
+ * for ToolpathSegment), so a given budget holds roughly five times as many layers.
  */
 class GCodeLayerCache {
   public:
@@ -52,8 +66,8 @@ class GCodeLayerCache {
     /// Memory budget for well-equipped devices (32MB) - >512MB total RAM
     static constexpr size_t DEFAULT_BUDGET_GOOD = 32 * 1024 * 1024;
 
-    /// Approximate bytes per segment (for estimation)
-    static constexpr size_t BYTES_PER_SEGMENT = 80;
+    /// Approximate bytes per cached segment (for estimation)
+    static constexpr size_t BYTES_PER_SEGMENT = CompactSegments::BYTES_PER_SEGMENT;
 
     /**
      * @brief Construct cache with memory budget
@@ -61,7 +75,8 @@ class GCodeLayerCache {
      */
     explicit GCodeLayerCache(size_t memory_budget_bytes = DEFAULT_BUDGET_NORMAL);
 
-    ~GCodeLayerCache() = default;
+    /// Stops the prefetch thread (waits for a load in progress)
+    ~GCodeLayerCache();
 
     // Non-copyable, non-moveable (mutex prevents move)
     GCodeLayerCache(const GCodeLayerCache&) = delete;
@@ -78,7 +93,7 @@ class GCodeLayerCache {
      * segments while other threads may trigger cache eviction.
      */
     struct CacheResult {
-        std::shared_ptr<const std::vector<ToolpathSegment>>
+        std::shared_ptr<const CompactSegments>
             segments;            ///< Shared pointer to segments (thread-safe lifetime)
         bool was_hit{false};     ///< True if found in cache
         bool load_failed{false}; ///< True if load attempted but failed
@@ -92,14 +107,14 @@ class GCodeLayerCache {
      * May evict other layers to stay within budget.
      *
      * @param layer_index Zero-based layer index
-     * @param loader Function to load layer data: (layer_index) -> vector<ToolpathSegment>
+     * @param loader Function to load layer data: (layer_index) -> CompactSegments
      * @return CacheResult with pointer to segments (valid until next cache operation)
      *
      * @note The returned pointer is only valid until the next cache-modifying operation.
      *       Copy the data if you need to keep it longer.
      */
     CacheResult get_or_load(size_t layer_index,
-                            std::function<std::vector<ToolpathSegment>(size_t)> loader);
+                            std::function<CompactSegments(size_t)> loader);
 
     /**
      * @brief Check if a layer is currently cached
@@ -109,10 +124,10 @@ class GCodeLayerCache {
     bool is_cached(size_t layer_index) const;
 
     /**
-     * @brief Prefetch layers around a center layer
+     * @brief Prefetch layers around a center layer, synchronously
      *
-     * Loads layers in range [center - radius, center + radius] in the background.
-     * Useful for preloading layers the user is likely to view next.
+     * Loads layers in range [center - radius, center + radius] on the calling thread.
+     * Prefer prefetch_async() from the UI thread.
      *
      * @param center_layer Center layer index
      * @param radius Number of layers on each side to prefetch
@@ -120,7 +135,38 @@ class GCodeLayerCache {
      * @param max_layer Maximum valid layer index (to avoid out-of-bounds)
      */
     void prefetch(size_t center_layer, size_t radius,
-                  std::function<std::vector<ToolpathSegment>(size_t)> loader, size_t max_layer);
+                  std::function<CompactSegments(size_t)> loader, size_t max_layer);
+
+    /**
+     * @brief Queue layers around a center layer for the background loader
+     *
+     * Loads @p center_layer first, then neighbours by distance. When the center
+     * moved since the previous call, layers in the direction of travel come
+     * before those behind it. Requests still queued from the previous call are
+     * cancelled. Starts the loader thread on first use.
+     *
+     * @param center_layer Layer being viewed
+     * @param radius Number of layers on each side to prefetch
+     * @param loader Function to load layer data (called on the loader thread)
+     * @param max_layer Maximum valid layer index
+     */
+    void prefetch_async(size_t center_layer, size_t radius,
+                        std::function<CompactSegments(size_t)> loader,
+                        size_t max_layer);
+
+    /**
+     * @brief Drop queued prefetches and wait for a load in progress to finish
+     *
+     * Call before invalidating whatever the prefetch loader reads from.
+     */
+    void cancel_prefetch();
+
+    /**
+     * @brief Wait until the prefetch queue is empty and the loader is idle
+     * @param timeout Maximum time to wait
+     * @return true if idle, false on timeout
+     */
+    bool wait_for_prefetch(std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
     /**
      * @brief Insert pre-loaded layer data into cache
@@ -131,7 +177,7 @@ class GCodeLayerCache {
      * @param segments Segment data to cache (moved into cache)
      * @return true if inserted, false if would exceed budget even after eviction
      */
-    bool insert(size_t layer_index, std::vector<ToolpathSegment>&& segments);
+    bool insert(size_t layer_index, CompactSegments&& segments);
 
     /**
      * @brief Clear all cached layers
@@ -167,11 +213,33 @@ class GCodeLayerCache {
      */
     size_t cached_layer_count() const;
 
+    /**
+     * @brief Cache and prefetch statistics
+     *
+     * Hits and misses count get_or_load() calls only; prefetch loads are
+     * tracked separately.
+     */
+    struct HitStats {
+        size_t hits{0};               ///< Requests served from cache
+        size_t misses{0};             ///< Requests that loaded, or waited for, the layer
+        size_t prefetch_loads{0};     ///< Layers loaded by prefetch
+        size_t prefetch_hits{0};      ///< Prefetched layers later requested
+        size_t prefetch_cancelled{0}; ///< Queued prefetches dropped as stale
+        double max_stall_ms{0.0};     ///< Longest get_or_load() miss
+        double total_stall_ms{0.0};   ///< Time spent in get_or_load() misses
+
+        /// Fraction of prefetched layers that were used [0.0, 1.0]
+        float prefetch_hit_rate() const {
+            return prefetch_loads == 0 ? 0.0f
+                                       : static_cast<float>(prefetch_hits) /
+                                             static_cast<float>(prefetch_loads);
+        }
+    };
+
     /**
      * @brief Get cache hit statistics
-     * @return Pair of (hits, misses)
      */
-    std::pair<size_t, size_t> hit_stats() const;
+    HitStats hit_stats() const;
 
     /**
      * @brief Get cache hit rate
@@ -264,16 +332,42 @@ class GCodeLayerCache {
      * data alive even if this entry is evicted from the cache.
      */
     struct CacheEntry {
-        std::shared_ptr<std::vector<ToolpathSegment>> segments;
+        std::shared_ptr<CompactSegments> segments;
         size_t memory_bytes{0}; ///< Estimated memory usage
+        bool prefetched{false}; ///< Loaded by prefetch and not requested since
+    };
+
+    /// Queued prefetch; lower rank loads first
+    struct PrefetchRequest {
+        size_t rank;
+        size_t layer;
+
+        bool operator<(const PrefetchRequest& other) const {
+            return rank > other.rank; // std::priority_queue pops the largest
+        }
     };
 
     /**
-     * @brief Estimate memory usage for segment vector
-     * @param segments Vector of segments
-     * @return Estimated bytes
+     * @brief Load a layer with the lock released and cache the result
+     *
+     * Caller holds @p lock, and the layer is neither cached nor being loaded.
+     */
+    CacheResult load_and_insert(size_t layer_index,
+                                const std::function<CompactSegments(size_t)>& loader,
+                                std::unique_lock<std::mutex>& lock, bool prefetched);
+
+    /// Hit bookkeeping for a cached entry (lock held)
+    void record_hit(size_t layer_index, CacheEntry& entry);
+
+    /// Prefetch loader thread body
+    void prefetch_worker();
+
+    /**
+     * @brief Memory used by a packed layer
+     * @param segments Layer segments
+     * @return Bytes, including the container itself
      */
-    static size_t estimate_memory(const std::vector<ToolpathSegment>& segments);
+    static size_t estimate_memory(const CompactSegments& segments);
 
     /**
      * @brief Evict oldest entries until under budget
@@ -304,11 +398,24 @@ class GCodeLayerCache {
     size_t current_memory_{0};
 
     // Statistics
-    mutable size_t hit_count_{0};
-    mutable size_t miss_count_{0};
+    HitStats stats_;
 
     // Thread safety
     mutable std::mutex mutex_;
+    std::unordered_set<size_t> loading_;  ///< Layers being loaded outside the lock
+    std::condition_variable loaded_cv_;   ///< Signalled when a load finishes
+    uint64_t clear_generation_{0};        ///< Bumped by clear(); stale loads are dropped
+
+    // Background prefetch (state guarded by mutex_)
+    std::thread prefetch_thread_;
+    std::priority_queue<PrefetchRequest> prefetch_queue_;
+    std::function<CompactSegments(size_t)> prefetch_loader_;
+    std::condition_variable prefetch_cv_; ///< Work queued or stop requested
+    std::condition_variable idle_cv_;     ///< Loader finished a request
+    std::optional<size_t> last_prefetch_center_;
+    int scrub_direction_{0}; ///< +1 towards higher layers, -1 lower, 0 unknown
+    bool prefetch_busy_{false};
+    bool stop_prefetch_{false};
 
     // Adaptive memory management
     bool adaptive_enabled_{false};
@@ -49,12 +49,118 @@ struct LayerIndexStats {
     std::string filament_color; ///< Filament color hex (e.g., "#26A69A") from metadata
 };
 
+/**
+ * @brief Incremental layer boundary scanner
+ *
+ * Finds layer boundaries in G-code fed in file order, in chunks of any size.
+ * Lines split across chunks are carried over to the next feed(). This lets the
+ * index grow while a file is still downloading: every layer except the one
+ * currently being scanned has its final byte range.
+ *
+ * GCodeLayerIndex::build_from_file() runs a file through this scanner, so
+ * streamed and file-based indexes are identical. A file that is already
+ * complete in memory can instead be scanned on several threads with
+ * scan_buffer(), again with an identical result.
+ *
+ * Usage:
+ * @code
+ *   LayerIndexScanner scanner(file_size);
+ *   while (auto chunk = next_chunk()) {
+ *       scanner.feed(chunk.data(), chunk.size());
+ *       index.sync_from(scanner); // Publishes newly completed layers
+ *   }
+ *   scanner.finish();
+ *   index.sync_from(scanner);
+ * @endcode
+ */
+class LayerIndexScanner {
+  public:
+    /**
+     * @param expected_bytes File size if known; enables the footer filament color scan
+     */
+    explicit LayerIndexScanner(uint64_t expected_bytes = 0);
+
+    /**
+     * @brief Scan the next bytes of the file
+     */
+    void feed(const char* data, size_t size);
+
+    /**
+     * @brief Scan a whole file image on up to @p threads threads, then finish()
+     *
+     * The buffer is split into chunks on line boundaries. Each thread scans
+     * one chunk for layer markers, Z moves and metadata, and the results are
+     * stitched together in file order. With one thread, or if anything was
+     * fed already, this is feed() followed by finish().
+     */
+    void scan_buffer(const char* data, size_t size, unsigned threads);
+
+    /**
+     * @brief Scan the trailing partial line and close the last layer
+     *
+     * Further feed() calls are ignored.
+     */
+    void finish();
+
+    /// Layers whose byte range is final (all of them once finished)
+    size_t complete_layers() const {
+        if (finished_ || entries_.empty()) {
+            return entries_.size();
+        }
+        return entries_.size() - 1;
+    }
+
+    /// Layers found so far; the last one is still open until finish()
+    const std::vector<StreamingLayerEntry>& entries() const {
+        return entries_;
+    }
+
+    /// Totals so far; total_layers and total_bytes are set by finish()
+    const LayerIndexStats& stats() const {
+        return stats_;
+    }
+
+    uint64_t bytes_scanned() const {
+        return bytes_scanned_;
+    }
+
+    bool is_finished() const {
+        return finished_;
+    }
+
+  private:
+    void scan_line(const char* line, size_t len);
+
+    /// Layer state machine, shared by scan_line() and the scan_buffer() stitch
+    void on_layer_marker();
+    void on_z_move(float z, uint64_t offset, uint64_t line);
+
+    /// True where filament color metadata is searched (header lines, footer bytes)
+    bool in_metadata_region(uint64_t line, uint64_t offset) const;
+
+    std::vector<StreamingLayerEntry> entries_;
+    LayerIndexStats stats_;
+    uint64_t expected_bytes_{0};
+    uint64_t bytes_scanned_{0};
+    std::string line_; ///< Line split across feed() calls
+
+    float current_z_;
+    uint64_t current_layer_start_{0};
+    uint64_t current_layer_start_line_{0};
+    uint64_t current_offset_{0};
+    bool use_layer_markers_{false};
+    bool pending_layer_start_{false};
+    bool first_layer_started_{false};
+    bool finished_{false};
+};
+
 /**
  * @brief Layer index for streaming G-code access
  *
  * Provides random access to layers without loading the entire file.
  * Built with a single-pass scan of the file, recording byte offsets
- * for each layer boundary.
+ * for each layer boundary. Large files are memory-mapped and scanned
+ * in parallel chunks.
  *
  * Usage:
  * @code
@@ -87,10 +193,53 @@ class GCodeLayerIndex {
      * Z-axis changes or ;LAYER_CHANGE markers. Records byte offset,
      * length, and line count for each layer.
      *
+     * The file is memory-mapped and, when it is large enough (4MB per
+     * thread), scanned on several threads. If it cannot be mapped it is
+     * read sequentially instead; the index is the same either way.
+     *
      * @param filepath Path to G-code file
+     * @param max_threads Upper bound on scanning threads (0 = one per core)
      * @return true if successful, false on error
      */
-    bool build_from_file(const std::string& filepath);
+    bool build_from_file(const std::string& filepath, unsigned max_threads = 0);
+
+    /**
+     * @brief Publish layers completed by a scanner since the last call
+     *
+     * Appends newly completed entries, so the layer count grows while a
+     * download is in progress. Statistics are copied once the scanner has
+     * finished.
+     *
+     * @param scanner Scanner fed from the start of the same file
+     * @return Number of layers added
+     */
+    size_t sync_from(const LayerIndexScanner& scanner);
+
+    /**
+     * @brief Replace the index with previously built entries
+     *
+     * Used to restore an index from LayerIndexDiskCache without rescanning.
+     */
+    void assign(std::vector<StreamingLayerEntry> entries, LayerIndexStats stats,
+                std::string source_path) {
+        entries_ = std::move(entries);
+        stats_ = std::move(stats);
+        source_path_ = std::move(source_path);
+    }
+
+    /**
+     * @brief All layer entries, in file order
+     */
+    const std::vector<StreamingLayerEntry>& entries() const {
+        return entries_;
+    }
+
+    /**
+     * @brief Set the path reported by get_source_path()
+     */
+    void set_source_path(std::string path) {
+        source_path_ = std::move(path);
+    }
 
     /**
      * @brief Get entry for a specific layer
@@ -0,0 +1,136 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "gcode_layer_index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Identity of a G-code file, used to decide whether a cached index still applies
+ *
+ * Size and mtime catch ordinary edits; the fingerprint of the first and last
+ * bytes catches files replaced in place with the same size and timestamp
+ * (e.g. copied with preserved mtime).
+ */
+struct GCodeFileIdentity {
+    std::string path;
+    uint64_t size{0};
+    int64_t mtime_ns{0};
+    uint64_t fingerprint{0}; ///< FNV-1a of the head and tail of the file
+
+    bool operator==(const GCodeFileIdentity& other) const {
+        return path == other.path && size == other.size && mtime_ns == other.mtime_ns &&
+               fingerprint == other.fingerprint;
+    }
+
+    /**
+     * @brief Read the identity of a file on disk
+     * @return false if the file cannot be opened
+     */
+    static bool from_file(const std::string& filepath, GCodeFileIdentity& out);
+};
+
+/// FNV-1a offset basis (the hash of no bytes)
+constexpr uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ULL;
+
+/**
+ * @brief FNV-1a hash used for cache file names, fingerprints and checksums
+ * @param hash Result of a previous call, to hash several buffers as one
+ */
+uint64_t fnv1a_hash(const char* data, size_t size, uint64_t hash = FNV1A_OFFSET_BASIS);
+
+/**
+ * @brief On-disk cache of layer indexes, so reopening a file skips the scan
+ *
+ * Each indexed file gets a small binary sidecar (~24 bytes per layer) in the
+ * cache directory, named after a hash of its path. A sidecar is only used when
+ * the file's current GCodeFileIdentity matches the one it was built from, so
+ * edited or replaced files are rescanned. Least-recently-used sidecars are
+ * removed once the directory grows past its size limit.
+ *
+ * Usage:
+ * @code
+ *   GCodeLayerIndex index;
+ *   if (!get_layer_index_cache().load(path, index) && index.build_from_file(path)) {
+ *       get_layer_index_cache().store(path, index);
+ *   }
+ * @endcode
+ *
+ * @threading load() and store() may be called from any thread
+ * @gotchas Sidecars use the host's byte order; they are not meant to be copied between machines
+ */
+class LayerIndexDiskCache {
+  public:
+    /// Subdirectory appended to the base cache dir (next to helix_thumbs)
+    static constexpr const char* CACHE_SUBDIR = "helix_gcode_index";
+
+    /// Default size limit for all sidecars (2 MB holds ~80,000 layers)
+    static constexpr size_t DEFAULT_MAX_CACHE_SIZE = 2 * 1024 * 1024;
+
+    /// Bytes read from each end of the file for GCodeFileIdentity::fingerprint
+    static constexpr size_t FINGERPRINT_BYTES = 16 * 1024;
+
+    /**
+     * @param cache_dir Directory for sidecar files (created if missing)
+     * @param max_size Total size limit in bytes before old sidecars are evicted
+     */
+    explicit LayerIndexDiskCache(std::string cache_dir, size_t max_size = DEFAULT_MAX_CACHE_SIZE);
+
+    /**
+     * @brief Restore the index of a file if a matching sidecar exists
+     * @param filepath G-code file
+     * @param index Replaced with the cached index on success, untouched otherwise
+     * @return true on a cache hit
+     */
+    bool load(const std::string& filepath, GCodeLayerIndex& index);
+
+    /**
+     * @brief Write the sidecar for a freshly built index
+     * @param filepath G-code file the index was built from
+     * @param index Complete index (nothing is stored for an empty index)
+     * @return true if the sidecar was written
+     */
+    bool store(const std::string& filepath, const GCodeLayerIndex& index);
+
+    /**
+     * @brief Remove the sidecar for a file, if any
+     */
+    void remove(const std::string& filepath);
+
+    /**
+     * @brief Sidecar location for a file path
+     */
+    [[nodiscard]] std::string get_cache_path(const std::string& filepath) const;
+
+    [[nodiscard]] const std::string& get_cache_dir() const {
+        return cache_dir_;
+    }
+
+    /**
+     * @brief Total size of all sidecars in bytes
+     */
+    [[nodiscard]] size_t get_cache_size() const;
+
+  private:
+    void evict_if_needed();
+
+    std::string cache_dir_;
+    size_t max_size_;
+    std::mutex mutex_; ///< Serialises writes and eviction
+};
+
+/**
+ * @brief Global layer index cache in the helix cache directory
+ */
+LayerIndexDiskCache& get_layer_index_cache();
+
+} // namespace gcode
+} // namespace helix
@@ -0,0 +1,221 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_layer_raster.h
+ * @brief Off-thread rasterization for the 2D layer view's cached images
+ *
+ * The FRONT view keeps two cached images, the solid layers up to the current
+ * one and the ghost of the whole print. Both are drawn here on a worker thread,
+ * so a layer change costs the LVGL thread one copy instead of a rasterization:
+ *
+ * - RasterImage / draw_line_aa(): plain ARGB8888 pixels and an anti-aliased
+ *   round-capped line kernel, no LVGL calls.
+ * - RasterSwapChain: lock-free triple buffer. The worker draws into the back
+ *   image and publishes it with one atomic exchange; the LVGL thread picks up
+ *   the newest published image with another.
+ * - LayerRasterWorker: one thread running the newest job of each lane, the
+ *   solid lane ahead of the ghost lane.
+ *
+ * @threading RasterSwapChain has exactly one writer and one reader thread
+ * @gotchas Jobs must only check their stop flag between layers; a layer cut off
+ *          halfway would be drawn twice when the next job resumes. A job paused
+ *          for a higher-priority lane is called again later and must carry on
+ *          from its own progress.
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/// Row-major 0xAARRGGBB image, non-premultiplied (same bytes as LVGL ARGB8888 on little-endian)
+struct RasterImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint32_t> pixels;
+
+    // Set by the writer, read with the image after acquire()
+    uint64_t generation = 0; ///< Which invalidation of the source the pixels belong to
+    int tag = -1;            ///< Writer-defined progress (highest layer drawn)
+    int64_t published_ns = 0;
+
+    // Row change tracking, so copies of a newer image skip the rows it shares
+    // with an older one (a new layer in the FRONT view touches a thin band)
+    uint64_t version = 0;               ///< publish() that produced the pixels (0 = none)
+    std::vector<uint64_t> row_versions; ///< Per row: the publish() that last changed it
+    int dirty_top = 0;                  ///< Rows [dirty_top, dirty_bottom) changed since
+    int dirty_bottom = 0;               ///< the last publish()
+
+    /// Reallocate to @p w x @p h (contents undefined until clear())
+    void resize(int w, int h);
+    /// Fill every pixel (marks every row changed)
+    void clear(uint32_t argb = 0);
+    /// Record that rows [top, bottom) changed (clamped to the image)
+    void mark_rows_changed(int top, int bottom);
+
+    /**
+     * @brief Become a copy of @p newer, an image published later from the same writer
+     *
+     * Only rows changed after this image's version are copied; a different
+     * size copies everything.
+     */
+    void update_from(const RasterImage& newer);
+};
+
+/**
+ * @brief Composite an anti-aliased, round-capped line over @p image
+ *
+ * Coverage is the distance from each pixel center to the segment, so the
+ * image does not depend on the direction the line is drawn in. Pixels outside
+ * the image are skipped. The rows touched are marked changed.
+ *
+ * @param p0, p1 Endpoints in pixels (pixel i spans [i, i + 1))
+ * @param width Line width in pixels (narrower lines are drawn 1 px wide)
+ * @param argb Color; its alpha scales the coverage
+ */
+void draw_line_aa(RasterImage& image, glm::vec2 p0, glm::vec2 p1, float width, uint32_t argb);
+
+/// Frame time and swap latency counters of a RasterSwapChain
+struct RasterStats {
+    uint64_t frames_published = 0;
+    uint64_t frames_acquired = 0;
+    uint32_t last_frame_us = 0; ///< begin_frame() to publish() on the worker
+    uint32_t max_frame_us = 0;
+    uint32_t last_swap_latency_us = 0; ///< publish() to acquire() on the reader
+    uint32_t max_swap_latency_us = 0;
+};
+
+/**
+ * @brief Triple buffer handing finished images from a worker to the LVGL thread
+ *
+ * The writer owns the back image and the reader the front one; the third
+ * sits in between. publish() and acquire() each swap with the middle image
+ * in one atomic exchange, so neither side ever waits for the other and the
+ * reader never sees a half-drawn image.
+ */
+class RasterSwapChain {
+  public:
+    RasterSwapChain() = default;
+    RasterSwapChain(const RasterSwapChain&) = delete;
+    RasterSwapChain& operator=(const RasterSwapChain&) = delete;
+
+    /// Writer: start timing a frame and return the back image to draw into
+    RasterImage& begin_frame();
+
+    /**
+     * @brief Writer: hand the back image to the reader
+     *
+     * Stamps the image with the next version and its changed rows with it.
+     *
+     * @param carry_over Bring the new back image up to date with it (changed
+     *                   rows only), so drawing can continue where it left off
+     * @return The new back image
+     */
+    RasterImage& publish(bool carry_over);
+
+    /// Reader: newest published image, or nullptr if nothing was published since the last call
+    const RasterImage* acquire();
+
+    /// Reader: an image is waiting for acquire()
+    bool has_new() const {
+        return (middle_.load(std::memory_order_acquire) & kDirty) != 0;
+    }
+
+    RasterStats stats() const;
+
+  private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kDirty = 0x4;
+
+    std::array<RasterImage, 3> images_;
+    int back_ = 0;                   ///< Writer only
+    int front_ = 1;                  ///< Reader only
+    uint64_t version_ = 0;           ///< Writer only: last version published
+    std::atomic<uint8_t> middle_{2}; ///< Index | kDirty when not yet acquired
+    std::chrono::steady_clock::time_point frame_start_; ///< Writer only
+
+    std::atomic<uint64_t> frames_published_{0};
+    std::atomic<uint64_t> frames_acquired_{0};
+    std::atomic<uint32_t> last_frame_us_{0};
+    std::atomic<uint32_t> max_frame_us_{0};
+    std::atomic<uint32_t> last_swap_latency_us_{0};
+    std::atomic<uint32_t> max_swap_latency_us_{0};
+};
+
+/// Independent job queues of LayerRasterWorker, run in this order of priority
+enum class RasterLane : uint8_t {
+    Solid = 0, ///< Layers up to the current one (what the user is looking at)
+    Ghost = 1, ///< Whole print, faded
+};
+
+/**
+ * @brief Single background thread running rasterization jobs
+ *
+ * Each lane holds at most one pending job: submitting replaces it and asks
+ * the running job of that lane to stop. Submitting to a higher-priority lane
+ * also asks a running lower-priority job to stop; that job is put back in its
+ * lane (unless replaced meanwhile) and called again once the higher lane is
+ * idle, so a long ghost pass never delays the solid image by more than a layer.
+ * The thread starts on the first submit.
+ */
+class LayerRasterWorker {
+  public:
+    /// Job body; return early once @p stop reads true
+    using Job = std::function<void(const std::atomic<bool>& stop)>;
+
+    LayerRasterWorker() = default;
+    ~LayerRasterWorker();
+
+    LayerRasterWorker(const LayerRasterWorker&) = delete;
+    LayerRasterWorker& operator=(const LayerRasterWorker&) = delete;
+
+    /// Queue @p job, replacing the lane's pending job and stopping its running one
+    /// (or pausing a running job of a lower-priority lane)
+    void submit(RasterLane lane, Job job);
+
+    /// Drop the lane's pending job and ask its running job to stop (does not wait)
+    void cancel(RasterLane lane);
+
+    /// Block until no job is running (pending jobs stay queued)
+    void wait_idle();
+
+    /// Stop every job and join the thread; later submits are ignored
+    void shutdown();
+
+    /// The lane has a pending or running job
+    bool is_busy(RasterLane lane) const;
+
+  private:
+    static constexpr size_t kLaneCount = 2;
+    static constexpr int kNoLane = -1;
+
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_; ///< Job submitted or shutdown
+    std::condition_variable idle_; ///< Job finished
+    std::array<Job, kLaneCount> pending_;
+    std::array<std::atomic<bool>, kLaneCount> stop_{};
+    int running_lane_ = kNoLane;
+    bool running_paused_ = false;    ///< Running job was stopped for a higher lane
+    bool running_abandoned_ = false; ///< Running job was replaced or cancelled
+    bool shutdown_ = false;
+    std::thread thread_;
+};
+
+} // namespace gcode
+} // namespace helix
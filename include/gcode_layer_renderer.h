@@ -4,6 +4,9 @@
 #pragma once
 
 #include "gcode_color_palette.h"
+#include "gcode_layer_raster.h"
+#include "gcode_lod.h"
+#include "gcode_object_table.h"
 #include "gcode_parser.h"
 #include "gcode_projection.h"
 #include "gcode_streaming_controller.h"
@@ -11,12 +14,13 @@
 #include <lvgl/lvgl.h>
 
 #include <atomic>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
 #include <optional>
 #include <string>
-#include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace helix {
 namespace gcode {
@@ -109,6 +113,19 @@ class GCodeLayerRenderer {
      */
     void set_current_layer(int layer);
 
+    /**
+     * @brief Set how far the printer has read into the G-code file
+     * @param position Byte offset (virtual_sdcard.file_position), 0 when not printing
+     *
+     * In FRONT view the current layer is then drawn only as far as the print
+     * has got, and each new position adds just the segments printed since the
+     * last one. A full redraw still follows layer steps backwards, zoom and
+     * exclusion changes.
+     */
+    void set_print_file_position(uint64_t position) {
+        print_file_position_ = position;
+    }
+
     /**
      * @brief Get current layer index
      * @return Current layer (0-based)
@@ -137,9 +154,9 @@ class GCodeLayerRenderer {
     /**
      * @brief Check if renderer needs more frames to complete caching
      *
-     * Progressive rendering renders N layers per frame to avoid UI blocking.
-     * After calling render(), check this method - if true, the caller should
-     * invalidate the widget to trigger another frame.
+     * The FRONT view's cached images are drawn on a worker thread and picked
+     * up by later render() calls. After calling render(), check this method -
+     * if true, the caller should invalidate the widget to trigger another frame.
      *
      * @return true if more frames are needed to complete solid or ghost cache
      */
@@ -253,6 +270,16 @@ class GCodeLayerRenderer {
      */
     bool is_ghost_build_running() const;
 
+    /// Worker frame time and publish-to-blit latency of the solid layer image
+    RasterStats get_solid_raster_stats() const {
+        return solid_chain_.stats();
+    }
+
+    /// Worker frame time and publish-to-blit latency of the ghost image
+    RasterStats get_ghost_raster_stats() const {
+        return ghost_chain_.stats();
+    }
+
     /// View mode alias — uses shared enum from gcode_projection.h
     using ViewMode = helix::gcode::ViewMode;
 
@@ -397,6 +424,8 @@ class GCodeLayerRenderer {
     bool has_support_detection() const;
 
   private:
+    friend class GCodeLayerRendererTestAccess;
+
     // =========================================================================
     // Internal Rendering
     // =========================================================================
@@ -409,6 +438,31 @@ class GCodeLayerRenderer {
      */
     void render_segment(lv_layer_t* layer, const ToolpathSegment& seg, bool ghost = false);
 
+    /**
+     * @brief Set a line descriptor's color, width and opacity for a segment
+     * @param dsc Initialized descriptor (points are left alone)
+     * @param seg Segment whose object, tool and type decide the style
+     * @param ghost If true, use the ghost style
+     */
+    void apply_segment_style(lv_draw_line_dsc_t& dsc, const ToolpathSegment& seg,
+                             bool ghost = false) const;
+
+    /**
+     * @brief Decimated geometry of a layer at the current zoom (TOP_DOWN / ISOMETRIC)
+     *
+     * Built from the visible segments on a miss and kept in lod_cache_.
+     *
+     * @param layer_idx Layer index (caller checks the range)
+     * @return nullptr if the layer has no data yet; valid until the next call
+     */
+    const LodLayer* get_lod_layer(int layer_idx);
+
+    /**
+     * @brief Draw a decimated layer, skipping polylines and edges outside the clip area
+     * @return Number of lines drawn
+     */
+    size_t render_lod_layer(lv_layer_t* layer, const LodLayer& lod);
+
     /**
      * @brief Render L-shaped corner brackets around highlighted objects' bounding boxes
      * @param layer LVGL draw layer
@@ -437,10 +491,9 @@ class GCodeLayerRenderer {
     /**
      * @brief Capture current transformation parameters as a thread-safe snapshot
      *
-     * The background ghost render thread calls this ONCE at thread start to
-     * snapshot all transform state (scale, offset, canvas size, etc.). Each
-     * field is a plain float/int read, and the main thread only modifies these
-     * between render() calls, so no additional synchronization is needed.
+     * Raster jobs take this snapshot on the main thread when they are
+     * submitted (scale, offset, canvas size, etc.), so the worker thread never
+     * reads transform state that the main thread may be changing.
      *
      * @return TransformParams struct with current values
      */
@@ -484,10 +537,44 @@ class GCodeLayerRenderer {
      */
     lv_color_t get_segment_color(const ToolpathSegment& seg) const;
 
+    /**
+     * @brief Call @p fn for each segment of a layer, from whichever source is loaded
+     *
+     * Streaming layers are packed (CompactSegments) and held by shared_ptr for
+     * the whole call, so the cache may evict them meanwhile. Full-file layers
+     * are read in place.
+     *
+     * @param layer_idx Layer index (caller checks the range)
+     * @param fn Callable taking `const ToolpathSegment&`
+     * @param first, last Only segments [first, last) of the layer
+     * @return false if the layer has no data
+     */
+    template <typename Fn>
+    bool for_each_layer_segment(int layer_idx, Fn&& fn, size_t first = 0,
+                                size_t last = SIZE_MAX) const;
+
+    /// Number of segments in a layer (0 if it has no data)
+    size_t layer_segment_count(int layer_idx) const;
+
+    /// Object table of the loaded file (a copy in streaming mode)
+    ObjectSymbolTable current_object_table() const;
+
+    /// Number of entries in current_object_table()
+    size_t current_object_count() const;
+
+    /**
+     * @brief Rebuild excluded_ids_ / highlighted_ids_ from the name sets
+     *
+     * Runs at the start of each frame. Streaming files learn object names as
+     * layers load, so the sets are rebuilt whenever the table has grown.
+     */
+    void resolve_object_ids();
+
     // Data source (exactly one should be non-null)
     const ParsedGCodeFile* gcode_ = nullptr;
     GCodeStreamingController* streaming_controller_ = nullptr;
     int current_layer_ = 0;
+    uint64_t print_file_position_ = 0; ///< 0 = draw the current layer whole
 
     // Canvas dimensions
     int canvas_width_ = 400;
@@ -516,9 +603,13 @@ class GCodeLayerRenderer {
     bool use_custom_support_color_ = false;
     GCodeColorPalette tool_palette_; ///< Per-tool colors for multi-color prints
 
-    // Object exclusion/highlight state
+    // Object exclusion/highlight state: names as set by the UI, and the same
+    // sets as object ids for per-segment tests (see resolve_object_ids())
     std::unordered_set<std::string> excluded_objects_;
     std::unordered_set<std::string> highlighted_objects_;
+    ObjectIdSet excluded_ids_;
+    ObjectIdSet highlighted_ids_;
+    size_t resolved_object_count_ = SIZE_MAX; ///< Object table size the id sets match
 
     // Cached bounds
     float bounds_min_x_ = 0.0f;
@@ -529,6 +620,20 @@ class GCodeLayerRenderer {
     float bounds_max_z_ = 0.0f;
     bool bounds_valid_ = false;
 
+    // Decimated layers for TOP_DOWN / ISOMETRIC, least recently used replaced first.
+    // Colors and exclusion are applied at draw time, so only the layer, zoom
+    // bucket and visibility toggles select an entry.
+    struct LodCacheEntry {
+        int layer = -1;
+        int zoom_bucket = 0;
+        uint8_t visibility = 0; ///< show_* flags the entry was built with
+        uint64_t last_used = 0;
+        LodLayer lod;
+    };
+    static constexpr size_t LOD_CACHE_ENTRIES = 8;
+    std::vector<LodCacheEntry> lod_cache_;
+    uint64_t lod_cache_clock_ = 0;
+
     // Widget screen offset (set during render())
     int widget_offset_x_ = 0;
     int widget_offset_y_ = 0;
@@ -542,8 +647,9 @@ class GCodeLayerRenderer {
     // Note: We only use draw buffers (no canvas widgets) to avoid clip area
     // contamination from overlays/toasts on lv_layer_top().
     lv_draw_buf_t* cache_buf_ = nullptr;
-    int cached_up_to_layer_ = -1; // Highest layer rendered in cache
-    int cached_width_ = 0;        // Dimensions cache was built for
+    int cached_up_to_layer_ = -1;    // Highest layer shown in cache_buf_
+    uint64_t cache_buf_version_ = 0; // Solid image version cache_buf_ holds (0 = none)
+    int cached_width_ = 0;           // Dimensions cache was built for
     int cached_height_ = 0;
 
     // Ghost cache - all layers rendered once at reduced opacity
@@ -556,26 +662,16 @@ class GCodeLayerRenderer {
     std::atomic<bool> ghost_mode_enabled_{true}; // Enable ghost mode by default
     int ghost_rendered_up_to_ = -1;              // Progress tracker for progressive ghost rendering
 
-    // Progressive rendering - render N layers per frame to avoid blocking UI
-    // These are defaults; actual values come from config or adaptive adjustment
+    // Progressive reveal - the worker publishes the solid image every N layers
+    // (or every adaptive_target_ms_ when N comes from config as 0)
     static constexpr int DEFAULT_LAYERS_PER_FRAME = 15;
     static constexpr int MIN_LAYERS_PER_FRAME = 1;
     static constexpr int MAX_LAYERS_PER_FRAME = 100;
     static constexpr int DEFAULT_ADAPTIVE_TARGET_MS = 16; // ~60 FPS
 
-    // Constrained device limits (AD5M, low-RAM embedded < 256MB)
-    static constexpr int CONSTRAINED_START_LPF = 5;
-    static constexpr int CONSTRAINED_MAX_LPF = 15;
-    static constexpr float CONSTRAINED_GROWTH_CAP = 1.3f; // vs 2.0f normal
-
-    int layers_per_frame_{DEFAULT_LAYERS_PER_FRAME}; ///< Current layers per frame (may be adaptive)
-    int config_layers_per_frame_{0};                 ///< Config value (0 = adaptive)
-    int adaptive_target_ms_{DEFAULT_ADAPTIVE_TARGET_MS}; ///< Target render time for adaptive mode
-    uint32_t last_frame_render_ms_{0}; ///< Render time of last frame (for adaptive)
-
-    // Device-aware limits
-    bool is_constrained_device_{false};              ///< True if device has < 256MB RAM
-    int max_layers_per_frame_{MAX_LAYERS_PER_FRAME}; ///< Device-adjusted max (15 on constrained)
+    int layers_per_frame_{DEFAULT_LAYERS_PER_FRAME}; ///< Layers drawn between fixed publishes
+    int config_layers_per_frame_{0};                 ///< Config value (0 = publish by time)
+    int adaptive_target_ms_{DEFAULT_ADAPTIVE_TARGET_MS}; ///< Publish interval when time-based
 
     // Warm-up frames: skip heavy rendering for first N frames to let panel layout complete
     static constexpr int WARMUP_FRAMES = 2;
@@ -584,12 +680,8 @@ class GCodeLayerRenderer {
     /// Load config values from helixconfig.json
     void load_config();
 
-    /// Adjust layers_per_frame based on last render time (when config_layers_per_frame_ == 0)
-    void adapt_layers_per_frame();
-
     void invalidate_cache();
     void ensure_cache(int width, int height);
-    void render_layers_to_cache(int from_layer, int to_layer);
     void blit_cache(lv_layer_t* target);
     void destroy_cache();
 
@@ -600,57 +692,104 @@ class GCodeLayerRenderer {
     void destroy_ghost_cache();
 
     // =========================================================================
-    // Background Thread Ghost Rendering
+    // Off-thread Rasterization
     // =========================================================================
-    // LVGL is not thread-safe, so background thread renders to a raw pixel
-    // buffer using software Bresenham line drawing, then copies to LVGL buffer
-    // on main thread when complete.
-
-    /// Raw pixel buffer for background thread rendering (ARGB8888)
-    std::unique_ptr<uint8_t[]> ghost_raw_buffer_;
-    int ghost_raw_width_ = 0;
-    int ghost_raw_height_ = 0;
-    int ghost_raw_stride_ = 0; // Bytes per row
-
-    /// Background thread management (works for both streaming and non-streaming modes)
-    std::thread ghost_thread_;
-    std::atomic<bool> ghost_thread_cancel_{false};
-    std::atomic<bool> ghost_thread_running_{false};
-    std::atomic<bool> ghost_thread_ready_{false}; // True when raw buffer is complete
-
-    /// Start background ghost rendering (called when new gcode loaded)
-    void start_background_ghost_render();
+    // LVGL is not thread-safe, so the worker draws into RasterImages with its
+    // own anti-aliased line kernel and publishes them through a swap chain.
+    // The main thread only copies a newly published image into cache_buf_ /
+    // ghost_buf_ and blits. Jobs run on a snapshot taken at submit time.
+
+    /// Everything a raster job reads besides the segments themselves
+    struct RasterPass {
+        uint64_t generation = 0;
+        TransformParams transform;
+        float line_width = 1.0f;
+        int target_layer = -1;      ///< Solid: draw up to here; ghost: last layer
+        uint64_t file_position = 0; ///< Solid: print position in target_layer (0 = all)
+        bool show_travels = false;
+        bool show_extrusions = true;
+        bool show_supports = true;
+        bool depth_shading = false;
+        lv_color_t color_extrusion;
+        GCodeColorPalette tool_palette;
+        std::unordered_set<std::string> excluded_names; ///< Ghost re-resolves as names load
+        ObjectIdSet excluded_ids;
+        ObjectIdSet highlighted_ids;
+        float bounds_min_y = 0.0f;
+        float bounds_max_y = 0.0f;
+        float bounds_min_z = 0.0f;
+        float bounds_max_z = 0.0f;
+        int layers_per_publish = 0; ///< 0 = publish every publish_interval_ms
+        int publish_interval_ms = DEFAULT_ADAPTIVE_TARGET_MS;
+    };
+
+    LayerRasterWorker raster_worker_;
+    RasterSwapChain solid_chain_;
+    RasterSwapChain ghost_chain_;
+
+    // Main thread: what the cached images must match and what was last submitted
+    uint64_t solid_generation_ = 1;
+    uint64_t ghost_generation_ = 1;
+    uint64_t solid_submitted_generation_ = 0;
+    int solid_submitted_layer_ = -1;
+    uint64_t solid_submitted_file_position_ = 0;
+    uint64_t ghost_submitted_generation_ = 0;
+
+    // Worker thread only: contents of the solid chain's back image
+    uint64_t solid_drawn_generation_ = 0;
+    int solid_drawn_layer_ = -1;      ///< Layers up to here are drawn whole
+    size_t solid_drawn_segments_ = 0; ///< Leading segments drawn of the layer above
+
+    // Worker thread only: progress of the ghost chain's back image (a ghost
+    // pass pauses whenever a solid job is queued and resumes from here)
+    uint64_t ghost_drawn_generation_ = 0;
+    int ghost_drawn_layer_ = -1; ///< Layers up to here are drawn (or published, if the last)
+
+    /// Snapshot the state a raster job needs (main thread)
+    RasterPass capture_raster_pass(uint64_t generation, int target_layer, int width,
+                                   int height) const;
 
-    /// Cancel any in-progress background ghost render
-    void cancel_background_ghost_render();
+    /// Queue drawing of the solid image up to @p target_layer
+    void submit_solid_raster(int target_layer);
 
-    /// Background thread entry point (renders all layers to raw buffer)
-    void background_ghost_render_thread();
+    /// Queue drawing of the ghost image (called when the ghost cache is invalid)
+    void start_background_ghost_render();
 
-    /// Copy completed raw buffer to LVGL ghost_buf_ (called on main thread)
-    void copy_raw_to_ghost_buf();
+    /// Stop raster jobs and wait until none is reading the data source
+    void stop_raster_jobs();
 
-    /// Software Bresenham line drawing to raw ARGB8888 buffer (ghost)
-    void draw_line_bresenham(int x0, int y0, int x1, int y1, uint32_t color);
+    /// Worker: continue (or restart) the solid image up to pass.target_layer
+    void raster_solid_layers(const RasterPass& pass, const std::atomic<bool>& stop);
 
-    /// Thick line drawing using parallel Bresenham lines (ghost buffer)
-    void draw_thick_line_bresenham(int x0, int y0, int x1, int y1, uint32_t color, int width);
+    /**
+     * @brief Worker: how many of a layer's @p count segments the print has reached
+     *
+     * Segments carry no file offsets, so pass.file_position is placed within
+     * the layer's byte range and scaled to the segment count (moves are
+     * evenly sized lines). Layers without a known range count as printed.
+     */
+    size_t printed_segment_count(const RasterPass& pass, int layer_idx, size_t count) const;
 
-    /// Blend a pixel with alpha into the ghost raw buffer
-    void blend_pixel(int x, int y, uint32_t color);
+    /// Worker: draw every layer into the ghost image, continuing a paused pass
+    void raster_ghost_layers(const RasterPass& pass, const std::atomic<bool>& stop);
 
-    /// Software Bresenham line drawing to solid cache buffer
-    /// Used for solid layer rendering, bypassing LVGL draw API for AD5M compatibility
-    void draw_line_bresenham_solid(int x0, int y0, int x1, int y1, uint32_t color);
+    /// Main thread: copy a newly published image into its LVGL buffer
+    void take_solid_frame();
+    void take_ghost_frame();
 
-    /// Thick line drawing using parallel Bresenham lines (solid cache)
-    void draw_thick_line_bresenham_solid(int x0, int y0, int x1, int y1, uint32_t color, int width);
+    /**
+     * @brief Copy @p image into @p buf honoring the buffer's stride (sizes must match)
+     * @param since_version Version of the same chain @p buf already holds; only
+     *                      rows changed after it are copied (0 = copy all)
+     */
+    static bool copy_image_to_draw_buf(const RasterImage& image, lv_draw_buf_t* buf,
+                                       uint64_t since_version = 0);
 
-    /// Blend a pixel directly into the solid LVGL cache buffer
-    void blend_pixel_solid(int x, int y, uint32_t color);
+    /// should_render_segment() against the pass's visibility snapshot
+    bool pass_shows_segment(const RasterPass& pass, const ToolpathSegment& seg) const;
 
     /// Compute line width in pixels from extrusion width metadata and current scale
-    int get_extrusion_pixel_width() const;
+    float get_extrusion_pixel_width() const;
 };
 
 } // namespace gcode
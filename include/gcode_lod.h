@@ -0,0 +1,132 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_lod.h
+ * @brief Level-of-detail polylines for drawing one layer at a given zoom
+ *
+ * @pattern Feed a layer's visible segments to a PolylineDecimator, draw the
+ *          resulting LodLayer until the zoom bucket changes
+ * @threading A LodLayer is immutable once built; a decimator belongs to one thread
+ * @gotchas XY only: the result is for the TOP_DOWN and ISOMETRIC projections,
+ *          which ignore Z. Decimation error is bounded in world millimetres;
+ *          pick the tolerance with lod_tolerance_mm() to bound it in pixels.
+ */
+
+#pragma once
+
+#include "gcode_parser.h"
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/// Largest on-screen deviation allowed by lod_tolerance_mm(), in pixels
+constexpr float LOD_MAX_ERROR_PX = 0.5f;
+
+/// Zoom buckets per doubling of the scale
+constexpr int LOD_BUCKETS_PER_OCTAVE = 4;
+
+/**
+ * @brief Quantize a pixels-per-mm scale to a zoom bucket
+ *
+ * lod_bucket_scale(lod_zoom_bucket(s)) is never below @p s, so geometry
+ * decimated for a bucket holds its pixel error bound at every scale in it.
+ */
+int lod_zoom_bucket(float scale);
+
+/// Largest scale in a zoom bucket (pixels per mm)
+float lod_bucket_scale(int bucket);
+
+/**
+ * @brief World-space tolerance for a zoom bucket
+ *
+ * Both 2D projections are rotations plus at most a uniform scale and a
+ * compression, so a world deviation of d mm is at most d * scale pixels.
+ */
+float lod_tolerance_mm(int bucket, float max_error_px = LOD_MAX_ERROR_PX);
+
+/**
+ * @brief A run of chained, identically styled segments, simplified
+ */
+struct LodPolyline {
+    /// First source segment; every merged segment shares its extrusion flag,
+    /// tool and object, so it stands in for all of them when choosing colours
+    ToolpathSegment style;
+    std::vector<glm::vec2> points; ///< At least two vertices
+    glm::vec2 min{0.0f, 0.0f};     ///< XY bounds of points
+    glm::vec2 max{0.0f, 0.0f};
+};
+
+/**
+ * @brief Decimated geometry of one layer at one zoom bucket
+ */
+struct LodLayer {
+    std::vector<LodPolyline> polylines;
+    AABB bounds;                ///< Bounds of all source segments
+    size_t source_segments = 0; ///< Segments passed to the decimator
+
+    /// Number of lines needed to draw the layer
+    size_t edge_count() const;
+};
+
+/**
+ * @brief Merges collinear and sub-tolerance segments into polylines
+ *
+ * Consecutive segments are joined while each starts within the tolerance of
+ * the previous end and has the same extrusion flag, tool and object. Within a
+ * polyline a vertex is dropped when every point skipped since the last kept
+ * vertex stays within the tolerance of the new edge, so straight runs and
+ * sub-pixel zig-zags (arcs, gyroid infill at low zoom) become single edges
+ * while every source vertex stays within the tolerance of the result.
+ *
+ * Runs in one pass; at most MAX_SKIPPED points are held back per edge.
+ *
+ * @code
+ *   int bucket = lod_zoom_bucket(scale);
+ *   PolylineDecimator decimator(lod_tolerance_mm(bucket));
+ *   for (const auto& seg : segments) {
+ *       decimator.add(seg);
+ *   }
+ *   LodLayer lod = decimator.finish();
+ * @endcode
+ */
+class PolylineDecimator {
+  public:
+    /// Skipped points checked per candidate edge before a vertex is forced
+    static constexpr size_t MAX_SKIPPED = 32;
+
+    /// @param tolerance_mm Largest distance of a source vertex from the result
+    explicit PolylineDecimator(float tolerance_mm);
+
+    /// Append the next segment in drawing order
+    void add(const ToolpathSegment& seg);
+
+    /// Flush the last polyline and return the layer; the decimator is reset
+    LodLayer finish();
+
+  private:
+    /// Whether @p seg continues the open polyline
+    bool continues(const ToolpathSegment& seg) const;
+
+    /// Extend the open polyline to @p point
+    void extend(const glm::vec2& point);
+
+    /// Close the open polyline (dropped if it has no length)
+    void close_polyline();
+
+    float tolerance_;
+    float tolerance_sq_;
+    LodLayer layer_;
+    bool open_ = false;
+    LodPolyline current_;
+    glm::vec2 candidate_{0.0f, 0.0f}; ///< Latest point, not yet committed as a vertex
+    bool has_candidate_ = false;
+    std::vector<glm::vec2> skipped_; ///< Points dropped since the last vertex
+};
+
+} // namespace gcode
+} // namespace helix
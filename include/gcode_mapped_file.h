@@ -0,0 +1,47 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_mapped_file.h
+ * @brief Read-only memory mapping of a whole G-code file
+ *
+ * @pattern RAII: unmapped on destruction
+ * @threading The mapping is immutable; any number of threads may read it
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Read-only mapping of a whole file, unmapped on destruction
+ */
+class MappedFile {
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /// Map @p path; false (and nothing mapped) for empty files or if mmap is unavailable
+    bool open(const std::string& path);
+
+    const char* data() const {
+        return static_cast<const char*>(data_);
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+  private:
+    void* data_{nullptr};
+    size_t size_{0};
+};
+
+} // namespace gcode
+} // namespace helix
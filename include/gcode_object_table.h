@@ -0,0 +1,137 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_object_table.h
+ * @brief Dense ids for EXCLUDE_OBJECT names, and bitsets over them
+ *
+ * @pattern Append-only symbol table; ids are indices into it
+ * @threading Not synchronised; owners guard shared tables themselves
+ * @gotchas Ids are only meaningful together with the table that issued them
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/// Dense object id (index into an ObjectSymbolTable)
+using ObjectId = uint16_t;
+
+/// Id of segments outside any object
+constexpr ObjectId NO_OBJECT_ID = 0xFFFF;
+
+/**
+ * @brief Set of object ids, one bit per id
+ *
+ * Replaces `std::unordered_set<std::string>` lookups in per-segment loops:
+ * test() is a shift and a mask, and NO_OBJECT_ID is never a member.
+ */
+class ObjectIdSet {
+  public:
+    bool test(ObjectId id) const {
+        size_t word = id / 64;
+        return word < words_.size() && (words_[word] >> (id % 64)) & 1;
+    }
+
+    void set(ObjectId id) {
+        if (id == NO_OBJECT_ID) {
+            return;
+        }
+        size_t word = id / 64;
+        if (word >= words_.size()) {
+            words_.resize(word + 1, 0);
+        }
+        words_[word] |= uint64_t{1} << (id % 64);
+    }
+
+    void reset(ObjectId id) {
+        size_t word = id / 64;
+        if (word < words_.size()) {
+            words_[word] &= ~(uint64_t{1} << (id % 64));
+        }
+    }
+
+    void clear() {
+        words_.clear();
+    }
+
+    bool any() const;
+    size_t count() const;
+
+    bool operator==(const ObjectIdSet& other) const;
+    bool operator!=(const ObjectIdSet& other) const {
+        return !(*this == other);
+    }
+
+  private:
+    std::vector<uint64_t> words_;
+};
+
+/**
+ * @brief Per-file table mapping object names to dense ids
+ *
+ * The parser interns each name when it is first defined or started, so ids
+ * follow EXCLUDE_OBJECT_DEFINE order. Segments carry the id, and consumers
+ * resolve name sets to an ObjectIdSet once instead of hashing strings per
+ * segment.
+ *
+ * @code
+ *   ObjectIdSet excluded = gcode.object_table.to_id_set(excluded_names);
+ *   for (const auto& seg : layer.segments) {
+ *       if (excluded.test(seg.object_id)) { ... }
+ *   }
+ * @endcode
+ */
+class ObjectSymbolTable {
+  public:
+    /// Maximum number of distinct names (ids 0 .. MAX_OBJECTS-1)
+    static constexpr size_t MAX_OBJECTS = NO_OBJECT_ID;
+
+    /**
+     * @brief Id for @p name, adding it if new
+     * @return NO_OBJECT_ID for an empty name or when the table is full
+     */
+    ObjectId intern(std::string_view name);
+
+    /**
+     * @brief Id for @p name without adding it
+     * @return NO_OBJECT_ID if unknown
+     */
+    ObjectId find(std::string_view name) const;
+
+    /// Name for @p id (empty string for NO_OBJECT_ID or an unknown id)
+    const std::string& name(ObjectId id) const;
+
+    /// All names, indexed by id
+    const std::vector<std::string>& names() const {
+        return names_;
+    }
+
+    size_t size() const {
+        return names_.size();
+    }
+    bool empty() const {
+        return names_.empty();
+    }
+
+    void clear();
+
+    /// Ids of the known names in @p names (unknown names are skipped)
+    ObjectIdSet to_id_set(const std::unordered_set<std::string>& names) const;
+
+  private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, ObjectId> ids_;
+};
+
+} // namespace gcode
+} // namespace helix
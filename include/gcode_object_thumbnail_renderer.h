@@ -12,7 +12,6 @@
 #include <memory>
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <vector>
 
 namespace helix::gcode {
@@ -69,7 +68,7 @@ using ThumbnailCompleteCallback = std::function<void(std::unique_ptr<ObjectThumb
  * @brief Renders per-object toolpath thumbnails from parsed G-code
  *
  * Single-pass algorithm: iterates all segments once, dispatching each to the
- * correct object's pixel buffer based on segment.object_name. Runs in a
+ * correct object's pixel buffer based on segment.object_id. Runs in a
  * background thread with cancellation support.
  *
  * Usage:
@@ -155,15 +154,17 @@ class GCodeObjectThumbnailRenderer {
      * @brief Core render function (runs in background thread or synchronously)
      *
      * Single pass through all layers and segments. Each segment is dispatched
-     * to its object's pixel buffer based on object_name.
+     * to its object's pixel buffer based on object_id.
      */
     std::unique_ptr<ObjectThumbnailSet> render_impl(const ParsedGCodeFile* gcode, int thumb_width,
                                                     int thumb_height, uint32_t color);
 
     /**
-     * @brief Build render contexts from object AABBs
+     * @brief Build render contexts from object AABBs, indexed by ObjectId
+     *
+     * Objects with an empty bounding box get a context with no pixel buffer.
      */
-    std::unordered_map<std::string, ObjectRenderContext>
+    std::vector<ObjectRenderContext>
     build_contexts(const ParsedGCodeFile* gcode, int thumb_width, int thumb_height);
 
     /**
@@ -0,0 +1,185 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_parallel.h
+ * @brief Fork/join helpers for splitting G-code work across threads
+ *
+ * @pattern parallel_for(): one short-lived std::thread per task, task 0 on the caller.
+ *          WorkerPool: persistent threads for work that forks many times per frame.
+ * @threading Both block until every task has finished
+ * @gotchas Tasks must not throw; catch inside the task and report through its output
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Worker count for @p work_units units of work
+ * @param max_threads Caller's limit (0 = one per core)
+ * @param work_units Total amount of work (bytes, segments, ...)
+ * @param min_units_per_thread Smallest share worth a thread of its own
+ */
+inline unsigned parallel_thread_count(unsigned max_threads, size_t work_units,
+                                      size_t min_units_per_thread) {
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t useful = std::max<size_t>(1, work_units / std::max<size_t>(1, min_units_per_thread));
+    return static_cast<unsigned>(std::min<size_t>(max_threads, useful));
+}
+
+/**
+ * @brief Run fn(0) .. fn(count - 1) concurrently and wait for all of them
+ *
+ * If a thread cannot be created (e.g. RLIMIT_NPROC on small boards) that task
+ * runs inline instead, so the result never depends on how many threads started.
+ */
+template <typename Fn> void parallel_for(size_t count, Fn&& fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; ++i) {
+        try {
+            workers.emplace_back([&fn, i]() { fn(i); });
+        } catch (const std::system_error& e) {
+            spdlog::debug("[GCode] Running task {} inline: {}", i, e.what());
+            fn(i);
+        }
+    }
+    if (count > 0) {
+        fn(0);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Persistent fork/join pool for work split many times per frame
+ *
+ * run() hands tasks out dynamically to the workers and the calling thread, so
+ * results must depend only on the task index, never on which thread ran it.
+ * Not reentrant: call run() from one thread at a time, never from inside a task.
+ */
+class WorkerPool {
+  public:
+    /// @param threads Participants including the caller (0 = one per core)
+    explicit WorkerPool(unsigned threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i) {
+            try {
+                workers_.emplace_back([this]() { worker_loop(); });
+            } catch (const std::system_error& e) {
+                spdlog::debug("[GCode] Worker pool limited to {} threads: {}", i, e.what());
+                break;
+            }
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Threads that take part in run(), the caller included
+    unsigned size() const {
+        return static_cast<unsigned>(workers_.size()) + 1;
+    }
+
+    /// Run fn(0) .. fn(count - 1) across the pool and wait for all of them
+    void run(size_t count, const std::function<void(size_t)>& fn) {
+        if (workers_.empty() || count <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &fn;
+            job_count_ = count;
+            next_task_.store(0, std::memory_order_relaxed);
+            busy_workers_ = workers_.size();
+            ++generation_;
+        }
+        wake_cv_.notify_all();
+        drain(fn, count);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this]() { return busy_workers_ == 0; });
+        job_ = nullptr;
+    }
+
+  private:
+    void drain(const std::function<void(size_t)>& fn, size_t count) {
+        for (size_t i = next_task_.fetch_add(1); i < count; i = next_task_.fetch_add(1)) {
+            fn(i);
+        }
+    }
+
+    void worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* job = nullptr;
+            size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_cv_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                job = job_;
+                count = job_count_;
+            }
+            drain(*job, count);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--busy_workers_ == 0) {
+                    done_cv_.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t job_count_ = 0;
+    std::atomic<size_t> next_task_{0};
+    size_t busy_workers_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace gcode
+} // namespace helix
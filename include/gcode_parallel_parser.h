@@ -0,0 +1,84 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_parallel_parser.h
+ * @brief Full-file G-code parse split across threads by layer-aligned byte ranges
+ *
+ * @pattern Scan ranges backwards for their modal state, fold it forward, parse
+ *          each range with a seeded GCodeParser, then stitch the results
+ * @threading parse() blocks; worker threads only read the input buffer
+ * @gotchas A range whose start depends on G91 (relative XYZ) state is merged
+ *          into its predecessor and parsed sequentially
+ */
+
+#pragma once
+
+#include "gcode_parser.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Drop-in replacement for GCodeParser + finalize() on a whole buffer
+ *
+ * Produces the same ParsedGCodeFile as parsing the buffer line by line:
+ *
+ * 1. Split the buffer at roughly equal offsets, nudged to the next layer
+ *    marker line so ranges start on a layer boundary.
+ * 2. Scan each range backwards (in parallel) for the state it leaves behind:
+ *    last position words, G90/G91, M82/M83, tool, object, wipe tower, layer
+ *    markers and layer height metadata.
+ * 3. Fold those summaries forward to get every range's entry state.
+ * 4. Parse the ranges in parallel, each with a parser seeded from its entry state.
+ * 5. Concatenate layers (joining a layer split across two ranges), re-number
+ *    object ids and merge metadata.
+ *
+ * @code
+ *   ParallelGCodeParser parser;
+ *   auto parsed = parser.parse_file(path); // std::nullopt if the file can't be mapped
+ * @endcode
+ */
+class ParallelGCodeParser {
+  public:
+    /// Smallest range worth a parsing thread of its own
+    static constexpr size_t MIN_RANGE_BYTES = 2 * 1024 * 1024;
+
+    /**
+     * @brief Limit the threads used by parse() (0 = one per core, 1 = single-threaded)
+     */
+    void set_max_threads(unsigned threads) {
+        max_threads_ = threads;
+    }
+
+    /**
+     * @brief Override MIN_RANGE_BYTES (tests use tiny ranges to exercise the seams)
+     */
+    void set_min_range_bytes(size_t bytes) {
+        min_range_bytes_ = bytes;
+    }
+
+    /**
+     * @brief Parse a whole G-code buffer
+     * @param data File contents
+     * @param size Number of bytes
+     */
+    ParsedGCodeFile parse(const char* data, size_t size) const;
+
+    /**
+     * @brief Memory-map and parse a file
+     * @return std::nullopt if the file cannot be mapped (caller should stream it instead)
+     */
+    std::optional<ParsedGCodeFile> parse_file(const std::string& path) const;
+
+  private:
+    unsigned max_threads_{0};
+    size_t min_range_bytes_{MIN_RANGE_BYTES};
+};
+
+} // namespace gcode
+} // namespace helix
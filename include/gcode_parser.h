@@ -5,18 +5,22 @@
  * @file gcode_parser.h
  * @brief Streaming G-code parser extracting toolpath, layers, and metadata
  *
- * @pattern Line-by-line streaming (no full buffer); layer-indexed geometry
+ * @pattern Line-by-line streaming (no full buffer); layer-indexed geometry; lines are
+ *          tokenized in place (gcode_tokenizer.h), no per-line allocations
  * @threading Main thread only
  * @gotchas clear_segments() frees 40-160MB after geometry build; layer detection via Z changes
  */
 
 #pragma once
 
+#include "gcode_object_table.h"
+
 #include <glm/glm.hpp>
 #include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace helix {
@@ -76,6 +80,7 @@ struct ToolpathSegment {
     glm::vec3 start{0.0f, 0.0f, 0.0f}; ///< Start point (X, Y, Z)
     glm::vec3 end{0.0f, 0.0f, 0.0f};   ///< End point (X, Y, Z)
     bool is_extrusion{false};          ///< true if extruding, false if travel move
+    ObjectId object_id{NO_OBJECT_ID};  ///< Id of object_name in the file's object_table
     std::string object_name;           ///< Object name (from EXCLUDE_OBJECT_START) or
                                        ///< empty
     float extrusion_amount{0.0f};      ///< E-axis delta (mm of filament)
@@ -96,6 +101,11 @@ struct Layer {
     AABB bounding_box;                     ///< Precomputed spatial bounds
     size_t segment_count_extrusion{0};     ///< Count of extrusion moves
     size_t segment_count_travel{0};        ///< Count of travel moves
+
+    /// File range of the layer's moves, first move line to past the last one
+    /// (only set by parse_buffer(); byte_length 0 = unknown)
+    uint64_t file_offset{0};
+    uint32_t byte_length{0};
 };
 
 /**
@@ -122,6 +132,7 @@ struct ParsedGCodeFile {
     std::string filename;                       ///< Source filename
     std::vector<Layer> layers;                  ///< Indexed by layer number
     std::map<std::string, GCodeObject> objects; ///< Object metadata (name → object)
+    ObjectSymbolTable object_table;             ///< Object name ↔ ToolpathSegment::object_id
     AABB global_bounding_box;                   ///< Bounds of entire model
 
     // Statistics
@@ -167,6 +178,14 @@ struct ParsedGCodeFile {
      */
     int find_layer_at_z(float z) const;
 
+    /**
+     * @brief Rebuild object_table and every segment's object_id from names
+     *
+     * The parser assigns ids as it goes; call this after building or editing
+     * a file by hand. Defined objects are interned first, in name order.
+     */
+    void index_objects();
+
     /**
      * @brief Clear segment data to free memory
      *
@@ -195,22 +214,42 @@ struct ParsedGCodeFile {
     }
 };
 
+/**
+ * @brief Parser state carried from one line of a file to the next
+ *
+ * Everything a GCodeParser needs to resume parsing mid-file as if it had
+ * read the file from the start: seed a parser with set_modal_state() and feed
+ * it any line-aligned range (see ParallelGCodeParser).
+ */
+struct GCodeModalState {
+    glm::vec3 position{0.0f, 0.0f, 0.0f}; ///< Current XYZ position
+    float e{0.0f};                        ///< Current E position
+    bool absolute_positioning{true};      ///< G90 (true) / G91 (false)
+    bool absolute_extrusion{true};        ///< M82 (true) / M83 (false)
+    int tool_index{0};                    ///< Active tool
+    std::string object_name;              ///< Object from EXCLUDE_OBJECT_START ("" = none)
+    bool in_wipe_tower{false};            ///< Inside a WIPE_TOWER_START/END section
+    bool use_layer_markers{false};        ///< A ;LAYER_CHANGE marker was seen earlier
+    float layer_height_mm{0.2f};          ///< Layer height metadata (used for widths)
+    bool has_moved{false};                ///< An XY move was seen earlier (see add_segment())
+};
+
 /**
  * @brief Streaming G-code parser
  *
  * Usage pattern:
  * @code
  *   GCodeParser parser;
- *   std::ifstream file("model.gcode");
- *   std::string line;
- *   while (std::getline(file, line)) {
- *       parser.parse_line(line);
+ *   std::ifstream file("model.gcode", std::ios::binary);
+ *   std::vector<char> chunk(64 * 1024);
+ *   while (file.read(chunk.data(), chunk.size()) || file.gcount() > 0) {
+ *       parser.parse_buffer(chunk.data(), static_cast<size_t>(file.gcount()));
  *   }
  *   ParsedGCodeFile result = parser.finalize();
  * @endcode
  *
- * The parser maintains state across parse_line() calls and accumulates
- * data. Call finalize() once when complete to get the final result.
+ * The parser maintains state across parse_line() / parse_buffer() calls and
+ * accumulates data. Call finalize() once when complete to get the final result.
  */
 class GCodeParser {
   public:
@@ -224,7 +263,18 @@ class GCodeParser {
      * Extracts movement commands, coordinate changes, and object metadata.
      * Automatically detects layer changes (Z-axis movement).
      */
-    void parse_line(const std::string& line);
+    void parse_line(std::string_view line);
+
+    /**
+     * @brief Parse a block of G-code text
+     * @param data Raw bytes (any number of lines, '\n' or "\r\n" terminated)
+     * @param size Number of bytes
+     *
+     * Splits lines in place and feeds them to parse_line(). Blocks may end
+     * mid-line; the partial line is kept until the next block, or parsed by
+     * finalize() if the file does not end with a newline.
+     */
+    void parse_buffer(const char* data, size_t size);
 
     /**
      * @brief Finalize parsing and return complete data structure
@@ -268,6 +318,43 @@ class GCodeParser {
         return layers_.size() - 1;
     }
 
+    /**
+     * @brief Resume from the state at another point in the file
+     *
+     * Call on a fresh parser before the first line. Objects named here but
+     * defined in an earlier part of the file get ids, not definitions.
+     */
+    void set_modal_state(const GCodeModalState& state);
+
+    /**
+     * @brief Snapshot of the state after the lines parsed so far
+     */
+    GCodeModalState modal_state() const;
+
+    /**
+     * @brief Set the file offset of the next parse_buffer() byte
+     *
+     * For parsing a range of a file, so Layer::file_offset stays relative to
+     * the file rather than the range.
+     */
+    void set_byte_offset(uint64_t offset) {
+        byte_offset_ = offset;
+    }
+
+    /**
+     * @brief Layer height from a "; layer_height = 0.2" or ";Layer height: 0.2" comment
+     * @param comment Comment including its leading ';'
+     * @return false if the comment is anything else
+     */
+    static bool parse_layer_height_comment(std::string_view comment, float& height_mm);
+
+    /**
+     * @brief Recognise WIPE_TOWER_START/END (and _BRIM_) markers in a comment
+     * @param entering Set to true for a start marker, false for an end marker
+     * @return false if the comment is not a wipe tower marker
+     */
+    static bool parse_wipe_tower_comment(std::string_view comment, bool& entering);
+
     /**
      * @brief Get tool color palette parsed from metadata
      * @return Vector of hex color strings (e.g., ["#ED1C24", "#00C1AE"])
@@ -286,14 +373,14 @@ class GCodeParser {
      * @param line Trimmed G-code line
      * @return true if parsed successfully
      */
-    bool parse_movement_command(const std::string& line);
+    bool parse_movement_command(std::string_view line);
 
     /**
      * @brief Parse EXCLUDE_OBJECT_* command
      * @param line Trimmed G-code line
      * @return true if parsed successfully
      */
-    bool parse_exclude_object_command(const std::string& line);
+    bool parse_exclude_object_command(std::string_view line);
 
     /**
      * @brief Parse slicer metadata from comment line
@@ -305,7 +392,7 @@ class GCodeParser {
      * - "; estimated printing time (normal mode) = 29m 25s"
      * - "; printer_model = Flashforge Adventurer 5M Pro"
      */
-    void parse_metadata_comment(const std::string& line);
+    void parse_metadata_comment(std::string_view line);
 
     /**
      * @brief Parse extruder color palette from header metadata
@@ -314,7 +401,7 @@ class GCodeParser {
      * Extracts semicolon-separated hex color values for multi-color prints.
      * Format: "; extruder_colour = #ED1C24;#00C1AE;#F4E2C1;#000000"
      */
-    void parse_extruder_color_metadata(const std::string& line);
+    void parse_extruder_color_metadata(std::string_view line);
 
     /**
      * @brief Parse tool change command (T0, T1, T2, etc.)
@@ -322,7 +409,7 @@ class GCodeParser {
      *
      * Updates current_tool_index_ when tool change commands are encountered.
      */
-    void parse_tool_change_command(const std::string& line);
+    void parse_tool_change_command(std::string_view line);
 
     /**
      * @brief Parse wipe tower markers from comments
@@ -330,26 +417,7 @@ class GCodeParser {
      *
      * Detects WIPE_TOWER_START/END markers for optional wipe tower filtering.
      */
-    void parse_wipe_tower_marker(const std::string& comment);
-
-    /**
-     * @brief Extract parameter value from G-code line
-     * @param line G-code line
-     * @param param Parameter letter (e.g., 'X', 'Y', 'Z')
-     * @param out_value Output value
-     * @return true if parameter found
-     */
-    bool extract_param(const std::string& line, char param, float& out_value);
-
-    /**
-     * @brief Extract string parameter value
-     * @param line G-code line
-     * @param param Parameter name (e.g., "NAME")
-     * @param out_value Output string
-     * @return true if parameter found
-     */
-    bool extract_string_param(const std::string& line, const std::string& param,
-                              std::string& out_value);
+    void parse_wipe_tower_marker(std::string_view comment);
 
     /**
      * @brief Add toolpath segment to current layer
@@ -367,13 +435,6 @@ class GCodeParser {
      */
     void start_new_layer(float z);
 
-    /**
-     * @brief Trim whitespace and comments from line
-     * @param line Raw line
-     * @return Trimmed line
-     */
-    std::string trim_line(const std::string& line);
-
     // Parser state
     glm::vec3 current_position_{0.0f, 0.0f, 0.0f}; ///< Current XYZ position
     float current_e_{0.0f};                        ///< Current E (extruder) position
@@ -381,6 +442,11 @@ class GCodeParser {
     bool is_absolute_positioning_{true}; ///< G90 (absolute) vs G91 (relative)
     bool is_absolute_extrusion_{true};   ///< M82 (absolute E) vs M83 (relative E)
 
+    // Object ids (so add_segment() does no string lookups)
+    ObjectId current_object_id_{NO_OBJECT_ID}; ///< Id of current_object_ in object_table_
+    GCodeObject* current_object_def_{nullptr}; ///< objects_ entry for current_object_, if any
+    ObjectId wipe_tower_id_{NO_OBJECT_ID};     ///< Id of the wipe tower pseudo-object
+
     // Multi-color tool tracking
     int current_tool_index_{0};                   ///< Active extruder/tool (0-indexed)
     std::vector<std::string> tool_color_palette_; ///< Hex colors per tool: ["#ED1C24", ...]
@@ -389,6 +455,7 @@ class GCodeParser {
     // Accumulated data
     std::vector<Layer> layers_;                  ///< All parsed layers
     std::map<std::string, GCodeObject> objects_; ///< Object metadata
+    ObjectSymbolTable object_table_;             ///< Ids for object names seen so far
     AABB global_bounds_;                         ///< Global bounding box
 
     // Parsed metadata (transferred to ParsedGCodeFile on finalize())
@@ -414,8 +481,14 @@ class GCodeParser {
 
     // Progress tracking
     size_t lines_parsed_{0};           ///< Line counter
+    std::string pending_line_;         ///< parse_buffer() line split across blocks
+    uint64_t byte_offset_{0};          ///< File offset of the next parse_buffer() byte
+    uint64_t line_begin_{0};           ///< File range of the line being parsed
+    uint64_t line_end_{0};             ///< (stay 0/0 when only parse_line() is used)
+    std::string key_scratch_;          ///< Lowercased metadata key (reused across lines)
     bool use_layer_markers_{false};    ///< True if ;LAYER_CHANGE markers found
     bool pending_layer_marker_{false}; ///< Layer change marker seen, layer not yet started
+    bool has_moved_{false};            ///< Seeded past the first move (set_modal_state())
 
     // Warning counters (logged as summary in finalize() instead of per-segment)
     size_t out_of_range_width_count_{
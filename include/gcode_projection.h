@@ -80,6 +80,10 @@ struct ProjectionParams {
 /// @return Screen coordinates in pixels (origin at top-left of canvas)
 glm::ivec2 project(const ProjectionParams& params, float x, float y, float z = 0.0f);
 
+/// project() without rounding to whole pixels (pixel i spans [i, i + 1)), for
+/// anti-aliased drawing
+glm::vec2 project_subpixel(const ProjectionParams& params, float x, float y, float z = 0.0f);
+
 /// Result of auto-fit computation.
 struct AutoFitResult {
     float scale = 1.0f;
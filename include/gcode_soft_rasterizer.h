@@ -0,0 +1,221 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+/**
+ * @file gcode_soft_rasterizer.h
+ * @brief Multi-threaded CPU rasterizer for RibbonGeometry (no GPU, no LVGL)
+ *
+ * Draws the same quantized ribbon geometry the GLES renderer uploads, for
+ * builds and boards without EGL. A frame is drawn in chunks of consecutive
+ * layers so scratch memory stays bounded by SOFT_CHUNK_VERTICES:
+ *
+ * 1. Transform: the chunk's vertices go straight from int16 to screen space
+ *    (dequantization is folded into the MVP) and are lit once per vertex.
+ * 2. Bin: strips that cover a pixel center and face the camera are appended
+ *    to the bins of every tile their bounds touch.
+ * 3. Raster: each tile is owned by one thread, which draws its bins in strip
+ *    order with a 16-bit depth buffer.
+ *
+ * Layers whose bounding box is outside the view frustum are skipped before
+ * any vertex work. Bins keep the original strip order, so the image does not
+ * depend on the thread count or chunk size.
+ *
+ * @threading render calls must come from one thread; the worker pool is internal
+ */
+
+#include "gcode_camera.h"
+#include "gcode_geometry_builder.h"
+#include "gcode_parallel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/// Tile edge in pixels; each tile is rasterized by a single thread
+constexpr int SOFT_TILE_SIZE = 64;
+
+/// Largest vertex span transformed per chunk (bounds per-frame scratch memory)
+constexpr size_t SOFT_CHUNK_VERTICES = 65536;
+
+/// Cleared depth; drawn geometry maps to [0, SOFT_DEPTH_FAR)
+constexpr uint16_t SOFT_DEPTH_FAR = 0xFFFF;
+
+/// Per-frame camera and lighting inputs (defaults match the GLES renderer)
+struct SoftRenderView {
+    glm::mat4 mvp{1.0f};           ///< Model-view-projection, model transform included
+    glm::mat3 normal_matrix{1.0f}; ///< Model-space normals to view space
+    glm::vec3 light_dirs[2] = {{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}}; ///< View space
+    float light_intensity[2] = {0.6f, 0.2f}; ///< Camera light, fill light
+    float ambient = 0.25f;
+    float specular_intensity = 0.25f;
+    float specular_shininess = 48.0f;
+    /// Skip triangles wound clockwise on screen (tubes are closed, so never visible)
+    bool cull_back_faces = true;
+};
+
+/**
+ * @brief View for @p camera with the GLES renderer's model transform and lights
+ * @param content_offset_y Vertical shift in NDC halves (see set_content_offset_y())
+ */
+SoftRenderView make_soft_render_view(const GCodeCamera& camera, float content_offset_y = 0.0f);
+
+/// How one draw_layers() pass colors and composites its strips
+struct SoftPassStyle {
+    glm::vec3 base_color{0.15f, 0.65f, 0.60f}; ///< Used when use_vertex_colors is false
+    bool use_vertex_colors = true;             ///< Take colors from the geometry palette
+    float color_scale = 1.0f;                  ///< Base color multiplier (ghosts wash out)
+    uint8_t alpha = 255; ///< Below 255: blended, depth tested but not written
+};
+
+/**
+ * @brief Tile-binned software rasterizer for ribbon geometry
+ *
+ * Usage per frame: begin_frame(), one draw_layers() per pass (solid first,
+ * then translucent), then read pixels().
+ */
+class RibbonRasterizer {
+  public:
+    /// @param threads Worker threads including the caller (0 = one per core)
+    explicit RibbonRasterizer(unsigned threads = 0);
+
+    RibbonRasterizer(const RibbonRasterizer&) = delete;
+    RibbonRasterizer& operator=(const RibbonRasterizer&) = delete;
+
+    /// Resize the color and depth buffers (contents are undefined until begin_frame())
+    void resize(int width, int height);
+
+    /**
+     * @brief Clear the buffers and prepare a frame over layers [first_layer, last_layer]
+     *
+     * Culls layers against the view frustum and fits the depth range to the
+     * bounding boxes of the layers that remain. @p geometry must stay alive
+     * and unchanged until the frame's last draw_layers() call.
+     *
+     * @param clear_color 0xAARRGGBB background
+     */
+    void begin_frame(const RibbonGeometry& geometry, const SoftRenderView& view, int first_layer,
+                     int last_layer, uint32_t clear_color);
+
+    /// Draw layers [first_layer, last_layer] (clamped to the begin_frame() range)
+    void draw_layers(int first_layer, int last_layer, const SoftPassStyle& style);
+
+    int width() const {
+        return width_;
+    }
+    int height() const {
+        return height_;
+    }
+    unsigned thread_count() const {
+        return pool_.size();
+    }
+
+    /// Row-major 0xAARRGGBB pixels, width() per row
+    const std::vector<uint32_t>& pixels() const {
+        return color_;
+    }
+    /// Row-major depth, SOFT_DEPTH_FAR where nothing was drawn
+    const std::vector<uint16_t>& depth() const {
+        return depth_;
+    }
+
+    // Statistics since begin_frame()
+    size_t triangles_drawn() const {
+        return triangles_drawn_;
+    }
+    size_t layers_culled() const {
+        return layers_culled_;
+    }
+    size_t chunks_drawn() const {
+        return chunks_drawn_;
+    }
+
+    /// Drop per-geometry caches (call when geometry is replaced in place)
+    void reset_geometry_cache() {
+        spans_geometry_ = nullptr;
+    }
+
+    /// Override SOFT_CHUNK_VERTICES (tests use tiny chunks to exercise splitting)
+    void set_chunk_vertices(size_t count) {
+        chunk_vertices_ = count > 0 ? count : 1;
+    }
+
+  private:
+    struct TileRect {
+        int x0, y0, x1, y1; ///< Half-open pixel bounds
+    };
+
+    /// Strip range [first, first + count) of one layer, plus its vertex span
+    struct LayerSpan {
+        size_t first_strip = 0;
+        size_t strip_count = 0;
+        uint32_t vertex_min = 0;
+        uint32_t vertex_max = 0; ///< Inclusive; below vertex_min when the layer is empty
+    };
+
+    void update_layer_spans();
+    void cull_layers(int first_layer, int last_layer);
+    void prepare_shading(const SoftPassStyle& style);
+    void draw_chunk(const std::vector<int>& layers, uint32_t vertex_begin, uint32_t vertex_end,
+                    const SoftPassStyle& style);
+    void transform_vertices(uint32_t begin, uint32_t end);
+    void bin_strips(size_t task, size_t task_count, const std::vector<int>& layers);
+    bool strip_faces_camera(const TriangleStrip& strip) const;
+    void raster_tile(size_t tile, uint8_t alpha);
+    void raster_triangle(const TileRect& tile, uint32_t a, uint32_t b, uint32_t c, uint8_t alpha);
+
+    WorkerPool pool_;
+    size_t chunk_vertices_ = SOFT_CHUNK_VERTICES;
+
+    // Frame buffers
+    int width_ = 0;
+    int height_ = 0;
+    int tiles_x_ = 0;
+    int tiles_y_ = 0;
+    std::vector<uint32_t> color_;
+    std::vector<uint16_t> depth_;
+
+    // Frame state (begin_frame)
+    const RibbonGeometry* geometry_ = nullptr;
+    SoftRenderView view_;
+    glm::mat4 quantized_mvp_{1.0f}; ///< MVP applied to raw int16 positions
+    float depth_min_ = -1.0f;       ///< NDC z mapped to depth 0
+    float depth_scale_ = 0.0f;      ///< NDC z to depth units
+    int frame_first_layer_ = 0;
+    int frame_last_layer_ = -1;
+    std::vector<uint8_t> layer_visible_; ///< Indexed by layer - frame_first_layer_
+
+    // Per-geometry cache (rebuilt when the geometry changes)
+    const RibbonGeometry* spans_geometry_ = nullptr;
+    size_t spans_strip_count_ = 0;
+    std::vector<LayerSpan> layer_spans_;
+
+    // Per-pass shading tables
+    std::vector<glm::vec2> normal_shading_; ///< Diffuse factor, specular term per normal
+    std::vector<glm::vec3> base_colors_;    ///< 0..255 per color palette entry
+
+    // Per-chunk scratch, indexed by vertex - chunk_vertex_base_
+    uint32_t chunk_vertex_base_ = 0;
+    std::vector<int32_t> screen_x_; ///< 28.4 fixed point
+    std::vector<int32_t> screen_y_;
+    std::vector<uint16_t> screen_z_;
+    std::vector<uint32_t> vertex_rgb_;
+    std::vector<uint8_t> vertex_flags_;
+
+    /// bins_[task * tile_count + tile]: strip indices in draw order
+    std::vector<std::vector<uint32_t>> bins_;
+    std::vector<size_t> task_strips_; ///< Strips binned per task (statistics)
+    size_t bin_tasks_ = 0;
+
+    size_t triangles_drawn_ = 0;
+    size_t layers_culled_ = 0;
+    size_t chunks_drawn_ = 0;
+};
+
+} // namespace gcode
+} // namespace helix
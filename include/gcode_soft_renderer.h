@@ -0,0 +1,238 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#ifndef ENABLE_GLES_3D
+
+/**
+ * @file gcode_soft_renderer.h
+ * @brief 3D G-code viewer backend for builds without OpenGL ES
+ *
+ * Drop-in replacement for GCodeGLESRenderer on boards without EGL: the same
+ * ribbon geometry and lighting, drawn by RibbonRasterizer on all cores and
+ * blitted into an lv_draw_buf. Frames are only redrawn when the camera or
+ * render options change, and drawn at half resolution while the user drags.
+ *
+ * @threading render calls from the LVGL thread; set_tool_color_overrides()
+ *            may race with render and is guarded by palette_mutex_
+ */
+
+#include "gcode_camera.h"
+#include "gcode_color_palette.h"
+#include "gcode_geometry_builder.h"
+#include "gcode_parser.h"
+#include "gcode_renderer.h"
+#include "gcode_soft_rasterizer.h"
+
+#include <lvgl/lvgl.h>
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+// ====== Named Constants (rendering parameters) ======
+
+/// Cheapest geometry tier the CPU path accepts (8-sided tubes, coarser simplification)
+constexpr int kSoftRenderMinTier = 2;
+
+/// Resolution divisor while the camera is being dragged
+constexpr int kSoftInteractionDownscale = 2;
+
+// Specular clamp ranges (same as the GLES renderer)
+constexpr float kSoftMinSpecularIntensity = 0.0f;
+constexpr float kSoftMaxSpecularIntensity = 1.0f;
+constexpr float kSoftMinSpecularShininess = 1.0f;
+constexpr float kSoftMaxSpecularShininess = 128.0f;
+
+/// Background 0xAARRGGBB (the GLES renderer's neutral gray, 0.45/0.45/0.47)
+constexpr uint32_t kSoftBackgroundColor = 0xFF737378;
+
+/// Default filament color (#26A69A teal)
+constexpr glm::vec3 kSoftDefaultFilamentColor{0.15f, 0.65f, 0.60f};
+
+/// Ghost layer default opacity (out of 255), barely visible as on GLES
+constexpr uint8_t kSoftDefaultGhostOpacity = 5;
+
+/// Ghost color multiplier (washes ghost layers toward white)
+constexpr float kSoftGhostLightenScale = 4.0f;
+
+/// Object picking screen-space threshold (pixels)
+constexpr float kSoftPickThresholdPx = 15.0f;
+
+/// CPU-rasterized G-code 3D renderer
+///
+/// Same interface as GCodeGLESRenderer so the viewer widget can use either.
+class GCodeSoftRenderer {
+  public:
+    GCodeSoftRenderer();
+    ~GCodeSoftRenderer();
+
+    GCodeSoftRenderer(const GCodeSoftRenderer&) = delete;
+    GCodeSoftRenderer& operator=(const GCodeSoftRenderer&) = delete;
+
+    // ====== Main Rendering Interface ======
+
+    void render(lv_layer_t* layer, const ParsedGCodeFile& gcode, const GCodeCamera& camera,
+                const lv_area_t* widget_coords);
+
+    void set_viewport_size(int width, int height);
+    void set_interaction_mode(bool interacting);
+    bool is_interaction_mode() const {
+        return interaction_mode_;
+    }
+
+    /// Geometry is drawn straight from RAM, so there is never an upload to wait for
+    bool is_uploading() const {
+        return false;
+    }
+
+    // ====== Color / Material ======
+
+    void set_filament_color(const std::string& hex_color);
+    void set_smooth_shading(bool) {}
+    void set_extrusion_width(float) {}
+    void set_simplification_tolerance(float) {}
+    void set_specular(float intensity, float shininess);
+    void set_debug_face_colors(bool) {}
+
+    // Color setters (lv_color_t interface used by gcode viewer widget)
+    void set_extrusion_color(lv_color_t color);
+    void set_tool_color_overrides(const std::vector<uint32_t>& ams_colors);
+    void set_travel_color(lv_color_t) {}
+    void set_brightness_factor(float) {}
+
+    // ====== Rendering Options ======
+
+    void set_show_travels(bool show);
+    void set_show_extrusions(bool show);
+    void set_layer_range(int start, int end);
+    void set_highlighted_object(const std::string& name);
+    void set_highlighted_objects(const std::unordered_set<std::string>& names);
+    void set_excluded_objects(const std::unordered_set<std::string>& names);
+    void set_global_opacity(lv_opa_t) {}
+    void reset_colors();
+    void clear_cached_frame();
+    RenderOptions get_options() const;
+
+    // ====== Object Picking ======
+
+    std::optional<std::string> pick_object(const glm::vec2& screen_pos,
+                                           const ParsedGCodeFile& gcode,
+                                           const GCodeCamera& camera) const;
+
+    // ====== Ghost Layer / Print Progress ======
+
+    void set_print_progress_layer(int current_layer);
+    void set_ghost_opacity(lv_opa_t opacity);
+    void set_ghost_render_mode(GhostRenderMode mode);
+    void set_content_offset_y(float offset_percent);
+    GhostRenderMode get_ghost_render_mode() const {
+        return ghost_render_mode_;
+    }
+    bool is_ghost_mode_enabled() const {
+        return progress_layer_ >= 0;
+    }
+    int get_max_layer_index() const;
+
+    // ====== Async Geometry Loading ======
+
+    void set_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry,
+                               const std::string& filename);
+    void set_prebuilt_coarse_geometry(std::unique_ptr<RibbonGeometry>) {}
+    /// Replace geometry with a grown copy of it (progressive load)
+    void extend_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry);
+
+    // ====== Statistics ======
+
+    size_t get_segments_rendered() const {
+        return triangles_rendered_ / 2;
+    }
+    size_t get_geometry_color_count() const;
+    size_t get_memory_usage() const;
+    size_t get_triangle_count() const;
+
+  private:
+    void render_frame(const GCodeCamera& camera);
+    bool ensure_draw_buf(int width, int height);
+    void blit_to_draw_buf();
+    void draw_cached_to_lvgl(lv_layer_t* layer, const lv_area_t* widget_coords);
+
+    // ====== Frame Skip ======
+
+    struct CachedRenderState {
+        float azimuth = -999.0f;
+        float elevation = -999.0f;
+        float distance = -999.0f;
+        float zoom_level = -999.0f;
+        glm::vec3 target{-999.0f};
+        int progress_layer = -2;
+        int layer_start = -2;
+        int layer_end = -2;
+        int render_width = 0;
+        int render_height = 0;
+        bool operator==(const CachedRenderState& o) const;
+        bool operator!=(const CachedRenderState& o) const {
+            return !(*this == o);
+        }
+    };
+
+    RibbonRasterizer raster_;
+
+    // ====== Output Buffer ======
+
+    lv_draw_buf_t* draw_buf_ = nullptr;
+    int draw_buf_width_ = 0;
+    int draw_buf_height_ = 0;
+
+    // ====== Viewport ======
+
+    int viewport_width_ = 800;
+    int viewport_height_ = 480;
+    bool interaction_mode_ = false;
+
+    // ====== Geometry ======
+
+    std::unique_ptr<RibbonGeometry> geometry_;
+    std::string current_filename_;
+
+    // ====== Configuration ======
+
+    GCodeColorPalette palette_; ///< Single-color override state
+    std::mutex palette_mutex_;  ///< Guards geometry color palette reads/writes
+    glm::vec3 filament_color_{kSoftDefaultFilamentColor};
+    float specular_intensity_ = 0.25f;
+    float specular_shininess_ = 48.0f;
+    bool show_travels_ = false;
+    bool show_extrusions_ = true;
+    int layer_start_ = -1;
+    int layer_end_ = -1;
+    std::string highlighted_object_;
+    std::unordered_set<std::string> highlighted_objects_;
+    std::unordered_set<std::string> excluded_objects_;
+
+    // ====== Ghost / Progress ======
+
+    int progress_layer_ = -1;
+    lv_opa_t ghost_opacity_ = kSoftDefaultGhostOpacity;
+    GhostRenderMode ghost_render_mode_ = GhostRenderMode::Stipple;
+    float content_offset_y_percent_ = 0.0f;
+
+    // ====== Frame Skip ======
+
+    CachedRenderState cached_state_;
+    bool frame_dirty_ = true;
+    size_t triangles_rendered_ = 0;
+};
+
+} // namespace gcode
+} // namespace helix
+
+#endif // !ENABLE_GLES_3D
@@ -8,6 +8,7 @@
 #include "gcode_layer_index.h"
 #include "gcode_parser.h"
 #include "gcode_streaming_config.h"
+#include "gcode_toolpath_cache.h"
 
 #include <atomic>
 #include <chrono>
@@ -52,7 +53,7 @@ class BackgroundGhostBuilder {
   public:
     /// Callback type for rendering a layer's segments
     using RenderCallback =
-        std::function<void(size_t layer_index, const std::vector<ToolpathSegment>& segments)>;
+        std::function<void(size_t layer_index, const CompactSegments& segments)>;
 
     BackgroundGhostBuilder() = default;
     ~BackgroundGhostBuilder();
@@ -147,6 +148,11 @@ class BackgroundGhostBuilder {
  * This enables viewing 10MB+ G-code files on devices with limited RAM (e.g.,
  * AD5M with 47MB) by loading only the layers currently being viewed.
  *
+ * The first time a local file is opened, a background pass parses every layer
+ * once and writes a .helixpath file (see ToolpathDiskCache). Later opens of
+ * the unchanged file decode layers from that memory-mapped file instead of
+ * reading and parsing G-code text.
+ *
  * Usage:
  * @code
  *   GCodeStreamingController controller;
@@ -171,6 +177,9 @@ class GCodeStreamingController {
     /// Minimum cache budget (1MB)
     static constexpr size_t MIN_CACHE_BUDGET = 1 * 1024 * 1024;
 
+    /// How far into a file open_file_async() looks for the first complete layer
+    static constexpr size_t FIRST_LAYERS_SCAN_LIMIT = 16 * 1024 * 1024;
+
     /**
      * @brief Construct controller with default settings
      *
@@ -213,16 +222,26 @@ class GCodeStreamingController {
      * Returns immediately. Use is_ready() to check when indexing is complete.
      * Progress can be monitored via get_index_progress().
      *
+     * With @p on_first_layers, a file without a cached index is first scanned
+     * from the start until a layer is complete (at most FIRST_LAYERS_SCAN_LIMIT
+     * bytes). is_open() then turns true and those layers can be loaded while
+     * the full index is built; get_layer_count() jumps to the final count
+     * when it is done.
+     *
      * @param filepath Path to G-code file
      * @param on_complete Optional callback when indexing completes (bool success)
+     * @param on_first_layers Optional callback when the first layers can be loaded
      */
     void open_file_async(const std::string& filepath,
-                         std::function<void(bool)> on_complete = nullptr);
+                         std::function<void(bool)> on_complete = nullptr,
+                         std::function<void()> on_first_layers = nullptr);
 
     /**
      * @brief Open a G-code file via Moonraker API
      *
-     * Uses HTTP range requests for efficient streaming access.
+     * Builds the index while streaming the file with HTTP range requests;
+     * layers are later loaded with range requests too, so no local copy is
+     * made unless the server ignores Range headers.
      *
      * @param moonraker_url Base Moonraker URL (e.g., "http://192.168.1.100:7125")
      * @param gcode_path G-code file path on printer
@@ -230,6 +249,27 @@ class GCodeStreamingController {
      */
     bool open_moonraker(const std::string& moonraker_url, const std::string& gcode_path);
 
+    /**
+     * @brief Open a G-code file via Moonraker, indexing while it downloads
+     *
+     * Returns at once: the file size is fetched and the index built in the
+     * background as range-request chunks arrive; is_open() turns true as soon
+     * as the first layer is complete, and get_layer_count() grows until
+     * is_index_complete(). A dropped connection resumes from the last byte
+     * received.
+     *
+     * If the download fails after some layers were indexed, the file stays
+     * open with those layers and on_complete receives false.
+     *
+     * @param moonraker_url Base Moonraker URL (e.g., "http://192.168.1.100:7125")
+     * @param gcode_path G-code file path on printer
+     * @param on_first_layer Optional callback when the first layer can be loaded
+     * @param on_complete Optional callback when indexing ends (bool success)
+     */
+    void open_moonraker_async(const std::string& moonraker_url, const std::string& gcode_path,
+                              std::function<void()> on_first_layer = nullptr,
+                              std::function<void(bool)> on_complete = nullptr);
+
     /**
      * @brief Open from an existing data source
      *
@@ -257,6 +297,15 @@ class GCodeStreamingController {
      */
     bool is_indexing() const;
 
+    /**
+     * @brief Check if every layer of the file has been indexed
+     *
+     * Differs from is_open() only while open_moonraker_async() is streaming
+     * or open_file_async() has published its first layers, or after a
+     * streamed open failed part way.
+     */
+    bool is_index_complete() const;
+
     /**
      * @brief Get indexing progress (0.0 to 1.0)
      * @return Progress fraction, or 1.0 if complete
@@ -280,19 +329,19 @@ class GCodeStreamingController {
      * Thread-safe but blocks if loading is needed.
      *
      * @param layer_index Zero-based layer index
-     * @return Shared pointer to segment vector, or nullptr if layer doesn't exist.
+     * @return Shared pointer to the layer's segments, or nullptr if layer doesn't exist.
      *         Data stays valid as long as the shared_ptr is held, even if the
      *         cache entry is evicted. This is critical for thread safety.
      *
      * @note For background loading, use request_layer() + is_layer_ready()
      */
-    std::shared_ptr<const std::vector<ToolpathSegment>> get_layer_segments(size_t layer_index);
+    std::shared_ptr<const CompactSegments> get_layer_segments(size_t layer_index);
 
     /**
      * @brief Request a layer to be loaded (non-blocking)
      *
-     * If layer is not cached, queues it for background loading.
-     * Check is_layer_ready() or get_layer_segments() later.
+     * If layer is not cached, queues it for background loading ahead of its
+     * neighbours. Check is_layer_cached() or get_layer_segments() later.
      *
      * @param layer_index Zero-based layer index
      */
@@ -308,8 +357,9 @@ class GCodeStreamingController {
     /**
      * @brief Prefetch layers around current view
      *
-     * Loads layers in range [center - radius, center + radius].
-     * Called automatically by get_layer_segments() but can be
+     * Queues layers in range [center - radius, center + radius] for the
+     * background loader, replacing any requests still queued for a previous
+     * center. Called automatically by get_layer_segments() but can be
      * called explicitly for more control.
      *
      * @param center_layer Center layer index
@@ -317,6 +367,12 @@ class GCodeStreamingController {
      */
     void prefetch_around(size_t center_layer, size_t radius = DEFAULT_PREFETCH_RADIUS);
 
+    /**
+     * @brief Wait for queued prefetches to finish
+     * @return false if still loading after @p timeout
+     */
+    bool wait_for_prefetch(std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
     // =========================================================================
     // Layer Information
     // =========================================================================
@@ -334,6 +390,13 @@ class GCodeStreamingController {
      */
     float get_layer_z(size_t layer_index) const;
 
+    /**
+     * @brief Get where a layer lies in the source file
+     * @param layer_index Zero-based layer index
+     * @return Index entry (file_offset, byte_length), or an invalid entry if out of range
+     */
+    StreamingLayerEntry get_layer_entry(size_t layer_index) const;
+
     /**
      * @brief Find layer closest to Z height
      * @param z Z coordinate
@@ -343,9 +406,9 @@ class GCodeStreamingController {
 
     /**
      * @brief Get layer index statistics
-     * @return Statistics from index building
+     * @return Statistics from index building (empty until indexing completes)
      */
-    const LayerIndexStats& get_index_stats() const;
+    LayerIndexStats get_index_stats() const;
 
     /**
      * @brief Get file size
@@ -363,6 +426,11 @@ class GCodeStreamingController {
      */
     float get_cache_hit_rate() const;
 
+    /**
+     * @brief Get cache and prefetch statistics (prefetch hit rate, worst stall)
+     */
+    GCodeLayerCache::HitStats get_cache_stats() const;
+
     /**
      * @brief Get current cache memory usage
      * @return Bytes used
@@ -406,55 +474,121 @@ class GCodeStreamingController {
     /**
      * @brief Get header metadata (slicer info, print time, etc.)
      *
-     * Only populated after first layer is parsed.
+     * Populated when the first layer is parsed, or at open from a .helixpath file.
      *
      * @return Pointer to metadata, or nullptr if not available
      */
     const GCodeHeaderMetadata* get_header_metadata() const;
 
+    /**
+     * @brief Object names seen so far, with the ids used by get_layer_segments()
+     *
+     * Each layer is parsed on its own, so ids are moved onto this file-wide
+     * table as layers load; it grows until every object has been seen.
+     *
+     * @return Copy of the table (safe to use while layers keep loading)
+     */
+    ObjectSymbolTable get_object_table() const;
+
+    /**
+     * @brief Number of entries in get_object_table(), without copying it
+     */
+    size_t get_object_count() const;
+
   private:
     /**
      * @brief Load a layer from source and parse to segments
      * @param layer_index Layer to load
-     * @return Parsed segments
+     * @return Parsed segments, packed for the cache
      */
-    std::vector<ToolpathSegment> load_layer(size_t layer_index);
+    CompactSegments load_layer(size_t layer_index);
 
     /**
      * @brief Build index from current data source
+     * @param keep_running Cleared to abandon a streamed index
      * @return true if successful
      */
-    bool build_index();
+    bool build_index(const std::atomic<bool>& keep_running);
+
+    /**
+     * @brief Build index from data_source_->stream_chunks()
+     *
+     * Publishes layers to index_ as they complete.
+     */
+    bool stream_index(const std::atomic<bool>& keep_running);
+
+    /**
+     * @brief Index the start of a local file and publish its first layers
+     *
+     * Lets open_file_async() show something before the full scan finishes.
+     * Layers published here have the same byte ranges in the full index.
+     */
+    void index_first_layers(const std::string& file_path, const std::atomic<bool>& keep_running);
+
+    /**
+     * @brief Use the file's .helixpath toolpaths, or start writing them
+     *
+     * Called once the full index of a local file is known.
+     */
+    void attach_toolpaths(const std::string& file_path);
+
+    /**
+     * @brief Parse every layer of a local file into a .helixpath file (digest_thread_)
+     * @param entries Layer index of the file, copied so index_ stays unlocked
+     */
+    void digest_toolpaths(const std::string& file_path,
+                          const std::vector<StreamingLayerEntry>& entries);
+
+    /// Abandon and join a running digest_toolpaths()
+    void stop_digest();
+
+    /// Mark the file open and invoke index_ready_callback_ (once per open)
+    void notify_index_ready();
+
+    /// Invoke index_complete_callback_ (async opens, background thread)
+    void notify_index_complete(bool success);
+
+    /// Layer count under index_mutex_, regardless of is_open_
+    size_t indexed_layer_count() const;
 
     /**
      * @brief Create loader function for cache
      * @return Loader lambda
      */
-    std::function<std::vector<ToolpathSegment>(size_t)> make_loader();
+    std::function<CompactSegments(size_t)> make_loader();
 
     // Components (order matters for destruction)
     std::unique_ptr<GCodeDataSource> data_source_;
+    std::mutex read_mutex_; // Serialises data_source_ reads (sources are not thread-safe)
     GCodeLayerIndex index_;
+    mutable std::mutex index_mutex_; // Protects index_ (grows while streaming) and toolpaths_
+    std::shared_ptr<const ToolpathFile> toolpaths_; ///< Pre-digested layers, if valid
+    std::vector<ObjectId> toolpath_object_ids_;     ///< toolpaths_ object ids -> object_table_
     GCodeLayerCache cache_;
 
     // Async indexing
     std::future<bool> index_future_;
     std::atomic<bool> indexing_{false};
     std::atomic<float> index_progress_{0.0f};
-    mutable std::mutex callback_mutex_; // Protects index_complete_callback_
+    std::atomic<bool> partial_index_{false}; // Layers usable before indexing ends
+    std::atomic<bool> index_complete_{false};
+    mutable std::mutex callback_mutex_; // Protects the callbacks below
     std::function<void(bool)> index_complete_callback_;
+    std::function<void()> index_ready_callback_;
+
+    // Background .helixpath writer
+    std::thread digest_thread_;
+    std::atomic<bool> digesting_{false};
 
     // Metadata (populated lazily)
     mutable std::mutex metadata_mutex_;
     std::unique_ptr<GCodeHeaderMetadata> header_metadata_;
     bool metadata_extracted_{false};
+    ObjectSymbolTable object_table_; ///< File-wide object ids (guarded by metadata_mutex_)
 
     // State
     std::atomic<bool> is_open_{false};
     size_t prefetch_radius_{DEFAULT_PREFETCH_RADIUS};
-
-    // Empty stats for when not open
-    static const LayerIndexStats empty_stats_;
 };
 
 } // namespace gcode
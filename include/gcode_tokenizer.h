@@ -0,0 +1,149 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_tokenizer.h
+ * @brief Allocation-free G-code line tokenizer and number parsing
+ *
+ * @pattern Views into the caller's buffer; nothing is copied or owned
+ * @threading Stateless, safe from any thread
+ * @gotchas Views are only valid while the source buffer is alive
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace helix {
+namespace gcode {
+
+/**
+ * @brief Commands GCodeParser acts on, recognised from the first bytes of a line
+ */
+enum class GCodeCommand : uint8_t {
+    None,          ///< Blank or comment-only line
+    Move,          ///< G0 / G1
+    Absolute,      ///< G90
+    Relative,      ///< G91
+    AbsoluteE,     ///< M82
+    RelativeE,     ///< M83
+    ToolChange,    ///< T<n>
+    ExcludeObject, ///< EXCLUDE_OBJECT_DEFINE / _START / _END
+    Other,         ///< Anything else (ignored by the parser)
+};
+
+/**
+ * @brief One G-code line split into code and comment
+ */
+struct GCodeLine {
+    std::string_view code;    ///< Command text, comment removed, whitespace trimmed
+    std::string_view comment; ///< From ';' to end of line (empty if none)
+    GCodeCommand command{GCodeCommand::None};
+};
+
+/**
+ * @brief X/Y/Z/E words of a movement command
+ *
+ * Bit N of @c present is set when axis N (X, Y, Z, E) was given.
+ */
+struct MoveWords {
+    static constexpr uint8_t X = 1 << 0;
+    static constexpr uint8_t Y = 1 << 1;
+    static constexpr uint8_t Z = 1 << 2;
+    static constexpr uint8_t E = 1 << 3;
+
+    float x{0.0f};
+    float y{0.0f};
+    float z{0.0f};
+    float e{0.0f};
+    uint8_t present{0};
+
+    bool has(uint8_t axis) const {
+        return (present & axis) != 0;
+    }
+};
+
+/**
+ * @brief Split a line into code and comment and classify the command
+ * @param line One line without its '\n' (a trailing '\r' is trimmed)
+ */
+GCodeLine tokenize_line(std::string_view line);
+
+/**
+ * @brief Trim leading and trailing whitespace
+ */
+std::string_view trim_view(std::string_view text);
+
+/**
+ * @brief Parse a decimal number at the start of @p text
+ *
+ * Accepts an optional sign, digits with an optional fraction and an optional
+ * exponent ("-12.5", ".4", "3.", "1e-3"). Locale independent. Returns the
+ * number of characters consumed, 0 if @p text does not start with a number.
+ */
+size_t parse_float(std::string_view text, float& out);
+
+/**
+ * @brief Parse a decimal integer (optional sign) at the start of @p text
+ * @return Characters consumed, 0 if there is no number or it does not fit in an int
+ */
+size_t parse_int(std::string_view text, int& out);
+
+/**
+ * @brief Like std::stof: skips leading whitespace, then parses a number prefix
+ * @return true if a number was found
+ */
+bool parse_leading_float(std::string_view text, float& out);
+
+/**
+ * @brief Like std::stoi: skips leading whitespace, then parses an integer prefix
+ * @return true if a number was found
+ */
+bool parse_leading_int(std::string_view text, int& out);
+
+/**
+ * @brief Extract the X, Y, Z and E words of a G0/G1 line in one pass
+ * @param code Code part of the line (see GCodeLine::code)
+ *
+ * Only the first occurrence of each letter counts, and it must follow a space
+ * or tab: "G1 X10 X20" yields X=10 and "G1 AX10" yields no X.
+ */
+MoveWords scan_move_words(std::string_view code);
+
+/**
+ * @brief Find a KEY=value parameter (e.g. NAME=part_1)
+ * @param code Code part of the line
+ * @param name Parameter name without '='
+ * @param out View of the value, up to the next space
+ * @return false if the parameter is missing or nothing follows '='
+ */
+bool find_string_param(std::string_view code, std::string_view name, std::string_view& out);
+
+/**
+ * @brief Tool number of a standalone tool change ("T0", "T12")
+ * @param code Code part of the line
+ * @return false for anything else ("T", "TX", "T0 X1", out-of-range numbers)
+ */
+bool parse_tool_number(std::string_view code, int& out);
+
+/**
+ * @brief True for a slicer layer marker comment (";LAYER_CHANGE", "; layer:12")
+ *
+ * Not for metadata such as ";LAYER_COUNT:120".
+ */
+bool is_layer_marker(std::string_view comment);
+
+/**
+ * @brief Split a "; key = value" or ";key: value" metadata comment
+ * @param comment Comment including its leading ';'
+ * @param key Trimmed key, case preserved
+ * @param value Trimmed value
+ * @return false if the comment has no '=' or ':' separator
+ */
+bool split_metadata_comment(std::string_view comment, std::string_view& key,
+                            std::string_view& value);
+
+} // namespace gcode
+} // namespace helix
@@ -0,0 +1,271 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file gcode_toolpath_cache.h
+ * @brief Pre-digested binary toolpaths (.helixpath), written once per G-code file
+ *
+ * @pattern Write once in layer order, then memory-map and decode single layers
+ * @threading ToolpathFile is immutable once opened; any number of threads may
+ *            call load_layer(). A ToolpathFileWriter belongs to one thread.
+ * @gotchas Files use the host's byte order; they are not meant to be copied
+ *          between machines
+ */
+
+#pragma once
+
+#include "gcode_compact_segments.h"
+#include "gcode_layer_index_cache.h"
+#include "gcode_mapped_file.h"
+#include "gcode_object_table.h"
+#include "gcode_parser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+/// Where one layer's blob lives in a .helixpath file
+struct ToolpathLayerRecord {
+    uint64_t offset;
+    uint32_t byte_length;
+    uint32_t segment_count;
+    float z;
+    uint64_t checksum; ///< FNV-1a of the blob
+};
+
+/**
+ * @brief Streams parsed layers into a .helixpath file
+ *
+ * Each layer becomes one self-contained blob. Per segment it stores a flag
+ * byte and zigzag varint XY deltas on the CompactSegments grid, so a chained
+ * move takes 3-5 bytes. Tool, object, width and extrusion amount are written
+ * only when they change from the previous segment.
+ *
+ * The layer table, object table, tool palette and slicer metadata follow the
+ * blobs, so layers can be written as they are parsed without holding the
+ * file in memory. Nothing is visible at the final path until commit().
+ *
+ * @code
+ *   ToolpathFileWriter writer(path, identity);
+ *   for (...) {
+ *       writer.add_layer(z, segments);
+ *   }
+ *   writer.commit(metadata);
+ * @endcode
+ */
+class ToolpathFileWriter {
+  public:
+    /**
+     * @param path Final file path (written to path + ".tmp" until commit())
+     * @param identity G-code file the toolpaths come from
+     */
+    ToolpathFileWriter(std::string path, GCodeFileIdentity identity);
+
+    /// Removes the temporary file unless commit() succeeded
+    ~ToolpathFileWriter();
+
+    ToolpathFileWriter(const ToolpathFileWriter&) = delete;
+    ToolpathFileWriter& operator=(const ToolpathFileWriter&) = delete;
+
+    /// false if the temporary file could not be created or a write failed
+    bool is_open() const {
+        return out_.is_open() && out_.good();
+    }
+
+    /**
+     * @brief Append the next layer
+     *
+     * Object names are interned into the file's own table; the segments'
+     * object_id values are ignored.
+     */
+    void add_layer(float z, const CompactSegments& segments);
+
+    size_t layer_count() const {
+        return layers_.size();
+    }
+
+    /// Bytes of layer data written so far (the tables added by commit() are small)
+    uint64_t bytes_written() const {
+        return offset_;
+    }
+
+    /**
+     * @brief Write the tables and move the file into place
+     * @param metadata Slicer metadata; tool_colors becomes the tool palette
+     * @return true if the file is complete at its final path
+     */
+    bool commit(const GCodeHeaderMetadata& metadata);
+
+    const std::string& path() const {
+        return path_;
+    }
+
+  private:
+    std::string path_;
+    std::string temp_path_;
+    GCodeFileIdentity identity_;
+    std::ofstream out_;
+    uint64_t offset_{0};
+    std::vector<ToolpathLayerRecord> layers_;
+    ObjectSymbolTable objects_;
+    std::string blob_; ///< Reused encode buffer
+    bool committed_{false};
+};
+
+/**
+ * @brief Read-only, memory-mapped .helixpath file
+ *
+ * open() maps the file and checks only its tables, so opening costs the same
+ * for a 5 MB and a 500 MB print. load_layer() decodes one layer straight from
+ * the mapping (no read or copy of the rest of the file) and checks that
+ * layer's own checksum.
+ */
+class ToolpathFile {
+  public:
+    ToolpathFile() = default;
+    ToolpathFile(const ToolpathFile&) = delete;
+    ToolpathFile& operator=(const ToolpathFile&) = delete;
+
+    /**
+     * @brief Map a file and validate it against the G-code it was made from
+     * @return false if missing, damaged, or made from a different file
+     */
+    bool open(const std::string& path, const GCodeFileIdentity& expected);
+
+    size_t layer_count() const {
+        return layers_.size();
+    }
+
+    /// Z height of a layer (0.0 for an invalid index)
+    float layer_z(size_t layer_index) const;
+
+    /// Number of segments in a layer, without decoding it
+    size_t layer_segment_count(size_t layer_index) const;
+
+    /**
+     * @brief Decode one layer
+     * @param segments Receives the layer
+     * @param object_ids Caller's id for each object_names() entry; empty to
+     *                   use the indices into object_names()
+     * @return false for an invalid index or a damaged layer
+     */
+    bool load_layer(size_t layer_index, CompactSegments& segments,
+                    const std::vector<ObjectId>& object_ids = {}) const;
+
+    /// Object names by ObjectId, in first-seen order
+    const std::vector<std::string>& object_names() const {
+        return object_names_;
+    }
+
+    /// Slicer metadata; tool_colors holds the tool palette
+    const GCodeHeaderMetadata& metadata() const {
+        return metadata_;
+    }
+
+  private:
+    MappedFile mapping_;
+    std::vector<ToolpathLayerRecord> layers_;
+    std::vector<std::string> object_names_;
+    GCodeHeaderMetadata metadata_;
+};
+
+/**
+ * @brief Directory of .helixpath files, one per G-code file
+ *
+ * Mirrors LayerIndexDiskCache: files are named after a hash of the G-code
+ * path, only used while the file's GCodeFileIdentity still matches, and the
+ * least recently used ones are removed once the directory passes its limit.
+ *
+ * @code
+ *   auto toolpaths = get_toolpath_cache().load(path);
+ *   if (!toolpaths) {
+ *       auto writer = get_toolpath_cache().begin_store(path);
+ *       // ... writer->add_layer() for every layer ...
+ *       get_toolpath_cache().finish_store(*writer, metadata);
+ *   }
+ * @endcode
+ *
+ * @threading All methods may be called from any thread
+ */
+class ToolpathDiskCache {
+  public:
+    /// Subdirectory appended to the base cache dir (next to helix_gcode_index)
+    static constexpr const char* CACHE_SUBDIR = "helix_toolpaths";
+
+    /// Default size limit for all files (~8 bytes per segment: a few large prints)
+    static constexpr size_t DEFAULT_MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * @param cache_dir Directory for .helixpath files (created if missing)
+     * @param max_size Total size limit in bytes before old files are evicted
+     */
+    explicit ToolpathDiskCache(std::string cache_dir, size_t max_size = DEFAULT_MAX_CACHE_SIZE);
+
+    /**
+     * @brief Open the toolpaths of a G-code file if a matching file exists
+     * @return nullptr on a miss (stale or damaged files are removed)
+     */
+    std::shared_ptr<const ToolpathFile> load(const std::string& filepath);
+
+    /**
+     * @brief Start a .helixpath file for a G-code file
+     * @return nullptr if there is no cache directory or the G-code file is unreadable
+     */
+    std::unique_ptr<ToolpathFileWriter> begin_store(const std::string& filepath);
+
+    /**
+     * @brief Commit a writer from begin_store() and evict old files
+     *
+     * A file larger than the whole cache is dropped rather than stored, since
+     * keeping it would evict everything else; the new file itself is never evicted.
+     *
+     * @return true if the file was written
+     */
+    bool finish_store(ToolpathFileWriter& writer, const GCodeHeaderMetadata& metadata);
+
+    /**
+     * @brief Remove the .helixpath file for a G-code file, if any
+     */
+    void remove(const std::string& filepath);
+
+    /**
+     * @brief .helixpath location for a G-code file path
+     */
+    [[nodiscard]] std::string get_cache_path(const std::string& filepath) const;
+
+    [[nodiscard]] const std::string& get_cache_dir() const {
+        return cache_dir_;
+    }
+
+    /**
+     * @brief Total size of all .helixpath files in bytes
+     */
+    [[nodiscard]] size_t get_cache_size() const;
+
+    /**
+     * @brief Size limit in bytes; a single file larger than this is not stored
+     */
+    [[nodiscard]] size_t get_max_size() const {
+        return max_size_;
+    }
+
+  private:
+    std::string cache_dir_;
+    size_t max_size_;
+    std::mutex mutex_; ///< Serialises commits and eviction
+};
+
+/**
+ * @brief Global toolpath cache in the helix cache directory
+ */
+ToolpathDiskCache& get_toolpath_cache();
+
+} // namespace gcode
+} // namespace helix
@@ -31,7 +31,9 @@ class GeometryBudgetManager {
     size_t calculate_budget(size_t available_kb) const;
     size_t read_system_available_kb() const;
     bool is_system_memory_critical() const;
-    BudgetConfig select_tier(size_t segment_count, size_t budget_bytes) const;
+    /// @param min_tier Cheapest tier allowed; lower tiers are skipped even if they
+    ///        fit (renderers that cannot afford full detail pass 2 or 3)
+    BudgetConfig select_tier(size_t segment_count, size_t budget_bytes, int min_tier = 1) const;
 
     enum class BudgetAction { CONTINUE, DEGRADE, ABORT };
 
@@ -0,0 +1,235 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file http_worker_pool.h
+ * @brief Fixed-size HTTP worker pool with keep-alive connections and priority lanes
+ *
+ * File transfers used to spawn one std::thread per request, each opening a
+ * fresh TCP connection. Scrolling a folder of a few hundred files into view
+ * paid thread creation plus a connect for every thumbnail, and a large
+ * background download competed with them on equal terms.
+ *
+ * The pool runs a fixed number of workers. Each worker owns a hv::HttpClient,
+ * so consecutive requests on the same worker reuse one keep-alive connection.
+ * Jobs wait in three lanes, and a worker always takes the highest-priority job
+ * available:
+ *
+ *   VISIBLE     thumbnails currently on screen
+ *   PREFETCH    small transfers: file contents, G-code preambles, config saves
+ *   BACKGROUND  streaming downloads and uploads
+ *
+ * BACKGROUND jobs may occupy at most workers - 1 workers, so a long transfer
+ * never leaves on-screen thumbnails waiting.
+ *
+ * Usage:
+ *   HttpWorkerPool pool(4);
+ *   auto ticket = pool.submit(HttpPriority::VISIBLE, [](HttpWorkerPool::Context& ctx) {
+ *       auto resp = ctx.send(req);
+ *       if (ctx.cancelled()) return;
+ *       ...
+ *   }, "thumbnail/key");
+ *   pool.cancel(ticket); // or pool.cancel_key("thumbnail/key")
+ *
+ * @threading submit()/cancel()/take_stats() from any thread; jobs run on workers
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct HttpRequest;
+struct HttpResponse;
+
+namespace hv {
+class HttpClient;
+} // namespace hv
+
+namespace helix {
+
+/// Lane a transfer waits in; lower values are served first
+enum class HttpPriority : uint8_t {
+    VISIBLE = 0,    ///< On-screen thumbnails
+    PREFETCH = 1,   ///< Small transfers the UI is waiting on or will need soon
+    BACKGROUND = 2, ///< Streaming downloads and uploads
+};
+
+constexpr size_t HTTP_PRIORITY_COUNT = 3;
+
+/// Returns "visible", "prefetch" or "background"
+const char* http_priority_name(HttpPriority priority);
+
+/// Queue wait and transfer time for one lane, in microseconds
+struct HttpLaneStats {
+    uint64_t completed = 0;
+    uint64_t cancelled = 0; ///< Removed from the queue or flagged while running
+    uint64_t wait_total_us = 0;
+    uint64_t wait_max_us = 0;
+    uint64_t run_total_us = 0;
+    uint64_t run_max_us = 0;
+
+    double avg_wait_ms() const {
+        return completed > 0 ? static_cast<double>(wait_total_us) / completed / 1000.0 : 0.0;
+    }
+    double avg_run_ms() const {
+        return completed > 0 ? static_cast<double>(run_total_us) / completed / 1000.0 : 0.0;
+    }
+};
+
+/// Snapshot returned by HttpWorkerPool::take_stats()
+struct HttpPoolStats {
+    std::array<HttpLaneStats, HTTP_PRIORITY_COUNT> lanes;
+    size_t queued = 0;      ///< Jobs waiting right now
+    size_t active = 0;      ///< Jobs running right now
+    size_t peak_queued = 0; ///< Highest queue depth since the previous call
+};
+
+class HttpWorkerPool {
+  public:
+    using Ticket = uint64_t;
+
+    /**
+     * @brief Per-job view of the worker running it
+     *
+     * Only valid for the duration of the job.
+     */
+    class Context {
+      public:
+        /**
+         * @brief Send a request over this worker's keep-alive connection
+         *
+         * Blocks until the response is complete or the request times out.
+         *
+         * @return Response, or nullptr on connection failure or timeout
+         */
+        std::shared_ptr<HttpResponse> send(const std::shared_ptr<HttpRequest>& req);
+
+        /// True once the job has been cancelled; skip any further work and callbacks
+        bool cancelled() const {
+            return cancelled_->load();
+        }
+
+      private:
+        friend class HttpWorkerPool;
+        Context(hv::HttpClient& client, std::shared_ptr<std::atomic<bool>> cancelled)
+            : client_(client), cancelled_(std::move(cancelled)) {}
+
+        hv::HttpClient& client_;
+        std::shared_ptr<std::atomic<bool>> cancelled_;
+    };
+
+    using Job = std::function<void(Context&)>;
+
+    /// Reports a job cancelled by cancel() or cancel_key() (never by shutdown())
+    using CancelHandler = std::function<void()>;
+
+    /**
+     * @brief Start @p workers worker threads (at least one)
+     */
+    explicit HttpWorkerPool(size_t workers);
+
+    /// Shuts down with a 2 second grace period
+    ~HttpWorkerPool();
+
+    HttpWorkerPool(const HttpWorkerPool&) = delete;
+    HttpWorkerPool& operator=(const HttpWorkerPool&) = delete;
+
+    /**
+     * @brief Queue a job
+     *
+     * @param priority Lane to wait in
+     * @param job Runs on a worker thread
+     * @param key Optional tag for cancel_key(), e.g. the thumbnail path
+     * @param on_cancel Optional; called once if cancel() or cancel_key() cancels the
+     *        job: on the cancelling thread if it was still queued, otherwise on its
+     *        worker after the job returns. Not called for jobs stopped by shutdown().
+     * @return Ticket for cancel(), or 0 if the pool is shut down (job is dropped)
+     */
+    Ticket submit(HttpPriority priority, Job job, std::string key = {},
+                  CancelHandler on_cancel = nullptr);
+
+    /**
+     * @brief Cancel one job
+     *
+     * A queued job is removed without running. A running job is flagged;
+     * it sees Context::cancelled() and skips its callbacks. Either way the
+     * job's CancelHandler runs.
+     *
+     * @return true if the job was still queued or running
+     */
+    bool cancel(Ticket ticket);
+
+    /**
+     * @brief Cancel every queued or running job submitted with @p key
+     *
+     * @return Number of jobs cancelled (an empty key matches nothing)
+     */
+    size_t cancel_key(std::string_view key);
+
+    /**
+     * @brief Stop accepting jobs, drop the queue and join the workers
+     *
+     * Workers still inside a transfer after @p timeout are detached; they only
+     * touch state they share with the pool, so the pool may be destroyed.
+     */
+    void shutdown(std::chrono::milliseconds timeout);
+
+    /// Lane metrics since the previous call, plus the current gauges
+    HttpPoolStats take_stats();
+
+    size_t worker_count() const {
+        return workers_.size();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct QueuedJob {
+        Ticket ticket = 0;
+        std::string key;
+        Job job;
+        CancelHandler on_cancel;
+        Clock::time_point queued_at;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct RunningJob {
+        Ticket ticket = 0;
+        std::string key;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        size_t lane = 0;
+    };
+
+    /// Outlives the pool if a worker has to be detached
+    struct Shared {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::array<std::deque<QueuedJob>, HTTP_PRIORITY_COUNT> lanes;
+        std::vector<RunningJob> running;
+        size_t background_running = 0;
+        size_t background_limit = 0;
+        bool stopping = false;
+        Ticket next_ticket = 1;
+        HttpPoolStats stats;
+    };
+
+    static void worker_loop(const std::shared_ptr<Shared>& shared);
+    static bool pop_next_locked(Shared& shared, QueuedJob& out, size_t& lane);
+
+    std::shared_ptr<Shared> shared_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace helix
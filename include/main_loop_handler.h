@@ -8,7 +8,7 @@
  * Handles timing-related concerns in the main loop:
  * - Auto-screenshot after delay
  * - Auto-quit timeout
- * - Benchmark mode FPS tracking
+ * - Benchmark mode FPS tracking and status dispatch timing
  */
 
 #pragma once
@@ -44,6 +44,11 @@ class MainLoopHandler {
         float fps{0.0f};
         uint32_t frame_count{0};
         float elapsed_sec{0.0f};
+
+        // Status update dispatch (PrinterState) during the interval
+        uint32_t dispatch_count{0};
+        float dispatch_avg_us{0.0f};
+        float dispatch_max_us{0.0f};
     };
 
     struct FinalBenchmarkReport {
@@ -102,6 +107,15 @@ class MainLoopHandler {
      */
     bool benchmark_should_report() const;
 
+    /**
+     * @brief Add status dispatch timing to the current benchmark interval
+     *
+     * @param count Number of status updates dispatched
+     * @param total_ns Total dispatch time in nanoseconds
+     * @param max_ns Slowest single dispatch in nanoseconds
+     */
+    void benchmark_record_dispatch(uint32_t count, uint64_t total_ns, uint64_t max_ns);
+
     /**
      * @brief Get and consume benchmark report (resets counters)
      */
@@ -124,6 +138,9 @@ class MainLoopHandler {
     // Benchmark state
     uint32_t m_benchmark_frame_count{0};
     uint32_t m_benchmark_last_report{0};
+    uint32_t m_benchmark_dispatch_count{0};
+    uint64_t m_benchmark_dispatch_total_ns{0};
+    uint64_t m_benchmark_dispatch_max_ns{0};
 };
 
 } // namespace helix::application
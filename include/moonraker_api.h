@@ -412,6 +412,10 @@ class MoonrakerAPI {
     /// Subscribe to status update notifications (mirrors MoonrakerClient::register_notify_update)
     virtual helix::SubscriptionId subscribe_notifications(std::function<void(json)> callback);
 
+    /// Zero-copy variant (mirrors MoonrakerClient::register_notify_update_shared)
+    virtual helix::SubscriptionId
+    subscribe_notifications_shared(helix::SharedNotifyCallback callback);
+
     /// Unsubscribe from status update notifications
     virtual bool unsubscribe_notifications(helix::SubscriptionId id);
 
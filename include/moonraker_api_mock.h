@@ -369,7 +369,9 @@ class MoonrakerFileTransferAPIMock : public MoonrakerFileTransferAPI {
                                SuccessCallback on_success, ErrorCallback on_error) override;
 
     void download_thumbnail(const std::string& thumbnail_path, const std::string& cache_path,
-                            StringCallback on_success, ErrorCallback on_error) override;
+                            StringCallback on_success, ErrorCallback on_error,
+                            helix::HttpPriority priority = helix::HttpPriority::VISIBLE,
+                            const std::string& cancel_key = {}) override;
 
   private:
     /**
@@ -419,6 +421,8 @@ class MoonrakerAPIMock : public MoonrakerAPI {
     // ========================================================================
 
     helix::SubscriptionId subscribe_notifications(std::function<void(json)> callback) override;
+    helix::SubscriptionId
+    subscribe_notifications_shared(helix::SharedNotifyCallback callback) override;
     bool unsubscribe_notifications(helix::SubscriptionId id) override;
     void register_method_callback(const std::string& method, const std::string& name,
                                   std::function<void(json)> callback) override;
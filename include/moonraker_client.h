@@ -42,17 +42,21 @@
 #include "moonraker_discovery_sequence.h"
 #include "moonraker_error.h"
 #include "moonraker_events.h"
+#include "moonraker_frame_log.h"
 #include "moonraker_request.h"
 #include "moonraker_request_tracker.h"
+#include "moonraker_status_decoder.h"
 #include "moonraker_types.h"
 #include "printer_detector.h" // For BuildVolume struct
 #include "printer_discovery.h"
+#include "status_subscription_manager.h"
 #include "spdlog/spdlog.h"
 
 #include <atomic>
 #include <chrono>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -69,6 +73,23 @@ using SubscriptionId = uint64_t;
 /** @brief Invalid subscription ID constant */
 inline constexpr SubscriptionId INVALID_SUBSCRIPTION_ID = 0;
 
+/**
+ * @brief Immutable parsed notification shared by every subscriber
+ *
+ * Each WebSocket frame is parsed once; subscribers receive the same document
+ * by reference count instead of each taking a deep copy.
+ */
+using SharedJson = std::shared_ptr<const nlohmann::json>;
+
+/** @brief Callback type for shared (zero-copy) status update subscriptions */
+using SharedNotifyCallback = std::function<void(const SharedJson&)>;
+
+/** @brief Immutable decoded status frame shared by every frame subscriber */
+using SharedStatusFrame = std::shared_ptr<const StatusFrame>;
+
+/** @brief Callback type for decoded status frame subscriptions */
+using StatusFrameCallback = std::function<void(const SharedStatusFrame&)>;
+
 // RequestId and INVALID_REQUEST_ID are defined in moonraker_request_tracker.h
 
 } // namespace helix
@@ -174,18 +195,51 @@ class MoonrakerClient : public hv::WebSocketClient {
      * Invoked when Moonraker sends "notify_status_update" messages
      * (triggered by printer.objects.subscribe subscriptions).
      *
+     * Compatibility shim over register_notify_update_shared(): the callback
+     * receives its own copy of the notification. Prefer the shared variant for
+     * new code and for anything on the per-frame hot path.
+     *
      * @param cb Callback function receiving parsed JSON notification
      * @return Subscription ID for later unsubscription (0 = invalid/failed)
      */
     SubscriptionId register_notify_update(std::function<void(json)> cb);
 
+    /**
+     * @brief Register zero-copy callback for status update notifications
+     *
+     * The notification is parsed once and the same immutable document is handed
+     * to every subscriber. Callers that need the data on another thread should
+     * capture the SharedJson rather than copying the JSON.
+     *
+     * @param cb Callback receiving the shared, immutable notification
+     * @return Subscription ID for later unsubscription (0 = invalid/failed)
+     */
+    SubscriptionId register_notify_update_shared(SharedNotifyCallback cb);
+
+    /**
+     * @brief Register callback for decoded notify_status_update frames
+     *
+     * While only frame subscribers are registered, status updates are decoded
+     * straight from the WebSocket text by StatusFrameDecoder and no JSON
+     * document is built for them. If JSON subscribers exist as well, the frame
+     * is derived from the parsed document so both see the same data.
+     *
+     * Shares the ID space of register_notify_update(); remove with
+     * unsubscribe_notify_update().
+     *
+     * @param cb Callback receiving the shared, immutable frame
+     * @return Subscription ID for later unsubscription (0 = invalid/failed)
+     */
+    SubscriptionId register_status_frame_callback(StatusFrameCallback cb);
+
     /**
      * @brief Unsubscribe from status update notifications
      *
      * Removes a previously registered notification callback.
      * Safe to call with invalid IDs (no-op).
      *
-     * @param id Subscription ID returned by register_notify_update()
+     * @param id Subscription ID returned by register_notify_update() or
+     *           register_status_frame_callback()
      * @return true if subscription was found and removed, false otherwise
      */
     bool unsubscribe_notify_update(SubscriptionId id);
@@ -360,6 +414,15 @@ class MoonrakerClient : public hv::WebSocketClient {
         return discovery_.hardware();
     }
 
+    /**
+     * @brief Field selection for the status subscription
+     *
+     * Panels register the extra fields they display through NavigationManager.
+     */
+    helix::StatusSubscriptionManager& status_subscriptions() {
+        return status_subscriptions_;
+    }
+
     /**
      * @brief Check if client has been identified to Moonraker
      *
@@ -528,6 +591,42 @@ class MoonrakerClient : public hv::WebSocketClient {
         reconnect_max_delay_ms_ = reconnect_max_delay_ms;
     }
 
+    /**
+     * @brief Batch requests issued close together into single WebSocket frames
+     *
+     * Flushes run on the client's event loop, so a burst issued from the main
+     * thread (or from one response callback) goes out as one JSON-RPC batch.
+     *
+     * @param config Window, batch size and in-flight cap (max_batch 1 disables)
+     */
+    void configure_request_batching(const RequestBatchConfig& config);
+
+    /**
+     * @brief Per-method latency histograms and in-flight gauge since the last call
+     */
+    RequestTrackerStats take_request_stats() {
+        return tracker_.take_stats();
+    }
+
+    /**
+     * @brief Record every inbound frame to a frame log (see moonraker_frame_log.h)
+     *
+     * Replaces any recording in progress. Frames are appended on the WebSocket
+     * thread as they arrive, before any parsing.
+     *
+     * @param path Log file to create
+     * @return false if the file could not be created
+     */
+    bool start_frame_recording(const std::string& path);
+
+    /// Close the frame log, if recording
+    void stop_frame_recording();
+
+    /// Inbound WebSocket frames handed to the client since construction
+    uint64_t frames_received() const {
+        return frames_received_.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Process timeout checks for pending requests
      *
@@ -595,6 +694,30 @@ class MoonrakerClient : public hv::WebSocketClient {
     void dispatch_status_update(const json& status);
 
   protected:
+    /**
+     * @brief Invoke every notify callback with a shared notification
+     *
+     * Two-phase: callbacks are copied under callbacks_mutex_ and invoked outside
+     * it. Exceptions thrown by a callback are logged and do not stop dispatch.
+     *
+     * @param notification Parsed notification (never null)
+     * @return Number of callbacks invoked
+     */
+    size_t dispatch_notification(const SharedJson& notification);
+
+    /**
+     * @brief Invoke every status frame callback with a shared frame
+     *
+     * Same two-phase and exception rules as dispatch_notification().
+     *
+     * @param frame Decoded frame (never null)
+     * @return Number of callbacks invoked
+     */
+    size_t dispatch_status_frame(const SharedStatusFrame& frame);
+
+    /// True if any JSON notify or status frame subscriber is registered
+    bool has_status_subscribers();
+
     /**
      * @brief Transition to new connection state
      *
@@ -604,9 +727,10 @@ class MoonrakerClient : public hv::WebSocketClient {
 
     // Notification callbacks (protected to allow mock to trigger notifications)
     // Map of subscription ID -> callback for O(1) unsubscription
-    std::map<SubscriptionId, std::function<void(json)>> notify_callbacks_;
+    std::map<SubscriptionId, SharedNotifyCallback> notify_callbacks_;
+    std::map<SubscriptionId, StatusFrameCallback> frame_callbacks_;
     std::atomic<SubscriptionId> next_subscription_id_{1}; // Start at 1 (0 = invalid)
-    std::mutex callbacks_mutex_; // Protect notify_callbacks_ and method_callbacks_
+    std::mutex callbacks_mutex_; // Protect notify/frame callbacks and method_callbacks_
 
     // Persistent method-specific callbacks (protected to allow mock to dispatch)
     // method_name : { handler_name : callback }
@@ -615,10 +739,32 @@ class MoonrakerClient : public hv::WebSocketClient {
     // Discovery sequence (protected to allow mock access to hardware vectors)
     MoonrakerDiscoverySequence discovery_;
 
+    // Field-level subscription state (built by discovery, extended by visible panels)
+    StatusSubscriptionManager status_subscriptions_;
+
   private:
+    /**
+     * @brief SAX fast path for notify_status_update frames
+     *
+     * Taken only when every subscriber to the frame accepts a StatusFrame.
+     *
+     * @param msg Raw WebSocket text
+     * @return true if the message was fully handled
+     */
+    bool try_dispatch_status_frame(const std::string& msg);
+
     // Request tracker (pending requests, timeouts, response routing)
     MoonrakerRequestTracker tracker_;
 
+    // Status frame decoder (WebSocket thread only)
+    StatusFrameDecoder status_decoder_;
+
+    // Inbound frame counter and optional recording (HELIX_RECORD_FRAMES)
+    std::atomic<uint64_t> frames_received_{0};
+    std::atomic<bool> recording_frames_{false};
+    std::unique_ptr<FrameLogWriter> frame_log_;
+    std::mutex frame_log_mutex_;
+
     // Connection state tracking
     std::atomic_bool was_connected_;
     std::atomic<ConnectionState> connection_state_;
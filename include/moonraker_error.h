@@ -21,6 +21,7 @@ enum class MoonrakerErrorType {
     NOT_READY,         ///< Klipper not in ready state
     FILE_NOT_FOUND,    ///< Requested file doesn't exist
     PERMISSION_DENIED, ///< Operation not allowed
+    CANCELLED,         ///< Request cancelled by its requester before completing
     UNKNOWN            ///< Unknown error
 };
 
@@ -66,6 +67,8 @@ struct MoonrakerError {
             return "FILE_NOT_FOUND";
         case MoonrakerErrorType::PERMISSION_DENIED:
             return "PERMISSION_DENIED";
+        case MoonrakerErrorType::CANCELLED:
+            return "CANCELLED";
         case MoonrakerErrorType::UNKNOWN:
             return "UNKNOWN";
         default:
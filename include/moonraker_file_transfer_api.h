@@ -6,20 +6,20 @@
  * @brief HTTP file transfer operations via Moonraker
  *
  * Extracted from MoonrakerAPI to encapsulate all HTTP file transfer functionality
- * (downloads, uploads, thumbnails) in a dedicated class. Owns an HTTP thread pool
+ * (downloads, uploads, thumbnails) in a dedicated class. Owns an HTTP worker pool
  * for async file transfer operations.
  */
 
 #pragma once
 
+#include "http_worker_pool.h"
 #include "moonraker_error.h"
 
 #include <atomic>
 #include <functional>
-#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 
 // Forward declarations
 namespace helix {
@@ -30,12 +30,14 @@ class MoonrakerClient;
  * @brief HTTP File Transfer API operations via Moonraker
  *
  * Provides HTTP-based file download and upload operations through Moonraker's
- * /server/files/ endpoints. Manages its own thread pool for async HTTP requests
- * with proper lifecycle management (thread joining on destruction).
+ * /server/files/ endpoints. Requests run on a helix::HttpWorkerPool that is started
+ * on first use: a few workers with keep-alive connections, serving on-screen
+ * thumbnails before prefetches and prefetches before bulk transfers.
  *
- * Thread safety: All file transfer methods launch background HTTP threads.
- * Callbacks are invoked from those threads. Callers must ensure their callback
- * captures remain valid for the duration of the request.
+ * Thread safety: All file transfer methods queue work on the pool's worker
+ * threads. Callbacks are invoked from those threads. Callers must ensure their
+ * callback captures remain valid for the duration of the request. Cancelled
+ * requests invoke neither callback.
  *
  * Usage:
  *   MoonrakerFileTransferAPI transfers(client, http_base_url);
@@ -53,7 +55,7 @@ class MoonrakerFileTransferAPI {
      * @brief Progress callback for file transfer operations
      *
      * Called periodically during download/upload with bytes transferred and total.
-     * NOTE: Called from background HTTP thread - use helix::ui::async_call() for UI updates.
+     * NOTE: Called from an HTTP worker thread - use helix::ui::async_call() for UI updates.
      *
      * @param current Bytes transferred so far
      * @param total Total bytes to transfer
@@ -68,11 +70,13 @@ class MoonrakerFileTransferAPI {
      */
     MoonrakerFileTransferAPI(helix::MoonrakerClient& client, const std::string& http_base_url);
 
+    /// Workers started by the pool on first transfer
+    static constexpr size_t HTTP_WORKERS = 4;
+
     /**
-     * @brief Destructor — joins all pending HTTP threads
+     * @brief Destructor — drops queued transfers and joins the HTTP workers
      *
-     * Signals shutdown and waits for active HTTP threads with timeout.
-     * Threads that don't complete within 2 seconds are detached.
+     * Workers still inside a transfer after 2 seconds are detached.
      */
     virtual ~MoonrakerFileTransferAPI();
 
@@ -85,6 +89,7 @@ class MoonrakerFileTransferAPI {
      *
      * Uses GET request to /server/files/{root}/{path} endpoint.
      * The file content is returned as a string in the callback.
+     * Runs in the PREFETCH lane.
      *
      * Virtual to allow mocking in tests (MoonrakerAPIMock reads local files).
      *
@@ -101,6 +106,7 @@ class MoonrakerFileTransferAPI {
      *
      * Uses HTTP Range request to fetch only the beginning of a file.
      * Ideal for scanning G-code files where operations are in the preamble.
+     * Runs in the PREFETCH lane.
      *
      * @param root Root directory ("gcodes", "config", etc.)
      * @param path File path relative to root
@@ -118,6 +124,7 @@ class MoonrakerFileTransferAPI {
      * Unlike download_file() which loads entire content into memory,
      * this streams chunks directly to disk as they arrive. Essential
      * for large G-code files on memory-constrained devices like AD5M.
+     * Runs in the BACKGROUND lane on its own connection.
      *
      * Virtual to allow mocking in tests.
      *
@@ -126,7 +133,7 @@ class MoonrakerFileTransferAPI {
      * @param dest_path Local filesystem path to write to
      * @param on_success Callback with dest_path on success
      * @param on_error Error callback
-     * @param on_progress Optional callback for progress updates (called from HTTP thread)
+     * @param on_progress Optional callback for progress updates (called from HTTP worker)
      */
     virtual void download_file_to_path(const std::string& root, const std::string& path,
                                        const std::string& dest_path, StringCallback on_success,
@@ -139,16 +146,45 @@ class MoonrakerFileTransferAPI {
      * Downloads thumbnail from Moonraker's HTTP server and saves to a local cache file.
      * The callback receives the local file path (suitable for LVGL image loading).
      *
+     * Pass a @p cancel_key to make the download cancellable with
+     * cancel_thumbnail(), e.g. when the card showing it scrolls off-screen.
+     * Keys should name the requester ("print_select:" + path) so cancelling
+     * one caller's request never drops another caller's download of the
+     * same file.
+     *
      * Virtual to allow mocking in tests.
      *
      * @param thumbnail_path Relative path from metadata (e.g., ".thumbnails/file.png")
      * @param cache_path Local filesystem path to save the thumbnail
      * @param on_success Callback with local cache path
-     * @param on_error Error callback
+     * @param on_error Error callback; MoonrakerErrorType::CANCELLED if cancelled
+     * @param priority Worker pool lane (VISIBLE for thumbnails on screen)
+     * @param cancel_key Tag for cancel_thumbnail(); empty means not cancellable
      */
     virtual void download_thumbnail(const std::string& thumbnail_path,
                                     const std::string& cache_path, StringCallback on_success,
-                                    ErrorCallback on_error);
+                                    ErrorCallback on_error,
+                                    helix::HttpPriority priority = helix::HttpPriority::VISIBLE,
+                                    const std::string& cancel_key = {});
+
+    /**
+     * @brief Cancel pending thumbnail downloads queued under a cancel key
+     *
+     * Queued downloads are dropped; one already running finishes its transfer
+     * but skips the cache write. Either way the download's on_error receives
+     * MoonrakerErrorType::CANCELLED.
+     *
+     * @param cancel_key Same key passed to download_thumbnail()
+     * @return true if a download was cancelled
+     */
+    bool cancel_thumbnail(const std::string& cancel_key);
+
+    /**
+     * @brief Per-lane queue wait and transfer times since the previous call
+     *
+     * All zero until the first transfer starts the worker pool.
+     */
+    helix::HttpPoolStats take_transfer_stats();
 
     // ========================================================================
     // Upload Operations
@@ -177,6 +213,7 @@ class MoonrakerFileTransferAPI {
      *
      * Like upload_file() but allows specifying a different filename for the
      * multipart form than the path. Useful when uploading to a subdirectory.
+     * Runs in the PREFETCH lane: these are small config and macro saves.
      *
      * Virtual to allow mocking in tests (MoonrakerAPIMock logs but doesn't write).
      *
@@ -196,7 +233,7 @@ class MoonrakerFileTransferAPI {
      *
      * Streams file from disk to Moonraker in chunks, never loading the entire
      * file into memory. Essential for large G-code files on memory-constrained
-     * devices like AD5M.
+     * devices like AD5M. Runs in the BACKGROUND lane on its own connection.
      *
      * Virtual to allow mocking in tests.
      *
@@ -205,7 +242,7 @@ class MoonrakerFileTransferAPI {
      * @param local_path Local filesystem path to read from
      * @param on_success Success callback
      * @param on_error Error callback
-     * @param on_progress Optional callback for progress updates (called from HTTP thread)
+     * @param on_progress Optional callback for progress updates (called from HTTP worker)
      */
     virtual void upload_file_from_path(const std::string& root, const std::string& dest_path,
                                        const std::string& local_path, SuccessCallback on_success,
@@ -217,19 +254,23 @@ class MoonrakerFileTransferAPI {
     const std::string& http_base_url_;
 
   private:
-    // Track pending HTTP request threads to ensure clean shutdown
-    // IMPORTANT: Prevents use-after-free when threads outlive the API object
-    mutable std::mutex http_threads_mutex_;
-    std::list<std::thread> http_threads_;
+    // Worker pool is created on first use so mock APIs never start threads.
+    // Shared so cancel_thumbnail() can cancel without holding pool_mutex_.
+    mutable std::mutex pool_mutex_;
+    std::shared_ptr<helix::HttpWorkerPool> pool_;
     std::atomic<bool> shutting_down_{false};
 
     /**
-     * @brief Launch an HTTP request thread with automatic lifecycle management
+     * @brief Queue an HTTP job on the worker pool, starting the pool if needed
      *
-     * Spawns a thread for async HTTP operations and tracks it for cleanup.
-     * Thread is automatically removed from tracking when it completes.
+     * Dropped silently once shutdown has begun.
      *
-     * @param func The function to execute in the thread
+     * @param priority Lane to queue the job in
+     * @param job The function to execute on a worker
+     * @param key Optional cancellation key (see HttpWorkerPool::cancel_key)
+     * @param on_cancel Called if the job is cancelled while still queued
      */
-    void launch_http_thread(std::function<void()> func);
+    void submit_http_job(helix::HttpPriority priority, helix::HttpWorkerPool::Job job,
+                         std::string key = {},
+                         helix::HttpWorkerPool::CancelHandler on_cancel = nullptr);
 };
@@ -0,0 +1,118 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file moonraker_frame_log.h
+ * @brief Compact log of timestamped inbound Moonraker WebSocket frames
+ *
+ * MoonrakerClient can record every frame it receives (HELIX_RECORD_FRAMES).
+ * The test suite's FrameReplayer streams a log back through MockWebSocketServer,
+ * so a busy print can be reproduced on a desktop at its original pace or as
+ * fast as the client keeps up.
+ *
+ * Format:
+ *
+ *   "HXFRAMES" version(1 byte)
+ *   { varint delta_us, varint length, length bytes of frame text }*
+ *
+ * delta_us is the time since the previous frame (since the start of the
+ * recording for the first). A typical status frame costs two or three bytes of
+ * framing. A truncated final record (recorder killed mid-write) ends the log.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace helix {
+
+/// One frame read back from a log
+struct LoggedFrame {
+    uint64_t time_us = 0; ///< Time since the start of the recording
+    std::string payload;  ///< Frame text as received
+};
+
+/**
+ * @brief Appends frames to a log file
+ *
+ * Not thread-safe; MoonrakerClient serializes access.
+ */
+class FrameLogWriter {
+  public:
+    static constexpr uint8_t VERSION = 1;
+
+    FrameLogWriter() = default;
+    ~FrameLogWriter();
+
+    FrameLogWriter(const FrameLogWriter&) = delete;
+    FrameLogWriter& operator=(const FrameLogWriter&) = delete;
+
+    /**
+     * @brief Create (truncate) @p path and write the header
+     *
+     * @return false if the file could not be created
+     */
+    bool open(const std::string& path);
+
+    /// Flush and close; further appends are ignored
+    void close();
+
+    bool is_open() const {
+        return file_.is_open();
+    }
+
+    /// Append a frame stamped with the time since open()
+    void append(std::string_view payload);
+
+    /// Append a frame with an explicit timestamp (clamped to be non-decreasing)
+    void append(std::string_view payload, uint64_t time_us);
+
+    uint64_t frame_count() const {
+        return frames_;
+    }
+
+    /// Payload bytes written (excluding framing)
+    uint64_t byte_count() const {
+        return bytes_;
+    }
+
+  private:
+    void write_varint(uint64_t value);
+
+    std::ofstream file_;
+    uint64_t start_us_ = 0;
+    uint64_t last_us_ = 0;
+    uint64_t frames_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+/**
+ * @brief Reads frames back from a log file in order
+ */
+class FrameLogReader {
+  public:
+    /**
+     * @brief Open @p path and check the header
+     *
+     * @return false if the file is missing or not a frame log
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Read the next frame
+     *
+     * @return false at the end of the log (or at a truncated record)
+     */
+    bool next(LoggedFrame& frame);
+
+  private:
+    bool read_varint(uint64_t& value);
+
+    std::ifstream file_;
+    uint64_t time_us_ = 0;
+};
+
+} // namespace helix
@@ -197,8 +197,14 @@ class MoonrakerManager {
     std::unique_ptr<helix::MoonrakerClient> m_client;
     std::unique_ptr<MoonrakerAPI> m_api;
 
-    // Thread-safe notification queue
-    std::queue<nlohmann::json> m_notification_queue;
+    /// Queued item: a connection state change (json) or a decoded status frame
+    struct QueuedNotification {
+        std::shared_ptr<const nlohmann::json> json;
+        std::shared_ptr<const helix::StatusFrame> frame;
+    };
+
+    // Thread-safe notification queue (shared with other subscribers, never copied)
+    std::queue<QueuedNotification> m_notification_queue;
     mutable std::mutex m_notification_mutex;
 
     // Print start collector (monitors PRINT_START macro progress)
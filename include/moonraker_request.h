@@ -21,9 +21,11 @@ struct PendingRequest {
     std::function<void(json)>
         success_callback; ///< Success callback (pass-by-value for thread safety)
     std::function<void(const MoonrakerError&)> error_callback; ///< Error callback (optional)
-    std::chrono::steady_clock::time_point timestamp;           ///< When request was sent
+    std::chrono::steady_clock::time_point timestamp;           ///< When request was issued
     uint32_t timeout_ms;                                       ///< Timeout in milliseconds
     bool silent = false; ///< If true, suppress RPC_ERROR events (for internal probes)
+    bool in_flight = false; ///< Written to the socket (false while waiting in the batch queue)
+    std::chrono::steady_clock::time_point sent_at; ///< When the request was written
 
     /**
      * @brief Check if request has timed out
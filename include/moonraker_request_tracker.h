@@ -8,8 +8,11 @@
 #include "moonraker_events.h"
 #include "moonraker_request.h"
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -30,12 +33,69 @@ using RequestId = uint64_t;
 /// @brief Invalid request ID constant
 constexpr RequestId INVALID_REQUEST_ID = 0;
 
+/**
+ * @brief Request batching parameters
+ *
+ * Requests queued within one flush window are written as a single JSON-RPC
+ * batch (a JSON array, answered by Moonraker with an array of responses).
+ */
+struct RequestBatchConfig {
+    /// Extra delay before flushing; 0 flushes on the next event-loop iteration
+    uint32_t window_ms = 0;
+    /// Most requests per WebSocket frame (1 disables batching)
+    size_t max_batch = 16;
+    /// Most requests awaiting a response; further requests wait in the queue
+    size_t max_in_flight = 32;
+};
+
+/**
+ * @brief Round-trip latency histogram for one method
+ *
+ * Power-of-two millisecond buckets: bucket 0 is < 1ms, bucket N covers
+ * [2^(N-1), 2^N) ms, the last bucket is open-ended.
+ */
+struct RequestLatencyHistogram {
+    static constexpr size_t BUCKETS = 16;
+
+    std::array<uint32_t, BUCKETS> buckets{};
+    uint32_t count = 0;    ///< Responses received (success or JSON-RPC error)
+    uint32_t errors = 0;   ///< JSON-RPC error responses
+    uint32_t timeouts = 0; ///< Requests that timed out (not in the buckets)
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+
+    void record(uint64_t latency_us, bool is_error);
+
+    double avg_ms() const {
+        return count > 0 ? static_cast<double>(total_us) / count / 1000.0 : 0.0;
+    }
+
+    /// Upper bound in ms of the bucket holding the given percentile (0-100)
+    uint32_t percentile_ms(double percentile) const;
+};
+
+/// Counters reported by MoonrakerRequestTracker::take_stats()
+struct RequestTrackerStats {
+    std::map<std::string, RequestLatencyHistogram> methods; ///< Keyed by RPC method
+    size_t in_flight = 0;      ///< Requests written and awaiting a response (now)
+    size_t queued = 0;         ///< Requests waiting for an in-flight slot (now)
+    size_t peak_in_flight = 0; ///< Highest in_flight since the previous call
+    uint64_t frames = 0;       ///< WebSocket frames written for tracked requests
+    uint64_t batched = 0;      ///< Requests that shared a frame with another request
+};
+
 /**
  * @brief Owns pending JSON-RPC request lifecycle
  *
  * Handles request ID generation, registration, timeout checking,
  * response routing, and disconnect cleanup. Uses two-phase lock
  * pattern: copy callbacks under lock, invoke outside lock.
+ *
+ * With batching enabled, send() only registers and queues the request; the
+ * owner's flush scheduler later calls flush(), which writes everything queued
+ * (up to the in-flight cap) as one JSON-RPC batch. Requests that must not wait
+ * behind others (G-code, print control, emergency stop) are always written
+ * immediately.
  */
 class MoonrakerRequestTracker {
   public:
@@ -64,6 +124,38 @@ class MoonrakerRequestTracker {
                    std::function<void(const MoonrakerError&)> error_cb, uint32_t timeout_ms = 0,
                    bool silent = false);
 
+    /**
+     * @brief Queue requests for batched writes instead of sending each one
+     *
+     * @param config Window, batch size and in-flight cap
+     * @param schedule_flush Called (from any thread) when flush() should run after
+     *        the given delay in ms; must eventually call flush() on the owner
+     */
+    void enable_batching(const RequestBatchConfig& config,
+                         std::function<void(uint32_t delay_ms)> schedule_flush);
+
+    /**
+     * @brief Write queued requests as one frame, up to the in-flight cap
+     *
+     * Called by the owner's flush scheduler. Requests cancelled or timed out
+     * while queued are skipped.
+     *
+     * @param ws WebSocket client to send through
+     */
+    void flush(hv::WebSocketClient& ws);
+
+    /**
+     * @brief Latency histograms and in-flight gauge since the previous call
+     */
+    RequestTrackerStats take_stats();
+
+    /**
+     * @brief Whether a method may wait in the batch queue
+     *
+     * False for methods whose effect must not be delayed behind other requests.
+     */
+    static bool is_batchable(const std::string& method);
+
     /**
      * @brief Send fire-and-forget JSON-RPC (no callbacks, no tracking)
      *
@@ -127,10 +219,41 @@ class MoonrakerRequestTracker {
     }
 
   private:
+    /// Serialized request waiting for an in-flight slot
+    struct QueuedRequest {
+        RequestId id;
+        std::string payload;
+    };
+
+    /// Write one frame; on failure fail every request in it (no lock held)
+    bool write_frame(hv::WebSocketClient& ws, const std::string& frame,
+                     const std::vector<RequestId>& ids);
+
+    /// Mark a registered request as written (caller holds requests_mutex_)
+    void mark_sent_locked(PendingRequest& request);
+
+    /// Bookkeeping when a request leaves pending_requests_ (caller holds requests_mutex_)
+    /// @return true if queued requests can now be flushed
+    bool release_locked(const PendingRequest& request);
+
+    /// Ask the owner to flush if anything is queued (no lock held)
+    void request_flush(uint32_t delay_ms);
+
     std::map<uint64_t, PendingRequest> pending_requests_;
     std::mutex requests_mutex_;
     std::atomic_uint64_t request_id_{0};
     uint32_t default_request_timeout_ms_{30000};
+
+    // Batching (protected by requests_mutex_)
+    bool batching_ = false;
+    RequestBatchConfig batch_config_;
+    std::function<void(uint32_t)> schedule_flush_;
+    std::deque<QueuedRequest> outbox_;
+    bool flush_scheduled_ = false;
+    size_t in_flight_ = 0;
+
+    // Statistics (protected by requests_mutex_)
+    RequestTrackerStats stats_;
 };
 
 } // namespace helix
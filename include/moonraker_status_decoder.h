@@ -0,0 +1,289 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file moonraker_status_decoder.h
+ * @brief Streaming (SAX) decoder for notify_status_update frames
+ *
+ * ## Why
+ *
+ * A full nlohmann DOM for every status frame costs hundreds of small heap
+ * allocations (one per object, key and array), and the state components then
+ * walk it again with string lookups. At 10-20 frames/s this dominates CPU time
+ * on single-core printers.
+ *
+ * ## What
+ *
+ * StatusFrameDecoder recognizes the high-rate Klipper objects (extruder*,
+ * heater_bed, toolhead, gcode_move, print_stats, virtual_sdcard, fan,
+ * motion_report) and writes their numeric fields straight into a fixed-size
+ * StatusFrame. Everything else - unknown objects, and non-numeric fields of the
+ * known ones (toolhead.homed_axes, print_stats.state, ...) - is built into the
+ * small StatusFrame::other DOM, so existing JSON consumers keep working.
+ *
+ * print_stats and virtual_sdcard are additionally kept whole in `other`, because
+ * PrinterPrintState still evaluates them as JSON (ordering-sensitive logic).
+ *
+ * @see PrinterState::update_from_frame
+ */
+
+#pragma once
+
+#include "json_fwd.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace helix {
+
+/// Heater readings (extruder*, heater_bed)
+struct HeaterSample {
+    enum Field : uint16_t {
+        TEMPERATURE = 1 << 0,
+        TARGET = 1 << 1,
+        POWER = 1 << 2,
+    };
+    uint16_t fields = 0; ///< Bitmask of Field values present in the frame
+    double temperature = 0.0;
+    double target = 0.0;
+    double power = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// toolhead numeric fields
+struct ToolheadSample {
+    enum Field : uint16_t {
+        POSITION = 1 << 0,
+        MAX_VELOCITY = 1 << 1,
+        MAX_ACCEL = 1 << 2,
+        PRINT_TIME = 1 << 3,
+        ESTIMATED_PRINT_TIME = 1 << 4,
+    };
+    uint16_t fields = 0;
+    std::array<double, 4> position{}; ///< X, Y, Z, E
+    double max_velocity = 0.0;
+    double max_accel = 0.0;
+    double print_time = 0.0;
+    double estimated_print_time = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// gcode_move numeric fields
+struct GcodeMoveSample {
+    enum Field : uint16_t {
+        POSITION = 1 << 0,
+        GCODE_POSITION = 1 << 1,
+        HOMING_ORIGIN = 1 << 2,
+        SPEED_FACTOR = 1 << 3,
+        EXTRUDE_FACTOR = 1 << 4,
+        SPEED = 1 << 5,
+    };
+    uint16_t fields = 0;
+    std::array<double, 4> position{};
+    std::array<double, 4> gcode_position{};
+    std::array<double, 4> homing_origin{};
+    double speed_factor = 1.0;
+    double extrude_factor = 1.0;
+    double speed = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// print_stats numeric fields (the object is also kept in StatusFrame::other)
+struct PrintStatsSample {
+    enum Field : uint16_t {
+        PRINT_DURATION = 1 << 0,
+        TOTAL_DURATION = 1 << 1,
+        FILAMENT_USED = 1 << 2,
+    };
+    uint16_t fields = 0;
+    double print_duration = 0.0;
+    double total_duration = 0.0;
+    double filament_used = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// virtual_sdcard numeric fields (the object is also kept in StatusFrame::other)
+struct VirtualSdcardSample {
+    enum Field : uint16_t {
+        PROGRESS = 1 << 0,
+        FILE_POSITION = 1 << 1,
+        FILE_SIZE = 1 << 2,
+    };
+    uint16_t fields = 0;
+    double progress = 0.0;
+    double file_position = 0.0;
+    double file_size = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// Part-cooling fan ("fan" object)
+struct FanSample {
+    enum Field : uint16_t {
+        SPEED = 1 << 0,
+        RPM = 1 << 1,
+    };
+    uint16_t fields = 0;
+    double speed = 0.0;
+    double rpm = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/// motion_report numeric fields
+struct MotionReportSample {
+    enum Field : uint16_t {
+        LIVE_POSITION = 1 << 0,
+        LIVE_VELOCITY = 1 << 1,
+        LIVE_EXTRUDER_VELOCITY = 1 << 2,
+    };
+    uint16_t fields = 0;
+    std::array<double, 4> live_position{};
+    double live_velocity = 0.0;
+    double live_extruder_velocity = 0.0;
+
+    bool has(Field f) const {
+        return (fields & f) != 0;
+    }
+};
+
+/**
+ * @brief One decoded notify_status_update frame
+ *
+ * Fixed-size typed section plus a DOM for whatever the decoder does not type.
+ * `objects` says which typed objects appeared at all; each sample's `fields`
+ * says which of its fields did (Moonraker only sends changed fields).
+ */
+struct StatusFrame {
+    enum Object : uint16_t {
+        EXTRUDER = 1 << 0, ///< At least one extruder* object (see extruder_mask)
+        HEATER_BED = 1 << 1,
+        TOOLHEAD = 1 << 2,
+        GCODE_MOVE = 1 << 3,
+        PRINT_STATS = 1 << 4,
+        VIRTUAL_SDCARD = 1 << 5,
+        FAN = 1 << 6,
+        MOTION_REPORT = 1 << 7,
+    };
+
+    /// "extruder" is index 0, "extruderN" is index N
+    static constexpr size_t MAX_EXTRUDERS = 8;
+
+    double eventtime = 0.0;
+    uint16_t objects = 0;
+    uint8_t extruder_mask = 0; ///< Bit N set when extruder index N is present
+
+    std::array<HeaterSample, MAX_EXTRUDERS> extruders{};
+    HeaterSample heater_bed;
+    ToolheadSample toolhead;
+    GcodeMoveSample gcode_move;
+    PrintStatsSample print_stats;
+    VirtualSdcardSample virtual_sdcard;
+    FanSample fan;
+    MotionReportSample motion_report;
+
+    /// Unknown objects and untyped fields, in status-object form. Null when empty.
+    json other;
+
+    bool has(Object o) const {
+        return (objects & o) != 0;
+    }
+
+    bool has_extruder(size_t index) const {
+        return index < MAX_EXTRUDERS && (extruder_mask & (1u << index)) != 0;
+    }
+
+    /// Reset to the empty state (keeps no allocations from a previous frame)
+    void clear();
+
+    /**
+     * @brief Fold a later frame into this one, newer values winning field by field
+     *
+     * Used to collapse frames that queued up while the main thread was busy.
+     * Refused (returns false, nothing changed) when both frames carry
+     * print_stats.state: each state transition must be applied on its own.
+     *
+     * @param newer Frame received after this one
+     * @return true if merged
+     */
+    bool merge(const StatusFrame& newer);
+
+    /// Klipper object name for an extruder index ("extruder", "extruder1", ...)
+    static std::string extruder_name(size_t index);
+
+    /// Parse "extruder"/"extruderN" into an index; -1 for anything else
+    static int extruder_index(std::string_view name);
+};
+
+/**
+ * @brief SAX decoder producing StatusFrame from raw WebSocket text
+ *
+ * Stateless between calls; a single instance may be reused for every frame but
+ * is not thread-safe.
+ */
+class StatusFrameDecoder {
+  public:
+    /**
+     * @brief Cheap check whether a raw message is a notify_status_update
+     *
+     * Only inspects the head of the message, so it is safe to call on every
+     * frame before deciding to take the SAX path.
+     */
+    static bool is_status_update(std::string_view message);
+
+    /**
+     * @brief Decode a full JSON-RPC notify_status_update message
+     *
+     * @param message Raw WebSocket text
+     * @param out Frame to fill (cleared first)
+     * @return true if the message was a well-formed notify_status_update
+     */
+    bool decode(std::string_view message, StatusFrame& out);
+
+    /**
+     * @brief Fill a frame from an already-parsed status object
+     *
+     * Used for paths that already hold a DOM (initial subscription response,
+     * mock client) so that frame subscribers see the same data either way.
+     *
+     * @param status Status object ({"extruder": {...}, ...})
+     * @param out Frame to fill (cleared first)
+     */
+    static void decode_status(const json& status, StatusFrame& out);
+
+    /**
+     * @brief Fill only the typed section of a frame from a status object
+     *
+     * Unlike decode_status(), nothing is copied into StatusFrame::other; the
+     * caller keeps using `status` itself for untyped lookups. This lets the
+     * JSON update path share the typed apply code without extra copies.
+     */
+    static void decode_typed(const json& status, StatusFrame& out);
+
+    /**
+     * @brief Read temperature/target/power from any heater-like object
+     *
+     * For heaters that are not typed in StatusFrame (heater_generic, ...).
+     */
+    static HeaterSample decode_heater(const json& obj);
+};
+
+} // namespace helix
@@ -16,12 +16,15 @@
  * - on_deactivate() called BEFORE a panel/overlay becomes hidden
  * - on_activate() called AFTER animation completes and panel/overlay is visible
  * - get_name() used for debugging/logging only
+ * - status_fields() subscribed after on_activate(), released after on_deactivate()
  *
  * @threading Main thread only
  */
 
 #pragma once
 
+#include "status_subscription_manager.h"
+
 /**
  * @class IPanelLifecycle
  * @brief Common lifecycle interface for NavigationManager dispatch
@@ -54,4 +57,18 @@ class IPanelLifecycle {
      * @return Panel/overlay name (e.g., "Motion Panel", "Network Settings")
      */
     virtual const char* get_name() const = 0;
+
+    /**
+     * @brief Printer status fields displayed only while visible
+     *
+     * The base subscription carries what the always-on state components read.
+     * Panels showing anything beyond that (e.g. live toolhead position) list it
+     * here; NavigationManager adds it to the subscription while the panel or
+     * overlay is active.
+     *
+     * @return Object -> fields map (empty by default)
+     */
+    virtual helix::StatusFieldMap status_fields() const {
+        return {};
+    }
 };
@@ -191,7 +191,9 @@ class PluginAPI {
      * - If connected: subscribes immediately
      * - If not connected: queues subscription for when connection is established
      *
-     * Subscriptions are automatically cleaned up when the plugin unloads.
+     * Subscribed objects receive every Klipper field, not just the subset the
+     * core UI asks for. Subscriptions are automatically cleaned up when the
+     * plugin unloads.
      *
      * @param objects Klipper objects to subscribe to (e.g., {"extruder", "heater_bed"})
      * @param callback Callback for status updates
@@ -386,6 +388,14 @@ class PluginAPI {
     void cleanup();
 
   private:
+    /**
+     * @brief Push the union of active subscription objects to the status manager
+     *
+     * Registers this API as a StatusSubscriptionManager owner requesting all
+     * fields of every object it subscribed to, or clears it when none remain.
+     */
+    void sync_status_fields(MoonrakerClient* client);
+
     // Core services
     MoonrakerAPI* moonraker_api_;
     MoonrakerClient* moonraker_client_;
@@ -410,6 +420,9 @@ class PluginAPI {
     // This allows proper cleanup when a plugin unloads
     std::unordered_map<MoonrakerSubscriptionId, uint64_t> moonraker_id_map_;
 
+    // Objects requested by each active subscription (drives status field ownership)
+    std::unordered_map<MoonrakerSubscriptionId, std::vector<std::string>> moonraker_objects_;
+
     // Registered subjects (for cleanup)
     std::vector<std::string> registered_subjects_;
 
@@ -3,6 +3,7 @@
 
 #include "ui_observer_guard.h" // SubjectLifetime
 
+#include "moonraker_status_decoder.h"
 #include "subject_managed_panel.h"
 
 #include <lvgl.h>
@@ -91,6 +92,21 @@ class PrinterFanState {
      */
     void update_from_status(const nlohmann::json& status);
 
+    /**
+     * @brief Update fan state from a decoded status frame
+     * @param frame Frame from StatusFrameDecoder; non-part fans come from frame.other
+     */
+    void update_from_frame(const StatusFrame& frame) {
+        apply_status(frame, frame.other);
+    }
+
+    /**
+     * @brief Apply the typed part-fan sample, reading other fans from JSON
+     * @param typed Typed section ("fan")
+     * @param untyped Status object for heater_fan/fan_generic/controller_fan objects
+     */
+    void apply_status(const StatusFrame& typed, const nlohmann::json& untyped);
+
     /**
      * @brief Initialize fan tracking from discovered fan objects
      * @param fan_objects List of Moonraker fan object names
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 #pragma once
 
+#include "moonraker_status_decoder.h"
 #include "subject_managed_panel.h"
 
 #include <lvgl.h>
@@ -46,6 +47,21 @@ class PrinterMotionState {
      */
     void update_from_status(const nlohmann::json& status);
 
+    /**
+     * @brief Update motion state from a decoded status frame
+     * @param frame Frame from StatusFrameDecoder; homed_axes comes from frame.other
+     */
+    void update_from_frame(const StatusFrame& frame) {
+        apply_status(frame, frame.other);
+    }
+
+    /**
+     * @brief Apply typed toolhead/gcode_move fields, reading the rest from JSON
+     * @param typed Typed section (toolhead, gcode_move)
+     * @param untyped Status object for untyped fields (toolhead.homed_axes)
+     */
+    void apply_status(const StatusFrame& typed, const nlohmann::json& untyped);
+
     // Toolhead position accessors - actual physical position (centimillimeters)
     lv_subject_t* get_position_x_subject() {
         return &position_x_;
@@ -4,6 +4,7 @@
 #include "subject_managed_panel.h"
 
 #include <atomic>
+#include <cstdint>
 #include <lvgl.h>
 #include <string>
 
@@ -67,7 +68,7 @@ class PrinterPrintState {
     void reset_for_new_print();
 
     // ========================================================================
-    // Subject accessors (18 subjects)
+    // Subject accessors (19 subjects)
     // ========================================================================
 
     /// Print progress as 0-100 percent
@@ -75,6 +76,16 @@ class PrinterPrintState {
         return &print_progress_;
     }
 
+    /// Bumped whenever get_print_file_position() changes
+    lv_subject_t* get_print_file_position_version_subject() {
+        return &print_file_position_version_;
+    }
+
+    /// Bytes of the file read by virtual_sdcard (64-bit: files may exceed 2 GiB)
+    uint64_t get_print_file_position() const {
+        return print_file_position_;
+    }
+
     /// Raw filename from Moonraker
     lv_subject_t* get_print_filename_subject() {
         return &print_filename_;
@@ -361,6 +372,11 @@ class PrinterPrintState {
     lv_subject_t print_display_filename_{}; // String: clean filename
     lv_subject_t print_thumbnail_path_{};   // String: LVGL thumbnail path
 
+    // virtual_sdcard.file_position does not fit an int subject on files over 2 GiB,
+    // so the value is kept here and the subject only signals changes
+    lv_subject_t print_file_position_version_{};
+    uint64_t print_file_position_ = 0;
+
     // Layer tracking subjects
     lv_subject_t print_layer_current_{}; // Current layer (0-based)
     lv_subject_t print_layer_total_{};   // Total layers
@@ -22,6 +22,7 @@
 #include "printer_temperature_state.h"
 #include "printer_versions_state.h"
 #include "spdlog/spdlog.h"
+#include "status_dispatch_table.h"
 #include "subject_managed_panel.h"
 
 #include <memory>
@@ -232,6 +233,17 @@ class PrinterState {
      */
     void update_from_notification(const json& notification);
 
+    /**
+     * @brief Update state from a shared Moonraker notification
+     *
+     * Zero-copy variant of update_from_notification(): the deferred main-thread
+     * update keeps a reference to the shared document instead of copying the
+     * status object.
+     *
+     * @param notification Shared, immutable notification (null is ignored)
+     */
+    void update_from_notification_shared(std::shared_ptr<const json> notification);
+
     /**
      * @brief Update state from raw status data
      *
@@ -243,6 +255,47 @@ class PrinterState {
      */
     void update_from_status(const json& status);
 
+    /**
+     * @brief Update state from a status frame decoded by StatusFrameDecoder
+     *
+     * Defers to the main thread like update_from_notification_shared(); the
+     * deferred update keeps the shared frame alive. Frames that arrive before
+     * the previous ones were applied are merged (StatusFrame::merge), so a
+     * stalled main thread applies one catch-up frame instead of a backlog.
+     *
+     * @param frame Shared, immutable frame (null is ignored)
+     */
+    void update_from_frame_shared(std::shared_ptr<const StatusFrame> frame);
+
+    /**
+     * @brief Update state from a decoded status frame (main thread only)
+     *
+     * Typed fields go straight to the temperature, motion and fan components;
+     * everything else is read from frame.other. Only frame.other is merged
+     * into the JSON state cache.
+     *
+     * @param frame Decoded frame
+     */
+    void update_from_frame(const StatusFrame& frame);
+
+    /**
+     * @brief Install the object -> component routing table
+     *
+     * Built by the discovery sequence from the subscription object list. Until
+     * one is installed (and in tests), every update goes to every component.
+     *
+     * @param table Routing table (null restores broadcast dispatch)
+     */
+    void set_status_dispatch_table(std::shared_ptr<const StatusDispatchTable> table);
+
+    /**
+     * @brief Get and reset status dispatch timing since the last call
+     *
+     * Covers update_from_status() and update_from_frame(); reported by the
+     * benchmark mode of MainLoopHandler.
+     */
+    StatusDispatchStats take_status_dispatch_stats();
+
     /**
      * @brief Get raw JSON state for complex queries
      *
@@ -510,6 +563,16 @@ class PrinterState {
         return print_domain_.get_print_filament_used_subject();
     }
 
+    // Byte offset into the print file (from virtual_sdcard.file_position)
+    // Delegated to PrinterPrintState component
+    lv_subject_t* get_print_file_position_version_subject() {
+        return print_domain_.get_print_file_position_version_subject();
+    }
+
+    uint64_t get_print_file_position() const {
+        return print_domain_.get_print_file_position();
+    }
+
     // Layer tracking subjects (from print_stats.info.current_layer/total_layer)
     // Delegated to PrinterPrintState component
     lv_subject_t* get_print_layer_current_subject() {
@@ -1583,6 +1646,25 @@ class PrinterState {
     ZOffsetCalibrationStrategy get_z_offset_calibration_strategy() const;
 
   private:
+    /**
+     * @brief Shared body of update_from_status() and update_from_frame()
+     *
+     * Caller holds state_mutex_.
+     *
+     * @param typed Typed section of the update
+     * @param state JSON status for everything the frame does not type
+     */
+    void apply_status(const StatusFrame& typed, const json& state);
+
+    /// apply_status() plus dispatch timing (caller holds state_mutex_)
+    void timed_apply_status(const StatusFrame& typed, const json& state);
+
+    /// Consumers that read at least one object in this update (caller holds state_mutex_)
+    StatusConsumerMask route_status(const StatusFrame& typed, const json& state) const;
+
+    /// Apply the frames queued by update_from_frame_shared() (main thread)
+    void apply_pending_frames();
+
     /// RAII manager for automatic subject cleanup - deinits all subjects on destruction
     SubjectManager subjects_;
 
@@ -1626,9 +1708,9 @@ class PrinterState {
     helix::PrinterExcludedObjectsState excluded_objects_state_;
 
     // Note: Print subjects are now managed by print_domain_ component
-    // (print_progress_, print_filename_, print_state_, print_state_enum_,
-    //  print_outcome_, print_active_, print_show_progress_, print_display_filename_,
-    //  print_thumbnail_path_, print_layer_current_, print_layer_total_,
+    // (print_progress_, print_file_position_version_, print_filename_, print_state_,
+    //  print_state_enum_, print_outcome_, print_active_, print_show_progress_,
+    //  print_display_filename_, print_thumbnail_path_, print_layer_current_, print_layer_total_,
     //  print_duration_, print_time_left_, print_start_phase_, print_start_message_,
     //  print_start_progress_, print_in_progress_)
 
@@ -1690,6 +1772,17 @@ class PrinterState {
     json json_state_;
     std::mutex state_mutex_;
 
+    // Status routing and timing (protected by state_mutex_)
+    std::shared_ptr<const StatusDispatchTable> dispatch_table_;
+    StatusDispatchStats dispatch_stats_;
+
+    // Status frames waiting for the main thread (protected by pending_frames_mutex_).
+    // merged_tail_ is set while pending_frames_.back() is a private copy that
+    // later frames are merged into.
+    std::mutex pending_frames_mutex_;
+    std::vector<std::shared_ptr<const StatusFrame>> pending_frames_;
+    std::shared_ptr<StatusFrame> merged_tail_;
+
     // Initialization guard to prevent multiple subject initializations
     bool subjects_initialized_ = false;
 
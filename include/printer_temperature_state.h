@@ -3,6 +3,7 @@
 
 #include "ui_observer_guard.h" // SubjectLifetime
 
+#include "moonraker_status_decoder.h"
 #include "subject_managed_panel.h"
 
 #include <lvgl.h>
@@ -69,6 +70,21 @@ class PrinterTemperatureState {
      */
     void update_from_status(const nlohmann::json& status);
 
+    /**
+     * @brief Update temperatures from a decoded status frame
+     * @param frame Frame from StatusFrameDecoder; untyped heaters come from frame.other
+     */
+    void update_from_frame(const StatusFrame& frame) {
+        apply_status(frame, frame.other);
+    }
+
+    /**
+     * @brief Apply typed heater samples, reading other heaters from JSON
+     * @param typed Typed section (extruder*, heater_bed)
+     * @param untyped Status object for heaters without a typed slot (chamber)
+     */
+    void apply_status(const StatusFrame& typed, const nlohmann::json& untyped);
+
     /**
      * @brief Re-register subjects with LVGL XML system
      *
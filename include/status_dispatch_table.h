@@ -0,0 +1,137 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file status_dispatch_table.h
+ * @brief Object-name -> component routing for PrinterState status updates
+ *
+ * PrinterState::update_from_status() used to hand every status frame to every
+ * domain component and sensor manager, each of which then probed the frame for
+ * the keys it cares about. Most frames only carry extruder/bed/toolhead data,
+ * so the majority of that work found nothing.
+ *
+ * StatusDispatchTable is built once at discovery time from the subscribed
+ * object list. Each object gets an integer handle and a mask of the consumers
+ * that read it; a frame is then routed by OR-ing the masks of its keys, and
+ * only the consumers in the result are invoked.
+ *
+ * Routing is conservative: an object name the classifier does not recognize
+ * routes to every consumer, so a missing rule costs time, never an update.
+ *
+ * @see MoonrakerDiscoverySequence::complete_discovery_subscription
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace helix {
+
+/// Components that PrinterState::update_from_status() forwards status to
+enum class StatusConsumer : uint8_t {
+    TEMPERATURE,         ///< PrinterTemperatureState
+    MOTION,              ///< PrinterMotionState
+    PRINT,               ///< PrinterPrintState
+    TOOLHEAD,            ///< Kinematics / active extruder (PrinterState itself)
+    FAN,                 ///< PrinterFanState
+    LED,                 ///< PrinterLedState
+    LED_CONTROLLER,      ///< LedController backends (native, effects, output_pin)
+    EXCLUDE_OBJECT,      ///< Excluded objects state
+    WEBHOOKS,            ///< Klippy state from webhooks
+    CALIBRATION,         ///< PrinterCalibrationState
+    FILAMENT_SENSORS,    ///< FilamentSensorManager
+    HUMIDITY_SENSORS,    ///< HumiditySensorManager
+    WIDTH_SENSORS,       ///< WidthSensorManager
+    PROBE_SENSORS,       ///< ProbeSensorManager
+    ACCEL_SENSORS,       ///< AccelSensorManager
+    COLOR_SENSORS,       ///< ColorSensorManager
+    TEMPERATURE_SENSORS, ///< TemperatureSensorManager
+    COUNT
+};
+
+/// Bitmask of StatusConsumer values
+using StatusConsumerMask = uint32_t;
+
+constexpr StatusConsumerMask status_consumer_bit(StatusConsumer consumer) {
+    return StatusConsumerMask{1} << static_cast<uint8_t>(consumer);
+}
+
+/// Every consumer (used for unrecognized objects and when no table is installed)
+inline constexpr StatusConsumerMask ALL_STATUS_CONSUMERS =
+    (StatusConsumerMask{1} << static_cast<uint8_t>(StatusConsumer::COUNT)) - 1;
+
+/// Accumulated status dispatch timing (see PrinterState::take_status_dispatch_stats)
+struct StatusDispatchStats {
+    uint32_t frames = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+/**
+ * @brief Immutable map from subscribed object name to interested consumers
+ *
+ * Thread-safe for concurrent reads once built.
+ */
+class StatusDispatchTable {
+  public:
+    using Handle = uint16_t;
+    static constexpr Handle INVALID_HANDLE = 0xFFFF;
+
+    StatusDispatchTable() = default;
+
+    /**
+     * @brief Build a table for a subscription object list
+     * @param objects Klipper object names (duplicates are ignored)
+     */
+    explicit StatusDispatchTable(const std::vector<std::string>& objects);
+
+    /// Handle for an object name, INVALID_HANDLE if it was not subscribed
+    Handle handle_of(const std::string& object_name) const;
+
+    /// Object name for a handle
+    const std::string& name_of(Handle handle) const {
+        return names_[handle];
+    }
+
+    /// Consumers of a handle
+    StatusConsumerMask consumers_of(Handle handle) const {
+        return consumers_[handle];
+    }
+
+    /**
+     * @brief Consumers for a status key
+     *
+     * O(1) for subscribed objects; falls back to classify() for anything else
+     * (webhooks, objects injected by mocks).
+     */
+    StatusConsumerMask route(const std::string& object_name) const;
+
+    /// Number of objects in the table
+    size_t size() const {
+        return names_.size();
+    }
+
+    /**
+     * @brief Which consumers read a Klipper object
+     *
+     * Mirrors the keys each component's update_from_status() looks up.
+     * Unrecognized names return ALL_STATUS_CONSUMERS.
+     */
+    static StatusConsumerMask classify(const std::string& object_name);
+
+    /**
+     * @brief Consumers for the typed section of a StatusFrame
+     * @param objects StatusFrame::objects bitmask
+     */
+    static StatusConsumerMask classify_typed(uint16_t objects);
+
+  private:
+    std::unordered_map<std::string, Handle> handles_;
+    std::vector<std::string> names_;
+    std::vector<StatusConsumerMask> consumers_;
+};
+
+} // namespace helix
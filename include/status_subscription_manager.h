@@ -0,0 +1,102 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file status_subscription_manager.h
+ * @brief Field-level printer.objects.subscribe management
+ *
+ * Discovery used to subscribe every object with `null` (all fields), so Klipper
+ * streamed fields nothing reads - toolhead max_velocity/print_time, extruder
+ * pressure_advance/power, motion_report, system_stats - in every frame.
+ *
+ * StatusSubscriptionManager builds the subscription from two sources:
+ * - A static base field list per object, covering what the always-on state
+ *   components (PrinterState, ToolState, MoonrakerClient) read. Objects with no
+ *   base rule keep the old all-fields subscription.
+ * - Per-owner field maps registered while a panel or overlay is visible
+ *   (IPanelLifecycle::status_fields(), applied by NavigationManager).
+ *
+ * When an owner change alters the union, the full subscription is re-sent
+ * (Moonraker replaces the set on every printer.objects.subscribe) and the
+ * returned status is dispatched so newly added fields start from fresh values.
+ *
+ * @see MoonrakerDiscoverySequence::complete_discovery_subscription
+ */
+
+#pragma once
+
+#include "json_fwd.h"
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace helix {
+
+class MoonrakerClient;
+
+/// Klipper object name -> fields to subscribe (an empty list means every field)
+using StatusFieldMap = std::map<std::string, std::vector<std::string>>;
+
+/**
+ * @brief Owns the field selection for the Moonraker status subscription
+ *
+ * Thread-safe: discovery runs on the WebSocket thread, owner updates on the
+ * main thread.
+ */
+class StatusSubscriptionManager {
+  public:
+    explicit StatusSubscriptionManager(MoonrakerClient& client);
+
+    StatusSubscriptionManager(const StatusSubscriptionManager&) = delete;
+    StatusSubscriptionManager& operator=(const StatusSubscriptionManager&) = delete;
+
+    /**
+     * @brief Start a new subscription for a discovered object list
+     *
+     * Called by discovery, which sends the request itself.
+     *
+     * @param objects Every object discovery wants status for
+     * @return The "objects" parameter for printer.objects.subscribe
+     */
+    json begin_subscription(const std::vector<std::string>& objects);
+
+    /**
+     * @brief Register (or replace) the extra fields an owner needs
+     *
+     * Objects outside the discovered list are ignored. Re-subscribes if the
+     * union of fields changes.
+     *
+     * @param owner Opaque owner key (a panel or overlay instance)
+     * @param fields Fields beyond the base set
+     */
+    void set_owner_fields(const void* owner, StatusFieldMap fields);
+
+    /// Drop an owner's fields, re-subscribing if the union shrinks (no-op if unknown)
+    void clear_owner(const void* owner);
+
+    /// The "objects" parameter for the current discovered list and owners
+    json build_objects() const;
+
+    /**
+     * @brief Fields the always-on state components read from an object
+     * @return std::nullopt for every field, an empty list for none (unsubscribed)
+     */
+    static std::optional<std::vector<std::string>> base_fields(const std::string& object_name);
+
+  private:
+    json build_objects_locked() const;
+
+    /// Re-send the subscription if the field union changed since the last request
+    void update_subscription();
+
+    MoonrakerClient& client_;
+    mutable std::mutex mutex_;
+    std::vector<std::string> discovered_;
+    std::map<const void*, StatusFieldMap> owners_;
+    json subscribed_; ///< Last "objects" sent (null until discovery subscribes)
+};
+
+} // namespace helix
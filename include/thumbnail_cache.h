@@ -178,13 +178,16 @@ class ThumbnailCache {
      * @param source_modified Optional source file modification time (Unix timestamp).
      *        If provided and the cached file is older than this, the cache is
      *        invalidated and a fresh download is triggered. Use 0 to skip validation.
+     * @param cancel_key Optional tag for MoonrakerFileTransferAPI::cancel_thumbnail();
+     *        a cancelled download reports through @p on_error
      *
      * @note Falls back to PNG on pre-scaling failure - display still works, just slower
      * @see docs/THUMBNAIL_OPTIMIZATION_PLAN.md
      */
     void fetch_optimized(MoonrakerAPI* api, const std::string& relative_path,
                          const helix::ThumbnailTarget& target, SuccessCallback on_success,
-                         ErrorCallback on_error, time_t source_modified = 0);
+                         ErrorCallback on_error, time_t source_modified = 0,
+                         const std::string& cancel_key = {});
 
     /**
      * @brief Check if a pre-scaled version exists in cache
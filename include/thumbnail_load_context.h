@@ -6,6 +6,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 /**
  * @file thumbnail_load_context.h
@@ -50,6 +51,10 @@ struct ThumbnailLoadContext {
     /// The generation value captured at creation time
     uint32_t captured_gen;
 
+    /// Tag for MoonrakerFileTransferAPI::cancel_thumbnail() (empty = not cancellable).
+    /// Prefix it with the requester, e.g. "print_select:" + path.
+    std::string cancel_key;
+
     /**
      * @brief Check if this context is still valid
      *
@@ -133,6 +133,17 @@ void ui_bed_mesh_set_render_mode(lv_obj_t* canvas, helix::BedMeshRenderMode mode
  */
 void ui_bed_mesh_set_zero_plane_visible(lv_obj_t* canvas, bool visible);
 
+/**
+ * @brief Set the 3D surface upsampling factor
+ *
+ * The probe grid is resampled with bicubic interpolation into factor x factor
+ * sub-cells per probe cell when the mesh is loaded. Clamped to 1..8.
+ *
+ * @param canvas The bed_mesh canvas widget
+ * @param factor Sub-cells per probe cell along each axis
+ */
+void ui_bed_mesh_set_upsample_factor(lv_obj_t* canvas, int factor);
+
 /**
  * @brief Set Z display offset for axis labels and tooltips
  *
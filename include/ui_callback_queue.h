@@ -0,0 +1,476 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+/**
+ * @file ui_callback_queue.h
+ * @brief Lock-free multi-producer / single-consumer callback queue
+ *
+ * Storage behind helix::ui::UpdateQueue, kept free of LVGL so it can be tested
+ * and benchmarked on its own.
+ *
+ * - SmallCallback: move-only `void()` callable with inline storage. Captures up
+ *   to SmallCallback::INLINE_SIZE bytes (a `this` pointer plus a string, a
+ *   shared_ptr or a std::function) are stored without a heap allocation.
+ * - CallbackQueue: bounded ring of SmallCallback slots (Vyukov-style per-slot
+ *   sequence numbers). Producers claim a slot with one CAS and nothing locks
+ *   while the ring has room. When it is full, callbacks spill into a mutex-protected
+ *   overflow list. While the overflow is in use, every producer appends to it,
+ *   which keeps each producer's callbacks in submission order.
+ *
+ * @threading push() from any thread, pop_batch() from one consumer thread only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace helix::ui {
+
+/**
+ * @brief Move-only `void()` callable with small-buffer storage
+ *
+ * Callables that fit INLINE_SIZE and are nothrow-movable live inline; larger
+ * ones fall back to a single heap allocation.
+ */
+class SmallCallback {
+  public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    SmallCallback() = default;
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, SmallCallback> &&
+                                          std::is_invocable_v<Fn&>>>
+    SmallCallback(F&& fn) { // NOLINT(google-explicit-constructor)
+        assign(std::forward<F>(fn));
+    }
+
+    SmallCallback(SmallCallback&& other) noexcept {
+        move_from(other);
+    }
+
+    SmallCallback& operator=(SmallCallback&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    SmallCallback(const SmallCallback&) = delete;
+    SmallCallback& operator=(const SmallCallback&) = delete;
+
+    ~SmallCallback() {
+        reset();
+    }
+
+    explicit operator bool() const {
+        return ops_ != nullptr;
+    }
+
+    /// True if the callable is stored inline (no heap allocation)
+    bool is_inline() const {
+        return ops_ != nullptr && ops_->is_inline;
+    }
+
+    void operator()() {
+        ops_->invoke(storage_);
+    }
+
+    void reset() {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief Replace the stored callable, constructing it in place
+     *
+     * If constructing @p fn throws, the callback is left empty.
+     */
+    template <typename F> void assign(F&& fn) {
+        using Fn = std::decay_t<F>;
+        reset();
+        if constexpr (std::is_same_v<Fn, SmallCallback>) {
+            move_from(fn);
+        } else if constexpr (fits_inline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(fn));
+            ops_ = &inline_ops<Fn>;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(fn));
+            ops_ = &heap_ops<Fn>;
+        }
+    }
+
+  private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* dst, void* src) noexcept; ///< Move-construct dst, destroy src
+        void (*destroy)(void* storage) noexcept;
+        bool is_inline;
+    };
+
+    template <typename Fn> static constexpr bool fits_inline() {
+        return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static constexpr Ops inline_ops = {
+        [](void* s) { (*static_cast<Fn*>(s))(); },
+        [](void* dst, void* src) noexcept {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        },
+        [](void* s) noexcept { static_cast<Fn*>(s)->~Fn(); },
+        true,
+    };
+
+    template <typename Fn>
+    static constexpr Ops heap_ops = {
+        [](void* s) { (**static_cast<Fn**>(s))(); },
+        [](void* dst, void* src) noexcept {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+        },
+        [](void* s) noexcept { delete *static_cast<Fn**>(s); },
+        false,
+    };
+
+    void move_from(SmallCallback& other) noexcept {
+        if (other.ops_) {
+            other.ops_->relocate(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_ = nullptr;
+};
+
+/// Counters reported by CallbackQueue::take_stats()
+struct CallbackQueueStats {
+    uint64_t enqueued = 0;         ///< Callbacks accepted
+    uint64_t executed = 0;         ///< Callbacks popped for execution
+    uint64_t overflowed = 0;       ///< Callbacks that spilled into overflow storage
+    uint64_t dropped = 0;          ///< Callbacks discarded (queue shut down)
+    size_t depth = 0;              ///< Callbacks pending at the time of the call
+    size_t max_depth = 0;          ///< Highest pending count seen by a producer
+    uint64_t latency_samples = 0;  ///< Callbacks timed (every 16th push)
+    uint64_t latency_total_ns = 0; ///< Sum of sampled enqueue-to-pop latency
+    uint64_t latency_max_ns = 0;   ///< Worst sampled enqueue-to-pop latency
+
+    static constexpr size_t LATENCY_BUCKETS = 24;
+    /// Sampled latencies by power of two: bucket i counts latencies below 2^i us
+    std::array<uint64_t, LATENCY_BUCKETS> latency_buckets{};
+
+    /// Mean sampled enqueue-to-pop latency in microseconds
+    double latency_avg_us() const {
+        return latency_samples > 0
+                   ? static_cast<double>(latency_total_ns) / latency_samples / 1000.0
+                   : 0.0;
+    }
+
+    /// Bucket for a latency: the number of significant bits in its microseconds
+    static size_t latency_bucket(uint64_t latency_ns) {
+        uint64_t us = latency_ns / 1000;
+        size_t bucket = 0;
+        while (bucket < LATENCY_BUCKETS - 1 && (us >> bucket) != 0) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    /// Upper bound in us of the bucket holding the given percentile (0-100)
+    uint64_t latency_percentile_us(double percentile) const {
+        if (latency_samples == 0) {
+            return 0;
+        }
+        double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+        auto target =
+            std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(latency_samples * fraction)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < LATENCY_BUCKETS - 1; ++i) {
+            seen += latency_buckets[i];
+            if (seen >= target && latency_buckets[i] > 0) {
+                return uint64_t{1} << i;
+            }
+        }
+        return (latency_max_ns + 999) / 1000;
+    }
+};
+
+/**
+ * @brief Bounded lock-free MPSC ring with overflow
+ *
+ * @tparam Capacity Ring slots (power of two)
+ */
+template <size_t Capacity> class CallbackQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "CallbackQueue capacity must be a power of two");
+
+  public:
+    CallbackQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    CallbackQueue(const CallbackQueue&) = delete;
+    CallbackQueue& operator=(const CallbackQueue&) = delete;
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+    /**
+     * @brief Enqueue a callback (any thread)
+     *
+     * The callable is constructed directly in its ring slot. If that throws,
+     * the slot is published empty (and skipped) before the exception propagates.
+     *
+     * @param callback Any `void()` callable or a SmallCallback
+     * @return false if the callback went to overflow storage instead of the ring
+     */
+    template <typename F> bool push(F&& callback) {
+        if (!overflow_active_.load(std::memory_order_acquire)) {
+            Slot* slot = claim_slot();
+            if (slot) {
+                publish(slot, std::forward<F>(callback));
+                return true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        overflow_active_.store(true, std::memory_order_release);
+        OverflowEntry& entry = overflow_.emplace_back();
+        try {
+            entry.callback.assign(std::forward<F>(callback));
+        } catch (...) {
+            overflow_.pop_back();
+            throw;
+        }
+        if ((overflow_.size() & (LATENCY_SAMPLE_INTERVAL - 1)) == 1) {
+            entry.enqueued_ns = now_ns();
+        }
+        overflowed_.fetch_add(1, std::memory_order_relaxed);
+        note_depth(ring_depth() + overflow_.size());
+        return false;
+    }
+
+    /**
+     * @brief Pop the callbacks that were pending when the call started (consumer only)
+     *
+     * Callbacks enqueued by @p fn itself are left for the next batch, so a
+     * callback that re-queues itself cannot spin the consumer. The overflow
+     * list is only taken once the ring is empty, so it never runs ahead of
+     * older ring entries.
+     *
+     * @param fn Invoked with each non-empty SmallCallback& in order (must not throw)
+     * @return Number of callbacks popped
+     */
+    template <typename Fn> size_t pop_batch(Fn&& fn) {
+        size_t popped = drain(std::forward<Fn>(fn));
+        executed_.fetch_add(popped, std::memory_order_relaxed);
+        return popped;
+    }
+
+    /// Discard everything pending, counting it as dropped (consumer only)
+    size_t discard() {
+        size_t discarded = drain([](SmallCallback&) {});
+        dropped_.fetch_add(discarded, std::memory_order_relaxed);
+        return discarded;
+    }
+
+    /// Count a callback rejected before reaching the queue
+    void note_dropped() {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// True if anything is pending (any thread, approximate under contention)
+    bool has_pending() const {
+        return ring_depth() != 0 || overflow_active_.load(std::memory_order_acquire);
+    }
+
+    /// Snapshot the counters and reset everything except depth (consumer only)
+    CallbackQueueStats take_stats() {
+        CallbackQueueStats stats;
+        stats.executed = executed_.exchange(0, std::memory_order_relaxed);
+        stats.overflowed = overflowed_.exchange(0, std::memory_order_relaxed);
+        stats.dropped = dropped_.exchange(0, std::memory_order_relaxed);
+        stats.max_depth = max_depth_.exchange(0, std::memory_order_relaxed);
+        stats.latency_samples = latency_samples_.exchange(0, std::memory_order_relaxed);
+        stats.latency_total_ns = latency_total_ns_.exchange(0, std::memory_order_relaxed);
+        stats.latency_max_ns = latency_max_ns_.exchange(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < CallbackQueueStats::LATENCY_BUCKETS; ++i) {
+            stats.latency_buckets[i] = latency_buckets_[i].exchange(0, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(overflow_mutex_);
+            stats.depth = ring_depth() + overflow_.size();
+        }
+        // Ring pushes are counted by the claim index itself, keeping producers off a shared counter
+        size_t pos = enqueue_pos_.load(std::memory_order_acquire);
+        stats.enqueued = (pos - stats_enqueue_pos_) + stats.overflowed;
+        stats_enqueue_pos_ = pos;
+        return stats;
+    }
+
+  private:
+    static constexpr size_t MASK = Capacity - 1;
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t LATENCY_SAMPLE_INTERVAL = 16; ///< Every Nth ring push (power of two)
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        uint64_t enqueued_ns = 0;
+        SmallCallback callback;
+    };
+
+    struct OverflowEntry {
+        SmallCallback callback;
+        uint64_t enqueued_ns = 0;
+    };
+
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /// pop_batch() without touching the executed counter
+    template <typename Fn> size_t drain(Fn&& fn) {
+        size_t popped = 0;
+        const size_t end = enqueue_pos_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_relaxed);
+
+        while (head != end) {
+            Slot& slot = slots_[head & MASK];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+                break; // Claimed but not yet published; the producer will wake us again
+            }
+            record_latency(slot.enqueued_ns);
+            if (slot.callback) {
+                ++popped;
+                fn(slot.callback);
+                slot.callback.reset();
+            }
+            slot.sequence.store(head + Capacity, std::memory_order_release);
+            head_.store(++head, std::memory_order_release);
+        }
+
+        if (overflow_active_.load(std::memory_order_acquire)) {
+            std::deque<OverflowEntry> overflow;
+            {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                if (head_.load(std::memory_order_relaxed) ==
+                    enqueue_pos_.load(std::memory_order_acquire)) {
+                    overflow.swap(overflow_);
+                    overflow_active_.store(false, std::memory_order_release);
+                }
+            }
+            for (auto& entry : overflow) {
+                record_latency(entry.enqueued_ns);
+                ++popped;
+                fn(entry.callback);
+            }
+        }
+
+        return popped;
+    }
+
+    /// Claim the next ring slot, nullptr if the ring is full
+    Slot* claim_slot() {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot* slot = &slots_[pos & MASK];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Construct the callback in a claimed slot and hand it to the consumer
+    template <typename F> void publish(Slot* slot, F&& callback) {
+        // The claimed position is the slot's current sequence number
+        size_t pos = slot->sequence.load(std::memory_order_relaxed);
+        try {
+            slot->callback.assign(std::forward<F>(callback));
+        } catch (...) {
+            slot->enqueued_ns = 0;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            throw;
+        }
+        // Reading the clock costs as much as the push itself, so latency is sampled
+        slot->enqueued_ns = (pos & (LATENCY_SAMPLE_INTERVAL - 1)) == 0 ? now_ns() : 0;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        note_depth(pos + 1 - head_.load(std::memory_order_relaxed));
+    }
+
+    size_t ring_depth() const {
+        return enqueue_pos_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+
+    void note_depth(size_t depth) {
+        size_t seen = max_depth_.load(std::memory_order_relaxed);
+        while (depth > seen &&
+               !max_depth_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    void record_latency(uint64_t enqueued_ns) {
+        if (enqueued_ns == 0) {
+            return; // Not sampled
+        }
+        uint64_t latency = now_ns() - enqueued_ns;
+        latency_samples_.fetch_add(1, std::memory_order_relaxed);
+        latency_total_ns_.fetch_add(latency, std::memory_order_relaxed);
+        latency_buckets_[CallbackQueueStats::latency_bucket(latency)].fetch_add(
+            1, std::memory_order_relaxed);
+        // The consumer is the only writer, so no CAS loop is needed
+        if (latency > latency_max_ns_.load(std::memory_order_relaxed)) {
+            latency_max_ns_.store(latency, std::memory_order_relaxed);
+        }
+    }
+
+    alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+    alignas(CACHE_LINE) std::atomic<bool> overflow_active_{false};
+    std::unique_ptr<Slot[]> slots_ = std::make_unique<Slot[]>(Capacity);
+
+    mutable std::mutex overflow_mutex_;
+    std::deque<OverflowEntry> overflow_;
+
+    size_t stats_enqueue_pos_ = 0; ///< enqueue_pos_ at the previous take_stats()
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> overflowed_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<size_t> max_depth_{0};
+    std::atomic<uint64_t> latency_samples_{0};
+    std::atomic<uint64_t> latency_total_ns_{0};
+    std::atomic<uint64_t> latency_max_ns_{0};
+    std::array<std::atomic<uint64_t>, CallbackQueueStats::LATENCY_BUCKETS> latency_buckets_{};
+};
+
+} // namespace helix::ui
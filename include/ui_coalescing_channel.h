@@ -0,0 +1,154 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+/**
+ * @file ui_coalescing_channel.h
+ * @brief Keyed "latest value wins" channel on top of the UI update queue
+ *
+ * High-rate producers (status frames, AMS backend events, print media updates)
+ * used to queue one callback per event. When the main thread stalls - a panel
+ * switch, a long XML build - every stale callback still ran once it resumed.
+ *
+ * A CoalescingChannel keeps at most one pending callback per key. Posting under
+ * a key that already has a pending callback replaces it, so the next drain runs
+ * only the newest one: one catch-up update instead of a backlog.
+ *
+ * Ordering: a key's callback runs at the queue position of the *first* post
+ * since its last run. A newer post under the same key can therefore overtake
+ * plain queue_update() calls made between the two posts. Use a key only for
+ * callbacks that publish current state, and route every writer of that state
+ * through the same key.
+ *
+ * Kept free of LVGL so it can be tested on its own; UpdateQueue owns the
+ * instance behind helix::ui::queue_latest().
+ *
+ * @threading post() from any thread; scheduled callbacks run on the consumer thread
+ */
+
+#pragma once
+
+#include "ui_callback_queue.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace helix::ui {
+
+class CoalescingChannel {
+  public:
+    /// Hands a drain callback to the underlying queue
+    using Scheduler = std::function<void(SmallCallback)>;
+
+    explicit CoalescingChannel(Scheduler schedule) : schedule_(std::move(schedule)) {}
+
+    CoalescingChannel(const CoalescingChannel&) = delete;
+    CoalescingChannel& operator=(const CoalescingChannel&) = delete;
+
+    /**
+     * @brief Post the newest callback for @p key (any thread)
+     *
+     * Replaces a callback still pending under the same key. The scheduler is only
+     * invoked for the first post since the key last ran.
+     *
+     * @param key Stable identifier, e.g. "status" or "ams:sync:0" (keys are never freed)
+     * @param callback Any `void()` callable
+     */
+    template <typename F> void post(std::string_view key, F&& callback) {
+        SmallCallback incoming(std::forward<F>(callback));
+        SmallCallback superseded; // Destroyed outside the lock
+        Slot* slot = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot = find_or_create(key);
+            superseded = std::move(slot->pending);
+            slot->pending = std::move(incoming);
+            if (superseded) {
+                coalesced_++;
+            }
+            if (slot->scheduled) {
+                return;
+            }
+            slot->scheduled = true;
+        }
+        schedule_([this, slot]() { run(*slot); });
+    }
+
+    /**
+     * @brief Drop every pending callback (e.g. on shutdown)
+     *
+     * Drain callbacks already handed to the scheduler find nothing to run.
+     *
+     * @return Number of callbacks dropped
+     */
+    size_t discard() {
+        size_t dropped = 0;
+        std::vector<SmallCallback> doomed; // Destroyed outside the lock
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [key, slot] : slots_) {
+                if (slot->pending) {
+                    doomed.push_back(std::move(slot->pending));
+                    dropped++;
+                }
+                slot->scheduled = false;
+            }
+        }
+        return dropped;
+    }
+
+    /// Posts since the previous call that replaced a still-pending callback
+    uint64_t take_coalesced() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::exchange(coalesced_, 0);
+    }
+
+    /// True if any key has a callback waiting to run
+    bool has_pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, slot] : slots_) {
+            if (slot->pending) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    struct Slot {
+        SmallCallback pending;
+        bool scheduled = false; ///< A drain callback for this key is queued
+    };
+
+    Slot* find_or_create(std::string_view key) {
+        auto it = slots_.find(key);
+        if (it == slots_.end()) {
+            it = slots_.emplace(std::string(key), std::make_unique<Slot>()).first;
+        }
+        return it->second.get();
+    }
+
+    void run(Slot& slot) {
+        SmallCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callback = std::move(slot.pending);
+            slot.scheduled = false; // Posts from here on schedule a new drain
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    Scheduler schedule_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Slot>, std::less<>> slots_;
+    uint64_t coalesced_ = 0;
+};
+
+} // namespace helix::ui
@@ -455,6 +455,17 @@ int ui_gcode_viewer_get_current_layer_end(lv_obj_t* obj);
  */
 void ui_gcode_viewer_set_print_progress(lv_obj_t* obj, int current_layer);
 
+/**
+ * @brief Set how far the printer has read into the G-code file
+ * @param obj Viewer widget
+ * @param file_position Byte offset (Moonraker virtual_sdcard.file_position)
+ *
+ * In print progress mode the 2D view draws the current layer only up to this
+ * point, adding just the newly printed segments on each update. Ignored in
+ * preview mode and by the 3D renderer.
+ */
+void ui_gcode_viewer_set_print_file_position(lv_obj_t* obj, uint64_t file_position);
+
 /**
  * @brief Set ghost layer opacity
  * @param obj Viewer widget
@@ -112,6 +112,11 @@ class ControlsPanel : public PanelBase {
      */
     void on_activate() override;
 
+    /// Position readout (gcode_position) is only streamed while the panel is visible
+    helix::StatusFieldMap status_fields() const override {
+        return {{"gcode_move", {"gcode_position"}}};
+    }
+
   private:
     //
     // === Dependencies ===
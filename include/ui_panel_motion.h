@@ -51,6 +51,11 @@ class MotionPanel : public OverlayBase {
     void on_activate() override;
     void on_deactivate() override;
 
+    /// Live and commanded position are only streamed while the panel is open
+    helix::StatusFieldMap status_fields() const override {
+        return {{"toolhead", {"position"}}, {"gcode_move", {"gcode_position"}}};
+    }
+
     // === Public API ===
     lv_obj_t* get_panel() const {
         return overlay_root_;
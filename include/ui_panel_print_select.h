@@ -26,6 +26,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -208,12 +209,21 @@ class PrintSelectPanel : public PanelBase {
      *
      * Only fetches metadata for files that haven't been fetched yet.
      * Called initially for visible items, then on scroll for newly visible items.
+     * Cancels card thumbnail downloads that fell outside the range first.
      *
      * @param start Start index (inclusive)
      * @param end End index (exclusive)
      */
     void fetch_metadata_range(size_t start, size_t end);
 
+    /**
+     * @brief Cancel queued card thumbnail downloads outside [start, end)
+     *
+     * Cancelled files are marked for a metadata refetch, so their thumbnail
+     * is requested again when they scroll back into view.
+     */
+    void cancel_offscreen_thumbnails(size_t start, size_t end);
+
     /**
      * @brief Process metadata result and update file list
      *
@@ -516,6 +526,13 @@ class PrintSelectPanel : public PanelBase {
     /// if the generation has changed (user navigated away).
     std::atomic<uint32_t> nav_generation_{0};
 
+    /// Card thumbnail downloads in flight, by file index (main thread only)
+    struct PendingThumbnail {
+        std::string filename;
+        std::string cancel_key; ///< "print_select:" + thumbnail path
+    };
+    std::unordered_map<size_t, PendingThumbnail> pending_card_thumbnails_;
+
     // File list change notification handler name (for unregistering)
     std::string filelist_handler_name_;
 
@@ -449,6 +449,7 @@ class PrintStatusPanel : public OverlayBase {
     void on_gcode_z_offset_changed(int microns);
     void on_led_state_changed(int state);
     void on_print_layer_changed(int current_layer);
+    void on_print_file_position_changed(uint64_t file_position);
     void on_print_duration_changed(int seconds);
     void on_print_time_left_changed(int seconds);
     void on_print_start_phase_changed(int phase);
@@ -468,6 +469,7 @@ class PrintStatusPanel : public OverlayBase {
     ObserverGuard gcode_z_offset_observer_;
     ObserverGuard led_state_observer_;
     ObserverGuard print_layer_observer_;
+    ObserverGuard print_file_position_observer_;
     ObserverGuard print_duration_observer_;
     ObserverGuard print_time_left_observer_;
     ObserverGuard print_start_phase_observer_;
@@ -11,8 +11,10 @@
  *
  * Architecture:
  * 1. Any thread can queue updates via helix::ui::queue_update()
- * 2. Updates accumulate in a thread-safe queue
- * 3. At the start of each frame (via LVGL timer), all pending updates are processed
+ * 2. Updates go into a lock-free MPSC ring (see ui_callback_queue.h); the first
+ *    update after a drain signals an eventfd that the main loop sleeps on
+ * 3. The main loop wakes, marks the drain timer ready, and lv_timer_handler()
+ *    processes all pending updates
  * 4. Rendering happens AFTER all updates are applied
  *
  * This is similar to React's batched state updates - changes are queued and
@@ -21,52 +23,71 @@
  * Usage:
  * @code
  * // From any thread (WebSocket callback, async operation, etc.):
- * helix::ui::queue_update([](void*) {
+ * helix::ui::queue_update([]() {
  *     lv_subject_set_int(&my_subject, new_value);
  *     lv_label_set_text(label, "Updated!");
  * });
  *
- * // With captured data:
- * auto* data = new MyData{value, text};
- * helix::ui::queue_update([](void* user_data) {
- *     auto* d = static_cast<MyData*>(user_data);
- *     lv_subject_set_int(&my_subject, d->value);
- *     delete d;
- * }, data);
+ * // With captured data (small captures are stored without allocating):
+ * helix::ui::queue_update([value, text = std::move(text)]() {
+ *     lv_subject_set_int(&my_subject, value);
+ * });
+ *
+ * // High-rate state: only the newest update per key runs on the next drain
+ * helix::ui::queue_latest("ams:sync:0", []() { AmsState::instance().sync_backend(0); });
  * @endcode
  */
 
 #pragma once
 
 #include "lvgl/lvgl.h"
+#include "ui_callback_queue.h"
+#include "ui_coalescing_channel.h"
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <string_view>
+#include <type_traits>
 
 namespace helix::ui {
 
 /**
  * @brief Callback type for queued updates
+ *
+ * Kept for callers that store callbacks; queue_update() accepts any `void()`
+ * callable directly and avoids the std::function allocation.
  */
 using UpdateCallback = std::function<void()>;
 
+/// Enqueue/execution counters for the UI update queue
+struct UpdateQueueStats : CallbackQueueStats {
+    uint64_t coalesced = 0; ///< queue_latest() updates replaced before they ran
+};
+
 /**
  * @brief Thread-safe UI update queue
  *
  * Singleton that manages pending UI updates. Call init() once at startup
- * to install a high-priority timer that processes updates every lv_timer_handler() cycle.
+ * to install the high-priority timer that processes updates.
  *
  * Key insight: Using LV_EVENT_REFR_START doesn't work because it only fires when
  * LVGL decides to render. If nothing invalidates the display, the queue never drains.
- * Instead, we use a highest-priority timer that fires every lv_timer_handler() call,
- * ensuring callbacks execute promptly regardless of render state.
+ * Instead, a highest-priority timer drains the queue. The main loop calls
+ * wait_for_work() instead of sleeping; it returns as soon as a producer signals
+ * and marks the timer ready, so the timer only needs a slow backstop period and
+ * the loop no longer wakes every millisecond while idle.
  */
 class UpdateQueue {
   public:
+    /// Ring slots before updates spill into overflow storage
+    static constexpr size_t RING_CAPACITY = 1024;
+
+    /// Drain timer period when nobody calls wait_for_work() (nested event loops)
+    static constexpr uint32_t BACKSTOP_PERIOD_MS = LV_DEF_REFR_PERIOD;
+
     /**
      * @brief Get singleton instance
      */
@@ -79,43 +100,75 @@ class UpdateQueue {
      * @brief Initialize the update queue (call once at startup)
      *
      * Creates a highest-priority timer that processes pending updates
-     * every lv_timer_handler() cycle, BEFORE the render timer runs.
+     * BEFORE the render timer runs. Callbacks that slipped in after a previous
+     * shutdown() are discarded.
      */
-    void init() {
-        if (initialized_)
-            return;
-
-        shut_down_ = false;
-
-        // Create a timer that fires every lv_timer_handler() cycle
-        // Period of 1ms ensures it runs frequently (LVGL processes all ready timers)
-        // Created early at init, so it's near the head of the timer list
-        timer_ = lv_timer_create(timer_cb, 1, this);
-        if (!timer_) {
-            spdlog::error("[UpdateQueue] Failed to create timer!");
-            return;
-        }
-
-        initialized_ = true;
-        spdlog::debug("[UpdateQueue] Initialized - timer created for queue drain");
-    }
+    void init();
 
     /**
      * @brief Queue an update for processing
      *
-     * Thread-safe. Can be called from any thread.
+     * Thread-safe and lock-free while the ring has room. Can be called from any thread.
      * The callback will be executed on the main LVGL thread before rendering.
      *
-     * @param callback Function to execute
+     * @param callback Any `void()` callable
      */
-    void queue(UpdateCallback callback) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (shut_down_) {
+    template <typename F, typename = std::enable_if_t<std::is_invocable_v<std::decay_t<F>&>>>
+    void queue(F&& callback) {
+        if (shut_down_.load(std::memory_order_acquire)) {
             // Silently discard — queue is shut down, panels may be destroyed.
             // Call init() to re-enable (e.g. when test fixtures re-initialize).
+            pending_.note_dropped();
+            return;
+        }
+        pending_.push(std::forward<F>(callback));
+        wake();
+    }
+
+    /**
+     * @brief Queue an update that supersedes any pending update with the same key
+     *
+     * Thread-safe. Only the newest callback posted under @p key runs, at the queue
+     * position of the first post since the key last ran. See ui_coalescing_channel.h
+     * for the ordering rules.
+     *
+     * @param key Stable key naming the state being published (e.g. "status")
+     * @param callback Any `void()` callable
+     */
+    template <typename F, typename = std::enable_if_t<std::is_invocable_v<std::decay_t<F>&>>>
+    void queue_latest(std::string_view key, F&& callback) {
+        if (shut_down_.load(std::memory_order_acquire)) {
+            pending_.note_dropped();
             return;
         }
-        pending_.push(std::move(callback));
+        latest_.post(key, std::forward<F>(callback));
+    }
+
+    /**
+     * @brief Wake the main loop from wait_for_work()
+     *
+     * Thread-safe. Called by queue(); other producers of main-loop work (e.g.
+     * MoonrakerManager's notification queue) call it directly. Only the first
+     * wake after the loop resumes costs a syscall.
+     */
+    void wake();
+
+    /**
+     * @brief Sleep until an update is queued, wake() is called, or the timeout expires
+     *
+     * Replaces the fixed delay in the main loop. If updates are pending on return,
+     * the drain timer is made ready so the next lv_timer_handler() runs it first.
+     *
+     * @param timeout_ms Maximum time to sleep (typically lv_timer_handler()'s return)
+     * @note Must be called from the main LVGL thread.
+     */
+    void wait_for_work(uint32_t timeout_ms);
+
+    /**
+     * @brief Counters since the previous call (depth is the current pending count)
+     */
+    UpdateQueueStats take_stats() {
+        return UpdateQueueStats{pending_.take_stats(), latest_.take_coalesced()};
     }
 
     /**
@@ -130,12 +183,10 @@ class UpdateQueue {
         // new enqueues so background threads (libhv WebSocket) that arrive late
         // silently discard instead of pushing stale panel pointers.
         process_pending();
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            initialized_ = false;
-            shut_down_ = true;
-            std::queue<UpdateCallback>().swap(pending_); // Discard any stragglers
-        }
+        initialized_ = false;
+        shut_down_.store(true, std::memory_order_release);
+        pending_.discard(); // Discard any stragglers
+        latest_.discard();
         timer_ = nullptr;
     }
 
@@ -181,10 +232,8 @@ class UpdateQueue {
 
   private:
     friend class UpdateQueueTestAccess;
-    UpdateQueue() = default;
-    ~UpdateQueue() {
-        shutdown();
-    }
+    UpdateQueue();
+    ~UpdateQueue();
 
     // Non-copyable
     UpdateQueue(const UpdateQueue&) = delete;
@@ -193,8 +242,8 @@ class UpdateQueue {
     /**
      * @brief Timer callback - processes all pending updates
      *
-     * Called by LVGL on every lv_timer_handler() cycle due to highest priority.
-     * Runs BEFORE the render timer, ensuring updates are applied before drawing.
+     * Highest priority, so it runs BEFORE the render timer, ensuring updates
+     * are applied before drawing.
      */
     static void timer_cb(lv_timer_t* timer) {
         auto* self = static_cast<UpdateQueue*>(lv_timer_get_user_data(timer));
@@ -203,33 +252,15 @@ class UpdateQueue {
         }
     }
 
-    void process_pending() {
-        // Move pending updates to local queue to minimize lock time
-        std::queue<UpdateCallback> to_process;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            std::swap(to_process, pending_);
-        }
-
-        // Execute all pending updates - safe because render hasn't started yet
-        while (!to_process.empty()) {
-            try {
-                auto& callback = to_process.front();
-                callback();
-            } catch (const std::exception& e) {
-                spdlog::error("[UpdateQueue] Exception in queued callback: {}", e.what());
-            } catch (...) {
-                spdlog::error("[UpdateQueue] Unknown exception in queued callback");
-            }
-            to_process.pop();
-        }
-    }
+    void process_pending();
 
-    std::mutex mutex_;
-    std::queue<UpdateCallback> pending_;
+    CallbackQueue<RING_CAPACITY> pending_;
+    CoalescingChannel latest_; ///< Keyed updates, drained through pending_
     lv_timer_t* timer_ = nullptr;
     bool initialized_ = false;
-    bool shut_down_ = false;
+    std::atomic<bool> shut_down_{false};
+    std::atomic<bool> wake_pending_{false}; ///< Set by the producer that signalled wake_fd_
+    int wake_fd_ = -1;                      ///< eventfd (Linux), -1 falls back to a short sleep
 };
 
 /**
@@ -239,10 +270,26 @@ class UpdateQueue {
  * Updates are guaranteed to execute BEFORE rendering, avoiding the
  * "Invalidate area is not allowed during rendering" assertion.
  *
- * @param callback Function to execute on the main thread
+ * @param callback Any `void()` callable to execute on the main thread
+ */
+template <typename F, typename = std::enable_if_t<std::is_invocable_v<std::decay_t<F>&>>>
+void queue_update(F&& callback) {
+    UpdateQueue::instance().queue(std::forward<F>(callback));
+}
+
+/**
+ * @brief Queue a UI update where only the newest one per key matters
+ *
+ * For producers that publish current state at a high rate (status frames, AMS
+ * backend events, print progress). If the main thread falls behind, the stale
+ * updates are dropped and one catch-up update runs instead.
+ *
+ * @param key Stable key naming the state being published
+ * @param callback Any `void()` callable to execute on the main thread
  */
-inline void queue_update(UpdateCallback callback) {
-    UpdateQueue::instance().queue(std::move(callback));
+template <typename F, typename = std::enable_if_t<std::is_invocable_v<std::decay_t<F>&>>>
+void queue_latest(std::string_view key, F&& callback) {
+    UpdateQueue::instance().queue_latest(key, std::forward<F>(callback));
 }
 
 /**
@@ -301,6 +301,18 @@ test-timing: test-build
 	$(ECHO) "$(CYAN)$(BOLD)Slowest tests (top 20):$(RESET)"
 	@$(TEST_BIN) "~[.]" --durations yes 2>&1 | grep -E "^[0-9]+\.[0-9]+ s:" | sort -rn | head -20
 
+# Replay Moonraker traffic through the client, PrinterState and LVGL (hidden [.benchmark] test)
+# Synthetic stream by default; HELIX_REPLAY_LOG=<frame log> replays a HELIX_RECORD_FRAMES capture.
+# HELIX_REPLAY_SPEED=1|10|... paces it against the recording (default 0 = as fast as possible)
+bench-replay: test-build
+	$(ECHO) "$(CYAN)$(BOLD)Running Moonraker replay benchmark...$(RESET)"
+	$(Q)$(TEST_BIN) "[.benchmark][replay]"
+
+# G-code parser throughput over assets/test_gcodes, in MB/s (hidden [.benchmark] test)
+bench-gcode: test-build
+	$(ECHO) "$(CYAN)$(BOLD)Running G-code parser benchmark...$(RESET)"
+	$(Q)$(TEST_BIN) "[.benchmark][gcode]"
+
 # Run only fast tests in PARALLEL (skip hidden and slow tests) - for quick iteration
 # Target: <15s total runtime for rapid development feedback with parallelism
 test-fast: test-build
@@ -857,6 +869,8 @@ help-test:
 	echo "  $${G}test-list$${X}            - List all test cases"; \
 	echo "  $${G}test-list-tags$${X}       - List available test tags"; \
 	echo "  $${G}test-timing$${X}          - Show slowest tests (top 20)"; \
+	echo "  $${G}bench-replay$${X}         - Moonraker record/replay throughput benchmark"; \
+	echo "  $${G}bench-gcode$${X}          - G-code parser throughput benchmark"; \
 	echo "  $${G}test-summary$${X}         - Test coverage by tag"; \
 	echo ""; \
 	echo "$${C}Sanitizers (Memory/Thread Safety):$${X}"; \
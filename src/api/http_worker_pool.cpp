@@ -0,0 +1,342 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "http_worker_pool.h"
+
+#include "hv/HttpClient.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+
+namespace helix {
+
+namespace {
+
+constexpr auto kShutdownTimeout = std::chrono::milliseconds(2000);
+constexpr auto kJoinPollInterval = std::chrono::milliseconds(10);
+
+uint64_t elapsed_us(std::chrono::steady_clock::time_point from,
+                    std::chrono::steady_clock::time_point to) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+} // namespace
+
+const char* http_priority_name(HttpPriority priority) {
+    switch (priority) {
+    case HttpPriority::VISIBLE:
+        return "visible";
+    case HttpPriority::PREFETCH:
+        return "prefetch";
+    case HttpPriority::BACKGROUND:
+        return "background";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// Context
+// ============================================================================
+
+std::shared_ptr<HttpResponse>
+HttpWorkerPool::Context::send(const std::shared_ptr<HttpRequest>& req) {
+    auto resp = std::make_shared<HttpResponse>();
+    if (client_.send(req.get(), resp.get()) != 0) {
+        return nullptr;
+    }
+    return resp;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+HttpWorkerPool::HttpWorkerPool(size_t workers) : shared_(std::make_shared<Shared>()) {
+    workers = std::max<size_t>(workers, 1);
+    // Keep one worker free for VISIBLE/PREFETCH jobs whenever there is more than one
+    shared_->background_limit = workers > 1 ? workers - 1 : 1;
+
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([shared = shared_]() { worker_loop(shared); });
+    }
+    spdlog::debug("[HttpWorkerPool] Started {} workers ({} for background transfers)", workers,
+                  shared_->background_limit);
+}
+
+HttpWorkerPool::~HttpWorkerPool() {
+    shutdown(kShutdownTimeout);
+}
+
+void HttpWorkerPool::shutdown(std::chrono::milliseconds timeout) {
+    std::array<std::deque<QueuedJob>, HTTP_PRIORITY_COUNT> dropped; // Destroyed outside the lock
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->stopping = true;
+        dropped = std::move(shared_->lanes);
+        shared_->lanes = {};
+        for (auto& running : shared_->running) {
+            running.cancelled->store(true);
+        }
+    }
+    shared_->wake.notify_all();
+
+    if (workers_.empty()) {
+        return;
+    }
+
+    // Transfers can have long libhv timeouts, so join with a deadline rather than
+    // blocking shutdown. Same helper-thread pattern as the old per-request threads:
+    // std::async can't be used because its future destructor blocks.
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (auto& worker : workers_) {
+        if (!worker.joinable()) {
+            continue;
+        }
+
+        std::atomic<bool> joined{false};
+        std::thread join_helper([&worker, &joined]() {
+            worker.join();
+            joined.store(true);
+        });
+
+        while (!joined.load()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                spdlog::warn("[HttpWorkerPool] Worker still inside a transfer after {}ms - "
+                             "will terminate with process",
+                             timeout.count());
+                join_helper.detach();
+                worker.detach(); // Worker only holds the shared state, not the pool
+                break;
+            }
+            std::this_thread::sleep_for(kJoinPollInterval);
+        }
+
+        if (join_helper.joinable()) {
+            join_helper.join();
+        }
+    }
+    workers_.clear();
+}
+
+// ============================================================================
+// Submission / Cancellation
+// ============================================================================
+
+HttpWorkerPool::Ticket HttpWorkerPool::submit(HttpPriority priority, Job job, std::string key,
+                                              CancelHandler on_cancel) {
+    Ticket ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (shared_->stopping) {
+            return 0;
+        }
+
+        ticket = shared_->next_ticket++;
+        auto& lane = shared_->lanes[static_cast<size_t>(priority)];
+        lane.push_back(QueuedJob{ticket, std::move(key), std::move(job), std::move(on_cancel),
+                                 Clock::now(), std::make_shared<std::atomic<bool>>(false)});
+
+        size_t queued = 0;
+        for (const auto& l : shared_->lanes) {
+            queued += l.size();
+        }
+        shared_->stats.peak_queued = std::max(shared_->stats.peak_queued, queued);
+    }
+    shared_->wake.notify_one();
+    return ticket;
+}
+
+bool HttpWorkerPool::cancel(Ticket ticket) {
+    if (ticket == 0) {
+        return false;
+    }
+
+    QueuedJob removed; // Destroyed outside the lock
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        bool found = false;
+        for (size_t l = 0; l < HTTP_PRIORITY_COUNT && !found; ++l) {
+            auto& lane = shared_->lanes[l];
+            auto it = std::find_if(lane.begin(), lane.end(),
+                                   [ticket](const QueuedJob& q) { return q.ticket == ticket; });
+            if (it != lane.end()) {
+                removed = std::move(*it);
+                lane.erase(it);
+                shared_->stats.lanes[l].cancelled++;
+                found = true;
+            }
+        }
+
+        if (!found) {
+            for (auto& running : shared_->running) {
+                if (running.ticket == ticket) {
+                    if (!running.cancelled->exchange(true)) {
+                        shared_->stats.lanes[running.lane].cancelled++;
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    if (removed.on_cancel) {
+        removed.on_cancel();
+    }
+    return true;
+}
+
+size_t HttpWorkerPool::cancel_key(std::string_view key) {
+    if (key.empty()) {
+        return 0;
+    }
+
+    std::vector<QueuedJob> removed; // Destroyed outside the lock
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        for (size_t l = 0; l < HTTP_PRIORITY_COUNT; ++l) {
+            auto& lane = shared_->lanes[l];
+            for (auto it = lane.begin(); it != lane.end();) {
+                if (it->key == key) {
+                    removed.push_back(std::move(*it));
+                    it = lane.erase(it);
+                    shared_->stats.lanes[l].cancelled++;
+                    count++;
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        for (auto& running : shared_->running) {
+            if (running.key == key && !running.cancelled->exchange(true)) {
+                shared_->stats.lanes[running.lane].cancelled++;
+                count++;
+            }
+        }
+    }
+
+    // Outside the lock: handlers may submit or cancel other jobs
+    for (auto& job : removed) {
+        if (job.on_cancel) {
+            job.on_cancel();
+        }
+    }
+    return count;
+}
+
+HttpPoolStats HttpWorkerPool::take_stats() {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    HttpPoolStats snapshot = shared_->stats;
+    snapshot.queued = 0;
+    for (const auto& lane : shared_->lanes) {
+        snapshot.queued += lane.size();
+    }
+    snapshot.active = shared_->running.size();
+
+    shared_->stats = HttpPoolStats{};
+    shared_->stats.peak_queued = snapshot.queued;
+    return snapshot;
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+bool HttpWorkerPool::pop_next_locked(Shared& shared, QueuedJob& out, size_t& lane) {
+    for (size_t l = 0; l < HTTP_PRIORITY_COUNT; ++l) {
+        if (shared.lanes[l].empty()) {
+            continue;
+        }
+        if (l == static_cast<size_t>(HttpPriority::BACKGROUND) &&
+            shared.background_running >= shared.background_limit) {
+            continue;
+        }
+        out = std::move(shared.lanes[l].front());
+        shared.lanes[l].pop_front();
+        lane = l;
+        return true;
+    }
+    return false;
+}
+
+void HttpWorkerPool::worker_loop(const std::shared_ptr<Shared>& shared) {
+    // One client per worker: libhv keeps its connection open between requests
+    // to the same host, so a worker reuses one TCP connection for all its jobs
+    hv::HttpClient client;
+    constexpr size_t background = static_cast<size_t>(HttpPriority::BACKGROUND);
+
+    for (;;) {
+        QueuedJob job;
+        size_t lane = 0;
+        {
+            std::unique_lock<std::mutex> lock(shared->mutex);
+            while (!shared->stopping && !pop_next_locked(*shared, job, lane)) {
+                shared->wake.wait(lock);
+            }
+            if (shared->stopping) {
+                return;
+            }
+            shared->running.push_back(RunningJob{job.ticket, job.key, job.cancelled, lane});
+            if (lane == background) {
+                shared->background_running++;
+            }
+        }
+
+        auto started = Clock::now();
+        Context ctx(client, job.cancelled);
+        try {
+            job.job(ctx);
+        } catch (const std::exception& e) {
+            spdlog::error("[HttpWorkerPool] {} job threw: {}",
+                          http_priority_name(static_cast<HttpPriority>(lane)), e.what());
+        }
+        auto finished = Clock::now();
+        uint64_t wait_us = elapsed_us(job.queued_at, started);
+        uint64_t run_us = elapsed_us(started, finished);
+        Ticket ticket = job.ticket;
+        CancelHandler on_cancel;
+        if (job.cancelled->load()) {
+            on_cancel = std::move(job.on_cancel);
+        }
+        job = QueuedJob{}; // Release captures before taking the lock
+
+        bool stopping = false;
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            stopping = shared->stopping;
+            auto& running = shared->running;
+            running.erase(std::remove_if(running.begin(), running.end(),
+                                         [ticket](const RunningJob& r) {
+                                             return r.ticket == ticket;
+                                         }),
+                          running.end());
+            if (lane == background) {
+                shared->background_running--;
+            }
+
+            auto& stats = shared->stats.lanes[lane];
+            stats.completed++;
+            stats.wait_total_us += wait_us;
+            stats.wait_max_us = std::max(stats.wait_max_us, wait_us);
+            stats.run_total_us += run_us;
+            stats.run_max_us = std::max(stats.run_max_us, run_us);
+        }
+
+        // Flagged by cancel()/cancel_key() while running; shutdown skips handlers
+        if (on_cancel && !stopping) {
+            on_cancel();
+        }
+        on_cancel = nullptr;
+
+        if (lane == background) {
+            // A background slot opened up; an idle worker may be waiting for it
+            shared->wake.notify_one();
+        }
+    }
+}
+
+} // namespace helix
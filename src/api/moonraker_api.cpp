@@ -149,6 +149,10 @@ SubscriptionId MoonrakerAPI::subscribe_notifications(std::function<void(json)> c
     return client_.register_notify_update(std::move(callback));
 }
 
+SubscriptionId MoonrakerAPI::subscribe_notifications_shared(SharedNotifyCallback callback) {
+    return client_.register_notify_update_shared(std::move(callback));
+}
+
 bool MoonrakerAPI::unsubscribe_notifications(SubscriptionId id) {
     return client_.unsubscribe_notify_update(id);
 }
@@ -94,6 +94,11 @@ SubscriptionId MoonrakerAPIMock::subscribe_notifications(std::function<void(json
     return mock_next_subscription_id_++;
 }
 
+SubscriptionId
+MoonrakerAPIMock::subscribe_notifications_shared(SharedNotifyCallback /*callback*/) {
+    return mock_next_subscription_id_++;
+}
+
 bool MoonrakerAPIMock::unsubscribe_notifications(SubscriptionId /*id*/) {
     return true;
 }
@@ -394,8 +399,12 @@ void MoonrakerFileTransferAPIMock::upload_file_with_name(
 void MoonrakerFileTransferAPIMock::download_thumbnail(const std::string& thumbnail_path,
                                                       const std::string& cache_path,
                                                       StringCallback on_success,
-                                                      ErrorCallback on_error) {
-    (void)on_error; // Unused - mock falls back to placeholder on failure
+                                                      ErrorCallback on_error,
+                                                      helix::HttpPriority priority,
+                                                      const std::string& cancel_key) {
+    (void)on_error;   // Unused - mock falls back to placeholder on failure
+    (void)priority;   // Mock resolves synchronously, nothing to queue
+    (void)cancel_key; // Nothing queued, so nothing to cancel
 
     spdlog::debug("[MoonrakerAPIMock] download_thumbnail: path='{}' -> cache='{}'", thumbnail_path,
                   cache_path);
@@ -70,8 +70,8 @@ std::string annotate_gcode(const std::string& gcode) {
 } // namespace
 
 MoonrakerClient::MoonrakerClient(EventLoopPtr loop)
-    : WebSocketClient(loop), discovery_(*this), was_connected_(false),
-      connection_state_(ConnectionState::DISCONNECTED),
+    : WebSocketClient(loop), discovery_(*this), status_subscriptions_(*this),
+      was_connected_(false), connection_state_(ConnectionState::DISCONNECTED),
       connection_timeout_ms_(10000) // Default 10 seconds
       ,
       keepalive_interval_ms_(10000) // Default 10 seconds
@@ -344,6 +344,14 @@ int MoonrakerClient::connect(const char* url, std::function<void()> on_connected
                 return;
             }
 
+            frames_received_.fetch_add(1, std::memory_order_relaxed);
+            if (recording_frames_.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(frame_log_mutex_);
+                if (frame_log_) {
+                    frame_log_->append(msg);
+                }
+            }
+
             // Validate message size to prevent memory exhaustion
             static constexpr size_t MAX_MESSAGE_SIZE = 5 * 1024 * 1024; // 5 MB
             if (msg.size() > MAX_MESSAGE_SIZE) {
@@ -369,14 +377,35 @@ int MoonrakerClient::connect(const char* url, std::function<void()> on_connected
                 spdlog::debug("[Moonraker Client] Received large message: {} bytes", msg.size());
             }
 
-            // Parse JSON message
-            json j;
+            // Status updates with only frame subscribers skip the JSON DOM entirely
+            if (try_dispatch_status_frame(msg)) {
+                return;
+            }
+
+            // Parse JSON message once; notify subscribers share this document
+            auto parsed = std::make_shared<json>();
             try {
-                j = json::parse(msg);
+                *parsed = json::parse(msg);
             } catch (const json::parse_error& e) {
                 LOG_ERROR_INTERNAL("[Moonraker Client] JSON parse error: {}", e.what());
                 return;
             }
+            SharedJson shared = std::move(parsed);
+            const json& j = *shared;
+
+            // JSON-RPC batch response: one entry per request in the batch
+            if (j.is_array()) {
+                for (const auto& response : j) {
+                    if (response.is_object() && response.contains("id")) {
+                        tracker_.route_response(
+                            response, [this](MoonrakerEventType type, const std::string& msg_str,
+                                             bool is_error, const std::string& details) {
+                                emit_event(type, msg_str, is_error, details);
+                            });
+                    }
+                }
+                return;
+            }
 
             // Route responses with request IDs through the tracker
             if (j.contains("id")) {
@@ -405,15 +434,6 @@ int MoonrakerClient::connect(const char* url, std::function<void()> on_connected
                 {
                     std::lock_guard<std::mutex> lock(callbacks_mutex_);
 
-                    // Printer status updates (most common)
-                    if (method == "notify_status_update" || method == "notify_filelist_changed") {
-                        // Copy all notify callbacks from map
-                        callbacks_to_invoke.reserve(notify_callbacks_.size());
-                        for (const auto& [id, cb] : notify_callbacks_) {
-                            callbacks_to_invoke.push_back(cb);
-                        }
-                    }
-
                     // Method-specific persistent callbacks
                     auto method_it = method_callbacks_.find(method);
                     if (method_it != method_callbacks_.end()) {
@@ -432,6 +452,11 @@ int MoonrakerClient::connect(const char* url, std::function<void()> on_connected
                     }
                 }
 
+                // Printer status updates (most common): one shared document for all
+                if (method == "notify_status_update" || method == "notify_filelist_changed") {
+                    dispatch_notification(shared);
+                }
+
                 // Invoke callbacks outside lock to prevent deadlock
                 for (auto& cb : callbacks_to_invoke) {
                     try {
@@ -616,15 +641,151 @@ SubscriptionId MoonrakerClient::register_notify_update(std::function<void(json)>
         return INVALID_SUBSCRIPTION_ID;
     }
 
+    // Legacy by-value signature: each subscriber gets its own copy
+    return register_notify_update_shared(
+        [cb = std::move(cb)](const SharedJson& notification) { cb(*notification); });
+}
+
+SubscriptionId MoonrakerClient::register_notify_update_shared(SharedNotifyCallback cb) {
+    if (!cb) {
+        spdlog::warn("[Moonraker Client] register_notify_update_shared called with null callback");
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
     SubscriptionId id = next_subscription_id_.fetch_add(1);
     {
         std::lock_guard<std::mutex> lock(callbacks_mutex_);
-        notify_callbacks_.emplace(id, cb);
+        notify_callbacks_.emplace(id, std::move(cb));
     }
     spdlog::trace("[Moonraker Client] Registered notify callback with ID {}", id);
     return id;
 }
 
+SubscriptionId MoonrakerClient::register_status_frame_callback(StatusFrameCallback cb) {
+    if (!cb) {
+        spdlog::warn("[Moonraker Client] register_status_frame_callback called with null callback");
+        return INVALID_SUBSCRIPTION_ID;
+    }
+
+    SubscriptionId id = next_subscription_id_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        frame_callbacks_.emplace(id, std::move(cb));
+    }
+    spdlog::trace("[Moonraker Client] Registered status frame callback with ID {}", id);
+    return id;
+}
+
+bool MoonrakerClient::has_status_subscribers() {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    return !notify_callbacks_.empty() || !frame_callbacks_.empty();
+}
+
+bool MoonrakerClient::try_dispatch_status_frame(const std::string& msg) {
+    if (!StatusFrameDecoder::is_status_update(msg)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        if (frame_callbacks_.empty() || !notify_callbacks_.empty() ||
+            method_callbacks_.count("notify_status_update") != 0) {
+            return false;
+        }
+    }
+
+    auto frame = std::make_shared<StatusFrame>();
+    if (!status_decoder_.decode(msg, *frame)) {
+        // Let the DOM path report the parse error
+        return false;
+    }
+
+    if (frame->other.is_object()) {
+        auto mesh_it = frame->other.find("bed_mesh");
+        if (mesh_it != frame->other.end() && mesh_it->is_object()) {
+            parse_bed_mesh(*mesh_it);
+        }
+    }
+
+    dispatch_status_frame(std::move(frame));
+    return true;
+}
+
+size_t MoonrakerClient::dispatch_status_frame(const SharedStatusFrame& frame) {
+    if (!frame) {
+        return 0;
+    }
+
+    // Two-phase: copy under lock, invoke outside to avoid deadlock
+    std::vector<StatusFrameCallback> callbacks_copy;
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callbacks_copy.reserve(frame_callbacks_.size());
+        for (const auto& [id, cb] : frame_callbacks_) {
+            callbacks_copy.push_back(cb);
+        }
+    }
+
+    for (const auto& cb : callbacks_copy) {
+        try {
+            cb(frame);
+        } catch (const std::exception& e) {
+            LOG_ERROR_INTERNAL("[Moonraker Client] Status frame callback threw exception: {}",
+                               e.what());
+        } catch (...) {
+            LOG_ERROR_INTERNAL("[Moonraker Client] Status frame callback threw unknown exception");
+        }
+    }
+    return callbacks_copy.size();
+}
+
+size_t MoonrakerClient::dispatch_notification(const SharedJson& notification) {
+    if (!notification) {
+        return 0;
+    }
+
+    // Two-phase: copy under lock, invoke outside to avoid deadlock
+    std::vector<SharedNotifyCallback> callbacks_copy;
+    bool has_frame_subscribers = false;
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        callbacks_copy.reserve(notify_callbacks_.size());
+        for (const auto& [id, cb] : notify_callbacks_) {
+            callbacks_copy.push_back(cb);
+        }
+        has_frame_subscribers = !frame_callbacks_.empty();
+    }
+
+    // Frame subscribers get the same update, decoded from the document we already hold
+    size_t frame_dispatched = 0;
+    if (has_frame_subscribers) {
+        const json& n = *notification;
+        auto method_it = n.find("method");
+        auto params_it = n.find("params");
+        if (method_it != n.end() && method_it->is_string() &&
+            method_it->get_ref<const std::string&>() == "notify_status_update" &&
+            params_it != n.end() && params_it->is_array() && !params_it->empty()) {
+            auto frame = std::make_shared<StatusFrame>();
+            StatusFrameDecoder::decode_status((*params_it)[0], *frame);
+            if (params_it->size() > 1 && (*params_it)[1].is_number()) {
+                frame->eventtime = (*params_it)[1].get<double>();
+            }
+            frame_dispatched = dispatch_status_frame(std::move(frame));
+        }
+    }
+
+    for (const auto& cb : callbacks_copy) {
+        try {
+            cb(notification);
+        } catch (const std::exception& e) {
+            LOG_ERROR_INTERNAL("[Moonraker Client] Notify callback threw exception: {}", e.what());
+        } catch (...) {
+            LOG_ERROR_INTERNAL("[Moonraker Client] Notify callback threw unknown exception");
+        }
+    }
+    return callbacks_copy.size() + frame_dispatched;
+}
+
 bool MoonrakerClient::unsubscribe_notify_update(SubscriptionId id) {
     if (id == INVALID_SUBSCRIPTION_ID) {
         return false;
@@ -637,6 +798,10 @@ bool MoonrakerClient::unsubscribe_notify_update(SubscriptionId id) {
         spdlog::debug("[Moonraker Client] Unsubscribed notify callback ID {}", id);
         return true;
     }
+    if (frame_callbacks_.erase(id) > 0) {
+        spdlog::debug("[Moonraker Client] Unsubscribed status frame callback ID {}", id);
+        return true;
+    }
     spdlog::debug("[Moonraker Client] Unsubscribe failed: notify callback ID {} not found", id);
     return false;
 }
@@ -706,32 +871,17 @@ void MoonrakerClient::dispatch_status_update(const json& status) {
         }
     }
 
-    // Wrap raw status into notify_status_update format
-    json notification = {
+    // Wrap raw status into notify_status_update format (single copy shared by all callbacks)
+    auto notification = std::make_shared<const json>(json{
         {"method", "notify_status_update"},
         {"params", json::array({status, 0.0})} // [status, eventtime]
-    };
-
-    // Dispatch to all registered callbacks
-    // Two-phase: copy under lock, invoke outside to avoid deadlock
-    std::vector<std::function<void(json)>> callbacks_copy;
-    {
-        std::lock_guard<std::mutex> lock(callbacks_mutex_);
-        callbacks_copy.reserve(notify_callbacks_.size());
-        for (const auto& [id, cb] : notify_callbacks_) {
-            callbacks_copy.push_back(cb);
-        }
-    }
+    });
 
-    for (const auto& cb : callbacks_copy) {
-        if (cb) {
-            cb(notification);
-        }
-    }
+    size_t dispatched = dispatch_notification(notification);
 
     spdlog::trace(
         "[Moonraker Client] Dispatched status update to {} callbacks (has print_stats: {})",
-        callbacks_copy.size(), status.contains("print_stats"));
+        dispatched, status.contains("print_stats"));
 }
 
 void MoonrakerClient::register_method_callback(const std::string& method,
@@ -787,6 +937,56 @@ bool MoonrakerClient::unregister_method_callback(const std::string& method,
     return true;
 }
 
+void MoonrakerClient::configure_request_batching(const RequestBatchConfig& config) {
+    // Flush on the event loop thread. queueInLoop (not runInLoop) so that requests
+    // sent from a callback on that thread still collect until the callback returns.
+    tracker_.enable_batching(config, [this, weak_guard = std::weak_ptr<bool>(lifetime_guard_)](
+                                         uint32_t delay_ms) {
+        auto guard = weak_guard.lock();
+        if (!guard || !loop()) {
+            return;
+        }
+        loop()->queueInLoop([this, weak_guard, delay_ms]() {
+            auto guard = weak_guard.lock();
+            if (!guard) {
+                return;
+            }
+            if (delay_ms == 0) {
+                tracker_.flush(*this);
+                return;
+            }
+            loop()->setTimeout(static_cast<int>(delay_ms), [this, weak_guard](hv::TimerID) {
+                auto guard = weak_guard.lock();
+                if (guard) {
+                    tracker_.flush(*this);
+                }
+            });
+        });
+    });
+}
+
+bool MoonrakerClient::start_frame_recording(const std::string& path) {
+    auto writer = std::make_unique<FrameLogWriter>();
+    if (!writer->open(path)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(frame_log_mutex_);
+    frame_log_ = std::move(writer);
+    recording_frames_.store(true, std::memory_order_release);
+    spdlog::info("[Moonraker Client] Recording inbound frames to {}", path);
+    return true;
+}
+
+void MoonrakerClient::stop_frame_recording() {
+    std::lock_guard<std::mutex> lock(frame_log_mutex_);
+    recording_frames_.store(false, std::memory_order_release);
+    if (frame_log_) {
+        spdlog::info("[Moonraker Client] Recorded {} frames ({} bytes)",
+                     frame_log_->frame_count(), frame_log_->byte_count());
+        frame_log_.reset();
+    }
+}
+
 int MoonrakerClient::send_jsonrpc(const std::string& method) {
     return tracker_.send_fire_and_forget(*this, method, json());
 }
@@ -2821,18 +2821,8 @@ void MoonrakerClientMock::dispatch_historical_temperatures() {
     constexpr int HOLD_PHASE_SAMPLES = 120; // ~30 seconds hold at peak
     // Cooling phase = remaining samples (~70s, cools extruder ~20°C to ~40°C)
 
-    // Copy callbacks to avoid holding lock during dispatch
-    std::vector<std::function<void(json)>> callbacks_copy;
-    {
-        std::lock_guard<std::mutex> lock(callbacks_mutex_);
-        callbacks_copy.reserve(notify_callbacks_.size());
-        for (const auto& [id, cb] : notify_callbacks_) {
-            callbacks_copy.push_back(cb);
-        }
-    }
-
     // If no callbacks registered yet, skip (caller should register before connect)
-    if (callbacks_copy.empty()) {
+    if (!has_status_subscribers()) {
         spdlog::warn(
             "[MoonrakerClientMock] No callbacks registered for historical temps - skipping");
         return;
@@ -2925,15 +2915,12 @@ void MoonrakerClientMock::dispatch_historical_temperatures() {
             }
         }
 
-        json notification = {{"method", "notify_status_update"},
-                             {"params", json::array({status_obj, timestamp_sec})}};
+        auto notification = std::make_shared<const json>(
+            json{{"method", "notify_status_update"},
+                 {"params", json::array({status_obj, timestamp_sec})}});
 
-        // Dispatch to all callbacks
-        for (const auto& cb : callbacks_copy) {
-            if (cb) {
-                cb(notification);
-            }
-        }
+        // Dispatch to all callbacks (JSON and status frame subscribers)
+        dispatch_notification(notification);
     }
 
     // Store final historical values as current temps
@@ -3470,29 +3457,17 @@ void MoonrakerClientMock::temperature_simulation_loop() {
             }
         }
 
-        json notification = {{"method", "notify_status_update"},
-                             {"params", json::array({status_obj, tick * base_dt})}};
+        auto notification = std::make_shared<const json>(
+            json{{"method", "notify_status_update"},
+                 {"params", json::array({status_obj, tick * base_dt})}});
 
         // Push notification through all registered callbacks
-        // Two-phase: copy under lock, invoke outside to avoid deadlock
-        std::vector<std::function<void(json)>> callbacks_copy;
-        {
-            std::lock_guard<std::mutex> lock(callbacks_mutex_);
-            callbacks_copy.reserve(notify_callbacks_.size());
-            for (const auto& [id, cb] : notify_callbacks_) {
-                callbacks_copy.push_back(cb);
-            }
-        }
-        for (const auto& cb : callbacks_copy) {
-            if (cb) {
-                cb(notification);
-            }
-        }
+        size_t dispatched = dispatch_notification(notification);
 
         // Log every 40 ticks (~10 seconds) to confirm loop is running
         if (tick % 40 == 0) {
             spdlog::trace("[MoonrakerClientMock] Simulation tick {} - callbacks={}", tick,
-                          callbacks_copy.size());
+                          dispatched);
         }
 
         // Sleep wall-clock interval with early-exit support for clean shutdown
@@ -646,6 +646,24 @@ void MoonrakerDiscoverySequence::complete_discovery_subscription() {
     // HelixScreen custom macro:
     subscription_objects["gcode_macro _HELIX_STATE"] = nullptr;
 
+    std::vector<std::string> object_names;
+    object_names.reserve(subscription_objects.size());
+    for (auto it = subscription_objects.begin(); it != subscription_objects.end(); ++it) {
+        object_names.push_back(it.key());
+    }
+
+    // Narrow each object to the fields its readers use (plus any visible panel's fields)
+    subscription_objects = client_.status_subscriptions().begin_subscription(object_names);
+
+    // Route status keys to the PrinterState components that read them
+    std::vector<std::string> subscribed_names;
+    subscribed_names.reserve(subscription_objects.size());
+    for (auto it = subscription_objects.begin(); it != subscription_objects.end(); ++it) {
+        subscribed_names.push_back(it.key());
+    }
+    get_printer_state().set_status_dispatch_table(
+        std::make_shared<const StatusDispatchTable>(subscribed_names));
+
     json subscribe_params = {{"objects", subscription_objects}};
 
     client_.send_jsonrpc(
@@ -13,13 +13,24 @@
 #include "moonraker_api_internal.h"
 #include "spdlog/spdlog.h"
 
-#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
-#include <thread>
 
 using namespace moonraker_internal;
+using helix::HttpPriority;
+using helix::HttpWorkerPool;
+
+namespace {
+
+std::shared_ptr<HttpRequest> make_get_request(const std::string& url) {
+    auto req = std::make_shared<HttpRequest>();
+    req->method = HTTP_GET;
+    req->url = url;
+    return req;
+}
+
+} // namespace
 
 // ============================================================================
 // MoonrakerFileTransferAPI — Constructor / Destructor
@@ -30,75 +41,51 @@ MoonrakerFileTransferAPI::MoonrakerFileTransferAPI(helix::MoonrakerClient& clien
     : client_(client), http_base_url_(http_base_url) {}
 
 MoonrakerFileTransferAPI::~MoonrakerFileTransferAPI() {
-    // Signal shutdown and wait for HTTP threads with timeout
+    // Signal shutdown, then let the pool drop queued jobs and join its workers.
     // File downloads/uploads can have long timeouts (up to 1 hour in libhv),
-    // so we use a timed join to avoid blocking shutdown indefinitely.
+    // so the pool joins with a deadline and detaches stragglers.
     shutting_down_.store(true);
 
-    std::list<std::thread> threads_to_join;
+    std::shared_ptr<helix::HttpWorkerPool> pool;
     {
-        std::lock_guard<std::mutex> lock(http_threads_mutex_);
-        threads_to_join = std::move(http_threads_);
-    }
-
-    if (threads_to_join.empty()) {
-        return;
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool = std::move(pool_);
     }
-
-    spdlog::debug("[FileTransferAPI] Waiting for {} HTTP thread(s) to finish...",
-                  threads_to_join.size());
-
-    // Timed join pattern: use a helper thread to do the join, poll for completion.
-    // We can't use std::async because its std::future destructor blocks!
-    constexpr auto kJoinTimeout = std::chrono::seconds(2);
-    constexpr auto kPollInterval = std::chrono::milliseconds(10);
-
-    for (auto& t : threads_to_join) {
-        if (!t.joinable()) {
-            continue;
-        }
-
-        // Launch helper thread to do the join
-        std::atomic<bool> joined{false};
-        std::thread join_helper([&t, &joined]() {
-            t.join();
-            joined.store(true);
-        });
-
-        // Poll for completion with timeout
-        auto start = std::chrono::steady_clock::now();
-        while (!joined.load()) {
-            if (std::chrono::steady_clock::now() - start > kJoinTimeout) {
-                spdlog::warn("[FileTransferAPI] HTTP thread still running after {}s - "
-                             "will terminate with process",
-                             kJoinTimeout.count());
-                join_helper.detach();
-                t.detach(); // Critical: avoid std::terminate on list destruction
-                break;
-            }
-            std::this_thread::sleep_for(kPollInterval);
-        }
-
-        // Use joinable() check - returns false after detach(), preventing UB
-        if (join_helper.joinable()) {
-            join_helper.join();
-        }
+    if (pool) {
+        spdlog::debug("[FileTransferAPI] Shutting down HTTP worker pool...");
     }
 }
 
-void MoonrakerFileTransferAPI::launch_http_thread(std::function<void()> func) {
-    std::lock_guard<std::mutex> lock(http_threads_mutex_);
+void MoonrakerFileTransferAPI::submit_http_job(helix::HttpPriority priority,
+                                               helix::HttpWorkerPool::Job job, std::string key,
+                                               helix::HttpWorkerPool::CancelHandler on_cancel) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
 
     // Check shutdown under lock to prevent race with destructor's move
     if (shutting_down_.load()) {
         return;
     }
 
-    // Launch the new thread
-    http_threads_.emplace_back([func = std::move(func)]() {
-        func();
-        // Thread auto-removed during next launch or destructor
-    });
+    if (!pool_) {
+        pool_ = std::make_shared<helix::HttpWorkerPool>(HTTP_WORKERS);
+    }
+    pool_->submit(priority, std::move(job), std::move(key), std::move(on_cancel));
+}
+
+bool MoonrakerFileTransferAPI::cancel_thumbnail(const std::string& cancel_key) {
+    // Cancel outside pool_mutex_: cancel handlers run on this thread and may queue
+    // new downloads
+    std::shared_ptr<helix::HttpWorkerPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool = pool_;
+    }
+    return pool && pool->cancel_key(cancel_key) > 0;
+}
+
+helix::HttpPoolStats MoonrakerFileTransferAPI::take_transfer_stats() {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return pool_ ? pool_->take_stats() : helix::HttpPoolStats{};
 }
 
 // ============================================================================
@@ -125,9 +112,12 @@ void MoonrakerFileTransferAPI::download_file(const std::string& root, const std:
 
     spdlog::debug("[Moonraker API] Downloading file: {}", url);
 
-    // Run HTTP request in a tracked thread to ensure clean shutdown
-    launch_http_thread([url, path, on_success, on_error]() {
-        auto resp = requests::get(url.c_str());
+    submit_http_job(HttpPriority::PREFETCH, [url, path, on_success,
+                                             on_error](HttpWorkerPool::Context& ctx) {
+        auto resp = ctx.send(make_get_request(url));
+        if (ctx.cancelled()) {
+            return;
+        }
 
         if (!handle_http_response(resp, "download_file", on_error)) {
             return;
@@ -163,12 +153,10 @@ void MoonrakerFileTransferAPI::download_file_partial(const std::string& root,
 
     spdlog::debug("[Moonraker API] Partial download (first {} bytes): {}", max_bytes, url);
 
-    // Run HTTP request in a tracked thread
-    launch_http_thread([url, path, max_bytes, on_success, on_error]() {
+    submit_http_job(HttpPriority::PREFETCH, [url, path, max_bytes, on_success,
+                                             on_error](HttpWorkerPool::Context& ctx) {
         // Create request with Range header for partial content
-        auto req = std::make_shared<HttpRequest>();
-        req->method = HTTP_GET;
-        req->url = url;
+        auto req = make_get_request(url);
         req->timeout = 30; // 30 second timeout
 
         // HTTP Range header: bytes=0-{max_bytes-1}
@@ -176,7 +164,10 @@ void MoonrakerFileTransferAPI::download_file_partial(const std::string& root,
         std::string range_header = "bytes=0-" + std::to_string(max_bytes - 1);
         req->SetHeader("Range", range_header);
 
-        auto resp = requests::request(req);
+        auto resp = ctx.send(req);
+        if (ctx.cancelled()) {
+            return;
+        }
 
         // Accept both 200 (full file) and 206 (partial content)
         if (!handle_http_response(resp, "download_file_partial", on_error, {200, 206})) {
@@ -208,11 +199,15 @@ void MoonrakerFileTransferAPI::download_file_to_path(
 
     spdlog::debug("[Moonraker API] Streaming download: {} -> {}", url, dest_path);
 
-    // Run HTTP request in a tracked thread to ensure clean shutdown
-    // Use requests::downloadFile which streams directly to disk
-    launch_http_thread([url, path, dest_path, on_success, on_error, on_progress]() {
+    // Use requests::downloadFile which streams directly to disk. It opens its own
+    // connection; at these sizes the connect is noise next to the transfer.
+    submit_http_job(HttpPriority::BACKGROUND, [url, path, dest_path, on_success, on_error,
+                                               on_progress](HttpWorkerPool::Context& ctx) {
         // libhv's downloadFile progress callback signature matches our ProgressCallback
         size_t bytes_written = requests::downloadFile(url.c_str(), dest_path.c_str(), on_progress);
+        if (ctx.cancelled()) {
+            return;
+        }
 
         if (bytes_written == 0) {
             spdlog::error("[Moonraker API] Streaming download failed: {} -> {}", url, dest_path);
@@ -232,7 +227,8 @@ void MoonrakerFileTransferAPI::download_file_to_path(
 void MoonrakerFileTransferAPI::download_thumbnail(const std::string& thumbnail_path,
                                                   const std::string& cache_path,
                                                   StringCallback on_success,
-                                                  ErrorCallback on_error) {
+                                                  ErrorCallback on_error, HttpPriority priority,
+                                                  const std::string& cancel_key) {
     // Validate inputs
     if (thumbnail_path.empty()) {
         spdlog::warn("[Moonraker API] Empty thumbnail path");
@@ -255,34 +251,46 @@ void MoonrakerFileTransferAPI::download_thumbnail(const std::string& thumbnail_p
 
     spdlog::trace("[Moonraker API] Downloading thumbnail: {} -> {}", url, cache_path);
 
-    // Run HTTP request in a tracked thread to ensure clean shutdown
-    launch_http_thread([url, thumbnail_path, cache_path, on_success, on_error]() {
-        auto resp = requests::get(url.c_str());
+    // Cancelled downloads still report back, so callers waiting on one can retry or clean up
+    auto report_cancelled = [thumbnail_path, on_error]() {
+        spdlog::trace("[Moonraker API] Thumbnail download cancelled: {}", thumbnail_path);
+        report_error(on_error, MoonrakerErrorType::CANCELLED, "download_thumbnail",
+                     "Thumbnail download cancelled");
+    };
+
+    submit_http_job(
+        priority,
+        [url, cache_path, on_success, on_error](HttpWorkerPool::Context& ctx) {
+            auto resp = ctx.send(make_get_request(url));
+            if (ctx.cancelled()) {
+                return; // report_cancelled runs unless the pool is shutting down
+            }
 
-        if (!handle_http_response(resp, "download_thumbnail", on_error)) {
-            return;
-        }
+            if (!handle_http_response(resp, "download_thumbnail", on_error)) {
+                return;
+            }
 
-        // Write to cache file
-        std::ofstream file(cache_path, std::ios::binary);
-        if (!file) {
-            spdlog::error("[Moonraker API] Failed to create cache file: {}", cache_path);
-            report_error(on_error, MoonrakerErrorType::UNKNOWN, "download_thumbnail",
-                         "Failed to create cache file: " + cache_path);
-            return;
-        }
+            // Write to cache file
+            std::ofstream file(cache_path, std::ios::binary);
+            if (!file) {
+                spdlog::error("[Moonraker API] Failed to create cache file: {}", cache_path);
+                report_error(on_error, MoonrakerErrorType::UNKNOWN, "download_thumbnail",
+                             "Failed to create cache file: " + cache_path);
+                return;
+            }
 
-        file.write(resp->body.data(), static_cast<std::streamsize>(resp->body.size()));
-        file.close();
+            file.write(resp->body.data(), static_cast<std::streamsize>(resp->body.size()));
+            file.close();
 
-        spdlog::trace("[Moonraker API] Cached thumbnail {} bytes -> {}", resp->body.size(),
-                      cache_path);
-        helix::MemoryMonitor::log_now("moonraker_thumb_downloaded");
+            spdlog::trace("[Moonraker API] Cached thumbnail {} bytes -> {}", resp->body.size(),
+                          cache_path);
+            helix::MemoryMonitor::log_now("moonraker_thumb_downloaded");
 
-        if (on_success) {
-            on_success(cache_path);
-        }
-    });
+            if (on_success) {
+                on_success(cache_path);
+            }
+        },
+        cancel_key, report_cancelled);
 }
 
 void MoonrakerFileTransferAPI::upload_file(const std::string& root, const std::string& path,
@@ -310,8 +318,8 @@ void MoonrakerFileTransferAPI::upload_file_with_name(
 
     spdlog::debug("[Moonraker API] Uploading {} bytes to {}/{}", content.size(), root, path);
 
-    // Run HTTP request in a tracked thread to ensure clean shutdown
-    launch_http_thread([url, root, path, filename, content, on_success, on_error]() {
+    submit_http_job(HttpPriority::PREFETCH, [url, root, path, filename, content, on_success,
+                                             on_error](HttpWorkerPool::Context& ctx) {
         // Create multipart form request
         auto req = std::make_shared<HttpRequest>();
         req->method = HTTP_POST;
@@ -341,7 +349,10 @@ void MoonrakerFileTransferAPI::upload_file_with_name(
         helix::MemoryMonitor::log_now("moonraker_upload_start");
 
         // Send request
-        auto resp = requests::request(req);
+        auto resp = ctx.send(req);
+        if (ctx.cancelled()) {
+            return;
+        }
 
         // Upload accepts 200 or 201
         if (!handle_http_response(resp, "upload_file", on_error, {200, 201})) {
@@ -406,9 +417,10 @@ void MoonrakerFileTransferAPI::upload_file_from_path(
         params["path"] = directory;
     }
 
-    // Run streaming upload in a tracked thread using libhv's uploadLargeFormFile
-    launch_http_thread(
-        [url, params, filename, local_path, file_size, on_success, on_error, on_progress]() {
+    // Streaming upload using libhv's uploadLargeFormFile (opens its own connection)
+    submit_http_job(
+        HttpPriority::BACKGROUND, [url, params, filename, local_path, file_size, on_success,
+                                   on_error, on_progress](HttpWorkerPool::Context& ctx) {
             // Use libhv's streaming multipart upload with custom filename
             // Combine external progress callback with internal logging
             size_t last_progress_log = 0;
@@ -430,6 +442,9 @@ void MoonrakerFileTransferAPI::upload_file_from_path(
 
             auto resp = requests::uploadLargeFormFile(url.c_str(), "file", local_path.c_str(),
                                                       filename.c_str(), params_copy, progress_cb);
+            if (ctx.cancelled()) {
+                return;
+            }
 
             // Upload accepts 200 or 201
             if (!handle_http_response(resp, "upload_file_from_path", on_error, {200, 201})) {
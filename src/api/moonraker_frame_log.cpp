@@ -0,0 +1,155 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "moonraker_frame_log.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace helix {
+
+namespace {
+
+constexpr char MAGIC[] = "HXFRAMES";
+constexpr size_t MAGIC_LEN = sizeof(MAGIC) - 1;
+
+/// Upper bound on a single frame; matches MoonrakerClient's own limit
+constexpr uint64_t MAX_FRAME_BYTES = 5 * 1024 * 1024;
+
+uint64_t now_us() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+} // namespace
+
+// ============================================================================
+// FrameLogWriter
+// ============================================================================
+
+FrameLogWriter::~FrameLogWriter() {
+    close();
+}
+
+bool FrameLogWriter::open(const std::string& path) {
+    close();
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        spdlog::error("[FrameLog] Cannot create {}", path);
+        return false;
+    }
+    file_.write(MAGIC, MAGIC_LEN);
+    file_.put(static_cast<char>(VERSION));
+    start_us_ = now_us();
+    last_us_ = 0;
+    frames_ = 0;
+    bytes_ = 0;
+    return true;
+}
+
+void FrameLogWriter::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+void FrameLogWriter::append(std::string_view payload) {
+    append(payload, now_us() - start_us_);
+}
+
+void FrameLogWriter::append(std::string_view payload, uint64_t time_us) {
+    if (!file_.is_open()) {
+        return;
+    }
+    time_us = std::max(time_us, last_us_);
+    write_varint(time_us - last_us_);
+    write_varint(payload.size());
+    file_.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    last_us_ = time_us;
+    frames_++;
+    bytes_ += payload.size();
+}
+
+void FrameLogWriter::write_varint(uint64_t value) {
+    char buf[10];
+    size_t len = 0;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buf[len++] = static_cast<char>(value != 0 ? byte | 0x80 : byte);
+    } while (value != 0);
+    file_.write(buf, static_cast<std::streamsize>(len));
+}
+
+// ============================================================================
+// FrameLogReader
+// ============================================================================
+
+bool FrameLogReader::open(const std::string& path) {
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+        spdlog::error("[FrameLog] Cannot open {}", path);
+        return false;
+    }
+    char header[MAGIC_LEN + 1] = {};
+    file_.read(header, sizeof(header));
+    if (!file_ || std::memcmp(header, MAGIC, MAGIC_LEN) != 0) {
+        spdlog::error("[FrameLog] {} is not a frame log", path);
+        file_.close();
+        return false;
+    }
+    if (static_cast<uint8_t>(header[MAGIC_LEN]) != FrameLogWriter::VERSION) {
+        spdlog::error("[FrameLog] {} has unsupported version {}", path,
+                      static_cast<int>(static_cast<uint8_t>(header[MAGIC_LEN])));
+        file_.close();
+        return false;
+    }
+    time_us_ = 0;
+    return true;
+}
+
+bool FrameLogReader::next(LoggedFrame& frame) {
+    if (!file_.is_open()) {
+        return false;
+    }
+    uint64_t delta = 0;
+    uint64_t length = 0;
+    if (!read_varint(delta)) {
+        return false; // Clean end of log
+    }
+    if (!read_varint(length) || length > MAX_FRAME_BYTES) {
+        spdlog::warn("[FrameLog] Corrupt record header, stopping");
+        return false;
+    }
+    frame.payload.resize(length);
+    file_.read(frame.payload.data(), static_cast<std::streamsize>(length));
+    if (static_cast<uint64_t>(file_.gcount()) != length) {
+        spdlog::warn("[FrameLog] Truncated final record ({} of {} bytes)", file_.gcount(),
+                     length);
+        return false;
+    }
+    time_us_ += delta;
+    frame.time_us = time_us_;
+    return true;
+}
+
+bool FrameLogReader::read_varint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = file_.get();
+        if (c == std::char_traits<char>::eof()) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace helix
@@ -11,6 +11,9 @@
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "hv/json.hpp"
 
 namespace helix {
@@ -34,7 +37,22 @@ RequestId MoonrakerRequestTracker::send(hv::WebSocketClient& ws, const std::stri
     request.timeout_ms = (timeout_ms > 0) ? timeout_ms : default_request_timeout_ms_;
     request.silent = silent;
 
-    // Register request
+    // Build the JSON-RPC message with the registered ID
+    json rpc;
+    rpc["jsonrpc"] = "2.0";
+    rpc["method"] = method;
+    rpc["id"] = id;
+
+    // Only include params if not null or empty
+    if (!params.is_null() && !params.empty()) {
+        rpc["params"] = params;
+    }
+    std::string payload = rpc.dump();
+
+    // Register request, then either queue it for the next batch or write it now
+    bool queued = false;
+    std::function<void(uint32_t)> schedule_flush;
+    uint32_t window_ms = 0;
     {
         std::lock_guard<std::mutex> lock(requests_mutex_);
         auto it = pending_requests_.find(id);
@@ -43,55 +61,222 @@ RequestId MoonrakerRequestTracker::send(hv::WebSocketClient& ws, const std::stri
                                id);
             return INVALID_REQUEST_ID;
         }
-        pending_requests_.insert({id, request});
+        PendingRequest& stored = pending_requests_.emplace(id, std::move(request)).first->second;
         spdlog::trace("[Request Tracker] Registered request {} for method {}, total pending: {}",
                       id, method, pending_requests_.size());
+
+        if (batching_ && is_batchable(method)) {
+            queued = true;
+            outbox_.push_back(QueuedRequest{id, std::move(payload)});
+            if (!flush_scheduled_) {
+                flush_scheduled_ = true;
+                schedule_flush = schedule_flush_;
+                window_ms = batch_config_.window_ms;
+            }
+        } else {
+            mark_sent_locked(stored);
+            stats_.frames++;
+        }
     }
 
-    // Build and send JSON-RPC message with the registered ID
-    json rpc;
-    rpc["jsonrpc"] = "2.0";
-    rpc["method"] = method;
-    rpc["id"] = id;
+    if (queued) {
+        spdlog::trace("[Request Tracker] Queued request {} ({}) for the next batch", id, method);
+        if (schedule_flush) {
+            schedule_flush(window_ms);
+        }
+        return id;
+    }
 
-    // Only include params if not null or empty
-    if (!params.is_null() && !params.empty()) {
-        rpc["params"] = params;
+    spdlog::trace("[Request Tracker] send: {}", payload);
+    // Return the request ID on success, or INVALID_REQUEST_ID on send failure
+    return write_frame(ws, payload, {id}) ? id : INVALID_REQUEST_ID;
+}
+
+void MoonrakerRequestTracker::enable_batching(
+    const RequestBatchConfig& config, std::function<void(uint32_t delay_ms)> schedule_flush) {
+    std::lock_guard<std::mutex> lock(requests_mutex_);
+    batch_config_ = config;
+    batch_config_.max_batch = std::max<size_t>(batch_config_.max_batch, 1);
+    batch_config_.max_in_flight = std::max<size_t>(batch_config_.max_in_flight, 1);
+    schedule_flush_ = std::move(schedule_flush);
+    batching_ = batch_config_.max_batch > 1 && schedule_flush_ != nullptr;
+    spdlog::debug("[Request Tracker] Batching {}: window={}ms, batch={}, in-flight cap={}",
+                  batching_ ? "enabled" : "disabled", batch_config_.window_ms,
+                  batch_config_.max_batch, batch_config_.max_in_flight);
+}
+
+void MoonrakerRequestTracker::flush(hv::WebSocketClient& ws) {
+    std::string frame;
+    std::vector<RequestId> ids;
+    bool more = false;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        flush_scheduled_ = false;
+
+        while (!outbox_.empty() && ids.size() < batch_config_.max_batch &&
+               in_flight_ < batch_config_.max_in_flight) {
+            QueuedRequest queued = std::move(outbox_.front());
+            outbox_.pop_front();
+
+            auto it = pending_requests_.find(queued.id);
+            if (it == pending_requests_.end()) {
+                continue; // Cancelled or timed out while queued
+            }
+            mark_sent_locked(it->second);
+            if (!ids.empty()) {
+                frame += ',';
+            }
+            frame += queued.payload;
+            ids.push_back(queued.id);
+        }
+
+        if (ids.empty()) {
+            return; // Nothing queued, or every slot is in flight (a response reschedules)
+        }
+        if (ids.size() > 1) {
+            frame = "[" + frame + "]"; // JSON-RPC batch; Moonraker answers with an array
+            stats_.batched += ids.size();
+        }
+        stats_.frames++;
+        more = !outbox_.empty() && in_flight_ < batch_config_.max_in_flight;
     }
 
-    spdlog::trace("[Request Tracker] send: {}", rpc.dump());
-    int result = ws.send(rpc.dump());
-    spdlog::trace("[Request Tracker] send({}) returned {}", method, result);
+    spdlog::trace("[Request Tracker] flush: {} request(s) in one frame", ids.size());
+    write_frame(ws, frame, ids);
 
-    // Return the request ID on success, or INVALID_REQUEST_ID on send failure
-    if (result < 0) {
-        // Send failed - remove pending request and invoke error callback
-        std::function<void(const MoonrakerError&)> error_callback_copy;
-        std::string method_name;
-        {
-            std::lock_guard<std::mutex> lock(requests_mutex_);
+    if (more) {
+        request_flush(0); // Batch size limit hit; the rest goes out next iteration
+    }
+}
+
+bool MoonrakerRequestTracker::write_frame(hv::WebSocketClient& ws, const std::string& frame,
+                                          const std::vector<RequestId>& ids) {
+    int result = ws.send(frame);
+    spdlog::trace("[Request Tracker] send({} request(s)) returned {}", ids.size(), result);
+    if (result >= 0) {
+        return true;
+    }
+
+    // Send failed - remove pending requests and invoke error callbacks
+    std::vector<std::pair<std::string, std::function<void(const MoonrakerError&)>>> failed;
+    bool flush_more = false;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        for (RequestId id : ids) {
             auto it = pending_requests_.find(id);
-            if (it != pending_requests_.end()) {
-                error_callback_copy = it->second.error_callback;
-                method_name = it->second.method;
-                pending_requests_.erase(it);
+            if (it == pending_requests_.end()) {
+                continue;
             }
+            spdlog::error("[Request Tracker] Failed to send request {} ({}), removed from pending",
+                          id, it->second.method);
+            flush_more = release_locked(it->second) || flush_more;
+            failed.emplace_back(it->second.method, it->second.error_callback);
+            pending_requests_.erase(it);
         }
-        spdlog::error("[Request Tracker] Failed to send request {} ({}), removed from pending", id,
-                      method_name.empty() ? "unknown" : method_name);
-
-        // Invoke error callback outside lock (prevents deadlock if callback sends new request)
-        if (error_callback_copy) {
-            try {
-                error_callback_copy(MoonrakerError::connection_lost(method_name));
-            } catch (const std::exception& e) {
-                spdlog::error("[Request Tracker] Error callback threw exception: {}", e.what());
-            }
+    }
+
+    // Invoke error callbacks outside lock (prevents deadlock if callback sends new request)
+    for (auto& [method_name, error_callback] : failed) {
+        if (!error_callback) {
+            continue;
+        }
+        try {
+            error_callback(MoonrakerError::connection_lost(method_name));
+        } catch (const std::exception& e) {
+            spdlog::error("[Request Tracker] Error callback threw exception: {}", e.what());
+        }
+    }
+    if (flush_more) {
+        request_flush(0);
+    }
+    return false;
+}
+
+void MoonrakerRequestTracker::mark_sent_locked(PendingRequest& request) {
+    request.in_flight = true;
+    request.sent_at = std::chrono::steady_clock::now();
+    in_flight_++;
+    stats_.peak_in_flight = std::max(stats_.peak_in_flight, in_flight_);
+}
+
+bool MoonrakerRequestTracker::release_locked(const PendingRequest& request) {
+    if (!request.in_flight) {
+        return false;
+    }
+    in_flight_--;
+    return batching_ && !outbox_.empty();
+}
+
+void MoonrakerRequestTracker::request_flush(uint32_t delay_ms) {
+    std::function<void(uint32_t)> schedule_flush;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        if (flush_scheduled_ || outbox_.empty() || !schedule_flush_) {
+            return;
         }
-        return INVALID_REQUEST_ID;
+        flush_scheduled_ = true;
+        schedule_flush = schedule_flush_;
+    }
+    schedule_flush(delay_ms);
+}
+
+bool MoonrakerRequestTracker::is_batchable(const std::string& method) {
+    // Effects the user is waiting on must not sit behind a batch of queries
+    static constexpr const char* IMMEDIATE_PREFIXES[] = {
+        "printer.gcode.script", "printer.emergency_stop", "printer.print.",
+        "printer.restart",      "printer.firmware_restart", "machine.",
+    };
+    for (const char* prefix : IMMEDIATE_PREFIXES) {
+        if (method.rfind(prefix, 0) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RequestTrackerStats MoonrakerRequestTracker::take_stats() {
+    std::lock_guard<std::mutex> lock(requests_mutex_);
+    RequestTrackerStats stats = std::move(stats_);
+    stats_ = RequestTrackerStats{};
+    stats_.peak_in_flight = in_flight_;
+    stats.in_flight = in_flight_;
+    stats.queued = outbox_.size();
+    return stats;
+}
+
+void RequestLatencyHistogram::record(uint64_t latency_us, bool is_error) {
+    uint64_t ms = latency_us / 1000;
+    size_t bucket = 0;
+    while (ms > 0 && bucket < BUCKETS - 1) {
+        ms >>= 1;
+        bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    if (is_error) {
+        errors++;
     }
+    total_us += latency_us;
+    max_us = std::max(max_us, latency_us);
+}
 
-    return id;
+uint32_t RequestLatencyHistogram::percentile_ms(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(count * fraction)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= target && buckets[i] > 0) {
+            if (i == BUCKETS - 1) {
+                return static_cast<uint32_t>((max_us + 999) / 1000);
+            }
+            return 1u << i;
+        }
+    }
+    return static_cast<uint32_t>((max_us + 999) / 1000);
 }
 
 int MoonrakerRequestTracker::send_fire_and_forget(hv::WebSocketClient& ws,
@@ -138,6 +323,7 @@ bool MoonrakerRequestTracker::route_response(
     bool has_error = false;
     bool is_silent = false;
     bool found = false;
+    bool flush_more = false;
     MoonrakerError error;
 
     {
@@ -155,9 +341,17 @@ bool MoonrakerRequestTracker::route_response(
                 error = MoonrakerError::from_json_rpc(msg["error"], request.method);
                 error_cb = request.error_callback;
             } else {
-                success_cb = request.success_callback;
+                success_cb = std::move(request.success_callback);
             }
 
+            if (request.in_flight) {
+                auto latency = std::chrono::steady_clock::now() - request.sent_at;
+                stats_.methods[request.method].record(
+                    static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(latency).count()),
+                    has_error);
+            }
+            flush_more = release_locked(request);
             pending_requests_.erase(it);
         }
     } // Lock released here
@@ -166,6 +360,11 @@ bool MoonrakerRequestTracker::route_response(
         return false;
     }
 
+    // A slot freed up: let queued requests go before running the callback
+    if (flush_more) {
+        request_flush(0);
+    }
+
     // Invoke callbacks outside the lock to avoid deadlock
     if (has_error) {
         // Suppress toast notifications during shutdown handling to avoid
@@ -210,16 +409,24 @@ bool MoonrakerRequestTracker::cancel(RequestId id) {
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(requests_mutex_);
-    auto it = pending_requests_.find(id);
-    if (it != pending_requests_.end()) {
+    bool flush_more = false;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        auto it = pending_requests_.find(id);
+        if (it == pending_requests_.end()) {
+            spdlog::debug(
+                "[Request Tracker] Cancel failed: request {} not found (already completed?)", id);
+            return false;
+        }
         spdlog::debug("[Request Tracker] Cancelled request {} ({})", id, it->second.method);
+        flush_more = release_locked(it->second);
         pending_requests_.erase(it);
-        return true;
     }
 
-    spdlog::debug("[Request Tracker] Cancel failed: request {} not found (already completed?)", id);
-    return false;
+    if (flush_more) {
+        request_flush(0);
+    }
+    return true;
 }
 
 void MoonrakerRequestTracker::check_timeouts(
@@ -233,6 +440,7 @@ void MoonrakerRequestTracker::check_timeouts(
         std::function<void()> error_callback;
     };
     std::vector<TimeoutInfo> timed_out;
+    bool flush_more = false;
 
     // Phase 1: Find timed out requests and copy data (under lock)
     {
@@ -268,6 +476,8 @@ void MoonrakerRequestTracker::check_timeouts(
                     };
                 }
 
+                stats_.methods[request.method].timeouts++;
+                flush_more = release_locked(request) || flush_more;
                 timed_out.push_back(std::move(info));
                 timed_out_ids.push_back(id);
             }
@@ -279,6 +489,10 @@ void MoonrakerRequestTracker::check_timeouts(
         }
     } // Lock released here
 
+    if (flush_more) {
+        request_flush(0);
+    }
+
     // Phase 2: Emit events and invoke callbacks outside lock
     // (safe - event handlers and callbacks can call send without deadlock)
     for (auto& info : timed_out) {
@@ -330,6 +544,11 @@ void MoonrakerRequestTracker::cleanup_all() {
 
             pending_requests_.clear();
         }
+
+        // Queued requests were in pending_requests_ and are failed with the rest
+        outbox_.clear();
+        flush_scheduled_ = false;
+        in_flight_ = 0;
     } // Lock released here
 
     // Phase 2: Invoke callbacks outside lock (safe - callbacks can call send)
@@ -0,0 +1,781 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "moonraker_status_decoder.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace helix {
+
+namespace {
+
+/// Known Klipper objects with a typed section in StatusFrame
+enum class Kind : uint8_t {
+    NONE,
+    EXTRUDER,
+    HEATER_BED,
+    TOOLHEAD,
+    GCODE_MOVE,
+    PRINT_STATS,
+    VIRTUAL_SDCARD,
+    FAN,
+    MOTION_REPORT,
+};
+
+/// Minimum element count for a typed vector field (Klipper sends XYZ[E])
+constexpr uint8_t MIN_VECTOR_ELEMENTS = 3;
+
+/**
+ * @brief Where a typed field lands inside a StatusFrame
+ *
+ * count == 0 means "not typed" (goes to StatusFrame::other), 1 is a scalar,
+ * anything larger is a numeric array of up to `count` elements.
+ */
+struct FieldSlot {
+    double* values = nullptr;
+    uint8_t count = 0;
+    uint16_t* mask = nullptr;
+    uint16_t bit = 0;
+
+    bool scalar() const {
+        return count == 1;
+    }
+    bool vector() const {
+        return count > 1;
+    }
+    void commit() const {
+        *mask |= bit;
+    }
+};
+
+FieldSlot scalar_slot(double& value, uint16_t& mask, uint16_t bit) {
+    return FieldSlot{&value, 1, &mask, bit};
+}
+
+FieldSlot vector_slot(std::array<double, 4>& values, uint16_t& mask, uint16_t bit) {
+    return FieldSlot{values.data(), static_cast<uint8_t>(values.size()), &mask, bit};
+}
+
+Kind classify(std::string_view name, int& extruder_index) {
+    extruder_index = StatusFrame::extruder_index(name);
+    if (extruder_index >= 0) {
+        return Kind::EXTRUDER;
+    }
+    if (name == "heater_bed")
+        return Kind::HEATER_BED;
+    if (name == "toolhead")
+        return Kind::TOOLHEAD;
+    if (name == "gcode_move")
+        return Kind::GCODE_MOVE;
+    if (name == "print_stats")
+        return Kind::PRINT_STATS;
+    if (name == "virtual_sdcard")
+        return Kind::VIRTUAL_SDCARD;
+    if (name == "fan")
+        return Kind::FAN;
+    if (name == "motion_report")
+        return Kind::MOTION_REPORT;
+    return Kind::NONE;
+}
+
+/// Objects whose JSON consumers still need the whole object in StatusFrame::other
+bool retains_dom(Kind kind) {
+    return kind == Kind::PRINT_STATS || kind == Kind::VIRTUAL_SDCARD;
+}
+
+void mark_present(StatusFrame& frame, Kind kind, int extruder_index) {
+    switch (kind) {
+    case Kind::EXTRUDER:
+        frame.objects |= StatusFrame::EXTRUDER;
+        frame.extruder_mask |= static_cast<uint8_t>(1u << extruder_index);
+        break;
+    case Kind::HEATER_BED:
+        frame.objects |= StatusFrame::HEATER_BED;
+        break;
+    case Kind::TOOLHEAD:
+        frame.objects |= StatusFrame::TOOLHEAD;
+        break;
+    case Kind::GCODE_MOVE:
+        frame.objects |= StatusFrame::GCODE_MOVE;
+        break;
+    case Kind::PRINT_STATS:
+        frame.objects |= StatusFrame::PRINT_STATS;
+        break;
+    case Kind::VIRTUAL_SDCARD:
+        frame.objects |= StatusFrame::VIRTUAL_SDCARD;
+        break;
+    case Kind::FAN:
+        frame.objects |= StatusFrame::FAN;
+        break;
+    case Kind::MOTION_REPORT:
+        frame.objects |= StatusFrame::MOTION_REPORT;
+        break;
+    case Kind::NONE:
+        break;
+    }
+}
+
+FieldSlot heater_field(HeaterSample& h, std::string_view key) {
+    if (key == "temperature")
+        return scalar_slot(h.temperature, h.fields, HeaterSample::TEMPERATURE);
+    if (key == "target")
+        return scalar_slot(h.target, h.fields, HeaterSample::TARGET);
+    if (key == "power")
+        return scalar_slot(h.power, h.fields, HeaterSample::POWER);
+    return {};
+}
+
+FieldSlot lookup_field(StatusFrame& f, Kind kind, int extruder_index, std::string_view key) {
+    switch (kind) {
+    case Kind::EXTRUDER:
+        return heater_field(f.extruders[static_cast<size_t>(extruder_index)], key);
+    case Kind::HEATER_BED:
+        return heater_field(f.heater_bed, key);
+    case Kind::TOOLHEAD: {
+        auto& t = f.toolhead;
+        if (key == "position")
+            return vector_slot(t.position, t.fields, ToolheadSample::POSITION);
+        if (key == "max_velocity")
+            return scalar_slot(t.max_velocity, t.fields, ToolheadSample::MAX_VELOCITY);
+        if (key == "max_accel")
+            return scalar_slot(t.max_accel, t.fields, ToolheadSample::MAX_ACCEL);
+        if (key == "print_time")
+            return scalar_slot(t.print_time, t.fields, ToolheadSample::PRINT_TIME);
+        if (key == "estimated_print_time")
+            return scalar_slot(t.estimated_print_time, t.fields,
+                               ToolheadSample::ESTIMATED_PRINT_TIME);
+        return {};
+    }
+    case Kind::GCODE_MOVE: {
+        auto& g = f.gcode_move;
+        if (key == "gcode_position")
+            return vector_slot(g.gcode_position, g.fields, GcodeMoveSample::GCODE_POSITION);
+        if (key == "position")
+            return vector_slot(g.position, g.fields, GcodeMoveSample::POSITION);
+        if (key == "homing_origin")
+            return vector_slot(g.homing_origin, g.fields, GcodeMoveSample::HOMING_ORIGIN);
+        if (key == "speed_factor")
+            return scalar_slot(g.speed_factor, g.fields, GcodeMoveSample::SPEED_FACTOR);
+        if (key == "extrude_factor")
+            return scalar_slot(g.extrude_factor, g.fields, GcodeMoveSample::EXTRUDE_FACTOR);
+        if (key == "speed")
+            return scalar_slot(g.speed, g.fields, GcodeMoveSample::SPEED);
+        return {};
+    }
+    case Kind::PRINT_STATS: {
+        auto& p = f.print_stats;
+        if (key == "print_duration")
+            return scalar_slot(p.print_duration, p.fields, PrintStatsSample::PRINT_DURATION);
+        if (key == "total_duration")
+            return scalar_slot(p.total_duration, p.fields, PrintStatsSample::TOTAL_DURATION);
+        if (key == "filament_used")
+            return scalar_slot(p.filament_used, p.fields, PrintStatsSample::FILAMENT_USED);
+        return {};
+    }
+    case Kind::VIRTUAL_SDCARD: {
+        auto& v = f.virtual_sdcard;
+        if (key == "progress")
+            return scalar_slot(v.progress, v.fields, VirtualSdcardSample::PROGRESS);
+        if (key == "file_position")
+            return scalar_slot(v.file_position, v.fields, VirtualSdcardSample::FILE_POSITION);
+        if (key == "file_size")
+            return scalar_slot(v.file_size, v.fields, VirtualSdcardSample::FILE_SIZE);
+        return {};
+    }
+    case Kind::FAN:
+        if (key == "speed")
+            return scalar_slot(f.fan.speed, f.fan.fields, FanSample::SPEED);
+        if (key == "rpm")
+            return scalar_slot(f.fan.rpm, f.fan.fields, FanSample::RPM);
+        return {};
+    case Kind::MOTION_REPORT: {
+        auto& m = f.motion_report;
+        if (key == "live_position")
+            return vector_slot(m.live_position, m.fields, MotionReportSample::LIVE_POSITION);
+        if (key == "live_velocity")
+            return scalar_slot(m.live_velocity, m.fields, MotionReportSample::LIVE_VELOCITY);
+        if (key == "live_extruder_velocity")
+            return scalar_slot(m.live_extruder_velocity, m.fields,
+                               MotionReportSample::LIVE_EXTRUDER_VELOCITY);
+        return {};
+    }
+    case Kind::NONE:
+        break;
+    }
+    return {};
+}
+
+/// Store a typed vector from a DOM array; false if it is not a usable numeric array
+bool store_vector(const FieldSlot& slot, const json& arr) {
+    if (arr.size() < MIN_VECTOR_ELEMENTS) {
+        return false;
+    }
+    size_t n = std::min<size_t>(arr.size(), slot.count);
+    for (size_t i = 0; i < n; ++i) {
+        if (!arr[i].is_number()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        slot.values[i] = arr[i].get<double>();
+    }
+    slot.commit();
+    return true;
+}
+
+/**
+ * @brief Copy typed fields of one known object from DOM into the frame
+ *
+ * @param untyped If non-null, receives the fields that have no typed slot
+ */
+void extract_typed(StatusFrame& out, Kind kind, int extruder_index, const json& obj,
+                   json* untyped) {
+    mark_present(out, kind, extruder_index);
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        FieldSlot slot = lookup_field(out, kind, extruder_index, it.key());
+        if (slot.scalar() && it->is_number()) {
+            *slot.values = it->get<double>();
+            slot.commit();
+            continue;
+        }
+        if (slot.vector() && it->is_array()) {
+            // Unusable vectors (e.g. null positions before homing) are dropped,
+            // matching the SAX path
+            store_vector(slot, *it);
+            continue;
+        }
+        if (untyped) {
+            (*untyped)[it.key()] = *it;
+        }
+    }
+}
+
+/**
+ * @brief Incremental DOM builder fed by SAX events
+ *
+ * Builds exactly one JSON value (scalar or container) into a target, then
+ * deactivates. Container pointers stay valid because a parent is never
+ * modified while one of its children is still open.
+ */
+class DomCapture {
+  public:
+    bool active() const {
+        return target_ != nullptr;
+    }
+
+    void begin(json& target) {
+        target_ = &target;
+        stack_.clear();
+    }
+
+    /// @return true when the captured value is complete
+    bool value(json&& v) {
+        place(std::move(v));
+        return finish_if_done();
+    }
+
+    void start(bool is_object) {
+        json* container = place(is_object ? json::object() : json::array());
+        stack_.push_back(container);
+    }
+
+    void key(json::string_t&& k) {
+        pending_key_ = std::move(k);
+    }
+
+    /// @return true when the captured value is complete
+    bool end() {
+        if (!stack_.empty()) {
+            stack_.pop_back();
+        }
+        return finish_if_done();
+    }
+
+  private:
+    json* place(json&& v) {
+        if (stack_.empty()) {
+            *target_ = std::move(v);
+            return target_;
+        }
+        json* parent = stack_.back();
+        if (parent->is_object()) {
+            json& slot = (*parent)[pending_key_];
+            slot = std::move(v);
+            return &slot;
+        }
+        parent->push_back(std::move(v));
+        return &parent->back();
+    }
+
+    bool finish_if_done() {
+        if (stack_.empty()) {
+            target_ = nullptr;
+            return true;
+        }
+        return false;
+    }
+
+    json* target_ = nullptr;
+    std::vector<json*> stack_;
+    json::string_t pending_key_;
+};
+
+/**
+ * @brief nlohmann SAX handler for notify_status_update envelopes
+ *
+ * Depth map (number of open containers):
+ *   1 = JSON-RPC envelope, 2 = params array, 3 = status object,
+ *   4 = fields of a typed object, 5 = elements of a typed vector field.
+ * Anything that is not typed is diverted into a DomCapture.
+ */
+class StatusSaxHandler {
+  public:
+    explicit StatusSaxHandler(StatusFrame& out) : out_(out) {}
+
+    bool is_status_update() const {
+        return method_ok_ && status_seen_;
+    }
+
+    bool null() {
+        return scalar(json(nullptr), false, 0.0);
+    }
+    bool boolean(bool v) {
+        return scalar(json(v), false, 0.0);
+    }
+    bool number_integer(json::number_integer_t v) {
+        return scalar(json(v), true, static_cast<double>(v));
+    }
+    bool number_unsigned(json::number_unsigned_t v) {
+        return scalar(json(v), true, static_cast<double>(v));
+    }
+    bool number_float(json::number_float_t v, const json::string_t& /*raw*/) {
+        return scalar(json(v), true, static_cast<double>(v));
+    }
+    bool string(json::string_t& v) {
+        if (!capture_.active() && depth_ == 1) {
+            if (envelope_key_ == "method") {
+                method_ok_ = (v == "notify_status_update");
+            }
+            return true;
+        }
+        return scalar(json(std::move(v)), false, 0.0);
+    }
+    bool binary(json::binary_t& /*v*/) {
+        return scalar(json(nullptr), false, 0.0);
+    }
+
+    bool start_object(std::size_t /*elements*/) {
+        return container(true);
+    }
+    bool start_array(std::size_t /*elements*/) {
+        return container(false);
+    }
+    bool end_object() {
+        return end();
+    }
+    bool end_array() {
+        return end();
+    }
+
+    bool key(json::string_t& k) {
+        if (capture_.active()) {
+            capture_.key(std::move(k));
+            return true;
+        }
+        switch (depth_) {
+        case 1:
+            envelope_key_.swap(k);
+            break;
+        case 3:
+            object_name_.swap(k);
+            kind_ = classify(object_name_, extruder_index_);
+            break;
+        case 4:
+            field_key_.swap(k);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/,
+                     const json::exception& /*ex*/) {
+        return false;
+    }
+
+  private:
+    json& untyped_field() {
+        return out_.other[object_name_][field_key_];
+    }
+
+    bool scalar(json&& v, bool is_number, double number) {
+        if (capture_.active()) {
+            if (capture_.value(std::move(v))) {
+                on_capture_done();
+            }
+            return true;
+        }
+
+        switch (depth_) {
+        case 2:
+            ++params_index_;
+            if (in_params_ && params_index_ == 1 && is_number) {
+                out_.eventtime = number;
+            }
+            break;
+        case 3:
+            if (kind_ == Kind::NONE) {
+                out_.other[object_name_] = std::move(v);
+            }
+            break;
+        case 4: {
+            FieldSlot slot = lookup_field(out_, kind_, extruder_index_, field_key_);
+            if (slot.scalar() && is_number) {
+                *slot.values = number;
+                slot.commit();
+            } else {
+                untyped_field() = std::move(v);
+            }
+            break;
+        }
+        case 5:
+            if (is_number) {
+                if (vector_count_ < vector_slot_.count) {
+                    vector_values_[vector_count_] = number;
+                }
+            } else {
+                vector_ok_ = false;
+            }
+            ++vector_count_;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool container(bool is_object) {
+        if (!capture_.active()) {
+            switch (depth_) {
+            case 0:
+                if (!is_object) {
+                    return false;
+                }
+                break;
+            case 1:
+                if (envelope_key_ == "params" && !is_object) {
+                    in_params_ = true;
+                    params_index_ = -1;
+                } else {
+                    capture_.begin(scratch_);
+                }
+                break;
+            case 2:
+                ++params_index_;
+                if (in_params_ && params_index_ == 0 && is_object) {
+                    status_seen_ = true;
+                } else {
+                    capture_.begin(scratch_);
+                }
+                break;
+            case 3:
+                if (is_object && kind_ != Kind::NONE && !retains_dom(kind_)) {
+                    mark_present(out_, kind_, extruder_index_);
+                } else {
+                    capture_.begin(out_.other[object_name_]);
+                    capture_kind_ = is_object ? kind_ : Kind::NONE;
+                }
+                break;
+            case 4: {
+                FieldSlot slot = lookup_field(out_, kind_, extruder_index_, field_key_);
+                if (!is_object && slot.vector()) {
+                    vector_slot_ = slot;
+                    vector_count_ = 0;
+                    vector_ok_ = true;
+                } else {
+                    capture_.begin(untyped_field());
+                }
+                break;
+            }
+            default:
+                // Nested container inside a typed vector: not a usable vector
+                vector_ok_ = false;
+                capture_.begin(scratch_);
+                break;
+            }
+        }
+
+        ++depth_;
+        if (capture_.active()) {
+            capture_.start(is_object);
+        }
+        return true;
+    }
+
+    bool end() {
+        --depth_;
+        if (capture_.active()) {
+            if (capture_.end()) {
+                on_capture_done();
+            }
+            return true;
+        }
+
+        if (depth_ == 4 && vector_slot_.vector()) {
+            if (vector_ok_ && vector_count_ >= MIN_VECTOR_ELEMENTS) {
+                size_t n = std::min<size_t>(vector_count_, vector_slot_.count);
+                for (size_t i = 0; i < n; ++i) {
+                    vector_slot_.values[i] = vector_values_[i];
+                }
+                vector_slot_.commit();
+            }
+            vector_slot_ = {};
+        } else if (depth_ == 1) {
+            in_params_ = false;
+        }
+        return true;
+    }
+
+    void on_capture_done() {
+        // Retained objects (print_stats, virtual_sdcard) are captured whole,
+        // then their typed fields are lifted out of the captured DOM
+        if (capture_kind_ != Kind::NONE) {
+            extract_typed(out_, capture_kind_, extruder_index_, out_.other[object_name_],
+                          nullptr);
+            capture_kind_ = Kind::NONE;
+        }
+        scratch_ = nullptr;
+    }
+
+    StatusFrame& out_;
+    DomCapture capture_;
+    json scratch_; ///< Sink for values outside the status object
+
+    int depth_ = 0;
+    json::string_t envelope_key_;
+    bool method_ok_ = false;
+    bool in_params_ = false;
+    bool status_seen_ = false;
+    int params_index_ = -1;
+
+    json::string_t object_name_;
+    Kind kind_ = Kind::NONE;
+    Kind capture_kind_ = Kind::NONE;
+    int extruder_index_ = -1;
+    json::string_t field_key_;
+
+    FieldSlot vector_slot_;
+    std::array<double, 4> vector_values_{};
+    size_t vector_count_ = 0;
+    bool vector_ok_ = false;
+};
+
+/// Copy one field of a typed sample if the newer frame carries it
+template <typename Sample, typename Field, typename T>
+void take_field(Sample& into, const Sample& newer, Field field, T Sample::*member) {
+    if (newer.has(field)) {
+        into.*member = newer.*member;
+        into.fields |= field;
+    }
+}
+
+void merge_sample(HeaterSample& into, const HeaterSample& newer) {
+    take_field(into, newer, HeaterSample::TEMPERATURE, &HeaterSample::temperature);
+    take_field(into, newer, HeaterSample::TARGET, &HeaterSample::target);
+    take_field(into, newer, HeaterSample::POWER, &HeaterSample::power);
+}
+
+void merge_sample(ToolheadSample& into, const ToolheadSample& newer) {
+    take_field(into, newer, ToolheadSample::POSITION, &ToolheadSample::position);
+    take_field(into, newer, ToolheadSample::MAX_VELOCITY, &ToolheadSample::max_velocity);
+    take_field(into, newer, ToolheadSample::MAX_ACCEL, &ToolheadSample::max_accel);
+    take_field(into, newer, ToolheadSample::PRINT_TIME, &ToolheadSample::print_time);
+    take_field(into, newer, ToolheadSample::ESTIMATED_PRINT_TIME,
+               &ToolheadSample::estimated_print_time);
+}
+
+void merge_sample(GcodeMoveSample& into, const GcodeMoveSample& newer) {
+    take_field(into, newer, GcodeMoveSample::POSITION, &GcodeMoveSample::position);
+    take_field(into, newer, GcodeMoveSample::GCODE_POSITION, &GcodeMoveSample::gcode_position);
+    take_field(into, newer, GcodeMoveSample::HOMING_ORIGIN, &GcodeMoveSample::homing_origin);
+    take_field(into, newer, GcodeMoveSample::SPEED_FACTOR, &GcodeMoveSample::speed_factor);
+    take_field(into, newer, GcodeMoveSample::EXTRUDE_FACTOR, &GcodeMoveSample::extrude_factor);
+    take_field(into, newer, GcodeMoveSample::SPEED, &GcodeMoveSample::speed);
+}
+
+void merge_sample(PrintStatsSample& into, const PrintStatsSample& newer) {
+    take_field(into, newer, PrintStatsSample::PRINT_DURATION, &PrintStatsSample::print_duration);
+    take_field(into, newer, PrintStatsSample::TOTAL_DURATION, &PrintStatsSample::total_duration);
+    take_field(into, newer, PrintStatsSample::FILAMENT_USED, &PrintStatsSample::filament_used);
+}
+
+void merge_sample(VirtualSdcardSample& into, const VirtualSdcardSample& newer) {
+    take_field(into, newer, VirtualSdcardSample::PROGRESS, &VirtualSdcardSample::progress);
+    take_field(into, newer, VirtualSdcardSample::FILE_POSITION,
+               &VirtualSdcardSample::file_position);
+    take_field(into, newer, VirtualSdcardSample::FILE_SIZE, &VirtualSdcardSample::file_size);
+}
+
+void merge_sample(FanSample& into, const FanSample& newer) {
+    take_field(into, newer, FanSample::SPEED, &FanSample::speed);
+    take_field(into, newer, FanSample::RPM, &FanSample::rpm);
+}
+
+void merge_sample(MotionReportSample& into, const MotionReportSample& newer) {
+    take_field(into, newer, MotionReportSample::LIVE_POSITION, &MotionReportSample::live_position);
+    take_field(into, newer, MotionReportSample::LIVE_VELOCITY, &MotionReportSample::live_velocity);
+    take_field(into, newer, MotionReportSample::LIVE_EXTRUDER_VELOCITY,
+               &MotionReportSample::live_extruder_velocity);
+}
+
+bool has_print_state(const json& other) {
+    if (!other.is_object()) {
+        return false;
+    }
+    auto it = other.find("print_stats");
+    return it != other.end() && it->is_object() && it->contains("state");
+}
+
+} // namespace
+
+void StatusFrame::clear() {
+    *this = StatusFrame{};
+}
+
+bool StatusFrame::merge(const StatusFrame& newer) {
+    if (has_print_state(other) && has_print_state(newer.other)) {
+        return false;
+    }
+
+    eventtime = newer.eventtime;
+    objects |= newer.objects;
+    extruder_mask |= newer.extruder_mask;
+    for (size_t i = 0; i < MAX_EXTRUDERS; ++i) {
+        if (newer.has_extruder(i)) {
+            merge_sample(extruders[i], newer.extruders[i]);
+        }
+    }
+    merge_sample(heater_bed, newer.heater_bed);
+    merge_sample(toolhead, newer.toolhead);
+    merge_sample(gcode_move, newer.gcode_move);
+    merge_sample(print_stats, newer.print_stats);
+    merge_sample(virtual_sdcard, newer.virtual_sdcard);
+    merge_sample(fan, newer.fan);
+    merge_sample(motion_report, newer.motion_report);
+
+    // Klipper reports changed fields whole, so a per-object field overwrite is exact
+    if (newer.other.is_object()) {
+        if (!other.is_object()) {
+            other = json::object();
+        }
+        for (auto it = newer.other.begin(); it != newer.other.end(); ++it) {
+            json& object = other[it.key()];
+            if (object.is_object() && it.value().is_object()) {
+                for (auto field = it.value().begin(); field != it.value().end(); ++field) {
+                    object[field.key()] = field.value();
+                }
+            } else {
+                object = it.value();
+            }
+        }
+    }
+    return true;
+}
+
+std::string StatusFrame::extruder_name(size_t index) {
+    return index == 0 ? std::string("extruder") : "extruder" + std::to_string(index);
+}
+
+int StatusFrame::extruder_index(std::string_view name) {
+    constexpr std::string_view prefix = "extruder";
+    if (name.size() < prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+        return -1;
+    }
+    std::string_view suffix = name.substr(prefix.size());
+    if (suffix.empty()) {
+        return 0;
+    }
+    // Single digit only: "extruder1".."extruder7" (not "extruder_stepper x")
+    if (suffix.size() != 1 || suffix[0] < '1' || suffix[0] > '9') {
+        return -1;
+    }
+    int index = suffix[0] - '0';
+    return index < static_cast<int>(MAX_EXTRUDERS) ? index : -1;
+}
+
+bool StatusFrameDecoder::is_status_update(std::string_view message) {
+    // Moonraker puts "method" before "params"; the method name is always near the head
+    constexpr size_t HEAD_BYTES = 128;
+    return message.substr(0, HEAD_BYTES).find("\"notify_status_update\"") !=
+           std::string_view::npos;
+}
+
+bool StatusFrameDecoder::decode(std::string_view message, StatusFrame& out) {
+    out.clear();
+    StatusSaxHandler handler(out);
+    bool ok = json::sax_parse(message.data(), message.data() + message.size(), &handler);
+    return ok && handler.is_status_update();
+}
+
+void StatusFrameDecoder::decode_status(const json& status, StatusFrame& out) {
+    out.clear();
+    if (!status.is_object()) {
+        return;
+    }
+
+    for (auto it = status.begin(); it != status.end(); ++it) {
+        int extruder_index = -1;
+        Kind kind = classify(it.key(), extruder_index);
+        if (kind == Kind::NONE) {
+            out.other[it.key()] = *it;
+            continue;
+        }
+        if (!it->is_object()) {
+            continue;
+        }
+        if (retains_dom(kind)) {
+            out.other[it.key()] = *it;
+            extract_typed(out, kind, extruder_index, *it, nullptr);
+            continue;
+        }
+        json untyped;
+        extract_typed(out, kind, extruder_index, *it, &untyped);
+        if (!untyped.is_null()) {
+            out.other[it.key()] = std::move(untyped);
+        }
+    }
+}
+
+void StatusFrameDecoder::decode_typed(const json& status, StatusFrame& out) {
+    out.clear();
+    if (!status.is_object()) {
+        return;
+    }
+
+    for (auto it = status.begin(); it != status.end(); ++it) {
+        int extruder_index = -1;
+        Kind kind = classify(it.key(), extruder_index);
+        if (kind != Kind::NONE && it->is_object()) {
+            extract_typed(out, kind, extruder_index, *it, nullptr);
+        }
+    }
+}
+
+HeaterSample StatusFrameDecoder::decode_heater(const json& obj) {
+    HeaterSample sample;
+    if (!obj.is_object()) {
+        return sample;
+    }
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        FieldSlot slot = heater_field(sample, it.key());
+        if (slot.scalar() && it->is_number()) {
+            *slot.values = it->get<double>();
+            slot.commit();
+        }
+    }
+    return sample;
+}
+
+} // namespace helix
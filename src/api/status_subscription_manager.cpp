@@ -0,0 +1,153 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "status_subscription_manager.h"
+
+#include "moonraker_client.h"
+#include "moonraker_status_decoder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <set>
+
+namespace helix {
+
+namespace {
+
+bool starts_with(const std::string& name, const char* prefix) {
+    return name.rfind(prefix, 0) == 0;
+}
+
+} // namespace
+
+StatusSubscriptionManager::StatusSubscriptionManager(MoonrakerClient& client) : client_(client) {}
+
+std::optional<std::vector<std::string>>
+StatusSubscriptionManager::base_fields(const std::string& name) {
+    // homed_axes: motion/calibration, kinematics: printer detection, extruder: active tool.
+    // position is only shown by the motion/controls panels, which request it while visible.
+    if (name == "toolhead") {
+        return std::vector<std::string>{"homed_axes", "kinematics", "extruder"};
+    }
+    // gcode_position is likewise panel-only
+    if (name == "gcode_move") {
+        return std::vector<std::string>{"speed_factor", "extrude_factor", "homing_origin"};
+    }
+    if (name == "heater_bed" || StatusFrame::extruder_index(name) >= 0 ||
+        starts_with(name, "heater_generic ")) {
+        return std::vector<std::string>{"temperature", "target"};
+    }
+    if (starts_with(name, "temperature_sensor ")) {
+        return std::vector<std::string>{"temperature"};
+    }
+    if (starts_with(name, "temperature_fan ")) {
+        return std::vector<std::string>{"temperature", "target", "speed"};
+    }
+    if (name == "fan" || starts_with(name, "heater_fan ") || starts_with(name, "fan_generic ") ||
+        starts_with(name, "controller_fan ")) {
+        return std::vector<std::string>{"speed"};
+    }
+    // Not read anywhere unless a panel asks for it
+    if (name == "motion_report" || name == "system_stats") {
+        return std::vector<std::string>{};
+    }
+    return std::nullopt;
+}
+
+json StatusSubscriptionManager::begin_subscription(const std::vector<std::string>& objects) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    discovered_ = objects;
+    subscribed_ = build_objects_locked();
+    return subscribed_;
+}
+
+void StatusSubscriptionManager::set_owner_fields(const void* owner, StatusFieldMap fields) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        owners_[owner] = std::move(fields);
+    }
+    update_subscription();
+}
+
+void StatusSubscriptionManager::clear_owner(const void* owner) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (owners_.erase(owner) == 0) {
+            return;
+        }
+    }
+    update_subscription();
+}
+
+json StatusSubscriptionManager::build_objects() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return build_objects_locked();
+}
+
+json StatusSubscriptionManager::build_objects_locked() const {
+    json objects = json::object();
+
+    for (const auto& name : discovered_) {
+        auto base = base_fields(name);
+        if (!base) {
+            objects[name] = nullptr;
+            continue;
+        }
+
+        std::set<std::string> fields(base->begin(), base->end());
+        bool all_fields = false;
+        for (const auto& [owner, owner_fields] : owners_) {
+            auto it = owner_fields.find(name);
+            if (it == owner_fields.end()) {
+                continue;
+            }
+            if (it->second.empty()) {
+                all_fields = true;
+                break;
+            }
+            fields.insert(it->second.begin(), it->second.end());
+        }
+
+        if (all_fields) {
+            objects[name] = nullptr;
+        } else if (!fields.empty()) {
+            objects[name] = std::vector<std::string>(fields.begin(), fields.end());
+        }
+    }
+
+    return objects;
+}
+
+void StatusSubscriptionManager::update_subscription() {
+    json objects;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscribed_.is_null()) {
+            return; // Discovery has not subscribed yet; it will pick up the owners
+        }
+        objects = build_objects_locked();
+        if (objects == subscribed_) {
+            return;
+        }
+        subscribed_ = objects;
+    }
+
+    if (client_.get_connection_state() != ConnectionState::CONNECTED) {
+        return; // Next discovery rebuilds the subscription
+    }
+
+    spdlog::debug("[StatusSubscriptionManager] Re-subscribing {} objects", objects.size());
+    client_.send_jsonrpc(
+        "printer.objects.subscribe", json{{"objects", objects}},
+        [this](json response) {
+            // Newly added fields only stream on change; seed them from the response
+            if (response.contains("result") && response["result"].contains("status")) {
+                client_.dispatch_status_update(response["result"]["status"]);
+            }
+        },
+        [](const MoonrakerError& err) {
+            spdlog::warn("[StatusSubscriptionManager] Re-subscribe failed: {}", err.message);
+        });
+}
+
+} // namespace helix
@@ -152,6 +152,7 @@
 #include <SDL.h>
 #endif
 
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdlib>
@@ -2125,6 +2126,11 @@ int Application::main_loop() {
     static constexpr uint32_t INVALIDATION_FAILSAFE_MS =
         8000; // Must exceed DISCOVERY_TIMEOUT_MS (5s)
 
+    // Main loop sleep bounds: at least 1ms so ready-now timers cannot spin the CPU,
+    // at most 50ms so polled work (timeouts, display sleep) stays responsive
+    static constexpr uint32_t MIN_LOOP_WAIT_MS = 1;
+    static constexpr uint32_t MAX_LOOP_WAIT_MS = 50;
+
     // Configure main loop handler
     helix::application::MainLoopHandler::Config loop_config;
     loop_config.screenshot_enabled = m_args.screenshot_enabled;
@@ -2178,7 +2184,7 @@ int Application::main_loop() {
         }
 
         // Run LVGL tasks
-        lv_timer_handler();
+        uint32_t idle_ms = lv_timer_handler();
 
         // Signal splash to exit when discovery completes (or timeout)
         m_splash_manager.check_and_signal();
@@ -2217,12 +2223,68 @@ int Application::main_loop() {
         if (loop_config.benchmark_mode) {
             lv_obj_invalidate(lv_screen_active());
             if (m_loop_handler.benchmark_should_report()) {
+                auto dispatch = get_printer_state().take_status_dispatch_stats();
+                m_loop_handler.benchmark_record_dispatch(dispatch.frames, dispatch.total_ns,
+                                                         dispatch.max_ns);
                 auto report = m_loop_handler.benchmark_get_report();
-                spdlog::info("[Application] Benchmark FPS: {:.1f}", report.fps);
+                spdlog::info("[Application] Benchmark FPS: {:.1f}, status dispatch: {} frames, "
+                             "avg {:.1f}us, max {:.1f}us",
+                             report.fps, report.dispatch_count, report.dispatch_avg_us,
+                             report.dispatch_max_us);
+
+                auto queue = helix::ui::UpdateQueue::instance().take_stats();
+                spdlog::info("[Application] Benchmark update queue: {} run, max depth {}, "
+                             "latency avg {:.1f}us p50 {}us p95 {}us p99 {}us max {:.1f}us, "
+                             "{} overflowed, {} dropped, {} coalesced",
+                             queue.executed, queue.max_depth, queue.latency_avg_us(),
+                             queue.latency_percentile_us(50), queue.latency_percentile_us(95),
+                             queue.latency_percentile_us(99),
+                             static_cast<double>(queue.latency_max_ns) / 1000.0, queue.overflowed,
+                             queue.dropped, queue.coalesced);
+
+                if (MoonrakerClient* client = get_moonraker_client()) {
+                    auto requests = client->take_request_stats();
+                    spdlog::info("[Application] Benchmark requests: {} in flight (peak {}), "
+                                 "{} queued, {} frames, {} batched",
+                                 requests.in_flight, requests.peak_in_flight, requests.queued,
+                                 requests.frames, requests.batched);
+                    for (const auto& [method, latency] : requests.methods) {
+                        spdlog::info("[Application] Benchmark   {}: {} done, avg {:.1f}ms, "
+                                     "p50 <{}ms, p95 <{}ms, max {:.1f}ms, {} errors, {} timeouts",
+                                     method, latency.count, latency.avg_ms(),
+                                     latency.percentile_ms(50), latency.percentile_ms(95),
+                                     static_cast<double>(latency.max_us) / 1000.0, latency.errors,
+                                     latency.timeouts);
+                    }
+                }
+
+                if (MoonrakerAPI* api = get_moonraker_api()) {
+                    auto transfers = api->transfers().take_transfer_stats();
+                    spdlog::info("[Application] Benchmark transfers: {} active, {} queued "
+                                 "(peak {})",
+                                 transfers.active, transfers.queued, transfers.peak_queued);
+                    for (size_t lane = 0; lane < transfers.lanes.size(); ++lane) {
+                        const auto& stats = transfers.lanes[lane];
+                        if (stats.completed == 0 && stats.cancelled == 0) {
+                            continue;
+                        }
+                        auto priority = static_cast<helix::HttpPriority>(lane);
+                        spdlog::info("[Application] Benchmark   {}: {} done, {} cancelled, "
+                                     "wait avg {:.1f}ms max {:.1f}ms, transfer avg {:.1f}ms "
+                                     "max {:.1f}ms",
+                                     helix::http_priority_name(priority), stats.completed,
+                                     stats.cancelled, stats.avg_wait_ms(),
+                                     static_cast<double>(stats.wait_max_us) / 1000.0,
+                                     stats.avg_run_ms(),
+                                     static_cast<double>(stats.run_max_us) / 1000.0);
+                    }
+                }
             }
         }
 
-        DisplayManager::delay(5);
+        // Sleep until the next LVGL timer is due or another thread queues work
+        helix::ui::UpdateQueue::instance().wait_for_work(
+            std::clamp(idle_ms, MIN_LOOP_WAIT_MS, MAX_LOOP_WAIT_MS));
     }
 
     m_running = false;
@@ -19,6 +19,9 @@ void MainLoopHandler::init(const Config& config, uint32_t start_tick_ms) {
     // Initialize benchmark state
     m_benchmark_frame_count = 0;
     m_benchmark_last_report = start_tick_ms;
+    m_benchmark_dispatch_count = 0;
+    m_benchmark_dispatch_total_ns = 0;
+    m_benchmark_dispatch_max_ns = 0;
 }
 
 void MainLoopHandler::on_frame(uint32_t current_tick_ms) {
@@ -60,6 +63,18 @@ bool MainLoopHandler::benchmark_should_report() const {
     return (m_current_tick - m_benchmark_last_report) >= m_config.benchmark_report_interval_ms;
 }
 
+void MainLoopHandler::benchmark_record_dispatch(uint32_t count, uint64_t total_ns,
+                                                uint64_t max_ns) {
+    if (!m_config.benchmark_mode) {
+        return;
+    }
+    m_benchmark_dispatch_count += count;
+    m_benchmark_dispatch_total_ns += total_ns;
+    if (max_ns > m_benchmark_dispatch_max_ns) {
+        m_benchmark_dispatch_max_ns = max_ns;
+    }
+}
+
 MainLoopHandler::BenchmarkReport MainLoopHandler::benchmark_get_report() {
     BenchmarkReport report;
     report.frame_count = m_benchmark_frame_count;
@@ -71,9 +86,19 @@ MainLoopHandler::BenchmarkReport MainLoopHandler::benchmark_get_report() {
         report.fps = m_benchmark_frame_count / report.elapsed_sec;
     }
 
+    report.dispatch_count = m_benchmark_dispatch_count;
+    if (m_benchmark_dispatch_count > 0) {
+        float total_us = static_cast<float>(m_benchmark_dispatch_total_ns) / 1000.0f;
+        report.dispatch_avg_us = total_us / static_cast<float>(m_benchmark_dispatch_count);
+    }
+    report.dispatch_max_us = static_cast<float>(m_benchmark_dispatch_max_ns) / 1000.0f;
+
     // Reset counters for next interval
     m_benchmark_frame_count = 0;
     m_benchmark_last_report = m_current_tick;
+    m_benchmark_dispatch_count = 0;
+    m_benchmark_dispatch_total_ns = 0;
+    m_benchmark_dispatch_max_ns = 0;
 
     return report;
 }
@@ -16,12 +16,14 @@
 #include "ui_emergency_stop.h"
 #include "ui_error_reporting.h"
 #include "ui_modal.h"
+#include "ui_update_queue.h"
 
 #include "abort_manager.h"
 #include "ams_state.h"
 #include "app_constants.h"
 #include "app_globals.h"
 #include "config.h"
+#include "environment_config.h"
 #include "macro_modification_manager.h"
 #include "moonraker_api.h"
 #include "moonraker_api_mock.h"
@@ -37,6 +39,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -172,9 +175,25 @@ void MoonrakerManager::process_notifications() {
     std::lock_guard<std::mutex> lock(m_notification_mutex);
 
     while (!m_notification_queue.empty()) {
-        json notification = m_notification_queue.front();
+        QueuedNotification queued = std::move(m_notification_queue.front());
         m_notification_queue.pop();
 
+        // Decoded status update
+        if (queued.frame) {
+            // Forward status updates to ToolState for tool changer tracking
+            // (toolchanger/tool objects are never typed, so frame->other has them)
+            if (queued.frame->other.is_object()) {
+                helix::ToolState::instance().update_from_status(queued.frame->other);
+            }
+            get_printer_state().update_from_frame_shared(std::move(queued.frame));
+            continue;
+        }
+
+        if (!queued.json) {
+            continue;
+        }
+        const json& notification = *queued.json;
+
         // Check for connection state change (queued from state_change_callback)
         if (notification.contains("_connection_state")) {
             int new_state = notification["new_state"].get<int>();
@@ -205,20 +224,6 @@ void MoonrakerManager::process_notifications() {
                     }
                 }
             }
-        } else {
-            // Regular Moonraker notification
-            get_printer_state().update_from_notification(notification);
-
-            // Forward status updates to ToolState for tool changer tracking
-            if (notification.contains("method") && notification.contains("params")) {
-                const auto& method = notification["method"];
-                if (method.is_string() && method.get<std::string>() == "notify_status_update") {
-                    const auto& params = notification["params"];
-                    if (params.is_array() && !params.empty()) {
-                        helix::ToolState::instance().update_from_status(params[0]);
-                    }
-                }
-            }
         }
     }
 }
@@ -253,6 +258,9 @@ void MoonrakerManager::create_client(const RuntimeConfig& runtime_config) {
     } else {
         spdlog::debug("[MoonrakerManager] Creating REAL client");
         m_client = std::make_unique<MoonrakerClient>();
+        if (auto record_path = helix::config::EnvironmentConfig::get_frame_record_path()) {
+            m_client->start_frame_recording(*record_path);
+        }
     }
 
     // Register with app_globals
@@ -283,6 +291,16 @@ void MoonrakerManager::configure_timeouts(Config* config) {
 
     spdlog::debug("[MoonrakerManager] Timeouts: connection={}ms, request={}ms, keepalive={}ms",
                   connection_timeout, request_timeout, keepalive_interval);
+
+    // Requests issued close together share one WebSocket frame
+    RequestBatchConfig batching;
+    batching.window_ms = static_cast<uint32_t>(
+        config->get<int>(config->df() + "moonraker_request_batch_window_ms", 0));
+    batching.max_batch = static_cast<size_t>(
+        std::max(1, config->get<int>(config->df() + "moonraker_request_batch_size", 16)));
+    batching.max_in_flight = static_cast<size_t>(
+        std::max(1, config->get<int>(config->df() + "moonraker_max_in_flight_requests", 32)));
+    m_client->configure_request_batching(batching);
 }
 
 void MoonrakerManager::register_callbacks() {
@@ -345,21 +363,27 @@ void MoonrakerManager::register_callbacks() {
             spdlog::trace("[MoonrakerManager] State change: {} -> {} (queueing)",
                           static_cast<int>(old_state), static_cast<int>(new_state));
 
-            std::lock_guard<std::mutex> lock(m_notification_mutex);
-            json state_change;
-            state_change["_connection_state"] = true;
-            state_change["old_state"] = static_cast<int>(old_state);
-            state_change["new_state"] = static_cast<int>(new_state);
-            m_notification_queue.push(state_change);
+            auto state_change = std::make_shared<json>();
+            (*state_change)["_connection_state"] = true;
+            (*state_change)["old_state"] = static_cast<int>(old_state);
+            (*state_change)["new_state"] = static_cast<int>(new_state);
+            {
+                std::lock_guard<std::mutex> lock(m_notification_mutex);
+                m_notification_queue.push({std::move(state_change), nullptr});
+            }
+            helix::ui::UpdateQueue::instance().wake();
         });
 
-    // Register notification callback to queue updates for main thread
-    m_client->register_notify_update([this, alive](json notification) {
+    // Register status frame callback to queue updates for main thread
+    m_client->register_status_frame_callback([this, alive](const SharedStatusFrame& frame) {
         if (!alive->load())
             return;
 
-        std::lock_guard<std::mutex> lock(m_notification_mutex);
-        m_notification_queue.push(notification);
+        {
+            std::lock_guard<std::mutex> lock(m_notification_mutex);
+            m_notification_queue.push({nullptr, frame});
+        }
+        helix::ui::UpdateQueue::instance().wake(); // process_notifications() runs on wake
     });
 }
 
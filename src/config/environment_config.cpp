@@ -105,6 +105,14 @@ bool EnvironmentConfig::get_benchmark_mode() {
     return exists("HELIX_BENCHMARK");
 }
 
+std::optional<std::string> EnvironmentConfig::get_frame_record_path() {
+    auto path = get_string("HELIX_RECORD_FRAMES");
+    if (!path || path->empty()) {
+        return std::nullopt;
+    }
+    return path;
+}
+
 std::optional<std::string> EnvironmentConfig::get_data_dir() {
     return get_string("HELIX_DATA_DIR");
 }
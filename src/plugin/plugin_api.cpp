@@ -80,6 +80,7 @@ MoonrakerSubscriptionId PluginAPI::subscribe_moonraker(const std::vector<std::st
             client_to_register = moonraker_client_;
             weak_alive = alive_flag_;
             active_moonraker_subscriptions_.push_back(id);
+            moonraker_objects_[id] = objects;
         } else {
             // Queue for later when Moonraker connects
             should_defer = true;
@@ -91,13 +92,14 @@ MoonrakerSubscriptionId PluginAPI::subscribe_moonraker(const std::vector<std::st
     if (client_to_register != nullptr) {
         // Subscribe immediately
         // Use weak_ptr to detect if plugin has been unloaded (prevents use-after-free)
-        uint64_t client_sub_id = client_to_register->register_notify_update(
-            [callback, objects, weak_alive](const json& update) {
+        uint64_t client_sub_id = client_to_register->register_notify_update_shared(
+            [callback, objects, weak_alive](const SharedJson& shared_update) {
                 // Check if plugin is still alive before processing
                 auto alive = weak_alive.lock();
                 if (!alive || !*alive) {
                     return; // Plugin has been unloaded, skip callback
                 }
+                const json& update = *shared_update;
 
                 // Filter update to only include objects we subscribed to
                 // The update is in format: { "object_name": { ... }, ... }
@@ -110,9 +112,9 @@ MoonrakerSubscriptionId PluginAPI::subscribe_moonraker(const std::vector<std::st
                 if (!filtered.empty()) {
                     // Marshal to main thread for LVGL safety
                     // Plugins don't need to worry about threading
-                    json filtered_copy = filtered; // Copy for capture
-                    helix::ui::queue_update(
-                        [callback, filtered_copy]() { callback(filtered_copy); });
+                    helix::ui::queue_update([callback, filtered = std::move(filtered)]() {
+                        callback(filtered);
+                    });
                 }
             });
 
@@ -121,6 +123,7 @@ MoonrakerSubscriptionId PluginAPI::subscribe_moonraker(const std::vector<std::st
             std::lock_guard<std::mutex> lock(mutex_);
             moonraker_id_map_[id] = client_sub_id;
         }
+        sync_status_fields(client_to_register);
 
         spdlog::debug("[plugin:{}] Moonraker subscription active (id={}, client_id={})",
                       plugin_id_copy, id, client_sub_id);
@@ -134,6 +137,7 @@ MoonrakerSubscriptionId PluginAPI::subscribe_moonraker(const std::vector<std::st
 bool PluginAPI::unsubscribe_moonraker(MoonrakerSubscriptionId id) {
     uint64_t client_sub_id = 0;
     MoonrakerClient* client = nullptr;
+    MoonrakerClient* status_client = nullptr;
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -156,6 +160,8 @@ bool PluginAPI::unsubscribe_moonraker(MoonrakerSubscriptionId id) {
 
         if (active_it != active_moonraker_subscriptions_.end()) {
             active_moonraker_subscriptions_.erase(active_it);
+            moonraker_objects_.erase(id);
+            status_client = moonraker_client_;
 
             // Look up the MoonrakerClient subscription ID for proper cleanup
             auto map_it = moonraker_id_map_.find(id);
@@ -170,6 +176,9 @@ bool PluginAPI::unsubscribe_moonraker(MoonrakerSubscriptionId id) {
     }
 
     // Call MoonrakerClient unsubscribe outside the lock
+    if (status_client != nullptr) {
+        sync_status_fields(status_client);
+    }
     if (client != nullptr && client_sub_id != 0) {
         client->unsubscribe_notify_update(client_sub_id);
         spdlog::debug("[plugin:{}] Moonraker subscription unsubscribed (id={}, client_id={})",
@@ -365,6 +374,7 @@ void PluginAPI::apply_deferred_subscriptions() {
         // Pre-register all IDs as active while we still hold the lock
         for (const auto& sub : subs_to_apply) {
             active_moonraker_subscriptions_.push_back(sub.id);
+            moonraker_objects_[sub.id] = sub.objects;
         }
     }
 
@@ -380,13 +390,14 @@ void PluginAPI::apply_deferred_subscriptions() {
         auto objects = sub.objects;
 
         // Use weak_ptr to detect if plugin has been unloaded (prevents use-after-free)
-        uint64_t client_sub_id = client_to_register->register_notify_update(
-            [callback, objects, weak_alive](const json& update) {
+        uint64_t client_sub_id = client_to_register->register_notify_update_shared(
+            [callback, objects, weak_alive](const SharedJson& shared_update) {
                 // Check if plugin is still alive before processing
                 auto alive = weak_alive.lock();
                 if (!alive || !*alive) {
                     return; // Plugin has been unloaded, skip callback
                 }
+                const json& update = *shared_update;
 
                 json filtered;
                 for (const auto& obj : objects) {
@@ -396,9 +407,9 @@ void PluginAPI::apply_deferred_subscriptions() {
                 }
                 if (!filtered.empty()) {
                     // Marshal to main thread for LVGL safety
-                    json filtered_copy = filtered;
-                    helix::ui::queue_update(
-                        [callback, filtered_copy]() { callback(filtered_copy); });
+                    helix::ui::queue_update([callback, filtered = std::move(filtered)]() {
+                        callback(filtered);
+                    });
                 }
             });
 
@@ -414,6 +425,26 @@ void PluginAPI::apply_deferred_subscriptions() {
             moonraker_id_map_[plugin_id] = client_id;
         }
     }
+    sync_status_fields(client_to_register);
+}
+
+void PluginAPI::sync_status_fields(MoonrakerClient* client) {
+    StatusFieldMap fields;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, objects] : moonraker_objects_) {
+            for (const auto& obj : objects) {
+                fields[obj] = {}; // Empty list requests every field of the object
+            }
+        }
+    }
+
+    // Outside the lock: the manager may re-send printer.objects.subscribe
+    if (fields.empty()) {
+        client->status_subscriptions().clear_owner(this);
+    } else {
+        client->status_subscriptions().set_owner_fields(this, std::move(fields));
+    }
 }
 
 void PluginAPI::cleanup() {
@@ -447,6 +478,7 @@ void PluginAPI::cleanup() {
         moonraker_id_map_.clear();
         deferred_subscriptions_.clear();
         active_moonraker_subscriptions_.clear();
+        moonraker_objects_.clear();
 
         // Unregister all services
         for (const auto& name : registered_services_) {
@@ -460,6 +492,9 @@ void PluginAPI::cleanup() {
     }
 
     // Unsubscribe from MoonrakerClient outside the lock
+    if (client != nullptr) {
+        client->status_subscriptions().clear_owner(this);
+    }
     if (client != nullptr && !client_sub_ids.empty()) {
         for (uint64_t client_id : client_sub_ids) {
             client->unsubscribe_notify_update(client_id);
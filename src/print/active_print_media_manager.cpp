@@ -21,6 +21,15 @@ using helix::gcode::resolve_gcode_filename;
 
 namespace helix {
 
+namespace {
+
+// queue_latest() keys for the print info subjects this manager publishes
+constexpr const char* DISPLAY_FILENAME_KEY = "print_media:display_filename";
+constexpr const char* LAYER_TOTAL_KEY = "print_media:layer_total";
+constexpr const char* THUMBNAIL_KEY = "print_media:thumbnail";
+
+} // namespace
+
 // Singleton storage
 static std::unique_ptr<ActivePrintMediaManager> g_instance;
 
@@ -130,9 +139,10 @@ void ActivePrintMediaManager::process_filename(const char* raw_filename) {
     // Thread-safe update to display filename subject (RAII via unique_ptr)
     // Capture printer_state_ reference to avoid using global in tests
     PrinterState* state = &printer_state_;
-    helix::ui::queue_update<std::string>(
-        std::make_unique<std::string>(display_name),
-        [state](std::string* name) { state->set_print_display_filename(*name); });
+    // Keyed: only the newest name matters if several arrive before the next drain
+    helix::ui::queue_latest(DISPLAY_FILENAME_KEY, [state, display_name]() {
+        state->set_print_display_filename(display_name);
+    });
 
     // Load thumbnail if filename changed
     if (!effective_filename.empty() && effective_filename != last_loaded_thumbnail_filename_) {
@@ -195,9 +205,9 @@ void ActivePrintMediaManager::load_thumbnail_for_file(const std::string& filenam
             if (metadata.layer_count > 0) {
                 int layer_count = static_cast<int>(metadata.layer_count);
                 PrinterState* state = &printer_state_;
-                helix::ui::queue_update<int>(
-                    std::make_unique<int>(layer_count),
-                    [state](int* count) { state->set_print_layer_total(*count); });
+                helix::ui::queue_latest(LAYER_TOTAL_KEY, [state, layer_count]() {
+                    state->set_print_layer_total(layer_count);
+                });
                 spdlog::debug("[ActivePrintMediaManager] Set total layers from metadata: {}",
                               metadata.layer_count);
             }
@@ -230,11 +240,10 @@ void ActivePrintMediaManager::load_thumbnail_for_file(const std::string& filenam
 
                     // Thread-safe update to thumbnail path subject (RAII via unique_ptr)
                     PrinterState* state = &printer_state_;
-                    helix::ui::queue_update<std::string>(
-                        std::make_unique<std::string>(lvgl_path), [state](std::string* path) {
-                            state->set_print_thumbnail_path(*path);
-                            spdlog::info("[ActivePrintMediaManager] Thumbnail path set: {}", *path);
-                        });
+                    helix::ui::queue_latest(THUMBNAIL_KEY, [state, lvgl_path]() {
+                        state->set_print_thumbnail_path(lvgl_path);
+                        spdlog::info("[ActivePrintMediaManager] Thumbnail path set: {}", lvgl_path);
+                    });
                 },
                 [](const std::string& error) {
                     spdlog::warn("[ActivePrintMediaManager] Failed to fetch thumbnail: {}", error);
@@ -255,8 +264,9 @@ void ActivePrintMediaManager::clear_print_info() {
 
     // Thread-safe clear of shared subjects (capture printer_state_ for testability)
     PrinterState* state = &printer_state_;
-    helix::ui::queue_update([state]() {
-        state->set_print_thumbnail_path("");
+    // Same keys as the setters, so a set still pending cannot land after the clear
+    helix::ui::queue_latest(THUMBNAIL_KEY, [state]() { state->set_print_thumbnail_path(""); });
+    helix::ui::queue_latest(DISPLAY_FILENAME_KEY, [state]() {
         state->set_print_display_filename("");
         spdlog::debug("[ActivePrintMediaManager] Cleared print info subjects");
     });
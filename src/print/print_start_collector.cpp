@@ -101,10 +101,12 @@ void PrintStartCollector::start() {
 
     // Register for printer status updates (fallback for printers with KAMP/custom macros)
     // This watches for _START_PRINT.print_started, START_PRINT.preparation_done, etc.
-    macro_subscription_id_ = client_.register_notify_update([self](const json& notification) {
+    macro_subscription_id_ = client_.register_notify_update_shared([self](const SharedJson& msg) {
         if (!self->active_.load())
             return;
 
+        const json& notification = *msg;
+
         if (!notification.contains("params") || !notification["params"].is_array() ||
             notification["params"].empty()) {
             return;
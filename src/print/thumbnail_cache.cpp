@@ -4,11 +4,11 @@
 #include "thumbnail_cache.h"
 
 #include "app_globals.h"
+#include "cache_dir_utils.h"
 #include "config.h"
 
 #include <spdlog/spdlog.h>
 
-#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
@@ -283,47 +283,10 @@ void ThumbnailCache::evict_if_needed() {
             current_size / (1024 * 1024), effective_limit / (1024 * 1024));
     }
 
-    // Collect files with their modification times
-    struct CacheEntry {
-        std::filesystem::path path;
-        std::filesystem::file_time_type mtime;
-        std::uintmax_t size; // Match std::filesystem::file_size() return type
-    };
-    std::vector<CacheEntry> entries;
-
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(cache_dir_)) {
-            if (std::filesystem::is_regular_file(entry.path())) {
-                entries.push_back({entry.path(), std::filesystem::last_write_time(entry.path()),
-                                   std::filesystem::file_size(entry.path())});
-            }
-        }
-    } catch (const std::filesystem::filesystem_error& e) {
-        spdlog::warn("[ThumbnailCache] Error scanning cache for eviction: {}", e.what());
-        return;
-    }
-
-    // Sort by modification time (oldest first)
-    std::sort(entries.begin(), entries.end(),
-              [](const CacheEntry& a, const CacheEntry& b) { return a.mtime < b.mtime; });
-
-    // Remove oldest files until under limit
-    size_t evicted_count = 0;
-    size_t evicted_bytes = 0;
-    for (const auto& entry : entries) {
-        if (current_size <= effective_limit) {
-            break;
-        }
-
-        try {
-            std::filesystem::remove(entry.path);
-            current_size -= entry.size;
-            evicted_bytes += entry.size;
-            ++evicted_count;
-        } catch (const std::filesystem::filesystem_error& e) {
-            spdlog::warn("[ThumbnailCache] Failed to evict {}: {}", entry.path.string(), e.what());
-        }
-    }
+    // Same LRU policy as the G-code caches: oldest mtime first
+    size_t evicted_count = helix::evict_least_recent_files(cache_dir_, effective_limit);
+    size_t remaining_size = get_cache_size();
+    size_t evicted_bytes = current_size > remaining_size ? current_size - remaining_size : 0;
 
     if (evicted_count > 0) {
         spdlog::info("[ThumbnailCache] Evicted {} files ({} KB) to stay under limit", evicted_count,
@@ -539,17 +502,7 @@ size_t ThumbnailCache::invalidate(const std::string& relative_path) {
 }
 
 size_t ThumbnailCache::get_cache_size() const {
-    size_t total = 0;
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(cache_dir_)) {
-            if (std::filesystem::is_regular_file(entry.path())) {
-                total += std::filesystem::file_size(entry.path());
-            }
-        }
-    } catch (const std::filesystem::filesystem_error& e) {
-        spdlog::warn("[ThumbnailCache] Error calculating cache size: {}", e.what());
-    }
-    return total;
+    return helix::cache_directory_size(cache_dir_);
 }
 
 // ============================================================================
@@ -606,7 +559,7 @@ std::string ThumbnailCache::get_if_optimized(const std::string& relative_path,
 void ThumbnailCache::fetch_optimized(MoonrakerAPI* api, const std::string& relative_path,
                                      const helix::ThumbnailTarget& target,
                                      SuccessCallback on_success, ErrorCallback on_error,
-                                     time_t source_modified) {
+                                     time_t source_modified, const std::string& cancel_key) {
     if (relative_path.empty()) {
         if (on_error) {
             on_error("Empty thumbnail path");
@@ -669,14 +622,19 @@ void ThumbnailCache::fetch_optimized(MoonrakerAPI* api, const std::string& relat
             std::string lvgl_path = to_lvgl_path(local_path);
             process_and_callback(lvgl_path, relative_path, target, on_success, on_error);
         },
-        // Error callback - download failed
+        // Error callback - download failed or was cancelled by its requester
         [on_error, relative_path](const MoonrakerError& error) {
-            spdlog::warn("[ThumbnailCache] Optimized fetch failed for {}: {}", relative_path,
-                         error.message);
+            if (error.type == MoonrakerErrorType::CANCELLED) {
+                spdlog::trace("[ThumbnailCache] Optimized fetch cancelled for {}", relative_path);
+            } else {
+                spdlog::warn("[ThumbnailCache] Optimized fetch failed for {}: {}", relative_path,
+                             error.message);
+            }
             if (on_error) {
                 on_error(error.message);
             }
-        });
+        },
+        helix::HttpPriority::VISIBLE, cancel_key);
 }
 
 void ThumbnailCache::process_and_callback(const std::string& png_lvgl_path,
@@ -767,7 +725,8 @@ void ThumbnailCache::fetch_for_detail_view(MoonrakerAPI* api, const std::string&
         on_error ? std::move(on_error) : [relative_path](const std::string& error) {
             spdlog::warn("[ThumbnailCache] Detail view fetch failed for {}: {}", relative_path,
                          error);
-        });
+        },
+        0, ctx.cancel_key);
 }
 
 void ThumbnailCache::fetch_for_card_view(MoonrakerAPI* api, const std::string& relative_path,
@@ -795,5 +754,5 @@ void ThumbnailCache::fetch_for_card_view(MoonrakerAPI* api, const std::string& r
                         spdlog::warn("[ThumbnailCache] Card view fetch failed for {}: {}",
                                      relative_path, error);
                     },
-                    source_modified);
+                    source_modified, ctx.cancel_key);
 }
@@ -50,12 +50,6 @@ static std::atomic<bool> s_shutdown_flag{false};
 // Polling interval for Spoolman weight updates (30 seconds)
 static constexpr uint32_t SPOOLMAN_POLL_INTERVAL_MS = 30000;
 
-struct AsyncSyncData {
-    int backend_index;
-    bool full_sync;
-    int slot_index; // Only used if full_sync == false
-};
-
 } // namespace
 
 AmsState& AmsState::instance() {
@@ -839,24 +833,23 @@ void AmsState::on_backend_event(int backend_index, const std::string& event,
     spdlog::trace("[AMS State] Received event '{}' data='{}' from backend {}", event, data,
                   backend_index);
 
-    // Use ui_queue_update to post updates to LVGL's main thread
+    // Use queue_latest to post updates to LVGL's main thread
     // This is required because backend events may come from background threads
-    // and LVGL is not thread-safe
-
-    // Helper to safely queue async call using RAII pattern
+    // and LVGL is not thread-safe. Syncs read the backend's current state, so
+    // bursts of events per backend (or per slot) collapse into one sync.
     auto queue_sync = [backend_index](bool full_sync, int slot_index) {
-        auto sync_data =
-            std::make_unique<AsyncSyncData>(AsyncSyncData{backend_index, full_sync, slot_index});
-        helix::ui::queue_update<AsyncSyncData>(std::move(sync_data), [](AsyncSyncData* d) {
+        std::string key = full_sync ? fmt::format("ams:sync:{}", backend_index)
+                                    : fmt::format("ams:slot:{}:{}", backend_index, slot_index);
+        helix::ui::queue_latest(key, [backend_index, full_sync, slot_index]() {
             // Skip if shutdown is in progress - AmsState singleton may be destroyed
             if (s_shutdown_flag.load(std::memory_order_acquire)) {
                 return;
             }
 
-            if (d->full_sync) {
-                AmsState::instance().sync_backend(d->backend_index);
+            if (full_sync) {
+                AmsState::instance().sync_backend(backend_index);
             } else {
-                AmsState::instance().update_slot_for_backend(d->backend_index, d->slot_index);
+                AmsState::instance().update_slot_for_backend(backend_index, slot_index);
             }
         });
     };
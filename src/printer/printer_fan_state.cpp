@@ -71,25 +71,28 @@ void PrinterFanState::deinit_subjects() {
 }
 
 void PrinterFanState::update_from_status(const nlohmann::json& status) {
+    StatusFrame typed;
+    StatusFrameDecoder::decode_typed(status, typed);
+    apply_status(typed, status);
+}
+
+void PrinterFanState::apply_status(const StatusFrame& typed, const nlohmann::json& untyped) {
     // Update main part-cooling fan speed
-    if (status.contains("fan")) {
-        const auto& fan = status["fan"];
-        spdlog::trace("[PrinterFanState] Received fan status update: {}", fan.dump());
-
-        if (fan.contains("speed") && fan["speed"].is_number()) {
-            int speed_pct = units::json_to_percent(fan, "speed");
-            spdlog::trace("[PrinterFanState] Fan speed update: {}%", speed_pct);
-            lv_subject_set_int(&fan_speed_, speed_pct);
-
-            // Also update multi-fan tracking
-            double speed = fan["speed"].get<double>();
-            update_fan_speed("fan", speed);
-        }
+    if (typed.fan.has(FanSample::SPEED)) {
+        int speed_pct = units::to_percent(typed.fan.speed);
+        spdlog::trace("[PrinterFanState] Fan speed update: {}%", speed_pct);
+        lv_subject_set_int(&fan_speed_, speed_pct);
+
+        // Also update multi-fan tracking
+        update_fan_speed("fan", typed.fan.speed);
     }
 
     // Check for other fan types in the status update
     // Moonraker sends fan objects as top-level keys: "heater_fan hotend_fan", "fan_generic xyz"
-    for (const auto& [key, value] : status.items()) {
+    if (!untyped.is_object()) {
+        return;
+    }
+    for (const auto& [key, value] : untyped.items()) {
         // Skip non-fan objects
         if (key.rfind("heater_fan ", 0) == 0 || key.rfind("fan_generic ", 0) == 0 ||
             key.rfind("controller_fan ", 0) == 0) {
@@ -59,23 +59,28 @@ void PrinterMotionState::deinit_subjects() {
 }
 
 void PrinterMotionState::update_from_status(const nlohmann::json& status) {
+    StatusFrame typed;
+    StatusFrameDecoder::decode_typed(status, typed);
+    apply_status(typed, status);
+}
+
+void PrinterMotionState::apply_status(const StatusFrame& typed, const nlohmann::json& untyped) {
     // Update toolhead position
-    if (status.contains("toolhead")) {
-        const auto& toolhead = status["toolhead"];
-
-        if (toolhead.contains("position") && toolhead["position"].is_array()) {
-            const auto& pos = toolhead["position"];
-            // Note: Klipper can send null position values before homing or during errors
-            // Store positions as centimillimeters (×100) for 0.01mm precision
-            if (pos.size() >= 3 && pos[0].is_number() && pos[1].is_number() && pos[2].is_number()) {
-                lv_subject_set_int(&position_x_, helix::units::to_centimm(pos[0].get<double>()));
-                lv_subject_set_int(&position_y_, helix::units::to_centimm(pos[1].get<double>()));
-                lv_subject_set_int(&position_z_, helix::units::to_centimm(pos[2].get<double>()));
-            }
-        }
+    // Note: Klipper can send null position values before homing or during errors; the
+    // decoder only marks a vector present when X, Y and Z are all numbers.
+    // Store positions as centimillimeters (x100) for 0.01mm precision
+    if (typed.toolhead.has(ToolheadSample::POSITION)) {
+        const auto& pos = typed.toolhead.position;
+        lv_subject_set_int(&position_x_, helix::units::to_centimm(pos[0]));
+        lv_subject_set_int(&position_y_, helix::units::to_centimm(pos[1]));
+        lv_subject_set_int(&position_z_, helix::units::to_centimm(pos[2]));
+    }
 
-        if (toolhead.contains("homed_axes") && toolhead["homed_axes"].is_string()) {
-            std::string axes = toolhead["homed_axes"].get<std::string>();
+    auto toolhead_it = untyped.find("toolhead");
+    if (toolhead_it != untyped.end() && toolhead_it->is_object()) {
+        auto axes_it = toolhead_it->find("homed_axes");
+        if (axes_it != toolhead_it->end() && axes_it->is_string()) {
+            std::string axes = axes_it->get<std::string>();
             lv_subject_copy_string(&homed_axes_, axes.c_str());
             // Note: Derived homing subjects (xy_homed, z_homed, all_homed) are now
             // panel-local in ControlsPanel, which observes this homed_axes string.
@@ -83,43 +88,31 @@ void PrinterMotionState::update_from_status(const nlohmann::json& status) {
     }
 
     // Update gcode_move data (commanded position, speed/flow factors, z-offset)
-    if (status.contains("gcode_move")) {
-        const auto& gcode_move = status["gcode_move"];
-
-        // Parse commanded position from gcode_move.gcode_position
-        // Note: gcode_move.position is raw commanded, gcode_move.gcode_position is effective
-        // (after offset adjustments). UI should display gcode_position to match Mainsail.
-        if (gcode_move.contains("gcode_position") && gcode_move["gcode_position"].is_array()) {
-            const auto& pos = gcode_move["gcode_position"];
-            if (pos.size() >= 3 && pos[0].is_number() && pos[1].is_number() && pos[2].is_number()) {
-                lv_subject_set_int(&gcode_position_x_,
-                                   helix::units::to_centimm(pos[0].get<double>()));
-                lv_subject_set_int(&gcode_position_y_,
-                                   helix::units::to_centimm(pos[1].get<double>()));
-                lv_subject_set_int(&gcode_position_z_,
-                                   helix::units::to_centimm(pos[2].get<double>()));
-            }
-        }
+    const GcodeMoveSample& gcode_move = typed.gcode_move;
+
+    // Parse commanded position from gcode_move.gcode_position
+    // Note: gcode_move.position is raw commanded, gcode_move.gcode_position is effective
+    // (after offset adjustments). UI should display gcode_position to match Mainsail.
+    if (gcode_move.has(GcodeMoveSample::GCODE_POSITION)) {
+        const auto& pos = gcode_move.gcode_position;
+        lv_subject_set_int(&gcode_position_x_, helix::units::to_centimm(pos[0]));
+        lv_subject_set_int(&gcode_position_y_, helix::units::to_centimm(pos[1]));
+        lv_subject_set_int(&gcode_position_z_, helix::units::to_centimm(pos[2]));
+    }
 
-        if (gcode_move.contains("speed_factor") && gcode_move["speed_factor"].is_number()) {
-            int factor_pct = helix::units::json_to_percent(gcode_move, "speed_factor");
-            lv_subject_set_int(&speed_factor_, factor_pct);
-        }
+    if (gcode_move.has(GcodeMoveSample::SPEED_FACTOR)) {
+        lv_subject_set_int(&speed_factor_, helix::units::to_percent(gcode_move.speed_factor));
+    }
 
-        if (gcode_move.contains("extrude_factor") && gcode_move["extrude_factor"].is_number()) {
-            int factor_pct = helix::units::json_to_percent(gcode_move, "extrude_factor");
-            lv_subject_set_int(&flow_factor_, factor_pct);
-        }
+    if (gcode_move.has(GcodeMoveSample::EXTRUDE_FACTOR)) {
+        lv_subject_set_int(&flow_factor_, helix::units::to_percent(gcode_move.extrude_factor));
+    }
 
-        // Parse Z-offset from homing_origin[2] (baby stepping / SET_GCODE_OFFSET Z=)
-        if (gcode_move.contains("homing_origin") && gcode_move["homing_origin"].is_array()) {
-            const auto& origin = gcode_move["homing_origin"];
-            if (origin.size() >= 3 && origin[2].is_number()) {
-                int z_microns = static_cast<int>(origin[2].get<double>() * 1000.0);
-                lv_subject_set_int(&gcode_z_offset_, z_microns);
-                spdlog::trace("[PrinterMotionState] G-code Z-offset: {}um", z_microns);
-            }
-        }
+    // Parse Z-offset from homing_origin[2] (baby stepping / SET_GCODE_OFFSET Z=)
+    if (gcode_move.has(GcodeMoveSample::HOMING_ORIGIN)) {
+        int z_microns = static_cast<int>(gcode_move.homing_origin[2] * 1000.0);
+        lv_subject_set_int(&gcode_z_offset_, z_microns);
+        spdlog::trace("[PrinterMotionState] G-code Z-offset: {}um", z_microns);
     }
 }
 
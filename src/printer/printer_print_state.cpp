@@ -46,6 +46,8 @@ void PrinterPrintState::init_subjects(bool register_xml) {
 
     // Print progress subjects
     INIT_SUBJECT_INT(print_progress, 0, subjects_, register_xml);
+    INIT_SUBJECT_INT(print_file_position_version, 0, subjects_, register_xml);
+    print_file_position_ = 0;
     INIT_SUBJECT_STRING(print_filename, "", subjects_, register_xml);
     INIT_SUBJECT_STRING(print_state, "standby", subjects_, register_xml);
     INIT_SUBJECT_INT(print_state_enum, static_cast<int>(PrintJobState::STANDBY), subjects_,
@@ -106,6 +108,11 @@ void PrinterPrintState::reset_for_new_print() {
     // Clearing filename triggers ActivePrintMediaManager to wipe the thumbnail we just set.
     // Filename is Moonraker's source of truth - it updates when the print actually starts.
     lv_subject_set_int(&print_progress_, 0);
+    if (print_file_position_ != 0) {
+        print_file_position_ = 0;
+        lv_subject_set_int(&print_file_position_version_,
+                           lv_subject_get_int(&print_file_position_version_) + 1);
+    }
     lv_subject_set_int(&print_layer_current_, 0);
     has_real_layer_data_ = false;
     slicer_progress_ = 0.0;
@@ -362,6 +369,17 @@ void PrinterPrintState::update_from_status(const nlohmann::json& status) {
     if (status.contains("virtual_sdcard")) {
         const auto& sdcard = status["virtual_sdcard"];
 
+        // Byte offset the print has read up to (drives the live layer view)
+        if (sdcard.contains("file_position") && sdcard["file_position"].is_number()) {
+            double position = std::max(sdcard["file_position"].get<double>(), 0.0);
+            auto bytes = static_cast<uint64_t>(position);
+            if (bytes != print_file_position_) {
+                print_file_position_ = bytes;
+                lv_subject_set_int(&print_file_position_version_,
+                                   lv_subject_get_int(&print_file_position_version_) + 1);
+            }
+        }
+
         if (sdcard.contains("progress") && sdcard["progress"].is_number()) {
             int file_progress_pct = helix::units::json_to_percent(sdcard, "progress");
 
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
 
 // ============================================================================
@@ -300,27 +301,170 @@ void PrinterState::update_from_notification(const json& notification) {
     }
 }
 
+void PrinterState::update_from_notification_shared(std::shared_ptr<const json> notification) {
+    if (!notification) {
+        return;
+    }
+
+    const json& n = *notification;
+    auto method_it = n.find("method");
+    if (method_it == n.end() || !method_it->is_string() ||
+        method_it->get_ref<const std::string&>() != "notify_status_update") {
+        return;
+    }
+
+    auto params_it = n.find("params");
+    if (params_it == n.end() || !params_it->is_array() || params_it->empty()) {
+        return;
+    }
+
+    // Same main-thread deferral as update_from_notification(), but the lambda holds
+    // the shared document rather than a copy of params[0]
+    helix::ui::queue_update([this, notification = std::move(notification)]() {
+        if (lvgl_is_rendering()) {
+            spdlog::error("[PrinterState] async status update running during render phase!");
+        }
+        update_from_status((*notification)["params"][0]);
+    });
+}
+
+void PrinterState::update_from_frame_shared(std::shared_ptr<const StatusFrame> frame) {
+    if (!frame) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_frames_mutex_);
+        bool merged = false;
+        if (merged_tail_) {
+            merged = merged_tail_->merge(*frame);
+        } else if (!pending_frames_.empty()) {
+            // First frame behind a pending one: merge into a copy, later ones merge in place
+            auto copy = std::make_shared<StatusFrame>(*pending_frames_.back());
+            if (copy->merge(*frame)) {
+                merged_tail_ = copy;
+                pending_frames_.back() = std::move(copy);
+                merged = true;
+            }
+        }
+        if (!merged) {
+            pending_frames_.push_back(std::move(frame));
+            merged_tail_.reset();
+        }
+    }
+
+    helix::ui::queue_latest("status", [this]() { apply_pending_frames(); });
+}
+
+void PrinterState::apply_pending_frames() {
+    std::vector<std::shared_ptr<const StatusFrame>> frames;
+    {
+        std::lock_guard<std::mutex> lock(pending_frames_mutex_);
+        frames.swap(pending_frames_);
+        merged_tail_.reset(); // Producers start a new batch from here
+    }
+
+    if (lvgl_is_rendering()) {
+        spdlog::error("[PrinterState] async status update running during render phase!");
+    }
+    for (const auto& frame : frames) {
+        update_from_frame(*frame);
+    }
+}
+
+void PrinterState::update_from_frame(const StatusFrame& frame) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    // Debug: Check if we're in render phase (this should never be true)
+    LV_DEBUG_RENDER_STATE();
+
+    // frame.other is null when every object in the frame was typed
+    static const json empty_status = json::object();
+    timed_apply_status(frame, frame.other.is_object() ? frame.other : empty_status);
+}
+
 void PrinterState::update_from_status(const json& state) {
+    // Typed fields are decoded once and shared by the temperature/motion/fan components
+    StatusFrame typed;
+    StatusFrameDecoder::decode_typed(state, typed);
+
     std::lock_guard<std::mutex> lock(state_mutex_);
 
     // Debug: Check if we're in render phase (this should never be true)
     LV_DEBUG_RENDER_STATE();
 
+    timed_apply_status(typed, state);
+}
+
+void PrinterState::set_status_dispatch_table(std::shared_ptr<const StatusDispatchTable> table) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    dispatch_table_ = std::move(table);
+}
+
+StatusDispatchStats PrinterState::take_status_dispatch_stats() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    StatusDispatchStats stats = dispatch_stats_;
+    dispatch_stats_ = {};
+    return stats;
+}
+
+StatusConsumerMask PrinterState::route_status(const StatusFrame& typed, const json& state) const {
+    if (!dispatch_table_) {
+        return ALL_STATUS_CONSUMERS;
+    }
+
+    StatusConsumerMask mask = StatusDispatchTable::classify_typed(typed.objects);
+    if (!state.is_object()) {
+        return mask;
+    }
+    for (auto it = state.begin(); it != state.end() && mask != ALL_STATUS_CONSUMERS; ++it) {
+        mask |= dispatch_table_->route(it.key());
+    }
+    return mask;
+}
+
+void PrinterState::timed_apply_status(const StatusFrame& typed, const json& state) {
+    auto start = std::chrono::steady_clock::now();
+
+    apply_status(typed, state);
+
+    auto elapsed_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             start)
+            .count());
+    dispatch_stats_.frames++;
+    dispatch_stats_.total_ns += elapsed_ns;
+    dispatch_stats_.max_ns = std::max(dispatch_stats_.max_ns, elapsed_ns);
+}
+
+void PrinterState::apply_status(const StatusFrame& typed, const json& state) {
+    // Only invoke the components that read at least one object in this update
+    const StatusConsumerMask route = route_status(typed, state);
+    auto wants = [route](StatusConsumer consumer) {
+        return (route & status_consumer_bit(consumer)) != 0;
+    };
+
     // Delegate temperature updates to temperature state component
-    temperature_state_.update_from_status(state);
+    if (wants(StatusConsumer::TEMPERATURE)) {
+        temperature_state_.apply_status(typed, state);
+    }
 
     // Delegate motion updates to motion state component
-    motion_state_.update_from_status(state);
+    if (wants(StatusConsumer::MOTION)) {
+        motion_state_.apply_status(typed, state);
+    }
 
     // Delegate print updates to print state component
-    print_domain_.update_from_status(state);
+    if (wants(StatusConsumer::PRINT)) {
+        print_domain_.update_from_status(state);
+    }
 
     // Note: Toolhead position, homed_axes, speed_factor, flow_factor, and gcode_z_offset
-    // are now updated by motion_state_.update_from_status() above
+    // are now updated by motion_state_.apply_status() above
 
     // Extract kinematics type (determines if bed moves on Z or gantry moves)
     // This is not part of motion_state_ as it affects printer_bed_moves_ subject
-    if (state.contains("toolhead")) {
+    if (wants(StatusConsumer::TOOLHEAD) && state.contains("toolhead")) {
         const auto& toolhead = state["toolhead"];
         if (toolhead.contains("kinematics") && toolhead["kinematics"].is_string()) {
             std::string kin = toolhead["kinematics"].get<std::string>();
@@ -335,21 +479,25 @@ void PrinterState::update_from_status(const json& state) {
     }
 
     // Delegate fan state updates to fan component
-    fan_state_.update_from_status(state);
+    if (wants(StatusConsumer::FAN)) {
+        fan_state_.apply_status(typed, state);
+    }
 
     // Delegate LED state updates to LED component
-    led_state_component_.update_from_status(state);
+    if (wants(StatusConsumer::LED)) {
+        led_state_component_.update_from_status(state);
+    }
 
     // Update LED controller per-strip color cache
     auto& led_ctrl = helix::led::LedController::instance();
-    if (led_ctrl.is_initialized()) {
+    if (wants(StatusConsumer::LED_CONTROLLER) && led_ctrl.is_initialized()) {
         led_ctrl.native().update_from_status(state);
         led_ctrl.effects().update_from_status(state);
         led_ctrl.output_pin().update_from_status(state);
     }
 
     // Update exclude_object state (for mid-print object exclusion)
-    if (state.contains("exclude_object")) {
+    if (wants(StatusConsumer::EXCLUDE_OBJECT) && state.contains("exclude_object")) {
         const auto& eo = state["exclude_object"];
 
         if (eo.contains("excluded_objects") && eo["excluded_objects"].is_array()) {
@@ -387,7 +535,7 @@ void PrinterState::update_from_status(const json& state) {
     }
 
     // Update klippy state from webhooks (for restart simulation)
-    if (state.contains("webhooks")) {
+    if (wants(StatusConsumer::WEBHOOKS) && state.contains("webhooks")) {
         const auto& webhooks = state["webhooks"];
         if (webhooks.contains("state") && webhooks["state"].is_string()) {
             std::string klippy_state_str = webhooks["state"].get<std::string>();
@@ -410,22 +558,38 @@ void PrinterState::update_from_status(const json& state) {
 
     // Delegate calibration updates (manual probe, motor state, firmware retraction)
     // to calibration_state_ component
-    calibration_state_.update_from_status(state);
+    if (wants(StatusConsumer::CALIBRATION)) {
+        calibration_state_.update_from_status(state);
+    }
 
     // Forward filament sensor updates to FilamentSensorManager
     // The manager handles all sensor types: filament_switch_sensor and filament_motion_sensor
-    helix::FilamentSensorManager::instance().update_from_status(state);
+    if (wants(StatusConsumer::FILAMENT_SENSORS)) {
+        helix::FilamentSensorManager::instance().update_from_status(state);
+    }
 
     // Forward updates to all other sensor managers
-    helix::sensors::HumiditySensorManager::instance().update_from_status(state);
-    helix::sensors::WidthSensorManager::instance().update_from_status(state);
-    helix::sensors::ProbeSensorManager::instance().update_from_status(state);
-    helix::sensors::AccelSensorManager::instance().update_from_status(state);
-    helix::sensors::ColorSensorManager::instance().update_from_status(state);
-    helix::sensors::TemperatureSensorManager::instance().update_from_status(state);
+    if (wants(StatusConsumer::HUMIDITY_SENSORS)) {
+        helix::sensors::HumiditySensorManager::instance().update_from_status(state);
+    }
+    if (wants(StatusConsumer::WIDTH_SENSORS)) {
+        helix::sensors::WidthSensorManager::instance().update_from_status(state);
+    }
+    if (wants(StatusConsumer::PROBE_SENSORS)) {
+        helix::sensors::ProbeSensorManager::instance().update_from_status(state);
+    }
+    if (wants(StatusConsumer::ACCEL_SENSORS)) {
+        helix::sensors::AccelSensorManager::instance().update_from_status(state);
+    }
+    if (wants(StatusConsumer::COLOR_SENSORS)) {
+        helix::sensors::ColorSensorManager::instance().update_from_status(state);
+    }
+    if (wants(StatusConsumer::TEMPERATURE_SENSORS)) {
+        helix::sensors::TemperatureSensorManager::instance().update_from_status(state);
+    }
 
     // Cache full state for complex queries
-    // (already under state_mutex_ from top of function)
+    // (caller holds state_mutex_)
     json_state_.merge_patch(state);
 }
 
@@ -235,57 +235,93 @@ const std::string& PrinterTemperatureState::active_extruder_name() const {
 }
 
 void PrinterTemperatureState::update_from_status(const nlohmann::json& status) {
+    StatusFrame typed;
+    StatusFrameDecoder::decode_typed(status, typed);
+    apply_status(typed, status);
+}
+
+namespace {
+
+/// Typed sample for a heater, falling back to the untyped JSON for other names
+bool find_heater(const StatusFrame& typed, const nlohmann::json& untyped, const std::string& name,
+                 HeaterSample& out) {
+    int index = StatusFrame::extruder_index(name);
+    if (index >= 0) {
+        if (!typed.has_extruder(static_cast<size_t>(index))) {
+            return false;
+        }
+        out = typed.extruders[static_cast<size_t>(index)];
+        return true;
+    }
+    if (name == "heater_bed") {
+        if (!typed.has(StatusFrame::HEATER_BED)) {
+            return false;
+        }
+        out = typed.heater_bed;
+        return true;
+    }
+    auto it = untyped.find(name);
+    if (it == untyped.end()) {
+        return false;
+    }
+    out = StatusFrameDecoder::decode_heater(*it);
+    return true;
+}
+
+} // namespace
+
+void PrinterTemperatureState::apply_status(const StatusFrame& typed,
+                                           const nlohmann::json& untyped) {
+    HeaterSample sample;
+
     // Update dynamic per-extruder subjects
     for (auto& [name, info] : extruders_) {
-        if (!status.contains(name))
+        if (!find_heater(typed, untyped, name, sample))
             continue;
-        const auto& data = status[name];
 
-        if (data.contains("temperature") && data["temperature"].is_number()) {
-            int temp_centi = helix::units::json_to_centidegrees(data, "temperature");
-            info.temperature = data["temperature"].get<float>();
-            lv_subject_set_int(info.temp_subject.get(), temp_centi);
+        if (sample.has(HeaterSample::TEMPERATURE)) {
+            info.temperature = static_cast<float>(sample.temperature);
+            lv_subject_set_int(info.temp_subject.get(),
+                               helix::units::to_centidegrees(sample.temperature));
             // Force notify for graph updates even when value unchanged
             lv_subject_notify(info.temp_subject.get());
         }
 
-        if (data.contains("target") && data["target"].is_number()) {
-            int target_centi = helix::units::json_to_centidegrees(data, "target");
-            info.target = data["target"].get<float>();
-            lv_subject_set_int(info.target_subject.get(), target_centi);
+        if (sample.has(HeaterSample::TARGET)) {
+            info.target = static_cast<float>(sample.target);
+            lv_subject_set_int(info.target_subject.get(),
+                               helix::units::to_centidegrees(sample.target));
         }
     }
 
     // Update active extruder subjects from the currently active extruder's data
-    if (status.contains(active_extruder_name_)) {
-        const auto& active = status[active_extruder_name_];
-
-        if (active.contains("temperature") && active["temperature"].is_number()) {
-            int temp_centi = helix::units::json_to_centidegrees(active, "temperature");
-            lv_subject_set_int(&active_extruder_temp_, temp_centi);
+    if (find_heater(typed, untyped, active_extruder_name_, sample)) {
+        if (sample.has(HeaterSample::TEMPERATURE)) {
+            lv_subject_set_int(&active_extruder_temp_,
+                               helix::units::to_centidegrees(sample.temperature));
             lv_subject_notify(&active_extruder_temp_);
         }
 
-        if (active.contains("target") && active["target"].is_number()) {
-            int target_centi = helix::units::json_to_centidegrees(active, "target");
-            lv_subject_set_int(&active_extruder_target_, target_centi);
+        if (sample.has(HeaterSample::TARGET)) {
+            lv_subject_set_int(&active_extruder_target_,
+                               helix::units::to_centidegrees(sample.target));
         }
     }
 
     // Update bed temperature (stored as centidegrees for 0.1C resolution)
-    if (status.contains("heater_bed")) {
-        const auto& bed = status["heater_bed"];
+    if (typed.has(StatusFrame::HEATER_BED)) {
+        const HeaterSample& bed = typed.heater_bed;
 
-        if (bed.contains("temperature") && bed["temperature"].is_number()) {
-            int temp_centi = helix::units::json_to_centidegrees(bed, "temperature");
+        if (bed.has(HeaterSample::TEMPERATURE)) {
+            int temp_centi = helix::units::to_centidegrees(bed.temperature);
             lv_subject_set_int(&bed_temp_, temp_centi);
             lv_subject_notify(&bed_temp_); // Force notify for graph updates even if unchanged
             spdlog::trace("[PrinterTemperatureState] Bed temp: {}.{}C", temp_centi / 10,
                           temp_centi % 10);
         }
 
-        if (bed.contains("target") && bed["target"].is_number()) {
-            int target_centi = helix::units::json_to_centidegrees(bed, "target");
+        if (bed.has(HeaterSample::TARGET)) {
+            int target_centi = helix::units::to_centidegrees(bed.target);
             lv_subject_set_int(&bed_target_, target_centi);
             spdlog::trace("[PrinterTemperatureState] Bed target: {}.{}C", target_centi / 10,
                           target_centi % 10);
@@ -294,27 +330,25 @@ void PrinterTemperatureState::update_from_status(const nlohmann::json& status) {
 
     // Update chamber temperature from heater or sensor
     // Prefer heater (has both temp + target), fall back to sensor (temp only)
-    if (!chamber_heater_name_.empty() && status.contains(chamber_heater_name_)) {
-        const auto& chamber = status[chamber_heater_name_];
-
-        if (chamber.contains("temperature") && chamber["temperature"].is_number()) {
-            int temp_centi = helix::units::json_to_centidegrees(chamber, "temperature");
+    if (!chamber_heater_name_.empty() &&
+        find_heater(typed, untyped, chamber_heater_name_, sample)) {
+        if (sample.has(HeaterSample::TEMPERATURE)) {
+            int temp_centi = helix::units::to_centidegrees(sample.temperature);
             lv_subject_set_int(&chamber_temp_, temp_centi);
             spdlog::trace("[PrinterTemperatureState] Chamber temp (heater): {}.{}C",
                           temp_centi / 10, temp_centi % 10);
         }
 
-        if (chamber.contains("target") && chamber["target"].is_number()) {
-            int target_centi = helix::units::json_to_centidegrees(chamber, "target");
+        if (sample.has(HeaterSample::TARGET)) {
+            int target_centi = helix::units::to_centidegrees(sample.target);
             lv_subject_set_int(&chamber_target_, target_centi);
             spdlog::trace("[PrinterTemperatureState] Chamber target: {}.{}C", target_centi / 10,
                           target_centi % 10);
         }
-    } else if (!chamber_sensor_name_.empty() && status.contains(chamber_sensor_name_)) {
-        const auto& chamber = status[chamber_sensor_name_];
-
-        if (chamber.contains("temperature") && chamber["temperature"].is_number()) {
-            int temp_centi = helix::units::json_to_centidegrees(chamber, "temperature");
+    } else if (!chamber_sensor_name_.empty() &&
+               find_heater(typed, untyped, chamber_sensor_name_, sample)) {
+        if (sample.has(HeaterSample::TEMPERATURE)) {
+            int temp_centi = helix::units::to_centidegrees(sample.temperature);
             lv_subject_set_int(&chamber_temp_, temp_centi);
             spdlog::trace("[PrinterTemperatureState] Chamber temp (sensor): {}.{}C",
                           temp_centi / 10, temp_centi % 10);
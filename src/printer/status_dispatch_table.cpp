@@ -0,0 +1,168 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "status_dispatch_table.h"
+
+#include "moonraker_status_decoder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <limits>
+
+namespace helix {
+
+namespace {
+
+constexpr StatusConsumerMask bit(StatusConsumer consumer) {
+    return status_consumer_bit(consumer);
+}
+
+bool starts_with(const std::string& name, const char* prefix) {
+    return name.rfind(prefix, 0) == 0;
+}
+
+} // namespace
+
+StatusDispatchTable::StatusDispatchTable(const std::vector<std::string>& objects) {
+    names_.reserve(objects.size());
+    consumers_.reserve(objects.size());
+    handles_.reserve(objects.size());
+
+    for (const auto& name : objects) {
+        if (names_.size() >= std::numeric_limits<Handle>::max()) {
+            spdlog::warn("[StatusDispatchTable] Too many objects, routing the rest by name");
+            break;
+        }
+        auto handle = static_cast<Handle>(names_.size());
+        if (!handles_.emplace(name, handle).second) {
+            continue;
+        }
+        names_.push_back(name);
+        consumers_.push_back(classify(name));
+    }
+
+    spdlog::debug("[StatusDispatchTable] Built dispatch table for {} objects", names_.size());
+}
+
+StatusDispatchTable::Handle StatusDispatchTable::handle_of(const std::string& object_name) const {
+    auto it = handles_.find(object_name);
+    return it != handles_.end() ? it->second : INVALID_HANDLE;
+}
+
+StatusConsumerMask StatusDispatchTable::route(const std::string& object_name) const {
+    auto it = handles_.find(object_name);
+    if (it != handles_.end()) {
+        return consumers_[it->second];
+    }
+    return classify(object_name);
+}
+
+StatusConsumerMask StatusDispatchTable::classify(const std::string& name) {
+    // Core objects (exact names)
+    if (name == "toolhead") {
+        // position (motion), kinematics/extruder (toolhead), homed_axes (motion, calibration)
+        return bit(StatusConsumer::MOTION) | bit(StatusConsumer::TOOLHEAD) |
+               bit(StatusConsumer::CALIBRATION);
+    }
+    if (name == "gcode_move") {
+        return bit(StatusConsumer::MOTION);
+    }
+    if (name == "print_stats" || name == "virtual_sdcard" || name == "display_status") {
+        return bit(StatusConsumer::PRINT);
+    }
+    if (name == "heater_bed" || StatusFrame::extruder_index(name) >= 0) {
+        return bit(StatusConsumer::TEMPERATURE);
+    }
+    if (name == "fan") {
+        return bit(StatusConsumer::FAN);
+    }
+    if (name == "exclude_object") {
+        return bit(StatusConsumer::EXCLUDE_OBJECT);
+    }
+    if (name == "webhooks") {
+        return bit(StatusConsumer::WEBHOOKS);
+    }
+    if (name == "manual_probe" || name == "stepper_enable" || name == "firmware_retraction") {
+        return bit(StatusConsumer::CALIBRATION);
+    }
+
+    // Objects consumed outside PrinterState (MoonrakerClient, ToolState, AMS backends,
+    // PrintStartCollector) or not at all
+    if (name == "bed_mesh" || name == "system_stats" || name == "idle_timeout" ||
+        name == "motion_report" || name == "toolchanger" || name == "mmu" ||
+        starts_with(name, "tool ") || starts_with(name, "AFC") ||
+        starts_with(name, "gcode_macro ")) {
+        return 0;
+    }
+
+    // Heaters and temperature sensors (chamber heater/sensor may be any of these)
+    if (starts_with(name, "heater_generic ")) {
+        return bit(StatusConsumer::TEMPERATURE);
+    }
+    if (starts_with(name, "temperature_sensor ") || starts_with(name, "temperature_fan ")) {
+        return bit(StatusConsumer::TEMPERATURE) | bit(StatusConsumer::TEMPERATURE_SENSORS);
+    }
+
+    // Secondary fans
+    if (starts_with(name, "heater_fan ") || starts_with(name, "fan_generic ") ||
+        starts_with(name, "controller_fan ")) {
+        return bit(StatusConsumer::FAN);
+    }
+
+    // LEDs - led_effect must be checked before "led "
+    if (starts_with(name, "led_effect ")) {
+        return bit(StatusConsumer::LED_CONTROLLER);
+    }
+    if (name == "neopixel" || name == "dotstar" || starts_with(name, "neopixel ") ||
+        starts_with(name, "dotstar ") || starts_with(name, "led ") ||
+        starts_with(name, "pca9533 ") || starts_with(name, "pca9632 ") ||
+        starts_with(name, "output_pin ")) {
+        return bit(StatusConsumer::LED) | bit(StatusConsumer::LED_CONTROLLER);
+    }
+
+    // Sensor managers
+    if (starts_with(name, "filament_switch_sensor ") ||
+        starts_with(name, "filament_motion_sensor ")) {
+        return bit(StatusConsumer::FILAMENT_SENSORS);
+    }
+    if (starts_with(name, "bme280 ") || starts_with(name, "htu21d ")) {
+        return bit(StatusConsumer::HUMIDITY_SENSORS);
+    }
+    if (name == "hall_filament_width_sensor" || name == "tsl1401cl_filament_width_sensor") {
+        return bit(StatusConsumer::WIDTH_SENSORS);
+    }
+    if (name == "probe" || name == "bltouch" || name == "smart_effector" ||
+        name == "cartographer" || name == "beacon" || starts_with(name, "probe_eddy_current ")) {
+        return bit(StatusConsumer::PROBE_SENSORS);
+    }
+    if (starts_with(name, "adxl345") || starts_with(name, "lis2dw") ||
+        starts_with(name, "lis3dh") || starts_with(name, "mpu9250") ||
+        starts_with(name, "icm20948")) {
+        return bit(StatusConsumer::ACCEL_SENSORS);
+    }
+    if (starts_with(name, "td1_sensor")) {
+        return bit(StatusConsumer::COLOR_SENSORS);
+    }
+
+    return ALL_STATUS_CONSUMERS;
+}
+
+StatusConsumerMask StatusDispatchTable::classify_typed(uint16_t objects) {
+    StatusConsumerMask mask = 0;
+    if (objects & (StatusFrame::EXTRUDER | StatusFrame::HEATER_BED)) {
+        mask |= bit(StatusConsumer::TEMPERATURE);
+    }
+    // Untyped toolhead fields (homed_axes, kinematics, extruder) arrive as their own key
+    if (objects & (StatusFrame::TOOLHEAD | StatusFrame::GCODE_MOVE)) {
+        mask |= bit(StatusConsumer::MOTION);
+    }
+    if (objects & (StatusFrame::PRINT_STATS | StatusFrame::VIRTUAL_SDCARD)) {
+        mask |= bit(StatusConsumer::PRINT);
+    }
+    if (objects & StatusFrame::FAN) {
+        mask |= bit(StatusConsumer::FAN);
+    }
+    return mask;
+}
+
+} // namespace helix
@@ -16,6 +16,33 @@
 namespace helix {
 namespace mesh {
 
+namespace {
+
+/// Place the upsampled surface on the same world-space grid as the mesh quads
+void place_mesh_surface(bed_mesh_renderer_t* renderer) {
+    double x_first, x_last, y_first, y_last;
+    if (renderer->geometry_computed) {
+        x_first = printer_x_to_world_x(renderer->mesh_area_min_x, renderer->bed_center_x,
+                                       renderer->coord_scale);
+        x_last = printer_x_to_world_x(renderer->mesh_area_max_x, renderer->bed_center_x,
+                                      renderer->coord_scale);
+        y_first = printer_y_to_world_y(renderer->mesh_area_min_y, renderer->bed_center_y,
+                                       renderer->coord_scale);
+        y_last = printer_y_to_world_y(renderer->mesh_area_max_y, renderer->bed_center_y,
+                                      renderer->coord_scale);
+    } else {
+        x_first = mesh_col_to_world_x(0, renderer->cols, BED_MESH_SCALE);
+        x_last = mesh_col_to_world_x(renderer->cols - 1, renderer->cols, BED_MESH_SCALE);
+        y_first = mesh_row_to_world_y(0, renderer->rows, BED_MESH_SCALE);
+        y_last = mesh_row_to_world_y(renderer->rows - 1, renderer->rows, BED_MESH_SCALE);
+    }
+    renderer->surface.place(x_first, x_last, y_first, y_last, renderer->cached_z_center,
+                            renderer->view_state.z_scale, renderer->color_min_z,
+                            renderer->color_max_z);
+}
+
+} // namespace
+
 void generate_mesh_quads(bed_mesh_renderer_t* renderer) {
     if (!renderer || !renderer->has_mesh_data) {
         return;
@@ -158,6 +185,7 @@ void generate_mesh_quads(bed_mesh_renderer_t* renderer) {
     }
 
     size_t mesh_quad_count = renderer->quads.size();
+    place_mesh_surface(renderer);
 
     // DEBUG: Log quad generation with z_scale used
     spdlog::debug("[QUAD_GEN] Generated {} mesh quads, z_scale={:.2f}, z_center={:.4f}",
@@ -9,6 +9,8 @@
  * - Solid color fills using batched rectangle draws
  * - Gradient fills with adaptive segment counts
  * - Per-vertex color interpolation
+ * - SpanRasterizer: fixed-point edge walking into an ARGB8888 buffer with a
+ *   16-bit depth buffer
  */
 
 #include "bed_mesh_rasterizer.h"
@@ -16,6 +18,7 @@
 #include "bed_mesh_gradient.h"
 
 #include <algorithm>
+#include <cmath>
 
 namespace {
 
@@ -102,6 +105,90 @@ inline void interpolate_edge(int y, int y0, int x0, const bed_mesh_rgb_t& c0, in
     }
 }
 
+// ========== SpanRasterizer helpers ==========
+
+/// Fractional bits for edge X and color channels
+constexpr int FIXED_SHIFT = 16;
+constexpr int64_t FIXED_ONE = int64_t{1} << FIXED_SHIFT;
+
+/// Fractional bits for depth (16-bit depth << 8 still fits int32)
+constexpr int DEPTH_SHIFT = 8;
+
+/// Triangle edge walked one scanline at a time in 16.16 fixed point
+struct FixedEdge {
+    int64_t x;
+    int64_t step;
+
+    /// Start at row @p y; vertices must be ordered by Y (top first)
+    FixedEdge(const helix::mesh::RasterVertex& top, const helix::mesh::RasterVertex& bottom,
+              int y) {
+        int dy = bottom.y - top.y;
+        step = dy > 0 ? (static_cast<int64_t>(bottom.x - top.x) * FIXED_ONE) / dy : 0;
+        x = static_cast<int64_t>(top.x) * FIXED_ONE + step * (y - top.y);
+    }
+};
+
+/// First pixel center at or right of a fixed-point X
+inline int fixed_ceil(int64_t x) {
+    return static_cast<int>((x + FIXED_ONE - 1) >> FIXED_SHIFT);
+}
+
+/// Screen-space gradient of one vertex attribute over a triangle
+struct AttributePlane {
+    float value_at_a;
+    float ddx;
+    float ddy;
+
+    AttributePlane(const helix::mesh::RasterVertex& a, const helix::mesh::RasterVertex& b,
+                   const helix::mesh::RasterVertex& c, float va, float vb, float vc,
+                   float inv_area2) {
+        value_at_a = va;
+        ddx = ((vb - va) * static_cast<float>(c.y - a.y) -
+               (vc - va) * static_cast<float>(b.y - a.y)) *
+              inv_area2;
+        ddy = ((vc - va) * static_cast<float>(b.x - a.x) -
+               (vb - va) * static_cast<float>(c.x - a.x)) *
+              inv_area2;
+    }
+
+    float at(const helix::mesh::RasterVertex& a, int x, int y) const {
+        return value_at_a + ddx * static_cast<float>(x - a.x) + ddy * static_cast<float>(y - a.y);
+    }
+};
+
+/**
+ * Fixed-point start value and per-pixel step of an attribute across a span
+ *
+ * Both ends are clamped to [0, max_value] and the step derived from them, so
+ * rounding can never push a pixel out of range (the attribute is linear).
+ */
+inline void span_attribute(const AttributePlane& plane, const helix::mesh::RasterVertex& a,
+                           int x_start, int x_last, int y, float max_value, int shift,
+                           int32_t* out_start, int32_t* out_step) {
+    float scale = static_cast<float>(1 << shift);
+    float v0 = std::clamp(plane.at(a, x_start, y), 0.0f, max_value);
+    float v1 = std::clamp(plane.at(a, x_last, y), 0.0f, max_value);
+    *out_start = static_cast<int32_t>(std::lround(v0 * scale));
+    int32_t end = static_cast<int32_t>(std::lround(v1 * scale));
+    *out_step = x_last > x_start ? (end - *out_start) / (x_last - x_start) : 0;
+}
+
+inline uint32_t pack_argb(uint32_t a, uint32_t r, uint32_t g, uint32_t b) {
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+/// Straight-alpha "source over" blend of a translucent color onto an ARGB8888 pixel
+inline uint32_t blend_over(uint32_t dst, uint32_t r, uint32_t g, uint32_t b, uint32_t alpha) {
+    uint32_t dst_a = dst >> 24;
+    uint32_t dst_weight = dst_a * (255 - alpha) / 255;
+    uint32_t out_a = alpha + dst_weight;
+    auto channel = [&](uint32_t src, int shift) {
+        uint32_t d = (dst >> shift) & 0xFF;
+        return (src * alpha + d * dst_weight) / out_a;
+    };
+    return pack_argb(out_a, channel(r, 16), channel(g, 8), channel(b, 0));
+}
+
 } // anonymous namespace
 
 namespace helix {
@@ -252,5 +339,145 @@ void fill_triangle_gradient(lv_layer_t* layer, int x1, int y1, lv_color_t c1, in
     }
 }
 
+// ========== SpanRasterizer ==========
+
+uint16_t quantize_depth(double depth, double near_depth, double far_depth) {
+    if (!(far_depth > near_depth)) {
+        return 0;
+    }
+    double t = std::clamp((depth - near_depth) / (far_depth - near_depth), 0.0, 1.0);
+    return static_cast<uint16_t>(std::lround(t * (RASTER_DEPTH_FAR - 1)));
+}
+
+void SpanRasterizer::begin(uint8_t* pixels, int width, int height, int stride,
+                           const lv_area_t& clip) {
+    pixels_ = pixels;
+    width_ = width;
+    height_ = height;
+    stride_ = stride;
+    pixels_drawn_ = 0;
+
+    clip_.x1 = std::max<int32_t>(clip.x1, 0);
+    clip_.y1 = std::max<int32_t>(clip.y1, 0);
+    clip_.x2 = std::min<int32_t>(clip.x2, width - 1);
+    clip_.y2 = std::min<int32_t>(clip.y2, height - 1);
+
+    size_t depth_size = static_cast<size_t>(std::max(width, 0)) * std::max(height, 0);
+    if (depth_.size() != depth_size) {
+        depth_.assign(depth_size, RASTER_DEPTH_FAR);
+    }
+    if (!pixels_ || clip_.x1 > clip_.x2 || clip_.y1 > clip_.y2) {
+        return;
+    }
+
+    size_t span = static_cast<size_t>(clip_.x2 - clip_.x1 + 1);
+    for (int y = clip_.y1; y <= clip_.y2; y++) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(pixels_ + static_cast<size_t>(y) * stride_);
+        std::fill_n(row + clip_.x1, span, 0u);
+        std::fill_n(&depth_[static_cast<size_t>(y) * width_ + clip_.x1], span, RASTER_DEPTH_FAR);
+    }
+}
+
+void SpanRasterizer::fill_triangle(const RasterVertex& a, const RasterVertex& b,
+                                   const RasterVertex& c, lv_opa_t opacity) {
+    if (!pixels_ || opacity == LV_OPA_TRANSP || clip_.x1 > clip_.x2 || clip_.y1 > clip_.y2) {
+        return;
+    }
+
+    int64_t area2 = static_cast<int64_t>(b.x - a.x) * (c.y - a.y) -
+                    static_cast<int64_t>(c.x - a.x) * (b.y - a.y);
+    if (area2 == 0) {
+        return; // Degenerate (also covers a.y == b.y == c.y)
+    }
+
+    // Sort by Y for edge walking
+    const RasterVertex* v[3] = {&a, &b, &c};
+    if (v[0]->y > v[1]->y)
+        std::swap(v[0], v[1]);
+    if (v[1]->y > v[2]->y)
+        std::swap(v[1], v[2]);
+    if (v[0]->y > v[1]->y)
+        std::swap(v[0], v[1]);
+    const RasterVertex& top = *v[0];
+    const RasterVertex& mid = *v[1];
+    const RasterVertex& bottom = *v[2];
+
+    // Rows [top.y, bottom.y): the bottom row belongs to the triangle below
+    int y_start = std::max<int>(top.y, clip_.y1);
+    int y_end = std::min<int>(bottom.y, clip_.y2 + 1);
+    if (y_start >= y_end) {
+        return;
+    }
+
+    float inv_area2 = 1.0f / static_cast<float>(area2);
+    AttributePlane red(a, b, c, a.color.red, b.color.red, c.color.red, inv_area2);
+    AttributePlane green(a, b, c, a.color.green, b.color.green, c.color.green, inv_area2);
+    AttributePlane blue(a, b, c, a.color.blue, b.color.blue, c.color.blue, inv_area2);
+    AttributePlane depth(a, b, c, a.depth, b.depth, c.depth, inv_area2);
+
+    FixedEdge long_edge(top, bottom, y_start);
+    FixedEdge upper_edge(top, mid, y_start);
+    FixedEdge lower_edge(mid, bottom, std::max(y_start, static_cast<int>(mid.y)));
+    const bool opaque = opacity == LV_OPA_COVER;
+
+    for (int y = y_start; y < y_end; y++) {
+        FixedEdge& short_edge = (y < mid.y) ? upper_edge : lower_edge;
+        int64_t left = std::min(long_edge.x, short_edge.x);
+        int64_t right = std::max(long_edge.x, short_edge.x);
+        long_edge.x += long_edge.step;
+        short_edge.x += short_edge.step;
+
+        // Columns [ceil(left), ceil(right)): left edges are drawn, right edges are not
+        int x_start = std::max<int>(fixed_ceil(left), clip_.x1);
+        int x_end = std::min<int>(fixed_ceil(right), clip_.x2 + 1);
+        if (x_start >= x_end) {
+            continue;
+        }
+
+        int32_t r, g, bl, z, dr, dg, db, dz;
+        span_attribute(red, a, x_start, x_end - 1, y, 255.0f, FIXED_SHIFT, &r, &dr);
+        span_attribute(green, a, x_start, x_end - 1, y, 255.0f, FIXED_SHIFT, &g, &dg);
+        span_attribute(blue, a, x_start, x_end - 1, y, 255.0f, FIXED_SHIFT, &bl, &db);
+        span_attribute(depth, a, x_start, x_end - 1, y, RASTER_DEPTH_FAR - 1, DEPTH_SHIFT, &z,
+                       &dz);
+
+        uint32_t* row = reinterpret_cast<uint32_t*>(pixels_ + static_cast<size_t>(y) * stride_);
+        uint16_t* depth_row = &depth_[static_cast<size_t>(y) * width_];
+        size_t drawn = 0;
+
+        if (opaque) {
+            // Branch-free select so the loop vectorizes
+            for (int x = x_start; x < x_end; x++) {
+                uint16_t pixel_depth = static_cast<uint16_t>(z >> DEPTH_SHIFT);
+                uint32_t color = pack_argb(0xFF, static_cast<uint32_t>(r >> FIXED_SHIFT),
+                                           static_cast<uint32_t>(g >> FIXED_SHIFT),
+                                           static_cast<uint32_t>(bl >> FIXED_SHIFT));
+                bool nearer = pixel_depth < depth_row[x];
+                depth_row[x] = nearer ? pixel_depth : depth_row[x];
+                row[x] = nearer ? color : row[x];
+                drawn += nearer;
+                r += dr;
+                g += dg;
+                bl += db;
+                z += dz;
+            }
+        } else {
+            for (int x = x_start; x < x_end; x++) {
+                if (static_cast<uint16_t>(z >> DEPTH_SHIFT) < depth_row[x]) {
+                    row[x] = blend_over(row[x], static_cast<uint32_t>(r >> FIXED_SHIFT),
+                                        static_cast<uint32_t>(g >> FIXED_SHIFT),
+                                        static_cast<uint32_t>(bl >> FIXED_SHIFT), opacity);
+                    drawn++;
+                }
+                r += dr;
+                g += dg;
+                bl += db;
+                z += dz;
+            }
+        }
+        pixels_drawn_ += drawn;
+    }
+}
+
 } // namespace mesh
 } // namespace helix
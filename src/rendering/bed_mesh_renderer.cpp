@@ -12,6 +12,7 @@
 #include "bed_mesh_overlays.h"
 #include "bed_mesh_projection.h"
 #include "bed_mesh_rasterizer.h"
+#include "bed_mesh_surface.h"
 #include "memory_monitor.h"
 #include "theme_manager.h"
 
@@ -25,6 +26,7 @@ using namespace helix;
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -53,7 +55,7 @@ static void update_trig_cache(bed_mesh_view_state_t* view_state);
 static void project_and_cache_vertices(bed_mesh_renderer_t* renderer, int canvas_width,
                                        int canvas_height);
 static void project_and_cache_quads(bed_mesh_renderer_t* renderer, int canvas_width,
-                                    int canvas_height);
+                                    int canvas_height, bool translucent_only = false);
 static void compute_projected_mesh_bounds(const bed_mesh_renderer_t* renderer, int* out_min_x,
                                           int* out_max_x, int* out_min_y, int* out_max_y);
 static void compute_centering_offset(int mesh_min_x, int mesh_max_x, int mesh_min_y, int mesh_max_y,
@@ -67,6 +69,10 @@ static void prepare_render_frame(bed_mesh_renderer_t* renderer, int canvas_width
                                  int layer_offset_x, int layer_offset_y);
 static void render_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer, int canvas_width,
                                 int canvas_height);
+static bool ensure_surface_buffer(bed_mesh_renderer_t* renderer, int canvas_width,
+                                  int canvas_height);
+static bool rasterize_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer,
+                                   int canvas_width, int canvas_height);
 static void render_decorations(lv_layer_t* layer, bed_mesh_renderer_t* renderer, int canvas_width,
                                int canvas_height);
 
@@ -156,6 +162,9 @@ void bed_mesh_renderer_destroy(bed_mesh_renderer_t* renderer) {
     }
 
     spdlog::debug("[Bed Mesh Renderer] Destroying bed mesh renderer");
+    if (renderer->surface_buf && lv_is_initialized()) {
+        lv_draw_buf_destroy(renderer->surface_buf);
+    }
     delete renderer;
 }
 
@@ -189,6 +198,9 @@ bool bed_mesh_renderer_set_mesh_data(bed_mesh_renderer_t* renderer, const float*
     renderer->has_mesh_data = true;
     helix::MemoryMonitor::log_now("bed_mesh_data_set");
 
+    // Resample the surface once per mesh; generate_mesh_quads() places it
+    renderer->surface.set_heights(renderer->mesh, renderer->upsample_factor);
+
     // Compute bounds
     compute_mesh_bounds(renderer);
 
@@ -732,18 +744,23 @@ static void project_and_cache_vertices(bed_mesh_renderer_t* renderer, int canvas
  * @param renderer Renderer with quads already generated
  * @param canvas_width Canvas width in pixels
  * @param canvas_height Canvas height in pixels
+ * @param translucent_only Skip opaque (mesh) quads, e.g. when the upsampled
+ *        surface is drawn instead of them
  *
  * Side effects:
  * - Updates quad.screen_x[], quad.screen_y[], quad.depths[] for all quads
  * - Updates quad.avg_depth for depth sorting
  */
 static void project_and_cache_quads(bed_mesh_renderer_t* renderer, int canvas_width,
-                                    int canvas_height) {
+                                    int canvas_height, bool translucent_only) {
     if (!renderer || renderer->quads.empty()) {
         return;
     }
 
     for (auto& quad : renderer->quads) {
+        if (translucent_only && quad.opacity == LV_OPA_COVER) {
+            continue;
+        }
         double total_depth = 0.0;
 
         for (int i = 0; i < 4; i++) {
@@ -1066,9 +1083,11 @@ static void prepare_render_frame(bed_mesh_renderer_t* renderer, int canvas_width
 /**
  * @brief Render mesh surface as colored quads
  *
- * Projects all quad vertices, sorts by depth (painter's algorithm), and renders
- * each quad as two triangles. Uses gradient interpolation when static, solid
- * colors when dragging for performance.
+ * Projects all quad vertices and rasterizes each quad as two Gouraud-shaded
+ * triangles into the surface buffer, using a depth buffer for visibility, then
+ * draws the buffer as one image. If the buffer cannot be allocated, falls back
+ * to sorting by depth (painter's algorithm) and drawing spans through LVGL,
+ * with solid colors while dragging.
  *
  * @param layer LVGL draw layer
  * @param renderer Renderer with prepared view state
@@ -1084,17 +1103,31 @@ static void render_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer
     // DO NOT use clip_area dimensions here - they can be smaller during partial redraws
     // which corrupts the 3D projection math
 
+    // With a surface buffer the upsampled surface replaces the mesh quads, so only
+    // it and the translucent zero plane quads need projecting
+    bool use_surface = renderer->surface.is_ready() &&
+                       ensure_surface_buffer(renderer, canvas_width, canvas_height);
+    if (use_surface) {
+        renderer->surface.project(renderer->view_state, canvas_width, canvas_height);
+    }
+
     // Project all quad vertices once and cache screen coordinates + depths
     // This replaces 3 separate projection passes (depth calc, bounds tracking, rendering)
-    project_and_cache_quads(renderer, canvas_width, canvas_height);
+    project_and_cache_quads(renderer, canvas_width, canvas_height, use_surface);
     auto t_project = std::chrono::high_resolution_clock::now();
 
-    // Sort quads by depth using cached avg_depth (painter's algorithm - furthest first)
-    helix::mesh::sort_quads_by_depth(renderer->quads);
-    auto t_sort = std::chrono::high_resolution_clock::now();
-
-    spdlog::trace("[Bed Mesh Renderer] Rendering {} quads with {} mode", renderer->quads.size(),
-                  renderer->view_state.is_dragging ? "solid" : "gradient");
+    if (use_surface) {
+        rasterize_mesh_surface(layer, renderer, canvas_width, canvas_height);
+        auto t_rasterize = std::chrono::high_resolution_clock::now();
+        auto ms_project = std::chrono::duration<double, std::milli>(t_project - t_start).count();
+        auto ms_rasterize =
+            std::chrono::duration<double, std::milli>(t_rasterize - t_project).count();
+        spdlog::trace("[Bed Mesh Renderer] [PERF] Surface render: Proj: {:.2f}ms | "
+                      "Raster: {:.2f}ms | Vertices: {} ({}x upsampled) | Mode: span",
+                      ms_project, ms_rasterize, renderer->surface.vertex_count(),
+                      renderer->surface.factor());
+        return;
+    }
 
     // DEBUG: Track overall gradient quad bounds using cached coordinates
     int quad_min_x = INT_MAX, quad_max_x = INT_MIN;
@@ -1125,7 +1158,10 @@ static void render_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer
     }
 
     // Render quads using cached screen coordinates
+    // Sort quads by depth using cached avg_depth (painter's algorithm - furthest first)
+    helix::mesh::sort_quads_by_depth(renderer->quads);
     bool use_gradient = !renderer->view_state.is_dragging;
+    const char* mode = use_gradient ? "gradient" : "solid";
     for (const auto& quad : renderer->quads) {
         render_quad(layer, quad, use_gradient);
     }
@@ -1133,16 +1169,139 @@ static void render_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer
 
     // PERF: Log performance breakdown (use -vvv to see)
     auto ms_project = std::chrono::duration<double, std::milli>(t_project - t_start).count();
-    auto ms_sort = std::chrono::duration<double, std::milli>(t_sort - t_project).count();
-    auto ms_rasterize = std::chrono::duration<double, std::milli>(t_rasterize - t_sort).count();
-
-    spdlog::trace("[Bed Mesh Renderer] [PERF] Surface render: Proj: {:.2f}ms ({:.0f}%) | Sort: "
-                  "{:.2f}ms ({:.0f}%) | "
-                  "Raster: {:.2f}ms ({:.0f}%) | Mode: {}",
-                  ms_project, 100.0 * ms_project / (ms_project + ms_sort + ms_rasterize), ms_sort,
-                  100.0 * ms_sort / (ms_project + ms_sort + ms_rasterize), ms_rasterize,
-                  100.0 * ms_rasterize / (ms_project + ms_sort + ms_rasterize),
-                  renderer->view_state.is_dragging ? "solid" : "gradient");
+    auto ms_rasterize = std::chrono::duration<double, std::milli>(t_rasterize - t_project).count();
+
+    spdlog::trace("[Bed Mesh Renderer] [PERF] Surface render: Proj: {:.2f}ms ({:.0f}%) | "
+                  "Raster: {:.2f}ms ({:.0f}%) | Quads: {} | Mode: {}",
+                  ms_project, 100.0 * ms_project / (ms_project + ms_rasterize), ms_rasterize,
+                  100.0 * ms_rasterize / (ms_project + ms_rasterize), renderer->quads.size(),
+                  mode);
+}
+
+/**
+ * @brief (Re)create the canvas-sized ARGB8888 surface buffer
+ *
+ * @return false if the buffer could not be allocated
+ */
+static bool ensure_surface_buffer(bed_mesh_renderer_t* renderer, int canvas_width,
+                                  int canvas_height) {
+    lv_draw_buf_t* buf = renderer->surface_buf;
+    if (buf && static_cast<int>(buf->header.w) == canvas_width &&
+        static_cast<int>(buf->header.h) == canvas_height) {
+        return true;
+    }
+    if (buf) {
+        lv_draw_buf_destroy(buf);
+        renderer->surface_buf = nullptr;
+    }
+
+    renderer->surface_buf =
+        lv_draw_buf_create(canvas_width, canvas_height, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (!renderer->surface_buf) {
+        spdlog::warn("[Bed Mesh Renderer] Failed to create {}x{} surface buffer, "
+                     "using depth-sorted draws",
+                     canvas_width, canvas_height);
+        return false;
+    }
+    spdlog::debug("[Bed Mesh Renderer] Created {}x{} surface buffer", canvas_width,
+                  canvas_height);
+    return true;
+}
+
+/**
+ * @brief Rasterize the upsampled surface and the zero plane, draw them as one image
+ *
+ * Only the layer's clip area is cleared and filled: during partial redraws LVGL
+ * calls render() once per band, and everything outside the band is clipped.
+ * The opaque surface goes first so the translucent zero plane is tested
+ * against the finished depth buffer.
+ *
+ * Expects renderer->surface and the translucent quads to be projected.
+ *
+ * @return false if the surface buffer is unavailable (nothing was drawn)
+ */
+static bool rasterize_mesh_surface(lv_layer_t* layer, bed_mesh_renderer_t* renderer,
+                                   int canvas_width, int canvas_height) {
+    if (!ensure_surface_buffer(renderer, canvas_width, canvas_height)) {
+        return false;
+    }
+    lv_draw_buf_t* buf = renderer->surface_buf;
+    const int offset_x = renderer->view_state.layer_offset_x;
+    const int offset_y = renderer->view_state.layer_offset_y;
+
+    // Clip area in buffer coordinates
+    lv_area_t clip = layer->_clip_area;
+    clip.x1 -= offset_x;
+    clip.x2 -= offset_x;
+    clip.y1 -= offset_y;
+    clip.y2 -= offset_y;
+    auto& raster = renderer->surface_raster;
+    raster.begin(buf->data, canvas_width, canvas_height, static_cast<int>(buf->header.stride),
+                 clip);
+
+    // Scene depth range, spread over the 16-bit depth buffer
+    const auto& surface = renderer->surface;
+    double near_depth = std::numeric_limits<double>::max();
+    double far_depth = std::numeric_limits<double>::lowest();
+    for (float depth : surface.depths()) {
+        near_depth = std::min(near_depth, static_cast<double>(depth));
+        far_depth = std::max(far_depth, static_cast<double>(depth));
+    }
+    for (const auto& quad : renderer->quads) {
+        if (quad.opacity == LV_OPA_COVER) {
+            continue;
+        }
+        for (double depth : quad.depths) {
+            near_depth = std::min(near_depth, depth);
+            far_depth = std::max(far_depth, depth);
+        }
+    }
+
+    // Surface cells, split like render_quad(): BL-BR-TL and BR-TR-TL
+    auto surface_vertex = [&](size_t i) -> helix::mesh::RasterVertex {
+        return {surface.screen_x()[i] - offset_x, surface.screen_y()[i] - offset_y,
+                helix::mesh::quantize_depth(surface.depths()[i], near_depth, far_depth),
+                surface.colors()[i]};
+    };
+    const size_t cols = static_cast<size_t>(surface.cols());
+    for (size_t row = 0; row + 1 < static_cast<size_t>(surface.rows()); row++) {
+        helix::mesh::RasterVertex tl = surface_vertex(row * cols);
+        helix::mesh::RasterVertex bl = surface_vertex((row + 1) * cols);
+        for (size_t col = 1; col < cols; col++) {
+            helix::mesh::RasterVertex tr = surface_vertex(row * cols + col);
+            helix::mesh::RasterVertex br = surface_vertex((row + 1) * cols + col);
+            raster.fill_triangle(bl, br, tl);
+            raster.fill_triangle(br, tr, tl);
+            tl = tr;
+            bl = br;
+        }
+    }
+
+    // Zero plane: one flat color per quad, depth tested against the surface
+    for (const auto& quad : renderer->quads) {
+        if (quad.opacity == LV_OPA_COVER) {
+            continue;
+        }
+        helix::mesh::RasterVertex v[4];
+        for (int i = 0; i < 4; i++) {
+            v[i] = {quad.screen_x[i] - offset_x, quad.screen_y[i] - offset_y,
+                    helix::mesh::quantize_depth(quad.depths[i], near_depth, far_depth),
+                    quad.center_color};
+        }
+        raster.fill_triangle(v[0], v[1], v[2], quad.opacity);
+        raster.fill_triangle(v[1], v[3], v[2], quad.opacity);
+    }
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = buf;
+    lv_area_t coords = {offset_x, offset_y, offset_x + canvas_width - 1,
+                        offset_y + canvas_height - 1};
+    lv_draw_image(layer, &dsc, &coords);
+
+    spdlog::trace("[Bed Mesh Renderer] Rasterized {}x{} surface, {} pixels", surface.rows(),
+                  surface.cols(), raster.pixels_drawn());
+    return true;
 }
 
 /**
@@ -1777,3 +1936,25 @@ void bed_mesh_renderer_set_z_display_offset(bed_mesh_renderer_t* renderer, doubl
     renderer->z_display_offset = offset_mm;
     spdlog::debug("[Bed Mesh Renderer] Z display offset set to {:.4f}mm", offset_mm);
 }
+
+void bed_mesh_renderer_set_upsample_factor(bed_mesh_renderer_t* renderer, int factor) {
+    if (!renderer)
+        return;
+
+    factor = std::clamp(factor, 1, helix::mesh::SURFACE_MAX_UPSAMPLE);
+    if (renderer->upsample_factor == factor)
+        return; // No change
+
+    renderer->upsample_factor = factor;
+    spdlog::debug("[Bed Mesh Renderer] Surface upsample factor set to {}", factor);
+
+    if (renderer->has_mesh_data) {
+        renderer->surface.set_heights(renderer->mesh, factor);
+        helix::mesh::generate_mesh_quads(renderer);
+
+        // State transition: READY_TO_RENDER → MESH_LOADED (quads regenerated, projections invalid)
+        if (renderer->state == RendererState::READY_TO_RENDER) {
+            renderer->state = RendererState::MESH_LOADED;
+        }
+    }
+}
@@ -0,0 +1,216 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "bed_mesh_surface.h"
+
+#include "bed_mesh_coordinate_transform.h"
+#include "bed_mesh_gradient.h"
+
+#include <algorithm>
+#include <array>
+
+namespace helix {
+namespace mesh {
+
+namespace {
+
+/// Catmull-Rom weights for p[-1], p[0], p[1], p[2] at parameter t in [0, 1)
+std::array<float, 4> catmull_rom_weights(float t) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return {0.5f * (-t3 + 2.0f * t2 - t), 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f),
+            0.5f * (-3.0f * t3 + 4.0f * t2 + t), 0.5f * (t3 - t2)};
+}
+
+/**
+ * @brief Upsample one line of samples (stride apart) into dst (dst_stride apart)
+ *
+ * Phantom samples beyond each end are extrapolated linearly, which keeps the
+ * spline exact for linear data.
+ */
+void upsample_line(const float* src, int count, size_t stride, float* dst, size_t dst_stride,
+                   int factor, const std::vector<std::array<float, 4>>& weights) {
+    auto sample = [&](int i) -> float {
+        if (i < 0) {
+            return 2.0f * src[0] - src[stride];
+        }
+        if (i >= count) {
+            return 2.0f * src[(count - 1) * stride] - src[(count - 2) * stride];
+        }
+        return src[static_cast<size_t>(i) * stride];
+    };
+
+    size_t out = 0;
+    for (int i = 0; i < count - 1; i++) {
+        float p0 = sample(i - 1);
+        float p1 = sample(i);
+        float p2 = sample(i + 1);
+        float p3 = sample(i + 2);
+        for (int k = 0; k < factor; k++) {
+            const auto& w = weights[static_cast<size_t>(k)];
+            dst[out * dst_stride] = w[0] * p0 + w[1] * p1 + w[2] * p2 + w[3] * p3;
+            out++;
+        }
+    }
+    dst[out * dst_stride] = src[static_cast<size_t>(count - 1) * stride];
+}
+
+} // namespace
+
+std::vector<float> upsample_mesh_bicubic(const std::vector<std::vector<double>>& mesh,
+                                         int factor, int* out_rows, int* out_cols) {
+    *out_rows = 0;
+    *out_cols = 0;
+    int rows = static_cast<int>(mesh.size());
+    int cols = rows > 0 ? static_cast<int>(mesh[0].size()) : 0;
+    if (rows < 2 || cols < 2) {
+        return {};
+    }
+    for (const auto& row : mesh) {
+        if (static_cast<int>(row.size()) != cols) {
+            return {};
+        }
+    }
+
+    factor = std::clamp(factor, 1, SURFACE_MAX_UPSAMPLE);
+    int up_rows = (rows - 1) * factor + 1;
+    int up_cols = (cols - 1) * factor + 1;
+
+    std::vector<std::array<float, 4>> weights(static_cast<size_t>(factor));
+    for (int k = 0; k < factor; k++) {
+        weights[static_cast<size_t>(k)] =
+            catmull_rom_weights(static_cast<float>(k) / static_cast<float>(factor));
+    }
+
+    // Pass 1: along each probe row (probe rows land on every factor-th output row)
+    std::vector<float> probe_row(static_cast<size_t>(cols));
+    std::vector<float> result(static_cast<size_t>(up_rows) * up_cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            probe_row[static_cast<size_t>(c)] = static_cast<float>(mesh[r][c]);
+        }
+        float* dst = &result[static_cast<size_t>(r) * factor * up_cols];
+        upsample_line(probe_row.data(), cols, 1, dst, 1, factor, weights);
+    }
+
+    // Pass 2: down each output column, in place from the probe rows
+    if (factor > 1) {
+        std::vector<float> column(static_cast<size_t>(rows));
+        for (int c = 0; c < up_cols; c++) {
+            for (int r = 0; r < rows; r++) {
+                column[static_cast<size_t>(r)] =
+                    result[static_cast<size_t>(r) * factor * up_cols + c];
+            }
+            upsample_line(column.data(), rows, 1, &result[static_cast<size_t>(c)],
+                          static_cast<size_t>(up_cols), factor, weights);
+        }
+    }
+
+    *out_rows = up_rows;
+    *out_cols = up_cols;
+    return result;
+}
+
+// ============================================================================
+// MeshSurface
+// ============================================================================
+
+void MeshSurface::set_heights(const std::vector<std::vector<double>>& mesh, int factor) {
+    factor_ = std::clamp(factor, 1, SURFACE_MAX_UPSAMPLE);
+    heights_ = upsample_mesh_bicubic(mesh, factor_, &rows_, &cols_);
+    placed_ = false;
+}
+
+void MeshSurface::place(double x_first, double x_last, double y_first, double y_last,
+                        double z_center, double z_scale, double color_min, double color_max) {
+    size_t count = heights_.size();
+    world_x_.resize(count);
+    world_y_.resize(count);
+    world_z_.resize(count);
+    colors_.resize(count);
+    if (count == 0) {
+        placed_ = false;
+        return;
+    }
+
+    double step_x = (x_last - x_first) / (cols_ - 1);
+    double step_y = (y_last - y_first) / (rows_ - 1);
+    size_t i = 0;
+    for (int r = 0; r < rows_; r++) {
+        float wy = static_cast<float>(y_first + step_y * r);
+        for (int c = 0; c < cols_; c++, i++) {
+            world_x_[i] = static_cast<float>(x_first + step_x * c);
+            world_y_[i] = wy;
+            world_z_[i] = static_cast<float>(mesh_z_to_world_z(heights_[i], z_center, z_scale));
+            colors_[i] = bed_mesh_gradient_height_to_color(heights_[i], color_min, color_max);
+        }
+    }
+    placed_ = true;
+}
+
+void MeshSurface::project(const bed_mesh_view_state_t& view, int canvas_width,
+                          int canvas_height) {
+    size_t count = world_x_.size();
+    screen_x_.resize(count);
+    screen_y_.resize(count);
+    depth_.resize(count);
+
+    // Z spin, X tilt and the FOV scale folded into one affine transform;
+    // the third row is the camera-space depth (camera_distance - rotated z)
+    const float cz = static_cast<float>(view.cached_cos_z);
+    const float sz = static_cast<float>(view.cached_sin_z);
+    const float cx = static_cast<float>(view.cached_cos_x);
+    const float sx = static_cast<float>(view.cached_sin_x);
+    const float fov = static_cast<float>(view.fov_scale);
+
+    const float m00 = fov * cz;
+    const float m01 = fov * sz;
+    const float m10 = -fov * sz * cx;
+    const float m11 = fov * cz * cx;
+    const float m12 = -fov * sx;
+    const float m20 = sz * sx;
+    const float m21 = -cz * sx;
+    const float m22 = -cx;
+    const float m23 = static_cast<float>(view.camera_distance);
+
+    // Same origin and truncation as bed_mesh_projection_project_3d_to_2d()
+    constexpr float MIN_CAMERA_Z = 1.0f;
+    const float origin_x = static_cast<float>(canvas_width / 2);
+    const float origin_y = static_cast<float>(canvas_height * BED_MESH_Z_ORIGIN_VERTICAL_POS);
+    const int32_t offset_x = view.center_offset_x + view.layer_offset_x;
+    const int32_t offset_y = view.center_offset_y + view.layer_offset_y;
+
+    const float* wx = world_x_.data();
+    const float* wy = world_y_.data();
+    const float* wz = world_z_.data();
+    int32_t* out_x = screen_x_.data();
+    int32_t* out_y = screen_y_.data();
+    float* out_depth = depth_.data();
+    for (size_t i = 0; i < count; i++) {
+        float px = m00 * wx[i] + m01 * wy[i];
+        float py = m10 * wx[i] + m11 * wy[i] + m12 * wz[i];
+        float d = std::max(m20 * wx[i] + m21 * wy[i] + m22 * wz[i] + m23, MIN_CAMERA_Z);
+        float inv_d = 1.0f / d;
+        out_x[i] = static_cast<int32_t>(origin_x + px * inv_d) + offset_x;
+        out_y[i] = static_cast<int32_t>(origin_y + py * inv_d) + offset_y;
+        out_depth[i] = d;
+    }
+}
+
+void MeshSurface::clear() {
+    rows_ = 0;
+    cols_ = 0;
+    factor_ = 0;
+    placed_ = false;
+    heights_.clear();
+    world_x_.clear();
+    world_y_.clear();
+    world_z_.clear();
+    colors_.clear();
+    screen_x_.clear();
+    screen_y_.clear();
+    depth_.clear();
+}
+
+} // namespace mesh
+} // namespace helix
@@ -0,0 +1,207 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_compact_segments.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+constexpr float GRID_PER_MM = 1.0f / CompactSegments::XY_QUANTUM_MM;
+
+int32_t to_grid(float mm) {
+    return static_cast<int32_t>(std::lround(mm * GRID_PER_MM));
+}
+
+float from_grid(int32_t units) {
+    return static_cast<float>(units) * CompactSegments::XY_QUANTUM_MM;
+}
+
+bool fits_int16(int32_t value) {
+    return value >= std::numeric_limits<int16_t>::min() &&
+           value <= std::numeric_limits<int16_t>::max();
+}
+
+template <typename T> size_t vector_bytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+CompactSegments::CompactSegments(const std::vector<ToolpathSegment>& segments) {
+    reserve(segments.size());
+    for (const auto& segment : segments) {
+        push_back(segment);
+    }
+    shrink_to_fit();
+}
+
+void CompactSegments::reserve(size_t count) {
+    flags_.reserve(count);
+    dx_.reserve(count);
+    dy_.reserve(count);
+    tool_.reserve(count);
+    object_.reserve(count);
+    width_um_.reserve(count);
+    extrusion_.reserve(count);
+}
+
+void CompactSegments::shrink_to_fit() {
+    flags_.shrink_to_fit();
+    dx_.shrink_to_fit();
+    dy_.shrink_to_fit();
+    tool_.shrink_to_fit();
+    object_.shrink_to_fit();
+    width_um_.shrink_to_fit();
+    extrusion_.shrink_to_fit();
+    anchors_.shrink_to_fit();
+    z_values_.shrink_to_fit();
+    object_names_.shrink_to_fit();
+    object_ids_.shrink_to_fit();
+}
+
+uint16_t CompactSegments::intern_object(const std::string& name, ObjectId id) {
+    if (name.empty()) {
+        return 0;
+    }
+    // Runs of segments share an object, so the last id is nearly always right
+    if (last_object_ != 0 && object_names_[last_object_ - 1] == name) {
+        return last_object_;
+    }
+    auto it = std::find(object_names_.begin(), object_names_.end(), name);
+    if (it == object_names_.end()) {
+        if (object_names_.size() >= std::numeric_limits<uint16_t>::max()) {
+            return 0; // Out of ids; drop the name rather than alias another object
+        }
+        object_names_.push_back(name);
+        object_ids_.push_back(id);
+        it = object_names_.end() - 1;
+    }
+    last_object_ = static_cast<uint16_t>(it - object_names_.begin() + 1);
+    return last_object_;
+}
+
+void CompactSegments::push_back(const ToolpathSegment& segment) {
+    uint8_t flags = segment.is_extrusion ? EXTRUSION : 0;
+
+    int32_t start_x = to_grid(segment.start.x);
+    int32_t start_y = to_grid(segment.start.y);
+    if (start_x != last_x_ || start_y != last_y_) {
+        flags |= START_JUMP;
+        anchors_.push_back({start_x, start_y});
+    }
+    if (segment.start.z != last_z_) {
+        flags |= START_Z;
+        z_values_.push_back(segment.start.z);
+    }
+
+    int32_t end_x = to_grid(segment.end.x);
+    int32_t end_y = to_grid(segment.end.y);
+    int32_t dx = end_x - start_x;
+    int32_t dy = end_y - start_y;
+    if (fits_int16(dx) && fits_int16(dy)) {
+        dx_.push_back(static_cast<int16_t>(dx));
+        dy_.push_back(static_cast<int16_t>(dy));
+    } else {
+        flags |= LONG_MOVE;
+        anchors_.push_back({end_x, end_y});
+        dx_.push_back(0);
+        dy_.push_back(0);
+    }
+    if (segment.end.z != segment.start.z) {
+        flags |= END_Z;
+        z_values_.push_back(segment.end.z);
+    }
+
+    flags_.push_back(flags);
+    tool_.push_back(static_cast<uint8_t>(std::clamp(segment.tool_index, 0, 255)));
+    object_.push_back(intern_object(segment.object_name, segment.object_id));
+    float width_um = std::round(std::max(segment.width, 0.0f) * 1000.0f);
+    width_um_.push_back(static_cast<uint16_t>(std::min(width_um, 65535.0f)));
+    extrusion_.push_back(segment.extrusion_amount);
+
+    last_x_ = end_x;
+    last_y_ = end_y;
+    last_z_ = segment.end.z;
+}
+
+std::vector<ToolpathSegment> CompactSegments::to_vector() const {
+    return std::vector<ToolpathSegment>(begin(), end());
+}
+
+size_t CompactSegments::memory_bytes() const {
+    size_t bytes = vector_bytes(flags_) + vector_bytes(dx_) + vector_bytes(dy_) +
+                   vector_bytes(tool_) + vector_bytes(object_) + vector_bytes(width_um_) +
+                   vector_bytes(extrusion_) + vector_bytes(anchors_) + vector_bytes(z_values_) +
+                   vector_bytes(object_names_) + vector_bytes(object_ids_);
+    for (const auto& name : object_names_) {
+        if (name.capacity() > 15) { // Beyond the SSO buffer
+            bytes += name.capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+CompactSegments::const_iterator::const_iterator(const CompactSegments* owner, size_t index)
+    : owner_(owner), index_(index) {
+    if (index_ == 0) {
+        decode();
+    }
+}
+
+void CompactSegments::const_iterator::decode() {
+    if (!owner_ || index_ >= owner_->size()) {
+        return;
+    }
+    const CompactSegments& s = *owner_;
+    uint8_t flags = s.flags_[index_];
+
+    if (flags & START_JUMP) {
+        x_ = s.anchors_[anchor_pos_].x;
+        y_ = s.anchors_[anchor_pos_].y;
+        ++anchor_pos_;
+    }
+    if (flags & START_Z) {
+        z_ = s.z_values_[z_pos_++];
+    }
+    current_.start = glm::vec3(from_grid(x_), from_grid(y_), z_);
+
+    if (flags & LONG_MOVE) {
+        x_ = s.anchors_[anchor_pos_].x;
+        y_ = s.anchors_[anchor_pos_].y;
+        ++anchor_pos_;
+    } else {
+        x_ += s.dx_[index_];
+        y_ += s.dy_[index_];
+    }
+    if (flags & END_Z) {
+        z_ = s.z_values_[z_pos_++];
+    }
+    current_.end = glm::vec3(from_grid(x_), from_grid(y_), z_);
+
+    current_.is_extrusion = (flags & EXTRUSION) != 0;
+    current_.tool_index = s.tool_[index_];
+    current_.width = static_cast<float>(s.width_um_[index_]) / 1000.0f;
+    current_.extrusion_amount = s.extrusion_[index_];
+
+    // Only touch the string when the object changes
+    uint16_t slot = s.object_[index_];
+    if (slot != object_slot_) {
+        object_slot_ = slot;
+        if (slot == 0) {
+            current_.object_name.clear();
+            current_.object_id = NO_OBJECT_ID;
+        } else {
+            current_.object_name = s.object_names_[slot - 1];
+            current_.object_id = s.object_ids_[slot - 1];
+        }
+    }
+}
+
+} // namespace gcode
+} // namespace helix
@@ -15,14 +15,50 @@
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <thread>
 
 // For HTTP requests - use libhv which is already in the project
+#include "hv/HttpClient.h"
 #include "hv/hurl.h"
 #include "hv/requests.h"
 
 namespace helix {
 namespace gcode {
 
+namespace {
+
+// Chunk size for stream_chunks() over read_range()
+constexpr uint32_t STREAM_CHUNK_BYTES = 1024 * 1024;
+
+// The metadata response is tiny; a slow one means the printer is unreachable
+constexpr int METADATA_TIMEOUT_SECONDS = 5;
+
+// Deliver [offset, file_size()) through read_range() in file order
+bool stream_via_read_range(GCodeDataSource& source, uint64_t offset,
+                           const GCodeDataSource::ChunkCallback& on_chunk,
+                           const std::atomic<bool>& keep_running) {
+    uint64_t size = source.file_size();
+    while (offset < size) {
+        if (!keep_running.load()) {
+            return false;
+        }
+        auto length = static_cast<uint32_t>(std::min<uint64_t>(STREAM_CHUNK_BYTES, size - offset));
+        auto data = source.read_range(offset, length);
+        if (data.empty()) {
+            spdlog::error("[DataSource] Read failed at byte {} of {}", offset, size);
+            return false;
+        }
+        uint64_t chunk_offset = offset;
+        offset += data.size();
+        if (!on_chunk(data.data(), data.size(), chunk_offset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 // =============================================================================
 // GCodeDataSource base class
 // =============================================================================
@@ -62,6 +98,11 @@ std::vector<char> GCodeDataSource::read_all() {
     return result;
 }
 
+bool GCodeDataSource::stream_chunks(const ChunkCallback& on_chunk,
+                                    const std::atomic<bool>& keep_running) {
+    return stream_via_read_range(*this, 0, on_chunk, keep_running);
+}
+
 // =============================================================================
 // FileDataSource
 // =============================================================================
@@ -198,7 +239,11 @@ bool MoonrakerDataSource::fetch_metadata() {
     std::string encoded_filename = HUrl::escape(gcode_path_);
     std::string url = moonraker_url_ + "/server/files/metadata?filename=" + encoded_filename;
 
-    auto resp = requests::get(url.c_str());
+    auto req = std::make_shared<HttpRequest>();
+    req->method = HTTP_GET;
+    req->url = url;
+    req->timeout = METADATA_TIMEOUT_SECONDS;
+    auto resp = requests::request(req);
 
     if (!resp) {
         spdlog::error("[MoonrakerDataSource] Metadata request failed for '{}'", gcode_path_);
@@ -447,29 +492,129 @@ std::string MoonrakerDataSource::indexable_file_path() const {
     return "";
 }
 
-bool MoonrakerDataSource::ensure_indexable() {
-    // If we already have a temp file, we're ready
-    if (fallback_source_) {
-        return true;
+bool MoonrakerDataSource::stream_chunks(const ChunkCallback& on_chunk,
+                                        const std::atomic<bool>& keep_running) {
+    if (!is_valid()) {
+        return false;
     }
 
-    // Check if range requests are supported
-    if (!range_support_probed_) {
-        probe_range_support();
+    uint64_t offset = 0;
+    if (!fallback_source_) {
+        switch (stream_ranges(on_chunk, keep_running, offset)) {
+        case RangeStreamResult::COMPLETE:
+            return true;
+        case RangeStreamResult::STOPPED:
+        case RangeStreamResult::FAILED:
+            return false;
+        case RangeStreamResult::NO_RANGE_SUPPORT:
+            spdlog::warn(
+                "[MoonrakerDataSource] Range requests not supported, downloading to temp file");
+            if (!download_to_temp()) {
+                return false;
+            }
+            break;
+        }
     }
 
-    // If range requests aren't supported, download to temp file
-    if (!range_support_) {
-        spdlog::warn(
-            "[MoonrakerDataSource] Range requests not supported, downloading to temp file");
-        return download_to_temp();
+    return stream_via_read_range(*this, offset, on_chunk, keep_running);
+}
+
+MoonrakerDataSource::RangeStreamResult
+MoonrakerDataSource::stream_ranges(const ChunkCallback& on_chunk,
+                                   const std::atomic<bool>& keep_running, uint64_t& offset) {
+    const RangeStreamOptions options = stream_options_;
+    const std::string url = get_download_url();
+
+    // One client for the whole file: chunks share a keep-alive connection, and
+    // the next send() reconnects if the connection dropped
+    hv::HttpClient client;
+    int failures = 0;
+    uint32_t chunk_bytes = std::max<uint32_t>(options.chunk_bytes, 1);
+
+    spdlog::info("[MoonrakerDataSource] Streaming {} ({} bytes) in {}KB ranges", url, size_,
+                 chunk_bytes / 1024);
+
+    while (offset < size_) {
+        if (!keep_running.load()) {
+            return RangeStreamResult::STOPPED;
+        }
+
+        uint64_t last = std::min<uint64_t>(offset + chunk_bytes, size_) - 1;
+        char range_value[64];
+        std::snprintf(range_value, sizeof(range_value), "bytes=%" PRIu64 "-%" PRIu64, offset,
+                      last);
+
+        HttpRequest req;
+        req.method = HTTP_GET;
+        req.url = url;
+        req.timeout = static_cast<int>(options.request_timeout.count());
+        req.headers["Range"] = range_value;
+        HttpResponse resp;
+        int ret = client.send(&req, &resp);
+        int status = ret == 0 ? static_cast<int>(resp.status_code) : 0;
+
+        if (status == 206 && !resp.body.empty()) {
+            failures = 0;
+            range_support_probed_ = true;
+            range_support_ = true;
+
+            // Some servers send more than asked for; never run past the range
+            size_t length = std::min<size_t>(resp.body.size(), last - offset + 1);
+            uint64_t chunk_offset = offset;
+            offset += length;
+            if (!on_chunk(resp.body.data(), length, chunk_offset)) {
+                return RangeStreamResult::STOPPED;
+            }
+            continue;
+        }
+
+        if (status == 200) {
+            // Server ignored the Range header. Layers may already be loading
+            // from earlier chunks, so only switch to the temp file before any
+            // data was delivered.
+            spdlog::warn("[MoonrakerDataSource] Server returned 200 instead of 206 at byte {}",
+                         offset);
+            range_support_probed_ = true;
+            range_support_ = false;
+            return offset == 0 ? RangeStreamResult::NO_RANGE_SUPPORT : RangeStreamResult::FAILED;
+        }
+
+        // A timed-out or dropped request may just be too big for the link:
+        // retry smaller before counting it as a failure
+        if (ret != 0 && chunk_bytes > options.min_chunk_bytes) {
+            chunk_bytes = std::max(chunk_bytes / 2, options.min_chunk_bytes);
+            spdlog::warn("[MoonrakerDataSource] Range request at byte {} failed (error {}), "
+                         "retrying in {}KB ranges",
+                         offset, ret, chunk_bytes / 1024);
+            continue;
+        }
+
+        // Connection errors, timeouts and server errors are worth retrying;
+        // anything else (e.g. 404 after the file was deleted) is not
+        bool retryable = ret != 0 || status >= 500 || status == 408 || status == 429;
+        if (!retryable || ++failures > options.max_retries) {
+            spdlog::error("[MoonrakerDataSource] Streaming stopped at byte {} of {} (HTTP {}, "
+                          "error {})",
+                          offset, size_, status, ret);
+            return RangeStreamResult::FAILED;
+        }
+
+        spdlog::warn("[MoonrakerDataSource] Range request at byte {} failed (HTTP {}, error {}), "
+                     "resuming, attempt {}/{}",
+                     offset, status, ret, failures, options.max_retries);
+
+        // Back off, staying responsive to cancellation
+        auto resume_at = std::chrono::steady_clock::now() + options.retry_delay * failures;
+        while (std::chrono::steady_clock::now() < resume_at) {
+            if (!keep_running.load()) {
+                return RangeStreamResult::STOPPED;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
     }
 
-    // Even with range request support, the layer indexer requires filesystem access
-    // to memory-map the file for efficient random-access parsing. Download once
-    // for indexing, then streaming can use range requests for actual rendering.
-    spdlog::info("[MoonrakerDataSource] Downloading for file-based layer indexing");
-    return download_to_temp();
+    spdlog::info("[MoonrakerDataSource] Streamed {} bytes", size_);
+    return RangeStreamResult::COMPLETE;
 }
 
 // =============================================================================
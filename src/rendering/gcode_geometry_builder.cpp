@@ -8,12 +8,14 @@
 #include "ui_utils.h"
 
 #include "config.h"
+#include "gcode_parallel.h"
 #include "geometry_budget_manager.h"
 
 #include <spdlog/spdlog.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <glm/gtx/norm.hpp>
@@ -369,6 +371,10 @@ uint16_t GeometryBuilder::add_to_normal_palette(RibbonGeometry& geometry, const
         quantized = normal; // Fallback if quantization created zero vector
     }
 
+    return intern_normal(geometry, quantized);
+}
+
+uint16_t GeometryBuilder::intern_normal(RibbonGeometry& geometry, const glm::vec3& quantized) {
     // Check cache first (O(1) lookup)
     auto it = geometry.normal_cache->find(quantized);
     if (it != geometry.normal_cache->end()) {
@@ -377,11 +383,10 @@ uint16_t GeometryBuilder::add_to_normal_palette(RibbonGeometry& geometry, const
 
     // Not in cache - add to palette
     if (geometry.normal_palette.size() >= 65536) {
-        static bool warned = false;
-        if (!warned) {
+        static std::atomic<bool> warned{false};
+        if (!warned.exchange(true)) {
             spdlog::warn(
                 "[GCode Geometry] Normal palette full (65536 entries), reusing last entry");
-            warned = true;
         }
         return 65535;
     }
@@ -408,10 +413,9 @@ uint8_t GeometryBuilder::add_to_color_palette(RibbonGeometry& geometry, uint32_t
 
     // Not in cache - add to palette
     if (geometry.color_palette.size() >= 256) {
-        static bool color_warned = false;
-        if (!color_warned) {
+        static std::atomic<bool> color_warned{false};
+        if (!color_warned.exchange(true)) {
             spdlog::warn("[GCode Geometry] Color palette full (256 entries), reusing last entry");
-            color_warned = true;
         }
         return 255;
     }
@@ -423,12 +427,31 @@ uint8_t GeometryBuilder::add_to_color_palette(RibbonGeometry& geometry, uint32_t
     return index;
 }
 
+// ============================================================================
+// Geometry Build
+// ============================================================================
+
+/// Geometry for a contiguous run of layers, built on one thread
+struct GeometryBuilder::LayerRangeBuild {
+    size_t first_layer{0};
+    size_t end_layer{0};
+    RibbonGeometry geometry; ///< Per-layer vectors are sized to end_layer
+    size_t input_segments{0};
+    size_t output_segments{0};
+    size_t degenerate_segments{0};
+};
+
+/// Memory accounting shared by every range of one build()
+struct GeometryBuilder::SharedBuildState {
+    std::atomic<size_t> memory_bytes{0}; ///< Sum of each range's last reported usage
+    std::atomic<bool> exceeded{false};   ///< Set by the first range to hit the budget
+};
+
 RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
                                       const SimplificationOptions& options) {
     // Start timing
     auto build_start = std::chrono::high_resolution_clock::now();
 
-    RibbonGeometry geometry;
     stats_ = {}; // Reset statistics
     budget_exceeded_ = false;
 
@@ -461,18 +484,169 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
         "[GCode Geometry] Expanded quantization bounds by {:.1f}mm for tube width {:.1f}mm",
         expansion_margin, max_tube_width);
 
-    // Collect all segments from all layers, stamping each with its source layer index
+    size_t total_segments = 0;
+    for (const auto& layer : gcode.layers) {
+        total_segments += layer.segments.size();
+    }
+
+    // Progressive builds go bottom-up in waves, each about as large as all earlier ones
+    std::vector<size_t> wave_ends;
+    if (batch_callback_) {
+        size_t running = 0;
+        size_t target = first_batch_segments_;
+        for (size_t li = 0; li + 1 < gcode.layers.size(); ++li) {
+            running += gcode.layers[li].segments.size();
+            if (running >= target) {
+                wave_ends.push_back(li + 1);
+                target = running * 2;
+            }
+        }
+    }
+    wave_ends.push_back(gcode.layers.size());
+
+    spdlog::debug("[GCode::Builder] Building {} segments from {} layers in {} wave(s)",
+                  total_segments, gcode.layers.size(), wave_ends.size());
+
+    RibbonGeometry geometry;
+    SharedBuildState shared;
+    size_t degenerate_count = 0;
+    size_t wave_first = 0;
+    for (size_t wave_end : wave_ends) {
+        // Split the wave into contiguous ranges of roughly equal segment count
+        size_t wave_segments = 0;
+        for (size_t li = wave_first; li < wave_end; ++li) {
+            wave_segments += gcode.layers[li].segments.size();
+        }
+        unsigned threads =
+            parallel_thread_count(max_threads_, wave_segments, MIN_SEGMENTS_PER_THREAD);
+
+        std::vector<LayerRangeBuild> ranges(1);
+        ranges.back().first_layer = wave_first;
+        size_t running = 0;
+        for (size_t li = wave_first; li < wave_end; ++li) {
+            running += gcode.layers[li].segments.size();
+            size_t target = wave_segments * ranges.size() / threads;
+            if (running >= target && ranges.size() < threads && li + 1 < wave_end) {
+                ranges.back().end_layer = li + 1;
+                ranges.emplace_back();
+                ranges.back().first_layer = li + 1;
+            }
+        }
+        ranges.back().end_layer = wave_end;
+
+        parallel_for(ranges.size(), [&](size_t i) {
+            build_layer_range(gcode, ranges[i].first_layer, ranges[i].end_layer, validated_opts,
+                              shared, ranges[i]);
+        });
+
+        // Merge ranges in layer order; palettes come out as a sequential build would order them
+        for (auto& range : ranges) {
+            stats_.input_segments += range.input_segments;
+            stats_.output_segments += range.output_segments;
+            degenerate_count += range.degenerate_segments;
+            append_layer_range(geometry, range);
+        }
+
+        if (shared.exceeded.load()) {
+            break; // The caller discards the geometry; don't publish more of it
+        }
+        if (wave_end < gcode.layers.size()) {
+            batch_callback_(snapshot(geometry, wave_end), wave_end);
+        }
+        wave_first = wave_end;
+    }
+    budget_exceeded_ = shared.exceeded.load();
+
+    geometry.max_layer_index =
+        gcode.layers.empty() ? 0 : static_cast<uint16_t>(gcode.layers.size() - 1);
+
+    if (degenerate_count > 0) {
+        spdlog::debug("[GCode::Builder] Pre-filtered {} degenerate (zero-length) segments",
+                      degenerate_count);
+    }
+
+    size_t filtered_segments = stats_.input_segments - degenerate_count;
+    if (validated_opts.enable_merging) {
+        stats_.simplification_ratio =
+            filtered_segments > 0
+                ? 1.0f - (static_cast<float>(stats_.output_segments) / filtered_segments)
+                : 0.0f;
+        spdlog::info(
+            "[GCode::Builder] Toolpath simplification: {} → {} segments ({:.1f}% reduction)",
+            filtered_segments, stats_.output_segments, stats_.simplification_ratio * 100.0f);
+    } else {
+        stats_.simplification_ratio = 0.0f;
+        spdlog::info("[GCode::Builder] Toolpath simplification DISABLED: using {} raw segments",
+                     stats_.output_segments);
+    }
+
+    // Store quantization parameters for dequantization during rendering
+    geometry.quantization = quant_params_;
+
+    // Store layer height for Z-offset calculations during LOD rendering
+    geometry.layer_height_mm = layer_height_mm_;
+
+    // Update final statistics
+    stats_.vertices_generated = geometry.vertices.size();
+    // Each TriangleStrip has 4 indices forming 2 triangles
+    stats_.triangles_generated = geometry.strips.size() * 2;
+    stats_.memory_bytes = geometry.memory_usage();
+
+    stats_.log();
+
+    // Validate geometry integrity before returning
+    geometry.validate();
+
+    // End timing
+    auto build_end = std::chrono::high_resolution_clock::now();
+    auto build_duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(build_end - build_start);
+    spdlog::info("[GCode::Builder] Geometry build completed in {:.3f} seconds",
+                 build_duration.count() / 1000.0);
+
+    return geometry;
+}
+
+std::unique_ptr<RibbonGeometry> GeometryBuilder::snapshot(const RibbonGeometry& geometry,
+                                                         size_t end_layer) const {
+    auto copy = std::make_unique<RibbonGeometry>();
+    copy->vertices = geometry.vertices;
+    copy->indices = geometry.indices;
+    copy->strips = geometry.strips;
+    copy->normal_palette = geometry.normal_palette;
+    copy->color_palette = geometry.color_palette;
+    copy->tool_palette_map = geometry.tool_palette_map;
+    copy->strip_layer_index = geometry.strip_layer_index;
+    copy->layer_strip_ranges.assign(
+        geometry.layer_strip_ranges.begin(),
+        geometry.layer_strip_ranges.begin() +
+            static_cast<std::ptrdiff_t>(std::min(end_layer, geometry.layer_strip_ranges.size())));
+    copy->layer_bboxes.assign(
+        geometry.layer_bboxes.begin(),
+        geometry.layer_bboxes.begin() +
+            static_cast<std::ptrdiff_t>(std::min(end_layer, geometry.layer_bboxes.size())));
+    copy->max_layer_index = end_layer > 0 ? static_cast<uint16_t>(end_layer - 1) : 0;
+    copy->extrusion_triangle_count = geometry.extrusion_triangle_count;
+    copy->travel_triangle_count = geometry.travel_triangle_count;
+    copy->quantization = quant_params_;
+    copy->layer_height_mm = layer_height_mm_;
+    return copy;
+}
+
+void GeometryBuilder::build_layer_range(const ParsedGCodeFile& gcode, size_t first_layer,
+                                        size_t end_layer, const SimplificationOptions& options,
+                                        SharedBuildState& shared, LayerRangeBuild& out) {
+    RibbonGeometry& geometry = out.geometry;
+
+    // Collect this range's segments, stamping each with its source layer index
     std::vector<ToolpathSegment> all_segments;
-    for (size_t li = 0; li < gcode.layers.size(); ++li) {
+    for (size_t li = first_layer; li < end_layer; ++li) {
         for (const auto& seg : gcode.layers[li].segments) {
             all_segments.push_back(seg);
             all_segments.back().layer_index = static_cast<uint16_t>(li);
         }
     }
-
-    stats_.input_segments = all_segments.size();
-    spdlog::debug("[GCode::Builder] Collected {} total segments from {} layers",
-                  all_segments.size(), gcode.layers.size());
+    out.input_segments = all_segments.size();
 
     // Pre-filter: Remove degenerate (zero-length) segments before simplification
     size_t degenerate_count = 0;
@@ -486,30 +660,16 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
                                           return false; // Keep this segment
                                       }),
                        all_segments.end());
-
-    if (degenerate_count > 0) {
-        spdlog::debug("[GCode::Builder] Pre-filtered {} degenerate (zero-length) segments",
-                      degenerate_count);
-    }
+    out.degenerate_segments = degenerate_count;
 
     // Step 1: Simplify segments (merge collinear lines)
     std::vector<ToolpathSegment> simplified;
-    if (validated_opts.enable_merging) {
-        simplified = simplify_segments(all_segments, validated_opts);
-        stats_.output_segments = simplified.size();
-        stats_.simplification_ratio =
-            1.0f - (static_cast<float>(simplified.size()) / all_segments.size());
-
-        spdlog::info(
-            "[GCode::Builder] Toolpath simplification: {} → {} segments ({:.1f}% reduction)",
-            all_segments.size(), simplified.size(), stats_.simplification_ratio * 100.0f);
+    if (options.enable_merging) {
+        simplified = simplify_segments(all_segments, options);
     } else {
-        simplified = all_segments;
-        stats_.output_segments = simplified.size();
-        stats_.simplification_ratio = 0.0f;
-        spdlog::info("[GCode::Builder] Toolpath simplification DISABLED: using {} raw segments",
-                     simplified.size());
+        simplified = std::move(all_segments);
     }
+    out.output_segments = simplified.size();
 
     // Step 2: Generate ribbon geometry with vertex sharing
     // Track previous segment end vertices for reuse
@@ -519,13 +679,12 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
     // Layer tracking for ghost layer rendering
     // Temporary map to accumulate strips per layer, then convert to ranges
     std::unordered_map<uint16_t, std::vector<size_t>> layer_to_strip_indices;
-    geometry.max_layer_index =
-        gcode.layers.empty() ? 0 : static_cast<uint16_t>(gcode.layers.size() - 1);
 
     // Initialize per-layer bounding boxes for frustum culling
-    geometry.layer_bboxes.resize(gcode.layers.size());
+    geometry.layer_bboxes.resize(end_layer);
 
     size_t segments_since_budget_check = 0;
+    size_t reported_mem = 0;
 
     for (size_t i = 0; i < simplified.size(); ++i) {
         const auto& segment = simplified[i];
@@ -538,19 +697,25 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
             continue;
         }
 
-        // Progressive budget check
+        // Progressive budget check, against the memory of every range combined
         if (budget_limit_bytes_ > 0) {
             segments_since_budget_check++;
             if (segments_since_budget_check >= GeometryBudgetManager::CHECK_INTERVAL_SEGMENTS) {
                 segments_since_budget_check = 0;
+                if (shared.exceeded.load(std::memory_order_relaxed)) {
+                    break; // Another range already hit the budget
+                }
                 size_t current_mem = geometry.memory_usage();
+                size_t total_mem = shared.memory_bytes.fetch_add(current_mem - reported_mem) +
+                                   (current_mem - reported_mem);
+                reported_mem = current_mem;
                 float threshold = static_cast<float>(budget_limit_bytes_) *
                                   GeometryBudgetManager::BUDGET_THRESHOLD;
-                if (static_cast<float>(current_mem) > threshold) {
+                if (static_cast<float>(total_mem) > threshold) {
                     spdlog::warn("[GCode::Builder] Budget exceeded: {}MB / {}MB at segment {}/{}",
-                                 current_mem / (1024 * 1024), budget_limit_bytes_ / (1024 * 1024),
+                                 total_mem / (1024 * 1024), budget_limit_bytes_ / (1024 * 1024),
                                  i, simplified.size());
-                    budget_exceeded_ = true;
+                    shared.exceeded = true;
                     break;
                 }
 
@@ -559,7 +724,7 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
                     GeometryBudgetManager budget_mgr;
                     if (budget_mgr.is_system_memory_critical()) {
                         spdlog::error("[GCode::Builder] System memory critical — aborting build");
-                        budget_exceeded_ = true;
+                        shared.exceeded = true;
                         break;
                     }
                 }
@@ -614,7 +779,7 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
 
     // Build layer_strip_ranges from accumulated data
     // Initialize with empty ranges for all layers
-    geometry.layer_strip_ranges.resize(gcode.layers.size(), {0, 0});
+    geometry.layer_strip_ranges.resize(end_layer, {0, 0});
     size_t non_contiguous_layers = 0;
     for (const auto& [layer_idx, strip_indices] : layer_to_strip_indices) {
         if (!strip_indices.empty() && layer_idx < geometry.layer_strip_ranges.size()) {
@@ -641,32 +806,74 @@ RibbonGeometry GeometryBuilder::build(const ParsedGCodeFile& gcode,
                      "(using span-based ranges as fallback)",
                      non_contiguous_layers);
     }
+}
 
-    // Store quantization parameters for dequantization during rendering
-    geometry.quantization = quant_params_;
+void GeometryBuilder::append_layer_range(RibbonGeometry& geometry, LayerRangeBuild& range) {
+    RibbonGeometry& src = range.geometry;
+    src.layer_bboxes.resize(range.end_layer);
+    src.layer_strip_ranges.resize(range.end_layer, {0, 0});
 
-    // Store layer height for Z-offset calculations during LOD rendering
-    geometry.layer_height_mm = layer_height_mm_;
+    // First range: nothing to remap
+    if (geometry.vertices.empty() && geometry.normal_palette.empty() &&
+        geometry.color_palette.empty()) {
+        geometry = std::move(src);
+        return;
+    }
 
-    // Update final statistics
-    stats_.vertices_generated = geometry.vertices.size();
-    // Each TriangleStrip has 4 indices forming 2 triangles
-    stats_.triangles_generated = geometry.strips.size() * 2;
-    stats_.memory_bytes = geometry.memory_usage();
+    // Palettes: intern the stored values (already quantized) into the merged palettes
+    std::vector<uint16_t> normal_map(src.normal_palette.size());
+    for (size_t i = 0; i < src.normal_palette.size(); ++i) {
+        normal_map[i] = intern_normal(geometry, src.normal_palette[i]);
+    }
+    std::vector<uint8_t> color_map(src.color_palette.size());
+    for (size_t i = 0; i < src.color_palette.size(); ++i) {
+        color_map[i] = add_to_color_palette(geometry, src.color_palette[i]);
+    }
 
-    stats_.log();
+    auto vertex_offset = static_cast<uint32_t>(geometry.vertices.size());
+    size_t strip_offset = geometry.strips.size();
 
-    // Validate geometry integrity before returning
-    geometry.validate();
+    geometry.vertices.reserve(geometry.vertices.size() + src.vertices.size());
+    for (RibbonVertex vertex : src.vertices) {
+        vertex.normal_index = normal_map[vertex.normal_index];
+        vertex.color_index = color_map[vertex.color_index];
+        geometry.vertices.push_back(vertex);
+    }
+    geometry.strips.reserve(geometry.strips.size() + src.strips.size());
+    for (TriangleStrip strip : src.strips) {
+        for (auto& index : strip) {
+            index += vertex_offset;
+        }
+        geometry.strips.push_back(strip);
+    }
+    for (TriangleIndices tri : src.indices) {
+        for (auto& index : tri) {
+            index += vertex_offset;
+        }
+        geometry.indices.push_back(tri);
+    }
+    geometry.strip_layer_index.insert(geometry.strip_layer_index.end(),
+                                      src.strip_layer_index.begin(), src.strip_layer_index.end());
+
+    geometry.layer_bboxes.resize(range.end_layer);
+    geometry.layer_strip_ranges.resize(range.end_layer, {0, 0});
+    for (size_t li = range.first_layer; li < range.end_layer; ++li) {
+        geometry.layer_bboxes[li] = src.layer_bboxes[li];
+        auto [first, count] = src.layer_strip_ranges[li];
+        if (count > 0) {
+            geometry.layer_strip_ranges[li] = {first + strip_offset, count};
+        }
+    }
 
-    // End timing
-    auto build_end = std::chrono::high_resolution_clock::now();
-    auto build_duration =
-        std::chrono::duration_cast<std::chrono::milliseconds>(build_end - build_start);
-    spdlog::info("[GCode::Builder] Geometry build completed in {:.3f} seconds",
-                 build_duration.count() / 1000.0);
+    // Later ranges win, matching the last-write-wins order of a sequential build
+    for (const auto& [tool, color_idx] : src.tool_palette_map) {
+        geometry.tool_palette_map[tool] = color_map[color_idx];
+    }
 
-    return geometry;
+    geometry.extrusion_triangle_count += src.extrusion_triangle_count;
+    geometry.travel_triangle_count += src.travel_triangle_count;
+
+    src.clear();
 }
 
 // ============================================================================
@@ -849,12 +1056,11 @@ GeometryBuilder::generate_ribbon_vertices(const ToolpathSegment& segment, Ribbon
             face_colors[static_cast<size_t>(i)] = add_to_color_palette(geometry, color);
         }
 
-        static bool logged_once = false;
-        if (!logged_once) {
+        static std::atomic<bool> logged_once{false};
+        if (!logged_once.exchange(true)) {
             spdlog::debug("[GCode Geometry] DEBUG FACE COLORS ACTIVE: N={} faces, colors cycle "
                           "through Red/Yellow/Blue/Green",
                           N);
-            logged_once = true;
         }
     }
 
@@ -1098,11 +1304,10 @@ uint32_t GeometryBuilder::compute_color_rgb(float z_height, float z_min, float z
         uint32_t color = (static_cast<uint32_t>(filament_r_) << 16) |
                          (static_cast<uint32_t>(filament_g_) << 8) |
                          static_cast<uint32_t>(filament_b_);
-        static bool logged_once = false;
-        if (!logged_once) {
+        static std::atomic<bool> logged_once{false};
+        if (!logged_once.exchange(true)) {
             spdlog::debug("[GCode Geometry] compute_color_rgb: R={}, G={}, B={} -> 0x{:06X}",
                           filament_r_, filament_g_, filament_b_, color);
-            logged_once = true;
         }
         return color;
     }
@@ -1623,6 +1623,28 @@ void GCodeGLESRenderer::set_prebuilt_geometry(std::unique_ptr<RibbonGeometry> ge
                   geometry_ ? geometry_->vertices.size() : 0);
 }
 
+void GCodeGLESRenderer::extend_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry) {
+    size_t num_layers = geometry ? geometry->layer_strip_ranges.size() : 0;
+    if (!geometry_ || num_layers == 0 || num_layers < layer_vbos_.size()) {
+        set_prebuilt_geometry(std::move(geometry), current_filename_);
+        return;
+    }
+
+    // Layers already on the GPU are identical in the grown geometry; upload only the rest.
+    // Growing layer_vbos_ makes no GL calls, so it is safe outside the context.
+    size_t uploaded = geometry_uploaded_        ? layer_vbos_.size()
+                      : upload_total_layers_ > 0 ? upload_next_layer_
+                                                 : 0;
+    geometry_ = std::move(geometry);
+    layer_vbos_.resize(num_layers);
+    geometry_uploaded_ = false;
+    upload_next_layer_ = uploaded;
+    upload_total_layers_ = num_layers;
+    frame_dirty_ = true;
+    spdlog::debug("[GCode GLES] Geometry extended to {} layers ({} already uploaded)", num_layers,
+                  uploaded);
+}
+
 void GCodeGLESRenderer::set_prebuilt_coarse_geometry(std::unique_ptr<RibbonGeometry> /*geometry*/) {
     // Coarse LOD no longer used — GPU handles full geometry at full speed
 }
@@ -6,6 +6,7 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <system_error>
 
 namespace helix {
 namespace gcode {
@@ -15,46 +16,36 @@ GCodeLayerCache::GCodeLayerCache(size_t memory_budget_bytes) : memory_budget_(me
                   static_cast<double>(memory_budget_) / (1024 * 1024));
 }
 
-size_t GCodeLayerCache::estimate_memory(const std::vector<ToolpathSegment>& segments) {
-    // Base cost: vector overhead + segment data
-    // Each ToolpathSegment is approximately:
-    // - glm::vec3 start: 12 bytes
-    // - glm::vec3 end: 12 bytes
-    // - bool is_extrusion: 1 byte (+ padding)
-    // - std::string object_name: 32 bytes (SSO buffer) + potential heap
-    // - float extrusion_amount: 4 bytes
-    // - float width: 4 bytes
-    // - int tool_index: 4 bytes
-    // Total: ~80 bytes base + string heap allocation
-
-    size_t base_cost = sizeof(std::vector<ToolpathSegment>) + 64; // Vector overhead + some slack
-
-    size_t per_segment = BYTES_PER_SEGMENT;
-
-    // Add extra for segments with long object names
-    size_t string_overhead = 0;
-    for (const auto& seg : segments) {
-        if (seg.object_name.length() > 15) { // Beyond SSO threshold
-            string_overhead += seg.object_name.length() + 1;
-        }
+GCodeLayerCache::~GCodeLayerCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_prefetch_ = true;
+    }
+    prefetch_cv_.notify_all();
+    if (prefetch_thread_.joinable()) {
+        prefetch_thread_.join();
     }
+}
 
-    return base_cost + (segments.size() * per_segment) + string_overhead;
+size_t GCodeLayerCache::estimate_memory(const CompactSegments& segments) {
+    // Packed arrays (~14 bytes per segment) plus side tables and interned names,
+    // measured rather than estimated
+    return sizeof(CompactSegments) + segments.memory_bytes();
 }
 
 GCodeLayerCache::CacheResult
-GCodeLayerCache::get_or_load(size_t layer_index,
-                             std::function<std::vector<ToolpathSegment>(size_t)> loader) {
+GCodeLayerCache::get_or_load(size_t layer_index, std::function<CompactSegments(size_t)> loader) {
     // Periodically check memory pressure and adapt budget (rate-limited internally)
     check_memory_pressure();
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto start_time = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
 
     // Check if already cached
     auto it = cache_.find(layer_index);
     if (it != cache_.end()) {
-        hit_count_++;
-        touch(layer_index);
+        stats_.hits++;
+        record_hit(layer_index, it->second);
         spdlog::trace("[LayerCache] Hit layer {} ({} segments)", layer_index,
                       it->second.segments->size());
         // Return shared_ptr - data stays alive even if entry is evicted
@@ -62,15 +53,55 @@ GCodeLayerCache::get_or_load(size_t layer_index,
     }
 
     // Cache miss - need to load
-    miss_count_++;
+    stats_.misses++;
+    auto record_stall = [this, start_time]() {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                              start_time)
+                        .count();
+        stats_.total_stall_ms += ms;
+        stats_.max_stall_ms = std::max(stats_.max_stall_ms, ms);
+    };
+
+    // Already being loaded (usually by the prefetcher): wait for it rather than load twice
+    if (loading_.count(layer_index) != 0) {
+        spdlog::debug("[LayerCache] Miss layer {}, waiting for load in progress", layer_index);
+        loaded_cv_.wait(lock, [this, layer_index]() { return loading_.count(layer_index) == 0; });
+        it = cache_.find(layer_index);
+        if (it != cache_.end()) {
+            record_hit(layer_index, it->second);
+            record_stall();
+            return CacheResult{it->second.segments, false, false};
+        }
+        // That load failed or was dropped; try again ourselves
+    }
+
     spdlog::debug("[LayerCache] Miss layer {}, loading...", layer_index);
+    CacheResult result = load_and_insert(layer_index, loader, lock, false);
+    record_stall();
+    return result;
+}
+
+GCodeLayerCache::CacheResult GCodeLayerCache::load_and_insert(
+    size_t layer_index, const std::function<CompactSegments(size_t)>& loader,
+    std::unique_lock<std::mutex>& lock, bool prefetched) {
+    // Parse without the lock so hits on other layers are not held up
+    loading_.insert(layer_index);
+    uint64_t generation = clear_generation_;
+    lock.unlock();
 
-    // Load the layer data
-    std::vector<ToolpathSegment> segments;
+    CompactSegments segments;
+    bool failed = false;
     try {
         segments = loader(layer_index);
     } catch (const std::exception& e) {
         spdlog::error("[LayerCache] Failed to load layer {}: {}", layer_index, e.what());
+        failed = true;
+    }
+
+    lock.lock();
+    loading_.erase(layer_index);
+    loaded_cv_.notify_all();
+    if (failed) {
         return CacheResult{nullptr, false, true};
     }
 
@@ -92,24 +123,35 @@ GCodeLayerCache::get_or_load(size_t layer_index,
         return CacheResult{nullptr, false, true};
     }
 
+    auto shared = std::make_shared<CompactSegments>(std::move(segments));
+
+    // Cleared while loading (e.g. a different file was opened): hand back, don't cache
+    if (generation != clear_generation_) {
+        return CacheResult{shared, false, false};
+    }
+
     // Make room if needed
     evict_for_space(needed);
 
     // Insert into cache - use shared_ptr for thread-safe lifetime management
     CacheEntry entry;
-    entry.segments = std::make_shared<std::vector<ToolpathSegment>>(std::move(segments));
+    entry.segments = shared;
     entry.memory_bytes = needed;
+    entry.prefetched = prefetched;
 
     auto [inserted_it, success] = cache_.emplace(layer_index, std::move(entry));
     if (!success) {
-        spdlog::error("[LayerCache] Failed to insert layer {} into cache", layer_index);
-        return CacheResult{nullptr, false, true};
+        // insert() got there first
+        return CacheResult{inserted_it->second.segments, false, false};
     }
 
     // Add to LRU tracking
     lru_order_.push_front(layer_index);
     lru_map_[layer_index] = lru_order_.begin();
     current_memory_ += needed;
+    if (prefetched) {
+        stats_.prefetch_loads++;
+    }
 
     spdlog::debug("[LayerCache] Cached layer {} ({} segments, {} bytes, total {:.1f}MB)",
                   layer_index, inserted_it->second.segments->size(), needed,
@@ -119,13 +161,22 @@ GCodeLayerCache::get_or_load(size_t layer_index,
     return CacheResult{inserted_it->second.segments, false, false};
 }
 
+void GCodeLayerCache::record_hit(size_t layer_index, CacheEntry& entry) {
+    // Already holding lock when called
+    if (entry.prefetched) {
+        entry.prefetched = false;
+        stats_.prefetch_hits++;
+    }
+    touch(layer_index);
+}
+
 bool GCodeLayerCache::is_cached(size_t layer_index) const {
     std::lock_guard<std::mutex> lock(mutex_);
     return cache_.find(layer_index) != cache_.end();
 }
 
 void GCodeLayerCache::prefetch(size_t center_layer, size_t radius,
-                               std::function<std::vector<ToolpathSegment>(size_t)> loader,
+                               std::function<CompactSegments(size_t)> loader,
                                size_t max_layer) {
     // Calculate range
     size_t start = (center_layer > radius) ? (center_layer - radius) : 0;
@@ -133,13 +184,122 @@ void GCodeLayerCache::prefetch(size_t center_layer, size_t radius,
 
     spdlog::debug("[LayerCache] Prefetching layers [{}, {}] around {}", start, end, center_layer);
 
-    // Load layers - get_or_load handles "already cached" internally, avoiding TOCTOU race
+    std::unique_lock<std::mutex> lock(mutex_);
     for (size_t i = start; i <= end; ++i) {
-        get_or_load(i, loader);
+        if (cache_.count(i) == 0 && loading_.count(i) == 0) {
+            load_and_insert(i, loader, lock, true);
+        }
     }
 }
 
-bool GCodeLayerCache::insert(size_t layer_index, std::vector<ToolpathSegment>&& segments) {
+void GCodeLayerCache::prefetch_async(size_t center_layer, size_t radius,
+                                     std::function<CompactSegments(size_t)> loader,
+                                     size_t max_layer) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_prefetch_) {
+        return;
+    }
+
+    // Same view as last time: keep working through the queue already there
+    if (last_prefetch_center_ == center_layer) {
+        return;
+    }
+    if (last_prefetch_center_) {
+        scrub_direction_ = center_layer > *last_prefetch_center_ ? 1 : -1;
+    }
+    last_prefetch_center_ = center_layer;
+
+    // Whatever is still queued was for a layer the user has scrolled past
+    stats_.prefetch_cancelled += prefetch_queue_.size();
+    prefetch_queue_ = {};
+    prefetch_loader_ = std::move(loader);
+
+    // Rank: center, then ahead of the scrub before behind it; alternate when direction unknown
+    auto queue_layer = [this, max_layer](size_t layer, size_t rank) {
+        if (layer <= max_layer && cache_.count(layer) == 0) {
+            prefetch_queue_.push({rank, layer});
+        }
+    };
+    queue_layer(center_layer, 0);
+    for (size_t d = 1; d <= radius; ++d) {
+        size_t ahead = d;
+        size_t behind = radius + d;
+        size_t above_rank = scrub_direction_ > 0 ? ahead : behind;
+        size_t below_rank = scrub_direction_ < 0 ? ahead : behind;
+        if (scrub_direction_ == 0) {
+            above_rank = 2 * d - 1;
+            below_rank = 2 * d;
+        }
+        queue_layer(center_layer + d, above_rank);
+        if (center_layer >= d) {
+            queue_layer(center_layer - d, below_rank);
+        }
+    }
+    if (prefetch_queue_.empty()) {
+        return;
+    }
+
+    if (!prefetch_thread_.joinable()) {
+        try {
+            prefetch_thread_ = std::thread(&GCodeLayerCache::prefetch_worker, this);
+        } catch (const std::system_error& e) {
+            // No thread to spare: load on the caller, as prefetch() does
+            spdlog::warn("[LayerCache] Prefetch thread unavailable ({}), loading inline",
+                         e.what());
+            auto inline_loader = prefetch_loader_;
+            while (!prefetch_queue_.empty()) {
+                size_t layer = prefetch_queue_.top().layer;
+                prefetch_queue_.pop();
+                if (cache_.count(layer) == 0 && loading_.count(layer) == 0) {
+                    load_and_insert(layer, inline_loader, lock, true);
+                }
+            }
+            return;
+        }
+    }
+    lock.unlock();
+    prefetch_cv_.notify_one();
+}
+
+void GCodeLayerCache::prefetch_worker() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        prefetch_cv_.wait(lock, [this]() { return stop_prefetch_ || !prefetch_queue_.empty(); });
+        if (stop_prefetch_) {
+            return;
+        }
+
+        size_t layer = prefetch_queue_.top().layer;
+        prefetch_queue_.pop();
+        if (cache_.count(layer) == 0 && loading_.count(layer) == 0) {
+            // Copy: the next prefetch_async() may replace the loader while this one runs
+            auto loader = prefetch_loader_;
+            prefetch_busy_ = true;
+            load_and_insert(layer, loader, lock, true);
+            prefetch_busy_ = false;
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+void GCodeLayerCache::cancel_prefetch() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats_.prefetch_cancelled += prefetch_queue_.size();
+    prefetch_queue_ = {};
+    prefetch_loader_ = nullptr;
+    last_prefetch_center_.reset();
+    scrub_direction_ = 0;
+    idle_cv_.wait(lock, [this]() { return !prefetch_busy_; });
+}
+
+bool GCodeLayerCache::wait_for_prefetch(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_cv_.wait_for(lock, timeout, [this]() {
+        return prefetch_queue_.empty() && !prefetch_busy_;
+    });
+}
+
+bool GCodeLayerCache::insert(size_t layer_index, CompactSegments&& segments) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Check if already cached
@@ -163,7 +323,7 @@ bool GCodeLayerCache::insert(size_t layer_index, std::vector<ToolpathSegment>&&
 
     // Insert - use shared_ptr for thread-safe lifetime management
     CacheEntry entry;
-    entry.segments = std::make_shared<std::vector<ToolpathSegment>>(std::move(segments));
+    entry.segments = std::make_shared<CompactSegments>(std::move(segments));
     entry.memory_bytes = needed;
 
     cache_.emplace(layer_index, std::move(entry));
@@ -181,6 +341,8 @@ void GCodeLayerCache::clear() {
     lru_order_.clear();
     lru_map_.clear();
     current_memory_ = 0;
+    clear_generation_++;
+    last_prefetch_center_.reset();
 
     spdlog::debug("[LayerCache] Cleared");
 }
@@ -220,24 +382,23 @@ size_t GCodeLayerCache::cached_layer_count() const {
     return cache_.size();
 }
 
-std::pair<size_t, size_t> GCodeLayerCache::hit_stats() const {
+GCodeLayerCache::HitStats GCodeLayerCache::hit_stats() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return {hit_count_, miss_count_};
+    return stats_;
 }
 
 float GCodeLayerCache::hit_rate() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    size_t total = hit_count_ + miss_count_;
+    size_t total = stats_.hits + stats_.misses;
     if (total == 0) {
         return 0.0f;
     }
-    return static_cast<float>(hit_count_) / static_cast<float>(total);
+    return static_cast<float>(stats_.hits) / static_cast<float>(total);
 }
 
 void GCodeLayerCache::reset_stats() {
     std::lock_guard<std::mutex> lock(mutex_);
-    hit_count_ = 0;
-    miss_count_ = 0;
+    stats_ = HitStats{};
 }
 
 void GCodeLayerCache::set_memory_budget(size_t budget_bytes) {
@@ -3,6 +3,10 @@
 
 #include "gcode_layer_index.h"
 
+#include "gcode_mapped_file.h"
+#include "gcode_parallel.h"
+#include "gcode_tokenizer.h"
+
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
@@ -20,6 +24,18 @@ namespace {
 // Layer detection tolerance for Z changes
 constexpr float Z_EPSILON = 0.001f;
 
+// Trailing bytes searched for footer metadata (filament color)
+constexpr uint64_t FOOTER_SCAN_BYTES = 32768;
+
+// File read size for build_from_file() when the file cannot be mapped
+constexpr size_t READ_CHUNK_BYTES = 64 * 1024;
+
+// Smallest share of a mapped file worth a scanning thread of its own
+constexpr size_t MIN_PARALLEL_CHUNK_BYTES = 4 * 1024 * 1024;
+
+// Header lines searched for metadata (filament color)
+constexpr uint64_t HEADER_SCAN_LINES = 999;
+
 // Extract float parameter from G-code line (e.g., "Z1.2" -> 1.2)
 bool extract_z_param(const char* line, size_t len, float& out_z) {
     // Find 'Z' parameter (case-insensitive)
@@ -28,9 +44,7 @@ bool extract_z_param(const char* line, size_t len, float& out_z) {
             // Check if followed by a digit or sign
             char next = line[i + 1];
             if (next == '-' || next == '+' || next == '.' || (next >= '0' && next <= '9')) {
-                char* end = nullptr;
-                out_z = std::strtof(line + i + 1, &end);
-                if (end != line + i + 1) {
+                if (parse_float(std::string_view(line + i + 1, len - i - 1), out_z) != 0) {
                     return true;
                 }
             }
@@ -101,11 +115,12 @@ bool extract_filament_color(const char* line, size_t len, std::string& out_color
     lower[check_len] = '\0';
 
     // Look for color keywords
+    const char* line_end = line + len;
     const char* color_pos = nullptr;
     if (std::strstr(lower, "extruder_colour") || std::strstr(lower, "extruder_color")) {
-        color_pos = std::strchr(line, '=');
+        color_pos = static_cast<const char*>(std::memchr(line, '=', len));
     } else if (std::strstr(lower, "filament_colour") || std::strstr(lower, "filament_color")) {
-        color_pos = std::strchr(line, '=');
+        color_pos = static_cast<const char*>(std::memchr(line, '=', len));
     }
 
     if (!color_pos) {
@@ -114,12 +129,14 @@ bool extract_filament_color(const char* line, size_t len, std::string& out_color
 
     // Find the hex color after '='
     ++color_pos; // Skip '='
-    while (*color_pos && (*color_pos == ' ' || *color_pos == '"' || *color_pos == '\'')) {
+    while (color_pos < line_end &&
+           (*color_pos == ' ' || *color_pos == '"' || *color_pos == '\'')) {
         ++color_pos;
     }
 
     // Look for '#' followed by hex digits
-    const char* hash = std::strchr(color_pos, '#');
+    const char* hash =
+        static_cast<const char*>(std::memchr(color_pos, '#', line_end - color_pos));
     if (!hash) {
         return false;
     }
@@ -127,7 +144,7 @@ bool extract_filament_color(const char* line, size_t len, std::string& out_color
     // Extract 6 or 8 hex digits after #
     std::string color = "#";
     const char* p = hash + 1;
-    while (*p &&
+    while (p < line_end &&
            ((*p >= '0' && *p <= '9') || (*p >= 'A' && *p <= 'F') || (*p >= 'a' && *p <= 'f'))) {
         color += *p;
         ++p;
@@ -147,8 +164,7 @@ bool extract_filament_color(const char* line, size_t len, std::string& out_color
 // Check if line is a layer change marker
 bool is_layer_marker(const char* line, size_t len) {
     // Look for ;LAYER_CHANGE or ; LAYER_CHANGE
-    const char* pos = std::strstr(line, "LAYER_CHANGE");
-    if (pos && pos < line + len) {
+    if (std::string_view(line, len).find("LAYER_CHANGE") != std::string_view::npos) {
         return true;
     }
     // Also check lowercase
@@ -181,151 +197,362 @@ bool is_layer_marker(const char* line, size_t len) {
     return false;
 }
 
-} // anonymous namespace
+/**
+ * @brief What one thread found in its share of a mapped file
+ *
+ * Layer detection depends on everything before a line, so chunks record the
+ * marker and Z events the state machine needs, and LayerIndexScanner replays
+ * them in file order. Events that cannot change the outcome are dropped here:
+ * after the chunk's first marker only the first Z move following each marker
+ * counts, and before it only Z moves that rise above every earlier one in the
+ * chunk can start a layer. That keeps the event list close to the layer count.
+ */
+struct ChunkScan {
+    struct Event {
+        uint64_t offset; ///< File offset of the line
+        uint64_t line;   ///< Line number within the chunk
+        float z;         ///< Z height (Z moves only)
+        bool marker;     ///< ;LAYER_CHANGE marker rather than a Z move
+    };
+
+    struct Color {
+        uint64_t offset;
+        uint64_t line;
+        std::string color;
+    };
+
+    std::vector<Event> events;
+    std::vector<Color> colors; ///< Color metadata candidates, filtered when stitched
+    uint64_t lines{0};
+    size_t extrusion_moves{0};
+    size_t travel_moves{0};
+};
+
+ChunkScan scan_chunk(const char* data, size_t size, uint64_t base_offset,
+                     uint64_t expected_bytes) {
+    ChunkScan result;
+    bool seen_marker = false;
+    bool pending = false;
+    bool seen_z = false;
+    float max_z = 0.0f;
+
+    const char* end = data + size;
+    uint64_t offset = base_offset;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        size_t len = static_cast<size_t>((newline ? newline : end) - data);
+        uint64_t line = result.lines++;
+
+        if (is_layer_marker(data, len)) {
+            if (!pending) {
+                result.events.push_back({offset, line, 0.0f, true});
+            }
+            seen_marker = true;
+            pending = true;
+        }
 
-bool GCodeLayerIndex::build_from_file(const std::string& filepath) {
-    auto start_time = std::chrono::high_resolution_clock::now();
+        // Global line numbers are only known once chunks are stitched; this is a
+        // superset of the lines LayerIndexScanner checks
+        if (line < HEADER_SCAN_LINES ||
+            (expected_bytes > 0 && offset + FOOTER_SCAN_BYTES >= expected_bytes)) {
+            std::string color;
+            if (extract_filament_color(data, len, color)) {
+                result.colors.push_back({offset, line, std::move(color)});
+            }
+        }
 
-    // Clear any previous data
-    entries_.clear();
-    stats_ = LayerIndexStats{};
-    source_path_ = filepath;
+        if (is_movement_command(data, len)) {
+            float z;
+            if (extract_z_param(data, len, z)) {
+                if (seen_marker) {
+                    if (pending) {
+                        result.events.push_back({offset, line, z, false});
+                        pending = false;
+                    }
+                } else if (!seen_z || z > max_z) {
+                    result.events.push_back({offset, line, z, false});
+                    seen_z = true;
+                    max_z = z;
+                }
+            }
 
-    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        spdlog::error("[LayerIndex] Failed to open file: {}", filepath);
-        return false;
+            if (has_positive_extrusion(data, len)) {
+                result.extrusion_moves++;
+            } else {
+                result.travel_moves++;
+            }
+        }
+
+        offset += len + 1;
+        data = newline ? newline + 1 : end;
     }
+    return result;
+}
 
-    // Get file size
-    stats_.total_bytes = static_cast<size_t>(file.tellg());
-    file.seekg(0, std::ios::beg);
+} // anonymous namespace
 
-    spdlog::debug("[LayerIndex] Building index for {} ({} bytes)", filepath, stats_.total_bytes);
+// =============================================================================
+// LayerIndexScanner
+// =============================================================================
 
+LayerIndexScanner::LayerIndexScanner(uint64_t expected_bytes)
+    : expected_bytes_(expected_bytes), current_z_(-std::numeric_limits<float>::infinity()) {
     // Reserve estimated capacity (assume ~100 layers for now)
     entries_.reserve(100);
+    line_.reserve(256);
+}
 
-    // Read line by line
-    std::string line;
-    line.reserve(256);
-
-    float current_z = -std::numeric_limits<float>::infinity();
-    uint64_t current_layer_start = 0;
-    uint64_t current_offset = 0;
-    uint16_t current_layer_lines = 0;
-    bool use_layer_markers = false;
-    bool pending_layer_start = false;
-    bool first_layer_started = false;
-
-    while (std::getline(file, line)) {
-        size_t line_len = line.length();
-        stats_.total_lines++;
-
-        // Check for layer marker
-        if (is_layer_marker(line.c_str(), line_len)) {
-            use_layer_markers = true;
-            pending_layer_start = true;
-            // We'll start the new layer when we see the next Z move
+void LayerIndexScanner::feed(const char* data, size_t size) {
+    if (finished_) {
+        return;
+    }
+    bytes_scanned_ += size;
+
+    const char* end = data + size;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        if (!newline) {
+            // Incomplete line: keep it for the next chunk
+            line_.append(data, end - data);
+            return;
         }
+        if (line_.empty()) {
+            scan_line(data, newline - data);
+        } else {
+            line_.append(data, newline - data);
+            scan_line(line_.data(), line_.length());
+            line_.clear();
+        }
+        data = newline + 1;
+    }
+}
 
-        // Extract filament color from metadata (only if not already found)
-        // Only check comment lines in the header (first ~1000 lines)
-        if (stats_.filament_color.empty() && stats_.total_lines < 1000) {
-            std::string color;
-            if (extract_filament_color(line.c_str(), line_len, color)) {
-                stats_.filament_color = color;
-                spdlog::debug("[LayerIndex] Found filament color: {}", color);
+void LayerIndexScanner::scan_buffer(const char* data, size_t size, unsigned threads) {
+    if (finished_) {
+        return;
+    }
+    if (threads <= 1 || bytes_scanned_ > 0) {
+        feed(data, size);
+        finish();
+        return;
+    }
+
+    // Split into roughly equal chunks that end on line boundaries
+    std::vector<size_t> bounds{0};
+    for (unsigned i = 1; i < threads; ++i) {
+        size_t target = std::max(bounds.back(), static_cast<size_t>(size * uint64_t{i} / threads));
+        const void* newline = std::memchr(data + target, '\n', size - target);
+        if (!newline) {
+            break;
+        }
+        size_t boundary = static_cast<const char*>(newline) - data + 1;
+        if (boundary > bounds.back() && boundary < size) {
+            bounds.push_back(boundary);
+        }
+    }
+    bounds.push_back(size);
+
+    size_t chunk_count = bounds.size() - 1;
+    std::vector<ChunkScan> chunks(chunk_count);
+    auto scan = [&](size_t i) {
+        chunks[i] = scan_chunk(data + bounds[i], bounds[i + 1] - bounds[i], bounds[i],
+                               expected_bytes_);
+    };
+
+    parallel_for(chunk_count, scan);
+
+    // Stitch: replay each chunk's events through the same state machine as scan_line()
+    uint64_t line_base = 0;
+    for (const ChunkScan& chunk : chunks) {
+        for (const ChunkScan::Event& event : chunk.events) {
+            if (event.marker) {
+                on_layer_marker();
+            } else {
+                on_z_move(event.z, event.offset, line_base + event.line);
+            }
+        }
+        for (const ChunkScan::Color& candidate : chunk.colors) {
+            if (stats_.filament_color.empty() &&
+                in_metadata_region(line_base + candidate.line, candidate.offset)) {
+                stats_.filament_color = candidate.color;
+                spdlog::debug("[LayerIndex] Found filament color: {}", candidate.color);
             }
         }
+        stats_.extrusion_moves += chunk.extrusion_moves;
+        stats_.travel_moves += chunk.travel_moves;
+        line_base += chunk.lines;
+    }
+    stats_.total_lines = static_cast<size_t>(line_base);
+    bytes_scanned_ = size;
+    current_offset_ = size;
+    finish();
+}
 
-        // Check for movement commands
-        if (is_movement_command(line.c_str(), line_len)) {
-            float z;
-            if (extract_z_param(line.c_str(), line_len, z)) {
-                // Z change detected
-                bool is_new_layer = false;
-
-                if (use_layer_markers) {
-                    // Use marker-based layer detection
-                    if (pending_layer_start) {
-                        is_new_layer = true;
-                        pending_layer_start = false;
-                    }
-                } else {
-                    // Use Z-change based layer detection
-                    if (z > current_z + Z_EPSILON) {
-                        is_new_layer = true;
-                    }
-                }
+void LayerIndexScanner::finish() {
+    if (finished_) {
+        return;
+    }
 
-                if (is_new_layer) {
-                    // Finalize previous layer if any
-                    if (first_layer_started && current_layer_lines > 0) {
-                        StreamingLayerEntry& last = entries_.back();
-                        last.byte_length =
-                            static_cast<uint32_t>(current_offset - current_layer_start);
-                        last.line_count = current_layer_lines;
-                    }
+    // A last line without a trailing newline still counts
+    if (!line_.empty()) {
+        scan_line(line_.data(), line_.length());
+        line_.clear();
+    }
+    finished_ = true;
+    stats_.total_bytes = static_cast<size_t>(bytes_scanned_);
 
-                    // Start new layer
-                    StreamingLayerEntry entry{};
-                    entry.file_offset = current_offset;
-                    entry.z_height = z;
-                    entry.byte_length = 0; // Will be filled when layer ends
-                    entry.line_count = 0;  // Will be filled when layer ends
-                    entry.flags = 0;
-                    entries_.push_back(entry);
-
-                    if (!first_layer_started) {
-                        stats_.min_z = z;
-                        first_layer_started = true;
-                    }
-                    stats_.max_z = z;
+    // Finalize last layer
+    if (first_layer_started_ && !entries_.empty()) {
+        StreamingLayerEntry& last = entries_.back();
+        last.byte_length = static_cast<uint32_t>(bytes_scanned_ - current_layer_start_);
+        last.line_count = static_cast<uint16_t>(stats_.total_lines - current_layer_start_line_);
+    }
 
-                    current_z = z;
-                    current_layer_start = current_offset;
-                    current_layer_lines = 0;
-                }
-            }
+    stats_.total_layers = entries_.size();
+}
 
-            // Track extrusion vs travel
-            if (has_positive_extrusion(line.c_str(), line_len)) {
-                stats_.extrusion_moves++;
-            } else {
-                stats_.travel_moves++;
-            }
+bool LayerIndexScanner::in_metadata_region(uint64_t line, uint64_t offset) const {
+    // Header (first ~1000 lines) and, when the file size is known, the footer
+    // (OrcaSlicer puts metadata at the end)
+    return line < HEADER_SCAN_LINES ||
+           (expected_bytes_ > 0 && offset + FOOTER_SCAN_BYTES >= expected_bytes_);
+}
+
+void LayerIndexScanner::scan_line(const char* line, size_t line_len) {
+    uint64_t line_index = stats_.total_lines++;
+
+    // Check for layer marker
+    if (is_layer_marker(line, line_len)) {
+        on_layer_marker();
+    }
+
+    // Extract filament color from metadata (only if not already found)
+    if (stats_.filament_color.empty() && in_metadata_region(line_index, current_offset_)) {
+        std::string color;
+        if (extract_filament_color(line, line_len, color)) {
+            stats_.filament_color = color;
+            spdlog::debug("[LayerIndex] Found filament color: {}", color);
+        }
+    }
+
+    // Check for movement commands
+    if (is_movement_command(line, line_len)) {
+        float z;
+        if (extract_z_param(line, line_len, z)) {
+            on_z_move(z, current_offset_, line_index);
         }
 
-        current_layer_lines++;
-        // Account for line length + newline character
-        current_offset += line_len + 1;
+        // Track extrusion vs travel
+        if (has_positive_extrusion(line, line_len)) {
+            stats_.extrusion_moves++;
+        } else {
+            stats_.travel_moves++;
+        }
     }
 
-    // Finalize last layer
-    if (first_layer_started && !entries_.empty()) {
+    // Account for line length + newline character
+    current_offset_ += line_len + 1;
+}
+
+void LayerIndexScanner::on_layer_marker() {
+    use_layer_markers_ = true;
+    pending_layer_start_ = true;
+    // We'll start the new layer when we see the next Z move
+}
+
+void LayerIndexScanner::on_z_move(float z, uint64_t offset, uint64_t line) {
+    // Z change detected
+    bool is_new_layer = false;
+
+    if (use_layer_markers_) {
+        // Use marker-based layer detection
+        if (pending_layer_start_) {
+            is_new_layer = true;
+            pending_layer_start_ = false;
+        }
+    } else {
+        // Use Z-change based layer detection
+        if (z > current_z_ + Z_EPSILON) {
+            is_new_layer = true;
+        }
+    }
+
+    if (!is_new_layer) {
+        return;
+    }
+
+    // Finalize previous layer if any
+    auto previous_lines = static_cast<uint16_t>(line - current_layer_start_line_);
+    if (first_layer_started_ && previous_lines > 0) {
         StreamingLayerEntry& last = entries_.back();
-        last.byte_length = static_cast<uint32_t>(stats_.total_bytes - current_layer_start);
-        last.line_count = current_layer_lines;
+        last.byte_length = static_cast<uint32_t>(offset - current_layer_start_);
+        last.line_count = previous_lines;
     }
 
-    stats_.total_layers = entries_.size();
+    // Start new layer
+    StreamingLayerEntry entry{};
+    entry.file_offset = offset;
+    entry.z_height = z;
+    entry.byte_length = 0; // Will be filled when layer ends
+    entry.line_count = 0;  // Will be filled when layer ends
+    entry.flags = 0;
+    entries_.push_back(entry);
+
+    if (!first_layer_started_) {
+        stats_.min_z = z;
+        first_layer_started_ = true;
+    }
+    stats_.max_z = z;
 
-    // If no filament color found in header, scan the file footer (OrcaSlicer puts metadata at end)
-    if (stats_.filament_color.empty() && stats_.total_bytes > 0) {
-        // Read last 32KB of file to find metadata
-        size_t footer_size = std::min(stats_.total_bytes, size_t(32768));
-        file.clear();
-        file.seekg(-static_cast<std::streamoff>(footer_size), std::ios::end);
+    current_z_ = z;
+    current_layer_start_ = offset;
+    current_layer_start_line_ = line;
+}
 
-        while (std::getline(file, line)) {
-            std::string color;
-            if (extract_filament_color(line.c_str(), line.length(), color)) {
-                stats_.filament_color = color;
-                spdlog::debug("[LayerIndex] Found filament color in footer: {}", color);
-                break;
-            }
+// =============================================================================
+// GCodeLayerIndex
+// =============================================================================
+
+bool GCodeLayerIndex::build_from_file(const std::string& filepath, unsigned max_threads) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Clear any previous data
+    clear();
+    source_path_ = filepath;
+
+    MappedFile mapped;
+    if (mapped.open(filepath)) {
+        unsigned threads =
+            parallel_thread_count(max_threads, mapped.size(), MIN_PARALLEL_CHUNK_BYTES);
+
+        spdlog::debug("[LayerIndex] Building index for {} ({} bytes, mapped, {} threads)",
+                      filepath, mapped.size(), threads);
+
+        LayerIndexScanner scanner(mapped.size());
+        scanner.scan_buffer(mapped.data(), mapped.size(), threads);
+        sync_from(scanner);
+    } else {
+        // Fallback: stream the file through the scanner
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            spdlog::error("[LayerIndex] Failed to open file: {}", filepath);
+            return false;
+        }
+
+        // Get file size
+        auto file_size = static_cast<uint64_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        spdlog::debug("[LayerIndex] Building index for {} ({} bytes)", filepath, file_size);
+
+        LayerIndexScanner scanner(file_size);
+        std::vector<char> buffer(READ_CHUNK_BYTES);
+        while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) ||
+               file.gcount() > 0) {
+            scanner.feed(buffer.data(), static_cast<size_t>(file.gcount()));
         }
+        scanner.finish();
+        sync_from(scanner);
     }
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -341,6 +568,21 @@ bool GCodeLayerIndex::build_from_file(const std::string& filepath) {
     return !entries_.empty();
 }
 
+size_t GCodeLayerIndex::sync_from(const LayerIndexScanner& scanner) {
+    const auto& entries = scanner.entries();
+    size_t complete = scanner.complete_layers();
+    size_t added = 0;
+    if (complete > entries_.size()) {
+        added = complete - entries_.size();
+        entries_.insert(entries_.end(), entries.begin() + entries_.size(),
+                        entries.begin() + complete);
+    }
+    if (scanner.is_finished()) {
+        stats_ = scanner.stats();
+    }
+    return added;
+}
+
 StreamingLayerEntry GCodeLayerIndex::get_entry(size_t layer_index) const {
     if (layer_index < entries_.size()) {
         return entries_[layer_index];
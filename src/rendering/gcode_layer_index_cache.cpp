@@ -0,0 +1,337 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_layer_index_cache.h"
+
+#include "app_globals.h"
+#include "cache_dir_utils.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+// "HXLIDX" + format version; bump the version when the layout changes
+constexpr char SIDECAR_MAGIC[8] = {'H', 'X', 'L', 'I', 'D', 'X', 0, 1};
+
+// Serialized StreamingLayerEntry: offset, length, z, line_count, flags
+constexpr size_t ENTRY_BYTES = 8 + 4 + 4 + 2 + 2;
+
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// Appends fixed-size fields to a byte buffer
+class SidecarWriter {
+  public:
+    template <typename T> void put(T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer_.append(bytes, sizeof(T));
+    }
+
+    void put_string(const std::string& value) {
+        put(static_cast<uint32_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    std::string& buffer() {
+        return buffer_;
+    }
+
+  private:
+    std::string buffer_;
+};
+
+/// Reads fields back, failing (rather than overrunning) on truncated input
+class SidecarReader {
+  public:
+    SidecarReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T> bool get(T& value) {
+        if (size_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool get_string(std::string& value) {
+        uint32_t len = 0;
+        if (!get(len) || size_ - pos_ < len) {
+            return false;
+        }
+        value.assign(data_ + pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+    size_t remaining() const {
+        return size_ - pos_;
+    }
+
+  private:
+    const char* data_;
+    size_t size_;
+    size_t pos_{0};
+};
+
+std::string serialize(const GCodeFileIdentity& identity, const GCodeLayerIndex& index) {
+    const auto& stats = index.get_stats();
+    const auto& entries = index.entries();
+
+    SidecarWriter out;
+    out.buffer().reserve(128 + identity.path.size() + entries.size() * ENTRY_BYTES);
+    out.buffer().append(SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC));
+    out.put_string(identity.path);
+    out.put(identity.size);
+    out.put(identity.mtime_ns);
+    out.put(identity.fingerprint);
+
+    out.put(static_cast<uint64_t>(stats.total_lines));
+    out.put(static_cast<uint64_t>(stats.total_bytes));
+    out.put(static_cast<uint64_t>(stats.extrusion_moves));
+    out.put(static_cast<uint64_t>(stats.travel_moves));
+    out.put(stats.min_z);
+    out.put(stats.max_z);
+    out.put_string(stats.filament_color);
+
+    out.put(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        out.put(entry.file_offset);
+        out.put(entry.byte_length);
+        out.put(entry.z_height);
+        out.put(entry.line_count);
+        out.put(entry.flags);
+    }
+
+    // Trailing checksum catches torn writes and bit rot
+    out.put(fnv1a_hash(out.buffer().data(), out.buffer().size()));
+    return std::move(out.buffer());
+}
+
+bool deserialize(const std::string& data, const GCodeFileIdentity& expected,
+                 std::vector<StreamingLayerEntry>& entries, LayerIndexStats& stats) {
+    if (data.size() < sizeof(SIDECAR_MAGIC) + sizeof(uint64_t) ||
+        std::memcmp(data.data(), SIDECAR_MAGIC, sizeof(SIDECAR_MAGIC)) != 0) {
+        return false;
+    }
+    size_t body_size = data.size() - sizeof(uint64_t);
+    uint64_t checksum = 0;
+    std::memcpy(&checksum, data.data() + body_size, sizeof(checksum));
+    if (checksum != fnv1a_hash(data.data(), body_size)) {
+        return false;
+    }
+
+    SidecarReader in(data.data() + sizeof(SIDECAR_MAGIC), body_size - sizeof(SIDECAR_MAGIC));
+    GCodeFileIdentity identity;
+    if (!in.get_string(identity.path) || !in.get(identity.size) || !in.get(identity.mtime_ns) ||
+        !in.get(identity.fingerprint) || !(identity == expected)) {
+        return false;
+    }
+
+    uint64_t total_lines = 0;
+    uint64_t total_bytes = 0;
+    uint64_t extrusion_moves = 0;
+    uint64_t travel_moves = 0;
+    uint32_t count = 0;
+    if (!in.get(total_lines) || !in.get(total_bytes) || !in.get(extrusion_moves) ||
+        !in.get(travel_moves) || !in.get(stats.min_z) || !in.get(stats.max_z) ||
+        !in.get_string(stats.filament_color) || !in.get(count) ||
+        in.remaining() != static_cast<size_t>(count) * ENTRY_BYTES) {
+        return false;
+    }
+    stats.total_layers = count;
+    stats.total_lines = static_cast<size_t>(total_lines);
+    stats.total_bytes = static_cast<size_t>(total_bytes);
+    stats.extrusion_moves = static_cast<size_t>(extrusion_moves);
+    stats.travel_moves = static_cast<size_t>(travel_moves);
+
+    entries.resize(count);
+    for (auto& entry : entries) {
+        in.get(entry.file_offset);
+        in.get(entry.byte_length);
+        in.get(entry.z_height);
+        in.get(entry.line_count);
+        in.get(entry.flags);
+    }
+    return true;
+}
+
+} // namespace
+
+uint64_t fnv1a_hash(const char* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool GCodeFileIdentity::from_file(const std::string& filepath, GCodeFileIdentity& out) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(filepath, ec);
+    if (ec) {
+        return false;
+    }
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    auto size = static_cast<uint64_t>(file.tellg());
+
+    // Head and tail: slicers write their settings into both
+    std::vector<char> buffer(LayerIndexDiskCache::FINGERPRINT_BYTES);
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+    file.seekg(0, std::ios::beg);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    hash = fnv1a_hash(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    if (size > buffer.size()) {
+        file.clear();
+        file.seekg(-static_cast<std::streamoff>(buffer.size()), std::ios::end);
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = fnv1a_hash(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+
+    out.path = filepath;
+    out.size = size;
+    out.mtime_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+    out.fingerprint = hash;
+    return true;
+}
+
+LayerIndexDiskCache& get_layer_index_cache() {
+    static LayerIndexDiskCache instance(get_helix_cache_dir(LayerIndexDiskCache::CACHE_SUBDIR));
+    return instance;
+}
+
+LayerIndexDiskCache::LayerIndexDiskCache(std::string cache_dir, size_t max_size)
+    : cache_dir_(std::move(cache_dir)), max_size_(max_size) {
+    if (cache_dir_.empty()) {
+        spdlog::warn("[LayerIndexCache] No cache directory, layer indexes will not be cached");
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir_, ec);
+    if (ec) {
+        spdlog::warn("[LayerIndexCache] Failed to create cache directory {}: {}", cache_dir_,
+                     ec.message());
+    }
+}
+
+std::string LayerIndexDiskCache::get_cache_path(const std::string& filepath) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.hxidx",
+             static_cast<unsigned long long>(fnv1a_hash(filepath.data(), filepath.size())));
+    return cache_dir_ + "/" + name;
+}
+
+bool LayerIndexDiskCache::load(const std::string& filepath, GCodeLayerIndex& index) {
+    if (cache_dir_.empty()) {
+        return false;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+
+    std::string sidecar_path = get_cache_path(filepath);
+    std::ifstream sidecar(sidecar_path, std::ios::binary);
+    if (!sidecar.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(sidecar)), std::istreambuf_iterator<char>());
+    sidecar.close();
+
+    GCodeFileIdentity identity;
+    if (!GCodeFileIdentity::from_file(filepath, identity)) {
+        return false;
+    }
+
+    std::vector<StreamingLayerEntry> entries;
+    LayerIndexStats stats;
+    if (!deserialize(data, identity, entries, stats) || entries.empty()) {
+        spdlog::debug("[LayerIndexCache] Stale or damaged sidecar for {}", filepath);
+        remove(filepath);
+        return false;
+    }
+
+    // Mark as recently used so eviction keeps it
+    std::error_code ec;
+    std::filesystem::last_write_time(sidecar_path, std::filesystem::file_time_type::clock::now(),
+                                     ec);
+
+    stats.build_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+            .count();
+    spdlog::info("[LayerIndexCache] Loaded index for {}: {} layers, {:.1f}ms", filepath,
+                 entries.size(), stats.build_time_ms);
+    index.assign(std::move(entries), std::move(stats), filepath);
+    return true;
+}
+
+bool LayerIndexDiskCache::store(const std::string& filepath, const GCodeLayerIndex& index) {
+    if (cache_dir_.empty() || !index.is_valid()) {
+        return false;
+    }
+    GCodeFileIdentity identity;
+    if (!GCodeFileIdentity::from_file(filepath, identity)) {
+        return false;
+    }
+    std::string data = serialize(identity, index);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Write then rename, so a reader never sees a partial sidecar
+    std::string sidecar_path = get_cache_path(filepath);
+    std::string temp_path = sidecar_path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            spdlog::warn("[LayerIndexCache] Failed to write {}", temp_path);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, sidecar_path, ec);
+    if (ec) {
+        spdlog::warn("[LayerIndexCache] Failed to save {}: {}", sidecar_path, ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    spdlog::debug("[LayerIndexCache] Saved index for {} ({} bytes)", filepath, data.size());
+    evict_if_needed();
+    return true;
+}
+
+void LayerIndexDiskCache::remove(const std::string& filepath) {
+    if (cache_dir_.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    std::filesystem::remove(get_cache_path(filepath), ec);
+}
+
+size_t LayerIndexDiskCache::get_cache_size() const {
+    return cache_directory_size(cache_dir_);
+}
+
+void LayerIndexDiskCache::evict_if_needed() {
+    size_t evicted_count = evict_least_recent_files(cache_dir_, max_size_);
+    if (evicted_count > 0) {
+        spdlog::debug("[LayerIndexCache] Evicted {} sidecars to stay under {} KB", evicted_count,
+                      max_size_ / 1024);
+    }
+}
+
+} // namespace gcode
+} // namespace helix
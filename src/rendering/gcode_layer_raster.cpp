@@ -0,0 +1,384 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_layer_raster.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <system_error>
+#include <utility>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+/// Below this length (pixels) a segment is drawn as a dot
+constexpr float kMinSegmentLength = 1e-4f;
+
+int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint32_t clamp_us(int64_t ns) {
+    int64_t us = std::max<int64_t>(0, ns / 1000);
+    return static_cast<uint32_t>(std::min<int64_t>(us, UINT32_MAX));
+}
+
+void store_max(std::atomic<uint32_t>& max, uint32_t value) {
+    uint32_t seen = max.load(std::memory_order_relaxed);
+    while (value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+/// Source-over of @p argb at @p alpha (0-255) onto a non-premultiplied pixel
+inline void blend_over(uint32_t& dst, uint32_t argb, uint32_t alpha) {
+    if (alpha >= 255) {
+        dst = argb | 0xFF000000u;
+        return;
+    }
+    uint32_t dst_weight = ((dst >> 24) * (255 - alpha) + 127) / 255;
+    uint32_t out_alpha = alpha + dst_weight;
+    if (out_alpha == 0) {
+        return;
+    }
+    uint32_t out = out_alpha << 24;
+    for (int shift = 0; shift <= 16; shift += 8) {
+        uint32_t s = (argb >> shift) & 0xFF;
+        uint32_t d = (dst >> shift) & 0xFF;
+        out |= ((s * alpha + d * dst_weight + out_alpha / 2) / out_alpha) << shift;
+    }
+    dst = out;
+}
+
+} // namespace
+
+// ============================================================================
+// RasterImage
+// ============================================================================
+
+void RasterImage::resize(int w, int h) {
+    width = std::max(0, w);
+    height = std::max(0, h);
+    pixels.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+    row_versions.resize(static_cast<size_t>(height));
+    mark_rows_changed(0, height);
+}
+
+void RasterImage::clear(uint32_t argb) {
+    std::fill(pixels.begin(), pixels.end(), argb);
+    mark_rows_changed(0, height);
+}
+
+void RasterImage::mark_rows_changed(int top, int bottom) {
+    top = std::max(top, 0);
+    bottom = std::min(bottom, height);
+    if (top >= bottom) {
+        return;
+    }
+    if (dirty_top >= dirty_bottom) {
+        dirty_top = top;
+        dirty_bottom = bottom;
+    } else {
+        dirty_top = std::min(dirty_top, top);
+        dirty_bottom = std::max(dirty_bottom, bottom);
+    }
+}
+
+void RasterImage::update_from(const RasterImage& newer) {
+    if (width != newer.width || height != newer.height ||
+        row_versions.size() != newer.row_versions.size()) {
+        *this = newer;
+        return;
+    }
+    const size_t row_pixels = static_cast<size_t>(width);
+    for (size_t y = 0; y < row_versions.size(); ++y) {
+        if (newer.row_versions[y] > version) {
+            std::copy_n(newer.pixels.begin() + static_cast<std::ptrdiff_t>(y * row_pixels),
+                        row_pixels, pixels.begin() + static_cast<std::ptrdiff_t>(y * row_pixels));
+            row_versions[y] = newer.row_versions[y];
+        }
+    }
+    generation = newer.generation;
+    tag = newer.tag;
+    published_ns = newer.published_ns;
+    version = newer.version;
+    dirty_top = newer.dirty_top;
+    dirty_bottom = newer.dirty_bottom;
+}
+
+// ============================================================================
+// Anti-aliased line kernel
+// ============================================================================
+
+void draw_line_aa(RasterImage& image, glm::vec2 p0, glm::vec2 p1, float width, uint32_t argb) {
+    if (image.width <= 0 || image.height <= 0 || (argb >> 24) == 0) {
+        return;
+    }
+
+    // Coverage falls from 1 to 0 over the pixel straddling each edge
+    const float reach = std::max(width, 1.0f) * 0.5f + 0.5f;
+    const glm::vec2 dir = p1 - p0;
+    const float len_sq = glm::dot(dir, dir);
+    const float inv_len_sq = len_sq > kMinSegmentLength * kMinSegmentLength ? 1.0f / len_sq : 0.0f;
+
+    // Walk the major axis one pixel column (or row) at a time and cover the
+    // band around the line on the minor axis, so each pixel is visited once
+    const bool steep = std::abs(dir.y) > std::abs(dir.x);
+    const int major_size = steep ? image.height : image.width;
+    const int minor_size = steep ? image.width : image.height;
+    float a_major = steep ? p0.y : p0.x;
+    float a_minor = steep ? p0.x : p0.y;
+    float b_major = steep ? p1.y : p1.x;
+    float b_minor = steep ? p1.x : p1.y;
+    if (a_major > b_major) {
+        std::swap(a_major, b_major);
+        std::swap(a_minor, b_minor);
+    }
+    const float major_len = b_major - a_major;
+    const float slope = major_len > kMinSegmentLength ? (b_minor - a_minor) / major_len : 0.0f;
+    // Band half-height on the minor axis: reach / cos(angle to the major axis)
+    const float band = reach * std::sqrt(1.0f + slope * slope);
+
+    const uint32_t color_alpha = argb >> 24;
+    const uint32_t rgb = argb & 0x00FFFFFFu;
+
+    int m0 = std::max(0, static_cast<int>(std::ceil(a_major - reach - 0.5f)));
+    int m1 = std::min(major_size - 1, static_cast<int>(std::floor(b_major + reach - 0.5f)));
+    int minor_top = minor_size;
+    int minor_bottom = 0;
+    for (int m = m0; m <= m1; ++m) {
+        float center_major = static_cast<float>(m) + 0.5f;
+        float along = std::clamp(center_major, a_major, b_major);
+        float line_minor = a_minor + (along - a_major) * slope;
+
+        int n0 = std::max(0, static_cast<int>(std::ceil(line_minor - band - 0.5f)));
+        int n1 = std::min(minor_size - 1, static_cast<int>(std::floor(line_minor + band - 0.5f)));
+        minor_top = std::min(minor_top, n0);
+        minor_bottom = std::max(minor_bottom, n1 + 1);
+        for (int n = n0; n <= n1; ++n) {
+            glm::vec2 center = steep ? glm::vec2{static_cast<float>(n) + 0.5f, center_major}
+                                     : glm::vec2{center_major, static_cast<float>(n) + 0.5f};
+            float t = std::clamp(glm::dot(center - p0, dir) * inv_len_sq, 0.0f, 1.0f);
+            glm::vec2 offset = center - (p0 + dir * t);
+            float coverage = reach - std::sqrt(glm::dot(offset, offset));
+            if (coverage <= 0.0f) {
+                continue;
+            }
+            float scaled = std::min(coverage, 1.0f) * static_cast<float>(color_alpha);
+            uint32_t alpha = static_cast<uint32_t>(scaled + 0.5f);
+            if (alpha == 0) {
+                continue;
+            }
+            int x = steep ? n : m;
+            int y = steep ? m : n;
+            blend_over(image.pixels[static_cast<size_t>(y) * static_cast<size_t>(image.width) +
+                                    static_cast<size_t>(x)],
+                       rgb, alpha);
+        }
+    }
+
+    // Rows the band may have touched (a superset is fine, it only costs a copy)
+    if (steep) {
+        image.mark_rows_changed(m0, m1 + 1);
+    } else {
+        image.mark_rows_changed(minor_top, minor_bottom);
+    }
+}
+
+// ============================================================================
+// RasterSwapChain
+// ============================================================================
+
+RasterImage& RasterSwapChain::begin_frame() {
+    frame_start_ = std::chrono::steady_clock::now();
+    return images_[back_];
+}
+
+RasterImage& RasterSwapChain::publish(bool carry_over) {
+    int64_t now = steady_now_ns();
+    uint32_t frame_us = clamp_us(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - frame_start_)
+            .count());
+    last_frame_us_.store(frame_us, std::memory_order_relaxed);
+    store_max(max_frame_us_, frame_us);
+    frames_published_.fetch_add(1, std::memory_order_relaxed);
+
+    int published = back_;
+    RasterImage& image = images_[published];
+    image.published_ns = now;
+    image.version = ++version_;
+    for (int y = image.dirty_top; y < image.dirty_bottom; ++y) {
+        image.row_versions[static_cast<size_t>(y)] = image.version;
+    }
+    image.dirty_top = 0;
+    image.dirty_bottom = 0;
+    uint8_t previous = middle_.exchange(static_cast<uint8_t>(published) | kDirty,
+                                        std::memory_order_acq_rel);
+    back_ = previous & kIndexMask;
+
+    // The reader may take the published image meanwhile, but only reads it,
+    // and cannot hand it back before the next publish()
+    if (carry_over) {
+        images_[back_].update_from(images_[published]);
+    } else {
+        // Stale pixels: whatever is drawn on them next must be copied whole
+        images_[back_].mark_rows_changed(0, images_[back_].height);
+    }
+    frame_start_ = std::chrono::steady_clock::now();
+    return images_[back_];
+}
+
+const RasterImage* RasterSwapChain::acquire() {
+    // Only acquire() clears kDirty, so a set bit cannot vanish before the exchange
+    if (!has_new()) {
+        return nullptr;
+    }
+    uint8_t previous = middle_.exchange(static_cast<uint8_t>(front_), std::memory_order_acq_rel);
+    front_ = previous & kIndexMask;
+
+    const RasterImage& image = images_[front_];
+    uint32_t latency_us = clamp_us(steady_now_ns() - image.published_ns);
+    last_swap_latency_us_.store(latency_us, std::memory_order_relaxed);
+    store_max(max_swap_latency_us_, latency_us);
+    frames_acquired_.fetch_add(1, std::memory_order_relaxed);
+    return &image;
+}
+
+RasterStats RasterSwapChain::stats() const {
+    RasterStats stats;
+    stats.frames_published = frames_published_.load(std::memory_order_relaxed);
+    stats.frames_acquired = frames_acquired_.load(std::memory_order_relaxed);
+    stats.last_frame_us = last_frame_us_.load(std::memory_order_relaxed);
+    stats.max_frame_us = max_frame_us_.load(std::memory_order_relaxed);
+    stats.last_swap_latency_us = last_swap_latency_us_.load(std::memory_order_relaxed);
+    stats.max_swap_latency_us = max_swap_latency_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ============================================================================
+// LayerRasterWorker
+// ============================================================================
+
+LayerRasterWorker::~LayerRasterWorker() {
+    shutdown();
+}
+
+void LayerRasterWorker::submit(RasterLane lane, Job job) {
+    size_t index = static_cast<size_t>(lane);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (shutdown_) {
+        return;
+    }
+    pending_[index] = std::move(job);
+    if (running_lane_ == static_cast<int>(index)) {
+        stop_[index].store(true, std::memory_order_relaxed);
+        running_abandoned_ = true;
+    } else if (running_lane_ > static_cast<int>(index)) {
+        // Lower-priority job: pause it, run() puts it back behind this one
+        stop_[running_lane_].store(true, std::memory_order_relaxed);
+        running_paused_ = true;
+    }
+
+    if (!thread_.joinable()) {
+        try {
+            thread_ = std::thread(&LayerRasterWorker::run, this);
+        } catch (const std::system_error& e) {
+            // Small boards can hit RLIMIT_NPROC; draw on the caller rather than never
+            spdlog::error("[LayerRaster] Failed to start worker thread, drawing inline: {}",
+                          e.what());
+            Job inline_job = std::move(pending_[index]);
+            pending_[index] = nullptr;
+            lock.unlock();
+            std::atomic<bool> never_stop{false};
+            inline_job(never_stop);
+            return;
+        }
+    }
+    wake_.notify_one();
+}
+
+void LayerRasterWorker::cancel(RasterLane lane) {
+    size_t index = static_cast<size_t>(lane);
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_[index] = nullptr;
+    if (running_lane_ == static_cast<int>(index)) {
+        stop_[index].store(true, std::memory_order_relaxed);
+        running_abandoned_ = true;
+    }
+}
+
+void LayerRasterWorker::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return running_lane_ == kNoLane; });
+}
+
+void LayerRasterWorker::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+        running_abandoned_ = true;
+        for (size_t i = 0; i < kLaneCount; ++i) {
+            pending_[i] = nullptr;
+            stop_[i].store(true, std::memory_order_relaxed);
+        }
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool LayerRasterWorker::is_busy(RasterLane lane) const {
+    size_t index = static_cast<size_t>(lane);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_[index] != nullptr || running_lane_ == static_cast<int>(index);
+}
+
+void LayerRasterWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] {
+            return shutdown_ ||
+                   std::any_of(pending_.begin(), pending_.end(), [](const Job& j) { return j; });
+        });
+        if (shutdown_) {
+            break;
+        }
+
+        size_t index = 0;
+        while (!pending_[index]) {
+            ++index;
+        }
+        Job job = std::move(pending_[index]);
+        pending_[index] = nullptr;
+        stop_[index].store(false, std::memory_order_relaxed);
+        running_lane_ = static_cast<int>(index);
+        running_paused_ = false;
+        running_abandoned_ = false;
+
+        lock.unlock();
+        job(stop_[index]);
+        lock.lock();
+
+        if (running_paused_ && !running_abandoned_ && !pending_[index]) {
+            pending_[index] = std::move(job); // Resumes after the higher lane
+        } else {
+            lock.unlock();
+            job = nullptr; // Release captures before reporting idle
+            lock.lock();
+        }
+        running_lane_ = kNoLane;
+        idle_.notify_all();
+    }
+    running_lane_ = kNoLane;
+    idle_.notify_all();
+}
+
+} // namespace gcode
+} // namespace helix
@@ -4,9 +4,9 @@
 #include "gcode_layer_renderer.h"
 
 #include "config.h"
+#include "gcode_compact_segments.h"
 #include "gcode_parser.h"
 #include "memory_monitor.h"
-#include "memory_utils.h"
 #include "theme_manager.h"
 
 #include <spdlog/spdlog.h>
@@ -54,14 +54,97 @@ constexpr int kGhostDarkenPercent = 40;
 constexpr float kDefaultExtrusionWidthMm = 0.4f;
 
 /// Extrusion pixel width clamp range
-constexpr int kMinExtrusionPixelWidth = 1;
-constexpr int kMaxExtrusionPixelWidth = 8;
+constexpr float kMinExtrusionPixelWidth = 1.0f;
+constexpr float kMaxExtrusionPixelWidth = 8.0f;
 
-/// Minimum line length for thick line perpendicular computation
-constexpr float kMinLineLength = 0.001f;
+/// Clip area margin for LOD culling (pixels): half the widest line, rounded up
+constexpr int kLodCullMarginPx = 2;
 
 } // namespace
 
+// ============================================================================
+// Segment Access
+// ============================================================================
+
+template <typename Fn>
+bool GCodeLayerRenderer::for_each_layer_segment(int layer_idx, Fn&& fn, size_t first,
+                                                size_t last) const {
+    if (streaming_controller_) {
+        // Hold the shared_ptr so an eviction mid-iteration can't free the layer
+        std::shared_ptr<const CompactSegments> segments =
+            streaming_controller_->get_layer_segments(static_cast<size_t>(layer_idx));
+        if (!segments) {
+            return false;
+        }
+        // Packed segments decode in order; the skipped ones are only decoded
+        size_t index = 0;
+        for (const auto& seg : *segments) {
+            if (index >= last) {
+                break;
+            }
+            if (index++ >= first) {
+                fn(seg);
+            }
+        }
+        return true;
+    }
+    if (gcode_) {
+        const auto& segments = gcode_->layers[static_cast<size_t>(layer_idx)].segments;
+        for (size_t i = first; i < std::min(last, segments.size()); ++i) {
+            fn(segments[i]);
+        }
+        return true;
+    }
+    return false;
+}
+
+size_t GCodeLayerRenderer::layer_segment_count(int layer_idx) const {
+    if (streaming_controller_) {
+        auto segments = streaming_controller_->get_layer_segments(static_cast<size_t>(layer_idx));
+        return segments ? segments->size() : 0;
+    }
+    return gcode_ ? gcode_->layers[static_cast<size_t>(layer_idx)].segments.size() : 0;
+}
+
+ObjectSymbolTable GCodeLayerRenderer::current_object_table() const {
+    if (streaming_controller_) {
+        return streaming_controller_->get_object_table();
+    }
+    return gcode_ ? gcode_->object_table : ObjectSymbolTable{};
+}
+
+size_t GCodeLayerRenderer::current_object_count() const {
+    if (streaming_controller_) {
+        return streaming_controller_->get_object_count();
+    }
+    return gcode_ ? gcode_->object_table.size() : 0;
+}
+
+void GCodeLayerRenderer::resolve_object_ids() {
+    size_t count = current_object_count();
+    if (count == resolved_object_count_) {
+        return;
+    }
+    bool first = resolved_object_count_ == SIZE_MAX;
+    resolved_object_count_ = count;
+
+    ObjectIdSet excluded;
+    ObjectIdSet highlighted;
+    if (!excluded_objects_.empty() || !highlighted_objects_.empty()) {
+        ObjectSymbolTable table = current_object_table();
+        excluded = table.to_id_set(excluded_objects_);
+        highlighted = table.to_id_set(highlighted_objects_);
+    }
+    bool changed = excluded != excluded_ids_ || highlighted != highlighted_ids_;
+    excluded_ids_ = std::move(excluded);
+    highlighted_ids_ = std::move(highlighted);
+
+    // A name that just appeared may be on layers already drawn into the cache
+    if (changed && !first) {
+        invalidate_cache();
+    }
+}
+
 // ============================================================================
 // Construction
 // ============================================================================
@@ -75,8 +158,8 @@ GCodeLayerRenderer::GCodeLayerRenderer() {
 }
 
 GCodeLayerRenderer::~GCodeLayerRenderer() {
-    // Cancel background thread first (must complete before destroying buffers)
-    cancel_background_ghost_render();
+    // Stop the raster worker first (its jobs read this renderer and its data source)
+    raster_worker_.shutdown();
 
     destroy_cache();
     destroy_ghost_cache();
@@ -87,12 +170,15 @@ GCodeLayerRenderer::~GCodeLayerRenderer() {
 // ============================================================================
 
 void GCodeLayerRenderer::set_gcode(const ParsedGCodeFile* gcode) {
+    stop_raster_jobs(); // The worker may still be reading the previous file
     gcode_ = gcode;
     streaming_controller_ = nullptr; // Clear streaming mode
     bounds_valid_ = false;
     current_layer_ = 0;
     warmup_frames_remaining_ = WARMUP_FRAMES; // Allow panel to render before heavy caching
+    resolved_object_count_ = SIZE_MAX;
     invalidate_cache();
+    lod_cache_.clear();
 
     if (gcode_) {
         spdlog::debug("[GCodeLayerRenderer] Set G-code: {} layers, {} total segments",
@@ -101,12 +187,15 @@ void GCodeLayerRenderer::set_gcode(const ParsedGCodeFile* gcode) {
 }
 
 void GCodeLayerRenderer::set_streaming_controller(GCodeStreamingController* controller) {
+    stop_raster_jobs(); // The worker may still be reading the previous file
     streaming_controller_ = controller;
     gcode_ = nullptr; // Clear full-file mode
     bounds_valid_ = false;
     current_layer_ = 0;
     warmup_frames_remaining_ = WARMUP_FRAMES; // Allow panel to render before heavy caching
+    resolved_object_count_ = SIZE_MAX;
     invalidate_cache();
+    lod_cache_.clear();
 
     if (streaming_controller_) {
         spdlog::info(
@@ -221,6 +310,7 @@ void GCodeLayerRenderer::set_excluded_objects(const std::unordered_set<std::stri
         return; // No change - skip expensive cache invalidation
     }
     excluded_objects_ = names;
+    resolved_object_count_ = SIZE_MAX;
     invalidate_cache();
 }
 
@@ -236,6 +326,7 @@ void GCodeLayerRenderer::set_highlighted_objects(const std::unordered_set<std::s
         }
     }
     highlighted_objects_ = names;
+    resolved_object_count_ = SIZE_MAX;
     invalidate_cache();
 }
 
@@ -458,8 +549,10 @@ void GCodeLayerRenderer::destroy_cache() {
         cache_buf_ = nullptr;
     }
     cached_up_to_layer_ = -1;
+    cache_buf_version_ = 0;
     cached_width_ = 0;
     cached_height_ = 0;
+    ++solid_generation_;
 }
 
 void GCodeLayerRenderer::invalidate_cache() {
@@ -468,9 +561,14 @@ void GCodeLayerRenderer::invalidate_cache() {
         lv_draw_buf_clear(cache_buf_, nullptr);
     }
     cached_up_to_layer_ = -1;
+    cache_buf_version_ = 0;
 
-    // Cancel any in-progress background ghost rendering
-    cancel_background_ghost_render();
+    // Images already drawn or in flight are stale; the next render() queues new
+    // jobs, and anything published meanwhile is dropped by its generation
+    ++solid_generation_;
+    ++ghost_generation_;
+    raster_worker_.cancel(RasterLane::Solid);
+    raster_worker_.cancel(RasterLane::Ghost);
 
     // Also invalidate ghost cache (new gcode = need new ghost)
     if (ghost_buf_) {
@@ -502,124 +600,267 @@ void GCodeLayerRenderer::ensure_cache(int width, int height) {
         cached_width_ = width;
         cached_height_ = height;
         cached_up_to_layer_ = -1;
+        cache_buf_version_ = 0;
 
         spdlog::debug("[GCodeLayerRenderer] Created cache buffer: {}x{}", width, height);
         helix::MemoryMonitor::log_now("gcode_cache_buffer_created");
     }
 }
 
-void GCodeLayerRenderer::render_layers_to_cache(int from_layer, int to_layer) {
-    if (!cache_buf_)
-        return;
+// ============================================================================
+// Solid Cache (drawn by the raster worker)
+// ============================================================================
 
-    // Need either gcode file or streaming controller
-    if (!gcode_ && !streaming_controller_)
-        return;
+GCodeLayerRenderer::RasterPass GCodeLayerRenderer::capture_raster_pass(uint64_t generation,
+                                                                       int target_layer,
+                                                                       int width,
+                                                                       int height) const {
+    RasterPass pass;
+    pass.generation = generation;
+    pass.transform = capture_transform_params();
+    pass.transform.canvas_width = width;
+    pass.transform.canvas_height = height;
+    pass.line_width = get_extrusion_pixel_width();
+    pass.target_layer = target_layer;
+    pass.file_position = print_file_position_;
+    pass.show_travels = show_travels_.load(std::memory_order_relaxed);
+    pass.show_extrusions = show_extrusions_.load(std::memory_order_relaxed);
+    pass.show_supports = show_supports_.load(std::memory_order_relaxed);
+    pass.depth_shading =
+        depth_shading_.load(std::memory_order_relaxed) && get_view_mode() == ViewMode::FRONT;
+    pass.color_extrusion = color_extrusion_;
+    pass.tool_palette = tool_palette_;
+    pass.excluded_names = excluded_objects_;
+    pass.excluded_ids = excluded_ids_;
+    pass.highlighted_ids = highlighted_ids_;
+    pass.bounds_min_y = bounds_min_y_;
+    pass.bounds_max_y = bounds_max_y_;
+    pass.bounds_min_z = bounds_min_z_;
+    pass.bounds_max_z = bounds_max_z_;
+    pass.layers_per_publish = config_layers_per_frame_ > 0 ? layers_per_frame_ : 0;
+    pass.publish_interval_ms = adaptive_target_ms_;
+    return pass;
+}
 
-    // Capture transform params for coordinate conversion
-    // This ensures consistent rendering with widget offset set to 0 for cache
-    TransformParams transform = capture_transform_params();
-    transform.canvas_width = cached_width_;
-    transform.canvas_height = cached_height_;
+bool GCodeLayerRenderer::pass_shows_segment(const RasterPass& pass,
+                                            const ToolpathSegment& seg) const {
+    if (seg.is_extrusion) {
+        return is_support_segment(seg) ? pass.show_supports : pass.show_extrusions;
+    }
+    return pass.show_travels;
+}
 
-    int layer_count = get_layer_count();
-    size_t segments_rendered = 0;
+void GCodeLayerRenderer::submit_solid_raster(int target_layer) {
+    RasterPass pass =
+        capture_raster_pass(solid_generation_, target_layer, cached_width_, cached_height_);
+    solid_submitted_generation_ = solid_generation_;
+    solid_submitted_layer_ = target_layer;
+    solid_submitted_file_position_ = print_file_position_;
+    raster_worker_.submit(RasterLane::Solid,
+                          [this, pass = std::move(pass)](const std::atomic<bool>& stop) {
+                              raster_solid_layers(pass, stop);
+                          });
+}
 
-    // Compute extrusion line width in pixels (scale-dependent)
-    int line_width = get_extrusion_pixel_width();
+void GCodeLayerRenderer::raster_solid_layers(const RasterPass& pass,
+                                             const std::atomic<bool>& stop) {
+    const int width = pass.transform.canvas_width;
+    const int height = pass.transform.canvas_height;
+    const int last_layer = std::min(pass.target_layer, get_layer_count() - 1);
+    RasterImage* image = &solid_chain_.begin_frame();
+
+    // Keep painting on top of the segments already drawn, unless they belong
+    // to an older generation or go past the new target (a layer above it, or
+    // more of it than the print has reached)
+    bool overshoot = last_layer < solid_drawn_layer_;
+    if (last_layer >= 0 && last_layer == solid_drawn_layer_) {
+        size_t count = layer_segment_count(last_layer);
+        overshoot =
+            solid_drawn_segments_ > 0 || printed_segment_count(pass, last_layer, count) < count;
+    } else if (last_layer == solid_drawn_layer_ + 1 && solid_drawn_segments_ > 0) {
+        size_t count = layer_segment_count(last_layer);
+        overshoot = printed_segment_count(pass, last_layer, count) < solid_drawn_segments_;
+    }
+    bool restart = solid_drawn_generation_ != pass.generation || image->width != width ||
+                   image->height != height || overshoot;
+    if (restart) {
+        image->resize(width, height);
+        image->clear();
+        image->generation = pass.generation;
+        image->tag = -1;
+        solid_drawn_generation_ = pass.generation;
+        solid_drawn_layer_ = -1;
+        solid_drawn_segments_ = 0;
+    }
+    bool unpublished = restart;
+
+    auto draw_segment = [&](const ToolpathSegment& seg) {
+        // Skip non-extrusion moves for solid rendering (travels are subtle)
+        if (!seg.is_extrusion || !pass_shows_segment(pass, seg))
+            return;
 
-    for (int layer_idx = from_layer; layer_idx <= to_layer; ++layer_idx) {
-        if (layer_idx < 0 || layer_idx >= layer_count)
-            continue;
+        glm::vec2 p1 = project_subpixel(pass.transform, seg.start.x, seg.start.y, seg.start.z);
+        glm::vec2 p2 = project_subpixel(pass.transform, seg.end.x, seg.end.y, seg.end.z);
 
-        // Get segments from appropriate source
-        // For streaming mode, hold shared_ptr to keep data alive during iteration
-        std::shared_ptr<const std::vector<ToolpathSegment>> segments_holder;
-        const std::vector<ToolpathSegment>* segments = nullptr;
-
-        if (streaming_controller_) {
-            // Streaming mode: get segments from controller (returns shared_ptr)
-            segments_holder =
-                streaming_controller_->get_layer_segments(static_cast<size_t>(layer_idx));
-            segments = segments_holder.get();
-        } else if (gcode_) {
-            // Full file mode: get segments from parsed file
-            segments = &gcode_->layers[layer_idx].segments;
+        if (pass.excluded_ids.test(seg.object_id)) {
+            // Excluded: orange-red with reduced alpha
+            draw_line_aa(*image, p1, p2, pass.line_width,
+                         (static_cast<uint32_t>(kExcludedAlpha) << 24) | kExcludedObjectColor);
+            return;
         }
 
-        if (!segments)
-            continue;
-
-        for (const auto& seg : *segments) {
-            if (!should_render_segment(seg))
-                continue;
-
-            // Skip non-extrusion moves for solid rendering (travels are subtle)
-            if (!seg.is_extrusion)
-                continue;
-
-            // Convert world coordinates to screen using cached transform
-            glm::ivec2 p1 = world_to_screen_raw(transform, seg.start.x, seg.start.y, seg.start.z);
-            glm::ivec2 p2 = world_to_screen_raw(transform, seg.end.x, seg.end.y, seg.end.z);
-
-            // Skip zero-length segments
-            if (p1.x == p2.x && p1.y == p2.y)
-                continue;
-
+        uint32_t r, g, b;
+        if (pass.highlighted_ids.test(seg.object_id)) {
+            // Highlighted: selection blue, full alpha
+            r = kHighlightedR;
+            g = kHighlightedG;
+            b = kHighlightedB;
+        } else {
             // Per-segment tool color (or fallback to single extrusion color)
-            lv_color_t seg_color = color_extrusion_;
-            if (tool_palette_.has_tool_colors()) {
-                seg_color = tool_palette_.resolve(seg.tool_index, color_extrusion_);
+            lv_color_t seg_color = pass.color_extrusion;
+            if (pass.tool_palette.has_tool_colors()) {
+                seg_color = pass.tool_palette.resolve(seg.tool_index, pass.color_extrusion);
             }
-            uint8_t r = seg_color.red, g = seg_color.green, b = seg_color.blue;
+            r = seg_color.red;
+            g = seg_color.green;
+            b = seg_color.blue;
 
             // Calculate color with depth shading for 3D-like appearance
-            if (depth_shading_.load(std::memory_order_relaxed) &&
-                get_view_mode() == ViewMode::FRONT) {
+            if (pass.depth_shading) {
                 float avg_z = (seg.start.z + seg.end.z) * 0.5f;
                 float avg_y = (seg.start.y + seg.end.y) * 0.5f;
-                float brightness = compute_depth_brightness(avg_z, bounds_min_z_, bounds_max_z_,
-                                                            avg_y, bounds_min_y_, bounds_max_y_);
-
-                r = static_cast<uint8_t>(r * brightness);
-                g = static_cast<uint8_t>(g * brightness);
-                b = static_cast<uint8_t>(b * brightness);
+                float brightness =
+                    compute_depth_brightness(avg_z, pass.bounds_min_z, pass.bounds_max_z, avg_y,
+                                             pass.bounds_min_y, pass.bounds_max_y);
+                r = static_cast<uint32_t>(static_cast<float>(r) * brightness);
+                g = static_cast<uint32_t>(static_cast<float>(g) * brightness);
+                b = static_cast<uint32_t>(static_cast<float>(b) * brightness);
             }
+        }
+        draw_line_aa(*image, p1, p2, pass.line_width, (255u << 24) | (r << 16) | (g << 8) | b);
+    };
 
-            // Override color for excluded/highlighted objects
-            if (!seg.object_name.empty()) {
-                if (excluded_objects_.count(seg.object_name) > 0) {
-                    // Excluded: orange-red with reduced alpha
-                    r = kExcludedR;
-                    g = kExcludedG;
-                    b = kExcludedB;
-                    uint32_t color =
-                        (static_cast<uint32_t>(kExcludedAlpha) << 24) | (r << 16) | (g << 8) | b;
-                    draw_thick_line_bresenham_solid(p1.x, p1.y, p2.x, p2.y, color, line_width);
-                    ++segments_rendered;
-                    continue;
-                }
-                if (highlighted_objects_.count(seg.object_name) > 0) {
-                    // Highlighted: selection blue, full alpha
-                    r = kHighlightedR;
-                    g = kHighlightedG;
-                    b = kHighlightedB;
-                }
-            }
+    auto last_publish = std::chrono::steady_clock::now();
+    int layers_since_publish = 0;
 
-            // Build ARGB8888 color (full alpha for solid layers)
-            uint32_t color = (255u << 24) | (r << 16) | (g << 8) | b;
+    for (int layer_idx = solid_drawn_layer_ + 1; layer_idx <= last_layer; ++layer_idx) {
+        // Only between layers: a half-drawn layer would be drawn twice on resume
+        if (stop.load(std::memory_order_relaxed)) {
+            break;
+        }
 
-            // Draw using software Bresenham - bypasses LVGL draw API for AD5M compatibility
-            draw_thick_line_bresenham_solid(p1.x, p1.y, p2.x, p2.y, color, line_width);
-            ++segments_rendered;
+        // Resume a layer the print was partway through, and stop where it is now
+        size_t count = layer_segment_count(layer_idx);
+        size_t end = printed_segment_count(pass, layer_idx, count);
+        if (end > solid_drawn_segments_) {
+            for_each_layer_segment(layer_idx, draw_segment, solid_drawn_segments_, end);
+            unpublished = true;
+        }
+        if (image->tag != layer_idx) {
+            image->tag = layer_idx;
+            unpublished = true;
+        }
+        if (end < count) {
+            solid_drawn_segments_ = end;
+            break;
+        }
+        solid_drawn_layer_ = layer_idx;
+        solid_drawn_segments_ = 0;
+        ++layers_since_publish;
+
+        // Publish partial progress so long catch-ups appear progressively
+        auto now = std::chrono::steady_clock::now();
+        bool due = pass.layers_per_publish > 0
+                       ? layers_since_publish >= pass.layers_per_publish
+                       : now - last_publish >= std::chrono::milliseconds(pass.publish_interval_ms);
+        if (due && layer_idx < last_layer) {
+            image = &solid_chain_.publish(true);
+            unpublished = false;
+            layers_since_publish = 0;
+            last_publish = now;
         }
     }
 
-    spdlog::trace("[GCodeLayerRenderer] Rendered layers {}-{}: {} segments to cache (direct), "
-                  "buf={}x{} stride={}",
-                  from_layer, to_layer, segments_rendered, cached_width_, cached_height_,
-                  cache_buf_ ? cache_buf_->header.stride : 0);
+    if (unpublished) {
+        solid_chain_.publish(true);
+    }
+}
+
+size_t GCodeLayerRenderer::printed_segment_count(const RasterPass& pass, int layer_idx,
+                                                 size_t count) const {
+    if (pass.file_position == 0 || layer_idx != pass.target_layer) {
+        return count;
+    }
+
+    uint64_t begin = 0;
+    uint64_t length = 0;
+    if (streaming_controller_) {
+        StreamingLayerEntry entry =
+            streaming_controller_->get_layer_entry(static_cast<size_t>(layer_idx));
+        begin = entry.file_offset;
+        length = entry.byte_length;
+    } else if (gcode_) {
+        const Layer& layer = gcode_->layers[static_cast<size_t>(layer_idx)];
+        begin = layer.file_offset;
+        length = layer.byte_length;
+    }
+    if (length == 0 || pass.file_position >= begin + length) {
+        return count;
+    }
+    if (pass.file_position <= begin) {
+        return 0;
+    }
+    double fraction = static_cast<double>(pass.file_position - begin) / static_cast<double>(length);
+    return std::min(count, static_cast<size_t>(fraction * static_cast<double>(count)));
+}
+
+void GCodeLayerRenderer::take_solid_frame() {
+    const RasterImage* image = solid_chain_.acquire();
+    if (!image || image->generation != solid_generation_) {
+        return; // Nothing new, or drawn before the last invalidation
+    }
+    // cache_buf_ holds an older image of the same chain: copy the rows changed since
+    if (copy_image_to_draw_buf(*image, cache_buf_, cache_buf_version_)) {
+        cached_up_to_layer_ = image->tag;
+        cache_buf_version_ = image->version;
+    }
+}
+
+bool GCodeLayerRenderer::copy_image_to_draw_buf(const RasterImage& image, lv_draw_buf_t* buf,
+                                                uint64_t since_version) {
+    if (!buf) {
+        return false;
+    }
+
+    // A resize while the worker was drawing leaves an image of the old size
+    // LVGL 9: dimensions are in the header struct
+    if (image.width != static_cast<int>(buf->header.w) ||
+        image.height != static_cast<int>(buf->header.h)) {
+        spdlog::debug("[GCodeLayerRenderer] Raster image {}x{} does not match buffer {}x{}, "
+                      "discarding",
+                      image.width, image.height, buf->header.w, buf->header.h);
+        return false;
+    }
+
+    // RasterImage pixels are 0xAARRGGBB words: B, G, R, A in memory on
+    // little-endian, which is LVGL's ARGB8888 byte order
+    size_t row_bytes = static_cast<size_t>(image.width) * sizeof(uint32_t);
+    uint32_t stride = buf->header.stride;
+    auto* dst = static_cast<uint8_t*>(buf->data);
+    bool whole = since_version == 0 ||
+                 image.row_versions.size() != static_cast<size_t>(image.height);
+    if (whole && stride == row_bytes) {
+        std::memcpy(dst, image.pixels.data(), row_bytes * static_cast<size_t>(image.height));
+    } else {
+        for (int y = 0; y < image.height; ++y) {
+            if (!whole && image.row_versions[static_cast<size_t>(y)] <= since_version) {
+                continue; // Unchanged since the buffer's copy
+            }
+            std::memcpy(dst + static_cast<size_t>(y) * stride,
+                        image.pixels.data() + static_cast<size_t>(y) * image.width, row_bytes);
+        }
+    }
+    return true;
 }
 
 void GCodeLayerRenderer::blit_cache(lv_layer_t* target) {
@@ -651,6 +892,7 @@ void GCodeLayerRenderer::destroy_ghost_cache() {
     ghost_cached_height_ = 0;
     ghost_cache_valid_ = false;
     ghost_rendered_up_to_ = -1;
+    ++ghost_generation_;
 }
 
 void GCodeLayerRenderer::ensure_ghost_cache(int width, int height) {
@@ -761,6 +1003,8 @@ void GCodeLayerRenderer::render(lv_layer_t* layer, const lv_area_t* widget_area)
 
     uint32_t start_time = lv_tick_get();
 
+    resolve_object_ids();
+
     // Store widget screen offset for world_to_screen()
     if (widget_area) {
         widget_offset_x_ = widget_area->x1;
@@ -788,21 +1032,17 @@ void GCodeLayerRenderer::render(lv_layer_t* layer, const lv_area_t* widget_area)
         }
 
         // =====================================================================
-        // GHOST CACHE: Background thread rendering (non-blocking)
-        // Uses unified background thread for both streaming and non-streaming modes.
-        // The background thread renders all layers to a raw buffer, then we copy
-        // to LVGL buffer on main thread when ready.
+        // GHOST CACHE: Raster worker (non-blocking)
+        // The worker draws all layers to a RasterImage; we copy it to the LVGL
+        // buffer here once it is published.
         // =====================================================================
         bool ghost_enabled = ghost_mode_enabled_.load(std::memory_order_relaxed);
         if (ghost_enabled && ghost_buf_ && !ghost_cache_valid_) {
-            if (ghost_thread_ready_.load()) {
-                // Background thread finished - copy to LVGL buffer
-                copy_raw_to_ghost_buf();
-            } else if (!ghost_thread_running_.load()) {
-                // Start background thread if not running
+            take_ghost_frame();
+            if (!ghost_cache_valid_ && ghost_submitted_generation_ != ghost_generation_) {
                 start_background_ghost_render();
             }
-            // else: background thread is running, wait for it
+            // else: worker is drawing it, wait for it
         }
 
         // =====================================================================
@@ -814,43 +1054,20 @@ void GCodeLayerRenderer::render(lv_layer_t* layer, const lv_area_t* widget_area)
             if (ghost_enabled && ghost_buf_) {
                 blit_ghost_cache(layer);
             }
-            // Request another frame to continue after warmup
-            last_frame_render_ms_ = 1; // Minimal time so adaptation doesn't spike
             return;
         }
 
         // =====================================================================
-        // SOLID CACHE: Progressive rendering up to current print layer
+        // SOLID CACHE: Raster worker paints new layers on top of the old ones
+        // (or starts over when going backwards); we only copy and blit
         // =====================================================================
         if (cache_buf_) {
-            // Check if we need to render new layers
-            if (target_layer > cached_up_to_layer_) {
-                // Progressive rendering: only render up to layers_per_frame_ at a time
-                // This prevents UI freezing during initial load or big jumps
-                int from_layer = cached_up_to_layer_ + 1;
-                int to_layer = std::min(from_layer + layers_per_frame_ - 1, target_layer);
-
-                render_layers_to_cache(from_layer, to_layer);
-                cached_up_to_layer_ = to_layer;
-
-                // If we haven't caught up yet, caller should check needs_more_frames()
-                // and invalidate the widget to trigger another frame
-                if (cached_up_to_layer_ < target_layer) {
-                    spdlog::debug(
-                        "[GCodeLayerRenderer] Progressive: rendered to layer {}/{}, more needed",
-                        cached_up_to_layer_, target_layer);
-                }
-            } else if (target_layer < cached_up_to_layer_) {
-                // Going backwards - need to re-render from scratch (progressively)
-                lv_draw_buf_clear(cache_buf_, nullptr);
-                cached_up_to_layer_ = -1;
-
-                int to_layer = std::min(layers_per_frame_ - 1, target_layer);
-                render_layers_to_cache(0, to_layer);
-                cached_up_to_layer_ = to_layer;
-                // Caller checks needs_more_frames() for continuation
+            if (target_layer != solid_submitted_layer_ ||
+                solid_generation_ != solid_submitted_generation_ ||
+                print_file_position_ != solid_submitted_file_position_) {
+                submit_solid_raster(target_layer);
             }
-            // else: same layer, just blit cached image
+            take_solid_frame();
 
             // =====================================================================
             // BLIT: Ghost first (underneath), then solid on top
@@ -863,33 +1080,18 @@ void GCodeLayerRenderer::render(lv_layer_t* layer, const lv_area_t* widget_area)
         }
     } else {
         // TOP_DOWN or ISOMETRIC: render single layer directly (no caching needed)
-        // Get segments from appropriate source
-        // For streaming mode, hold shared_ptr to keep data alive during iteration
-        std::shared_ptr<const std::vector<ToolpathSegment>> segments_holder;
-        const std::vector<ToolpathSegment>* segments = nullptr;
-
-        if (streaming_controller_) {
-            // Streaming mode: get segments from controller (returns shared_ptr)
-            segments_holder =
-                streaming_controller_->get_layer_segments(static_cast<size_t>(current_layer_));
-            segments = segments_holder.get();
-            // Use default centering for streaming mode
-            // (Could be improved by computing bounds from segments if needed)
-        } else if (gcode_) {
-            // Full file mode: get segments and bounding box from parsed file
+        // Streaming mode uses default centering
+        // (Could be improved by computing bounds from segments if needed)
+        if (!streaming_controller_ && gcode_) {
+            // Full file mode: center on the layer's bounding box
             const auto& layer_bb = gcode_->layers[current_layer_].bounding_box;
             offset_x_ = (layer_bb.min.x + layer_bb.max.x) / 2.0f;
             offset_y_ = (layer_bb.min.y + layer_bb.max.y) / 2.0f;
-            segments = &gcode_->layers[current_layer_].segments;
         }
 
-        if (segments) {
-            for (const auto& seg : *segments) {
-                if (!should_render_segment(seg))
-                    continue;
-                render_segment(layer, seg);
-                ++segments_rendered;
-            }
+        // Collinear and sub-pixel segments are merged for the current zoom
+        if (const LodLayer* lod = get_lod_layer(current_layer_)) {
+            segments_rendered = render_lod_layer(layer, *lod);
         }
     }
 
@@ -898,18 +1100,15 @@ void GCodeLayerRenderer::render(lv_layer_t* layer, const lv_area_t* widget_area)
 
     // Track render time for diagnostics
     last_render_time_ms_ = lv_tick_get() - start_time;
-    last_frame_render_ms_ = last_render_time_ms_;
     last_segment_count_ = segments_rendered;
 
-    // Adapt layers_per_frame for next frame (if in adaptive mode)
-    if (config_layers_per_frame_ == 0 && current_view_mode == ViewMode::FRONT) {
-        adapt_layers_per_frame();
-    }
-
     // Log performance if layer changed or slow render
     if (current_layer_ != last_rendered_layer_ || last_render_time_ms_ > 50) {
-        spdlog::trace("[GCodeLayerRenderer] Layer {}: {}ms (cached_up_to={}, lpf={})",
-                      current_layer_, last_render_time_ms_, cached_up_to_layer_, layers_per_frame_);
+        RasterStats stats = solid_chain_.stats();
+        spdlog::trace("[GCodeLayerRenderer] Layer {}: {}ms (cached_up_to={}, raster frame={}us, "
+                      "swap latency={}us)",
+                      current_layer_, last_render_time_ms_, cached_up_to_layer_,
+                      stats.last_frame_us, stats.last_swap_latency_us);
         last_rendered_layer_ = current_layer_;
     }
 }
@@ -927,15 +1126,21 @@ bool GCodeLayerRenderer::needs_more_frames() const {
 
     int target_layer = std::min(current_layer_, layer_count - 1);
 
-    // Solid cache incomplete?
-    if (cached_up_to_layer_ < target_layer) {
+    // Solid image not yet showing the target layer (the worker may be above it
+    // after a step backwards)?
+    if (cached_up_to_layer_ != target_layer) {
+        return true;
+    }
+
+    // Segments printed since the last frame still being drawn?
+    if (raster_worker_.is_busy(RasterLane::Solid) || solid_chain_.has_new()) {
         return true;
     }
 
     // Ghost rendering in background?
     // Keep triggering frames while ghost is building so we can show progress
     if (ghost_mode_enabled_.load(std::memory_order_relaxed) && !ghost_cache_valid_) {
-        if (ghost_thread_running_.load() || ghost_thread_ready_.load()) {
+        if (raster_worker_.is_busy(RasterLane::Ghost) || ghost_chain_.has_new()) {
             return true;
         }
     }
@@ -966,7 +1171,19 @@ void GCodeLayerRenderer::render_segment(lv_layer_t* layer, const ToolpathSegment
     // Initialize line drawing descriptor
     lv_draw_line_dsc_t dsc;
     lv_draw_line_dsc_init(&dsc);
+    apply_segment_style(dsc, seg, ghost);
+
+    // LVGL 9: points are stored in the descriptor struct
+    dsc.p1.x = static_cast<lv_value_precise_t>(p1.x);
+    dsc.p1.y = static_cast<lv_value_precise_t>(p1.y);
+    dsc.p2.x = static_cast<lv_value_precise_t>(p2.x);
+    dsc.p2.y = static_cast<lv_value_precise_t>(p2.y);
 
+    lv_draw_line(layer, &dsc);
+}
+
+void GCodeLayerRenderer::apply_segment_style(lv_draw_line_dsc_t& dsc, const ToolpathSegment& seg,
+                                             bool ghost) const {
     lv_color_t base_color;
     if (ghost) {
         // Ghost mode: use darkened version of the model's extrusion color
@@ -996,9 +1213,8 @@ void GCodeLayerRenderer::render_segment(lv_layer_t* layer, const ToolpathSegment
     }
 
     // Check excluded/highlighted state for width/opacity
-    bool is_excluded = !seg.object_name.empty() && excluded_objects_.count(seg.object_name) > 0;
-    bool is_highlighted =
-        !seg.object_name.empty() && highlighted_objects_.count(seg.object_name) > 0;
+    bool is_excluded = excluded_ids_.test(seg.object_id);
+    bool is_highlighted = highlighted_ids_.test(seg.object_id);
 
     if (is_excluded) {
         dsc.width = 1;
@@ -1013,14 +1229,119 @@ void GCodeLayerRenderer::render_segment(lv_layer_t* layer, const ToolpathSegment
         dsc.width = 1;
         dsc.opa = LV_OPA_50;
     }
+}
 
-    // LVGL 9: points are stored in the descriptor struct
-    dsc.p1.x = static_cast<lv_value_precise_t>(p1.x);
-    dsc.p1.y = static_cast<lv_value_precise_t>(p1.y);
-    dsc.p2.x = static_cast<lv_value_precise_t>(p2.x);
-    dsc.p2.y = static_cast<lv_value_precise_t>(p2.y);
+// ============================================================================
+// Level of Detail (TOP_DOWN / ISOMETRIC)
+// ============================================================================
 
-    lv_draw_line(layer, &dsc);
+const LodLayer* GCodeLayerRenderer::get_lod_layer(int layer_idx) {
+    int bucket = lod_zoom_bucket(scale_);
+    uint8_t visibility = (show_travels_.load(std::memory_order_relaxed) ? 1 : 0) |
+                         (show_extrusions_.load(std::memory_order_relaxed) ? 2 : 0) |
+                         (show_supports_.load(std::memory_order_relaxed) ? 4 : 0);
+    ++lod_cache_clock_;
+
+    for (auto& entry : lod_cache_) {
+        if (entry.layer == layer_idx && entry.zoom_bucket == bucket &&
+            entry.visibility == visibility) {
+            entry.last_used = lod_cache_clock_;
+            return &entry.lod;
+        }
+    }
+
+    PolylineDecimator decimator(lod_tolerance_mm(bucket));
+    bool loaded = for_each_layer_segment(layer_idx, [&](const ToolpathSegment& seg) {
+        if (should_render_segment(seg)) {
+            decimator.add(seg);
+        }
+    });
+    if (!loaded) {
+        return nullptr; // Streaming layer not loaded yet; try again next frame
+    }
+
+    LodCacheEntry* slot;
+    if (lod_cache_.size() < LOD_CACHE_ENTRIES) {
+        slot = &lod_cache_.emplace_back();
+    } else {
+        slot = &*std::min_element(lod_cache_.begin(), lod_cache_.end(),
+                                  [](const LodCacheEntry& a, const LodCacheEntry& b) {
+                                      return a.last_used < b.last_used;
+                                  });
+    }
+    slot->layer = layer_idx;
+    slot->zoom_bucket = bucket;
+    slot->visibility = visibility;
+    slot->last_used = lod_cache_clock_;
+    slot->lod = decimator.finish();
+
+    spdlog::trace("[GCodeLayerRenderer] LOD layer {} (bucket {}): {} segments -> {} lines",
+                  layer_idx, bucket, slot->lod.source_segments, slot->lod.edge_count());
+    return &slot->lod;
+}
+
+size_t GCodeLayerRenderer::render_lod_layer(lv_layer_t* layer, const LodLayer& lod) {
+    TransformParams params = capture_transform_params();
+    auto to_screen = [&](const glm::vec2& p) {
+        glm::ivec2 raw = world_to_screen_raw(params, p.x, p.y);
+        return glm::ivec2{raw.x + widget_offset_x_, raw.y + widget_offset_y_};
+    };
+
+    // Grow the clip area by the widest line so edges just outside still get their caps
+    const lv_area_t& clip = layer->_clip_area;
+    const int x1 = clip.x1 - kLodCullMarginPx;
+    const int y1 = clip.y1 - kLodCullMarginPx;
+    const int x2 = clip.x2 + kLodCullMarginPx;
+    const int y2 = clip.y2 + kLodCullMarginPx;
+
+    // Projected XY box: both 2D views are linear, so the four corners bound it
+    auto box_visible = [&](const glm::vec2& min, const glm::vec2& max) {
+        glm::ivec2 corners[4] = {to_screen(min), to_screen(max), to_screen({min.x, max.y}),
+                                 to_screen({max.x, min.y})};
+        int min_x = corners[0].x, max_x = corners[0].x;
+        int min_y = corners[0].y, max_y = corners[0].y;
+        for (const auto& c : corners) {
+            min_x = std::min(min_x, c.x);
+            max_x = std::max(max_x, c.x);
+            min_y = std::min(min_y, c.y);
+            max_y = std::max(max_y, c.y);
+        }
+        return max_x >= x1 && min_x <= x2 && max_y >= y1 && min_y <= y2;
+    };
+
+    if (lod.polylines.empty() ||
+        !box_visible({lod.bounds.min.x, lod.bounds.min.y}, {lod.bounds.max.x, lod.bounds.max.y})) {
+        return 0;
+    }
+
+    size_t lines = 0;
+    lv_draw_line_dsc_t dsc;
+    for (const auto& polyline : lod.polylines) {
+        if (!box_visible(polyline.min, polyline.max)) {
+            continue;
+        }
+
+        // Style once per polyline; only the points change per edge
+        lv_draw_line_dsc_init(&dsc);
+        apply_segment_style(dsc, polyline.style);
+
+        glm::ivec2 p1 = to_screen(polyline.points[0]);
+        for (size_t i = 1; i < polyline.points.size(); ++i) {
+            glm::ivec2 p2 = to_screen(polyline.points[i]);
+            bool outside = (p1.x < x1 && p2.x < x1) || (p1.x > x2 && p2.x > x2) ||
+                           (p1.y < y1 && p2.y < y1) || (p1.y > y2 && p2.y > y2);
+            if (!outside && p1 != p2) {
+                dsc.p1.x = static_cast<lv_value_precise_t>(p1.x);
+                dsc.p1.y = static_cast<lv_value_precise_t>(p1.y);
+                dsc.p2.x = static_cast<lv_value_precise_t>(p2.x);
+                dsc.p2.y = static_cast<lv_value_precise_t>(p2.y);
+                lv_draw_line(layer, &dsc);
+                ++lines;
+            }
+            p1 = p2;
+        }
+    }
+    return lines;
 }
 
 // ============================================================================
@@ -1098,31 +1419,16 @@ std::optional<std::string> GCodeLayerRenderer::pick_object_at(int screen_x, int
 
     const float PICK_THRESHOLD = kPickThresholdPx;
     float closest_distance = std::numeric_limits<float>::max();
-    std::optional<std::string> picked_object;
-
-    // Get segments for current layer
-    std::shared_ptr<const std::vector<ToolpathSegment>> segments_holder;
-    const std::vector<ToolpathSegment>* segments = nullptr;
-
-    if (streaming_controller_) {
-        segments_holder =
-            streaming_controller_->get_layer_segments(static_cast<size_t>(current_layer_));
-        segments = segments_holder.get();
-    } else if (gcode_) {
-        segments = &gcode_->layers[static_cast<size_t>(current_layer_)].segments;
-    }
-
-    if (!segments)
-        return std::nullopt;
+    ObjectId picked_id = NO_OBJECT_ID;
 
     glm::vec2 click_pos(static_cast<float>(screen_x), static_cast<float>(screen_y));
 
-    for (const auto& seg : *segments) {
+    for_each_layer_segment(current_layer_, [&](const ToolpathSegment& seg) {
         if (!should_render_segment(seg))
-            continue;
+            return;
 
-        if (seg.object_name.empty())
-            continue;
+        if (seg.object_id == NO_OBJECT_ID)
+            return;
 
         // Project segment endpoints to screen space
         glm::ivec2 p1 = world_to_screen_raw(transform, seg.start.x, seg.start.y, seg.start.z);
@@ -1143,22 +1449,22 @@ std::optional<std::string> GCodeLayerRenderer::pick_object_at(int screen_x, int
 
         if (dist < PICK_THRESHOLD && dist < closest_distance) {
             closest_distance = dist;
-            picked_object = seg.object_name;
+            picked_id = seg.object_id;
         }
-    }
+    });
 
-    return picked_object;
+    if (picked_id == NO_OBJECT_ID)
+        return std::nullopt;
+    return current_object_table().name(picked_id);
 }
 
 lv_color_t GCodeLayerRenderer::get_segment_color(const ToolpathSegment& seg) const {
     // Check excluded/highlighted state first
-    if (!seg.object_name.empty()) {
-        if (excluded_objects_.count(seg.object_name) > 0) {
-            return lv_color_hex(kExcludedObjectColor);
-        }
-        if (highlighted_objects_.count(seg.object_name) > 0) {
-            return lv_color_hex(kHighlightedObjectColor);
-        }
+    if (excluded_ids_.test(seg.object_id)) {
+        return lv_color_hex(kExcludedObjectColor);
+    }
+    if (highlighted_ids_.test(seg.object_id)) {
+        return lv_color_hex(kHighlightedObjectColor);
     }
 
     // Existing logic below
@@ -1267,66 +1573,35 @@ void GCodeLayerRenderer::render_selection_brackets(lv_layer_t* layer) {
 }
 
 // ============================================================================
-// Background Thread Ghost Rendering
+// Ghost Rendering (drawn by the raster worker)
 // ============================================================================
 // LVGL drawing APIs are not thread-safe. To avoid blocking the UI during
-// ghost cache generation, we render to a raw pixel buffer in a background
-// thread using software Bresenham line drawing, then copy to the LVGL
-// draw buffer on the main thread when complete.
+// ghost cache generation, the worker draws all layers into a RasterImage and
+// publishes it; render() copies it into the LVGL draw buffer once complete.
 
 void GCodeLayerRenderer::start_background_ghost_render() {
-    // Cancel any existing render first
-    cancel_background_ghost_render();
+    ghost_submitted_generation_ = ghost_generation_;
 
-    // Need either gcode or streaming controller
     int layer_count = get_layer_count();
     if (layer_count == 0) {
         return;
     }
 
-    // Allocate raw buffer if dimensions changed or not allocated
-    int width = canvas_width_;
-    int height = canvas_height_;
-    size_t stride = static_cast<size_t>(width) * 4; // ARGB8888 = 4 bytes per pixel
-    size_t buffer_size = stride * static_cast<size_t>(height);
-
-    if (ghost_raw_width_ != width || ghost_raw_height_ != height || !ghost_raw_buffer_) {
-        ghost_raw_buffer_ = std::make_unique<uint8_t[]>(buffer_size);
-        ghost_raw_width_ = width;
-        ghost_raw_height_ = height;
-        ghost_raw_stride_ = static_cast<int>(stride);
-    }
-
-    // Clear buffer to transparent black (ARGB = 0x00000000)
-    std::memset(ghost_raw_buffer_.get(), 0, buffer_size);
-
-    // Reset flags
-    ghost_thread_cancel_.store(false);
-    ghost_thread_ready_.store(false);
-
-    // Launch background thread - only set running flag after successful creation
-    try {
-        ghost_thread_ = std::thread(&GCodeLayerRenderer::background_ghost_render_thread, this);
-        ghost_thread_running_.store(true);
-    } catch (const std::system_error& e) {
-        spdlog::error("[GCodeLayerRenderer] Failed to start ghost render thread: {}", e.what());
-        return;
-    }
+    RasterPass pass =
+        capture_raster_pass(ghost_generation_, layer_count - 1, canvas_width_, canvas_height_);
+    raster_worker_.submit(RasterLane::Ghost,
+                          [this, pass = std::move(pass)](const std::atomic<bool>& stop) {
+                              raster_ghost_layers(pass, stop);
+                          });
 
-    spdlog::debug("[GCodeLayerRenderer] Started background ghost render thread ({}x{})", width,
-                  height);
+    spdlog::debug("[GCodeLayerRenderer] Queued background ghost render ({}x{})", canvas_width_,
+                  canvas_height_);
 }
 
-void GCodeLayerRenderer::cancel_background_ghost_render() {
-    // Signal cancellation and join if the thread is joinable.
-    // This handles the case where the thread completed naturally but wasn't
-    // joined yet - we MUST join before assigning a new thread or std::terminate() is called.
-    ghost_thread_cancel_.store(true);
-    if (ghost_thread_.joinable()) {
-        ghost_thread_.join();
-    }
-    ghost_thread_running_.store(false);
-    ghost_thread_cancel_.store(false); // Reset for next run
+void GCodeLayerRenderer::stop_raster_jobs() {
+    raster_worker_.cancel(RasterLane::Solid);
+    raster_worker_.cancel(RasterLane::Ghost);
+    raster_worker_.wait_idle();
 }
 
 // =============================================================================
@@ -1334,239 +1609,118 @@ void GCodeLayerRenderer::cancel_background_ghost_render() {
 // =============================================================================
 
 float GCodeLayerRenderer::get_ghost_build_progress() const {
-    // Background thread running: return 0.5 (in progress)
-    // Background thread ready: return 1.0 (complete)
-    // Otherwise: return 1.0 (nothing to do or already done)
-    return ghost_thread_ready_.load() ? 1.0f : (ghost_thread_running_.load() ? 0.5f : 1.0f);
+    // Worker running: return 0.5 (in progress)
+    // Otherwise: return 1.0 (nothing to do, or done and waiting to be copied)
+    return raster_worker_.is_busy(RasterLane::Ghost) ? 0.5f : 1.0f;
 }
 
 bool GCodeLayerRenderer::is_ghost_build_complete() const {
-    return ghost_thread_ready_.load() || ghost_cache_valid_;
+    return ghost_chain_.has_new() || ghost_cache_valid_;
 }
 
 bool GCodeLayerRenderer::is_ghost_build_running() const {
-    return ghost_thread_running_.load();
+    return raster_worker_.is_busy(RasterLane::Ghost);
 }
 
-void GCodeLayerRenderer::background_ghost_render_thread() {
-    // Works with both full-file mode (gcode_) and streaming mode (streaming_controller_)
-    if (!ghost_raw_buffer_ || (!gcode_ && !streaming_controller_)) {
-        ghost_thread_running_.store(false);
-        return;
-    }
-
+void GCodeLayerRenderer::raster_ghost_layers(const RasterPass& pass,
+                                             const std::atomic<bool>& stop) {
     // Use std::chrono for timing - lv_tick_get() is not thread-safe
     auto start_time = std::chrono::steady_clock::now();
     size_t segments_rendered = 0;
-    int total_layers = get_layer_count();
+    int total_layers = pass.target_layer + 1;
 
-    // =========================================================================
-    // THREAD SAFETY: Capture ALL shared state at thread start
-    // These values may be modified by the main thread during rendering, so we
-    // take a snapshot to ensure consistent rendering throughout.
-    // =========================================================================
-
-    // Use TransformParams for unified coordinate conversion - includes content offset!
-    // This is the SINGLE SOURCE OF TRUTH for coordinate transforms.
-    TransformParams transform = capture_transform_params();
-    // Override canvas size with ghost buffer dimensions (may differ from display)
-    transform.canvas_width = ghost_raw_width_;
-    transform.canvas_height = ghost_raw_height_;
-
-    // Visibility flags (can be changed via set_show_*() on main thread)
-    const bool local_show_travels = show_travels_.load(std::memory_order_relaxed);
-    const bool local_show_extrusions = show_extrusions_.load(std::memory_order_relaxed);
-    const bool local_show_supports = show_supports_.load(std::memory_order_relaxed);
-
-    // Color (can be changed via set_extrusion_color() on main thread)
-    const lv_color_t local_color_extrusion = color_extrusion_;
-
-    // Tool palette (for multi-color ghost rendering)
-    const GCodeColorPalette local_tool_palette = tool_palette_;
-    const bool local_use_custom_extrusion = use_custom_extrusion_color_;
-
-    // Capture extrusion pixel width (uses scale_ which may change on main thread)
-    const int local_line_width = get_extrusion_pixel_width();
-
-    // Capture excluded objects for ghost rendering (thread-safe copy)
-    const auto local_excluded = excluded_objects_;
-
-    // Local version of should_render_segment using captured flags
-    auto local_should_render = [&](const ToolpathSegment& seg) -> bool {
-        if (seg.is_extrusion) {
-            if (is_support_segment(seg)) // Only reads seg fields, safe
-                return local_show_supports;
-            return local_show_extrusions;
-        }
-        return local_show_travels;
+    // Called again after pausing for a solid job: carry on where it stopped.
+    // A pass that already published has nothing left to do.
+    bool same_pass = ghost_drawn_generation_ == pass.generation;
+    if (same_pass && ghost_drawn_layer_ >= pass.target_layer) {
+        return;
+    }
+    RasterImage& image = ghost_chain_.begin_frame();
+    if (!same_pass || image.width != pass.transform.canvas_width ||
+        image.height != pass.transform.canvas_height) {
+        image.resize(pass.transform.canvas_width, pass.transform.canvas_height);
+        image.clear();
+        image.generation = pass.generation;
+        image.tag = -1;
+        ghost_drawn_generation_ = pass.generation;
+        ghost_drawn_layer_ = -1;
+    }
+    const int first_layer = ghost_drawn_layer_ + 1;
+
+    // Streaming files add object names as layers load, so re-resolve when the table grows
+    ObjectIdSet local_excluded;
+    size_t local_object_count = SIZE_MAX;
+
+    // Compute ghost color once (darkened extrusion color)
+    // ARGB8888: full alpha, we'll apply 40% when blitting
+    auto darken = [](uint32_t r, uint32_t g, uint32_t b) {
+        return (255u << 24) | ((r * kGhostDarkenPercent / 100) << 16) |
+               ((g * kGhostDarkenPercent / 100) << 8) | (b * kGhostDarkenPercent / 100);
     };
+    const lv_color_t base = pass.color_extrusion;
+    const uint32_t ghost_color = darken(base.red, base.green, base.blue);
+    const uint32_t excluded_color = darken(kExcludedR, kExcludedG, kExcludedB);
 
-    // Compute ghost color once (darkened extrusion color from captured value)
-    // ARGB8888: A in high byte, R, G, B in lower bytes
-    uint8_t ghost_r = local_color_extrusion.red * kGhostDarkenPercent / 100;
-    uint8_t ghost_g = local_color_extrusion.green * kGhostDarkenPercent / 100;
-    uint8_t ghost_b = local_color_extrusion.blue * kGhostDarkenPercent / 100;
-    uint8_t ghost_a = 255; // Full alpha, we'll apply 40% when blitting
-    uint32_t ghost_color = (ghost_a << 24) | (ghost_r << 16) | (ghost_g << 8) | ghost_b;
-
-    // Render all layers to raw buffer
     // Works with both full-file mode (gcode_) and streaming mode (streaming_controller_)
-    for (int layer_idx = 0; layer_idx < total_layers; ++layer_idx) {
-        // Check for cancellation periodically
-        if (ghost_thread_cancel_.load()) {
-            spdlog::debug("[GCodeLayerRenderer] Ghost render cancelled at layer {}/{}", layer_idx,
+    for (int layer_idx = first_layer; layer_idx < total_layers; ++layer_idx) {
+        if (stop.load(std::memory_order_relaxed)) {
+            spdlog::debug("[GCodeLayerRenderer] Ghost render stopped at layer {}/{}", layer_idx,
                           total_layers);
-            ghost_thread_running_.store(false);
             return;
         }
 
-        // Get segments from appropriate source
-        // CRITICAL: For streaming mode, hold shared_ptr to keep data alive during iteration.
-        // This prevents use-after-free if cache evicts the layer while we're iterating.
-        std::shared_ptr<const std::vector<ToolpathSegment>> segments_holder;
-        const std::vector<ToolpathSegment>* segments = nullptr;
-
-        if (streaming_controller_) {
-            // Streaming mode: get segments from controller (returns shared_ptr)
-            segments_holder =
-                streaming_controller_->get_layer_segments(static_cast<size_t>(layer_idx));
-            segments = segments_holder.get();
-        } else if (gcode_) {
-            segments = &gcode_->layers[layer_idx].segments;
+        size_t object_count = current_object_count();
+        if (!pass.excluded_names.empty() && object_count != local_object_count) {
+            local_object_count = object_count;
+            local_excluded = current_object_table().to_id_set(pass.excluded_names);
         }
 
-        if (!segments)
-            continue;
-
-        for (const auto& seg : *segments) {
-            if (!local_should_render(seg))
-                continue;
-
-            // Use unified world_to_screen_raw - includes content offset!
-            glm::ivec2 p1 = world_to_screen_raw(transform, seg.start.x, seg.start.y, seg.start.z);
-            glm::ivec2 p2 = world_to_screen_raw(transform, seg.end.x, seg.end.y, seg.end.z);
-
-            // Skip zero-length segments
-            if (p1.x == p2.x && p1.y == p2.y)
-                continue;
+        // Streaming layers stay alive for the whole call even if the cache evicts them
+        for_each_layer_segment(layer_idx, [&](const ToolpathSegment& seg) {
+            if (!pass_shows_segment(pass, seg))
+                return;
 
             // Per-segment ghost color (tool palette or single color)
             uint32_t seg_color = ghost_color;
-            if (local_tool_palette.has_tool_colors()) {
-                lv_color_t tc = local_tool_palette.resolve(seg.tool_index, local_color_extrusion);
-                uint8_t tr = tc.red * kGhostDarkenPercent / 100;
-                uint8_t tg = tc.green * kGhostDarkenPercent / 100;
-                uint8_t tb = tc.blue * kGhostDarkenPercent / 100;
-                seg_color = (255u << 24) | (tr << 16) | (tg << 8) | tb;
-            }
-            if (!seg.object_name.empty() && local_excluded.count(seg.object_name) > 0) {
-                // Excluded: dim orange-red
-                uint8_t ex_r = kExcludedR * kGhostDarkenPercent / 100;
-                uint8_t ex_g = kExcludedG * kGhostDarkenPercent / 100;
-                uint8_t ex_b = kExcludedB * kGhostDarkenPercent / 100;
-                seg_color = (255u << 24) | (ex_r << 16) | (ex_g << 8) | ex_b;
+            if (local_excluded.test(seg.object_id)) {
+                seg_color = excluded_color; // Excluded: dim orange-red
+            } else if (pass.tool_palette.has_tool_colors()) {
+                lv_color_t tc = pass.tool_palette.resolve(seg.tool_index, base);
+                seg_color = darken(tc.red, tc.green, tc.blue);
             }
 
-            // Draw line using Bresenham algorithm (width-aware)
-            draw_thick_line_bresenham(p1.x, p1.y, p2.x, p2.y, seg_color, local_line_width);
+            glm::vec2 p1 = project_subpixel(pass.transform, seg.start.x, seg.start.y, seg.start.z);
+            glm::vec2 p2 = project_subpixel(pass.transform, seg.end.x, seg.end.y, seg.end.z);
+            draw_line_aa(image, p1, p2, pass.line_width, seg_color);
             ++segments_rendered;
-        }
+        });
+        ghost_drawn_layer_ = layer_idx;
     }
 
-    // Mark as ready for main thread to copy
-    ghost_thread_ready_.store(true);
-    ghost_thread_running_.store(false);
+    image.tag = pass.target_layer;
+    ghost_chain_.publish(false);
 
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                        std::chrono::steady_clock::now() - start_time)
                        .count();
     spdlog::debug(
         "[GCodeLayerRenderer] Background ghost render complete: {} layers, {} segments in {}ms",
-        total_layers, segments_rendered, elapsed);
-}
-
-void GCodeLayerRenderer::copy_raw_to_ghost_buf() {
-    if (!ghost_thread_ready_.load() || !ghost_raw_buffer_ || !ghost_buf_) {
-        return;
-    }
-
-    // Validate dimensions match - if canvas was resized during background render,
-    // the raw buffer dimensions won't match the LVGL buffer
-    // LVGL 9: dimensions are in the header struct
-    uint32_t lvgl_width = ghost_buf_->header.w;
-    uint32_t lvgl_height = ghost_buf_->header.h;
-    if (ghost_raw_width_ != static_cast<int>(lvgl_width) ||
-        ghost_raw_height_ != static_cast<int>(lvgl_height)) {
-        spdlog::warn("[GCodeLayerRenderer] Ghost buffer dimension mismatch (raw {}x{} vs LVGL "
-                     "{}x{}), discarding",
-                     ghost_raw_width_, ghost_raw_height_, lvgl_width, lvgl_height);
-        ghost_thread_ready_.store(false);
-        return;
-    }
-
-    // Get LVGL buffer stride (may differ from our raw stride due to alignment)
-    // LVGL 9: stride is in the header struct
-    uint32_t lvgl_stride = ghost_buf_->header.stride;
-
-    if (static_cast<int>(lvgl_stride) == ghost_raw_stride_) {
-        // Fast path: strides match, single memcpy
-        size_t buffer_size = static_cast<size_t>(ghost_raw_stride_) * ghost_raw_height_;
-        std::memcpy(ghost_buf_->data, ghost_raw_buffer_.get(), buffer_size);
-    } else {
-        // Slow path: strides differ, copy row by row
-        spdlog::debug("[GCodeLayerRenderer] Stride mismatch (raw {} vs LVGL {}), row-by-row copy",
-                      ghost_raw_stride_, lvgl_stride);
-        for (int y = 0; y < ghost_raw_height_; ++y) {
-            std::memcpy(static_cast<uint8_t*>(ghost_buf_->data) + y * lvgl_stride,
-                        ghost_raw_buffer_.get() + y * ghost_raw_stride_,
-                        ghost_raw_width_ * 4); // Copy only actual pixel data (4 bytes per pixel)
-        }
-    }
-
-    ghost_cache_valid_ = true;
-    ghost_thread_ready_.store(false); // Consumed
-
-    spdlog::debug("[GCodeLayerRenderer] Copied raw ghost buffer to LVGL ({}x{})", ghost_raw_width_,
-                  ghost_raw_height_);
+        total_layers - first_layer, segments_rendered, elapsed);
 }
 
-void GCodeLayerRenderer::blend_pixel(int x, int y, uint32_t color) {
-    // Bounds check
-    if (x < 0 || x >= ghost_raw_width_ || y < 0 || y >= ghost_raw_height_) {
+void GCodeLayerRenderer::take_ghost_frame() {
+    const RasterImage* image = ghost_chain_.acquire();
+    if (!image || image->generation != ghost_generation_) {
         return;
     }
-
-    // Calculate pixel offset (ARGB8888 = 4 bytes per pixel)
-    uint8_t* pixel = ghost_raw_buffer_.get() + y * ghost_raw_stride_ + x * 4;
-
-    // Simple overwrite for now (could add alpha blending later)
-    // LVGL uses ARGB8888: byte order is B, G, R, A on little-endian
-    pixel[0] = color & 0xFF;         // B
-    pixel[1] = (color >> 8) & 0xFF;  // G
-    pixel[2] = (color >> 16) & 0xFF; // R
-    pixel[3] = (color >> 24) & 0xFF; // A
-}
-
-void GCodeLayerRenderer::blend_pixel_solid(int x, int y, uint32_t color) {
-    // Bounds check using cached dimensions
-    if (x < 0 || x >= cached_width_ || y < 0 || y >= cached_height_ || !cache_buf_) {
-        return;
+    if (copy_image_to_draw_buf(*image, ghost_buf_)) {
+        ghost_cache_valid_ = true;
+        spdlog::debug("[GCodeLayerRenderer] Copied ghost image to LVGL ({}x{})", image->width,
+                      image->height);
     }
-
-    // Get stride from LVGL buffer (may differ from width * 4 due to alignment)
-    uint32_t stride = cache_buf_->header.stride;
-
-    // Calculate pixel offset (ARGB8888 = 4 bytes per pixel)
-    uint8_t* pixel = static_cast<uint8_t*>(cache_buf_->data) + y * stride + x * 4;
-
-    // LVGL uses ARGB8888: byte order is B, G, R, A on little-endian
-    pixel[0] = color & 0xFF;         // B
-    pixel[1] = (color >> 8) & 0xFF;  // G
-    pixel[2] = (color >> 16) & 0xFF; // R
-    pixel[3] = (color >> 24) & 0xFF; // A
 }
 
-int GCodeLayerRenderer::get_extrusion_pixel_width() const {
+float GCodeLayerRenderer::get_extrusion_pixel_width() const {
     float width_mm = kDefaultExtrusionWidthMm;
 
     if (gcode_) {
@@ -1579,133 +1733,8 @@ int GCodeLayerRenderer::get_extrusion_pixel_width() const {
     }
     // Streaming mode: no metadata available, use default 0.4mm
 
-    int pixel_width = static_cast<int>(std::round(width_mm * scale_));
-    return std::clamp(pixel_width, kMinExtrusionPixelWidth, kMaxExtrusionPixelWidth);
-}
-
-void GCodeLayerRenderer::draw_thick_line_bresenham(int x0, int y0, int x1, int y1, uint32_t color,
-                                                   int width) {
-    if (width <= 1) {
-        draw_line_bresenham(x0, y0, x1, y1, color);
-        return;
-    }
-
-    // Compute perpendicular direction to the line
-    float dx = static_cast<float>(x1 - x0);
-    float dy = static_cast<float>(y1 - y0);
-    float len = std::sqrt(dx * dx + dy * dy);
-
-    if (len < kMinLineLength) {
-        draw_line_bresenham(x0, y0, x1, y1, color);
-        return;
-    }
-
-    // Perpendicular unit vector (rotated 90 degrees)
-    float px = -dy / len;
-    float py = dx / len;
-
-    // Draw parallel lines offset by [-width/2, +width/2]
-    float half = static_cast<float>(width - 1) * 0.5f;
-    for (int i = 0; i < width; ++i) {
-        float offset = static_cast<float>(i) - half;
-        int ox = static_cast<int>(std::round(px * offset));
-        int oy = static_cast<int>(std::round(py * offset));
-        draw_line_bresenham(x0 + ox, y0 + oy, x1 + ox, y1 + oy, color);
-    }
-}
-
-void GCodeLayerRenderer::draw_thick_line_bresenham_solid(int x0, int y0, int x1, int y1,
-                                                         uint32_t color, int width) {
-    if (width <= 1) {
-        draw_line_bresenham_solid(x0, y0, x1, y1, color);
-        return;
-    }
-
-    // Compute perpendicular direction to the line
-    float dx = static_cast<float>(x1 - x0);
-    float dy = static_cast<float>(y1 - y0);
-    float len = std::sqrt(dx * dx + dy * dy);
-
-    if (len < kMinLineLength) {
-        draw_line_bresenham_solid(x0, y0, x1, y1, color);
-        return;
-    }
-
-    // Perpendicular unit vector (rotated 90 degrees)
-    float px = -dy / len;
-    float py = dx / len;
-
-    // Draw parallel lines offset by [-width/2, +width/2]
-    float half = static_cast<float>(width - 1) * 0.5f;
-    for (int i = 0; i < width; ++i) {
-        float offset = static_cast<float>(i) - half;
-        int ox = static_cast<int>(std::round(px * offset));
-        int oy = static_cast<int>(std::round(py * offset));
-        draw_line_bresenham_solid(x0 + ox, y0 + oy, x1 + ox, y1 + oy, color);
-    }
-}
-
-void GCodeLayerRenderer::draw_line_bresenham_solid(int x0, int y0, int x1, int y1, uint32_t color) {
-    // Bresenham's line algorithm for software line drawing to solid cache
-
-    int dx = std::abs(x1 - x0);
-    int dy = -std::abs(y1 - y0);
-    int sx = x0 < x1 ? 1 : -1;
-    int sy = y0 < y1 ? 1 : -1;
-    int err = dx + dy;
-
-    while (true) {
-        blend_pixel_solid(x0, y0, color);
-
-        if (x0 == x1 && y0 == y1)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 >= dy) {
-            if (x0 == x1)
-                break;
-            err += dy;
-            x0 += sx;
-        }
-        if (e2 <= dx) {
-            if (y0 == y1)
-                break;
-            err += dx;
-            y0 += sy;
-        }
-    }
-}
-
-void GCodeLayerRenderer::draw_line_bresenham(int x0, int y0, int x1, int y1, uint32_t color) {
-    // Bresenham's line algorithm for software line drawing
-    // This runs in the background thread where LVGL APIs are not available
-
-    int dx = std::abs(x1 - x0);
-    int dy = -std::abs(y1 - y0);
-    int sx = x0 < x1 ? 1 : -1;
-    int sy = y0 < y1 ? 1 : -1;
-    int err = dx + dy;
-
-    while (true) {
-        blend_pixel(x0, y0, color);
-
-        if (x0 == x1 && y0 == y1)
-            break;
-
-        int e2 = 2 * err;
-        if (e2 >= dy) {
-            if (x0 == x1)
-                break;
-            err += dy;
-            x0 += sx;
-        }
-        if (e2 <= dx) {
-            if (y0 == y1)
-                break;
-            err += dx;
-            y0 += sy;
-        }
-    }
+    // Anti-aliased lines take fractional widths, so no rounding
+    return std::clamp(width_mm * scale_, kMinExtrusionPixelWidth, kMaxExtrusionPixelWidth);
 }
 
 // ============================================================================
@@ -1719,88 +1748,27 @@ void GCodeLayerRenderer::load_config() {
         return;
     }
 
-    // Load layers_per_frame: 0 = adaptive, 1-100 = fixed
+    // Load layers_per_frame: 0 = publish by time, 1-100 = fixed
     config_layers_per_frame_ = config->get<int>("/gcode_viewer/layers_per_frame", 0);
     config_layers_per_frame_ = std::clamp(config_layers_per_frame_, 0, MAX_LAYERS_PER_FRAME);
 
     if (config_layers_per_frame_ > 0) {
-        // Fixed value from config
+        // Fixed value from config: publish the solid image every N layers
         layers_per_frame_ =
             std::clamp(config_layers_per_frame_, MIN_LAYERS_PER_FRAME, MAX_LAYERS_PER_FRAME);
         spdlog::info("[GCodeLayerRenderer] Using fixed layers_per_frame: {}", layers_per_frame_);
     } else {
-        // Adaptive mode - start with default, adjust based on render time
+        // Time-based: publish every adaptive_target_ms_ however many layers that is
         layers_per_frame_ = DEFAULT_LAYERS_PER_FRAME;
-        spdlog::debug("[GCodeLayerRenderer] Using adaptive layers_per_frame (starting at {})",
-                      layers_per_frame_);
+        spdlog::debug("[GCodeLayerRenderer] Publishing layer progress by time");
     }
 
-    // Load adaptive target (only used when config_layers_per_frame_ == 0)
+    // Load publish interval (only used when config_layers_per_frame_ == 0)
     adaptive_target_ms_ =
         config->get<int>("/gcode_viewer/adaptive_layer_target_ms", DEFAULT_ADAPTIVE_TARGET_MS);
     adaptive_target_ms_ = std::clamp(adaptive_target_ms_, 1, 100); // Sensible bounds
 
-    spdlog::debug("[GCodeLayerRenderer] Adaptive target: {}ms", adaptive_target_ms_);
-
-    // Detect device tier and apply appropriate limits for constrained devices
-    auto mem_info = ::helix::get_system_memory_info();
-    is_constrained_device_ = mem_info.is_constrained_device();
-
-    if (is_constrained_device_) {
-        max_layers_per_frame_ = CONSTRAINED_MAX_LPF;
-        if (config_layers_per_frame_ == 0) { // Adaptive mode
-            layers_per_frame_ = CONSTRAINED_START_LPF;
-        }
-        spdlog::info(
-            "[GCodeLayerRenderer] Constrained device detected: lpf capped at {}, starting at {}",
-            max_layers_per_frame_, layers_per_frame_);
-    }
-}
-
-void GCodeLayerRenderer::adapt_layers_per_frame() {
-    // Only adapt when in adaptive mode (config value == 0)
-    if (config_layers_per_frame_ != 0) {
-        return;
-    }
-
-    // Skip adaptation if no meaningful render time yet
-    if (last_frame_render_ms_ == 0) {
-        return;
-    }
-
-    // Adaptive algorithm:
-    // - If render time < target: increase layers_per_frame to cache faster
-    // - If render time > target: decrease layers_per_frame to avoid UI stutter
-    // - Use exponential moving average to smooth adjustments
-
-    int old_lpf = layers_per_frame_;
-
-    if (last_frame_render_ms_ < static_cast<uint32_t>(adaptive_target_ms_)) {
-        // Under budget - can render more layers
-        // Scale up proportionally but cap growth (conservative on constrained devices)
-        float ratio = static_cast<float>(adaptive_target_ms_) / std::max(1u, last_frame_render_ms_);
-        float max_growth = is_constrained_device_ ? CONSTRAINED_GROWTH_CAP : 2.0f;
-        ratio = std::min(ratio, max_growth);
-        int new_lpf = static_cast<int>(layers_per_frame_ * ratio);
-        // Smooth increase (take average of current and target)
-        layers_per_frame_ = (layers_per_frame_ + new_lpf) / 2;
-    } else if (last_frame_render_ms_ > static_cast<uint32_t>(adaptive_target_ms_ * 2)) {
-        // Significantly over budget - reduce aggressively
-        float ratio = static_cast<float>(adaptive_target_ms_) / std::max(1u, last_frame_render_ms_);
-        layers_per_frame_ = static_cast<int>(layers_per_frame_ * ratio);
-    } else if (last_frame_render_ms_ > static_cast<uint32_t>(adaptive_target_ms_)) {
-        // Slightly over budget - reduce gradually
-        layers_per_frame_ = layers_per_frame_ * 3 / 4; // 75% of current
-    }
-
-    // Clamp to valid range (using device-aware max)
-    layers_per_frame_ = std::clamp(layers_per_frame_, MIN_LAYERS_PER_FRAME, max_layers_per_frame_);
-
-    // Log significant changes
-    if (layers_per_frame_ != old_lpf) {
-        spdlog::trace("[GCodeLayerRenderer] Adaptive lpf: {} -> {} (render={}ms, target={}ms)",
-                      old_lpf, layers_per_frame_, last_frame_render_ms_, adaptive_target_ms_);
-    }
+    spdlog::debug("[GCodeLayerRenderer] Layer publish interval: {}ms", adaptive_target_ms_);
 }
 
 } // namespace gcode
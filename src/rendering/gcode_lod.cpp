@@ -0,0 +1,159 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_lod.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+/// Squared distance from @p p to the segment a-b
+float distance_sq_to_segment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    glm::vec2 ab = b - a;
+    glm::vec2 ap = p - a;
+    float length_sq = glm::dot(ab, ab);
+    float t = length_sq > 0.0f ? std::clamp(glm::dot(ap, ab) / length_sq, 0.0f, 1.0f) : 0.0f;
+    glm::vec2 d = ap - ab * t;
+    return glm::dot(d, d);
+}
+
+bool same_style(const ToolpathSegment& a, const ToolpathSegment& b) {
+    if (a.is_extrusion != b.is_extrusion || a.tool_index != b.tool_index ||
+        a.object_id != b.object_id) {
+        return false;
+    }
+    // Without ids (unresolved tables) the name still decides support colouring
+    return a.object_id != NO_OBJECT_ID || a.object_name == b.object_name;
+}
+
+glm::vec2 xy(const glm::vec3& p) {
+    return {p.x, p.y};
+}
+
+} // namespace
+
+// ============================================================================
+// Zoom buckets
+// ============================================================================
+
+int lod_zoom_bucket(float scale) {
+    if (!(scale > 0.0f)) {
+        return 0;
+    }
+    return static_cast<int>(std::ceil(std::log2(scale) * LOD_BUCKETS_PER_OCTAVE));
+}
+
+float lod_bucket_scale(int bucket) {
+    return std::exp2(static_cast<float>(bucket) / LOD_BUCKETS_PER_OCTAVE);
+}
+
+float lod_tolerance_mm(int bucket, float max_error_px) {
+    return max_error_px / lod_bucket_scale(bucket);
+}
+
+size_t LodLayer::edge_count() const {
+    size_t edges = 0;
+    for (const auto& polyline : polylines) {
+        edges += polyline.points.size() - 1;
+    }
+    return edges;
+}
+
+// ============================================================================
+// PolylineDecimator
+// ============================================================================
+
+PolylineDecimator::PolylineDecimator(float tolerance_mm)
+    : tolerance_(std::max(tolerance_mm, 0.0f)), tolerance_sq_(tolerance_ * tolerance_) {
+    skipped_.reserve(MAX_SKIPPED);
+}
+
+void PolylineDecimator::add(const ToolpathSegment& seg) {
+    ++layer_.source_segments;
+    layer_.bounds.expand(seg.start);
+    layer_.bounds.expand(seg.end);
+
+    if (!continues(seg)) {
+        close_polyline();
+        open_ = true;
+        current_.style = seg;
+        current_.points.push_back(xy(seg.start));
+    } else {
+        // Within the tolerance, but it still has to stay near the result
+        extend(xy(seg.start));
+    }
+    extend(xy(seg.end));
+}
+
+LodLayer PolylineDecimator::finish() {
+    close_polyline();
+    LodLayer result = std::move(layer_);
+    layer_ = LodLayer{};
+    return result;
+}
+
+bool PolylineDecimator::continues(const ToolpathSegment& seg) const {
+    if (!open_ || !same_style(current_.style, seg)) {
+        return false;
+    }
+    glm::vec2 last = has_candidate_ ? candidate_ : current_.points.back();
+    glm::vec2 gap = xy(seg.start) - last;
+    return glm::dot(gap, gap) <= tolerance_sq_;
+}
+
+void PolylineDecimator::extend(const glm::vec2& point) {
+    if (!has_candidate_) {
+        if (point != current_.points.back()) {
+            candidate_ = point;
+            has_candidate_ = true;
+        }
+        return;
+    }
+    if (point == candidate_) {
+        return;
+    }
+
+    // Can the edge from the last vertex go straight to point, dropping the candidate?
+    const glm::vec2& anchor = current_.points.back();
+    bool fits = skipped_.size() < MAX_SKIPPED &&
+                distance_sq_to_segment(candidate_, anchor, point) <= tolerance_sq_;
+    for (size_t i = 0; fits && i < skipped_.size(); ++i) {
+        fits = distance_sq_to_segment(skipped_[i], anchor, point) <= tolerance_sq_;
+    }
+
+    if (fits) {
+        skipped_.push_back(candidate_);
+    } else {
+        current_.points.push_back(candidate_);
+        skipped_.clear();
+    }
+    candidate_ = point;
+}
+
+void PolylineDecimator::close_polyline() {
+    if (!open_) {
+        return;
+    }
+    if (has_candidate_) {
+        current_.points.push_back(candidate_);
+    }
+    if (current_.points.size() >= 2) {
+        current_.min = current_.max = current_.points.front();
+        for (const auto& p : current_.points) {
+            current_.min = glm::min(current_.min, p);
+            current_.max = glm::max(current_.max, p);
+        }
+        layer_.polylines.push_back(std::move(current_));
+    }
+    current_ = LodPolyline{};
+    open_ = false;
+    has_candidate_ = false;
+    skipped_.clear();
+}
+
+} // namespace gcode
+} // namespace helix
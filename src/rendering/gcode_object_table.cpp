@@ -0,0 +1,89 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_object_table.h"
+
+#include <algorithm>
+
+namespace helix {
+namespace gcode {
+
+// ============================================================================
+// ObjectIdSet
+// ============================================================================
+
+bool ObjectIdSet::any() const {
+    return std::any_of(words_.begin(), words_.end(), [](uint64_t w) { return w != 0; });
+}
+
+size_t ObjectIdSet::count() const {
+    size_t total = 0;
+    for (uint64_t w : words_) {
+        total += static_cast<size_t>(__builtin_popcountll(w));
+    }
+    return total;
+}
+
+bool ObjectIdSet::operator==(const ObjectIdSet& other) const {
+    // Trailing zero words don't change membership
+    size_t common = std::min(words_.size(), other.words_.size());
+    if (!std::equal(words_.begin(), words_.begin() + static_cast<ptrdiff_t>(common),
+                    other.words_.begin())) {
+        return false;
+    }
+    const auto& longer = words_.size() > other.words_.size() ? words_ : other.words_;
+    return std::all_of(longer.begin() + static_cast<ptrdiff_t>(common), longer.end(),
+                       [](uint64_t w) { return w == 0; });
+}
+
+// ============================================================================
+// ObjectSymbolTable
+// ============================================================================
+
+ObjectId ObjectSymbolTable::intern(std::string_view name) {
+    if (name.empty()) {
+        return NO_OBJECT_ID;
+    }
+    ObjectId existing = find(name);
+    if (existing != NO_OBJECT_ID) {
+        return existing;
+    }
+    if (names_.size() >= MAX_OBJECTS) {
+        return NO_OBJECT_ID;
+    }
+    auto id = static_cast<ObjectId>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+ObjectId ObjectSymbolTable::find(std::string_view name) const {
+    if (name.empty()) {
+        return NO_OBJECT_ID;
+    }
+    // C++17 unordered_map has no heterogeneous lookup; names are short, so
+    // the temporary usually stays in the SSO buffer
+    auto it = ids_.find(std::string(name));
+    return it == ids_.end() ? NO_OBJECT_ID : it->second;
+}
+
+const std::string& ObjectSymbolTable::name(ObjectId id) const {
+    static const std::string empty;
+    return id < names_.size() ? names_[id] : empty;
+}
+
+void ObjectSymbolTable::clear() {
+    names_.clear();
+    ids_.clear();
+}
+
+ObjectIdSet ObjectSymbolTable::to_id_set(const std::unordered_set<std::string>& names) const {
+    ObjectIdSet set;
+    for (const auto& n : names) {
+        set.set(find(n));
+    }
+    return set;
+}
+
+} // namespace gcode
+} // namespace helix
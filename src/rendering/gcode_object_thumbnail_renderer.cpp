@@ -7,6 +7,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstring>
@@ -103,7 +104,9 @@ GCodeObjectThumbnailRenderer::render_impl(const ParsedGCodeFile* gcode, int thum
     // Build per-object render contexts with coordinate transforms
     auto contexts = build_contexts(gcode, thumb_width, thumb_height);
 
-    if (contexts.empty()) {
+    bool any_context = std::any_of(contexts.begin(), contexts.end(),
+                                   [](const ObjectRenderContext& c) { return c.pixels; });
+    if (!any_context) {
         spdlog::debug("[ObjectThumbnail] No valid object contexts (all empty bounding boxes?)");
         return result;
     }
@@ -120,19 +123,16 @@ GCodeObjectThumbnailRenderer::render_impl(const ParsedGCodeFile* gcode, int thum
 
         const auto& layer = gcode->layers[layer_idx];
         for (const auto& seg : layer.segments) {
-            // Skip non-extrusion and unnamed segments
-            if (!seg.is_extrusion || seg.object_name.empty()) {
+            // Skip non-extrusion and unnamed segments (NO_OBJECT_ID is out of range)
+            if (!seg.is_extrusion || seg.object_id >= contexts.size()) {
                 continue;
             }
 
-            // Find the render context for this object
-            auto it = contexts.find(seg.object_name);
-            if (it == contexts.end()) {
+            auto& ctx = contexts[seg.object_id];
+            if (!ctx.pixels) {
                 continue;
             }
 
-            auto& ctx = it->second;
-
             // Convert world coordinates to pixel coordinates (FRONT view with Z)
             int px0, py0, px1, py1;
             world_to_pixel(ctx, seg.start.x, seg.start.y, seg.start.z, px0, py0);
@@ -158,9 +158,12 @@ GCodeObjectThumbnailRenderer::render_impl(const ParsedGCodeFile* gcode, int thum
     }
 
     // Convert contexts to output thumbnails
-    for (auto& [name, ctx] : contexts) {
+    for (auto& ctx : contexts) {
+        if (!ctx.pixels) {
+            continue;
+        }
         ObjectThumbnail thumb;
-        thumb.object_name = name;
+        thumb.object_name = std::move(ctx.name);
         thumb.pixels = std::move(ctx.pixels);
         thumb.width = ctx.width;
         thumb.height = ctx.height;
@@ -176,10 +179,10 @@ GCodeObjectThumbnailRenderer::render_impl(const ParsedGCodeFile* gcode, int thum
     return result;
 }
 
-std::unordered_map<std::string, GCodeObjectThumbnailRenderer::ObjectRenderContext>
+std::vector<GCodeObjectThumbnailRenderer::ObjectRenderContext>
 GCodeObjectThumbnailRenderer::build_contexts(const ParsedGCodeFile* gcode, int thumb_width,
                                              int thumb_height) {
-    std::unordered_map<std::string, ObjectRenderContext> contexts;
+    std::vector<ObjectRenderContext> contexts;
 
     if (thumb_width <= 0 || thumb_height <= 0) {
         return contexts;
@@ -188,18 +191,22 @@ GCodeObjectThumbnailRenderer::build_contexts(const ParsedGCodeFile* gcode, int t
     // Padding factor for auto-fit (5% each side, matching layer renderer)
     constexpr float kPadding = 0.05f;
 
+    // Indexed by ObjectId; objects without a drawable bbox keep a null buffer
+    contexts.resize(gcode->object_table.size());
+
     for (const auto& [name, obj] : gcode->objects) {
         const auto& bbox = obj.bounding_box;
+        ObjectId id = gcode->object_table.find(name);
 
-        // Skip objects with empty/degenerate bounding boxes
-        if (bbox.is_empty()) {
+        // Skip objects with empty/degenerate bounding boxes or no id
+        if (bbox.is_empty() || id == NO_OBJECT_ID) {
             continue;
         }
 
         // Use shared auto-fit with FRONT projection (isometric view)
         auto fit = compute_auto_fit(bbox, ViewMode::FRONT, thumb_width, thumb_height, kPadding);
 
-        ObjectRenderContext ctx;
+        ObjectRenderContext& ctx = contexts[id];
         ctx.name = name;
         ctx.width = thumb_width;
         ctx.height = thumb_height;
@@ -224,8 +231,6 @@ GCodeObjectThumbnailRenderer::build_contexts(const ParsedGCodeFile* gcode, int t
         size_t buf_size = static_cast<size_t>(ctx.height) * ctx.stride;
         ctx.pixels = std::make_unique<uint8_t[]>(buf_size);
         std::memset(ctx.pixels.get(), 0, buf_size);
-
-        contexts.emplace(name, std::move(ctx));
     }
 
     return contexts;
@@ -0,0 +1,482 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_parallel_parser.h"
+
+#include "gcode_mapped_file.h"
+#include "gcode_parallel.h"
+#include "gcode_tokenizer.h"
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+// Same tolerance GCodeParser::start_new_layer() uses to merge layers
+constexpr float LAYER_Z_EPSILON = 0.001f;
+
+// How far past a split target to look for a layer marker line
+constexpr size_t MARKER_SEARCH_BYTES = 256 * 1024;
+
+constexpr size_t AXIS_COUNT = 4; ///< X, Y, Z, E
+constexpr size_t E_AXIS = 3;
+
+constexpr uint8_t axis_bit(size_t axis) {
+    return static_cast<uint8_t>(1u << axis); // Matches MoveWords::X .. MoveWords::E
+}
+
+float axis_word(const MoveWords& words, size_t axis) {
+    switch (axis) {
+    case 0:
+        return words.x;
+    case 1:
+        return words.y;
+    case 2:
+        return words.z;
+    default:
+        return words.e;
+    }
+}
+
+/// Which G90/G91 (or M82/M83) a word was read under
+enum class Mode : uint8_t {
+    Entry,    ///< No mode command before it in the range: whatever the range started with
+    Absolute, ///< G90 / M82
+    Relative, ///< G91 / M83
+};
+
+/**
+ * @brief Modal state at the end of a range, as far as the range alone decides it
+ *
+ * Built by scanning the range backwards, so the first occurrence of anything is
+ * the last one in file order and nothing after it needs parsing.
+ */
+struct RangeSummary {
+    struct Axis {
+        bool found{false};      ///< Range has a word for this axis
+        float value{0.0f};      ///< The last such word
+        Mode mode{Mode::Entry}; ///< Mode that word was read under
+    };
+    std::array<Axis, AXIS_COUNT> axes;
+    Mode positioning{Mode::Entry}; ///< Last G90/G91
+    Mode extrusion{Mode::Entry};   ///< Last M82/M83
+
+    bool has_tool{false};
+    int tool{0};
+
+    bool has_object{false}; ///< An EXCLUDE_OBJECT_START decides the object
+    std::string object;     ///< Object after that START and any ENDs following it
+    std::unordered_set<std::string> ended; ///< EXCLUDE_OBJECT_END names after the last START
+
+    bool has_wipe_tower{false};
+    bool in_wipe_tower{false};
+
+    bool layer_marker{false};
+    bool has_layer_height{false};
+    float layer_height{0.0f};
+    bool moved{false}; ///< Range has an X or Y word
+};
+
+RangeSummary summarize_range(std::string_view range) {
+    RangeSummary s;
+    uint8_t pending_axes = 0; // Words still waiting for the mode command that governs them
+
+    auto resolve = [&s, &pending_axes](uint8_t axes, Mode mode) {
+        for (size_t i = 0; i < AXIS_COUNT; ++i) {
+            if (pending_axes & axes & axis_bit(i)) {
+                s.axes[i].mode = mode;
+            }
+        }
+        pending_axes &= static_cast<uint8_t>(~axes);
+    };
+    constexpr uint8_t XYZ = MoveWords::X | MoveWords::Y | MoveWords::Z;
+
+    size_t end = range.size();
+    while (end > 0) {
+        size_t line_end = range[end - 1] == '\n' ? end - 1 : end;
+        size_t newline = line_end == 0 ? std::string_view::npos : range.rfind('\n', line_end - 1);
+        size_t line_start = newline == std::string_view::npos ? 0 : newline + 1;
+        end = line_start;
+
+        GCodeLine tokens = tokenize_line(range.substr(line_start, line_end - line_start));
+
+        if (!tokens.comment.empty()) {
+            if (is_layer_marker(tokens.comment)) {
+                s.layer_marker = true;
+            } else if (!s.has_layer_height) {
+                s.has_layer_height =
+                    GCodeParser::parse_layer_height_comment(tokens.comment, s.layer_height);
+            }
+            if (!s.has_wipe_tower) {
+                s.has_wipe_tower =
+                    GCodeParser::parse_wipe_tower_comment(tokens.comment, s.in_wipe_tower);
+            }
+        }
+
+        switch (tokens.command) {
+        case GCodeCommand::Move: {
+            MoveWords words = scan_move_words(tokens.code);
+            for (size_t i = 0; i < AXIS_COUNT; ++i) {
+                if (!s.axes[i].found && words.has(axis_bit(i))) {
+                    s.axes[i].found = true;
+                    s.axes[i].value = axis_word(words, i);
+                    pending_axes |= axis_bit(i);
+                }
+            }
+            s.moved = s.moved || words.has(MoveWords::X) || words.has(MoveWords::Y);
+            break;
+        }
+        case GCodeCommand::Absolute:
+        case GCodeCommand::Relative: {
+            Mode mode = tokens.command == GCodeCommand::Absolute ? Mode::Absolute : Mode::Relative;
+            if (s.positioning == Mode::Entry) {
+                s.positioning = mode;
+            }
+            resolve(XYZ, mode);
+            break;
+        }
+        case GCodeCommand::AbsoluteE:
+        case GCodeCommand::RelativeE: {
+            Mode mode =
+                tokens.command == GCodeCommand::AbsoluteE ? Mode::Absolute : Mode::Relative;
+            if (s.extrusion == Mode::Entry) {
+                s.extrusion = mode;
+            }
+            resolve(MoveWords::E, mode);
+            break;
+        }
+        case GCodeCommand::ToolChange:
+            if (!s.has_tool) {
+                s.has_tool = parse_tool_number(tokens.code, s.tool);
+            }
+            break;
+        case GCodeCommand::ExcludeObject: {
+            if (s.has_object) {
+                break;
+            }
+            std::string_view name;
+            bool named = find_string_param(tokens.code, "NAME", name);
+            if (tokens.code.compare(0, 20, "EXCLUDE_OBJECT_START") == 0) {
+                s.has_object = true;
+                if (named && s.ended.count(std::string(name)) == 0) {
+                    s.object.assign(name.data(), name.size());
+                }
+            } else if (tokens.code.compare(0, 18, "EXCLUDE_OBJECT_END") == 0 && named) {
+                s.ended.emplace(name);
+            }
+            break;
+        }
+        case GCodeCommand::None:
+        case GCodeCommand::Other:
+            break;
+        }
+
+        bool complete = s.positioning != Mode::Entry && s.extrusion != Mode::Entry &&
+                        pending_axes == 0 && s.has_tool && s.has_object && s.has_wipe_tower &&
+                        s.layer_marker && s.has_layer_height && s.moved;
+        for (const auto& axis : s.axes) {
+            complete = complete && axis.found;
+        }
+        if (complete) {
+            break;
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Advance @p state past a range
+ * @param known Per-axis flag: XYZ value is exact (cleared by relative moves)
+ */
+void apply_summary(const RangeSummary& s, GCodeModalState& state, std::array<bool, 3>& known) {
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& axis = s.axes[i];
+        if (!axis.found) {
+            continue;
+        }
+        bool absolute = axis.mode == Mode::Entry ? state.absolute_positioning
+                                                 : axis.mode == Mode::Absolute;
+        if (absolute) {
+            state.position[static_cast<int>(i)] = axis.value;
+            known[i] = true;
+        } else {
+            known[i] = false; // Would need every relative word since the last absolute one
+        }
+    }
+
+    // Relative E deltas don't depend on the running total, so a relative last word
+    // leaves E as is. Only a later M82 would see the difference, and the sequential
+    // total is no better there (G92 is not tracked).
+    const auto& e = s.axes[E_AXIS];
+    if (e.found) {
+        bool absolute =
+            e.mode == Mode::Entry ? state.absolute_extrusion : e.mode == Mode::Absolute;
+        if (absolute) {
+            state.e = e.value;
+        }
+    }
+
+    if (s.positioning != Mode::Entry) {
+        state.absolute_positioning = s.positioning == Mode::Absolute;
+    }
+    if (s.extrusion != Mode::Entry) {
+        state.absolute_extrusion = s.extrusion == Mode::Absolute;
+    }
+    if (s.has_tool) {
+        state.tool_index = s.tool;
+    }
+    if (s.has_object) {
+        state.object_name = s.object;
+    } else if (s.ended.count(state.object_name) > 0) {
+        state.object_name.clear();
+    }
+    if (s.has_wipe_tower) {
+        state.in_wipe_tower = s.in_wipe_tower;
+    }
+    state.use_layer_markers = state.use_layer_markers || s.layer_marker;
+    if (s.has_layer_height) {
+        state.layer_height_mm = s.layer_height;
+    }
+    state.has_moved = state.has_moved || s.moved;
+}
+
+/// Start of the line after @p pos (or @p size)
+size_t next_line_start(const char* data, size_t size, size_t pos) {
+    std::string_view text(data, size);
+    size_t newline = text.find('\n', pos);
+    return newline == std::string_view::npos ? size : newline + 1;
+}
+
+/// Start of the first layer marker line in [pos, limit), or @p pos if there is none
+size_t find_marker_line(const char* data, size_t size, size_t pos, size_t limit) {
+    for (size_t line = pos; line < limit; line = next_line_start(data, size, line)) {
+        size_t i = line;
+        while (i < size && (data[i] == ' ' || data[i] == '\t')) {
+            i++;
+        }
+        if (i < size && data[i] == ';') {
+            size_t line_end = next_line_start(data, size, i);
+            if (is_layer_marker(std::string_view(data + i, line_end - i))) {
+                return line;
+            }
+        }
+    }
+    return pos;
+}
+
+/// Range start offsets, the first always 0
+std::vector<size_t> split_points(const char* data, size_t size, unsigned count) {
+    std::vector<size_t> starts{0};
+    for (unsigned t = 1; t < count; ++t) {
+        size_t target = size / count * t;
+        if (target <= starts.back()) {
+            continue;
+        }
+        size_t pos = next_line_start(data, size, target);
+        pos = find_marker_line(data, size, pos, std::min(size, pos + MARKER_SEARCH_BYTES));
+        if (pos > starts.back() && pos < size) {
+            starts.push_back(pos);
+        }
+    }
+    return starts;
+}
+
+/// Append @p part (the next range of the file) to @p result
+void merge_part(ParsedGCodeFile& result, ParsedGCodeFile& part) {
+    // First definition wins, as in GCodeParser (later ranges only see the name)
+    for (auto& [name, object] : part.objects) {
+        result.objects.try_emplace(name, std::move(object));
+    }
+
+    // Object ids: names first seen in this range come after every earlier one
+    std::vector<ObjectId> remap(part.object_table.size());
+    std::vector<GCodeObject*> defined(part.object_table.size(), nullptr);
+    for (size_t id = 0; id < remap.size(); ++id) {
+        const std::string& name = part.object_table.name(static_cast<ObjectId>(id));
+        remap[id] = result.object_table.intern(name);
+        auto it = result.objects.find(name);
+        defined[id] = it != result.objects.end() ? &it->second : nullptr;
+    }
+    for (auto& layer : part.layers) {
+        for (auto& segment : layer.segments) {
+            if (segment.object_id == NO_OBJECT_ID || segment.object_id >= remap.size()) {
+                continue;
+            }
+            // Object bounds cover extrusions made while the object was defined
+            GCodeObject* object = defined[segment.object_id];
+            if (object && segment.is_extrusion) {
+                object->bounding_box.expand(segment.start);
+                object->bounding_box.expand(segment.end);
+            }
+            segment.object_id = remap[segment.object_id];
+        }
+    }
+
+    // A layer split across the seam continues in this range at the same Z
+    auto next = part.layers.begin();
+    if (next != part.layers.end() && !result.layers.empty() &&
+        std::abs(next->z_height - result.layers.back().z_height) < LAYER_Z_EPSILON) {
+        Layer& last = result.layers.back();
+        if (!next->bounding_box.is_empty()) {
+            last.bounding_box.expand(next->bounding_box.min);
+            last.bounding_box.expand(next->bounding_box.max);
+        }
+        last.segments.insert(last.segments.end(), std::make_move_iterator(next->segments.begin()),
+                             std::make_move_iterator(next->segments.end()));
+        last.segment_count_extrusion += next->segment_count_extrusion;
+        last.segment_count_travel += next->segment_count_travel;
+        if (next->byte_length > 0) {
+            if (last.byte_length == 0) {
+                last.file_offset = next->file_offset;
+            }
+            last.byte_length =
+                static_cast<uint32_t>(next->file_offset + next->byte_length - last.file_offset);
+        }
+        ++next;
+    }
+    result.layers.insert(result.layers.end(), std::make_move_iterator(next),
+                         std::make_move_iterator(part.layers.end()));
+    if (!part.global_bounding_box.is_empty()) {
+        result.global_bounding_box.expand(part.global_bounding_box.min);
+        result.global_bounding_box.expand(part.global_bounding_box.max);
+    }
+
+    // Metadata: the last value set wins, as it would parsing line by line
+    auto take_string = [](std::string& into, std::string& from) {
+        if (!from.empty()) {
+            into = std::move(from);
+        }
+    };
+    auto take_number = [](auto& into, auto from) {
+        if (from != 0) {
+            into = from;
+        }
+    };
+    take_string(result.slicer_name, part.slicer_name);
+    take_string(result.filament_type, part.filament_type);
+    take_string(result.filament_color_hex, part.filament_color_hex);
+    take_string(result.printer_model, part.printer_model);
+    take_number(result.nozzle_diameter_mm, part.nozzle_diameter_mm);
+    take_number(result.total_filament_mm, part.total_filament_mm);
+    take_number(result.filament_weight_g, part.filament_weight_g);
+    take_number(result.filament_cost, part.filament_cost);
+    take_number(result.estimated_print_time_minutes, part.estimated_print_time_minutes);
+    take_number(result.total_layer_count, part.total_layer_count);
+    take_number(result.first_layer_height_mm, part.first_layer_height_mm);
+    take_number(result.perimeter_extrusion_width_mm, part.perimeter_extrusion_width_mm);
+    take_number(result.infill_extrusion_width_mm, part.infill_extrusion_width_mm);
+    take_number(result.first_layer_extrusion_width_mm, part.first_layer_extrusion_width_mm);
+    if (result.extrusion_width_mm == 0.0f) {
+        result.extrusion_width_mm = part.extrusion_width_mm; // Parser keeps the first one
+    }
+    result.layer_height_mm = part.layer_height_mm; // Seeded, so already the running value
+    if (!part.tool_color_palette.empty()) {
+        result.tool_color_palette = std::move(part.tool_color_palette);
+    }
+}
+
+} // namespace
+
+ParsedGCodeFile ParallelGCodeParser::parse(const char* data, size_t size) const {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    unsigned threads = parallel_thread_count(max_threads_, size, min_range_bytes_);
+    if (threads <= 1) {
+        GCodeParser parser;
+        parser.parse_buffer(data, size);
+        return parser.finalize();
+    }
+
+    std::vector<size_t> starts = split_points(data, size, threads);
+    auto range_end = [&starts, size](size_t i) {
+        return i + 1 < starts.size() ? starts[i + 1] : size;
+    };
+
+    // Phase 1: what each range leaves behind (the last range's is never needed)
+    std::vector<RangeSummary> summaries(starts.size() - 1);
+    parallel_for(summaries.size(), [&](size_t i) {
+        summaries[i] =
+            summarize_range(std::string_view(data + starts[i], range_end(i) - starts[i]));
+    });
+
+    // Phase 2: entry state of every range; a range entered with an unknown
+    // relative-mode position is folded into the one before it
+    struct Range {
+        size_t begin;
+        size_t end;
+        GCodeModalState entry;
+    };
+    std::vector<Range> ranges{{0, range_end(0), GCodeModalState{}}};
+    GCodeModalState state;
+    std::array<bool, 3> known{true, true, true};
+    for (size_t i = 1; i < starts.size(); ++i) {
+        apply_summary(summaries[i - 1], state, known);
+        if (known[0] && known[1] && known[2]) {
+            ranges.push_back({starts[i], range_end(i), state});
+        } else {
+            ranges.back().end = range_end(i);
+        }
+    }
+
+    // Phase 3: parse every range with its entry state
+    std::vector<ParsedGCodeFile> parts(ranges.size());
+    std::vector<std::exception_ptr> errors(ranges.size());
+    parallel_for(ranges.size(), [&](size_t i) {
+        try {
+            GCodeParser parser;
+            parser.set_modal_state(ranges[i].entry);
+            parser.set_byte_offset(ranges[i].begin);
+            parser.parse_buffer(data + ranges[i].begin, ranges[i].end - ranges[i].begin);
+            parts[i] = parser.finalize();
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Phase 4: stitch
+    ParsedGCodeFile result = std::move(parts[0]);
+    for (size_t i = 1; i < parts.size(); ++i) {
+        merge_part(result, parts[i]);
+    }
+    result.total_segments = 0;
+    for (const auto& layer : result.layers) {
+        result.total_segments += layer.segments.size();
+    }
+
+    auto elapsed = std::chrono::high_resolution_clock::now() - start_time;
+    spdlog::info("[GCode Parser] Parsed {} bytes in {} ranges ({} split points unusable): "
+                 "{} layers, {} segments, {:.1f}ms",
+                 size, ranges.size(), starts.size() - ranges.size(), result.layers.size(),
+                 result.total_segments,
+                 std::chrono::duration<double, std::milli>(elapsed).count());
+    return result;
+}
+
+std::optional<ParsedGCodeFile> ParallelGCodeParser::parse_file(const std::string& path) const {
+    MappedFile mapped;
+    if (!mapped.open(path)) {
+        return std::nullopt;
+    }
+    ParsedGCodeFile result = parse(mapped.data(), mapped.size());
+    result.filename = path;
+    return result;
+}
+
+} // namespace gcode
+} // namespace helix
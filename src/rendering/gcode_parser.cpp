@@ -3,6 +3,8 @@
 
 #include "gcode_parser.h"
 
+#include "gcode_tokenizer.h"
+
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
@@ -15,10 +17,57 @@
 namespace helix {
 namespace gcode {
 
+namespace {
+
+/// Object name given to segments inside a wipe tower section
+const std::string WIPE_TOWER_OBJECT = "__WIPE_TOWER__";
+
+bool starts_with(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+/// Case-insensitive equality; @p lower must be lower case
+bool equals_nocase(std::string_view text, std::string_view lower) {
+    if (text.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lower.size(); i++) {
+        if (std::tolower(static_cast<unsigned char>(text[i])) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Height in mm from a "0.2" / "0.2mm" metadata value, rejecting implausible values
+bool parse_height_value(std::string_view value, float& height_mm) {
+    std::string_view numeric_value = value.substr(0, value.find("mm"));
+    float h;
+    if (!parse_leading_float(numeric_value, h) || h <= 0.01f || h >= 2.0f) {
+        return false;
+    }
+    height_mm = h;
+    return true;
+}
+
+} // namespace
+
 // ============================================================================
 // ParsedGCodeFile Methods
 // ============================================================================
 
+void ParsedGCodeFile::index_objects() {
+    object_table.clear();
+    for (const auto& [name, obj] : objects) {
+        object_table.intern(name);
+    }
+    for (auto& layer : layers) {
+        for (auto& seg : layer.segments) {
+            seg.object_id = object_table.intern(seg.object_name);
+        }
+    }
+}
+
 int ParsedGCodeFile::find_layer_at_z(float z) const {
     if (layers.empty()) {
         return -1;
@@ -68,86 +117,154 @@ void GCodeParser::reset() {
     current_position_ = glm::vec3(0.0f, 0.0f, 0.0f);
     current_e_ = 0.0f;
     current_object_.clear();
+    current_object_id_ = NO_OBJECT_ID;
+    current_object_def_ = nullptr;
+    wipe_tower_id_ = NO_OBJECT_ID;
     is_absolute_positioning_ = true;
     is_absolute_extrusion_ = true;
     layers_.clear();
     objects_.clear();
+    object_table_.clear();
     global_bounds_ = AABB();
     lines_parsed_ = 0;
+    pending_line_.clear();
+    byte_offset_ = 0;
+    line_begin_ = 0;
+    line_end_ = 0;
+    has_moved_ = false;
     out_of_range_width_count_ = 0;
 
     // Layers will be created on-demand when segments are added
     // (see add_segment() which creates a layer if layers_ is empty)
 }
 
-void GCodeParser::parse_line(const std::string& line) {
-    lines_parsed_++;
+void GCodeParser::set_modal_state(const GCodeModalState& state) {
+    current_position_ = state.position;
+    current_e_ = state.e;
+    is_absolute_positioning_ = state.absolute_positioning;
+    is_absolute_extrusion_ = state.absolute_extrusion;
+    current_tool_index_ = state.tool_index;
+    current_object_ = state.object_name;
+    current_object_id_ =
+        current_object_.empty() ? NO_OBJECT_ID : object_table_.intern(current_object_);
+    auto defined = objects_.find(current_object_);
+    current_object_def_ = defined != objects_.end() ? &defined->second : nullptr;
+    in_wipe_tower_ = state.in_wipe_tower;
+    use_layer_markers_ = state.use_layer_markers;
+    pending_layer_marker_ = false;
+    metadata_layer_height_ = state.layer_height_mm;
+    has_moved_ = state.has_moved;
+}
 
-    // Extract and parse metadata comments before trimming
-    size_t comment_pos = line.find(';');
-    if (comment_pos != std::string::npos) {
-        std::string comment = line.substr(comment_pos);
-        parse_metadata_comment(comment);
-        parse_wipe_tower_marker(comment);
-    }
+GCodeModalState GCodeParser::modal_state() const {
+    GCodeModalState state;
+    state.position = current_position_;
+    state.e = current_e_;
+    state.absolute_positioning = is_absolute_positioning_;
+    state.absolute_extrusion = is_absolute_extrusion_;
+    state.tool_index = current_tool_index_;
+    state.object_name = current_object_;
+    state.in_wipe_tower = in_wipe_tower_;
+    state.use_layer_markers = use_layer_markers_;
+    state.layer_height_mm = metadata_layer_height_;
+    state.has_moved = has_moved_ || !layers_.empty();
+    return state;
+}
 
-    std::string trimmed = trim_line(line);
-    if (trimmed.empty()) {
-        return;
+bool GCodeParser::parse_layer_height_comment(std::string_view comment, float& height_mm) {
+    std::string_view key;
+    std::string_view value;
+    if (!split_metadata_comment(comment, key, value)) {
+        return false;
     }
+    if (!equals_nocase(key, "layer_height") && !equals_nocase(key, "layer height")) {
+        return false;
+    }
+    return parse_height_value(value, height_mm);
+}
 
-    // Check for tool changes (T0, T1, T2, etc.)
-    if (!trimmed.empty() && trimmed[0] == 'T') {
-        parse_tool_change_command(trimmed);
-        // Continue processing - some G-code files have commands after tool changes
+void GCodeParser::parse_buffer(const char* data, size_t size) {
+    std::string_view buffer(data, size);
+    size_t line_start = 0;
+    while (line_start < buffer.size()) {
+        size_t newline = buffer.find('\n', line_start);
+        if (newline == std::string_view::npos) {
+            // Incomplete line: keep it until the next buffer or finalize()
+            pending_line_.append(data + line_start, size - line_start);
+            break;
+        }
+        std::string_view line = buffer.substr(line_start, newline - line_start);
+        line_begin_ = byte_offset_ + line_start - pending_line_.size();
+        line_end_ = byte_offset_ + newline + 1;
+        if (pending_line_.empty()) {
+            parse_line(line);
+        } else {
+            pending_line_.append(line.data(), line.size());
+            parse_line(pending_line_);
+            pending_line_.clear();
+        }
+        line_start = newline + 1;
     }
+    byte_offset_ += size;
+}
 
-    // Check for EXCLUDE_OBJECT commands first
-    if (trimmed.find("EXCLUDE_OBJECT") == 0) {
-        parse_exclude_object_command(trimmed);
-        return;
+void GCodeParser::parse_line(std::string_view line) {
+    lines_parsed_++;
+
+    GCodeLine tokens = tokenize_line(line);
+
+    // Extract and parse metadata comments
+    if (!tokens.comment.empty()) {
+        parse_metadata_comment(tokens.comment);
+        parse_wipe_tower_marker(tokens.comment);
     }
 
-    // Parse positioning mode commands
-    if (trimmed == "G90") {
+    switch (tokens.command) {
+    case GCodeCommand::Move:
+        parse_movement_command(tokens.code);
+        break;
+    case GCodeCommand::Absolute:
         is_absolute_positioning_ = true;
-        return;
-    } else if (trimmed == "G91") {
+        break;
+    case GCodeCommand::Relative:
         is_absolute_positioning_ = false;
-        return;
-    } else if (trimmed == "M82") {
+        break;
+    case GCodeCommand::AbsoluteE:
         is_absolute_extrusion_ = true;
-        return;
-    } else if (trimmed == "M83") {
+        break;
+    case GCodeCommand::RelativeE:
         is_absolute_extrusion_ = false;
-        return;
-    }
-
-    // Parse movement commands (G0, G1)
-    if (trimmed[0] == 'G' && (trimmed.find("G0 ") == 0 || trimmed.find("G1 ") == 0 ||
-                              trimmed == "G0" || trimmed == "G1")) {
-        parse_movement_command(trimmed);
+        break;
+    case GCodeCommand::ToolChange:
+        parse_tool_change_command(tokens.code);
+        break;
+    case GCodeCommand::ExcludeObject:
+        parse_exclude_object_command(tokens.code);
+        break;
+    case GCodeCommand::None:
+    case GCodeCommand::Other:
+        break;
     }
 }
 
-bool GCodeParser::parse_movement_command(const std::string& line) {
+bool GCodeParser::parse_movement_command(std::string_view line) {
     glm::vec3 new_position = current_position_;
     float new_e = current_e_;
     bool has_movement = false;
     bool has_extrusion = false;
 
     // Extract X, Y, Z parameters
-    float value;
-    if (extract_param(line, 'X', value)) {
-        new_position.x = is_absolute_positioning_ ? value : current_position_.x + value;
+    MoveWords words = scan_move_words(line);
+    if (words.has(MoveWords::X)) {
+        new_position.x = is_absolute_positioning_ ? words.x : current_position_.x + words.x;
         has_movement = true;
     }
-    if (extract_param(line, 'Y', value)) {
-        new_position.y = is_absolute_positioning_ ? value : current_position_.y + value;
+    if (words.has(MoveWords::Y)) {
+        new_position.y = is_absolute_positioning_ ? words.y : current_position_.y + words.y;
         has_movement = true;
     }
-    if (extract_param(line, 'Z', value)) {
-        new_position.z = is_absolute_positioning_ ? value : current_position_.z + value;
+    if (words.has(MoveWords::Z)) {
+        new_position.z = is_absolute_positioning_ ? words.z : current_position_.z + words.z;
         has_movement = true;
 
         // Layer change detection:
@@ -169,8 +286,8 @@ bool GCodeParser::parse_movement_command(const std::string& line) {
     }
 
     // Extract E (extrusion) parameter
-    if (extract_param(line, 'E', value)) {
-        new_e = is_absolute_extrusion_ ? value : current_e_ + value;
+    if (words.has(MoveWords::E)) {
+        new_e = is_absolute_extrusion_ ? words.e : current_e_ + words.e;
         has_extrusion = true;
     }
 
@@ -181,7 +298,9 @@ bool GCodeParser::parse_movement_command(const std::string& line) {
         bool is_extruding = false;
         float e_delta = 0.0f;
         if (has_extrusion) {
-            e_delta = new_e - current_e_;
+            // Relative E is already a delta; recovering it from the running total would
+            // lose precision as the total grows (and make it depend on where parsing began)
+            e_delta = is_absolute_extrusion_ ? new_e - current_e_ : words.e;
             is_extruding = (e_delta > 0.00001f); // Small threshold for floating point
         }
 
@@ -197,26 +316,24 @@ bool GCodeParser::parse_movement_command(const std::string& line) {
     return has_movement;
 }
 
-bool GCodeParser::parse_exclude_object_command(const std::string& line) {
+bool GCodeParser::parse_exclude_object_command(std::string_view line) {
     // EXCLUDE_OBJECT_DEFINE NAME=... CENTER=... POLYGON=...
-    if (line.find("EXCLUDE_OBJECT_DEFINE") == 0) {
-        std::string name;
-        if (!extract_string_param(line, "NAME", name)) {
+    if (starts_with(line, "EXCLUDE_OBJECT_DEFINE")) {
+        std::string_view name;
+        if (!find_string_param(line, "NAME", name)) {
             return false;
         }
 
         GCodeObject obj;
-        obj.name = name;
+        obj.name = std::string(name);
 
         // Extract CENTER (format: "X,Y")
-        std::string center_str;
-        if (extract_string_param(line, "CENTER", center_str)) {
+        std::string_view center_str;
+        if (find_string_param(line, "CENTER", center_str)) {
             size_t comma = center_str.find(',');
-            if (comma != std::string::npos) {
-                try {
-                    obj.center.x = std::stof(center_str.substr(0, comma));
-                    obj.center.y = std::stof(center_str.substr(comma + 1));
-                } catch (...) {
+            if (comma != std::string_view::npos) {
+                if (!parse_leading_float(center_str.substr(0, comma), obj.center.x) ||
+                    !parse_leading_float(center_str.substr(comma + 1), obj.center.y)) {
                     // Internal parsing error - no user notification needed
                     spdlog::debug("[GCode Parser] Failed to parse CENTER for object: {}", name);
                 }
@@ -225,12 +342,9 @@ bool GCodeParser::parse_exclude_object_command(const std::string& line) {
 
         // Extract POLYGON (format: "[[x1,y1],[x2,y2],...]")
         // For now, we'll do basic parsing - full JSON parsing would be better
-        std::string polygon_str;
-        if (extract_string_param(line, "POLYGON", polygon_str)) {
-            // Simple extraction of number pairs
-            // Remove all whitespace first for easier parsing
-            polygon_str.erase(std::remove_if(polygon_str.begin(), polygon_str.end(), ::isspace),
-                              polygon_str.end());
+        std::string_view polygon_str;
+        if (find_string_param(line, "POLYGON", polygon_str)) {
+            // Simple extraction of number pairs; whitespace before a number is skipped
 
             // Skip outer opening bracket if present
             size_t pos = 0;
@@ -244,54 +358,65 @@ bool GCodeParser::parse_exclude_object_command(const std::string& line) {
                     pos++;
                     // Extract x coordinate (everything until comma)
                     size_t comma = polygon_str.find(',', pos);
-                    if (comma != std::string::npos) {
-                        try {
-                            float x = std::stof(polygon_str.substr(pos, comma - pos));
-                            pos = comma + 1;
-
-                            // Extract y coordinate (everything until closing bracket)
-                            size_t close = polygon_str.find(']', pos);
-                            if (close != std::string::npos) {
-                                float y = std::stof(polygon_str.substr(pos, close - pos));
-                                obj.polygon.push_back(glm::vec2(x, y));
-                                pos = close + 1;
-                                spdlog::trace("[GCode Parser] Parsed polygon point: ({}, {})", x,
-                                              y);
-                            } else {
-                                break;
-                            }
-                        } catch (...) {
-                            break;
-                        }
-                    } else {
+                    if (comma == std::string_view::npos) {
+                        break;
+                    }
+                    float x;
+                    if (!parse_leading_float(polygon_str.substr(pos, comma - pos), x)) {
+                        break;
+                    }
+                    pos = comma + 1;
+
+                    // Extract y coordinate (everything until closing bracket)
+                    size_t close = polygon_str.find(']', pos);
+                    float y;
+                    if (close == std::string_view::npos ||
+                        !parse_leading_float(polygon_str.substr(pos, close - pos), y)) {
                         break;
                     }
+                    obj.polygon.push_back(glm::vec2(x, y));
+                    pos = close + 1;
+                    spdlog::trace("[GCode Parser] Parsed polygon point: ({}, {})", x, y);
                 } else {
                     pos++;
                 }
             }
         }
 
-        objects_[name] = obj;
         spdlog::trace("[GCode Parser] Defined object: {} at ({}, {})", name, obj.center.x,
                       obj.center.y);
+        object_table_.intern(name);
+        GCodeObject& defined = objects_[obj.name];
+        defined = std::move(obj);
+        if (defined.name == current_object_) {
+            current_object_def_ = &defined; // Defined after its EXCLUDE_OBJECT_START
+        }
         return true;
     }
     // EXCLUDE_OBJECT_START NAME=...
-    else if (line.find("EXCLUDE_OBJECT_START") == 0) {
-        if (!extract_string_param(line, "NAME", current_object_)) {
+    else if (starts_with(line, "EXCLUDE_OBJECT_START")) {
+        std::string_view name;
+        if (!find_string_param(line, "NAME", name)) {
             current_object_.clear();
+            current_object_id_ = NO_OBJECT_ID;
+            current_object_def_ = nullptr;
             return false;
         }
+        current_object_.assign(name.data(), name.size());
+        current_object_id_ = object_table_.intern(name);
+        auto defined = objects_.find(current_object_);
+        current_object_def_ = defined != objects_.end() ? &defined->second : nullptr;
         spdlog::trace("[GCode Parser] Started object: {}", current_object_);
         return true;
     }
     // EXCLUDE_OBJECT_END NAME=...
-    else if (line.find("EXCLUDE_OBJECT_END") == 0) {
-        std::string name;
-        if (extract_string_param(line, "NAME", name) && name == current_object_) {
+    else if (starts_with(line, "EXCLUDE_OBJECT_END")) {
+        std::string_view name;
+        if (find_string_param(line, "NAME", name) && name == current_object_) {
             spdlog::trace("[GCode Parser] Ended object: {}", current_object_);
             current_object_.clear();
+            current_object_id_ = NO_OBJECT_ID;
+            current_object_def_ = nullptr;
             return true;
         }
     }
@@ -299,27 +424,14 @@ bool GCodeParser::parse_exclude_object_command(const std::string& line) {
     return false;
 }
 
-void GCodeParser::parse_metadata_comment(const std::string& line) {
+void GCodeParser::parse_metadata_comment(std::string_view line) {
     // OrcaSlicer/PrusaSlicer format: "; key = value"
     // Use fuzzy matching to handle variations across slicers
 
-    if (line.length() < 2 || line[0] != ';') {
-        return;
-    }
-
     // Check for layer change markers FIRST (before key=value parsing)
     // Common formats: ";LAYER_CHANGE", ";LAYER:N", "; LAYER_CHANGE"
-    std::string content_upper = line.substr(1);
-    // Remove leading whitespace for comparison
-    size_t ws_start = 0;
-    while (ws_start < content_upper.length() && std::isspace(content_upper[ws_start])) {
-        ws_start++;
-    }
-    content_upper = content_upper.substr(ws_start);
-    std::transform(content_upper.begin(), content_upper.end(), content_upper.begin(), ::toupper);
-
     // Detect layer change markers (but not LAYER_COUNT which is metadata)
-    if (content_upper.find("LAYER_CHANGE") == 0 || content_upper.find("LAYER:") == 0) {
+    if (is_layer_marker(line)) {
         // Mark that we found layer markers (prefer this over Z-based detection)
         use_layer_markers_ = true;
         pending_layer_marker_ = true;
@@ -328,57 +440,22 @@ void GCodeParser::parse_metadata_comment(const std::string& line) {
         return; // Don't process as key=value metadata
     }
 
-    // Skip '; ' to get key=value or key: value part
-    std::string content = line.substr(1);
-
-    // Trim leading whitespace
-    size_t start = 0;
-    while (start < content.length() && std::isspace(content[start])) {
-        start++;
-    }
-    content = content.substr(start);
-
     // Look for '=' or ':' separator (support both OrcaSlicer and PrusaSlicer formats)
-    size_t eq_pos = content.find('=');
-    size_t colon_pos = content.find(':');
-    size_t sep_pos = std::string::npos;
-
-    // Prefer '=' if present and before any ':', otherwise use ':'
-    if (eq_pos != std::string::npos && (colon_pos == std::string::npos || eq_pos < colon_pos)) {
-        sep_pos = eq_pos;
-    } else if (colon_pos != std::string::npos) {
-        sep_pos = colon_pos;
-    }
-
-    if (sep_pos == std::string::npos) {
+    std::string_view key;
+    std::string_view value;
+    if (!split_metadata_comment(line, key, value)) {
         return;
     }
 
-    // Extract key and value
-    std::string key = content.substr(0, sep_pos);
-    std::string value = content.substr(sep_pos + 1);
-
-    // Trim whitespace from key and value
-    auto trim = [](std::string& s) {
-        size_t start = 0;
-        while (start < s.length() && std::isspace(s[start]))
-            start++;
-        size_t end = s.length();
-        while (end > start && std::isspace(s[end - 1]))
-            end--;
-        s = s.substr(start, end - start);
-    };
-    trim(key);
-    trim(value);
-
-    // Convert key to lowercase for case-insensitive matching
-    std::string key_lower = key;
-    std::transform(key_lower.begin(), key_lower.end(), key_lower.begin(), ::tolower);
+    // Convert key to lowercase for case-insensitive matching (reuses the scratch buffer)
+    key_scratch_.assign(key.data(), key.size());
+    std::transform(key_scratch_.begin(), key_scratch_.end(), key_scratch_.begin(), ::tolower);
+    std::string_view key_lower = key_scratch_;
 
     // Helper to check if key contains all substrings (fuzzy match)
-    auto contains_all = [&key_lower](std::initializer_list<const char*> terms) {
+    auto contains_all = [key_lower](std::initializer_list<const char*> terms) {
         for (const char* term : terms) {
-            if (key_lower.find(term) == std::string::npos) {
+            if (key_lower.find(term) == std::string_view::npos) {
                 return false;
             }
         }
@@ -387,111 +464,82 @@ void GCodeParser::parse_metadata_comment(const std::string& line) {
 
     // Parse specific metadata fields with fuzzy matching
     // Multi-color: Check for extruder_colour first (priority over single filament_colour)
-    if (key_lower.find("extruder_colour") != std::string::npos ||
-        key_lower.find("extruder_color") != std::string::npos) {
+    if (key_lower.find("extruder_colour") != std::string_view::npos ||
+        key_lower.find("extruder_color") != std::string_view::npos) {
         parse_extruder_color_metadata(line);
     }
     // Fallback: Parse single filament_colour if extruder_colour not yet found
     else if (contains_all({"filament", "col"}) && tool_color_palette_.empty()) {
         // Check if it's a semicolon-separated list (multi-color)
-        if (value.find(';') != std::string::npos) {
+        if (value.find(';') != std::string_view::npos) {
             parse_extruder_color_metadata(line);
         } else {
             // Single color metadata
-            metadata_filament_color_ = value;
+            metadata_filament_color_ = std::string(value);
             spdlog::trace("[GCode Parser] Parsed single filament color: {}", value);
         }
     } else if (contains_all({"filament", "type"})) {
-        metadata_filament_type_ = value;
+        metadata_filament_type_ = std::string(value);
         spdlog::trace("[GCode Parser] Parsed filament type: {}", value);
     } else if (contains_all({"printer", "model"}) || contains_all({"printer", "name"})) {
-        metadata_printer_model_ = value;
+        metadata_printer_model_ = std::string(value);
         spdlog::trace("[GCode Parser] Parsed printer model: {}", value);
     } else if (contains_all({"nozzle", "diameter"})) {
-        try {
-            metadata_nozzle_diameter_ = std::stof(value);
+        if (parse_leading_float(value, metadata_nozzle_diameter_)) {
             spdlog::trace("[GCode Parser] Parsed nozzle diameter: {}mm", metadata_nozzle_diameter_);
-        } catch (...) {
         }
     } else if (contains_all({"filament"}) &&
-               (key_lower.find("[mm]") != std::string::npos || contains_all({"length"}))) {
-        try {
-            metadata_filament_length_ = std::stof(value);
+               (key_lower.find("[mm]") != std::string_view::npos || contains_all({"length"}))) {
+        if (parse_leading_float(value, metadata_filament_length_)) {
             spdlog::trace("[GCode Parser] Parsed filament length: {}mm", metadata_filament_length_);
-        } catch (...) {
         }
     } else if (contains_all({"filament"}) &&
-               (key_lower.find("[g]") != std::string::npos || contains_all({"weight"}))) {
-        try {
-            metadata_filament_weight_ = std::stof(value);
+               (key_lower.find("[g]") != std::string_view::npos || contains_all({"weight"}))) {
+        if (parse_leading_float(value, metadata_filament_weight_)) {
             spdlog::trace("[GCode Parser] Parsed filament weight: {}g", metadata_filament_weight_);
-        } catch (...) {
         }
     } else if (contains_all({"filament", "cost"}) || contains_all({"material", "cost"})) {
-        try {
-            metadata_filament_cost_ = std::stof(value);
+        if (parse_leading_float(value, metadata_filament_cost_)) {
             spdlog::trace("[GCode Parser] Parsed filament cost: ${}", metadata_filament_cost_);
-        } catch (...) {
         }
     } else if (contains_all({"layer"}) && contains_all({"total"}) &&
                (contains_all({"number"}) || contains_all({"count"}) ||
-                key_lower.find("total layer") != std::string::npos)) {
+                key_lower.find("total layer") != std::string_view::npos)) {
         // Match "total layer number", "total layers count", but NOT "interlocking_beam_layer_count"
-        try {
-            metadata_layer_count_ = std::stoi(value);
+        if (parse_leading_int(value, metadata_layer_count_)) {
             spdlog::trace("[GCode Parser] Parsed total layer count: {}", metadata_layer_count_);
-        } catch (...) {
         }
     } else if ((contains_all({"time"}) &&
                 (contains_all({"print"}) || contains_all({"estimated"}))) ||
                contains_all({"print", "time"})) {
         // Parse various time formats: "29m 25s", "1h 23m", "45s", etc.
         float minutes = 0.0f;
+        float number;
 
         // Try to find hours
         size_t h_pos = value.find('h');
-        if (h_pos != std::string::npos) {
-            try {
-                float hours = std::stof(value.substr(0, h_pos));
-                minutes += hours * 60.0f;
-            } catch (...) {
-            }
+        if (h_pos != std::string_view::npos &&
+            parse_leading_float(value.substr(0, h_pos), number)) {
+            minutes += number * 60.0f;
         }
 
         // Try to find minutes
         size_t m_pos = value.find('m');
-        if (m_pos != std::string::npos) {
-            try {
-                size_t start_pos = (h_pos != std::string::npos) ? h_pos + 1 : 0;
-                std::string min_str = value.substr(start_pos, m_pos - start_pos);
-                // Trim spaces
-                size_t min_start = 0;
-                while (min_start < min_str.length() && std::isspace(min_str[min_start]))
-                    min_start++;
-                if (min_start < min_str.length()) {
-                    minutes += std::stof(min_str.substr(min_start));
-                }
-            } catch (...) {
+        if (m_pos != std::string_view::npos) {
+            size_t start_pos = (h_pos != std::string_view::npos) ? h_pos + 1 : 0;
+            if (parse_leading_float(value.substr(start_pos, m_pos - start_pos), number)) {
+                minutes += number;
             }
         }
 
         // Try to find seconds
         size_t s_pos = value.find('s');
-        if (s_pos != std::string::npos) {
-            try {
-                size_t start_pos = (m_pos != std::string::npos)   ? m_pos + 1
-                                   : (h_pos != std::string::npos) ? h_pos + 1
-                                                                  : 0;
-                std::string sec_str = value.substr(start_pos, s_pos - start_pos);
-                // Trim spaces
-                size_t sec_start = 0;
-                while (sec_start < sec_str.length() && std::isspace(sec_str[sec_start]))
-                    sec_start++;
-                if (sec_start < sec_str.length()) {
-                    float seconds = std::stof(sec_str.substr(sec_start));
-                    minutes += seconds / 60.0f;
-                }
-            } catch (...) {
+        if (s_pos != std::string_view::npos) {
+            size_t start_pos = (m_pos != std::string_view::npos)   ? m_pos + 1
+                               : (h_pos != std::string_view::npos) ? h_pos + 1
+                                                                   : 0;
+            if (parse_leading_float(value.substr(start_pos, s_pos - start_pos), number)) {
+                minutes += number / 60.0f;
             }
         }
 
@@ -500,7 +548,7 @@ void GCodeParser::parse_metadata_comment(const std::string& line) {
             spdlog::trace("[GCode Parser] Parsed estimated time: {:.2f} minutes", minutes);
         }
     } else if (contains_all({"generated"}) || contains_all({"slicer"})) {
-        metadata_slicer_name_ = value;
+        metadata_slicer_name_ = std::string(value);
         spdlog::trace("[GCode Parser] Parsed slicer: {}", value);
     }
     // Parse layer height metadata (exact key match to avoid max_layer_height etc.)
@@ -508,113 +556,102 @@ void GCodeParser::parse_metadata_comment(const std::string& line) {
     // Cura: ";Layer height: 0.12"
     else if (key_lower == "layer_height" || key_lower == "layer height" ||
              key_lower == "first_layer_height" || key_lower == "first layer height") {
-        std::string numeric_value = value;
-        size_t mm_pos = numeric_value.find("mm");
-        if (mm_pos != std::string::npos) {
-            numeric_value = numeric_value.substr(0, mm_pos);
-        }
-        try {
-            float h = std::stof(numeric_value);
-            if (h > 0.01f && h < 2.0f) {
-                if (key_lower.find("first") != std::string::npos) {
-                    metadata_first_layer_height_ = h;
-                    spdlog::trace("[GCode Parser] Parsed first layer height: {}mm", h);
-                } else {
-                    metadata_layer_height_ = h;
-                    spdlog::trace("[GCode Parser] Parsed layer height: {}mm", h);
-                }
+        float h;
+        if (parse_height_value(value, h)) {
+            if (key_lower.find("first") != std::string_view::npos) {
+                metadata_first_layer_height_ = h;
+                spdlog::trace("[GCode Parser] Parsed first layer height: {}mm", h);
+            } else {
+                metadata_layer_height_ = h;
+                spdlog::trace("[GCode Parser] Parsed layer height: {}mm", h);
             }
-        } catch (...) {
         }
     }
     // Parse extrusion width metadata
     // OrcaSlicer/PrusaSlicer/SuperSlicer: "; perimeters extrusion width = 0.45mm"
     // Cura: ";SETTING_3 line_width = 0.4" or ";SETTING_3 wall_line_width_0 = 0.4"
     else if (contains_all({"extrusion", "width"}) ||
-             (key_lower.find("line_width") != std::string::npos) ||
-             (key_lower.find("linewidth") != std::string::npos)) {
-        // Extract numeric value (handle "0.45mm" format and plain "0.4")
-        std::string numeric_value = value;
-
+             (key_lower.find("line_width") != std::string_view::npos) ||
+             (key_lower.find("linewidth") != std::string_view::npos)) {
         // Skip percentage values (e.g., "100%", "112.5%") — OrcaSlicer's settings dump
         // at end of file uses percentages of nozzle diameter, not absolute mm values.
         // These would overwrite the correct mm values from the header comments.
-        if (numeric_value.find('%') != std::string::npos) {
+        if (value.find('%') != std::string_view::npos) {
             return;
         }
 
-        // Remove "mm" suffix if present
-        size_t mm_pos = numeric_value.find("mm");
-        if (mm_pos != std::string::npos) {
-            numeric_value = numeric_value.substr(0, mm_pos);
+        // Extract numeric value (handle "0.45mm" format and plain "0.4")
+        std::string_view numeric_value = value.substr(0, value.find("mm"));
+        float width;
+        if (!parse_leading_float(numeric_value, width)) {
+            return; // Failed to parse width value
         }
 
-        try {
-            float width = std::stof(numeric_value);
-
-            // Sanity check: extrusion widths should be 0.05mm to 3.0mm
-            if (width < 0.05f || width > 3.0f) {
-                spdlog::debug("[GCode Parser] Ignoring out-of-range extrusion width: {}mm", width);
-                return;
-            }
+        // Sanity check: extrusion widths should be 0.05mm to 3.0mm
+        if (width < 0.05f || width > 3.0f) {
+            spdlog::debug("[GCode Parser] Ignoring out-of-range extrusion width: {}mm", width);
+            return;
+        }
 
-            // Categorize by feature type
-            if (contains_all({"first", "layer"}) || contains_all({"initial", "layer"})) {
-                metadata_first_layer_extrusion_width_ = width;
-                spdlog::trace("[GCode Parser] Parsed first layer extrusion width: {}mm", width);
-            } else if (contains_all({"perimeter"}) || key_lower.find("wall") != std::string::npos) {
-                // Handles "perimeter" (Prusa/Orca) and "wall" (Cura)
-                metadata_perimeter_extrusion_width_ = width;
-                spdlog::trace("[GCode Parser] Parsed perimeter/wall extrusion width: {}mm", width);
-            } else if (contains_all({"infill"})) {
-                metadata_infill_extrusion_width_ = width;
-                spdlog::trace("[GCode Parser] Parsed infill extrusion width: {}mm", width);
-            } else {
-                // General extrusion width (fallback for "line_width", etc.)
-                if (metadata_extrusion_width_ == 0.0f) {
-                    metadata_extrusion_width_ = width;
-                    spdlog::trace("[GCode Parser] Parsed default extrusion width: {}mm", width);
-                }
+        // Categorize by feature type
+        if (contains_all({"first", "layer"}) || contains_all({"initial", "layer"})) {
+            metadata_first_layer_extrusion_width_ = width;
+            spdlog::trace("[GCode Parser] Parsed first layer extrusion width: {}mm", width);
+        } else if (contains_all({"perimeter"}) ||
+                   key_lower.find("wall") != std::string_view::npos) {
+            // Handles "perimeter" (Prusa/Orca) and "wall" (Cura)
+            metadata_perimeter_extrusion_width_ = width;
+            spdlog::trace("[GCode Parser] Parsed perimeter/wall extrusion width: {}mm", width);
+        } else if (contains_all({"infill"})) {
+            metadata_infill_extrusion_width_ = width;
+            spdlog::trace("[GCode Parser] Parsed infill extrusion width: {}mm", width);
+        } else {
+            // General extrusion width (fallback for "line_width", etc.)
+            if (metadata_extrusion_width_ == 0.0f) {
+                metadata_extrusion_width_ = width;
+                spdlog::trace("[GCode Parser] Parsed default extrusion width: {}mm", width);
             }
-        } catch (...) {
-            // Failed to parse width value
         }
     }
 }
 
-void GCodeParser::parse_extruder_color_metadata(const std::string& line) {
+void GCodeParser::parse_extruder_color_metadata(std::string_view line) {
     // Format: "; extruder_colour = #ED1C24;#00C1AE;#F4E2C1;#000000"
     //     OR: "; filament_colour = ..." (fallback)
     //     OR: ";extruder_colour=#AA0000 ; #00BB00 ;#0000CC" (with variations)
+    constexpr std::string_view WHITESPACE = " \t\r\n";
 
     // Find '=' character (with or without spaces)
     size_t eq_pos = line.find('=');
-    if (eq_pos == std::string::npos) {
+    if (eq_pos == std::string_view::npos) {
         return;
     }
 
-    std::string colors_str = line.substr(eq_pos + 1);
-
-    // Trim leading whitespace from colors_str
-    size_t start = colors_str.find_first_not_of(" \t\r\n");
-    if (start != std::string::npos) {
-        colors_str = colors_str.substr(start);
-    }
+    std::string_view colors_str = line.substr(eq_pos + 1);
 
     // Split by semicolons
-    std::stringstream ss(colors_str);
-    std::string color;
-    while (std::getline(ss, color, ';')) {
+    size_t pos = 0;
+    while (pos < colors_str.size()) {
+        size_t next = colors_str.find(';', pos);
+        std::string_view color = colors_str.substr(pos, next - pos);
+
         // Trim whitespace
-        color.erase(0, color.find_first_not_of(" \t\r\n"));
-        color.erase(color.find_last_not_of(" \t\r\n") + 1);
+        size_t first = color.find_first_not_of(WHITESPACE);
+        color = first == std::string_view::npos
+                    ? std::string_view()
+                    : color.substr(first, color.find_last_not_of(WHITESPACE) + 1 - first);
 
         if (!color.empty() && color[0] == '#') {
-            tool_color_palette_.push_back(color);
+            tool_color_palette_.emplace_back(color);
         } else if (!color.empty()) {
             // Non-empty but invalid format - use placeholder
-            tool_color_palette_.push_back("");
+            tool_color_palette_.emplace_back();
         }
+
+        if (next == std::string_view::npos) {
+            break;
+        }
+        pos = next + 1;
     }
 
     // Log color palette (manual join since fmt::join may not be available)
@@ -633,105 +670,38 @@ void GCodeParser::parse_extruder_color_metadata(const std::string& line) {
     }
 }
 
-void GCodeParser::parse_tool_change_command(const std::string& line) {
+void GCodeParser::parse_tool_change_command(std::string_view line) {
     // Format: "T0", "T1", "T2", etc. (standalone line)
-    if (line.empty() || line[0] != 'T') {
+    int tool_num;
+    if (!parse_tool_number(line, tool_num)) {
         return;
     }
 
-    // Check if it's JUST "T" + digits (no other commands on line)
-    if (line.length() < 2) {
-        return;
-    }
-
-    // Extract tool number
-    size_t i = 1;
-    while (i < line.length() && std::isdigit(line[i])) {
-        i++;
-    }
-
-    if (i == 1) {
-        return; // No digits after T
-    }
-    if (i < line.length() && !std::isspace(line[i])) {
-        return; // Not standalone
-    }
-
-    std::string tool_str = line.substr(1, i - 1);
-    int tool_num = std::stoi(tool_str);
-
     current_tool_index_ = tool_num;
     spdlog::trace("[GCode Parser] Tool change: T{}", tool_num);
 }
 
-void GCodeParser::parse_wipe_tower_marker(const std::string& comment) {
-    if (comment.find("WIPE_TOWER_START") != std::string::npos ||
-        comment.find("WIPE_TOWER_BRIM_START") != std::string::npos) {
-        in_wipe_tower_ = true;
-        spdlog::debug("[GCode Parser] Entering wipe tower section");
-    } else if (comment.find("WIPE_TOWER_END") != std::string::npos ||
-               comment.find("WIPE_TOWER_BRIM_END") != std::string::npos) {
-        in_wipe_tower_ = false;
-        spdlog::debug("[GCode Parser] Exiting wipe tower section");
-    }
-}
-
-bool GCodeParser::extract_param(const std::string& line, char param, float& out_value) {
-    size_t pos = line.find(param);
-    if (pos == std::string::npos) {
-        return false;
-    }
-
-    // Make sure it's a parameter (preceded by space or at start after command)
-    if (pos > 0 && line[pos - 1] != ' ' && line[pos - 1] != '\t') {
-        return false;
-    }
-
-    // Extract number after parameter letter
-    size_t start = pos + 1;
-    if (start >= line.length()) {
-        return false;
-    }
-
-    // Find end of number (space, end of string, or another letter)
-    size_t end = start;
-    while (end < line.length() &&
-           (std::isdigit(line[end]) || line[end] == '.' || line[end] == '-' || line[end] == '+')) {
-        end++;
-    }
-
-    if (end == start) {
-        return false;
+bool GCodeParser::parse_wipe_tower_comment(std::string_view comment, bool& entering) {
+    if (comment.find("WIPE_TOWER_START") != std::string_view::npos ||
+        comment.find("WIPE_TOWER_BRIM_START") != std::string_view::npos) {
+        entering = true;
+        return true;
     }
-
-    try {
-        out_value = std::stof(line.substr(start, end - start));
+    if (comment.find("WIPE_TOWER_END") != std::string_view::npos ||
+        comment.find("WIPE_TOWER_BRIM_END") != std::string_view::npos) {
+        entering = false;
         return true;
-    } catch (...) {
-        return false;
     }
+    return false;
 }
 
-bool GCodeParser::extract_string_param(const std::string& line, const std::string& param,
-                                       std::string& out_value) {
-    size_t pos = line.find(param + "=");
-    if (pos == std::string::npos) {
-        return false;
-    }
-
-    size_t start = pos + param.length() + 1; // Skip "PARAM="
-    if (start >= line.length()) {
-        return false;
-    }
-
-    // Find end of value (space or end of line)
-    size_t end = line.find(' ', start);
-    if (end == std::string::npos) {
-        end = line.length();
+void GCodeParser::parse_wipe_tower_marker(std::string_view comment) {
+    bool entering;
+    if (!parse_wipe_tower_comment(comment, entering)) {
+        return;
     }
-
-    out_value = line.substr(start, end - start);
-    return true;
+    in_wipe_tower_ = entering;
+    spdlog::debug("[GCode Parser] {} wipe tower section", entering ? "Entering" : "Exiting");
 }
 
 void GCodeParser::add_segment(const glm::vec3& start, const glm::vec3& end, bool is_extrusion,
@@ -744,7 +714,6 @@ void GCodeParser::add_segment(const glm::vec3& start, const glm::vec3& end, bool
     segment.start = start;
     segment.end = end;
     segment.is_extrusion = is_extrusion;
-    segment.object_name = current_object_;
     segment.extrusion_amount = e_delta;
 
     // Multi-color support: Tag segment with current tool
@@ -752,7 +721,14 @@ void GCodeParser::add_segment(const glm::vec3& start, const glm::vec3& end, bool
 
     // Wipe tower support: Tag wipe tower segments with special object name
     if (in_wipe_tower_) {
-        segment.object_name = "__WIPE_TOWER__";
+        if (wipe_tower_id_ == NO_OBJECT_ID) {
+            wipe_tower_id_ = object_table_.intern(WIPE_TOWER_OBJECT);
+        }
+        segment.object_name = WIPE_TOWER_OBJECT;
+        segment.object_id = wipe_tower_id_;
+    } else {
+        segment.object_name = current_object_;
+        segment.object_id = current_object_id_;
     }
 
     // Calculate actual extrusion width from E-delta and XY distance
@@ -791,11 +767,18 @@ void GCodeParser::add_segment(const glm::vec3& start, const glm::vec3& end, bool
 
     // Update layer data
     Layer& current_layer = layers_.back();
-    current_layer.segments.push_back(segment);
+    current_layer.segments.push_back(std::move(segment));
+    if (line_end_ > line_begin_) {
+        if (current_layer.byte_length == 0) {
+            current_layer.file_offset = line_begin_;
+        }
+        current_layer.byte_length = static_cast<uint32_t>(line_end_ - current_layer.file_offset);
+    }
 
     // For bounding box: skip start position if this is the first segment ever
     // (avoids including implicit (0,0,0) starting position in print bounds)
-    bool is_first_segment = (layers_.size() == 1 && current_layer.segments.size() == 1);
+    bool is_first_segment =
+        !has_moved_ && (layers_.size() == 1 && current_layer.segments.size() == 1);
 
     if (!is_first_segment) {
         current_layer.bounding_box.expand(start);
@@ -811,19 +794,21 @@ void GCodeParser::add_segment(const glm::vec3& start, const glm::vec3& end, bool
     }
 
     // Update object bounding box (only for extrusion moves, not travels)
-    if (!current_object_.empty() && objects_.count(current_object_) > 0 && is_extrusion) {
-        objects_[current_object_].bounding_box.expand(start);
-        objects_[current_object_].bounding_box.expand(end);
+    if (!is_extrusion || !current_object_def_) {
+        return;
+    }
+    current_object_def_->bounding_box.expand(start);
+    current_object_def_->bounding_box.expand(end);
 
-        // Debug: Log first few extrusion segments per object
-        static std::map<std::string, int> segment_counts;
-        segment_counts[current_object_]++;
-        if (segment_counts[current_object_] <= 3) {
-            spdlog::trace(
-                "[GCode Parser] Object '{}' extrusion segment: start=({:.2f},{:.2f},{:.2f}) "
-                "end=({:.2f},{:.2f},{:.2f})",
-                current_object_, start.x, start.y, start.z, end.x, end.y, end.z);
-        }
+    // Debug: Log first few extrusion segments per object
+    if (!spdlog::should_log(spdlog::level::trace)) {
+        return;
+    }
+    static std::map<std::string, int> segment_counts;
+    if (++segment_counts[current_object_] <= 3) {
+        spdlog::trace("[GCode Parser] Object '{}' extrusion segment: "
+                      "start=({:.2f},{:.2f},{:.2f}) end=({:.2f},{:.2f},{:.2f})",
+                      current_object_, start.x, start.y, start.z, end.x, end.y, end.z);
     }
 }
 
@@ -840,39 +825,21 @@ void GCodeParser::start_new_layer(float z) {
     spdlog::trace("[GCode Parser] Started layer {} at Z={:.3f}", layers_.size() - 1, z);
 }
 
-std::string GCodeParser::trim_line(const std::string& line) {
-    if (line.empty()) {
-        return line;
-    }
-
-    // Remove comments (everything after ';')
-    size_t comment_pos = line.find(';');
-    std::string without_comment =
-        (comment_pos != std::string::npos) ? line.substr(0, comment_pos) : line;
-
-    // Trim leading/trailing whitespace
-    size_t start = 0;
-    while (start < without_comment.length() && std::isspace(without_comment[start])) {
-        start++;
-    }
-
-    if (start == without_comment.length()) {
-        return "";
-    }
-
-    size_t end = without_comment.length();
-    while (end > start && std::isspace(without_comment[end - 1])) {
-        end--;
+ParsedGCodeFile GCodeParser::finalize() {
+    // Last line of a buffer that did not end in a newline
+    if (!pending_line_.empty()) {
+        line_begin_ = byte_offset_ - pending_line_.size();
+        line_end_ = byte_offset_;
+        parse_line(pending_line_);
+        pending_line_.clear();
     }
 
-    return without_comment.substr(start, end - start);
-}
-
-ParsedGCodeFile GCodeParser::finalize() {
     ParsedGCodeFile result;
     result.filename = "";
     result.layers = std::move(layers_);
     result.objects = std::move(objects_);
+    result.object_table = std::move(object_table_);
+    current_object_def_ = nullptr; // Pointed into objects_
     result.global_bounding_box = global_bounds_;
 
     // Calculate statistics
@@ -13,7 +13,7 @@ using namespace projection;
 // PROJECTION
 // ============================================================================
 
-glm::ivec2 project(const ProjectionParams& params, float x, float y, float z) {
+glm::vec2 project_subpixel(const ProjectionParams& params, float x, float y, float z) {
     float sx, sy;
     const float half_w = static_cast<float>(params.canvas_width) / 2.0f;
     const float half_h = static_cast<float>(params.canvas_height) / 2.0f;
@@ -67,7 +67,12 @@ glm::ivec2 project(const ProjectionParams& params, float x, float y, float z) {
     // Apply content offset (shifts render for UI overlap - used by layer renderer)
     sy += params.content_offset_y_percent * static_cast<float>(params.canvas_height);
 
-    return {static_cast<int>(sx), static_cast<int>(sy)};
+    return {sx, sy};
+}
+
+glm::ivec2 project(const ProjectionParams& params, float x, float y, float z) {
+    glm::vec2 screen = project_subpixel(params, x, y, z);
+    return {static_cast<int>(screen.x), static_cast<int>(screen.y)};
 }
 
 // ============================================================================
@@ -0,0 +1,611 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_soft_rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <utility>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+// 28.4 fixed-point screen coordinates
+constexpr int SUBPIXEL_BITS = 4;
+constexpr int64_t SUBPIXEL_ONE = 1 << SUBPIXEL_BITS;
+constexpr int64_t SUBPIXEL_HALF = SUBPIXEL_ONE / 2;
+
+/// Vertices further off-screen than this drop their strip (keeps edge math in range)
+constexpr float GUARD_BAND_PX = 16384.0f;
+
+/// Smallest clip-space w treated as in front of the camera
+constexpr float MIN_CLIP_W = 1e-4f;
+
+/// Vertices per transform task
+constexpr uint32_t TRANSFORM_TASK_VERTICES = 4096;
+
+/// Strips per bin task, so small chunks do not wake every worker
+constexpr size_t BIN_TASK_MIN_STRIPS = 2048;
+
+/// Same fallback as the GLES upload path for out-of-range palette indices
+constexpr uint32_t DEFAULT_VERTEX_RGB = 0x26A69A;
+
+constexpr uint8_t VERTEX_VALID = 1 << 0;
+
+// Strip order BL(0), BR(1), TL(2), TR(3): triangles BL-BR-TL and BR-TR-TL
+constexpr int STRIP_TRIANGLES[2][3] = {{0, 1, 2}, {1, 3, 2}};
+
+/// Twice the signed area in 28.4 screen space (y down): negative for GL front faces (CCW)
+int64_t signed_area(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t cx, int64_t cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+/// Pixel index range whose centers lie in [lo, hi] (28.4), clamped to [min_px, max_px)
+std::pair<int, int> covered_pixels(int64_t lo, int64_t hi, int min_px, int max_px) {
+    int64_t first = (lo - SUBPIXEL_HALF + SUBPIXEL_ONE - 1) >> SUBPIXEL_BITS;
+    int64_t last = (hi - SUBPIXEL_HALF) >> SUBPIXEL_BITS;
+    return {static_cast<int>(std::max<int64_t>(first, min_px)),
+            static_cast<int>(std::min<int64_t>(last, max_px - 1))};
+}
+
+/// Top-left fill rule: pixels exactly on other edges belong to the neighbouring triangle
+int64_t edge_bias(int64_t dx, int64_t dy) {
+    bool top_left = dy < 0 || (dy == 0 && dx > 0);
+    return top_left ? 0 : -1;
+}
+
+/// Round half away from zero; inline, unlike std::lround
+int32_t round_to_int(float value) {
+    return value >= 0.0f ? static_cast<int32_t>(value + 0.5f) : -static_cast<int32_t>(0.5f - value);
+}
+
+uint32_t to_byte(float value) {
+    return static_cast<uint32_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+}
+
+uint32_t blend_channel(uint32_t src, uint32_t dst, uint32_t alpha) {
+    return (src * alpha + dst * (255 - alpha) + 127) / 255;
+}
+
+/// Fixed fill light direction (front-right), as in the GLES renderer
+constexpr glm::vec3 FILL_LIGHT_DIR{0.6985074f, 0.1397015f, 0.6985074f};
+
+} // namespace
+
+SoftRenderView make_soft_render_view(const GCodeCamera& camera, float content_offset_y) {
+    // Model transform: rotate -90° (CW) around Z to match slicer thumbnail orientation
+    glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(0, 0, 1));
+    glm::mat4 view = camera.get_view_matrix();
+    glm::mat4 proj = camera.get_projection_matrix();
+    if (std::abs(content_offset_y) > 0.001f) {
+        proj[3][1] += -content_offset_y * 2.0f;
+    }
+
+    SoftRenderView result;
+    result.mvp = proj * view * model;
+    glm::mat3 view_model_rot = glm::mat3(view * model);
+    result.normal_matrix = glm::transpose(glm::inverse(view_model_rot));
+
+    // Camera-following light plus the fixed fill light, both in view space
+    glm::vec3 cam_light = glm::normalize(camera.get_camera_position() - camera.get_target());
+    result.light_dirs[0] = glm::normalize(view_model_rot * cam_light);
+    result.light_dirs[1] = glm::normalize(view_model_rot * FILL_LIGHT_DIR);
+    return result;
+}
+
+RibbonRasterizer::RibbonRasterizer(unsigned threads) : pool_(threads) {}
+
+void RibbonRasterizer::resize(int width, int height) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if (width == width_ && height == height_) {
+        return;
+    }
+    width_ = width;
+    height_ = height;
+    tiles_x_ = (width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    tiles_y_ = (height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    color_.assign(static_cast<size_t>(width) * height, 0);
+    depth_.assign(static_cast<size_t>(width) * height, SOFT_DEPTH_FAR);
+    bins_.clear();
+}
+
+// ============================================================================
+// Frame setup
+// ============================================================================
+
+void RibbonRasterizer::begin_frame(const RibbonGeometry& geometry, const SoftRenderView& view,
+                                   int first_layer, int last_layer, uint32_t clear_color) {
+    std::fill(color_.begin(), color_.end(), clear_color);
+    std::fill(depth_.begin(), depth_.end(), SOFT_DEPTH_FAR);
+    triangles_drawn_ = 0;
+    layers_culled_ = 0;
+    chunks_drawn_ = 0;
+
+    geometry_ = &geometry;
+    view_ = view;
+    update_layer_spans();
+
+    int layer_count = static_cast<int>(layer_spans_.size());
+    frame_first_layer_ = std::max(first_layer, 0);
+    frame_last_layer_ = std::min(last_layer, layer_count - 1);
+    cull_layers(frame_first_layer_, frame_last_layer_);
+
+    // Screen transform for raw int16 positions: dequantize, MVP, then NDC to
+    // 28.4 pixels (y down) and NDC z to depth units, all in one matrix
+    const QuantizationParams& quant = geometry.quantization;
+    float step = quant.scale_factor != 0.0f ? 1.0f / quant.scale_factor : 1.0f;
+    glm::mat4 dequantize = glm::translate(glm::mat4(1.0f), quant.min_bounds) *
+                           glm::scale(glm::mat4(1.0f), glm::vec3(step));
+    float half_w = 0.5f * static_cast<float>(width_) * SUBPIXEL_ONE;
+    float half_h = 0.5f * static_cast<float>(height_) * SUBPIXEL_ONE;
+    glm::mat4 viewport(1.0f);
+    viewport[0][0] = half_w;
+    viewport[3][0] = half_w;
+    viewport[1][1] = -half_h;
+    viewport[3][1] = half_h;
+    viewport[2][2] = depth_scale_;
+    viewport[3][2] = -depth_min_ * depth_scale_;
+    quantized_mvp_ = viewport * view.mvp * dequantize;
+}
+
+void RibbonRasterizer::update_layer_spans() {
+    const RibbonGeometry& geom = *geometry_;
+    if (spans_geometry_ == geometry_ && spans_strip_count_ == geom.strips.size() &&
+        layer_spans_.size() == std::max<size_t>(geom.layer_strip_ranges.size(), 1)) {
+        return;
+    }
+    spans_geometry_ = geometry_;
+    spans_strip_count_ = geom.strips.size();
+
+    // Geometry without layer ranges is one layer, as in the GLES upload path
+    std::vector<std::pair<size_t, size_t>> ranges = geom.layer_strip_ranges;
+    if (ranges.empty()) {
+        ranges.emplace_back(0, geom.strips.size());
+    }
+    layer_spans_.assign(ranges.size(), LayerSpan{});
+    for (size_t layer = 0; layer < ranges.size(); ++layer) {
+        LayerSpan& span = layer_spans_[layer];
+        span.first_strip = std::min(ranges[layer].first, geom.strips.size());
+        span.strip_count = std::min(ranges[layer].second, geom.strips.size() - span.first_strip);
+        span.vertex_min = UINT32_MAX;
+        span.vertex_max = 0;
+        for (size_t s = span.first_strip; s < span.first_strip + span.strip_count; ++s) {
+            for (uint32_t index : geom.strips[s]) {
+                span.vertex_min = std::min(span.vertex_min, index);
+                span.vertex_max = std::max(span.vertex_max, index);
+            }
+        }
+        if (span.vertex_min != UINT32_MAX && span.vertex_max >= geom.vertices.size()) {
+            span.strip_count = 0; // Corrupt indices: draw nothing rather than read past the end
+        }
+        if (span.strip_count == 0) {
+            span.vertex_min = 1;
+            span.vertex_max = 0;
+        }
+    }
+}
+
+void RibbonRasterizer::cull_layers(int first_layer, int last_layer) {
+    const RibbonGeometry& geom = *geometry_;
+    layer_visible_.assign(static_cast<size_t>(std::max(last_layer - first_layer + 1, 0)), 0);
+
+    float z_lo = 1.0f;
+    float z_hi = -1.0f;
+    bool full_depth_range = false;
+    for (int layer = first_layer; layer <= last_layer; ++layer) {
+        const LayerSpan& span = layer_spans_[static_cast<size_t>(layer)];
+        if (span.strip_count == 0) {
+            continue;
+        }
+        bool has_bbox = static_cast<size_t>(layer) < geom.layer_bboxes.size() &&
+                        geom.layer_bboxes[static_cast<size_t>(layer)].min.x <=
+                            geom.layer_bboxes[static_cast<size_t>(layer)].max.x;
+        if (!has_bbox) {
+            layer_visible_[static_cast<size_t>(layer - first_layer)] = 1;
+            full_depth_range = true;
+            continue;
+        }
+
+        // Outside if all eight corners are beyond the same clip plane
+        const AABB& box = geom.layer_bboxes[static_cast<size_t>(layer)];
+        unsigned outside_all = 0x3F;
+        float box_z_lo = 1.0f;
+        float box_z_hi = -1.0f;
+        bool behind_camera = false;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec4 p((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                        (corner & 4) ? box.max.z : box.min.z, 1.0f);
+            glm::vec4 clip = view_.mvp * p;
+            unsigned outside = (clip.x < -clip.w ? 1u : 0u) | (clip.x > clip.w ? 2u : 0u) |
+                               (clip.y < -clip.w ? 4u : 0u) | (clip.y > clip.w ? 8u : 0u) |
+                               (clip.z < -clip.w ? 16u : 0u) | (clip.z > clip.w ? 32u : 0u);
+            outside_all &= outside;
+            if (clip.w <= MIN_CLIP_W) {
+                behind_camera = true;
+            } else {
+                box_z_lo = std::min(box_z_lo, clip.z / clip.w);
+                box_z_hi = std::max(box_z_hi, clip.z / clip.w);
+            }
+        }
+        if (outside_all != 0) {
+            layers_culled_++;
+            continue;
+        }
+        layer_visible_[static_cast<size_t>(layer - first_layer)] = 1;
+        full_depth_range |= behind_camera;
+        z_lo = std::min(z_lo, box_z_lo);
+        z_hi = std::max(z_hi, box_z_hi);
+    }
+
+    // Spend the 16 depth bits on the visible layers only, not the whole near/far range
+    if (full_depth_range || z_lo >= z_hi) {
+        z_lo = -1.0f;
+        z_hi = 1.0f;
+    }
+    z_lo = std::max(z_lo, -1.0f);
+    z_hi = std::min(z_hi, 1.0f);
+    depth_min_ = z_lo;
+    depth_scale_ = z_hi > z_lo ? static_cast<float>(SOFT_DEPTH_FAR - 1) / (z_hi - z_lo) : 0.0f;
+}
+
+void RibbonRasterizer::prepare_shading(const SoftPassStyle& style) {
+    const RibbonGeometry& geom = *geometry_;
+
+    // Diffuse and specular per palette normal; the view direction is taken as
+    // the camera axis, so specular is exact for the orthographic camera
+    const glm::vec3 view_dir(0.0f, 0.0f, 1.0f);
+    glm::vec3 half_dirs[2];
+    for (int i = 0; i < 2; ++i) {
+        half_dirs[i] = glm::normalize(view_.light_dirs[i] + view_dir);
+    }
+    normal_shading_.resize(geom.normal_palette.size());
+    for (size_t n = 0; n < geom.normal_palette.size(); ++n) {
+        glm::vec3 normal = view_.normal_matrix * geom.normal_palette[n];
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : view_dir;
+
+        float diffuse = view_.ambient;
+        float specular = 0.0f;
+        for (int i = 0; i < 2; ++i) {
+            diffuse += view_.light_intensity[i] * std::max(glm::dot(normal, view_.light_dirs[i]),
+                                                           0.0f);
+            specular += std::pow(std::max(glm::dot(normal, half_dirs[i]), 0.0f),
+                                 view_.specular_shininess);
+        }
+        normal_shading_[n] = {diffuse, specular * view_.specular_intensity * 255.0f};
+    }
+
+    // Base colors in 0..255 per palette entry, plus the fallback in the last slot
+    auto to_rgb = [](uint32_t rgb) {
+        return glm::vec3((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+    };
+    base_colors_.resize(geom.color_palette.size() + 1);
+    for (size_t c = 0; c < base_colors_.size(); ++c) {
+        glm::vec3 base = !style.use_vertex_colors      ? style.base_color * 255.0f
+                         : c < geom.color_palette.size() ? to_rgb(geom.color_palette[c])
+                                                         : to_rgb(DEFAULT_VERTEX_RGB);
+        base_colors_[c] = base * style.color_scale;
+    }
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void RibbonRasterizer::draw_layers(int first_layer, int last_layer, const SoftPassStyle& style) {
+    if (!geometry_ || color_.empty()) {
+        return;
+    }
+    first_layer = std::max(first_layer, frame_first_layer_);
+    last_layer = std::min(last_layer, frame_last_layer_);
+    if (first_layer > last_layer) {
+        return;
+    }
+    prepare_shading(style);
+
+    // Group consecutive visible layers while their vertex span fits a chunk;
+    // a layer bigger than a chunk is drawn on its own
+    std::vector<int> chunk;
+    uint32_t chunk_min = 0;
+    uint32_t chunk_max = 0;
+    auto flush = [&]() {
+        if (!chunk.empty()) {
+            draw_chunk(chunk, chunk_min, chunk_max + 1, style);
+            chunk.clear();
+        }
+    };
+    for (int layer = first_layer; layer <= last_layer; ++layer) {
+        const LayerSpan& span = layer_spans_[static_cast<size_t>(layer)];
+        if (span.strip_count == 0 ||
+            !layer_visible_[static_cast<size_t>(layer - frame_first_layer_)]) {
+            continue;
+        }
+        uint32_t merged_min =
+            chunk.empty() ? span.vertex_min : std::min(chunk_min, span.vertex_min);
+        uint32_t merged_max =
+            chunk.empty() ? span.vertex_max : std::max(chunk_max, span.vertex_max);
+        if (!chunk.empty() && merged_max - merged_min + 1 > chunk_vertices_) {
+            flush();
+            merged_min = span.vertex_min;
+            merged_max = span.vertex_max;
+        }
+        chunk.push_back(layer);
+        chunk_min = merged_min;
+        chunk_max = merged_max;
+    }
+    flush();
+}
+
+void RibbonRasterizer::draw_chunk(const std::vector<int>& layers, uint32_t vertex_begin,
+                                  uint32_t vertex_end, const SoftPassStyle& style) {
+    chunks_drawn_++;
+
+    // 1. Transform and light the chunk's vertices
+    chunk_vertex_base_ = vertex_begin;
+    size_t count = vertex_end - vertex_begin;
+    screen_x_.resize(count);
+    screen_y_.resize(count);
+    screen_z_.resize(count);
+    vertex_rgb_.resize(count);
+    vertex_flags_.resize(count);
+    size_t transform_tasks = (count + TRANSFORM_TASK_VERTICES - 1) / TRANSFORM_TASK_VERTICES;
+    pool_.run(transform_tasks, [&](size_t task) {
+        uint32_t begin = vertex_begin + static_cast<uint32_t>(task) * TRANSFORM_TASK_VERTICES;
+        transform_vertices(begin, std::min(begin + TRANSFORM_TASK_VERTICES, vertex_end));
+    });
+
+    // 2. Bin strips by tile; tasks take contiguous strip ranges, so reading
+    //    the bins in task order replays the strips in their original order
+    size_t strip_total = 0;
+    for (int layer : layers) {
+        strip_total += layer_spans_[static_cast<size_t>(layer)].strip_count;
+    }
+    size_t tile_count = static_cast<size_t>(tiles_x_) * tiles_y_;
+    bin_tasks_ = std::clamp<size_t>(strip_total / BIN_TASK_MIN_STRIPS, 1, pool_.size());
+    if (bins_.size() < bin_tasks_ * tile_count) {
+        bins_.resize(bin_tasks_ * tile_count);
+    }
+    task_strips_.assign(bin_tasks_, 0);
+    pool_.run(bin_tasks_, [&](size_t task) { bin_strips(task, bin_tasks_, layers); });
+    for (size_t strips : task_strips_) {
+        triangles_drawn_ += strips * 2;
+    }
+
+    // 3. Rasterize tiles, one thread per tile
+    pool_.run(tile_count, [&](size_t tile) { raster_tile(tile, style.alpha); });
+}
+
+void RibbonRasterizer::transform_vertices(uint32_t begin, uint32_t end) {
+    const RibbonGeometry& geom = *geometry_;
+    const glm::mat4& m = quantized_mvp_;
+    const float guard = GUARD_BAND_PX * SUBPIXEL_ONE;
+    const float max_depth = static_cast<float>(SOFT_DEPTH_FAR - 1) + 0.5f;
+    const size_t fallback_color = base_colors_.size() - 1;
+
+    for (uint32_t v = begin; v < end; ++v) {
+        const RibbonVertex& vertex = geom.vertices[v];
+        size_t i = v - chunk_vertex_base_;
+        float qx = vertex.position.x;
+        float qy = vertex.position.y;
+        float qz = vertex.position.z;
+        float x = m[0][0] * qx + m[1][0] * qy + m[2][0] * qz + m[3][0];
+        float y = m[0][1] * qx + m[1][1] * qy + m[2][1] * qz + m[3][1];
+        float z = m[0][2] * qx + m[1][2] * qy + m[2][2] * qz + m[3][2];
+        float w = m[0][3] * qx + m[1][3] * qy + m[2][3] * qz + m[3][3];
+
+        vertex_flags_[i] = 0;
+        if (w <= MIN_CLIP_W) {
+            continue;
+        }
+        float inv_w = 1.0f / w;
+        x *= inv_w;
+        y *= inv_w;
+        z *= inv_w;
+        if (!(std::abs(x) < guard && std::abs(y) < guard && z > -0.5f && z < max_depth)) {
+            continue; // Its strips are dropped, so skip the shading too
+        }
+        vertex_flags_[i] = VERTEX_VALID;
+        screen_x_[i] = round_to_int(x);
+        screen_y_[i] = round_to_int(y);
+        screen_z_[i] = static_cast<uint16_t>(std::clamp(z + 0.5f, 0.0f, max_depth));
+
+        glm::vec2 shade = vertex.normal_index < normal_shading_.size()
+                              ? normal_shading_[vertex.normal_index]
+                              : glm::vec2(1.0f, 0.0f);
+        const glm::vec3& base = base_colors_[std::min<size_t>(vertex.color_index, fallback_color)];
+        auto channel = [&](float c) { return to_byte(c * shade.x + shade.y); };
+        vertex_rgb_[i] = (channel(base.x) << 16) | (channel(base.y) << 8) | channel(base.z);
+    }
+}
+
+void RibbonRasterizer::bin_strips(size_t task, size_t task_count, const std::vector<int>& layers) {
+    const RibbonGeometry& geom = *geometry_;
+    size_t tile_count = static_cast<size_t>(tiles_x_) * tiles_y_;
+    std::vector<uint32_t>* bins = &bins_[task * tile_count];
+    for (size_t t = 0; t < tile_count; ++t) {
+        bins[t].clear();
+    }
+
+    size_t strip_total = 0;
+    for (int layer : layers) {
+        strip_total += layer_spans_[static_cast<size_t>(layer)].strip_count;
+    }
+    size_t begin = strip_total * task / task_count;
+    size_t end = strip_total * (task + 1) / task_count;
+    bool check_layer = geom.strip_layer_index.size() == geom.strips.size();
+    bool cull = view_.cull_back_faces;
+
+    size_t binned = 0;
+    size_t offset = 0; // Position of the current layer in the chunk's strip sequence
+    for (int layer : layers) {
+        const LayerSpan& span = layer_spans_[static_cast<size_t>(layer)];
+        size_t lo = std::max(begin, offset);
+        size_t hi = std::min(end, offset + span.strip_count);
+        for (size_t k = lo; k < hi; ++k) {
+            uint32_t s = static_cast<uint32_t>(span.first_strip + (k - offset));
+            // Ranges may span strips of other layers; those draw with their own layer
+            if (check_layer && geom.strip_layer_index[s] != layer) {
+                continue;
+            }
+            const TriangleStrip& strip = geom.strips[s];
+            uint8_t all = VERTEX_VALID;
+            int64_t min_x = INT64_MAX, max_x = INT64_MIN, min_y = INT64_MAX, max_y = INT64_MIN;
+            for (uint32_t index : strip) {
+                size_t i = index - chunk_vertex_base_;
+                all &= vertex_flags_[i];
+                min_x = std::min<int64_t>(min_x, screen_x_[i]);
+                max_x = std::max<int64_t>(max_x, screen_x_[i]);
+                min_y = std::min<int64_t>(min_y, screen_y_[i]);
+                max_y = std::max<int64_t>(max_y, screen_y_[i]);
+            }
+            // Strips crossing the near plane are dropped whole (no clipping)
+            if (!(all & VERTEX_VALID) || (cull && !strip_faces_camera(strip))) {
+                continue;
+            }
+            auto [px0, px1] = covered_pixels(min_x, max_x, 0, width_);
+            auto [py0, py1] = covered_pixels(min_y, max_y, 0, height_);
+            if (px0 > px1 || py0 > py1) {
+                continue; // Off-screen or between pixel centers
+            }
+            for (int ty = py0 / SOFT_TILE_SIZE; ty <= py1 / SOFT_TILE_SIZE; ++ty) {
+                for (int tx = px0 / SOFT_TILE_SIZE; tx <= px1 / SOFT_TILE_SIZE; ++tx) {
+                    bins[static_cast<size_t>(ty) * tiles_x_ + tx].push_back(s);
+                }
+            }
+            binned++;
+        }
+        offset += span.strip_count;
+    }
+    task_strips_[task] = binned;
+}
+
+bool RibbonRasterizer::strip_faces_camera(const TriangleStrip& strip) const {
+    for (const auto& tri : STRIP_TRIANGLES) {
+        size_t a = strip[static_cast<size_t>(tri[0])] - chunk_vertex_base_;
+        size_t b = strip[static_cast<size_t>(tri[1])] - chunk_vertex_base_;
+        size_t c = strip[static_cast<size_t>(tri[2])] - chunk_vertex_base_;
+        if (signed_area(screen_x_[a], screen_y_[a], screen_x_[b], screen_y_[b], screen_x_[c],
+                        screen_y_[c]) < 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RibbonRasterizer::raster_tile(size_t tile, uint8_t alpha) {
+    const RibbonGeometry& geom = *geometry_;
+    size_t tile_count = static_cast<size_t>(tiles_x_) * tiles_y_;
+    int tx = static_cast<int>(tile % static_cast<size_t>(tiles_x_));
+    int ty = static_cast<int>(tile / static_cast<size_t>(tiles_x_));
+    TileRect rect{tx * SOFT_TILE_SIZE, ty * SOFT_TILE_SIZE,
+                  std::min((tx + 1) * SOFT_TILE_SIZE, width_),
+                  std::min((ty + 1) * SOFT_TILE_SIZE, height_)};
+
+    for (size_t task = 0; task < bin_tasks_; ++task) {
+        for (uint32_t s : bins_[task * tile_count + tile]) {
+            const TriangleStrip& strip = geom.strips[s];
+            for (const auto& tri : STRIP_TRIANGLES) {
+                raster_triangle(rect, strip[static_cast<size_t>(tri[0])] - chunk_vertex_base_,
+                                strip[static_cast<size_t>(tri[1])] - chunk_vertex_base_,
+                                strip[static_cast<size_t>(tri[2])] - chunk_vertex_base_, alpha);
+            }
+        }
+    }
+}
+
+void RibbonRasterizer::raster_triangle(const TileRect& tile, uint32_t a, uint32_t b, uint32_t c,
+                                       uint8_t alpha) {
+    int64_t ax = screen_x_[a], ay = screen_y_[a];
+    int64_t bx = screen_x_[b], by = screen_y_[b];
+    int64_t cx = screen_x_[c], cy = screen_y_[c];
+    int64_t area = signed_area(ax, ay, bx, by, cx, cy);
+    if (area == 0 || (view_.cull_back_faces && area > 0)) {
+        return;
+    }
+    if (area < 0) { // Edge functions below assume one winding
+        std::swap(b, c);
+        std::swap(bx, cx);
+        std::swap(by, cy);
+        area = -area;
+    }
+
+    auto [px0, px1] = covered_pixels(std::min({ax, bx, cx}), std::max({ax, bx, cx}), tile.x0,
+                                     tile.x1);
+    auto [py0, py1] = covered_pixels(std::min({ay, by, cy}), std::max({ay, by, cy}), tile.y0,
+                                     tile.y1);
+    if (px0 > px1 || py0 > py1) {
+        return;
+    }
+
+    // Edge functions at the first pixel center; each is the weight of the opposite vertex
+    int64_t sx = px0 * SUBPIXEL_ONE + SUBPIXEL_HALF;
+    int64_t sy = py0 * SUBPIXEL_ONE + SUBPIXEL_HALF;
+    int64_t e_a = (cx - bx) * (sy - by) - (cy - by) * (sx - bx) + edge_bias(cx - bx, cy - by);
+    int64_t e_b = (ax - cx) * (sy - cy) - (ay - cy) * (sx - cx) + edge_bias(ax - cx, ay - cy);
+    int64_t e_c = (bx - ax) * (sy - ay) - (by - ay) * (sx - ax) + edge_bias(bx - ax, by - ay);
+    const int64_t step_a_x = -(cy - by) * SUBPIXEL_ONE, step_a_y = (cx - bx) * SUBPIXEL_ONE;
+    const int64_t step_b_x = -(ay - cy) * SUBPIXEL_ONE, step_b_y = (ax - cx) * SUBPIXEL_ONE;
+    const int64_t step_c_x = -(by - ay) * SUBPIXEL_ONE, step_c_y = (bx - ax) * SUBPIXEL_ONE;
+
+    // Attribute planes: value = A + (B - A) * weight_b + (C - A) * weight_c
+    const float inv_area = 1.0f / static_cast<float>(area);
+    auto unpack = [](uint32_t rgb) {
+        return glm::vec3((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF);
+    };
+    const glm::vec4 attr_a(screen_z_[a], unpack(vertex_rgb_[a]));
+    const glm::vec4 attr_db = glm::vec4(screen_z_[b], unpack(vertex_rgb_[b])) - attr_a;
+    const glm::vec4 attr_dc = glm::vec4(screen_z_[c], unpack(vertex_rgb_[c])) - attr_a;
+    const glm::vec4 attr_step_x = (attr_db * static_cast<float>(step_b_x) +
+                                   attr_dc * static_cast<float>(step_c_x)) *
+                                  inv_area;
+    const bool flat = vertex_rgb_[a] == vertex_rgb_[b] && vertex_rgb_[b] == vertex_rgb_[c];
+    const uint32_t flat_rgb = vertex_rgb_[a];
+    const uint32_t inv_alpha = 255u - alpha;
+
+    for (int py = py0; py <= py1; ++py) {
+        int64_t row_a = e_a, row_b = e_b, row_c = e_c;
+        glm::vec4 attr = attr_a + (attr_db * static_cast<float>(row_b) +
+                                   attr_dc * static_cast<float>(row_c)) *
+                                      inv_area;
+        size_t offset = static_cast<size_t>(py) * width_;
+        uint16_t* depth_row = depth_.data() + offset;
+        uint32_t* color_row = color_.data() + offset;
+
+        for (int px = px0; px <= px1; ++px) {
+            if ((row_a | row_b | row_c) >= 0) {
+                uint16_t z = static_cast<uint16_t>(
+                    std::clamp(attr.x, 0.0f, static_cast<float>(SOFT_DEPTH_FAR - 1)));
+                if (z < depth_row[px]) {
+                    uint32_t rgb = flat ? flat_rgb
+                                        : (to_byte(attr.y) << 16) | (to_byte(attr.z) << 8) |
+                                              to_byte(attr.w);
+                    if (inv_alpha == 0) {
+                        depth_row[px] = z;
+                        color_row[px] = 0xFF000000u | rgb;
+                    } else {
+                        uint32_t dst = color_row[px];
+                        color_row[px] =
+                            0xFF000000u |
+                            (blend_channel((rgb >> 16) & 0xFF, (dst >> 16) & 0xFF, alpha) << 16) |
+                            (blend_channel((rgb >> 8) & 0xFF, (dst >> 8) & 0xFF, alpha) << 8) |
+                            blend_channel(rgb & 0xFF, dst & 0xFF, alpha);
+                    }
+                }
+            }
+            row_a += step_a_x;
+            row_b += step_b_x;
+            row_c += step_c_x;
+            attr += attr_step_x;
+        }
+        e_a += step_a_y;
+        e_b += step_b_y;
+        e_c += step_c_y;
+    }
+}
+
+} // namespace gcode
+} // namespace helix
@@ -0,0 +1,516 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_soft_renderer.h"
+
+#ifndef ENABLE_GLES_3D
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+// Frame-skip epsilon for float comparisons
+constexpr float kAngleEpsilon = 1e-5f;
+constexpr float kZoomEpsilon = 1e-3f;
+
+// Near-zero threshold for clipping space W division
+constexpr float kClipSpaceWEpsilon = 0.0001f;
+
+} // namespace
+
+GCodeSoftRenderer::GCodeSoftRenderer() {
+    spdlog::debug("[GCode Soft] Software 3D renderer using {} threads", raster_.thread_count());
+}
+
+GCodeSoftRenderer::~GCodeSoftRenderer() {
+    if (draw_buf_) {
+        lv_draw_buf_destroy(draw_buf_);
+        draw_buf_ = nullptr;
+    }
+}
+
+// ============================================================
+// Rendering
+// ============================================================
+
+void GCodeSoftRenderer::render(lv_layer_t* layer, const ParsedGCodeFile& /*gcode*/,
+                               const GCodeCamera& camera, const lv_area_t* widget_coords) {
+    if (!geometry_ || !widget_coords)
+        return;
+
+    int scale = interaction_mode_ ? kSoftInteractionDownscale : 1;
+    CachedRenderState current_state;
+    current_state.azimuth = camera.get_azimuth();
+    current_state.elevation = camera.get_elevation();
+    current_state.distance = camera.get_distance();
+    current_state.zoom_level = camera.get_zoom_level();
+    current_state.target = camera.get_target();
+    current_state.progress_layer = progress_layer_;
+    current_state.layer_start = layer_start_;
+    current_state.layer_end = layer_end_;
+    current_state.render_width = std::max(viewport_width_ / scale, 1);
+    current_state.render_height = std::max(viewport_height_ / scale, 1);
+
+    int widget_w = lv_area_get_width(widget_coords);
+    int widget_h = lv_area_get_height(widget_coords);
+    bool buffer_changed = !draw_buf_ || draw_buf_width_ != widget_w ||
+                          draw_buf_height_ != widget_h;
+
+    // Skip the raster entirely when nothing changed; just redraw the cached image
+    if (!frame_dirty_ && !buffer_changed && current_state == cached_state_) {
+        draw_cached_to_lvgl(layer, widget_coords);
+        return;
+    }
+    if (!ensure_draw_buf(widget_w, widget_h)) {
+        return;
+    }
+
+    bool needs_raster = frame_dirty_ || current_state != cached_state_;
+    cached_state_ = current_state;
+    frame_dirty_ = false;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    if (needs_raster) {
+        raster_.resize(current_state.render_width, current_state.render_height);
+        render_frame(camera);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    blit_to_draw_buf();
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    draw_cached_to_lvgl(layer, widget_coords);
+
+    auto raster_ms = std::chrono::duration<float, std::milli>(t1 - t0).count();
+    auto blit_ms = std::chrono::duration<float, std::milli>(t2 - t1).count();
+    spdlog::trace("[GCode Soft] raster={:.1f}ms ({}x{}), blit={:.1f}ms, triangles={}, "
+                  "culled layers={}",
+                  raster_ms, raster_.width(), raster_.height(), blit_ms, triangles_rendered_,
+                  raster_.layers_culled());
+}
+
+void GCodeSoftRenderer::render_frame(const GCodeCamera& camera) {
+    SoftRenderView view = make_soft_render_view(camera, content_offset_y_percent_);
+    view.specular_intensity = specular_intensity_;
+    view.specular_shininess = specular_shininess_;
+
+    int max_layer = static_cast<int>(std::max<size_t>(geometry_->layer_strip_ranges.size(), 1)) - 1;
+    int draw_start = (layer_start_ >= 0) ? layer_start_ : 0;
+    int draw_end = (layer_end_ >= 0) ? std::min(layer_end_, max_layer) : max_layer;
+
+    // Palette entries may be rewritten by set_tool_color_overrides()
+    std::lock_guard<std::mutex> lock(palette_mutex_);
+
+    // Same color rule as GLES: vertex colors unless a single-color override is active
+    SoftPassStyle solid;
+    solid.base_color = filament_color_;
+    solid.use_vertex_colors = !geometry_->color_palette.empty() && !palette_.has_override;
+
+    raster_.begin_frame(*geometry_, view, draw_start, draw_end, kSoftBackgroundColor);
+    if (progress_layer_ >= 0 && progress_layer_ < max_layer) {
+        // Pass 1: printed layers solid
+        int solid_end = std::min(progress_layer_, draw_end);
+        if (draw_start <= solid_end) {
+            raster_.draw_layers(draw_start, solid_end, solid);
+        }
+
+        // Pass 2: unprinted layers washed out and blended, without depth writes
+        SoftPassStyle ghost = solid;
+        ghost.color_scale = kSoftGhostLightenScale;
+        ghost.alpha = ghost_opacity_;
+        int ghost_start = std::max(progress_layer_ + 1, draw_start);
+        if (ghost_start <= draw_end && ghost.alpha > 0) {
+            raster_.draw_layers(ghost_start, draw_end, ghost);
+        }
+    } else {
+        raster_.draw_layers(draw_start, draw_end, solid);
+    }
+    triangles_rendered_ = raster_.triangles_drawn();
+}
+
+// ============================================================
+// LVGL Output
+// ============================================================
+
+bool GCodeSoftRenderer::ensure_draw_buf(int width, int height) {
+    if (draw_buf_ && draw_buf_width_ == width && draw_buf_height_ == height) {
+        return true;
+    }
+    if (draw_buf_) {
+        lv_draw_buf_destroy(draw_buf_);
+        draw_buf_ = nullptr;
+    }
+    draw_buf_width_ = 0;
+    draw_buf_height_ = 0;
+    if (width < 1 || height < 1) {
+        return false;
+    }
+    draw_buf_ = lv_draw_buf_create(static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                                   LV_COLOR_FORMAT_RGB888, 0);
+    if (!draw_buf_ || !draw_buf_->data) {
+        spdlog::error("[GCode Soft] Failed to create draw buffer");
+        if (draw_buf_) {
+            lv_draw_buf_destroy(draw_buf_);
+            draw_buf_ = nullptr;
+        }
+        return false;
+    }
+    draw_buf_width_ = width;
+    draw_buf_height_ = height;
+    return true;
+}
+
+void GCodeSoftRenderer::blit_to_draw_buf() {
+    int src_w = raster_.width();
+    int src_h = raster_.height();
+    if (!draw_buf_ || src_w < 1 || src_h < 1) {
+        return;
+    }
+
+    // 0xAARRGGBB → LVGL RGB888 (BGR byte order), nearest-neighbour scaled to the widget
+    const uint32_t* src = raster_.pixels().data();
+    auto* dest = static_cast<uint8_t*>(draw_buf_->data);
+    uint32_t stride = draw_buf_->header.stride;
+    std::vector<int> src_x(static_cast<size_t>(draw_buf_width_));
+    for (int dx = 0; dx < draw_buf_width_; ++dx) {
+        src_x[static_cast<size_t>(dx)] = dx * src_w / draw_buf_width_;
+    }
+
+    for (int dy = 0; dy < draw_buf_height_; ++dy) {
+        const uint32_t* src_row = src + static_cast<size_t>(dy * src_h / draw_buf_height_) * src_w;
+        uint8_t* dst_row = dest + static_cast<size_t>(dy) * stride;
+        for (int dx = 0; dx < draw_buf_width_; ++dx) {
+            uint32_t p = src_row[src_x[static_cast<size_t>(dx)]];
+            dst_row[0] = static_cast<uint8_t>(p);       // B
+            dst_row[1] = static_cast<uint8_t>(p >> 8);  // G
+            dst_row[2] = static_cast<uint8_t>(p >> 16); // R
+            dst_row += 3;
+        }
+    }
+}
+
+void GCodeSoftRenderer::draw_cached_to_lvgl(lv_layer_t* layer, const lv_area_t* widget_coords) {
+    if (!draw_buf_ || !draw_buf_->data)
+        return;
+
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.src = draw_buf_;
+
+    lv_area_t area = *widget_coords;
+    lv_draw_image(layer, &img_dsc, &area);
+}
+
+// ============================================================
+// CachedRenderState
+// ============================================================
+
+bool GCodeSoftRenderer::CachedRenderState::operator==(const CachedRenderState& o) const {
+    auto near_angle = [](float a, float b) { return std::abs(a - b) < kAngleEpsilon; };
+    auto near_zoom = [](float a, float b) { return std::abs(a - b) < kZoomEpsilon; };
+    return near_angle(azimuth, o.azimuth) && near_angle(elevation, o.elevation) &&
+           near_zoom(distance, o.distance) && near_zoom(zoom_level, o.zoom_level) &&
+           near_angle(target.x, o.target.x) && near_angle(target.y, o.target.y) &&
+           near_angle(target.z, o.target.z) && progress_layer == o.progress_layer &&
+           layer_start == o.layer_start && layer_end == o.layer_end &&
+           render_width == o.render_width && render_height == o.render_height;
+}
+
+// ============================================================
+// Configuration Methods
+// ============================================================
+
+void GCodeSoftRenderer::set_viewport_size(int width, int height) {
+    if (width == viewport_width_ && height == viewport_height_)
+        return;
+    viewport_width_ = width;
+    viewport_height_ = height;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_interaction_mode(bool interacting) {
+    if (interaction_mode_ == interacting)
+        return;
+    interaction_mode_ = interacting;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_filament_color(const std::string& hex_color) {
+    if (hex_color.size() < 7 || hex_color[0] != '#')
+        return;
+    unsigned int r = 0, g = 0, b = 0;
+    if (sscanf(hex_color.c_str(), "#%02x%02x%02x", &r, &g, &b) == 3) {
+        filament_color_ = glm::vec3(r / 255.0f, g / 255.0f, b / 255.0f);
+        frame_dirty_ = true;
+    }
+}
+
+void GCodeSoftRenderer::set_extrusion_color(lv_color_t color) {
+    filament_color_ = glm::vec3(color.red / 255.0f, color.green / 255.0f, color.blue / 255.0f);
+    palette_.has_override = true;
+    palette_.override_color = color;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_tool_color_overrides(const std::vector<uint32_t>& ams_colors) {
+    if (!geometry_ || ams_colors.empty()) {
+        return;
+    }
+
+    // Colors are looked up per frame, so editing the palette is all it takes
+    std::lock_guard<std::mutex> lock(palette_mutex_);
+    bool changed = false;
+    for (size_t tool = 0; tool < ams_colors.size(); ++tool) {
+        auto it = geometry_->tool_palette_map.find(static_cast<uint8_t>(tool));
+        if (it == geometry_->tool_palette_map.end()) {
+            continue;
+        }
+        uint8_t palette_idx = it->second;
+        if (palette_idx < geometry_->color_palette.size() &&
+            geometry_->color_palette[palette_idx] != ams_colors[tool]) {
+            geometry_->color_palette[palette_idx] = ams_colors[tool];
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        // Per-tool overrides replace palette entries, so drop any single-color override
+        palette_.has_override = false;
+        frame_dirty_ = true;
+        spdlog::debug("[GCode Soft] Applied {} tool color overrides", ams_colors.size());
+    }
+}
+
+void GCodeSoftRenderer::set_specular(float intensity, float shininess) {
+    specular_intensity_ =
+        std::clamp(intensity, kSoftMinSpecularIntensity, kSoftMaxSpecularIntensity);
+    specular_shininess_ =
+        std::clamp(shininess, kSoftMinSpecularShininess, kSoftMaxSpecularShininess);
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_show_travels(bool show) {
+    show_travels_ = show;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_show_extrusions(bool show) {
+    show_extrusions_ = show;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_layer_range(int start, int end) {
+    layer_start_ = start;
+    layer_end_ = end;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_highlighted_object(const std::string& name) {
+    std::unordered_set<std::string> objects;
+    if (!name.empty())
+        objects.insert(name);
+    highlighted_object_ = name;
+    set_highlighted_objects(objects);
+}
+
+void GCodeSoftRenderer::set_highlighted_objects(const std::unordered_set<std::string>& names) {
+    if (highlighted_objects_ != names) {
+        highlighted_objects_ = names;
+        frame_dirty_ = true;
+    }
+}
+
+void GCodeSoftRenderer::set_excluded_objects(const std::unordered_set<std::string>& names) {
+    if (excluded_objects_ != names) {
+        excluded_objects_ = names;
+        frame_dirty_ = true;
+    }
+}
+
+void GCodeSoftRenderer::reset_colors() {
+    palette_.has_override = false;
+    filament_color_ = kSoftDefaultFilamentColor;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::clear_cached_frame() {
+    // Free the cached draw buffer so stale frames aren't blitted on the next show
+    if (draw_buf_) {
+        lv_draw_buf_destroy(draw_buf_);
+        draw_buf_ = nullptr;
+        draw_buf_width_ = 0;
+        draw_buf_height_ = 0;
+    }
+    frame_dirty_ = true;
+}
+
+RenderOptions GCodeSoftRenderer::get_options() const {
+    RenderOptions opts;
+    opts.show_extrusions = show_extrusions_;
+    opts.show_travels = show_travels_;
+    opts.layer_start = layer_start_;
+    opts.layer_end = layer_end_;
+    opts.highlighted_object = highlighted_object_;
+    opts.highlighted_objects = highlighted_objects_;
+    opts.excluded_objects = excluded_objects_;
+    return opts;
+}
+
+// ============================================================
+// Ghost / Print Progress
+// ============================================================
+
+void GCodeSoftRenderer::set_print_progress_layer(int current_layer) {
+    if (progress_layer_ != current_layer) {
+        progress_layer_ = current_layer;
+        frame_dirty_ = true;
+    }
+}
+
+void GCodeSoftRenderer::set_ghost_opacity(lv_opa_t opacity) {
+    ghost_opacity_ = opacity;
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_content_offset_y(float offset_percent) {
+    content_offset_y_percent_ = std::clamp(offset_percent, -1.0f, 1.0f);
+    frame_dirty_ = true;
+}
+
+void GCodeSoftRenderer::set_ghost_render_mode(GhostRenderMode mode) {
+    ghost_render_mode_ = mode;
+    frame_dirty_ = true;
+}
+
+int GCodeSoftRenderer::get_max_layer_index() const {
+    if (geometry_)
+        return static_cast<int>(geometry_->max_layer_index);
+    return 0;
+}
+
+// ============================================================
+// Geometry Loading
+// ============================================================
+
+void GCodeSoftRenderer::set_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry,
+                                              const std::string& filename) {
+    std::lock_guard<std::mutex> lock(palette_mutex_);
+    geometry_ = std::move(geometry);
+    current_filename_ = filename;
+    raster_.reset_geometry_cache();
+    frame_dirty_ = true;
+    spdlog::debug("[GCode Soft] Geometry set: {} strips, {} vertices",
+                  geometry_ ? geometry_->strips.size() : 0,
+                  geometry_ ? geometry_->vertices.size() : 0);
+}
+
+void GCodeSoftRenderer::extend_prebuilt_geometry(std::unique_ptr<RibbonGeometry> geometry) {
+    // Nothing is uploaded, so a grown copy simply replaces the current one
+    set_prebuilt_geometry(std::move(geometry), current_filename_);
+}
+
+// ============================================================
+// Statistics
+// ============================================================
+
+size_t GCodeSoftRenderer::get_geometry_color_count() const {
+    if (geometry_)
+        return geometry_->color_palette.size();
+    return 0;
+}
+
+size_t GCodeSoftRenderer::get_memory_usage() const {
+    size_t total = sizeof(*this);
+    if (geometry_) {
+        total += geometry_->vertices.size() * sizeof(RibbonVertex);
+        total += geometry_->strips.size() * sizeof(TriangleStrip);
+        total += geometry_->normal_palette.size() * sizeof(glm::vec3);
+    }
+    if (draw_buf_) {
+        total += static_cast<size_t>(draw_buf_width_ * draw_buf_height_ * 3);
+    }
+    // Color (4 bytes/pixel) + depth (2 bytes/pixel) raster buffers
+    total += raster_.pixels().size() * sizeof(uint32_t) + raster_.depth().size() * sizeof(uint16_t);
+    return total;
+}
+
+size_t GCodeSoftRenderer::get_triangle_count() const {
+    if (geometry_)
+        return geometry_->extrusion_triangle_count;
+    return 0;
+}
+
+// ============================================================
+// Object Picking (same screen-space test as the GLES renderer)
+// ============================================================
+
+std::optional<std::string> GCodeSoftRenderer::pick_object(const glm::vec2& screen_pos,
+                                                          const ParsedGCodeFile& gcode,
+                                                          const GCodeCamera& camera) const {
+    glm::mat4 transform = camera.get_view_projection_matrix();
+    float closest_distance = std::numeric_limits<float>::max();
+    std::optional<std::string> picked_object;
+
+    int ls = layer_start_;
+    int le = (layer_end_ < 0 || layer_end_ >= static_cast<int>(gcode.layers.size()))
+                 ? static_cast<int>(gcode.layers.size()) - 1
+                 : layer_end_;
+
+    for (int layer_idx = ls; layer_idx <= le; ++layer_idx) {
+        if (layer_idx < 0 || layer_idx >= static_cast<int>(gcode.layers.size()))
+            continue;
+        const auto& layer = gcode.layers[static_cast<size_t>(layer_idx)];
+
+        for (const auto& segment : layer.segments) {
+            if (!segment.is_extrusion || !show_extrusions_)
+                continue;
+            if (segment.object_name.empty())
+                continue;
+
+            glm::vec4 start_clip = transform * glm::vec4(segment.start, 1.0f);
+            glm::vec4 end_clip = transform * glm::vec4(segment.end, 1.0f);
+
+            if (std::abs(start_clip.w) < kClipSpaceWEpsilon ||
+                std::abs(end_clip.w) < kClipSpaceWEpsilon)
+                continue;
+
+            glm::vec3 start_ndc = glm::vec3(start_clip) / start_clip.w;
+            glm::vec3 end_ndc = glm::vec3(end_clip) / end_clip.w;
+
+            if (start_ndc.x < -1 || start_ndc.x > 1 || start_ndc.y < -1 || start_ndc.y > 1 ||
+                end_ndc.x < -1 || end_ndc.x > 1 || end_ndc.y < -1 || end_ndc.y > 1) {
+                continue;
+            }
+
+            glm::vec2 start_screen((start_ndc.x + 1) * 0.5f * viewport_width_,
+                                   (1 - start_ndc.y) * 0.5f * viewport_height_);
+            glm::vec2 end_screen((end_ndc.x + 1) * 0.5f * viewport_width_,
+                                 (1 - end_ndc.y) * 0.5f * viewport_height_);
+
+            glm::vec2 v = end_screen - start_screen;
+            glm::vec2 w = screen_pos - start_screen;
+            float len_sq = glm::dot(v, v);
+            float t = (len_sq > 0.0001f) ? std::clamp(glm::dot(w, v) / len_sq, 0.0f, 1.0f) : 0.0f;
+            float dist = glm::length(screen_pos - (start_screen + t * v));
+
+            if (dist < kSoftPickThresholdPx && dist < closest_distance) {
+                closest_distance = dist;
+                picked_object = segment.object_name;
+            }
+        }
+    }
+    return picked_object;
+}
+
+} // namespace gcode
+} // namespace helix
+
+#endif // !ENABLE_GLES_3D
@@ -3,18 +3,55 @@
 
 #include "gcode_streaming_controller.h"
 
+#include "gcode_layer_index_cache.h"
+#include "gcode_mapped_file.h"
 #include "memory_monitor.h"
 #include "memory_utils.h"
 
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
-#include <sstream>
+#include <chrono>
+#include <system_error>
 #include <thread>
 
 namespace helix {
 namespace gcode {
 
+namespace {
+
+/// Parse one layer's G-code bytes with a fresh parser
+ParsedGCodeFile parse_layer_bytes(const char* data, size_t size) {
+    GCodeParser parser;
+    parser.parse_buffer(data, size);
+    return parser.finalize();
+}
+
+/**
+ * @brief Pack every parsed layer (the parser may split a layer on Z changes)
+ * @param file_ids File-wide id for each id of this parse (empty = keep the parser's ids)
+ */
+CompactSegments pack_segments(ParsedGCodeFile& result, const std::vector<ObjectId>& file_ids) {
+    size_t total = 0;
+    for (const auto& layer : result.layers) {
+        total += layer.segments.size();
+    }
+    CompactSegments segments;
+    segments.reserve(total);
+    for (auto& layer : result.layers) {
+        for (auto& seg : layer.segments) {
+            if (seg.object_id < file_ids.size()) {
+                seg.object_id = file_ids[seg.object_id];
+            }
+            segments.push_back(seg);
+        }
+    }
+    segments.shrink_to_fit();
+    return segments;
+}
+
+} // namespace
+
 // =============================================================================
 // BackgroundGhostBuilder Implementation
 // =============================================================================
@@ -137,9 +174,6 @@ void BackgroundGhostBuilder::worker_thread() {
     running_.store(false);
 }
 
-// Static member initialization
-const LayerIndexStats GCodeStreamingController::empty_stats_{};
-
 // =============================================================================
 // Construction / Destruction
 // =============================================================================
@@ -182,6 +216,12 @@ GCodeStreamingController::GCodeStreamingController(size_t cache_budget_bytes)
 }
 
 GCodeStreamingController::~GCodeStreamingController() {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        index_complete_callback_ = nullptr;
+        index_ready_callback_ = nullptr;
+    }
+
     // Wait for any async indexing to complete
     if (index_future_.valid()) {
         indexing_.store(false); // Signal cancellation
@@ -191,6 +231,10 @@ GCodeStreamingController::~GCodeStreamingController() {
             // Ignore exceptions during shutdown
         }
     }
+    stop_digest();
+
+    // The prefetch loader reads members destroyed before cache_
+    cache_.cancel_prefetch();
 }
 
 // =============================================================================
@@ -213,7 +257,8 @@ bool GCodeStreamingController::open_file(const std::string& filepath) {
 
     // Build index synchronously
     helix::MemoryMonitor::log_now("gcode_indexing_start");
-    if (!build_index()) {
+    std::atomic<bool> keep_running{true};
+    if (!build_index(keep_running)) {
         spdlog::error("[StreamingController] Failed to build index for: {}", filepath);
         data_source_.reset();
         return false;
@@ -222,13 +267,14 @@ bool GCodeStreamingController::open_file(const std::string& filepath) {
 
     is_open_.store(true);
     spdlog::info("[StreamingController] Opened {} with {} layers", filepath,
-                 index_.get_layer_count());
+                 indexed_layer_count());
 
     return true;
 }
 
 void GCodeStreamingController::open_file_async(const std::string& filepath,
-                                               std::function<void(bool)> on_complete) {
+                                               std::function<void(bool)> on_complete,
+                                               std::function<void()> on_first_layers) {
     close();
 
     spdlog::info("[StreamingController] Opening file async: {}", filepath);
@@ -247,13 +293,15 @@ void GCodeStreamingController::open_file_async(const std::string& filepath,
     {
         std::lock_guard<std::mutex> lock(callback_mutex_);
         index_complete_callback_ = on_complete;
+        index_ready_callback_ = std::move(on_first_layers);
+        partial_index_.store(static_cast<bool>(index_ready_callback_));
     }
     indexing_.store(true);
     index_progress_.store(0.0f);
 
     // Build index in background thread
-    index_future_ = std::async(std::launch::async, [this, filepath]() {
-        bool success = build_index();
+    index_future_ = std::async(std::launch::async, [this]() {
+        bool success = build_index(indexing_);
 
         indexing_.store(false);
         index_progress_.store(1.0f);
@@ -261,29 +309,17 @@ void GCodeStreamingController::open_file_async(const std::string& filepath,
         if (success) {
             is_open_.store(true);
             spdlog::info("[StreamingController] Async open complete: {} layers",
-                         index_.get_layer_count());
+                         indexed_layer_count());
+        } else if (is_open_.load()) {
+            // First layers were published; keep them like a failed streamed open
+            spdlog::warn("[StreamingController] Async indexing stopped after {} layers",
+                         indexed_layer_count());
         } else {
             spdlog::error("[StreamingController] Async indexing failed");
             data_source_.reset();
         }
 
-        // Capture callback under lock to prevent race with close()
-        // The callback may have been nullified if close() was called
-        std::function<void(bool)> callback;
-        {
-            std::lock_guard<std::mutex> lock(callback_mutex_);
-            callback = index_complete_callback_;
-        }
-
-        if (callback) {
-            spdlog::debug("[StreamingController] Invoking completion callback (success={})",
-                          success);
-            callback(success);
-            spdlog::debug("[StreamingController] Completion callback returned");
-        } else {
-            spdlog::debug("[StreamingController] No completion callback registered");
-        }
-
+        notify_index_complete(success);
         return success;
     });
 }
@@ -302,14 +338,8 @@ bool GCodeStreamingController::open_moonraker(const std::string& moonraker_url,
 
     data_source_ = std::move(source);
 
-    // Ensure the source is ready for indexing (may download to temp file)
-    if (!data_source_->ensure_indexable()) {
-        spdlog::error("[StreamingController] Failed to prepare source for indexing");
-        data_source_.reset();
-        return false;
-    }
-
-    if (!build_index()) {
+    std::atomic<bool> keep_running{true};
+    if (!build_index(keep_running)) {
         spdlog::error("[StreamingController] Failed to build index");
         data_source_.reset();
         return false;
@@ -319,6 +349,68 @@ bool GCodeStreamingController::open_moonraker(const std::string& moonraker_url,
     return true;
 }
 
+void GCodeStreamingController::open_moonraker_async(const std::string& moonraker_url,
+                                                    const std::string& gcode_path,
+                                                    std::function<void()> on_first_layer,
+                                                    std::function<void(bool)> on_complete) {
+    close();
+
+    spdlog::info("[StreamingController] Opening via Moonraker async: {} / {}", moonraker_url,
+                 gcode_path);
+
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        index_complete_callback_ = std::move(on_complete);
+        index_ready_callback_ = std::move(on_first_layer);
+    }
+    partial_index_.store(true);
+    indexing_.store(true);
+    index_progress_.store(0.0f);
+
+    index_future_ = std::async(std::launch::async, [this, moonraker_url, gcode_path]() {
+        // Fetching the file size is a network request too, so it stays off the caller
+        auto source = std::make_unique<MoonrakerDataSource>(moonraker_url, gcode_path);
+        if (!source->is_valid() || !indexing_.load()) {
+            if (indexing_.load()) {
+                spdlog::error("[StreamingController] Failed to connect to Moonraker");
+            }
+            indexing_.store(false);
+            index_progress_.store(1.0f);
+            notify_index_complete(false);
+            return false;
+        }
+        data_source_ = std::move(source);
+
+        bool success = build_index(indexing_);
+
+        indexing_.store(false);
+        index_progress_.store(1.0f);
+
+        if (success) {
+            is_open_.store(true);
+            size_t layer_count = indexed_layer_count();
+            {
+                // Metadata may have been extracted while the count was still growing
+                std::lock_guard<std::mutex> lock(metadata_mutex_);
+                if (header_metadata_) {
+                    header_metadata_->layer_count = static_cast<uint32_t>(layer_count);
+                }
+            }
+            spdlog::info("[StreamingController] Streamed open complete: {} layers", layer_count);
+        } else if (is_open_.load()) {
+            // Layers already shown stay usable; later ones are missing
+            spdlog::warn("[StreamingController] Streaming stopped after {} layers",
+                         indexed_layer_count());
+        } else {
+            spdlog::error("[StreamingController] Streamed indexing failed");
+            data_source_.reset();
+        }
+
+        notify_index_complete(success);
+        return success;
+    });
+}
+
 bool GCodeStreamingController::open_source(std::unique_ptr<GCodeDataSource> source) {
     close();
 
@@ -329,7 +421,8 @@ bool GCodeStreamingController::open_source(std::unique_ptr<GCodeDataSource> sour
 
     data_source_ = std::move(source);
 
-    if (!build_index()) {
+    std::atomic<bool> keep_running{true};
+    if (!build_index(keep_running)) {
         spdlog::error("[StreamingController] Failed to build index from source");
         data_source_.reset();
         return false;
@@ -340,7 +433,15 @@ bool GCodeStreamingController::open_source(std::unique_ptr<GCodeDataSource> sour
 }
 
 void GCodeStreamingController::close() {
-    // Wait for async operations
+    // Clear callbacks under lock first, so a cancelled open does not report back
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        index_complete_callback_ = nullptr;
+        index_ready_callback_ = nullptr;
+    }
+
+    // Wait for async operations. A streamed open stops between requests, so
+    // this waits for at most one request's timeout (a few seconds).
     if (index_future_.valid()) {
         indexing_.store(false);
         try {
@@ -348,35 +449,43 @@ void GCodeStreamingController::close() {
         } catch (...) {
         }
     }
+    stop_digest();
 
-    // Clear callback under lock to prevent race with async invocation
+    cache_.cancel_prefetch();
+    cache_.clear();
     {
-        std::lock_guard<std::mutex> lock(callback_mutex_);
-        index_complete_callback_ = nullptr;
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index_.clear();
+        toolpaths_.reset();
+        toolpath_object_ids_.clear();
     }
-
-    cache_.clear();
-    index_.clear();
     data_source_.reset();
     is_open_.store(false);
+    partial_index_.store(false);
+    index_complete_.store(false);
 
     {
         std::lock_guard<std::mutex> lock(metadata_mutex_);
         metadata_extracted_ = false;
         header_metadata_.reset();
+        object_table_.clear();
     }
 
     spdlog::debug("[StreamingController] Closed");
 }
 
 bool GCodeStreamingController::is_open() const {
-    return is_open_.load() && !indexing_.load();
+    return is_open_.load() && (!indexing_.load() || partial_index_.load());
 }
 
 bool GCodeStreamingController::is_indexing() const {
     return indexing_.load();
 }
 
+bool GCodeStreamingController::is_index_complete() const {
+    return is_open() && index_complete_.load();
+}
+
 float GCodeStreamingController::get_index_progress() const {
     if (!indexing_.load()) {
         return is_open_.load() ? 1.0f : 0.0f;
@@ -395,9 +504,9 @@ std::string GCodeStreamingController::get_source_name() const {
 // Layer Access
 // =============================================================================
 
-std::shared_ptr<const std::vector<ToolpathSegment>>
+std::shared_ptr<const CompactSegments>
 GCodeStreamingController::get_layer_segments(size_t layer_index) {
-    if (!is_open() || layer_index >= index_.get_layer_count()) {
+    if (!is_open() || layer_index >= indexed_layer_count()) {
         return nullptr;
     }
 
@@ -409,7 +518,7 @@ GCodeStreamingController::get_layer_segments(size_t layer_index) {
         return nullptr;
     }
 
-    // Trigger prefetch for nearby layers
+    // Queue nearby layers for the background loader
     prefetch_around(layer_index, prefetch_radius_);
 
     // Return shared_ptr - data stays valid as long as caller holds the pointer
@@ -417,12 +526,12 @@ GCodeStreamingController::get_layer_segments(size_t layer_index) {
 }
 
 void GCodeStreamingController::request_layer(size_t layer_index) {
-    if (!is_open() || layer_index >= index_.get_layer_count()) {
+    if (!is_open() || layer_index >= indexed_layer_count()) {
         return;
     }
 
-    // Just trigger the load (get_or_load handles caching)
-    cache_.get_or_load(layer_index, make_loader());
+    // Requested layer first, then its neighbours
+    prefetch_around(layer_index, prefetch_radius_);
 }
 
 bool GCodeStreamingController::is_layer_cached(size_t layer_index) const {
@@ -434,12 +543,16 @@ void GCodeStreamingController::prefetch_around(size_t center_layer, size_t radiu
         return;
     }
 
-    size_t layer_count = index_.get_layer_count();
+    size_t layer_count = indexed_layer_count();
     if (layer_count == 0) {
         return; // Nothing to prefetch
     }
 
-    cache_.prefetch(center_layer, radius, make_loader(), layer_count - 1);
+    cache_.prefetch_async(center_layer, radius, make_loader(), layer_count - 1);
+}
+
+bool GCodeStreamingController::wait_for_prefetch(std::chrono::milliseconds timeout) {
+    return cache_.wait_for_prefetch(timeout);
 }
 
 // =============================================================================
@@ -447,22 +560,30 @@ void GCodeStreamingController::prefetch_around(size_t center_layer, size_t radiu
 // =============================================================================
 
 size_t GCodeStreamingController::get_layer_count() const {
-    return is_open_.load() ? index_.get_layer_count() : 0;
+    return is_open_.load() ? indexed_layer_count() : 0;
 }
 
 float GCodeStreamingController::get_layer_z(size_t layer_index) const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
     return index_.get_layer_z(layer_index);
 }
 
+StreamingLayerEntry GCodeStreamingController::get_layer_entry(size_t layer_index) const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    return index_.get_entry(layer_index);
+}
+
 int GCodeStreamingController::find_layer_at_z(float z) const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
     return index_.find_layer_at_z(z);
 }
 
-const LayerIndexStats& GCodeStreamingController::get_index_stats() const {
+LayerIndexStats GCodeStreamingController::get_index_stats() const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
     if (index_.is_valid()) {
         return index_.get_stats();
     }
-    return empty_stats_;
+    return LayerIndexStats{};
 }
 
 size_t GCodeStreamingController::get_file_size() const {
@@ -477,6 +598,10 @@ float GCodeStreamingController::get_cache_hit_rate() const {
     return cache_.hit_rate();
 }
 
+GCodeLayerCache::HitStats GCodeStreamingController::get_cache_stats() const {
+    return cache_.hit_stats();
+}
+
 size_t GCodeStreamingController::get_cache_memory_usage() const {
     return cache_.memory_usage_bytes();
 }
@@ -517,25 +642,60 @@ const GCodeHeaderMetadata* GCodeStreamingController::get_header_metadata() const
     return header_metadata_.get();
 }
 
+ObjectSymbolTable GCodeStreamingController::get_object_table() const {
+    std::lock_guard<std::mutex> lock(metadata_mutex_);
+    return object_table_;
+}
+
+size_t GCodeStreamingController::get_object_count() const {
+    std::lock_guard<std::mutex> lock(metadata_mutex_);
+    return object_table_.size();
+}
+
 // =============================================================================
 // Private Implementation
 // =============================================================================
 
-std::vector<ToolpathSegment> GCodeStreamingController::load_layer(size_t layer_index) {
-    std::vector<ToolpathSegment> segments;
+CompactSegments GCodeStreamingController::load_layer(size_t layer_index) {
+    CompactSegments segments;
 
-    if (!data_source_ || !index_.is_valid()) {
+    if (!data_source_) {
         return segments;
     }
 
-    auto entry = index_.get_entry(layer_index);
+    // Copy what we need and release the lock before the (possibly network) read
+    StreamingLayerEntry entry;
+    size_t layer_count;
+    std::shared_ptr<const ToolpathFile> toolpaths;
+    std::vector<ObjectId> toolpath_ids;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        entry = index_.get_entry(layer_index);
+        layer_count = index_.get_layer_count();
+        toolpaths = toolpaths_;
+        toolpath_ids = toolpath_object_ids_;
+    }
     if (!entry.is_valid()) {
         spdlog::warn("[StreamingController] Invalid index entry for layer {}", layer_index);
         return segments;
     }
 
-    // Read layer bytes from source
-    auto bytes = data_source_->read_range(entry.file_offset, entry.byte_length);
+    // Pre-digested file: decode from the mapping instead of reading and parsing text
+    if (toolpaths) {
+        if (toolpaths->load_layer(layer_index, segments, toolpath_ids)) {
+            spdlog::trace("[StreamingController] Decoded layer {} ({} segments)", layer_index,
+                          segments.size());
+            return segments;
+        }
+        segments = CompactSegments(); // Damaged layer: parse the text instead
+    }
+
+    // Read layer bytes from source (prefetch and on-demand loads share it)
+    std::vector<char> bytes;
+    {
+        std::lock_guard<std::mutex> lock(read_mutex_);
+        bytes = data_source_->read_range(entry.file_offset, entry.byte_length);
+    }
     if (bytes.empty()) {
         spdlog::warn("[StreamingController] Failed to read bytes for layer {} "
                      "(offset={}, length={})",
@@ -543,38 +703,31 @@ std::vector<ToolpathSegment> GCodeStreamingController::load_layer(size_t layer_i
         return segments;
     }
 
-    // Parse the bytes line by line
-    GCodeParser parser;
-    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
-    std::string line;
+    auto result = parse_layer_bytes(bytes.data(), bytes.size());
 
-    while (std::getline(stream, line)) {
-        parser.parse_line(line);
-    }
-
-    // Get parsed result
-    auto result = parser.finalize();
+    // Ids from this parse -> file-wide ids
+    std::vector<ObjectId> file_ids(result.object_table.size(), NO_OBJECT_ID);
 
     // Extract metadata from first layer parsed (thread-safe)
     if (!result.layers.empty()) {
         std::lock_guard<std::mutex> lock(metadata_mutex_);
+        const auto& names = result.object_table.names();
+        for (size_t id = 0; id < names.size(); ++id) {
+            file_ids[id] = object_table_.intern(names[id]);
+        }
         if (!metadata_extracted_) {
             header_metadata_ = std::make_unique<GCodeHeaderMetadata>();
             header_metadata_->slicer = result.slicer_name;
             header_metadata_->filament_type = result.filament_type;
             header_metadata_->estimated_time_seconds = result.estimated_print_time_minutes * 60.0;
             header_metadata_->filament_used_mm = result.total_filament_mm;
-            header_metadata_->layer_count = static_cast<uint32_t>(index_.get_layer_count());
+            header_metadata_->layer_count = static_cast<uint32_t>(layer_count);
             header_metadata_->tool_colors = result.tool_color_palette;
             metadata_extracted_ = true;
         }
     }
 
-    // Collect all segments from all parsed layers
-    // (usually just one layer, but parser may split on Z changes)
-    for (const auto& layer : result.layers) {
-        segments.insert(segments.end(), layer.segments.begin(), layer.segments.end());
-    }
+    segments = pack_segments(result, file_ids);
 
     spdlog::debug("[StreamingController] Loaded layer {} ({} segments, {} bytes)", layer_index,
                   segments.size(), bytes.size());
@@ -582,27 +735,286 @@ std::vector<ToolpathSegment> GCodeStreamingController::load_layer(size_t layer_i
     return segments;
 }
 
-bool GCodeStreamingController::build_index() {
+bool GCodeStreamingController::build_index(const std::atomic<bool>& keep_running) {
     if (!data_source_) {
         return false;
     }
 
     // Use the virtual method to get an indexable file path
     // This works for FileDataSource (returns original filepath) and
-    // MoonrakerDataSource (returns temp file path after download)
+    // MoonrakerDataSource (returns temp file path after a fallback download)
     std::string file_path = data_source_->indexable_file_path();
 
+    bool success;
     if (!file_path.empty()) {
-        return index_.build_from_file(file_path);
+        // A temporary download is never opened again under the same name, so
+        // caching it would only push real entries out of the disk caches
+        const bool cacheable = !data_source_->indexable_file_is_temporary();
+
+        // Build off to the side so readers never see a half-built index
+        GCodeLayerIndex index;
+        auto& disk_cache = get_layer_index_cache();
+        success = cacheable && disk_cache.load(file_path, index);
+        if (!success) {
+            if (partial_index_.load()) {
+                index_first_layers(file_path, keep_running);
+            }
+            success = keep_running.load() && index.build_from_file(file_path);
+            if (success && cacheable) {
+                disk_cache.store(file_path, index);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(index_mutex_);
+            index_ = std::move(index);
+        }
+        if (success && cacheable) {
+            attach_toolpaths(file_path);
+        }
+    } else {
+        // Remote and in-memory sources: index the bytes as they are read
+        success = stream_index(keep_running);
+    }
+
+    index_complete_.store(success);
+    return success;
+}
+
+bool GCodeStreamingController::stream_index(const std::atomic<bool>& keep_running) {
+    auto start_time = std::chrono::steady_clock::now();
+    uint64_t total_bytes = data_source_->file_size();
+    std::string source_name = data_source_->source_name();
+
+    LayerIndexScanner scanner(total_bytes);
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index_.clear();
+        index_.set_source_path(source_name);
+    }
+
+    spdlog::debug("[StreamingController] Indexing {} while streaming ({} bytes)", source_name,
+                  total_bytes);
+
+    bool complete = data_source_->stream_chunks(
+        [&](const char* data, size_t size, uint64_t offset) {
+            scanner.feed(data, size);
+            if (total_bytes > 0) {
+                index_progress_.store(static_cast<float>(offset + size) /
+                                      static_cast<float>(total_bytes));
+            }
+
+            size_t added;
+            {
+                std::lock_guard<std::mutex> lock(index_mutex_);
+                added = index_.sync_from(scanner);
+            }
+
+            // Streamed async open: usable as soon as the first layer is complete
+            if (added > 0 && partial_index_.load() && !is_open_.load()) {
+                spdlog::info("[StreamingController] First layers ready after {} of {} bytes",
+                             offset + size, total_bytes);
+                notify_index_ready();
+            }
+            return true;
+        },
+        keep_running);
+
+    if (!complete) {
+        return false;
+    }
+
+    scanner.finish();
+    size_t layer_count;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index_.sync_from(scanner);
+        layer_count = index_.get_layer_count();
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                             start_time);
+    spdlog::info("[StreamingController] Indexed {} while streaming: {} layers, {:.1f}ms",
+                 source_name, layer_count, elapsed.count());
+
+    return layer_count > 0;
+}
+
+void GCodeStreamingController::index_first_layers(const std::string& file_path,
+                                                  const std::atomic<bool>& keep_running) {
+    constexpr uint32_t CHUNK_SIZE = 1024 * 1024;
+    auto start_time = std::chrono::steady_clock::now();
+    uint64_t total_bytes = data_source_->file_size();
+    uint64_t limit = std::min<uint64_t>(total_bytes, FIRST_LAYERS_SCAN_LIMIT);
+
+    LayerIndexScanner scanner(total_bytes);
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index_.clear();
+        index_.set_source_path(file_path);
+    }
+
+    // Header thumbnails can run to megabytes, so read until a layer completes
+    size_t added = 0;
+    uint64_t offset = 0;
+    while (added == 0 && offset < limit && keep_running.load()) {
+        std::vector<char> chunk;
+        {
+            std::lock_guard<std::mutex> lock(read_mutex_);
+            chunk = data_source_->read_range(
+                offset, static_cast<uint32_t>(std::min<uint64_t>(CHUNK_SIZE, limit - offset)));
+        }
+        if (chunk.empty()) {
+            return;
+        }
+        scanner.feed(chunk.data(), chunk.size());
+        offset += chunk.size();
+
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        added = index_.sync_from(scanner);
+    }
+
+    if (added > 0) {
+        auto elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time);
+        spdlog::info("[StreamingController] First {} layers ready after {} of {} bytes, {:.1f}ms",
+                     added, offset, total_bytes, elapsed.count());
+        notify_index_ready();
+    }
+}
+
+void GCodeStreamingController::attach_toolpaths(const std::string& file_path) {
+    auto toolpaths = get_toolpath_cache().load(file_path);
+    std::vector<StreamingLayerEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        if (!toolpaths || toolpaths->layer_count() != index_.get_layer_count()) {
+            entries = index_.entries();
+            toolpaths.reset();
+        }
+    }
+
+    if (!toolpaths) {
+        // First open of this file (or it changed): digest it for next time
+        stop_digest();
+        digesting_.store(true);
+        try {
+            digest_thread_ = std::thread(&GCodeStreamingController::digest_toolpaths, this,
+                                         file_path, std::move(entries));
+        } catch (const std::system_error& e) {
+            spdlog::debug("[StreamingController] Not digesting toolpaths: {}", e.what());
+            digesting_.store(false);
+        }
+        return;
     }
 
-    // Sources without file path (e.g., MemoryDataSource) cannot be indexed
-    // with the current file-based indexer
-    spdlog::warn("[StreamingController] Data source has no indexable file path");
-    return false;
+    // Layers shown during a progressive open may already have interned some names
+    std::vector<ObjectId> object_ids;
+    {
+        std::lock_guard<std::mutex> lock(metadata_mutex_);
+        for (const auto& name : toolpaths->object_names()) {
+            object_ids.push_back(object_table_.intern(name));
+        }
+        if (!metadata_extracted_) {
+            header_metadata_ = std::make_unique<GCodeHeaderMetadata>(toolpaths->metadata());
+            header_metadata_->layer_count = static_cast<uint32_t>(toolpaths->layer_count());
+            metadata_extracted_ = true;
+        }
+    }
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    toolpaths_ = std::move(toolpaths);
+    toolpath_object_ids_ = std::move(object_ids);
+}
+
+void GCodeStreamingController::digest_toolpaths(const std::string& file_path,
+                                               const std::vector<StreamingLayerEntry>& entries) {
+    auto start_time = std::chrono::steady_clock::now();
+    auto& toolpath_cache = get_toolpath_cache();
+    auto writer = toolpath_cache.begin_store(file_path);
+    MappedFile file;
+    if (!writer || !file.open(file_path)) {
+        return;
+    }
+
+    GCodeHeaderMetadata metadata = extract_header_metadata(file_path);
+    for (const auto& entry : entries) {
+        if (!digesting_.load()) {
+            spdlog::debug("[StreamingController] Toolpath digest abandoned");
+            return;
+        }
+        if (entry.file_offset > file.size() ||
+            entry.byte_length > file.size() - entry.file_offset) {
+            return; // File shrank since it was indexed
+        }
+        auto result = parse_layer_bytes(file.data() + entry.file_offset, entry.byte_length);
+        if (metadata.tool_colors.empty()) {
+            metadata.tool_colors = result.tool_color_palette;
+        }
+        writer->add_layer(entry.z_height, pack_segments(result, {}));
+        if (writer->bytes_written() > toolpath_cache.get_max_size()) {
+            // Storing it would evict every other file and then this one
+            spdlog::debug("[StreamingController] Toolpaths of {} exceed the cache, not digesting",
+                          file_path);
+            return;
+        }
+
+        // Small yield between layers to avoid starving UI thread
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    metadata.layer_count = static_cast<uint32_t>(entries.size());
+
+    if (toolpath_cache.finish_store(*writer, metadata)) {
+        auto elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start_time);
+        spdlog::info("[StreamingController] Digested {} layers of {} in {:.0f}ms", entries.size(),
+                     file_path, elapsed.count());
+    }
+}
+
+void GCodeStreamingController::stop_digest() {
+    digesting_.store(false);
+    if (digest_thread_.joinable()) {
+        digest_thread_.join();
+    }
+}
+
+void GCodeStreamingController::notify_index_ready() {
+    if (is_open_.exchange(true)) {
+        return;
+    }
+    std::function<void()> callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = index_ready_callback_;
+    }
+    if (callback) {
+        callback();
+    }
+}
+
+void GCodeStreamingController::notify_index_complete(bool success) {
+    // Capture callback under lock to prevent race with close()
+    // The callback may have been nullified if close() was called
+    std::function<void(bool)> callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = index_complete_callback_;
+    }
+
+    if (callback) {
+        spdlog::debug("[StreamingController] Invoking completion callback (success={})", success);
+        callback(success);
+        spdlog::debug("[StreamingController] Completion callback returned");
+    } else {
+        spdlog::debug("[StreamingController] No completion callback registered");
+    }
+}
+
+size_t GCodeStreamingController::indexed_layer_count() const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    return index_.get_layer_count();
 }
 
-std::function<std::vector<ToolpathSegment>(size_t)> GCodeStreamingController::make_loader() {
+std::function<CompactSegments(size_t)> GCodeStreamingController::make_loader() {
     return [this](size_t layer_index) { return load_layer(layer_index); };
 }
 
@@ -0,0 +1,362 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_tokenizer.h"
+
+#include <climits>
+#include <cmath>
+#include <limits>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+/// Same set as std::isspace in the "C" locale
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline bool starts_with(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+/// Case-insensitive starts_with; @p prefix must be upper case
+bool starts_with_nocase(std::string_view text, std::string_view prefix) {
+    if (text.size() < prefix.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < prefix.size(); i++) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+        if (c != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Comment text after the ';' and any leading whitespace
+std::string_view comment_body(std::string_view comment) {
+    if (comment.empty() || comment[0] != ';') {
+        return {};
+    }
+    size_t start = 1;
+    while (start < comment.size() && is_space(comment[start])) {
+        start++;
+    }
+    return comment.substr(start);
+}
+
+/// Powers of ten that are exact in a double
+constexpr double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr int MAX_EXACT_POW10 = 22;
+
+/// More digits than this cannot be accumulated in a uint64_t
+constexpr int MAX_MANTISSA_DIGITS = 19;
+
+double scale_pow10(double value, int exp10) {
+    if (exp10 == 0 || value == 0.0) {
+        return value;
+    }
+    if (exp10 > 0) {
+        return exp10 <= MAX_EXACT_POW10 ? value * POW10[exp10] : value * std::pow(10.0, exp10);
+    }
+    return -exp10 <= MAX_EXACT_POW10 ? value / POW10[-exp10] : value * std::pow(10.0, exp10);
+}
+
+GCodeCommand classify(std::string_view code) {
+    if (code.empty()) {
+        return GCodeCommand::None;
+    }
+    switch (code[0]) {
+    case 'G':
+        if (code.size() >= 2 && (code[1] == '0' || code[1] == '1') &&
+            (code.size() == 2 || code[2] == ' ')) {
+            return GCodeCommand::Move;
+        }
+        if (code == "G90") {
+            return GCodeCommand::Absolute;
+        }
+        if (code == "G91") {
+            return GCodeCommand::Relative;
+        }
+        return GCodeCommand::Other;
+    case 'M':
+        if (code == "M82") {
+            return GCodeCommand::AbsoluteE;
+        }
+        if (code == "M83") {
+            return GCodeCommand::RelativeE;
+        }
+        return GCodeCommand::Other;
+    case 'T':
+        return GCodeCommand::ToolChange;
+    case 'E':
+        return starts_with(code, "EXCLUDE_OBJECT") ? GCodeCommand::ExcludeObject
+                                                   : GCodeCommand::Other;
+    default:
+        return GCodeCommand::Other;
+    }
+}
+
+} // namespace
+
+std::string_view trim_view(std::string_view text) {
+    size_t start = 0;
+    while (start < text.size() && is_space(text[start])) {
+        start++;
+    }
+    size_t end = text.size();
+    while (end > start && is_space(text[end - 1])) {
+        end--;
+    }
+    return text.substr(start, end - start);
+}
+
+GCodeLine tokenize_line(std::string_view line) {
+    GCodeLine result;
+    size_t comment_pos = line.find(';');
+    if (comment_pos != std::string_view::npos) {
+        result.comment = line.substr(comment_pos);
+        line = line.substr(0, comment_pos);
+    }
+    result.code = trim_view(line);
+    result.command = classify(result.code);
+    return result;
+}
+
+size_t parse_float(std::string_view text, float& out) {
+    // Hand-rolled rather than std::from_chars: GCC 7 has no floating-point from_chars
+    size_t i = 0;
+    size_t n = text.size();
+    bool negative = false;
+    if (i < n && (text[i] == '+' || text[i] == '-')) {
+        negative = text[i] == '-';
+        i++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0; // Significant digits in mantissa
+    int exp10 = 0;
+    bool any_digit = false;
+
+    for (; i < n && is_digit(text[i]); i++) {
+        any_digit = true;
+        if (digits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(text[i] - '0');
+            digits += mantissa != 0;
+        } else {
+            exp10++;
+        }
+    }
+    if (i < n && text[i] == '.') {
+        i++;
+        for (; i < n && is_digit(text[i]); i++) {
+            any_digit = true;
+            if (digits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(text[i] - '0');
+                digits += mantissa != 0;
+                exp10--;
+            }
+        }
+    }
+    if (!any_digit) {
+        return 0;
+    }
+
+    // Exponent only counts when digits follow ("1e" parses as 1, like strtof)
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        size_t j = i + 1;
+        bool exp_negative = false;
+        if (j < n && (text[j] == '+' || text[j] == '-')) {
+            exp_negative = text[j] == '-';
+            j++;
+        }
+        if (j < n && is_digit(text[j])) {
+            int exponent = 0;
+            for (; j < n && is_digit(text[j]); j++) {
+                if (exponent < 10000) {
+                    exponent = exponent * 10 + (text[j] - '0');
+                }
+            }
+            exp10 += exp_negative ? -exponent : exponent;
+            i = j;
+        }
+    }
+
+    double value = scale_pow10(static_cast<double>(mantissa), exp10);
+    if (value > static_cast<double>(std::numeric_limits<float>::max())) {
+        return 0; // Out of range, as std::stof reports it
+    }
+    float result = static_cast<float>(value);
+    out = negative ? -result : result;
+    return i;
+}
+
+size_t parse_int(std::string_view text, int& out) {
+    size_t i = 0;
+    size_t n = text.size();
+    bool negative = false;
+    if (i < n && (text[i] == '+' || text[i] == '-')) {
+        negative = text[i] == '-';
+        i++;
+    }
+    size_t first_digit = i;
+    int64_t value = 0;
+    for (; i < n && is_digit(text[i]); i++) {
+        value = value * 10 + (text[i] - '0');
+        if (value > static_cast<int64_t>(INT_MAX) + 1) {
+            return 0;
+        }
+    }
+    if (i == first_digit) {
+        return 0;
+    }
+    value = negative ? -value : value;
+    if (value > INT_MAX) {
+        return 0;
+    }
+    out = static_cast<int>(value);
+    return i;
+}
+
+bool parse_leading_float(std::string_view text, float& out) {
+    size_t start = 0;
+    while (start < text.size() && is_space(text[start])) {
+        start++;
+    }
+    return parse_float(text.substr(start), out) != 0;
+}
+
+bool parse_leading_int(std::string_view text, int& out) {
+    size_t start = 0;
+    while (start < text.size() && is_space(text[start])) {
+        start++;
+    }
+    return parse_int(text.substr(start), out) != 0;
+}
+
+MoveWords scan_move_words(std::string_view code) {
+    MoveWords words;
+    uint8_t seen = 0;
+    size_t n = code.size();
+
+    for (size_t pos = 0; pos < n; pos++) {
+        uint8_t axis;
+        float* target;
+        switch (code[pos]) {
+        case 'X':
+            axis = MoveWords::X;
+            target = &words.x;
+            break;
+        case 'Y':
+            axis = MoveWords::Y;
+            target = &words.y;
+            break;
+        case 'Z':
+            axis = MoveWords::Z;
+            target = &words.z;
+            break;
+        case 'E':
+            axis = MoveWords::E;
+            target = &words.e;
+            break;
+        default:
+            continue;
+        }
+        if (seen & axis) {
+            continue;
+        }
+        seen |= axis;
+
+        if (pos > 0 && code[pos - 1] != ' ' && code[pos - 1] != '\t') {
+            continue;
+        }
+        // The word runs over [0-9.+-]; the number is the longest valid prefix of it
+        size_t end = pos + 1;
+        while (end < n && (is_digit(code[end]) || code[end] == '.' || code[end] == '-' ||
+                           code[end] == '+')) {
+            end++;
+        }
+        if (parse_float(code.substr(pos + 1, end - pos - 1), *target) != 0) {
+            words.present |= axis;
+        }
+        pos = end - 1;
+    }
+    return words;
+}
+
+bool find_string_param(std::string_view code, std::string_view name, std::string_view& out) {
+    size_t pos = 0;
+    while ((pos = code.find(name, pos)) != std::string_view::npos) {
+        size_t eq = pos + name.size();
+        if (eq < code.size() && code[eq] == '=') {
+            size_t start = eq + 1;
+            if (start >= code.size()) {
+                return false;
+            }
+            size_t end = code.find(' ', start);
+            out = code.substr(start, end == std::string_view::npos ? end : end - start);
+            return true;
+        }
+        pos++;
+    }
+    return false;
+}
+
+bool parse_tool_number(std::string_view code, int& out) {
+    if (code.size() < 2 || code[0] != 'T') {
+        return false;
+    }
+    size_t i = 1;
+    while (i < code.size() && is_digit(code[i])) {
+        i++;
+    }
+    if (i == 1) {
+        return false; // No digits after T
+    }
+    if (i < code.size() && !is_space(code[i])) {
+        return false; // Not standalone
+    }
+    return parse_int(code.substr(1, i - 1), out) != 0;
+}
+
+bool is_layer_marker(std::string_view comment) {
+    std::string_view body = comment_body(comment);
+    return starts_with_nocase(body, "LAYER_CHANGE") || starts_with_nocase(body, "LAYER:");
+}
+
+bool split_metadata_comment(std::string_view comment, std::string_view& key,
+                            std::string_view& value) {
+    std::string_view body = comment_body(comment);
+
+    // Prefer '=' if present and before any ':', otherwise use ':'
+    size_t eq_pos = body.find('=');
+    size_t colon_pos = body.find(':');
+    size_t sep_pos = std::string_view::npos;
+    if (eq_pos != std::string_view::npos &&
+        (colon_pos == std::string_view::npos || eq_pos < colon_pos)) {
+        sep_pos = eq_pos;
+    } else if (colon_pos != std::string_view::npos) {
+        sep_pos = colon_pos;
+    }
+    if (sep_pos == std::string_view::npos) {
+        return false;
+    }
+
+    key = trim_view(body.substr(0, sep_pos));
+    value = trim_view(body.substr(sep_pos + 1));
+    return true;
+}
+
+} // namespace gcode
+} // namespace helix
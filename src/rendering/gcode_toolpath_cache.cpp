@@ -0,0 +1,615 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_toolpath_cache.h"
+
+#include "app_globals.h"
+#include "cache_dir_utils.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace helix {
+namespace gcode {
+
+namespace {
+
+// "HXPATH" + format version; bump the version when the layout changes
+constexpr char FILE_MAGIC[8] = {'H', 'X', 'P', 'A', 'T', 'H', 0, 1};
+
+// Trailer at the very end: footer offset, footer checksum, magic
+constexpr size_t TRAILER_BYTES = 8 + 8 + sizeof(FILE_MAGIC);
+
+// Serialized ToolpathLayerRecord: offset, length, segment count, z, checksum
+constexpr size_t RECORD_BYTES = 8 + 4 + 4 + 4 + 8;
+
+constexpr float GRID_PER_MM = 1.0f / CompactSegments::XY_QUANTUM_MM;
+
+/// Per-segment flag byte. Fields follow in declaration order; the end XY
+/// delta from the start is always present, between START_Z and END_Z.
+enum SegmentFlag : uint8_t {
+    EXTRUSION = 1 << 0,
+    START_JUMP = 1 << 1, ///< Start XY delta from the previous end
+    START_Z = 1 << 2,    ///< Start Z (float)
+    END_Z = 1 << 3,      ///< End Z (float)
+    NEW_TOOL = 1 << 4,   ///< Tool index (varint)
+    NEW_OBJECT = 1 << 5, ///< Object id + 1, 0 = none (varint)
+    NEW_WIDTH = 1 << 6,  ///< Width in µm (varint)
+    NEW_AMOUNT = 1 << 7, ///< Extrusion amount (float)
+};
+
+// Same rounding as CompactSegments, so decoding and re-packing is lossless
+int32_t to_grid(float mm) {
+    return static_cast<int32_t>(std::lround(mm * GRID_PER_MM));
+}
+
+float from_grid(int32_t units) {
+    return static_cast<float>(units) * CompactSegments::XY_QUANTUM_MM;
+}
+
+uint32_t to_width_um(float width_mm) {
+    float width_um = std::round(std::max(width_mm, 0.0f) * 1000.0f);
+    return static_cast<uint32_t>(std::min(width_um, 65535.0f));
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// Appends fixed-size fields and varints to a byte buffer
+class ByteWriter {
+  public:
+    explicit ByteWriter(std::string& buffer) : buffer_(buffer) {}
+
+    template <typename T> void put(T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer_.append(bytes, sizeof(T));
+    }
+
+    void put_varint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    void put_string(const std::string& value) {
+        put(static_cast<uint32_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    void put_strings(const std::vector<std::string>& values) {
+        put(static_cast<uint32_t>(values.size()));
+        for (const auto& value : values) {
+            put_string(value);
+        }
+    }
+
+  private:
+    std::string& buffer_;
+};
+
+/// Reads fields back, failing (rather than overrunning) on truncated input
+class ByteReader {
+  public:
+    ByteReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T> bool get(T& value) {
+        if (size_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool get_varint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && pos_ < size_; shift += 7) {
+            auto byte = static_cast<uint8_t>(data_[pos_++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool get_string(std::string& value) {
+        uint32_t len = 0;
+        if (!get(len) || size_ - pos_ < len) {
+            return false;
+        }
+        value.assign(data_ + pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+    bool get_strings(std::vector<std::string>& values) {
+        uint32_t count = 0;
+        if (!get(count) || count > remaining() / sizeof(uint32_t)) {
+            return false;
+        }
+        values.resize(count);
+        for (auto& value : values) {
+            if (!get_string(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t remaining() const {
+        return size_ - pos_;
+    }
+
+  private:
+    const char* data_;
+    size_t size_;
+    size_t pos_{0};
+};
+
+} // namespace
+
+// =============================================================================
+// ToolpathFileWriter
+// =============================================================================
+
+ToolpathFileWriter::ToolpathFileWriter(std::string path, GCodeFileIdentity identity)
+    : path_(std::move(path)), temp_path_(path_ + ".tmp"), identity_(std::move(identity)),
+      out_(temp_path_, std::ios::binary | std::ios::trunc) {}
+
+ToolpathFileWriter::~ToolpathFileWriter() {
+    if (!committed_) {
+        out_.close();
+        std::error_code ec;
+        std::filesystem::remove(temp_path_, ec);
+    }
+}
+
+void ToolpathFileWriter::add_layer(float z, const CompactSegments& segments) {
+    blob_.clear();
+    ByteWriter out(blob_);
+
+    // Decoder state starts from the same values in every layer
+    int32_t x = 0;
+    int32_t y = 0;
+    float last_z = 0.0f;
+    int tool = 0;
+    uint64_t object = 0;
+    uint32_t width_um = 0;
+    float amount = 0.0f;
+
+    for (const auto& seg : segments) {
+        int32_t start_x = to_grid(seg.start.x);
+        int32_t start_y = to_grid(seg.start.y);
+        int32_t end_x = to_grid(seg.end.x);
+        int32_t end_y = to_grid(seg.end.y);
+        ObjectId id = seg.object_name.empty() ? NO_OBJECT_ID : objects_.intern(seg.object_name);
+        uint64_t seg_object = id == NO_OBJECT_ID ? 0 : static_cast<uint64_t>(id) + 1;
+        uint32_t seg_width = to_width_um(seg.width);
+        int seg_tool = std::max(seg.tool_index, 0);
+
+        uint8_t flags = seg.is_extrusion ? EXTRUSION : 0;
+        if (start_x != x || start_y != y) {
+            flags |= START_JUMP;
+        }
+        if (seg.start.z != last_z) {
+            flags |= START_Z;
+        }
+        if (seg.end.z != seg.start.z) {
+            flags |= END_Z;
+        }
+        if (seg_tool != tool) {
+            flags |= NEW_TOOL;
+        }
+        if (seg_object != object) {
+            flags |= NEW_OBJECT;
+        }
+        if (seg_width != width_um) {
+            flags |= NEW_WIDTH;
+        }
+        if (seg.extrusion_amount != amount) {
+            flags |= NEW_AMOUNT;
+        }
+
+        out.put(flags);
+        if (flags & START_JUMP) {
+            out.put_varint(zigzag(static_cast<int64_t>(start_x) - x));
+            out.put_varint(zigzag(static_cast<int64_t>(start_y) - y));
+        }
+        if (flags & START_Z) {
+            out.put(seg.start.z);
+        }
+        out.put_varint(zigzag(static_cast<int64_t>(end_x) - start_x));
+        out.put_varint(zigzag(static_cast<int64_t>(end_y) - start_y));
+        if (flags & END_Z) {
+            out.put(seg.end.z);
+        }
+        if (flags & NEW_TOOL) {
+            out.put_varint(static_cast<uint64_t>(seg_tool));
+        }
+        if (flags & NEW_OBJECT) {
+            out.put_varint(seg_object);
+        }
+        if (flags & NEW_WIDTH) {
+            out.put_varint(seg_width);
+        }
+        if (flags & NEW_AMOUNT) {
+            out.put(seg.extrusion_amount);
+        }
+
+        x = end_x;
+        y = end_y;
+        last_z = seg.end.z;
+        tool = seg_tool;
+        object = seg_object;
+        width_um = seg_width;
+        amount = seg.extrusion_amount;
+    }
+
+    layers_.push_back({offset_, static_cast<uint32_t>(blob_.size()),
+                       static_cast<uint32_t>(segments.size()), z,
+                       fnv1a_hash(blob_.data(), blob_.size())});
+    out_.write(blob_.data(), static_cast<std::streamsize>(blob_.size()));
+    offset_ += blob_.size();
+}
+
+bool ToolpathFileWriter::commit(const GCodeHeaderMetadata& metadata) {
+    if (committed_ || !is_open()) {
+        return false;
+    }
+
+    std::string footer;
+    ByteWriter out(footer);
+    out.put_string(identity_.path);
+    out.put(identity_.size);
+    out.put(identity_.mtime_ns);
+    out.put(identity_.fingerprint);
+
+    out.put_string(metadata.slicer);
+    out.put_string(metadata.slicer_version);
+    out.put_string(metadata.filament_type);
+    out.put(metadata.estimated_time_seconds);
+    out.put(metadata.filament_used_mm);
+    out.put(metadata.filament_used_g);
+    out.put(metadata.layer_height);
+    out.put(metadata.first_layer_height);
+    out.put(metadata.object_height);
+    out.put(metadata.first_layer_bed_temp);
+    out.put(metadata.first_layer_nozzle_temp);
+    out.put(metadata.layer_count);
+    out.put_strings(metadata.tool_colors);
+    out.put_strings(objects_.names());
+
+    out.put(static_cast<uint32_t>(layers_.size()));
+    for (const auto& layer : layers_) {
+        out.put(layer.offset);
+        out.put(layer.byte_length);
+        out.put(layer.segment_count);
+        out.put(layer.z);
+        out.put(layer.checksum);
+    }
+
+    // Trailer last, so a reader finds the tables from the end of the file
+    uint64_t checksum = fnv1a_hash(footer.data(), footer.size());
+    out.put(offset_);
+    out.put(checksum);
+    footer.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+    out_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+    out_.close();
+    if (!out_) {
+        spdlog::warn("[ToolpathCache] Failed to write {}", temp_path_);
+        return false;
+    }
+
+    // Rename, so a reader never sees a partial file
+    std::error_code ec;
+    std::filesystem::rename(temp_path_, path_, ec);
+    if (ec) {
+        spdlog::warn("[ToolpathCache] Failed to save {}: {}", path_, ec.message());
+        return false;
+    }
+    committed_ = true;
+    return true;
+}
+
+// =============================================================================
+// ToolpathFile
+// =============================================================================
+
+bool ToolpathFile::open(const std::string& path, const GCodeFileIdentity& expected) {
+    if (!mapping_.open(path) || mapping_.size() < TRAILER_BYTES) {
+        return false;
+    }
+    const char* data = mapping_.data();
+    size_t trailer_pos = mapping_.size() - TRAILER_BYTES;
+    if (std::memcmp(data + mapping_.size() - sizeof(FILE_MAGIC), FILE_MAGIC,
+                    sizeof(FILE_MAGIC)) != 0) {
+        return false;
+    }
+    uint64_t footer_offset = 0;
+    uint64_t checksum = 0;
+    std::memcpy(&footer_offset, data + trailer_pos, sizeof(footer_offset));
+    std::memcpy(&checksum, data + trailer_pos + sizeof(footer_offset), sizeof(checksum));
+    if (footer_offset > trailer_pos) {
+        return false;
+    }
+    size_t footer_size = trailer_pos - static_cast<size_t>(footer_offset);
+    const char* footer = data + footer_offset;
+    if (checksum != fnv1a_hash(footer, footer_size)) {
+        return false;
+    }
+
+    ByteReader in(footer, footer_size);
+    GCodeFileIdentity identity;
+    if (!in.get_string(identity.path) || !in.get(identity.size) || !in.get(identity.mtime_ns) ||
+        !in.get(identity.fingerprint) || !(identity == expected)) {
+        return false;
+    }
+
+    GCodeHeaderMetadata& meta = metadata_;
+    uint32_t layer_count = 0;
+    if (!in.get_string(meta.slicer) || !in.get_string(meta.slicer_version) ||
+        !in.get_string(meta.filament_type) || !in.get(meta.estimated_time_seconds) ||
+        !in.get(meta.filament_used_mm) || !in.get(meta.filament_used_g) ||
+        !in.get(meta.layer_height) || !in.get(meta.first_layer_height) ||
+        !in.get(meta.object_height) || !in.get(meta.first_layer_bed_temp) ||
+        !in.get(meta.first_layer_nozzle_temp) || !in.get(meta.layer_count) ||
+        !in.get_strings(meta.tool_colors) || !in.get_strings(object_names_) ||
+        !in.get(layer_count) || in.remaining() != static_cast<size_t>(layer_count) * RECORD_BYTES) {
+        return false;
+    }
+    meta.filename = identity.path;
+    meta.file_size = identity.size;
+    meta.modified_time = static_cast<double>(identity.mtime_ns) / 1e9;
+
+    layers_.resize(layer_count);
+    for (auto& layer : layers_) {
+        in.get(layer.offset);
+        in.get(layer.byte_length);
+        in.get(layer.segment_count);
+        in.get(layer.z);
+        in.get(layer.checksum);
+        if (layer.offset > footer_offset || layer.byte_length > footer_offset - layer.offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float ToolpathFile::layer_z(size_t layer_index) const {
+    return layer_index < layers_.size() ? layers_[layer_index].z : 0.0f;
+}
+
+size_t ToolpathFile::layer_segment_count(size_t layer_index) const {
+    return layer_index < layers_.size() ? layers_[layer_index].segment_count : 0;
+}
+
+bool ToolpathFile::load_layer(size_t layer_index, CompactSegments& segments,
+                              const std::vector<ObjectId>& object_ids) const {
+    if (layer_index >= layers_.size()) {
+        return false;
+    }
+    const ToolpathLayerRecord& layer = layers_[layer_index];
+    const char* blob = mapping_.data() + layer.offset;
+    if (fnv1a_hash(blob, layer.byte_length) != layer.checksum) {
+        spdlog::warn("[ToolpathCache] Layer {} is damaged", layer_index);
+        return false;
+    }
+
+    ByteReader in(blob, layer.byte_length);
+    int64_t x = 0;
+    int64_t y = 0;
+    float z = 0.0f;
+    ToolpathSegment seg; // Carries tool, object, width and amount between segments
+
+    segments.reserve(layer.segment_count);
+    for (uint32_t i = 0; i < layer.segment_count; ++i) {
+        uint8_t flags = 0;
+        uint64_t dx = 0;
+        uint64_t dy = 0;
+        if (!in.get(flags)) {
+            return false;
+        }
+        if (flags & START_JUMP) {
+            if (!in.get_varint(dx) || !in.get_varint(dy)) {
+                return false;
+            }
+            x += unzigzag(dx);
+            y += unzigzag(dy);
+        }
+        if ((flags & START_Z) && !in.get(z)) {
+            return false;
+        }
+        seg.start = glm::vec3(from_grid(static_cast<int32_t>(x)),
+                              from_grid(static_cast<int32_t>(y)), z);
+
+        if (!in.get_varint(dx) || !in.get_varint(dy)) {
+            return false;
+        }
+        x += unzigzag(dx);
+        y += unzigzag(dy);
+        if ((flags & END_Z) && !in.get(z)) {
+            return false;
+        }
+        seg.end = glm::vec3(from_grid(static_cast<int32_t>(x)), from_grid(static_cast<int32_t>(y)),
+                            z);
+        seg.is_extrusion = (flags & EXTRUSION) != 0;
+
+        uint64_t value = 0;
+        if (flags & NEW_TOOL) {
+            if (!in.get_varint(value)) {
+                return false;
+            }
+            seg.tool_index = static_cast<int>(std::min<uint64_t>(value, 255));
+        }
+        if (flags & NEW_OBJECT) {
+            if (!in.get_varint(value) || value > object_names_.size()) {
+                return false;
+            }
+            if (value == 0) {
+                seg.object_name.clear();
+                seg.object_id = NO_OBJECT_ID;
+            } else {
+                size_t id = value - 1;
+                seg.object_name = object_names_[id];
+                if (object_ids.empty()) {
+                    seg.object_id = static_cast<ObjectId>(id);
+                } else {
+                    seg.object_id = id < object_ids.size() ? object_ids[id] : NO_OBJECT_ID;
+                }
+            }
+        }
+        if (flags & NEW_WIDTH) {
+            if (!in.get_varint(value)) {
+                return false;
+            }
+            seg.width = static_cast<float>(std::min<uint64_t>(value, 65535)) / 1000.0f;
+        }
+        if ((flags & NEW_AMOUNT) && !in.get(seg.extrusion_amount)) {
+            return false;
+        }
+        segments.push_back(seg);
+    }
+    segments.shrink_to_fit();
+    return in.remaining() == 0;
+}
+
+// =============================================================================
+// ToolpathDiskCache
+// =============================================================================
+
+ToolpathDiskCache& get_toolpath_cache() {
+    static ToolpathDiskCache instance(get_helix_cache_dir(ToolpathDiskCache::CACHE_SUBDIR));
+    return instance;
+}
+
+ToolpathDiskCache::ToolpathDiskCache(std::string cache_dir, size_t max_size)
+    : cache_dir_(std::move(cache_dir)), max_size_(max_size) {
+    if (cache_dir_.empty()) {
+        spdlog::warn("[ToolpathCache] No cache directory, toolpaths will not be cached");
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir_, ec);
+    if (ec) {
+        spdlog::warn("[ToolpathCache] Failed to create cache directory {}: {}", cache_dir_,
+                     ec.message());
+    }
+}
+
+std::string ToolpathDiskCache::get_cache_path(const std::string& filepath) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.helixpath",
+             static_cast<unsigned long long>(fnv1a_hash(filepath.data(), filepath.size())));
+    return cache_dir_ + "/" + name;
+}
+
+std::shared_ptr<const ToolpathFile> ToolpathDiskCache::load(const std::string& filepath) {
+    if (cache_dir_.empty()) {
+        return nullptr;
+    }
+    auto start_time = std::chrono::steady_clock::now();
+
+    std::string cache_path = get_cache_path(filepath);
+    std::error_code ec;
+    if (!std::filesystem::exists(cache_path, ec)) {
+        return nullptr;
+    }
+    GCodeFileIdentity identity;
+    if (!GCodeFileIdentity::from_file(filepath, identity)) {
+        return nullptr;
+    }
+
+    auto file = std::make_shared<ToolpathFile>();
+    if (!file->open(cache_path, identity) || file->layer_count() == 0) {
+        spdlog::debug("[ToolpathCache] Stale or damaged toolpaths for {}", filepath);
+        remove(filepath);
+        return nullptr;
+    }
+
+    // Mark as recently used so eviction keeps it
+    std::filesystem::last_write_time(cache_path, std::filesystem::file_time_type::clock::now(),
+                                     ec);
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                             start_time);
+    spdlog::info("[ToolpathCache] Mapped toolpaths for {}: {} layers, {:.1f}ms", filepath,
+                 file->layer_count(), elapsed.count());
+    return file;
+}
+
+std::unique_ptr<ToolpathFileWriter> ToolpathDiskCache::begin_store(const std::string& filepath) {
+    if (cache_dir_.empty()) {
+        return nullptr;
+    }
+    GCodeFileIdentity identity;
+    if (!GCodeFileIdentity::from_file(filepath, identity)) {
+        return nullptr;
+    }
+    auto writer = std::make_unique<ToolpathFileWriter>(get_cache_path(filepath), identity);
+    if (!writer->is_open()) {
+        spdlog::warn("[ToolpathCache] Cannot write toolpaths for {}", filepath);
+        return nullptr;
+    }
+    return writer;
+}
+
+bool ToolpathDiskCache::finish_store(ToolpathFileWriter& writer,
+                                     const GCodeHeaderMetadata& metadata) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (writer.bytes_written() > max_size_) {
+        spdlog::debug("[ToolpathCache] Not saving {}: {} KB exceeds the {} MB cache",
+                      writer.path(), writer.bytes_written() / 1024, max_size_ / (1024 * 1024));
+        return false; // Writer removes its temporary file
+    }
+    if (!writer.commit(metadata)) {
+        return false;
+    }
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(writer.path(), ec);
+    if (!ec && size > max_size_) {
+        spdlog::debug("[ToolpathCache] Not keeping {}: {} KB exceeds the {} MB cache",
+                      writer.path(), size / 1024, max_size_ / (1024 * 1024));
+        std::filesystem::remove(writer.path(), ec);
+        return false;
+    }
+    spdlog::debug("[ToolpathCache] Saved {} layers to {} ({} KB)", writer.layer_count(),
+                  writer.path(), ec ? 0 : size / 1024);
+
+    size_t evicted_count = evict_least_recent_files(cache_dir_, max_size_, writer.path());
+    if (evicted_count > 0) {
+        spdlog::debug("[ToolpathCache] Evicted {} files to stay under {} MB", evicted_count,
+                      max_size_ / (1024 * 1024));
+    }
+    return true;
+}
+
+void ToolpathDiskCache::remove(const std::string& filepath) {
+    if (cache_dir_.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    std::filesystem::remove(get_cache_path(filepath), ec);
+}
+
+size_t ToolpathDiskCache::get_cache_size() const {
+    return cache_directory_size(cache_dir_);
+}
+
+} // namespace gcode
+} // namespace helix
@@ -46,8 +46,8 @@ bool GeometryBudgetManager::is_system_memory_critical() const {
     return read_system_available_kb() < CRITICAL_MEMORY_KB;
 }
 
-GeometryBudgetManager::BudgetConfig GeometryBudgetManager::select_tier(size_t segment_count,
-                                                                       size_t budget_bytes) const {
+GeometryBudgetManager::BudgetConfig
+GeometryBudgetManager::select_tier(size_t segment_count, size_t budget_bytes, int min_tier) const {
     if (budget_bytes == 0) {
         spdlog::info("[GeometryBudget] Zero budget — thumbnail only (tier 5)");
         return {.tier = 5,
@@ -56,7 +56,7 @@ GeometryBudgetManager::BudgetConfig GeometryBudgetManager::select_tier(size_t se
                 .include_travels = false,
                 .budget_bytes = 0};
     }
-    if (segment_count == 0) {
+    if (segment_count == 0 && min_tier <= 1) {
         return {.tier = 1,
                 .tube_sides = 16,
                 .simplification_tolerance = 0.01f,
@@ -68,7 +68,7 @@ GeometryBudgetManager::BudgetConfig GeometryBudgetManager::select_tier(size_t se
     size_t est_n8 = segment_count * BYTES_PER_SEG_N8;
     size_t est_n4 = segment_count * BYTES_PER_SEG_N4;
 
-    if (est_n16 < budget_bytes) {
+    if (min_tier <= 1 && est_n16 < budget_bytes) {
         spdlog::info("[GeometryBudget] Tier 1 (full): est {}MB / {}MB budget",
                      est_n16 / (1024 * 1024), budget_bytes / (1024 * 1024));
         return {.tier = 1,
@@ -77,7 +77,7 @@ GeometryBudgetManager::BudgetConfig GeometryBudgetManager::select_tier(size_t se
                 .include_travels = true,
                 .budget_bytes = budget_bytes};
     }
-    if (est_n8 < budget_bytes) {
+    if (min_tier <= 2 && est_n8 < budget_bytes) {
         spdlog::info("[GeometryBudget] Tier 2 (medium): est {}MB / {}MB budget",
                      est_n8 / (1024 * 1024), budget_bytes / (1024 * 1024));
         return {.tier = 2,
@@ -0,0 +1,87 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cache_dir_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace helix {
+
+namespace {
+
+struct CacheEntry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size;
+};
+
+/// Regular files of @p dir; entries that fail to stat are skipped
+std::vector<CacheEntry> list_cache_files(const std::string& dir) {
+    std::vector<CacheEntry> entries;
+    std::error_code ec;
+    // increment(ec) rather than a range-for: its operator++ throws
+    for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec)) {
+            continue;
+        }
+        CacheEntry entry{it->path(), it->last_write_time(entry_ec), 0};
+        if (entry_ec) {
+            continue;
+        }
+        entry.size = it->file_size(entry_ec);
+        if (entry_ec) {
+            continue; // Removed or renamed mid-scan (size would read as -1)
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+} // namespace
+
+size_t cache_directory_size(const std::string& dir) {
+    size_t total = 0;
+    for (const auto& entry : list_cache_files(dir)) {
+        total += entry.size;
+    }
+    return total;
+}
+
+size_t evict_least_recent_files(const std::string& dir, size_t max_size,
+                                const std::string& keep) {
+    std::vector<CacheEntry> entries = list_cache_files(dir);
+    size_t current_size = 0;
+    for (const auto& entry : entries) {
+        current_size += entry.size;
+    }
+    if (current_size <= max_size) {
+        return 0;
+    }
+
+    // Oldest (least recently loaded or stored) first
+    std::sort(entries.begin(), entries.end(),
+              [](const CacheEntry& a, const CacheEntry& b) { return a.mtime < b.mtime; });
+
+    size_t evicted_count = 0;
+    std::error_code ec;
+    for (const auto& entry : entries) {
+        if (current_size <= max_size) {
+            break;
+        }
+        if (!keep.empty() && std::filesystem::equivalent(entry.path, keep, ec)) {
+            continue;
+        }
+        if (std::filesystem::remove(entry.path, ec)) {
+            current_size -= std::min<size_t>(current_size, entry.size);
+            ++evicted_count;
+        }
+    }
+    return evicted_count;
+}
+
+} // namespace helix
@@ -5,6 +5,7 @@
 
 #include "ui_toast_manager.h"
 
+#include "bed_mesh_surface.h"
 #include "config.h"
 #include "display_manager.h"
 #include "spdlog/spdlog.h"
@@ -563,6 +564,13 @@ bool DisplaySettingsManager::get_bed_mesh_show_zero_plane() const {
     return config->get<bool>("/display/bed_mesh_show_zero_plane", true);
 }
 
+int DisplaySettingsManager::get_bed_mesh_upsample_factor() const {
+    Config* config = Config::get_instance();
+    int factor =
+        config->get<int>("/display/bed_mesh_upsample", helix::mesh::SURFACE_DEFAULT_UPSAMPLE);
+    return std::clamp(factor, 1, helix::mesh::SURFACE_MAX_UPSAMPLE);
+}
+
 // =============================================================================
 // DISPLAY DIM OPTIONS
 // =============================================================================
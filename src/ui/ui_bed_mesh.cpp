@@ -600,6 +600,23 @@ void ui_bed_mesh_set_zero_plane_visible(lv_obj_t* widget, bool visible) {
     lv_obj_invalidate(widget); // Redraw with updated plane visibility
 }
 
+/**
+ * Set the 3D surface upsampling factor
+ */
+void ui_bed_mesh_set_upsample_factor(lv_obj_t* widget, int factor) {
+    if (!widget) {
+        return;
+    }
+
+    bed_mesh_widget_data_t* data = (bed_mesh_widget_data_t*)lv_obj_get_user_data(widget);
+    if (!data || !data->renderer) {
+        return;
+    }
+
+    bed_mesh_renderer_set_upsample_factor(data->renderer, factor);
+    lv_obj_invalidate(widget); // Redraw the resampled surface
+}
+
 /**
  * Set Z display offset for axis labels
  *
@@ -9,6 +9,7 @@
 #include "ams_state.h"
 #include "gcode_camera.h"
 #include "gcode_layer_renderer.h"
+#include "gcode_parallel_parser.h"
 #include "gcode_parser.h"
 #include "gcode_streaming_config.h"
 #include "gcode_streaming_controller.h"
@@ -23,8 +24,13 @@
 #include "gcode_gles_renderer.h"
 #define ENABLE_3D_RENDERER
 using GCode3DRenderer = helix::gcode::GCodeGLESRenderer;
+constexpr int kMin3DGeometryTier = 1;
 #else
 #include "gcode_renderer.h"
+#include "gcode_soft_renderer.h"
+#define ENABLE_3D_RENDERER
+using GCode3DRenderer = helix::gcode::GCodeSoftRenderer;
+constexpr int kMin3DGeometryTier = helix::gcode::kSoftRenderMinTier;
 #endif
 
 // FPS tracking constants (for diagnostic logging, not mode selection)
@@ -215,6 +221,8 @@ class GCodeViewerState {
     lv_color_t external_color_override{};       ///< Stored override color for lazy-init renderers
     std::vector<uint32_t> tool_color_overrides; ///< Per-tool AMS colors for lazy-init renderers
     bool first_render{true};
+    /// Part of a load in progress is on screen (first streamed layers or 3D batches)
+    bool progressive_preview_{false};
     bool rendering_paused_{
         false}; ///< When true, draw_cb skips rendering (for visibility optimization)
 
@@ -242,6 +250,10 @@ class GCodeViewerState {
     /// -1 means "show all layers" (preview mode), >= 0 means "show up to this layer"
     int print_progress_layer_{-1};
 
+    /// Printer's byte offset into the file (set via ui_gcode_viewer_set_print_file_position)
+    /// Only used in print progress mode, where it limits how much of the current layer is drawn
+    uint64_t print_file_position_{0};
+
     /// Content offset (stored to apply when 2D renderer is lazily created)
     float content_offset_y_percent_{0.0f};
 
@@ -257,9 +269,12 @@ class GCodeViewerState {
 
     /// Helper to check if currently using 2D layer renderer
     bool is_using_2d_mode() const {
-#ifdef ENABLE_3D_RENDERER
+#if defined(ENABLE_GLES_3D)
         // With GPU-accelerated GLES: Auto defaults to 3D, only Layer2D forces 2D
         return render_mode_ == GcodeViewerRenderMode::Layer2D || budget_forced_2d_;
+#elif defined(ENABLE_3D_RENDERER)
+        // CPU 3D renderer: only an explicit Render3D selection uses it, Auto stays 2D
+        return render_mode_ != GcodeViewerRenderMode::Render3D || budget_forced_2d_;
 #else
         // Without 3D renderer: only explicit Render3D would use 3D (but it's not available)
         return render_mode_ != GcodeViewerRenderMode::Render3D;
@@ -370,7 +385,8 @@ static void gcode_viewer_draw_cb(lv_event_t* e) {
     // In streaming mode, gcode_file is null but streaming_controller_ is set
     bool has_gcode =
         st->gcode_file || (st->streaming_controller_ && st->streaming_controller_->is_open());
-    if (st->viewer_state != GcodeViewerState::Loaded || !has_gcode) {
+    if ((st->viewer_state != GcodeViewerState::Loaded && !st->progressive_preview_) ||
+        !has_gcode) {
         return;
     }
 
@@ -447,6 +463,8 @@ static void gcode_viewer_draw_cb(lv_event_t* e) {
             current_layer = std::max(0, max_layer);
         }
         st->layer_renderer_2d_->set_current_layer(current_layer);
+        st->layer_renderer_2d_->set_print_file_position(
+            st->print_progress_layer_ >= 0 ? st->print_file_position_ : 0);
 
         // Render 2D layer view
         st->layer_renderer_2d_->render(layer, &widget_coords);
@@ -1005,6 +1023,66 @@ lv_obj_t* ui_gcode_viewer_create(lv_obj_t* parent) {
     return obj;
 }
 
+// Remove the loading spinner overlay, if any
+static void clear_loading_ui(gcode_viewer_state_t* st) {
+    if (st->loading_container) {
+        helix::ui::safe_delete(st->loading_container);
+        st->loading_container = nullptr;
+        st->loading_spinner = nullptr;
+        st->loading_label = nullptr;
+    }
+}
+
+// (Re)create the 2D renderer on the streaming controller's current index
+static void init_streaming_2d_renderer(lv_obj_t* obj, gcode_viewer_state_t* st) {
+    st->layer_renderer_2d_ = std::make_unique<helix::gcode::GCodeLayerRenderer>();
+    st->layer_renderer_2d_->set_streaming_controller(st->streaming_controller_.get());
+
+    // Apply color: external override (AMS/Spoolman) takes priority
+    if (st->has_external_color_override) {
+        st->layer_renderer_2d_->set_extrusion_color(st->external_color_override);
+        spdlog::info("[GCode Viewer] Streaming 2D using external color override");
+    } else {
+        const auto& stats = st->streaming_controller_->get_index_stats();
+        if (!stats.filament_color.empty()) {
+            lv_color_t color =
+                lv_color_hex(std::strtol(stats.filament_color.c_str() + 1, nullptr, 16));
+            st->layer_renderer_2d_->set_extrusion_color(color);
+            spdlog::info("[GCode Viewer] Using filament color from metadata: {}",
+                         stats.filament_color);
+        }
+    }
+
+    // Get canvas size from widget
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    int width = lv_area_get_width(&coords);
+    int height = lv_area_get_height(&coords);
+    st->layer_renderer_2d_->set_canvas_size(width, height);
+    st->layer_renderer_2d_->auto_fit();
+
+    // Apply any stored content offset
+    if (st->content_offset_y_percent_ != 0.0f) {
+        st->layer_renderer_2d_->set_content_offset_y(st->content_offset_y_percent_);
+        spdlog::debug("[GCode Viewer] Applied stored content offset: {}%",
+                      st->content_offset_y_percent_ * 100);
+    }
+}
+
+// Filament color for the 3D renderer: external override (AMS/Spoolman), else G-code metadata
+static void apply_3d_extrusion_color(gcode_viewer_state_t* st) {
+    if (st->has_external_color_override) {
+        st->renderer_->set_extrusion_color(st->external_color_override);
+        spdlog::debug("[GCode Viewer] Applied external color override (AMS/Spoolman)");
+    } else if (st->use_filament_color && st->gcode_file->filament_color_hex.length() >= 2) {
+        lv_color_t color = lv_color_hex(static_cast<uint32_t>(
+            std::strtol(st->gcode_file->filament_color_hex.c_str() + 1, nullptr, 16)));
+        st->renderer_->set_extrusion_color(color);
+        spdlog::debug("[GCode Viewer] Applied filament color: {}",
+                      st->gcode_file->filament_color_hex);
+    }
+}
+
 // Result structure for async geometry building
 struct AsyncBuildResult {
     std::unique_ptr<helix::gcode::ParsedGCodeFile> gcode_file;
@@ -1016,6 +1094,49 @@ struct AsyncBuildResult {
     bool force_2d = false; ///< Budget system forced 2D fallback
 };
 
+#ifdef ENABLE_3D_RENDERER
+// Lower layers of a 3D build still in progress
+struct ProgressiveBatch {
+    std::unique_ptr<helix::gcode::RibbonGeometry> geometry;
+    size_t layers_built{0};
+    helix::gcode::AABB bounds; ///< Whole model, so the camera fits once
+    std::string filename;
+    std::string filament_color_hex;
+};
+
+// UI thread: show a batch, standing in a bounds-only file for the one still being built
+static void apply_progressive_batch(lv_obj_t* obj, uint64_t gen, ProgressiveBatch* b) {
+    gcode_viewer_state_t* st = get_state(obj);
+    if (!st || st->load_generation() != gen || st->viewer_state != GcodeViewerState::Loading ||
+        st->is_using_2d_mode()) {
+        return;
+    }
+
+    if (!st->progressive_preview_) {
+        clear_loading_ui(st);
+        st->gcode_file = std::make_unique<helix::gcode::ParsedGCodeFile>();
+        st->gcode_file->filename = b->filename;
+        st->gcode_file->global_bounding_box = b->bounds;
+        st->gcode_file->filament_color_hex = b->filament_color_hex;
+
+        st->renderer_->set_prebuilt_geometry(std::move(b->geometry), b->filename);
+        st->camera_->fit_to_bounds(b->bounds);
+        if (st->content_offset_y_percent_ != 0.0f) {
+            st->renderer_->set_content_offset_y(st->content_offset_y_percent_);
+        }
+        apply_3d_extrusion_color(st);
+
+        st->progressive_preview_ = true;
+        st->first_render = false;
+    } else {
+        st->renderer_->extend_prebuilt_geometry(std::move(b->geometry));
+    }
+
+    spdlog::debug("[GCode Viewer] Showing first {} layers while building", b->layers_built);
+    lv_obj_invalidate(obj);
+}
+#endif
+
 /**
  * @brief Asynchronously load and build G-code geometry in background thread
  *
@@ -1033,14 +1154,16 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
     st->viewer_state = GcodeViewerState::Loading;
     st->first_render = true;       // Reset for new file
     st->budget_forced_2d_ = false; // Reset budget 2D override for new file
+    st->progressive_preview_ = false;
 
     // Bump generation so any in-flight async callbacks from a prior load are rejected
     const uint64_t gen = st->bump_generation();
 
-    // Clear any existing data sources (mutually exclusive: streaming XOR full-file)
+    // Clear any existing data sources (mutually exclusive: streaming XOR full-file).
+    // The 2D renderer goes first: its raster worker reads them.
+    st->layer_renderer_2d_.reset(); // Will be recreated on first render
     st->streaming_controller_.reset();
     st->gcode_file.reset();
-    st->layer_renderer_2d_.reset(); // Will be recreated on first render
 
     // =========================================================================
     // PHASE 0: Streaming Mode Detection (Phase 6)
@@ -1105,7 +1228,29 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
         // Launch async index building with completion callback
         // The callback runs on the background thread, so we use lv_async_call to marshal to UI
         std::string path_copy = file_path;
-        st->streaming_controller_->open_file_async(path_copy, [obj, path_copy, gen](bool success) {
+        auto on_first_layers = [obj, gen]() {
+            // Marshal to UI thread: draw the first layers while the rest is indexed
+            struct FirstLayers {};
+            helix::ui::queue_update<FirstLayers>(
+                obj, std::make_unique<FirstLayers>(), [gen](lv_obj_t* obj, FirstLayers*) {
+                    gcode_viewer_state_t* st = get_state(obj);
+                    if (!st || st->load_generation() != gen ||
+                        st->viewer_state != GcodeViewerState::Loading ||
+                        !st->streaming_controller_ || !st->streaming_controller_->is_open()) {
+                        return;
+                    }
+
+                    clear_loading_ui(st);
+                    init_streaming_2d_renderer(obj, st);
+                    st->progressive_preview_ = true;
+                    st->first_render = false;
+                    lv_obj_invalidate(obj);
+                    spdlog::info("[GCode Viewer] Streaming mode: showing first {} layers "
+                                 "while indexing",
+                                 st->streaming_controller_->get_layer_count());
+                });
+        };
+        auto on_complete = [obj, path_copy, gen](bool success) {
             // Marshal completion to UI thread
             struct StreamingResult {
                 bool success;
@@ -1143,43 +1288,12 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                     spdlog::info("[GCode Viewer] Streaming mode: indexed {} layers",
                                  st->streaming_controller_->get_layer_count());
 
-                    // Initialize 2D renderer with streaming controller
-                    st->layer_renderer_2d_ = std::make_unique<helix::gcode::GCodeLayerRenderer>();
-                    st->layer_renderer_2d_->set_streaming_controller(
-                        st->streaming_controller_.get());
-
-                    // Apply color: external override (AMS/Spoolman) takes priority
-                    if (st->has_external_color_override) {
-                        st->layer_renderer_2d_->set_extrusion_color(st->external_color_override);
-                        spdlog::info("[GCode Viewer] Streaming 2D using external color override");
-                    } else {
-                        const auto& stats = st->streaming_controller_->get_index_stats();
-                        if (!stats.filament_color.empty()) {
-                            lv_color_t color = lv_color_hex(
-                                std::strtol(stats.filament_color.c_str() + 1, nullptr, 16));
-                            st->layer_renderer_2d_->set_extrusion_color(color);
-                            spdlog::info("[GCode Viewer] Using filament color from metadata: {}",
-                                         stats.filament_color);
-                        }
-                    }
-
-                    // Get canvas size from widget
-                    lv_area_t coords;
-                    lv_obj_get_coords(obj, &coords);
-                    int width = lv_area_get_width(&coords);
-                    int height = lv_area_get_height(&coords);
-                    st->layer_renderer_2d_->set_canvas_size(width, height);
-                    st->layer_renderer_2d_->auto_fit();
-
-                    // Apply any stored content offset
-                    if (st->content_offset_y_percent_ != 0.0f) {
-                        st->layer_renderer_2d_->set_content_offset_y(st->content_offset_y_percent_);
-                        spdlog::debug("[GCode Viewer] Applied stored content offset: {}%",
-                                      st->content_offset_y_percent_ * 100);
-                    }
+                    // (Re)create the 2D renderer: a preview covered only the first layers
+                    init_streaming_2d_renderer(obj, st);
 
                     st->viewer_state = GcodeViewerState::Loaded;
                     st->first_render = false;
+                    st->progressive_preview_ = false;
 
                     // Trigger initial render
                     lv_obj_invalidate(obj);
@@ -1191,6 +1305,8 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                 } else {
                     spdlog::error("[GCode Viewer] Streaming mode: failed to index {}", r->path);
                     st->viewer_state = GcodeViewerState::Error;
+                    st->progressive_preview_ = false;
+                    st->layer_renderer_2d_.reset(); // May point at the controller
                     st->streaming_controller_.reset();
 
                     if (st->load_callback) {
@@ -1198,7 +1314,8 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                     }
                 }
             });
-        });
+        };
+        st->streaming_controller_->open_file_async(path_copy, on_complete, on_first_layers);
 
         return; // Streaming path handles everything asynchronously
     }
@@ -1248,23 +1365,31 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
         auto result = std::make_unique<AsyncBuildResult>();
 
         try {
-            // PHASE 1: Parse G-code file (fast, ~100ms)
-            std::ifstream file(path);
-            if (!file.is_open()) {
+            // PHASE 1: Parse G-code file (layer ranges in parallel when it can be mapped)
+            std::ifstream file;
+            auto parsed = helix::gcode::ParallelGCodeParser().parse_file(path);
+            if (!parsed) {
+                file.open(path, std::ios::binary);
+            }
+            if (!parsed && !file.is_open()) {
                 result->success = false;
                 result->error_msg = "Failed to open file: " + path;
             } else {
-                helix::gcode::GCodeParser parser;
-                std::string line;
+                if (!parsed) {
+                    helix::gcode::GCodeParser parser;
+                    std::vector<char> chunk(64 * 1024);
 
-                while (std::getline(file, line)) {
-                    parser.parse_line(line);
-                }
+                    while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) ||
+                           file.gcount() > 0) {
+                        parser.parse_buffer(chunk.data(), static_cast<size_t>(file.gcount()));
+                    }
 
-                file.close();
+                    file.close();
+                    parsed = parser.finalize();
+                }
 
                 result->gcode_file =
-                    std::make_unique<helix::gcode::ParsedGCodeFile>(parser.finalize());
+                    std::make_unique<helix::gcode::ParsedGCodeFile>(std::move(*parsed));
                 result->gcode_file->filename = path;
 
                 spdlog::debug("[GCode Viewer] Parsed {} layers, {} segments",
@@ -1279,8 +1404,8 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                     size_t available_kb = budget_mgr.read_system_available_kb();
                     size_t budget = budget_mgr.calculate_budget(available_kb);
 
-                    auto budget_config =
-                        budget_mgr.select_tier(result->gcode_file->total_segments, budget);
+                    auto budget_config = budget_mgr.select_tier(
+                        result->gcode_file->total_segments, budget, kMin3DGeometryTier);
 
                     spdlog::info("[GCode Viewer] Memory: {}MB available, {}MB budget, "
                                  "{} segments -> tier {}",
@@ -1309,6 +1434,33 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                             helix::gcode::GeometryBuilder builder;
                             configure_builder(builder);
 
+                            // Show the lower layers while the rest builds. Each batch is a
+                            // copy of them, so skip this when memory is tight (tier 3).
+                            if (budget_config.tier <= 2) {
+                                builder.set_batch_callback(
+                                    [&](std::unique_ptr<helix::gcode::RibbonGeometry> partial,
+                                        size_t layers_built) {
+                                        if (st->is_cancelled()) {
+                                            return;
+                                        }
+#ifdef ENABLE_GLES_3D
+                                        partial->prepare_interleaved_buffers();
+#endif
+                                        auto batch = std::make_unique<ProgressiveBatch>();
+                                        batch->geometry = std::move(partial);
+                                        batch->layers_built = layers_built;
+                                        batch->bounds = result->gcode_file->global_bounding_box;
+                                        batch->filename = path;
+                                        batch->filament_color_hex =
+                                            result->gcode_file->filament_color_hex;
+                                        helix::ui::queue_update<ProgressiveBatch>(
+                                            obj, std::move(batch),
+                                            [gen](lv_obj_t* obj, ProgressiveBatch* b) {
+                                                apply_progressive_batch(obj, gen, b);
+                                            });
+                                    });
+                            }
+
                             helix::gcode::SimplificationOptions opts{
                                 .tolerance_mm = budget_config.simplification_tolerance,
                                 .min_segment_length_mm = 0.05f,
@@ -1330,10 +1482,12 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                                              result->geometry->extrusion_triangle_count +
                                                  result->geometry->travel_triangle_count,
                                              budget_config.tier);
+#ifdef ENABLE_GLES_3D
                                 // Pre-compute interleaved vertex buffers on background thread
                                 // so UI thread only does fast GL upload (no
                                 // dequantization/expansion)
                                 result->geometry->prepare_interleaved_buffers();
+#endif
                             }
                         }
 
@@ -1438,14 +1592,24 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
 
                 // Set pre-built geometry on renderer
 #ifdef ENABLE_3D_RENDERER
-                    if (r->geometry) {
+                    if (r->geometry && st->progressive_preview_) {
+                        // Batches already uploaded the lower layers
+                        st->renderer_->extend_prebuilt_geometry(std::move(r->geometry));
+                    } else if (r->geometry) {
                         st->renderer_->set_prebuilt_geometry(std::move(r->geometry),
                                                              st->gcode_file->filename);
+                    } else if (st->progressive_preview_) {
+                        // Budget fallback after batches were shown: drop the partial model
+                        st->renderer_->set_prebuilt_geometry(nullptr, st->gcode_file->filename);
                     }
 #endif
 
-                    // Fit camera to model bounds
-                    st->camera_->fit_to_bounds(st->gcode_file->global_bounding_box);
+                    // Fit camera to model bounds (already done, and maybe moved, if batches
+                    // were shown)
+                    if (!st->progressive_preview_) {
+                        st->camera_->fit_to_bounds(st->gcode_file->global_bounding_box);
+                    }
+                    st->progressive_preview_ = false;
 
                     // Apply any stored content offset to 3D renderer
                     if (st->content_offset_y_percent_ != 0.0f) {
@@ -1457,18 +1621,7 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
 
                     // Auto-apply filament color from gcode metadata (unless
                     // AMS/Spoolman has already set an external override)
-                    if (st->has_external_color_override) {
-                        st->renderer_->set_extrusion_color(st->external_color_override);
-                        spdlog::debug(
-                            "[GCode Viewer] Applied external color override (AMS/Spoolman)");
-                    } else if (st->use_filament_color &&
-                               st->gcode_file->filament_color_hex.length() >= 2) {
-                        lv_color_t color = lv_color_hex(static_cast<uint32_t>(std::strtol(
-                            st->gcode_file->filament_color_hex.c_str() + 1, nullptr, 16)));
-                        st->renderer_->set_extrusion_color(color);
-                        spdlog::debug("[GCode Viewer] Applied filament color: {}",
-                                      st->gcode_file->filament_color_hex);
-                    }
+                    apply_3d_extrusion_color(st);
 
                     // Clear first_render flag to allow actual rendering on next draw
                     st->first_render = false;
@@ -1486,7 +1639,15 @@ static void ui_gcode_viewer_load_file_async(lv_obj_t* obj, const char* file_path
                 } else {
                     spdlog::error("[GCode Viewer] Async load failed: {}", r->error_msg);
                     st->viewer_state = GcodeViewerState::Error;
+                    // The 2D renderer (and its raster worker) may still read the preview file
+                    st->layer_renderer_2d_.reset();
                     st->gcode_file.reset();
+#ifdef ENABLE_3D_RENDERER
+                    if (st->progressive_preview_) {
+                        st->renderer_->set_prebuilt_geometry(nullptr, "");
+                    }
+#endif
+                    st->progressive_preview_ = false;
 
                     // Invoke load callback with error status if registered
                     if (st->load_callback) {
@@ -1552,12 +1713,13 @@ void ui_gcode_viewer_clear(lv_obj_t* obj) {
     if (!st)
         return;
 
+    st->layer_renderer_2d_.reset();          // Clear 2D renderer before the data it reads
     st->gcode_file.reset();
     st->streaming_controller_.reset();       // Clear streaming controller (Phase 6)
-    st->layer_renderer_2d_.reset();          // Clear 2D renderer to avoid dangling pointer
     st->has_external_color_override = false; // Clear external color override
     st->tool_color_overrides.clear();        // Clear per-tool AMS colors
     st->viewer_state = GcodeViewerState::Empty;
+    st->progressive_preview_ = false;
 
     // Clear cached framebuffer so stale frames aren't blitted on next show
 #ifdef ENABLE_3D_RENDERER
@@ -2102,6 +2264,19 @@ void ui_gcode_viewer_set_print_progress(lv_obj_t* obj, int current_layer) {
     lv_obj_invalidate(obj);
 }
 
+void ui_gcode_viewer_set_print_file_position(lv_obj_t* obj, uint64_t file_position) {
+    gcode_viewer_state_t* st = get_state(obj);
+    if (!st || file_position == st->print_file_position_)
+        return;
+
+    st->print_file_position_ = file_position;
+
+    // Only the 2D renderer draws partial layers; the 3D view would re-render for nothing
+    if (st->is_using_2d_mode() && st->print_progress_layer_ >= 0) {
+        lv_obj_invalidate(obj);
+    }
+}
+
 void ui_gcode_viewer_set_ghost_opacity(lv_obj_t* obj, lv_opa_t opacity) {
     gcode_viewer_state_t* st = get_state(obj);
     if (!st)
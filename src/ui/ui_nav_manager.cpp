@@ -38,7 +38,26 @@ using helix::ui::observe_int_sync;
 // outlives all function-local statics, including the singleton itself.
 namespace {
 bool g_nav_manager_destroyed = false;
+
+// Lifecycle dispatch: also adds/removes the panel's extra status fields
+void activate_lifecycle(IPanelLifecycle* instance) {
+    instance->on_activate();
+
+    auto fields = instance->status_fields();
+    auto* client = get_moonraker_client();
+    if (!fields.empty() && client) {
+        client->status_subscriptions().set_owner_fields(instance, std::move(fields));
+    }
+}
+
+void deactivate_lifecycle(IPanelLifecycle* instance) {
+    instance->on_deactivate();
+
+    if (auto* client = get_moonraker_client()) {
+        client->status_subscriptions().clear_owner(instance);
+    }
 }
+} // namespace
 
 NavigationManager::~NavigationManager() {
     g_nav_manager_destroyed = true;
@@ -160,7 +179,7 @@ void NavigationManager::overlay_slide_out_complete_cb(lv_anim_t* anim) {
         if (mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]) {
             spdlog::trace("[NavigationManager] Activating main panel {} after overlay closed",
                           static_cast<int>(mgr.active_panel_));
-            mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]->on_activate();
+            activate_lifecycle(mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]);
         }
     } else if (mgr.panel_stack_.size() > 1) {
         // Back to previous overlay - activate it
@@ -169,7 +188,7 @@ void NavigationManager::overlay_slide_out_complete_cb(lv_anim_t* anim) {
         if (overlay_it != mgr.overlay_instances_.end() && overlay_it->second) {
             spdlog::trace("[NavigationManager] Activating previous overlay {}",
                           overlay_it->second->get_name());
-            overlay_it->second->on_activate();
+            activate_lifecycle(overlay_it->second);
         }
     }
 }
@@ -251,7 +270,7 @@ void NavigationManager::overlay_animate_slide_out(lv_obj_t* panel) {
             if (mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]) {
                 spdlog::trace("[NavigationManager] Activating main panel {} after overlay closed",
                               static_cast<int>(mgr.active_panel_));
-                mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]->on_activate();
+                activate_lifecycle(mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]);
             }
         } else if (mgr.panel_stack_.size() > 1) {
             lv_obj_t* now_visible = mgr.panel_stack_.back();
@@ -259,7 +278,7 @@ void NavigationManager::overlay_animate_slide_out(lv_obj_t* panel) {
             if (overlay_it != mgr.overlay_instances_.end() && overlay_it->second) {
                 spdlog::trace("[NavigationManager] Activating previous overlay {}",
                               overlay_it->second->get_name());
-                overlay_it->second->on_activate();
+                activate_lifecycle(overlay_it->second);
             }
         }
         return;
@@ -435,13 +454,13 @@ void NavigationManager::overlay_animate_zoom_out(lv_obj_t* panel, lv_area_t sour
         // Lifecycle: Activate what's now visible
         if (panel_stack_.size() == 1) {
             if (panel_instances_[static_cast<int>(active_panel_)]) {
-                panel_instances_[static_cast<int>(active_panel_)]->on_activate();
+                activate_lifecycle(panel_instances_[static_cast<int>(active_panel_)]);
             }
         } else if (panel_stack_.size() > 1) {
             lv_obj_t* now_visible = panel_stack_.back();
             auto overlay_it = overlay_instances_.find(now_visible);
             if (overlay_it != overlay_instances_.end() && overlay_it->second) {
-                overlay_it->second->on_activate();
+                activate_lifecycle(overlay_it->second);
             }
         }
         return;
@@ -744,7 +763,7 @@ void NavigationManager::switch_to_panel_impl(int panel_id) {
         if (inst_it != overlay_instances_.end() && inst_it->second) {
             spdlog::trace("[NavigationManager] Calling on_deactivate() for overlay {} (navbar)",
                           (void*)panel);
-            inst_it->second->on_deactivate();
+            deactivate_lifecycle(inst_it->second);
         }
 
         // Invoke close callback if registered
@@ -967,7 +986,7 @@ void NavigationManager::set_active(PanelId panel_id) {
     if (panel_instances_[static_cast<int>(old_panel)]) {
         spdlog::trace("[NavigationManager] Calling on_deactivate() for panel {}",
                       static_cast<int>(old_panel));
-        panel_instances_[static_cast<int>(old_panel)]->on_deactivate();
+        deactivate_lifecycle(panel_instances_[static_cast<int>(old_panel)]);
     }
 
     // Update state
@@ -978,7 +997,7 @@ void NavigationManager::set_active(PanelId panel_id) {
     if (panel_instances_[static_cast<int>(panel_id)]) {
         spdlog::trace("[NavigationManager] Calling on_activate() for panel {}",
                       static_cast<int>(panel_id));
-        panel_instances_[static_cast<int>(panel_id)]->on_activate();
+        activate_lifecycle(panel_instances_[static_cast<int>(panel_id)]);
     }
 }
 
@@ -1032,7 +1051,7 @@ void NavigationManager::activate_initial_panel() {
     if (panel_instances_[static_cast<int>(active_panel_)]) {
         spdlog::trace("[NavigationManager] Activating initial panel {}",
                       static_cast<int>(active_panel_));
-        panel_instances_[static_cast<int>(active_panel_)]->on_activate();
+        activate_lifecycle(panel_instances_[static_cast<int>(active_panel_)]);
     }
 }
 
@@ -1090,7 +1109,7 @@ void NavigationManager::push_overlay(lv_obj_t* overlay_panel, bool hide_previous
             if (mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]) {
                 spdlog::trace("[NavigationManager] Deactivating main panel {} for overlay",
                               static_cast<int>(mgr.active_panel_));
-                mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]->on_deactivate();
+                deactivate_lifecycle(mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]);
             }
         } else {
             // Deactivate previous overlay if stacking
@@ -1099,7 +1118,7 @@ void NavigationManager::push_overlay(lv_obj_t* overlay_panel, bool hide_previous
             if (it != mgr.overlay_instances_.end() && it->second) {
                 spdlog::trace("[NavigationManager] Deactivating previous overlay {}",
                               it->second->get_name());
-                it->second->on_deactivate();
+                deactivate_lifecycle(it->second);
             }
         }
 
@@ -1135,7 +1154,7 @@ void NavigationManager::push_overlay(lv_obj_t* overlay_panel, bool hide_previous
                          (void*)overlay_panel);
         } else if (it->second) {
             spdlog::trace("[NavigationManager] Activating overlay {}", it->second->get_name());
-            it->second->on_activate();
+            activate_lifecycle(it->second);
         }
 
         SoundManager::instance().play("nav_forward");
@@ -1170,13 +1189,13 @@ void NavigationManager::push_overlay_zoom_from(lv_obj_t* overlay_panel, lv_area_
         // Lifecycle: Deactivate what's currently visible
         if (is_first_overlay) {
             if (mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]) {
-                mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]->on_deactivate();
+                deactivate_lifecycle(mgr.panel_instances_[static_cast<int>(mgr.active_panel_)]);
             }
         } else {
             lv_obj_t* prev_overlay = mgr.panel_stack_.back();
             auto it = mgr.overlay_instances_.find(prev_overlay);
             if (it != mgr.overlay_instances_.end() && it->second) {
-                it->second->on_deactivate();
+                deactivate_lifecycle(it->second);
             }
         }
 
@@ -1217,7 +1236,7 @@ void NavigationManager::push_overlay_zoom_from(lv_obj_t* overlay_panel, lv_area_
             spdlog::warn("[NavigationManager] Overlay {} pushed without lifecycle registration",
                          (void*)overlay_panel);
         } else if (it->second) {
-            it->second->on_activate();
+            activate_lifecycle(it->second);
         }
 
         SoundManager::instance().play("nav_forward");
@@ -1283,7 +1302,7 @@ bool NavigationManager::go_back() {
             if (it != mgr.overlay_instances_.end() && it->second) {
                 spdlog::trace("[NavigationManager] Deactivating closing overlay {}",
                               it->second->get_name());
-                it->second->on_deactivate();
+                deactivate_lifecycle(it->second);
             }
         }
 
@@ -283,6 +283,11 @@ lv_obj_t* BedMeshPanel::create(lv_obj_t* parent) {
     ui_bed_mesh_set_zero_plane_visible(canvas_, show_zero_plane);
     spdlog::debug("[{}] Zero plane visibility set from settings: {}", get_name(), show_zero_plane);
 
+    // Apply surface upsampling from settings
+    int upsample = DisplaySettingsManager::instance().get_bed_mesh_upsample_factor();
+    ui_bed_mesh_set_upsample_factor(canvas_, upsample);
+    spdlog::debug("[{}] Surface upsample factor set from settings: {}", get_name(), upsample);
+
     // Evaluate render mode based on FPS history from previous sessions
     // This decides whether to use 3D or 2D fallback mode for AUTO mode
     ui_bed_mesh_evaluate_render_mode(canvas_);
@@ -508,11 +513,12 @@ void BedMeshPanel::setup_moonraker_subscription() {
     auto alive = alive_; // Capture shared_ptr by value for destruction detection [L012]
 
     SubscriptionId id =
-        api->subscribe_notifications([this, api, alive](nlohmann::json notification) {
+        api->subscribe_notifications_shared([this, api, alive](const SharedJson& shared) {
             // Check destruction flag FIRST - panel may have been deleted
             if (!alive->load()) {
                 return;
             }
+            const nlohmann::json& notification = *shared;
 
             // Check if this notification contains bed_mesh data BEFORE deferring to main thread
             // This avoids unnecessary context switches for unrelated notifications
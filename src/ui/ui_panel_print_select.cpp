@@ -783,6 +783,34 @@ void PrintSelectPanel::refresh_files() {
     file_provider_->refresh_files(current_path_, file_list_);
 }
 
+void PrintSelectPanel::cancel_offscreen_thumbnails(size_t start, size_t end) {
+    if (!api_ || pending_card_thumbnails_.empty()) {
+        return;
+    }
+
+    size_t cancelled = 0;
+    for (auto it = pending_card_thumbnails_.begin(); it != pending_card_thumbnails_.end();) {
+        size_t index = it->first;
+        if (index >= start && index < end) {
+            ++it;
+            continue;
+        }
+
+        if (api_->transfers().cancel_thumbnail(it->second.cancel_key)) {
+            cancelled++;
+            // Refetch metadata (and with it the thumbnail) when the card comes back
+            if (index < file_list_.size() && file_list_[index].filename == it->second.filename) {
+                file_list_[index].metadata_fetched = false;
+            }
+        }
+        it = pending_card_thumbnails_.erase(it);
+    }
+
+    if (cancelled > 0) {
+        spdlog::trace("[{}] Cancelled {} off-screen thumbnail download(s)", get_name(), cancelled);
+    }
+}
+
 void PrintSelectPanel::fetch_metadata_range(size_t start, size_t end) {
     if (!api_) {
         return;
@@ -792,6 +820,8 @@ void PrintSelectPanel::fetch_metadata_range(size_t start, size_t end) {
     start = std::min(start, file_list_.size());
     end = std::min(end, file_list_.size());
 
+    cancel_offscreen_thumbnails(start, end);
+
     if (start >= end) {
         return;
     }
@@ -1057,7 +1087,11 @@ void PrintSelectPanel::process_metadata_result(size_t i, const std::string& file
                     ctx.alive = self->alive_;
                     ctx.generation = &self->nav_generation_;
                     ctx.captured_gen = self->nav_generation_.load();
+                    // Scoped to this panel so scrolling never cancels another
+                    // requester's download of the same thumbnail
+                    ctx.cancel_key = "print_select:" + d->thumb_path;
 
+                    self->pending_card_thumbnails_[file_idx] = {filename_copy, ctx.cancel_key};
                     get_thumbnail_cache().fetch_for_card_view(
                         self->api_, d->thumb_path, ctx,
                         // Success callback - receives pre-scaled .bin path
@@ -1072,6 +1106,7 @@ void PrintSelectPanel::process_metadata_result(size_t i, const std::string& file
                                 std::make_unique<ThumbUpdate>(
                                     ThumbUpdate{self, file_idx, filename_copy, lvgl_path}),
                                 [](ThumbUpdate* t) {
+                                    t->panel->pending_card_thumbnails_.erase(t->index);
                                     if (t->index < t->panel->file_list_.size() &&
                                         t->panel->file_list_[t->index].filename == t->filename) {
                                         t->panel->file_list_[t->index].thumbnail_path =
@@ -1391,6 +1426,7 @@ void PrintSelectPanel::navigate_to_directory(const std::string& dirname) {
     uint32_t gen = ++nav_generation_;
     spdlog::debug("[{}] Navigation generation incremented to {} (entering {})", get_name(), gen,
                   dirname);
+    cancel_offscreen_thumbnails(0, 0);
 
     path_navigator_.navigate_to(dirname);
     current_path_ = path_navigator_.current_path();
@@ -1408,6 +1444,7 @@ void PrintSelectPanel::navigate_up() {
     // Increment generation counter to invalidate in-flight metadata callbacks
     uint32_t gen = ++nav_generation_;
     spdlog::debug("[{}] Navigation generation incremented to {} (going up)", get_name(), gen);
+    cancel_offscreen_thumbnails(0, 0);
 
     path_navigator_.navigate_up();
     current_path_ = path_navigator_.current_path();
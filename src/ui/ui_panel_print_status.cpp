@@ -122,6 +122,11 @@ PrintStatusPanel::PrintStatusPanel(PrinterState& printer_state, MoonrakerAPI* ap
     print_layer_observer_ = observe_int_sync<PrintStatusPanel>(
         printer_state_.get_print_layer_current_subject(), this,
         [](PrintStatusPanel* self, int layer) { self->on_print_layer_changed(layer); });
+    print_file_position_observer_ = observe_int_sync<PrintStatusPanel>(
+        printer_state_.get_print_file_position_version_subject(), this,
+        [](PrintStatusPanel* self, int /*version*/) {
+            self->on_print_file_position_changed(self->printer_state_.get_print_file_position());
+        });
 
     // Subscribe to wall-clock elapsed time (total_duration includes prep time)
     print_duration_observer_ = observe_int_sync<PrintStatusPanel>(
@@ -742,11 +747,14 @@ void PrintStatusPanel::load_gcode_file(const char* file_path) {
             struct ViewerProgressCtx {
                 lv_obj_t* viewer;
                 int layer;
+                uint64_t file_position;
             };
-            auto ctx = std::make_unique<ViewerProgressCtx>(ViewerProgressCtx{viewer, viewer_layer});
+            auto ctx = std::make_unique<ViewerProgressCtx>(ViewerProgressCtx{
+                viewer, viewer_layer, self->printer_state_.get_print_file_position()});
             helix::ui::queue_update<ViewerProgressCtx>(std::move(ctx), [](ViewerProgressCtx* c) {
                 if (c->viewer && lv_obj_is_valid(c->viewer)) {
                     ui_gcode_viewer_set_print_progress(c->viewer, c->layer);
+                    ui_gcode_viewer_set_print_file_position(c->viewer, c->file_position);
                 }
             });
 
@@ -1497,6 +1505,25 @@ void PrintStatusPanel::on_print_layer_changed(int current_layer) {
     }
 }
 
+void PrintStatusPanel::on_print_file_position_changed(uint64_t file_position) {
+    // The viewer draws the current layer only as far as the print has read
+    if (!gcode_viewer_ || lv_obj_has_flag(gcode_viewer_, LV_OBJ_FLAG_HIDDEN)) {
+        return;
+    }
+
+    // CRITICAL: Defer to avoid lv_obj_invalidate() during render phase
+    struct ViewerPositionCtx {
+        lv_obj_t* viewer;
+        uint64_t file_position;
+    };
+    auto ctx = std::make_unique<ViewerPositionCtx>(ViewerPositionCtx{gcode_viewer_, file_position});
+    helix::ui::queue_update<ViewerPositionCtx>(std::move(ctx), [](ViewerPositionCtx* c) {
+        if (c->viewer && lv_obj_is_valid(c->viewer)) {
+            ui_gcode_viewer_set_print_file_position(c->viewer, c->file_position);
+        }
+    });
+}
+
 void PrintStatusPanel::on_print_duration_changed(int seconds) {
     // Get outcome from PrinterState and delegate guard + state update to lifecycle
     auto outcome =
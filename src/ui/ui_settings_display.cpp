@@ -279,15 +279,13 @@ void DisplaySettingsOverlay::init_gcode_dropdown() {
     if (!gcode_row)
         return;
 
-        // The row's parent container is hidden by default in XML.
-        // Show it only when 3D rendering is compiled in.
-#ifdef ENABLE_GLES_3D
+    // The row's parent container is hidden by default in XML. Every build has a
+    // 3D renderer now (GLES, or the CPU rasterizer without it), so always show it.
     lv_obj_t* container = lv_obj_get_parent(gcode_row);
     if (container) {
         lv_obj_remove_flag(container, LV_OBJ_FLAG_HIDDEN);
         lv_obj_set_height(container, LV_SIZE_CONTENT);
     }
-#endif
 
     lv_obj_t* gcode_dropdown = lv_obj_find_by_name(gcode_row, "dropdown");
     if (gcode_dropdown) {
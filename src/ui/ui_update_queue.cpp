@@ -0,0 +1,123 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ui_update_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace helix::ui {
+
+namespace {
+
+// Without an eventfd, wake() cannot interrupt the sleep; keep it short
+constexpr uint32_t FALLBACK_SLEEP_MS = 5;
+
+} // namespace
+
+UpdateQueue::UpdateQueue()
+    : latest_([this](SmallCallback drain) { queue(std::move(drain)); }) {
+#ifdef __linux__
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        spdlog::warn("[UpdateQueue] eventfd unavailable, main loop falls back to polling");
+    }
+#endif
+}
+
+UpdateQueue::~UpdateQueue() {
+    shutdown();
+#ifdef __linux__
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+    }
+#endif
+}
+
+void UpdateQueue::init() {
+    if (initialized_)
+        return;
+
+    if (shut_down_.load(std::memory_order_acquire)) {
+        pending_.discard(); // Late enqueues that raced the previous shutdown()
+        latest_.discard();  // ...and keys whose drain was dropped while shut down
+    }
+    shut_down_.store(false, std::memory_order_release);
+
+    // Backstop period only: wait_for_work() marks the timer ready when updates arrive.
+    // Created early at init, so it's near the head of the timer list
+    timer_ = lv_timer_create(timer_cb, BACKSTOP_PERIOD_MS, this);
+    if (!timer_) {
+        spdlog::error("[UpdateQueue] Failed to create timer!");
+        return;
+    }
+
+    initialized_ = true;
+    spdlog::debug("[UpdateQueue] Initialized - timer created for queue drain");
+}
+
+void UpdateQueue::wake() {
+    if (wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        return; // Already signalled since the loop last woke
+    }
+#ifdef __linux__
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wake_fd_, &one, sizeof(one));
+    }
+#endif
+}
+
+void UpdateQueue::wait_for_work(uint32_t timeout_ms) {
+    if (!pending_.has_pending() && timeout_ms > 0) {
+#ifdef __linux__
+        if (wake_fd_ >= 0) {
+            struct pollfd pfd = {wake_fd_, POLLIN, 0};
+            poll(&pfd, 1, static_cast<int>(timeout_ms));
+        } else {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(std::min(timeout_ms, FALLBACK_SLEEP_MS)));
+        }
+#else
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(std::min(timeout_ms, FALLBACK_SLEEP_MS)));
+#endif
+    }
+
+    // Consume the signal before re-arming: a producer only writes after flipping
+    // wake_pending_ false -> true, so nothing can be written between these two steps.
+#ifdef __linux__
+    if (wake_fd_ >= 0) {
+        uint64_t count = 0;
+        [[maybe_unused]] ssize_t n = read(wake_fd_, &count, sizeof(count));
+    }
+#endif
+    wake_pending_.store(false, std::memory_order_seq_cst);
+
+    if (timer_ && initialized_ && pending_.has_pending()) {
+        lv_timer_ready(timer_);
+    }
+}
+
+void UpdateQueue::process_pending() {
+    // Execute the updates pending at entry - safe because render hasn't started yet.
+    // Updates queued by these callbacks run on the next drain.
+    pending_.pop_batch([](SmallCallback& callback) {
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            spdlog::error("[UpdateQueue] Exception in queued callback: {}", e.what());
+        } catch (...) {
+            spdlog::error("[UpdateQueue] Unknown exception in queued callback");
+        }
+    });
+}
+
+} // namespace helix::ui
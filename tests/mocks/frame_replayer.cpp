@@ -0,0 +1,94 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "frame_replayer.h"
+
+#include "mock_websocket_server.h"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <string_view>
+#include <thread>
+
+using helix::LoggedFrame;
+
+bool FrameReplayer::is_notification(const std::string& payload) {
+    // Moonraker writes "method" right after "jsonrpc"; replies lead with "result" or "error"
+    constexpr size_t HEAD_BYTES = 64;
+    return std::string_view(payload).substr(0, HEAD_BYTES).find("\"method\"") !=
+           std::string_view::npos;
+}
+
+FrameReplayer::Result FrameReplayer::replay_file(const std::string& path,
+                                                 const Options& options) {
+    helix::FrameLogReader reader;
+    if (!reader.open(path)) {
+        return {};
+    }
+    return run([&reader](LoggedFrame& frame) { return reader.next(frame); }, options);
+}
+
+FrameReplayer::Result FrameReplayer::replay(const std::vector<LoggedFrame>& frames,
+                                            const Options& options) {
+    size_t index = 0;
+    return run(
+        [&](LoggedFrame& frame) {
+            if (index >= frames.size()) {
+                return false;
+            }
+            frame = frames[index++];
+            return true;
+        },
+        options);
+}
+
+FrameReplayer::Result FrameReplayer::run(const std::function<bool(LoggedFrame&)>& next,
+                                         const Options& options) {
+    using Clock = std::chrono::steady_clock;
+    auto running = [&options]() {
+        return !options.keep_running || options.keep_running->load();
+    };
+
+    Result result;
+    auto start = Clock::now();
+    bool first = true;
+    uint64_t first_us = 0;
+    uint64_t consumed_base = options.frames_consumed ? options.frames_consumed() : 0;
+    LoggedFrame frame;
+
+    while (running() && next(frame)) {
+        if (options.notifications_only && !is_notification(frame.payload)) {
+            result.frames_skipped++;
+            continue;
+        }
+
+        if (first) {
+            first_us = frame.time_us;
+            first = false;
+        }
+        if (options.speed > 0.0) {
+            auto offset = std::chrono::duration<double, std::micro>(
+                static_cast<double>(frame.time_us - first_us) / options.speed);
+            std::this_thread::sleep_until(
+                start + std::chrono::duration_cast<Clock::duration>(offset));
+        }
+        if (options.frames_consumed) {
+            while (running() &&
+                   result.frames_sent > options.frames_consumed() - consumed_base +
+                                            options.max_ahead) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        server_.send_raw(frame.payload);
+        result.frames_sent++;
+        result.bytes_sent += frame.payload.size();
+    }
+
+    result.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    spdlog::debug("[FrameReplayer] Sent {} frames ({} bytes, {} skipped) in {:.2f}s",
+                  result.frames_sent, result.bytes_sent, result.frames_skipped,
+                  result.elapsed_s);
+    return result;
+}
@@ -0,0 +1,84 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FRAME_REPLAYER_H
+#define FRAME_REPLAYER_H
+
+/**
+ * @file frame_replayer.h
+ * @brief Plays recorded Moonraker traffic back through MockWebSocketServer
+ *
+ * Frames come from a log written by MoonrakerClient (HELIX_RECORD_FRAMES) or
+ * from a list built in the test. Replies to requests are skipped by default:
+ * the replaying client never sent those requests, so only notifications
+ * (frames carrying a "method") are meaningful.
+ *
+ * @example
+ * MockWebSocketServer server;
+ * server.start();
+ * client.connect(server.url().c_str(), ...);
+ *
+ * FrameReplayer replayer(server);
+ * FrameReplayer::Options options;
+ * options.speed = 10.0;
+ * auto result = replayer.replay_file("/tmp/print.hxframes", options);
+ */
+
+#include "moonraker_frame_log.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class MockWebSocketServer;
+
+class FrameReplayer {
+  public:
+    struct Options {
+        /// Playback rate relative to the recording (1 = real time, 0 = as fast as possible)
+        double speed = 1.0;
+
+        /// Skip JSON-RPC replies, sending only notifications
+        bool notifications_only = true;
+
+        /**
+         * @brief Frames the client has taken so far (optional)
+         *
+         * With a probe, the replayer stays at most max_ahead frames in front of
+         * the client instead of filling the socket buffers at max speed.
+         */
+        std::function<uint64_t()> frames_consumed;
+        uint64_t max_ahead = 64;
+
+        /// Stops the replay early when cleared (optional)
+        const std::atomic<bool>* keep_running = nullptr;
+    };
+
+    struct Result {
+        uint64_t frames_sent = 0;
+        uint64_t frames_skipped = 0;
+        uint64_t bytes_sent = 0;
+        double elapsed_s = 0.0;
+    };
+
+    explicit FrameReplayer(MockWebSocketServer& server) : server_(server) {}
+
+    /// Replay a frame log; an unreadable log sends nothing
+    Result replay_file(const std::string& path, const Options& options);
+
+    /// Replay frames already in memory
+    Result replay(const std::vector<helix::LoggedFrame>& frames, const Options& options);
+
+    /// True for notifications ({"jsonrpc": "2.0", "method": ...}), false for replies
+    static bool is_notification(const std::string& payload);
+
+  private:
+    /// Next-frame source shared by both entry points
+    Result run(const std::function<bool(helix::LoggedFrame&)>& next, const Options& options);
+
+    MockWebSocketServer& server_;
+};
+
+#endif // FRAME_REPLAYER_H
@@ -0,0 +1,173 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mock_http_server.h"
+
+#include "hv/hurl.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+
+namespace {
+constexpr const char* kFilesPrefix = "/server/files/";
+} // namespace
+
+MockHttpServer::MockHttpServer()
+    : service_(std::make_unique<hv::HttpService>()),
+      server_(std::make_unique<hv::HttpServer>(service_.get())) {
+    service_->GET("/server/files/*",
+                  [this](HttpRequest* req, HttpResponse* resp) { return handle_file(req, resp); });
+    // Several server threads so concurrent client connections are served in parallel
+    server_->setThreadNum(4);
+}
+
+MockHttpServer::~MockHttpServer() {
+    stop();
+}
+
+int MockHttpServer::start(int port) {
+    if (running_.load()) {
+        spdlog::warn("[MockHTTP] Server already running");
+        return port_.load();
+    }
+
+    server_->port = port;
+    if (server_->start() != 0) {
+        spdlog::error("[MockHTTP] Failed to start server");
+        return -1;
+    }
+    running_.store(true);
+
+    // Ephemeral port: libhv's start() is async, wait for the listen socket
+    int actual_port = server_->port;
+    if (actual_port == 0) {
+        for (int i = 0; i < 100 && server_->listenfd[0] < 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (server_->listenfd[0] >= 0) {
+            struct sockaddr_in addr;
+            socklen_t addr_len = sizeof(addr);
+            if (getsockname(server_->listenfd[0], (struct sockaddr*)&addr, &addr_len) == 0) {
+                actual_port = ntohs(addr.sin_port);
+            }
+        }
+    }
+
+    port_.store(actual_port);
+    spdlog::info("[MockHTTP] Server started on port {}", actual_port);
+    return actual_port;
+}
+
+void MockHttpServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    server_->stop();
+    spdlog::info("[MockHTTP] Server stopped");
+}
+
+std::string MockHttpServer::base_url() const {
+    return "http://127.0.0.1:" + std::to_string(port_.load());
+}
+
+void MockHttpServer::add_file(const std::string& path, const std::string& content) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_[path] = content;
+}
+
+size_t MockHttpServer::connection_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connections_.size();
+}
+
+std::vector<std::string> MockHttpServer::requested_paths() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requested_paths_;
+}
+
+std::string MockHttpServer::last_range() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_range_;
+}
+
+void MockHttpServer::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connections_.clear();
+    requested_paths_.clear();
+    last_range_.clear();
+    request_count_.store(0);
+}
+
+int MockHttpServer::handle_file(HttpRequest* req, HttpResponse* resp) {
+    request_count_++;
+    std::string path = HUrl::unescape(req->Path()).substr(std::string(kFilesPrefix).size());
+    std::string range = req->GetHeader("Range");
+
+    // /server/files/metadata?filename=... reports the size of a G-code file
+    bool metadata = path == "metadata";
+    if (metadata) {
+        path = "gcodes/" + req->GetParam("filename");
+    }
+
+    std::string content;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections_.insert(req->client_addr.ip + ":" + std::to_string(req->client_addr.port));
+        requested_paths_.push_back(path);
+        last_range_ = range;
+        auto it = files_.find(path);
+        if (it != files_.end()) {
+            content = it->second;
+            found = true;
+        }
+    }
+
+    if (int delay = response_delay_ms_.load(); delay > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    }
+
+    if (!metadata && fail_requests_.load() > 0 && fail_requests_.fetch_sub(1) > 0) {
+        return 503;
+    }
+
+    if (!found) {
+        return 404;
+    }
+
+    if (metadata) {
+        resp->content_type = APPLICATION_JSON;
+        resp->body = "{\"result\": {\"filename\": \"" + path.substr(7) +
+                     "\", \"size\": " + std::to_string(content.size()) + "}}";
+        return 200;
+    }
+
+    resp->content_type = APPLICATION_OCTET_STREAM;
+
+    // "bytes=first-last" or "bytes=first-"
+    constexpr const char* kBytesPrefix = "bytes=";
+    if (!ignore_range_.load() && range.rfind(kBytesPrefix, 0) == 0) {
+        std::string spec = range.substr(std::string(kBytesPrefix).size());
+        size_t dash = spec.find('-');
+        size_t first = std::stoul(spec.substr(0, dash));
+        size_t last = dash + 1 < spec.size() ? std::stoul(spec.substr(dash + 1))
+                                             : content.size() - 1;
+        if (first >= content.size()) {
+            return 416;
+        }
+        last = std::min(last, content.size() - 1);
+        resp->body = content.substr(first, last - first + 1);
+        resp->SetHeader("Content-Range", "bytes " + std::to_string(first) + "-" +
+                                             std::to_string(last) + "/" +
+                                             std::to_string(content.size()));
+        return 206;
+    }
+
+    resp->body = content;
+    return 200;
+}
@@ -0,0 +1,132 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MOCK_HTTP_SERVER_H
+#define MOCK_HTTP_SERVER_H
+
+/**
+ * @file mock_http_server.h
+ * @brief Local stand-in for Moonraker's /server/files HTTP endpoints
+ *
+ * Serves in-memory files over a real libhv HttpServer so HTTP transfer code
+ * (HttpWorkerPool, MoonrakerFileTransferAPI, MoonrakerDataSource) can be
+ * tested without a printer. Byte ranges and /server/files/metadata sizes are
+ * supported.
+ * Records which client connections requests arrived on, which lets tests check
+ * keep-alive reuse.
+ *
+ * @example
+ * MockHttpServer server;
+ * server.add_file("gcodes/.thumbs/cube.png", png_bytes);
+ * server.start();
+ * std::string base_url = server.base_url(); // "http://127.0.0.1:<port>"
+ */
+
+#include "hv/HttpServer.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class MockHttpServer {
+  public:
+    MockHttpServer();
+    ~MockHttpServer();
+
+    // Non-copyable
+    MockHttpServer(const MockHttpServer&) = delete;
+    MockHttpServer& operator=(const MockHttpServer&) = delete;
+
+    /**
+     * @brief Start the server
+     *
+     * @param port Port to listen on (0 = ephemeral, system assigns)
+     * @return Actual port number on success, -1 on failure
+     */
+    int start(int port = 0);
+
+    /**
+     * @brief Stop the server
+     */
+    void stop();
+
+    /**
+     * @brief Base URL for MoonrakerAPI::set_http_base_url()
+     *
+     * @return URL like "http://127.0.0.1:12345"
+     */
+    std::string base_url() const;
+
+    /**
+     * @brief Serve @p content at /server/files/{path}
+     *
+     * @param path Path including the root, e.g. "gcodes/.thumbs/cube.png"
+     * @param content File body
+     */
+    void add_file(const std::string& path, const std::string& content);
+
+    /**
+     * @brief Set artificial delay before each response
+     *
+     * @param ms Delay in milliseconds (0 = immediate)
+     */
+    void set_response_delay_ms(int ms) {
+        response_delay_ms_.store(ms);
+    }
+
+    /**
+     * @brief Answer the next @p count file requests with 503
+     *
+     * Simulates a dropped or overloaded server; metadata requests are unaffected.
+     */
+    void fail_next_requests(int count) {
+        fail_requests_.store(count);
+    }
+
+    /// Ignore Range headers and always send the whole file with 200
+    void set_ignore_range(bool ignore) {
+        ignore_range_.store(ignore);
+    }
+
+    /// Total requests received
+    int request_count() const {
+        return request_count_.load();
+    }
+
+    /// Distinct client connections (ip:port) that sent at least one request
+    size_t connection_count() const;
+
+    /// Paths requested, in arrival order
+    std::vector<std::string> requested_paths() const;
+
+    /// Last Range header received, empty if none
+    std::string last_range() const;
+
+    /// Reset request statistics (files are kept)
+    void reset_stats();
+
+  private:
+    int handle_file(HttpRequest* req, HttpResponse* resp);
+
+    std::unique_ptr<hv::HttpService> service_;
+    std::unique_ptr<hv::HttpServer> server_;
+
+    std::map<std::string, std::string> files_;
+    std::set<std::string> connections_;
+    std::vector<std::string> requested_paths_;
+    std::string last_range_;
+    mutable std::mutex mutex_;
+
+    std::atomic<int> port_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<int> request_count_{0};
+    std::atomic<int> response_delay_ms_{0};
+    std::atomic<int> fail_requests_{0};
+    std::atomic<bool> ignore_range_{false};
+};
+
+#endif // MOCK_HTTP_SERVER_H
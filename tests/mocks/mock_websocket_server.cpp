@@ -267,6 +267,15 @@ void MockWebSocketServer::send_notification_to(int channel_id, const std::string
     }
 }
 
+void MockWebSocketServer::send_raw(const std::string& msg) {
+    std::lock_guard<std::mutex> lock(channels_mutex_);
+    for (auto& channel : channels_) {
+        if (channel->isConnected()) {
+            channel->send(msg);
+        }
+    }
+}
+
 void MockWebSocketServer::disconnect_all() {
     std::lock_guard<std::mutex> lock(channels_mutex_);
     for (auto& channel : channels_) {
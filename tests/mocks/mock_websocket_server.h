@@ -172,6 +172,15 @@ class MockWebSocketServer {
      */
     void send_notification_to(int channel_id, const std::string& method, const json& params);
 
+    /**
+     * @brief Send a frame verbatim to all connected clients
+     *
+     * Used by FrameReplayer to play back recorded traffic.
+     *
+     * @param msg Frame text
+     */
+    void send_raw(const std::string& msg);
+
     /**
      * @brief Disconnect all connected clients
      */
@@ -14,11 +14,8 @@ class UpdateQueueTestAccess {
     /// Drain repeatedly until the queue is fully empty (handles nested queue_update calls)
     static void drain_all(UpdateQueue& q, int max_iterations = 10) {
         for (int i = 0; i < max_iterations; ++i) {
-            {
-                std::lock_guard<std::mutex> lock(q.mutex_);
-                if (q.pending_.empty())
-                    return;
-            }
+            if (!q.pending_.has_pending())
+                return;
             q.process_pending();
         }
     }
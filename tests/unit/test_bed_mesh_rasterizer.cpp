@@ -0,0 +1,178 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "bed_mesh_rasterizer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::mesh;
+
+namespace {
+
+constexpr int W = 64;
+constexpr int H = 48;
+constexpr uint32_t SENTINEL = 0x12345678;
+
+/// ARGB8888 target with a little padding per row, as lv_draw_buf strides have
+struct TestBuffer {
+    static constexpr int STRIDE_PX = W + 4;
+    std::vector<uint32_t> pixels = std::vector<uint32_t>(STRIDE_PX * H, SENTINEL);
+
+    uint8_t* data() {
+        return reinterpret_cast<uint8_t*>(pixels.data());
+    }
+    uint32_t at(int x, int y) const {
+        return pixels[static_cast<size_t>(y) * STRIDE_PX + x];
+    }
+};
+
+void begin(SpanRasterizer& raster, TestBuffer& buf, lv_area_t clip = {0, 0, W - 1, H - 1}) {
+    raster.begin(buf.data(), W, H, TestBuffer::STRIDE_PX * 4, clip);
+}
+
+RasterVertex vertex(int x, int y, uint16_t depth, uint32_t rgb) {
+    return {x, y, depth, lv_color_hex(rgb)};
+}
+
+/// Quad [x0, x1) x [y0, y1) as two triangles split along a diagonal
+void fill_quad(SpanRasterizer& raster, int x0, int y0, int x1, int y1, uint16_t depth,
+               uint32_t rgb, lv_opa_t opacity = LV_OPA_COVER) {
+    RasterVertex tl = vertex(x0, y0, depth, rgb);
+    RasterVertex tr = vertex(x1, y0, depth, rgb);
+    RasterVertex bl = vertex(x0, y1, depth, rgb);
+    RasterVertex br = vertex(x1, y1, depth, rgb);
+    raster.fill_triangle(bl, br, tl, opacity);
+    raster.fill_triangle(br, tr, tl, opacity);
+}
+
+uint32_t alpha(uint32_t argb) {
+    return argb >> 24;
+}
+
+int channel(uint32_t argb, int shift) {
+    return static_cast<int>((argb >> shift) & 0xFF);
+}
+
+} // namespace
+
+TEST_CASE("Bed Mesh Rasterizer: shared edges are drawn exactly once", "[bed_mesh][rasterizer]") {
+    SpanRasterizer raster;
+    TestBuffer buf;
+    begin(raster, buf);
+
+    // Translucent: any pixel drawn twice would blend to a higher alpha
+    fill_quad(raster, 10, 5, 50, 37, 100, 0x00FF00, LV_OPA_50);
+    REQUIRE(raster.pixels_drawn() == 40 * 32);
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            INFO("pixel " << x << "," << y);
+            bool inside = x >= 10 && x < 50 && y >= 5 && y < 37;
+            REQUIRE(alpha(buf.at(x, y)) == (inside ? uint32_t{LV_OPA_50} : 0u));
+        }
+    }
+
+    SECTION("Neighbouring quads tile without gaps or overlap") {
+        begin(raster, buf);
+        fill_quad(raster, 0, 0, 20, 20, 100, 0xFF0000, LV_OPA_50);
+        fill_quad(raster, 20, 0, 40, 20, 100, 0xFF0000, LV_OPA_50);
+        fill_quad(raster, 0, 20, 20, 40, 100, 0xFF0000, LV_OPA_50);
+        REQUIRE(raster.pixels_drawn() == 3 * 400);
+    }
+}
+
+TEST_CASE("Bed Mesh Rasterizer: depth test is order independent", "[bed_mesh][rasterizer]") {
+    SpanRasterizer raster;
+    TestBuffer near_first;
+    TestBuffer far_first;
+
+    begin(raster, near_first);
+    fill_quad(raster, 0, 0, 30, 30, 1000, 0x0000FF);
+    fill_quad(raster, 15, 15, 45, 45, 5000, 0xFF0000);
+
+    begin(raster, far_first);
+    fill_quad(raster, 15, 15, 45, 45, 5000, 0xFF0000);
+    fill_quad(raster, 0, 0, 30, 30, 1000, 0x0000FF);
+
+    REQUIRE(near_first.pixels == far_first.pixels);
+    REQUIRE(near_first.at(20, 20) == 0xFF0000FF); // Near (blue) wins the overlap
+    REQUIRE(near_first.at(40, 40) == 0xFFFF0000);
+    REQUIRE(near_first.at(50, 5) == 0); // Cleared to transparent
+
+    SECTION("Translucent geometry behind opaque is hidden") {
+        begin(raster, near_first);
+        fill_quad(raster, 0, 0, 30, 30, 1000, 0x0000FF);
+        fill_quad(raster, 10, 10, 40, 40, 3000, 0xFFFFFF, LV_OPA_20);
+        REQUIRE(near_first.at(20, 20) == 0xFF0000FF);
+        REQUIRE(alpha(near_first.at(35, 35)) == LV_OPA_20);
+    }
+
+    SECTION("Translucent geometry in front blends") {
+        begin(raster, near_first);
+        fill_quad(raster, 0, 0, 30, 30, 3000, 0x000000);
+        fill_quad(raster, 10, 10, 40, 40, 1000, 0xFFFFFF, LV_OPA_50);
+        uint32_t blended = near_first.at(20, 20);
+        REQUIRE(alpha(blended) == 0xFF);
+        REQUIRE(std::abs(channel(blended, 16) - 127) <= 1);
+    }
+}
+
+TEST_CASE("Bed Mesh Rasterizer: Gouraud shading", "[bed_mesh][rasterizer]") {
+    SpanRasterizer raster;
+    TestBuffer buf;
+    begin(raster, buf);
+
+    // Red ramps 0 -> 255 left to right, constant down each column
+    RasterVertex tl = vertex(0, 0, 0, 0x000000);
+    RasterVertex tr = vertex(60, 0, 0, 0xFF0000);
+    RasterVertex bl = vertex(0, 40, 0, 0x000000);
+    RasterVertex br = vertex(60, 40, 0, 0xFF0000);
+    raster.fill_triangle(bl, br, tl);
+    raster.fill_triangle(br, tr, tl);
+
+    for (int y : {0, 17, 39}) {
+        for (int x : {0, 15, 30, 59}) {
+            INFO("pixel " << x << "," << y);
+            int expected = x * 255 / 60;
+            REQUIRE(std::abs(channel(buf.at(x, y), 16) - expected) <= 1);
+            REQUIRE(channel(buf.at(x, y), 8) == 0);
+        }
+    }
+    // Monotonic along a row, across the diagonal
+    for (int x = 1; x < 60; x++) {
+        REQUIRE(channel(buf.at(x, 20), 16) >= channel(buf.at(x - 1, 20), 16));
+    }
+}
+
+TEST_CASE("Bed Mesh Rasterizer: clip area", "[bed_mesh][rasterizer]") {
+    SpanRasterizer raster;
+    TestBuffer buf;
+    begin(raster, buf, {8, 10, 40, 19});
+
+    // Vertices far outside the buffer must not write outside the clip area
+    raster.fill_triangle(vertex(-500, -300, 10, 0xFFFFFF), vertex(900, -200, 10, 0xFFFFFF),
+                         vertex(20, 800, 10, 0xFFFFFF));
+
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < TestBuffer::STRIDE_PX; x++) {
+            INFO("pixel " << x << "," << y);
+            bool inside = x >= 8 && x <= 40 && y >= 10 && y <= 19;
+            REQUIRE((buf.at(x, y) == 0xFFFFFFFF) == inside);
+            if (!inside) {
+                REQUIRE(buf.at(x, y) == SENTINEL);
+            }
+        }
+    }
+    REQUIRE(raster.pixels_drawn() == 33 * 10);
+}
+
+TEST_CASE("Bed Mesh Rasterizer: quantize_depth", "[bed_mesh][rasterizer]") {
+    REQUIRE(quantize_depth(10.0, 10.0, 20.0) == 0);
+    REQUIRE(quantize_depth(20.0, 10.0, 20.0) == RASTER_DEPTH_FAR - 1);
+    REQUIRE(quantize_depth(15.0, 10.0, 20.0) > quantize_depth(14.0, 10.0, 20.0));
+    REQUIRE(quantize_depth(99.0, 10.0, 20.0) == RASTER_DEPTH_FAR - 1);
+    REQUIRE(quantize_depth(5.0, 10.0, 10.0) == 0); // Flat scene
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "bed_mesh_projection.h"
+#include "bed_mesh_surface.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::mesh;
+using Catch::Approx;
+
+namespace {
+
+std::vector<std::vector<double>> make_mesh(int rows, int cols, double (*height)(int, int)) {
+    std::vector<std::vector<double>> mesh(static_cast<size_t>(rows));
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            mesh[static_cast<size_t>(r)].push_back(height(r, c));
+        }
+    }
+    return mesh;
+}
+
+bed_mesh_view_state_t make_view(double angle_x, double angle_z) {
+    bed_mesh_view_state_t view{};
+    view.angle_x = angle_x;
+    view.angle_z = angle_z;
+    view.z_scale = 60.0;
+    view.fov_scale = 450.0;
+    view.camera_distance = 300.0;
+    view.cached_cos_x = std::cos(angle_x * M_PI / 180.0);
+    view.cached_sin_x = std::sin(angle_x * M_PI / 180.0);
+    view.cached_cos_z = std::cos(angle_z * M_PI / 180.0);
+    view.cached_sin_z = std::sin(angle_z * M_PI / 180.0);
+    view.trig_cache_valid = true;
+    view.center_offset_x = 7;
+    view.center_offset_y = -12;
+    view.layer_offset_x = 40;
+    view.layer_offset_y = 25;
+    return view;
+}
+
+} // namespace
+
+TEST_CASE("Bed Mesh Surface: bicubic upsampling", "[bed_mesh][surface]") {
+    auto bumpy = make_mesh(4, 5, [](int r, int c) { return 0.1 * std::sin(r * 1.3 + c * 0.7); });
+    int rows = 0;
+    int cols = 0;
+
+    SECTION("Grid size and probe points are kept") {
+        std::vector<float> up = upsample_mesh_bicubic(bumpy, 3, &rows, &cols);
+        REQUIRE(rows == 10);
+        REQUIRE(cols == 13);
+        REQUIRE(up.size() == 130);
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 5; c++) {
+                INFO("probe " << r << "," << c);
+                REQUIRE(up[static_cast<size_t>(r * 3 * cols + c * 3)] ==
+                        Approx(bumpy[r][c]).margin(1e-6));
+            }
+        }
+    }
+
+    SECTION("Planar meshes stay planar, edges included") {
+        auto plane = make_mesh(3, 4, [](int r, int c) { return 0.05 * r - 0.02 * c + 0.3; });
+        std::vector<float> up = upsample_mesh_bicubic(plane, 4, &rows, &cols);
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                double expected = 0.05 * r / 4.0 - 0.02 * c / 4.0 + 0.3;
+                REQUIRE(up[static_cast<size_t>(r * cols + c)] == Approx(expected).margin(1e-6));
+            }
+        }
+    }
+
+    SECTION("Factor 1 is the probe grid; factor is clamped") {
+        std::vector<float> up = upsample_mesh_bicubic(bumpy, 1, &rows, &cols);
+        REQUIRE(rows == 4);
+        REQUIRE(cols == 5);
+        REQUIRE(up[6] == Approx(bumpy[1][1]).margin(1e-6));
+        upsample_mesh_bicubic(bumpy, 100, &rows, &cols);
+        REQUIRE(rows == 3 * SURFACE_MAX_UPSAMPLE + 1);
+    }
+
+    SECTION("Degenerate grids are rejected") {
+        REQUIRE(upsample_mesh_bicubic(make_mesh(1, 5, [](int, int) { return 0.0; }), 3, &rows,
+                                      &cols)
+                    .empty());
+        REQUIRE(rows == 0);
+        auto ragged = bumpy;
+        ragged[2].pop_back();
+        REQUIRE(upsample_mesh_bicubic(ragged, 3, &rows, &cols).empty());
+    }
+}
+
+TEST_CASE("Bed Mesh Surface: projection matches the reference", "[bed_mesh][surface]") {
+    auto mesh = make_mesh(5, 5, [](int r, int c) { return 0.02 * (r - 2) * (c - 1); });
+    MeshSurface surface;
+    surface.set_heights(mesh, 2);
+    REQUIRE_FALSE(surface.is_ready());
+    surface.place(-50.0, 50.0, 40.0, -40.0, 0.0, 60.0, -0.1, 0.1);
+    REQUIRE(surface.is_ready());
+    REQUIRE(surface.vertex_count() == 81);
+
+    for (auto angles : {std::pair{-35.0, 10.0}, std::pair{-80.0, -120.0}, std::pair{0.0, 45.0}}) {
+        bed_mesh_view_state_t view = make_view(angles.first, angles.second);
+        surface.project(view, 480, 320);
+
+        // Probe points: heights are exact there, so world z is known
+        for (int r = 0; r < surface.rows(); r += 2) {
+            for (int c = 0; c < surface.cols(); c += 2) {
+                size_t i = static_cast<size_t>(r * surface.cols() + c);
+                double x = -50.0 + 100.0 * c / (surface.cols() - 1);
+                double y = 40.0 - 80.0 * r / (surface.rows() - 1);
+                double z = mesh[static_cast<size_t>(r / 2)][static_cast<size_t>(c / 2)] * 60.0;
+                bed_mesh_point_3d_t ref =
+                    bed_mesh_projection_project_3d_to_2d(x, y, z, 480, 320, &view);
+                INFO("vertex " << r << "," << c << " view " << angles.first << ","
+                               << angles.second);
+                REQUIRE(std::abs(surface.screen_x()[i] - ref.screen_x) <= 1);
+                REQUIRE(std::abs(surface.screen_y()[i] - ref.screen_y) <= 1);
+                REQUIRE(surface.depths()[i] == Approx(ref.depth).epsilon(1e-4));
+            }
+        }
+    }
+
+    SECTION("Resampling invalidates the placement") {
+        surface.set_heights(mesh, 3);
+        REQUIRE_FALSE(surface.is_ready());
+    }
+}
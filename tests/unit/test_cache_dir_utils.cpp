@@ -0,0 +1,88 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "cache_dir_utils.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Fresh directory, removed afterwards
+class TempDir {
+  public:
+    TempDir() {
+        path_ = fs::temp_directory_path() / ("helix_cache_dir_utils_" + std::to_string(rand()));
+        fs::create_directories(path_);
+    }
+
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path_, ec);
+    }
+
+    /// Write @p size bytes to @p name, last used @p age ago
+    std::string add_file(const std::string& name, size_t size, std::chrono::minutes age) {
+        std::string file = (path_ / name).string();
+        std::ofstream(file, std::ios::binary) << std::string(size, 'x');
+        fs::last_write_time(file, fs::file_time_type::clock::now() - age);
+        return file;
+    }
+
+    std::string str() const {
+        return path_.string();
+    }
+
+  private:
+    fs::path path_;
+};
+
+} // namespace
+
+TEST_CASE("cache_directory_size counts regular files only", "[cache][cache_dir_utils]") {
+    TempDir dir;
+    REQUIRE(cache_directory_size(dir.str()) == 0);
+
+    dir.add_file("a", 100, std::chrono::minutes(1));
+    dir.add_file("b", 250, std::chrono::minutes(2));
+    fs::create_directories(fs::path(dir.str()) / "sub");
+    std::error_code ec;
+    fs::create_symlink(fs::path(dir.str()) / "gone", fs::path(dir.str()) / "dangling", ec);
+    REQUIRE(cache_directory_size(dir.str()) == 350);
+
+    REQUIRE(cache_directory_size(dir.str() + "/missing") == 0);
+    REQUIRE(evict_least_recent_files(dir.str() + "/missing", 0) == 0);
+}
+
+TEST_CASE("evict_least_recent_files removes the oldest files first", "[cache][cache_dir_utils]") {
+    TempDir dir;
+    std::string oldest = dir.add_file("oldest", 100, std::chrono::minutes(30));
+    std::string middle = dir.add_file("middle", 100, std::chrono::minutes(20));
+    std::string newest = dir.add_file("newest", 100, std::chrono::minutes(10));
+
+    SECTION("nothing to do under the limit") {
+        REQUIRE(evict_least_recent_files(dir.str(), 300) == 0);
+        REQUIRE(fs::exists(oldest));
+    }
+
+    SECTION("stops once the directory fits") {
+        REQUIRE(evict_least_recent_files(dir.str(), 200) == 1);
+        REQUIRE_FALSE(fs::exists(oldest));
+        REQUIRE(fs::exists(middle));
+        REQUIRE(fs::exists(newest));
+    }
+
+    SECTION("never removes the kept file") {
+        REQUIRE(evict_least_recent_files(dir.str(), 100, oldest) == 2);
+        REQUIRE(fs::exists(oldest));
+        REQUIRE_FALSE(fs::exists(middle));
+        REQUIRE_FALSE(fs::exists(newest));
+    }
+}
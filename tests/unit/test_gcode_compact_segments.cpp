@@ -0,0 +1,125 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_compact_segments.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+using Catch::Approx;
+
+namespace {
+
+ToolpathSegment make_segment(glm::vec3 start, glm::vec3 end, bool extrusion = true,
+                             const std::string& object = "", int tool = 0) {
+    ToolpathSegment s;
+    s.start = start;
+    s.end = end;
+    s.is_extrusion = extrusion;
+    s.object_name = object;
+    s.tool_index = tool;
+    s.width = 0.42f;
+    s.extrusion_amount = extrusion ? 0.05f : 0.0f;
+    return s;
+}
+
+/// A perimeter-like path: chained moves, a travel, a jump and a long move
+std::vector<ToolpathSegment> make_layer() {
+    std::vector<ToolpathSegment> segs;
+    const float z = 0.6f;
+    glm::vec3 p(100.0f, 100.0f, z);
+    for (int i = 0; i < 40; ++i) {
+        float angle = static_cast<float>(i) * 0.157f;
+        glm::vec3 next(100.0f + 10.0f * std::cos(angle), 100.0f + 10.0f * std::sin(angle), z);
+        segs.push_back(make_segment(p, next, true, "cube_id_0_copy_0"));
+        p = next;
+    }
+    segs.push_back(make_segment(p, {20.0f, 20.0f, z}, false));          // Travel
+    segs.push_back(make_segment({25.0f, 25.0f, z}, {26.0f, 25.0f, z})); // Does not chain
+    // Beyond the int16 grid delta, on another tool and object
+    segs.push_back(make_segment({26.0f, 25.0f, z}, {300.0f, 290.0f, z}, true,
+                                "a_much_longer_name_beyond_sso_buffer", 1));
+    segs.push_back(make_segment({300.0f, 290.0f, z}, {300.0f, 290.0f, z + 0.4f}, false)); // Z hop
+    return segs;
+}
+
+void require_close(const ToolpathSegment& a, const ToolpathSegment& b) {
+    const float tolerance = CompactSegments::XY_QUANTUM_MM / 2 + 1e-4f;
+    REQUIRE(std::abs(a.start.x - b.start.x) <= tolerance);
+    REQUIRE(std::abs(a.start.y - b.start.y) <= tolerance);
+    REQUIRE(std::abs(a.end.x - b.end.x) <= tolerance);
+    REQUIRE(std::abs(a.end.y - b.end.y) <= tolerance);
+    REQUIRE(a.start.z == b.start.z);
+    REQUIRE(a.end.z == b.end.z);
+    REQUIRE(a.is_extrusion == b.is_extrusion);
+    REQUIRE(a.object_name == b.object_name);
+    REQUIRE(a.tool_index == b.tool_index);
+    REQUIRE(a.width == Approx(b.width).margin(0.001));
+    REQUIRE(a.extrusion_amount == b.extrusion_amount);
+}
+
+} // namespace
+
+TEST_CASE("CompactSegments - Round trip", "[gcode][compact]") {
+    auto original = make_layer();
+    CompactSegments packed(original);
+
+    REQUIRE(packed.size() == original.size());
+    REQUIRE_FALSE(packed.empty());
+
+    size_t i = 0;
+    for (const auto& seg : packed) {
+        REQUIRE(i < original.size());
+        require_close(seg, original[i]);
+        ++i;
+    }
+    REQUIRE(i == original.size());
+
+    auto unpacked = packed.to_vector();
+    REQUIRE(unpacked.size() == original.size());
+    require_close(unpacked.back(), original.back());
+}
+
+TEST_CASE("CompactSegments - Interns object names", "[gcode][compact]") {
+    CompactSegments packed(make_layer());
+    const auto& names = packed.object_names();
+    REQUIRE(names.size() == 2);
+    REQUIRE(names[0] == "cube_id_0_copy_0");
+    REQUIRE(names[1] == "a_much_longer_name_beyond_sso_buffer");
+}
+
+TEST_CASE("CompactSegments - Empty and clamped values", "[gcode][compact]") {
+    CompactSegments empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.begin() == empty.end());
+
+    CompactSegments packed;
+    auto seg = make_segment({0, 0, 0}, {1, 1, 0});
+    seg.tool_index = 300;
+    seg.width = 100.0f;
+    packed.push_back(seg);
+    auto out = *packed.begin();
+    REQUIRE(out.tool_index == 255);
+    REQUIRE(out.width == Approx(65.535f));
+}
+
+TEST_CASE("CompactSegments - Uses a fraction of the vector's memory", "[gcode][compact]") {
+    std::vector<ToolpathSegment> layer;
+    glm::vec3 p(50.0f, 50.0f, 0.2f);
+    for (int i = 0; i < 5000; ++i) {
+        glm::vec3 next(50.0f + static_cast<float>(i % 100) * 0.5f,
+                       50.0f + static_cast<float>(i / 100) * 0.5f, 0.2f);
+        layer.push_back(make_segment(p, next, i % 10 != 0, "part_with_a_long_object_name_1"));
+        p = next;
+    }
+    CompactSegments packed(layer);
+
+    size_t vector_bytes = layer.capacity() * sizeof(ToolpathSegment);
+    INFO("vector " << vector_bytes << " bytes, packed " << packed.memory_bytes() << " bytes");
+    REQUIRE(packed.memory_bytes() * 4 < vector_bytes);
+    REQUIRE(packed.memory_bytes() < layer.size() * (CompactSegments::BYTES_PER_SEGMENT + 2));
+}
@@ -3,6 +3,9 @@
 
 #include "gcode_data_source.h"
 
+#include "../mocks/mock_http_server.h"
+
+#include <atomic>
 #include <fstream>
 
 #include "../catch_amalgamated.hpp"
@@ -184,6 +187,35 @@ TEST_CASE("MemoryDataSource from string", "[gcode][datasource]") {
     }
 }
 
+TEST_CASE("MemoryDataSource stream_chunks", "[gcode][datasource]") {
+    MemoryDataSource source(SAMPLE_GCODE);
+    std::atomic<bool> keep_running{true};
+
+    SECTION("delivers every byte in order") {
+        std::string streamed;
+        bool complete = source.stream_chunks(
+            [&](const char* data, size_t size, uint64_t offset) {
+                REQUIRE(offset == streamed.size());
+                streamed.append(data, size);
+                return true;
+            },
+            keep_running);
+        REQUIRE(complete);
+        REQUIRE(streamed == SAMPLE_GCODE);
+    }
+
+    SECTION("stops when the callback declines") {
+        REQUIRE_FALSE(
+            source.stream_chunks([](const char*, size_t, uint64_t) { return false; }, keep_running));
+    }
+
+    SECTION("stops when cancelled") {
+        keep_running = false;
+        REQUIRE_FALSE(
+            source.stream_chunks([](const char*, size_t, uint64_t) { return true; }, keep_running));
+    }
+}
+
 TEST_CASE("MemoryDataSource from vector", "[gcode][datasource]") {
     std::vector<char> bytes = {'H', 'e', 'l', 'l', 'o'};
     MemoryDataSource source(bytes);
@@ -235,3 +267,59 @@ TEST_CASE("MoonrakerDataSource construction", "[gcode][datasource][.network]") {
         REQUIRE_FALSE(source.is_valid());
     }
 }
+
+TEST_CASE("MoonrakerDataSource streams in ranges", "[gcode][datasource][slow]") {
+    std::string gcode;
+    for (int layer = 1; layer <= 200; ++layer) {
+        gcode += "G1 Z" + std::to_string(layer * 0.2) + "\nG1 X10 Y10 E1\nG1 X20 Y20 E2\n";
+    }
+
+    MockHttpServer server;
+    server.add_file("gcodes/part.gcode", gcode);
+    REQUIRE(server.start() > 0);
+
+    MoonrakerDataSource source(server.base_url(), "part.gcode");
+    REQUIRE(source.is_valid());
+    REQUIRE(source.file_size() == gcode.size());
+
+    RangeStreamOptions options;
+    options.chunk_bytes = 1000;
+    options.retry_delay = std::chrono::milliseconds(1);
+    source.set_stream_options(options);
+
+    std::atomic<bool> keep_running{true};
+    std::string streamed;
+    auto collect = [&](const char* data, size_t size, uint64_t offset) {
+        REQUIRE(offset == streamed.size());
+        streamed.append(data, size);
+        return true;
+    };
+
+    SECTION("without a local copy") {
+        server.reset_stats();
+        REQUIRE(source.stream_chunks(collect, keep_running));
+        REQUIRE(streamed == gcode);
+        REQUIRE_FALSE(source.is_using_temp_file());
+        REQUIRE(server.request_count() == static_cast<int>((gcode.size() + 999) / 1000));
+        REQUIRE(server.connection_count() == 1);
+    }
+
+    SECTION("resumes after failed requests") {
+        server.fail_next_requests(3);
+        REQUIRE(source.stream_chunks(collect, keep_running));
+        REQUIRE(streamed == gcode);
+    }
+
+    SECTION("gives up when retries run out") {
+        server.fail_next_requests(options.max_retries + 1);
+        REQUIRE_FALSE(source.stream_chunks(collect, keep_running));
+        REQUIRE(streamed.empty());
+    }
+
+    SECTION("falls back to a temp file if Range is ignored") {
+        server.set_ignore_range(true);
+        REQUIRE(source.stream_chunks(collect, keep_running));
+        REQUIRE(streamed == gcode);
+        REQUIRE(source.is_using_temp_file());
+    }
+}
@@ -959,6 +959,112 @@ TEST_CASE("GeometryBuilder: budget abort returns with flag set", "[gcode][budget
     REQUIRE(builder.was_budget_exceeded());
 }
 
+TEST_CASE("GeometryBuilder: parallel build matches single-threaded build",
+          "[gcode][geometry][parallel]") {
+    // Zig-zag layers with per-tool colors, large enough to split across four threads
+    ParsedGCodeFile gcode;
+    for (int li = 0; li < 20; ++li) {
+        Layer layer;
+        layer.z_height = 0.2f * static_cast<float>(li + 1);
+        for (int i = 0; i < 3000; ++i) {
+            ToolpathSegment seg;
+            float x = static_cast<float>(i) * 0.05f;
+            float y = (i % 2 == 0) ? 0.0f : 1.0f;
+            seg.start = {x, y, layer.z_height};
+            seg.end = {x + 0.05f, (i % 2 == 0) ? 1.0f : 0.0f, layer.z_height};
+            seg.is_extrusion = (i % 100) != 0;
+            seg.width = 0.4f;
+            seg.tool_index = li % 3;
+            layer.segments.push_back(seg);
+        }
+        gcode.layers.push_back(std::move(layer));
+    }
+    gcode.total_segments = 60000;
+    gcode.global_bounding_box.expand({0, 0, 0});
+    gcode.global_bounding_box.expand({150, 1, 4});
+
+    SimplificationOptions opts;
+    auto build_with = [&](unsigned threads) {
+        GeometryBuilder builder;
+        builder.set_budget_tube_sides(4);
+        builder.set_use_height_gradient(true);
+        builder.set_max_threads(threads);
+        return builder.build(gcode, opts);
+    };
+    RibbonGeometry sequential = build_with(1);
+    RibbonGeometry parallel = build_with(4);
+
+    // Palettes are merged in first-seen order, so they match exactly
+    REQUIRE(parallel.color_palette == sequential.color_palette);
+    REQUIRE(parallel.normal_palette.size() == sequential.normal_palette.size());
+    REQUIRE(parallel.tool_palette_map == sequential.tool_palette_map);
+
+    // Every layer starts with a travel, so no vertex sharing is lost at range seams
+    REQUIRE(parallel.vertices.size() == sequential.vertices.size());
+    REQUIRE(parallel.strips == sequential.strips);
+    REQUIRE(parallel.strip_layer_index == sequential.strip_layer_index);
+    REQUIRE(parallel.layer_strip_ranges == sequential.layer_strip_ranges);
+    REQUIRE(parallel.extrusion_triangle_count == sequential.extrusion_triangle_count);
+}
+
+TEST_CASE("GeometryBuilder: progressive build publishes growing lower layers",
+          "[gcode][geometry][progressive]") {
+    ParsedGCodeFile gcode;
+    for (int li = 0; li < 20; ++li) {
+        Layer layer;
+        layer.z_height = 0.2f * static_cast<float>(li + 1);
+        for (int i = 0; i < 1000; ++i) {
+            ToolpathSegment seg;
+            float x = static_cast<float>(i) * 0.05f;
+            seg.start = {x, (i % 2 == 0) ? 0.0f : 1.0f, layer.z_height};
+            seg.end = {x + 0.05f, (i % 2 == 0) ? 1.0f : 0.0f, layer.z_height};
+            seg.is_extrusion = i != 0;
+            seg.width = 0.4f;
+            layer.segments.push_back(seg);
+        }
+        gcode.layers.push_back(std::move(layer));
+    }
+    gcode.total_segments = 20000;
+    gcode.global_bounding_box.expand({0, 0, 0});
+    gcode.global_bounding_box.expand({50, 1, 4});
+
+    std::vector<std::unique_ptr<RibbonGeometry>> batches;
+    std::vector<size_t> layers_built;
+    GeometryBuilder builder;
+    builder.set_budget_tube_sides(4);
+    builder.set_batch_callback(
+        [&](std::unique_ptr<RibbonGeometry> partial, size_t layers) {
+            batches.push_back(std::move(partial));
+            layers_built.push_back(layers);
+        },
+        2000);
+    SimplificationOptions opts;
+    opts.enable_merging = false;
+    RibbonGeometry full = builder.build(gcode, opts);
+
+    // Each wave is about as large as everything before it; the last one is not published
+    REQUIRE(layers_built == std::vector<size_t>{2, 4, 8, 16});
+
+    // Published layers are never rewritten, so every batch is a prefix of the final geometry
+    for (size_t b = 0; b < batches.size(); ++b) {
+        INFO("batch " << b);
+        const RibbonGeometry& partial = *batches[b];
+        REQUIRE(partial.layer_strip_ranges.size() == layers_built[b]);
+        REQUIRE(std::equal(partial.layer_strip_ranges.begin(), partial.layer_strip_ranges.end(),
+                           full.layer_strip_ranges.begin()));
+        REQUIRE(partial.strips.size() < full.strips.size());
+        REQUIRE(std::equal(partial.strips.begin(), partial.strips.end(), full.strips.begin()));
+        REQUIRE(partial.vertices.size() < full.vertices.size());
+        for (size_t v = 0; v < partial.vertices.size(); v += 97) {
+            REQUIRE(partial.vertices[v].position.x == full.vertices[v].position.x);
+            REQUIRE(partial.vertices[v].position.z == full.vertices[v].position.z);
+            REQUIRE(partial.vertices[v].normal_index == full.vertices[v].normal_index);
+            REQUIRE(partial.vertices[v].color_index == full.vertices[v].color_index);
+        }
+        REQUIRE(partial.quantization.scale_factor == full.quantization.scale_factor);
+    }
+}
+
 // ============================================================================
 // prepare_interleaved_buffers() Tests
 // ============================================================================
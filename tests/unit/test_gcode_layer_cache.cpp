@@ -5,6 +5,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 #include <thread>
 
 #include "../catch_amalgamated.hpp"
@@ -14,9 +17,9 @@ using Catch::Approx;
 
 namespace {
 
-// Helper to create test segments
-std::vector<ToolpathSegment> make_test_segments(size_t count) {
-    std::vector<ToolpathSegment> segs;
+// Helper to create test segments (~14 bytes each once packed)
+CompactSegments make_test_segments(size_t count) {
+    CompactSegments segs;
     segs.reserve(count);
     for (size_t i = 0; i < count; ++i) {
         ToolpathSegment s;
@@ -25,6 +28,7 @@ std::vector<ToolpathSegment> make_test_segments(size_t count) {
         s.is_extrusion = true;
         segs.push_back(s);
     }
+    segs.shrink_to_fit();
     return segs;
 }
 
@@ -82,16 +86,16 @@ TEST_CASE("GCodeLayerCache basic operations", "[gcode][cache]") {
         cache.get_or_load(0, test_loader(10));
         cache.get_or_load(0, test_loader(10));
 
-        auto [hits, misses] = cache.hit_stats();
-        REQUIRE(hits == 2);
-        REQUIRE(misses == 1);
+        auto stats = cache.hit_stats();
+        REQUIRE(stats.hits == 2);
+        REQUIRE(stats.misses == 1);
         REQUIRE(cache.hit_rate() == Catch::Approx(2.0f / 3.0f));
     }
 }
 
 TEST_CASE("GCodeLayerCache LRU eviction", "[gcode][cache]") {
-    // Budget that fits ~2 layers of 50 segments each
-    // 50 segments * 80 bytes = 4KB per layer + overhead
+    // Budget that fits ~2 layers of 300 segments each
+    // 300 segments * 14 bytes = ~4KB per layer + overhead
     // Budget of 10KB should fit ~2 layers
     GCodeLayerCache cache(10 * 1024);
 
@@ -99,9 +103,9 @@ TEST_CASE("GCodeLayerCache LRU eviction", "[gcode][cache]") {
 
     SECTION("evicts oldest layer when over budget") {
         // Load layers 0, 1, 2 - should evict 0 to make room for 2
-        cache.get_or_load(0, tracking_loader(loaded, 50));
-        cache.get_or_load(1, tracking_loader(loaded, 50));
-        cache.get_or_load(2, tracking_loader(loaded, 50));
+        cache.get_or_load(0, tracking_loader(loaded, 300));
+        cache.get_or_load(1, tracking_loader(loaded, 300));
+        cache.get_or_load(2, tracking_loader(loaded, 300));
 
         // Layer 0 should have been evicted
         REQUIRE_FALSE(cache.is_cached(0));
@@ -111,14 +115,14 @@ TEST_CASE("GCodeLayerCache LRU eviction", "[gcode][cache]") {
     }
 
     SECTION("touching a layer prevents eviction") {
-        cache.get_or_load(0, tracking_loader(loaded, 50));
-        cache.get_or_load(1, tracking_loader(loaded, 50));
+        cache.get_or_load(0, tracking_loader(loaded, 300));
+        cache.get_or_load(1, tracking_loader(loaded, 300));
 
         // Touch layer 0 (makes it most recent)
-        cache.get_or_load(0, tracking_loader(loaded, 50));
+        cache.get_or_load(0, tracking_loader(loaded, 300));
 
         // Now add layer 2 - should evict 1, not 0
-        cache.get_or_load(2, tracking_loader(loaded, 50));
+        cache.get_or_load(2, tracking_loader(loaded, 300));
 
         REQUIRE(cache.is_cached(0));       // Was touched, kept
         REQUIRE_FALSE(cache.is_cached(1)); // Oldest, evicted
@@ -126,7 +130,7 @@ TEST_CASE("GCodeLayerCache LRU eviction", "[gcode][cache]") {
     }
 
     SECTION("explicit eviction works") {
-        cache.get_or_load(0, tracking_loader(loaded, 50));
+        cache.get_or_load(0, tracking_loader(loaded, 300));
         REQUIRE(cache.is_cached(0));
 
         bool evicted = cache.evict(0);
@@ -166,9 +170,9 @@ TEST_CASE("GCodeLayerCache memory tracking", "[gcode][cache]") {
 
     SECTION("set_memory_budget evicts excess") {
         // Start with generous budget
-        cache.get_or_load(0, test_loader(100));
-        cache.get_or_load(1, test_loader(100));
-        cache.get_or_load(2, test_loader(100));
+        cache.get_or_load(0, test_loader(300));
+        cache.get_or_load(1, test_loader(300));
+        cache.get_or_load(2, test_loader(300));
         REQUIRE(cache.cached_layer_count() == 3);
 
         // Reduce budget to fit only 1 layer
@@ -246,6 +250,122 @@ TEST_CASE("GCodeLayerCache prefetch", "[gcode][cache]") {
     }
 }
 
+TEST_CASE("GCodeLayerCache async prefetch", "[gcode][cache][thread]") {
+    GCodeLayerCache cache(1024 * 1024);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<size_t> loaded;
+    std::optional<size_t> blocked_layer; // Loads of this layer wait for release
+    bool blocked_started = false;
+    bool released = false;
+
+    auto loader = [&](size_t layer_index) {
+        std::unique_lock<std::mutex> lock(mutex);
+        loaded.push_back(layer_index);
+        if (blocked_layer == layer_index) {
+            blocked_started = true;
+            cv.notify_all();
+            cv.wait(lock, [&]() { return released; });
+        }
+        return make_test_segments(20);
+    };
+    auto wait_until_blocked = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [&]() { return blocked_started; });
+    };
+    auto release = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        cv.notify_all();
+    };
+
+    SECTION("center first, then nearest, favouring the scrub direction") {
+        cache.prefetch_async(10, 2, loader, 100);
+        REQUIRE(cache.wait_for_prefetch());
+        REQUIRE(loaded == std::vector<size_t>{10, 11, 9, 12, 8});
+
+        loaded.clear();
+        cache.prefetch_async(20, 2, loader, 100); // Scrubbing up
+        REQUIRE(cache.wait_for_prefetch());
+        REQUIRE(loaded == std::vector<size_t>{20, 21, 22, 19, 18});
+
+        loaded.clear();
+        cache.prefetch_async(15, 2, loader, 21); // Scrubbing down
+        REQUIRE(cache.wait_for_prefetch());
+        REQUIRE(loaded == std::vector<size_t>{15, 14, 13, 16, 17});
+    }
+
+    SECTION("new center cancels stale requests") {
+        blocked_layer = 0;
+        cache.prefetch_async(0, 3, loader, 100);
+        REQUIRE(wait_until_blocked());
+
+        cache.prefetch_async(50, 1, loader, 100);
+        release();
+        REQUIRE(cache.wait_for_prefetch());
+
+        REQUIRE(loaded == std::vector<size_t>{0, 50, 51, 49});
+        REQUIRE(cache.hit_stats().prefetch_cancelled == 3);
+        REQUIRE(cache.is_cached(0)); // The load in progress still completes
+        REQUIRE_FALSE(cache.is_cached(1));
+    }
+
+    SECTION("request for a layer being prefetched waits instead of reloading") {
+        blocked_layer = 7;
+        cache.prefetch_async(7, 0, loader, 100);
+        REQUIRE(wait_until_blocked());
+
+        std::atomic<int> demand_loads{0};
+        GCodeLayerCache::CacheResult result;
+        std::thread reader([&]() {
+            result = cache.get_or_load(7, [&](size_t) {
+                demand_loads++;
+                return make_test_segments(20);
+            });
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        release();
+        reader.join();
+
+        REQUIRE(demand_loads == 0);
+        REQUIRE(result.segments != nullptr);
+        auto stats = cache.hit_stats();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.prefetch_loads == 1);
+        REQUIRE(stats.prefetch_hits == 1);
+        REQUIRE(stats.max_stall_ms >= 10.0);
+    }
+
+    SECTION("prefetch hit rate counts prefetched layers that were used") {
+        cache.prefetch_async(5, 2, loader, 100);
+        REQUIRE(cache.wait_for_prefetch());
+        cache.get_or_load(5, loader);
+        cache.get_or_load(6, loader);
+        cache.get_or_load(6, loader); // Second use of the same layer doesn't count again
+
+        auto stats = cache.hit_stats();
+        REQUIRE(stats.hits == 3);
+        REQUIRE(stats.misses == 0);
+        REQUIRE(stats.prefetch_loads == 5);
+        REQUIRE(stats.prefetch_hits == 2);
+        REQUIRE(stats.prefetch_hit_rate() == Approx(0.4f));
+    }
+
+    SECTION("clear drops a load in progress") {
+        blocked_layer = 3;
+        cache.prefetch_async(3, 0, loader, 100);
+        REQUIRE(wait_until_blocked());
+        cache.clear();
+        release();
+        REQUIRE(cache.wait_for_prefetch());
+        REQUIRE_FALSE(cache.is_cached(3));
+    }
+
+    release();
+    cache.cancel_prefetch();
+}
+
 TEST_CASE("GCodeLayerCache adaptive mode", "[gcode][cache]") {
     GCodeLayerCache cache(100 * 1024);
 
@@ -260,7 +380,7 @@ TEST_CASE("GCodeLayerCache adaptive mode", "[gcode][cache]") {
     SECTION("respond_to_pressure evicts entries") {
         // Fill the cache
         for (size_t i = 0; i < 10; ++i) {
-            cache.get_or_load(i, test_loader(50));
+            cache.get_or_load(i, test_loader(300));
         }
         size_t before = cache.cached_layer_count();
         REQUIRE(before > 0);
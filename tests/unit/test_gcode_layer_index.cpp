@@ -229,3 +229,151 @@ TEST_CASE("GCodeLayerIndex - Invalid file", "[gcode][layer_index]") {
         REQUIRE(!index.is_valid());
     }
 }
+
+TEST_CASE("LayerIndexScanner - Chunked feed matches build_from_file", "[gcode][layer_index]") {
+    // CRLF lines, a footer color and no trailing newline exercise the carry-over
+    std::string gcode = "; generated by OrcaSlicer\r\n"
+                        ";LAYER_CHANGE\r\nG1 Z0.2 F600\r\nG1 X10 Y10 E1\r\n"
+                        ";LAYER_CHANGE\r\nG1 Z0.4\r\nG1 X20 Y20 E2\r\nG0 X0 Y0\r\n"
+                        ";LAYER_CHANGE\r\nG1 Z0.6\r\nG1 X30 Y30 E3\r\n"
+                        "; filament_colour = #FF8800\r\nM84";
+
+    TempGCodeFile file(gcode);
+    GCodeLayerIndex expected;
+    REQUIRE(expected.build_from_file(file.path()));
+    REQUIRE(expected.get_layer_count() == 3);
+
+    for (size_t chunk : {size_t(1), size_t(7), size_t(64), gcode.size()}) {
+        INFO("chunk size " << chunk);
+        LayerIndexScanner scanner(gcode.size());
+        GCodeLayerIndex index;
+        for (size_t offset = 0; offset < gcode.size(); offset += chunk) {
+            scanner.feed(gcode.data() + offset, std::min(chunk, gcode.size() - offset));
+            index.sync_from(scanner);
+            // The layer being scanned is never published early
+            REQUIRE(index.get_layer_count() <= 2);
+        }
+        scanner.finish();
+        index.sync_from(scanner);
+
+        REQUIRE(index.get_layer_count() == expected.get_layer_count());
+        for (size_t i = 0; i < index.get_layer_count(); ++i) {
+            auto a = index.get_entry(i);
+            auto b = expected.get_entry(i);
+            REQUIRE(a.file_offset == b.file_offset);
+            REQUIRE(a.byte_length == b.byte_length);
+            REQUIRE(a.line_count == b.line_count);
+            REQUIRE(a.z_height == Approx(b.z_height));
+        }
+        REQUIRE(index.get_stats().total_lines == expected.get_stats().total_lines);
+        REQUIRE(index.get_stats().total_bytes == gcode.size());
+        REQUIRE(index.get_stats().filament_color == "#FF8800");
+    }
+}
+
+TEST_CASE("LayerIndexScanner - Publishes completed layers", "[gcode][layer_index]") {
+    LayerIndexScanner scanner;
+    GCodeLayerIndex index;
+
+    std::string layer0 = "G1 Z0.2 E0.1\nG1 X10 E0.2\n";
+    scanner.feed(layer0.data(), layer0.size());
+    REQUIRE(index.sync_from(scanner) == 0); // Layer 0 may still grow
+
+    std::string layer1 = "G1 Z0.4 E0.3\nG1 X2";
+    scanner.feed(layer1.data(), layer1.size());
+    REQUIRE(index.sync_from(scanner) == 1);
+    REQUIRE(index.get_entry(0).byte_length == layer0.size());
+    REQUIRE(index.get_stats().total_layers == 0); // Stats arrive with finish()
+
+    std::string tail = "0 E0.4\n";
+    scanner.feed(tail.data(), tail.size());
+    scanner.finish();
+    REQUIRE(index.sync_from(scanner) == 1);
+    REQUIRE(index.get_entry(1).byte_length == layer1.size() + tail.size());
+    REQUIRE(index.get_stats().total_layers == 2);
+    REQUIRE(scanner.bytes_scanned() == layer0.size() + layer1.size() + tail.size());
+}
+
+namespace {
+
+GCodeLayerIndex scan_in_parallel(const std::string& gcode, unsigned threads) {
+    LayerIndexScanner scanner(gcode.size());
+    scanner.scan_buffer(gcode.data(), gcode.size(), threads);
+    GCodeLayerIndex index;
+    index.sync_from(scanner);
+    return index;
+}
+
+void require_same_index(const GCodeLayerIndex& a, const GCodeLayerIndex& b) {
+    REQUIRE(a.get_layer_count() == b.get_layer_count());
+    for (size_t i = 0; i < a.get_layer_count(); ++i) {
+        INFO("layer " << i);
+        REQUIRE(a.get_entry(i).file_offset == b.get_entry(i).file_offset);
+        REQUIRE(a.get_entry(i).byte_length == b.get_entry(i).byte_length);
+        REQUIRE(a.get_entry(i).line_count == b.get_entry(i).line_count);
+        REQUIRE(a.get_entry(i).z_height == b.get_entry(i).z_height);
+    }
+    const auto& sa = a.get_stats();
+    const auto& sb = b.get_stats();
+    REQUIRE(sa.total_layers == sb.total_layers);
+    REQUIRE(sa.total_lines == sb.total_lines);
+    REQUIRE(sa.total_bytes == sb.total_bytes);
+    REQUIRE(sa.extrusion_moves == sb.extrusion_moves);
+    REQUIRE(sa.travel_moves == sb.travel_moves);
+    REQUIRE(sa.min_z == sb.min_z);
+    REQUIRE(sa.max_z == sb.max_z);
+    REQUIRE(sa.filament_color == sb.filament_color);
+}
+
+} // namespace
+
+TEST_CASE("LayerIndexScanner - Parallel scan matches sequential", "[gcode][layer_index]") {
+    // Z-based layers with z-hops first, then markers take over mid-file; chunk
+    // boundaries land inside both regimes and between a marker and its Z move
+    std::string gcode;
+    float z = 0.0f;
+    for (int layer = 0; layer < 40; ++layer) {
+        z += 0.2f;
+        if (layer == 20) {
+            gcode += ";LAYER_CHANGE\n";
+        }
+        if (layer >= 20 && layer % 3 == 0) {
+            gcode += "; layer_change\n;LAYER_CHANGE\n"; // Repeated markers count once
+        } else if (layer > 20) {
+            gcode += ";LAYER_CHANGE\n";
+        }
+        gcode += "G1 Z" + std::to_string(z) + " F600\n";
+        for (int i = 0; i < 30; ++i) {
+            gcode += "G1 X" + std::to_string(i) + " Y" + std::to_string(layer) + " E0.5\n";
+        }
+        gcode += "G1 Z" + std::to_string(z + 0.4f) + "\nG0 X0 Y0\nG1 Z" + std::to_string(z) + "\n";
+    }
+    gcode += "; filament_colour = #12AB34\nM84"; // Footer color, no trailing newline
+
+    LayerIndexScanner sequential(gcode.size());
+    sequential.feed(gcode.data(), gcode.size());
+    sequential.finish();
+    GCodeLayerIndex expected;
+    expected.sync_from(sequential);
+    REQUIRE(expected.get_layer_count() >= 40);
+    REQUIRE(expected.get_stats().filament_color == "#12AB34");
+
+    for (unsigned threads : {2u, 3u, 5u, 16u, 200u}) {
+        INFO(threads << " threads");
+        require_same_index(scan_in_parallel(gcode, threads), expected);
+    }
+}
+
+TEST_CASE("LayerIndexScanner - Parallel scan of a real file", "[gcode][layer_index][integration]") {
+    std::ifstream file("assets/test_gcodes/3DBenchy.gcode", std::ios::binary);
+    if (!file.good()) {
+        SKIP("Test G-code file not found (run from project root)");
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string gcode = content.str();
+
+    GCodeLayerIndex expected;
+    REQUIRE(expected.build_from_file("assets/test_gcodes/3DBenchy.gcode", 1));
+    require_same_index(scan_in_parallel(gcode, 4), expected);
+}
@@ -0,0 +1,171 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_layer_index_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string layered_gcode(int layers, const char* color = "#26A69A") {
+    std::string gcode = "; filament_colour = " + std::string(color) + "\n";
+    for (int layer = 1; layer <= layers; ++layer) {
+        gcode += ";LAYER_CHANGE\nG1 Z" + std::to_string(layer * 0.2f) + "\n";
+        gcode += "G1 X10 Y10 E1\nG0 X0 Y0\n";
+    }
+    return gcode;
+}
+
+void write_file(const std::string& path, const std::string& content) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+}
+
+/// Fresh cache and G-code directories, removed afterwards
+class CacheDirs {
+  public:
+    CacheDirs() {
+        root_ = fs::temp_directory_path() / ("helix_index_cache_" + std::to_string(rand()));
+        fs::create_directories(root_ / "gcodes");
+    }
+
+    ~CacheDirs() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    std::string cache_dir() const {
+        return (root_ / "cache").string();
+    }
+
+    std::string gcode(const std::string& name) const {
+        return (root_ / "gcodes" / name).string();
+    }
+
+  private:
+    fs::path root_;
+};
+
+} // namespace
+
+TEST_CASE("LayerIndexDiskCache - Round trip", "[gcode][layer_index][cache]") {
+    CacheDirs dirs;
+    std::string path = dirs.gcode("part.gcode");
+    write_file(path, layered_gcode(25));
+
+    GCodeLayerIndex built;
+    REQUIRE(built.build_from_file(path));
+
+    LayerIndexDiskCache cache(dirs.cache_dir());
+    GCodeLayerIndex restored;
+    REQUIRE_FALSE(cache.load(path, restored));
+    REQUIRE(cache.store(path, built));
+    REQUIRE(fs::exists(cache.get_cache_path(path)));
+    REQUIRE(cache.load(path, restored));
+
+    REQUIRE(restored.get_layer_count() == built.get_layer_count());
+    for (size_t i = 0; i < built.get_layer_count(); ++i) {
+        auto a = built.get_entry(i);
+        auto b = restored.get_entry(i);
+        REQUIRE(a.file_offset == b.file_offset);
+        REQUIRE(a.byte_length == b.byte_length);
+        REQUIRE(a.line_count == b.line_count);
+        REQUIRE(a.z_height == b.z_height);
+    }
+    const auto& stats = restored.get_stats();
+    REQUIRE(stats.total_layers == built.get_stats().total_layers);
+    REQUIRE(stats.total_lines == built.get_stats().total_lines);
+    REQUIRE(stats.total_bytes == built.get_stats().total_bytes);
+    REQUIRE(stats.extrusion_moves == built.get_stats().extrusion_moves);
+    REQUIRE(stats.travel_moves == built.get_stats().travel_moves);
+    REQUIRE(stats.max_z == built.get_stats().max_z);
+    REQUIRE(stats.filament_color == "#26A69A");
+    REQUIRE(restored.get_source_path() == path);
+}
+
+TEST_CASE("LayerIndexDiskCache - Stale sidecars are ignored", "[gcode][layer_index][cache]") {
+    CacheDirs dirs;
+    std::string path = dirs.gcode("part.gcode");
+    write_file(path, layered_gcode(10));
+
+    LayerIndexDiskCache cache(dirs.cache_dir());
+    GCodeLayerIndex index;
+    REQUIRE(index.build_from_file(path));
+    REQUIRE(cache.store(path, index));
+
+    SECTION("same size and mtime, different content") {
+        auto mtime = fs::last_write_time(path);
+        write_file(path, layered_gcode(10, "#FF0000"));
+        fs::last_write_time(path, mtime);
+
+        GCodeLayerIndex restored;
+        REQUIRE_FALSE(cache.load(path, restored));
+        REQUIRE_FALSE(restored.is_valid());
+        REQUIRE_FALSE(fs::exists(cache.get_cache_path(path))); // Dropped on mismatch
+    }
+
+    SECTION("file grew") {
+        write_file(path, layered_gcode(11));
+        GCodeLayerIndex restored;
+        REQUIRE_FALSE(cache.load(path, restored));
+    }
+
+    SECTION("damaged sidecar") {
+        std::string sidecar = cache.get_cache_path(path);
+        fs::resize_file(sidecar, fs::file_size(sidecar) - 5);
+        GCodeLayerIndex restored;
+        REQUIRE_FALSE(cache.load(path, restored));
+    }
+
+    SECTION("another file at a different path") {
+        std::string other = dirs.gcode("copy.gcode");
+        fs::copy_file(path, other);
+        GCodeLayerIndex restored;
+        REQUIRE_FALSE(cache.load(other, restored));
+    }
+}
+
+TEST_CASE("LayerIndexDiskCache - Evicts least recently used", "[gcode][layer_index][cache]") {
+    CacheDirs dirs;
+    std::string first = dirs.gcode("first.gcode");
+    std::string second = dirs.gcode("second.gcode");
+    std::string third = dirs.gcode("third.gcode");
+    for (const auto& path : {first, second, third}) {
+        write_file(path, layered_gcode(100));
+    }
+
+    GCodeLayerIndex index;
+    REQUIRE(index.build_from_file(first));
+    LayerIndexDiskCache sizing(dirs.cache_dir());
+    REQUIRE(sizing.store(first, index));
+    size_t sidecar_bytes = fs::file_size(sizing.get_cache_path(first));
+    sizing.remove(first);
+
+    // Room for two sidecars
+    LayerIndexDiskCache cache(dirs.cache_dir(), sidecar_bytes * 2 + sidecar_bytes / 2);
+    GCodeLayerIndex scratch;
+    REQUIRE(index.build_from_file(first));
+    REQUIRE(cache.store(first, index));
+    fs::last_write_time(cache.get_cache_path(first),
+                        fs::file_time_type::clock::now() - std::chrono::hours(2));
+    REQUIRE(index.build_from_file(second));
+    REQUIRE(cache.store(second, index));
+    fs::last_write_time(cache.get_cache_path(second),
+                        fs::file_time_type::clock::now() - std::chrono::hours(1));
+
+    // Loading refreshes the first sidecar, so the second is now the oldest
+    REQUIRE(cache.load(first, scratch));
+    REQUIRE(index.build_from_file(third));
+    REQUIRE(cache.store(third, index));
+
+    REQUIRE(cache.get_cache_size() <= sidecar_bytes * 2 + sidecar_bytes / 2);
+    REQUIRE(fs::exists(cache.get_cache_path(first)));
+    REQUIRE_FALSE(fs::exists(cache.get_cache_path(second)));
+    REQUIRE(fs::exists(cache.get_cache_path(third)));
+}
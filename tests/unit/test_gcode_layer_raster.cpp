@@ -0,0 +1,347 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_layer_raster.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+namespace {
+
+constexpr uint32_t OPAQUE_RED = 0xFFFF0000;
+
+uint32_t alpha_at(const RasterImage& image, int x, int y) {
+    return image.pixels[static_cast<size_t>(y * image.width + x)] >> 24;
+}
+
+RasterImage make_image(int w, int h) {
+    RasterImage image;
+    image.resize(w, h);
+    image.clear();
+    return image;
+}
+
+} // namespace
+
+// ============================================================================
+// Line kernel
+// ============================================================================
+
+TEST_CASE("Layer raster: line on pixel centers is crisp", "[gcode][layer_raster]") {
+    RasterImage image = make_image(32, 16);
+    draw_line_aa(image, {4.5f, 8.5f}, {27.5f, 8.5f}, 1.0f, OPAQUE_RED);
+
+    for (int x = 4; x <= 27; ++x) {
+        REQUIRE(image.pixels[static_cast<size_t>(8 * 32 + x)] == OPAQUE_RED);
+        REQUIRE(alpha_at(image, x, 7) == 0);
+        REQUIRE(alpha_at(image, x, 9) == 0);
+    }
+    REQUIRE(alpha_at(image, 2, 8) == 0); // Round cap ends half a pixel out
+    REQUIRE(alpha_at(image, 29, 8) == 0);
+}
+
+TEST_CASE("Layer raster: line between pixel rows is split evenly", "[gcode][layer_raster]") {
+    RasterImage image = make_image(32, 16);
+    draw_line_aa(image, {4.0f, 8.0f}, {28.0f, 8.0f}, 1.0f, OPAQUE_RED);
+
+    for (int x = 6; x <= 25; ++x) {
+        uint32_t above = alpha_at(image, x, 7);
+        uint32_t below = alpha_at(image, x, 8);
+        REQUIRE(above == below);
+        REQUIRE(above >= 126);
+        REQUIRE(above <= 129);
+        REQUIRE((image.pixels[static_cast<size_t>(8 * 32 + x)] & 0x00FFFFFF) == 0xFF0000);
+    }
+}
+
+TEST_CASE("Layer raster: coverage does not depend on direction", "[gcode][layer_raster]") {
+    RasterImage forward = make_image(48, 48);
+    RasterImage backward = make_image(48, 48);
+    glm::vec2 a{5.3f, 7.8f};
+    glm::vec2 b{41.1f, 30.2f};
+    draw_line_aa(forward, a, b, 3.0f, OPAQUE_RED);
+    draw_line_aa(backward, b, a, 3.0f, OPAQUE_RED);
+    REQUIRE(forward.pixels == backward.pixels);
+
+    // Total coverage is about width x length plus the round caps
+    double coverage = 0.0;
+    for (uint32_t p : forward.pixels) {
+        coverage += static_cast<double>(p >> 24) / 255.0;
+    }
+    double length = static_cast<double>(glm::length(b - a));
+    double expected = 3.0 * length + 3.14159 * 1.5 * 1.5;
+    REQUIRE(coverage > expected * 0.95);
+    REQUIRE(coverage < expected * 1.05);
+}
+
+TEST_CASE("Layer raster: lines are clipped to the image", "[gcode][layer_raster]") {
+    RasterImage image = make_image(16, 16);
+    draw_line_aa(image, {-100.0f, -50.0f}, {120.0f, 60.0f}, 4.0f, OPAQUE_RED);
+    draw_line_aa(image, {8.0f, -1000.0f}, {8.0f, 1000.0f}, 2.0f, OPAQUE_RED);
+    draw_line_aa(image, {-30.0f, -30.0f}, {-10.0f, -10.0f}, 8.0f, OPAQUE_RED);
+    draw_line_aa(image, {5.0f, 5.0f}, {5.0f, 5.0f}, 3.0f, OPAQUE_RED); // Dot
+    REQUIRE(alpha_at(image, 8, 0) == 255);
+    REQUIRE(alpha_at(image, 8, 15) == 255);
+    REQUIRE(alpha_at(image, 4, 4) > 0);
+}
+
+TEST_CASE("Layer raster: translucent colors composite over", "[gcode][layer_raster]") {
+    RasterImage image = make_image(8, 8);
+    image.clear(0xFF0000FF); // Opaque blue
+    draw_line_aa(image, {0.0f, 4.5f}, {8.0f, 4.5f}, 1.0f, 0x80FF0000);
+
+    uint32_t mixed = image.pixels[4 * 8 + 4];
+    REQUIRE((mixed >> 24) == 0xFF);
+    uint32_t red = (mixed >> 16) & 0xFF;
+    uint32_t blue = mixed & 0xFF;
+    REQUIRE(red >= 126);
+    REQUIRE(red <= 130);
+    REQUIRE(red + blue >= 254);
+    REQUIRE(red + blue <= 256);
+
+    // Over a transparent pixel the color is kept and only alpha is partial
+    RasterImage clear = make_image(8, 8);
+    draw_line_aa(clear, {0.0f, 4.5f}, {8.0f, 4.5f}, 1.0f, 0x80FF0000);
+    REQUIRE(clear.pixels[4 * 8 + 4] == 0x80FF0000);
+}
+
+// ============================================================================
+// Swap chain
+// ============================================================================
+
+TEST_CASE("Layer raster: swap chain hands over published images", "[gcode][layer_raster]") {
+    RasterSwapChain chain;
+    REQUIRE(chain.acquire() == nullptr);
+
+    RasterImage* back = &chain.begin_frame();
+    back->resize(4, 4);
+    back->clear(OPAQUE_RED);
+    back->tag = 3;
+    back = &chain.publish(true);
+    REQUIRE(chain.has_new());
+
+    SECTION("carry_over keeps drawing on a copy") {
+        REQUIRE(back->tag == 3);
+        REQUIRE(back->pixels == std::vector<uint32_t>(16, OPAQUE_RED));
+    }
+
+    SECTION("acquire returns each image once") {
+        const RasterImage* front = chain.acquire();
+        REQUIRE(front != nullptr);
+        REQUIRE(front->tag == 3);
+        REQUIRE(front != back);
+        REQUIRE(chain.acquire() == nullptr);
+
+        // Only the newest of several publishes is seen
+        back->tag = 4;
+        back = &chain.publish(true);
+        back->tag = 5;
+        chain.publish(false);
+        front = chain.acquire();
+        REQUIRE(front->tag == 5);
+
+        RasterStats stats = chain.stats();
+        REQUIRE(stats.frames_published == 3);
+        REQUIRE(stats.frames_acquired == 2);
+        REQUIRE(stats.max_frame_us >= stats.last_frame_us);
+        REQUIRE(stats.max_swap_latency_us >= stats.last_swap_latency_us);
+    }
+}
+
+TEST_CASE("Layer raster: publish stamps only the rows drawn on", "[gcode][layer_raster]") {
+    RasterSwapChain chain;
+    RasterImage* back = &chain.begin_frame();
+    back->resize(8, 8);
+    back->clear();
+    back = &chain.publish(true);
+    REQUIRE(back->row_versions == std::vector<uint64_t>(8, 1));
+
+    draw_line_aa(*back, {0.0f, 3.5f}, {8.0f, 3.5f}, 1.0f, OPAQUE_RED);
+    back = &chain.publish(true);
+    REQUIRE(back->version == 2);
+    REQUIRE(back->row_versions[3] == 2);
+    // The antialiasing band may reach the neighbours; nothing further
+    for (size_t y : {0, 1, 5, 6, 7}) {
+        INFO("row " << y);
+        REQUIRE(back->row_versions[y] == 1);
+    }
+}
+
+TEST_CASE("Layer raster: changed-row copies match the drawn image", "[gcode][layer_raster]") {
+    constexpr int SIZE = 32;
+    RasterSwapChain chain;
+    RasterImage reference = make_image(SIZE, SIZE);
+    RasterImage* back = &chain.begin_frame();
+    back->resize(SIZE, SIZE);
+    back->clear();
+
+    // Like the renderer's cache_buf_: a copy only ever updated from acquired images
+    RasterImage view;
+    for (int frame = 0; frame < 60; ++frame) {
+        // Shallow and steep lines at varying rows
+        float at = static_cast<float>(frame % SIZE) + 0.3f;
+        float run = static_cast<float>(frame % 7) * 3.0f;
+        glm::vec2 p0{1.0f, at};
+        glm::vec2 p1{static_cast<float>(SIZE - 2), at + static_cast<float>(frame % 5)};
+        if (frame % 2 == 1) {
+            p0 = {at, 1.0f};
+            p1 = {at + static_cast<float>(frame % 5), 2.0f + run};
+        }
+        uint32_t color = 0x80000000u | static_cast<uint32_t>(frame * 0x040201);
+        draw_line_aa(*back, p0, p1, 1.5f, color);
+        draw_line_aa(reference, p0, p1, 1.5f, color);
+        back = &chain.publish(true);
+        REQUIRE(back->pixels == reference.pixels);
+
+        if (frame % 3 != 1) { // Skip some, so the reader falls behind by several publishes
+            const RasterImage* front = chain.acquire();
+            REQUIRE(front != nullptr);
+            REQUIRE(front->pixels == reference.pixels);
+            view.update_from(*front);
+            REQUIRE(view.pixels == reference.pixels);
+        }
+    }
+}
+
+TEST_CASE("Layer raster: reader never sees a half-drawn image", "[gcode][layer_raster]") {
+    constexpr int FRAMES = 2000;
+    RasterSwapChain chain;
+
+    std::thread writer([&chain]() {
+        RasterImage* back = &chain.begin_frame();
+        back->resize(32, 32);
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            back->clear(static_cast<uint32_t>(frame));
+            back->tag = frame;
+            back = &chain.publish(true);
+        }
+    });
+
+    int last_tag = -1;
+    bool consistent = true;
+    while (last_tag < FRAMES - 1) {
+        const RasterImage* front = chain.acquire();
+        if (!front) {
+            std::this_thread::yield();
+            continue;
+        }
+        consistent = consistent && front->tag > last_tag;
+        uint32_t expected = static_cast<uint32_t>(front->tag);
+        consistent = consistent && std::all_of(front->pixels.begin(), front->pixels.end(),
+                                               [expected](uint32_t p) { return p == expected; });
+        last_tag = front->tag;
+    }
+    writer.join();
+    REQUIRE(consistent);
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+
+TEST_CASE("Layer raster: a newer job stops the running one", "[gcode][layer_raster]") {
+    LayerRasterWorker worker;
+    std::atomic<bool> first_started{false};
+    std::atomic<bool> first_stopped{false};
+    std::atomic<int> second_runs{0};
+
+    worker.submit(RasterLane::Solid, [&](const std::atomic<bool>& stop) {
+        first_started = true;
+        while (!stop.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        first_stopped = true;
+    });
+    while (!first_started.load()) {
+        std::this_thread::yield();
+    }
+    REQUIRE(worker.is_busy(RasterLane::Solid));
+    REQUIRE_FALSE(worker.is_busy(RasterLane::Ghost));
+
+    worker.submit(RasterLane::Solid, [&](const std::atomic<bool>&) { ++second_runs; });
+    while (worker.is_busy(RasterLane::Solid)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(first_stopped.load());
+    REQUIRE(second_runs.load() == 1);
+}
+
+TEST_CASE("Layer raster: cancel drops pending work", "[gcode][layer_raster]") {
+    LayerRasterWorker worker;
+    std::atomic<bool> release{false};
+    std::atomic<bool> solid_started{false};
+    std::atomic<int> ghost_runs{0};
+
+    worker.submit(RasterLane::Solid, [&](const std::atomic<bool>&) {
+        solid_started = true;
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    while (!solid_started.load()) {
+        std::this_thread::yield();
+    }
+    worker.submit(RasterLane::Ghost, [&](const std::atomic<bool>&) { ++ghost_runs; });
+    worker.cancel(RasterLane::Ghost);
+    REQUIRE_FALSE(worker.is_busy(RasterLane::Ghost));
+
+    release = true;
+    worker.wait_idle();
+    worker.shutdown();
+    REQUIRE(ghost_runs.load() == 0);
+
+    worker.submit(RasterLane::Ghost, [&](const std::atomic<bool>&) { ++ghost_runs; });
+    REQUIRE_FALSE(worker.is_busy(RasterLane::Ghost)); // Ignored after shutdown
+}
+
+TEST_CASE("Layer raster: a solid job pauses a long ghost job", "[gcode][layer_raster]") {
+    constexpr int kGhostLayers = 200;
+    LayerRasterWorker worker;
+    std::atomic<int> ghost_layer{0}; // The job's own progress, kept across calls
+    std::atomic<int> ghost_calls{0};
+    std::atomic<int> finished{0};
+    std::atomic<int> solid_finished_as{0};
+    std::atomic<int> ghost_finished_as{0};
+    std::atomic<int> ghost_layer_at_solid{-1};
+
+    worker.submit(RasterLane::Ghost, [&](const std::atomic<bool>& stop) {
+        ++ghost_calls;
+        while (ghost_layer.load() < kGhostLayers) {
+            if (stop.load()) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++ghost_layer;
+        }
+        ghost_finished_as = ++finished;
+    });
+    while (ghost_calls.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    worker.submit(RasterLane::Solid, [&](const std::atomic<bool>&) {
+        ghost_layer_at_solid = ghost_layer.load();
+        solid_finished_as = ++finished;
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((worker.is_busy(RasterLane::Solid) || worker.is_busy(RasterLane::Ghost)) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(solid_finished_as.load() == 1);
+    REQUIRE(ghost_finished_as.load() == 2);
+    REQUIRE(ghost_layer_at_solid.load() < kGhostLayers);
+
+    // The ghost job was called again and carried on instead of starting over
+    REQUIRE(ghost_calls.load() == 2);
+    REQUIRE(ghost_layer.load() == kGhostLayers);
+}
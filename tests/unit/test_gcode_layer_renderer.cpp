@@ -4,14 +4,78 @@
 #include "gcode_layer_renderer.h"
 #include "gcode_parser.h"
 
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "../catch_amalgamated.hpp"
 
 using namespace helix::gcode;
 
+namespace helix::gcode {
+
+/// Drives the solid raster pass synchronously, without the worker thread
+class GCodeLayerRendererTestAccess {
+  public:
+    static constexpr int kWidth = 160;
+    static constexpr int kHeight = 120;
+
+    static size_t printed_segment_count(const GCodeLayerRenderer& r, int target_layer,
+                                        uint64_t file_position, int layer_idx, size_t count) {
+        GCodeLayerRenderer::RasterPass pass;
+        pass.target_layer = target_layer;
+        pass.file_position = file_position;
+        return r.printed_segment_count(pass, layer_idx, count);
+    }
+
+    /// Run one solid raster job; returns the published pixels (empty if nothing changed)
+    static std::vector<uint32_t> raster_solid(GCodeLayerRenderer& r, int target_layer,
+                                              uint64_t file_position) {
+        r.set_print_file_position(file_position);
+        auto pass = r.capture_raster_pass(r.solid_generation_, target_layer, kWidth, kHeight);
+        std::atomic<bool> stop{false};
+        r.raster_solid_layers(pass, stop);
+        const RasterImage* image = r.solid_chain_.acquire();
+        return image ? image->pixels : std::vector<uint32_t>{};
+    }
+
+    /// Run one solid raster job and take it into cache_buf_ like a frame does;
+    /// returns cache_buf_'s pixels without the stride padding
+    static std::vector<uint32_t> raster_solid_to_cache(GCodeLayerRenderer& r, int target_layer,
+                                                       uint64_t file_position) {
+        r.ensure_cache(kWidth, kHeight);
+        r.set_print_file_position(file_position);
+        auto pass = r.capture_raster_pass(r.solid_generation_, target_layer, kWidth, kHeight);
+        std::atomic<bool> stop{false};
+        r.raster_solid_layers(pass, stop);
+        r.take_solid_frame();
+
+        std::vector<uint32_t> pixels(static_cast<size_t>(kWidth) * kHeight);
+        const auto* src = static_cast<const uint8_t*>(r.cache_buf_->data);
+        for (int y = 0; y < kHeight; ++y) {
+            std::memcpy(pixels.data() + static_cast<size_t>(y) * kWidth,
+                        src + static_cast<size_t>(y) * r.cache_buf_->header.stride,
+                        kWidth * sizeof(uint32_t));
+        }
+        return pixels;
+    }
+
+    static int drawn_layer(const GCodeLayerRenderer& r) {
+        return r.solid_drawn_layer_;
+    }
+
+    static size_t drawn_segments(const GCodeLayerRenderer& r) {
+        return r.solid_drawn_segments_;
+    }
+};
+
+} // namespace helix::gcode
+
 namespace {
 
 // Helper to build a ParsedGCodeFile with named objects and an unnamed segment.
@@ -64,6 +128,7 @@ ParsedGCodeFile make_test_gcode() {
     // Set global bounding box
     gcode.global_bounding_box.expand(glm::vec3(10.0f, 20.0f, 0.2f));
     gcode.global_bounding_box.expand(glm::vec3(50.0f, 80.0f, 0.2f));
+    gcode.index_objects();
 
     return gcode;
 }
@@ -89,10 +154,53 @@ ParsedGCodeFile make_single_object_gcode(const std::string& name, float y) {
     gcode.total_segments = 1;
     gcode.global_bounding_box.expand(glm::vec3(10.0f, y, 0.2f));
     gcode.global_bounding_box.expand(glm::vec3(90.0f, y, 0.2f));
+    gcode.index_objects();
 
     return gcode;
 }
 
+// Helper to build layers of 40 arc segments, layer i spanning file bytes
+// [1000 * i, 1000 * i + 800)
+ParsedGCodeFile make_byte_range_gcode(int layer_count) {
+    ParsedGCodeFile gcode;
+    for (int i = 0; i < layer_count; ++i) {
+        Layer layer;
+        layer.z_height = 0.2f * static_cast<float>(i + 1);
+        layer.file_offset = 1000u * static_cast<uint64_t>(i);
+        layer.byte_length = 800;
+        for (int s = 0; s < 40; ++s) {
+            float a0 = static_cast<float>(s) * 0.157f;
+            float a1 = static_cast<float>(s + 1) * 0.157f;
+            ToolpathSegment seg;
+            seg.start = glm::vec3(50.0f + 20.0f * std::cos(a0), 50.0f + 20.0f * std::sin(a0),
+                                  layer.z_height);
+            seg.end = glm::vec3(50.0f + 20.0f * std::cos(a1), 50.0f + 20.0f * std::sin(a1),
+                                layer.z_height);
+            seg.is_extrusion = true;
+            layer.segments.push_back(seg);
+            layer.bounding_box.expand(seg.start);
+            gcode.global_bounding_box.expand(seg.start);
+        }
+        layer.segment_count_extrusion = 40;
+        gcode.total_segments += 40;
+        gcode.layers.push_back(std::move(layer));
+    }
+    gcode.index_objects();
+    return gcode;
+}
+
+using RendererAccess = GCodeLayerRendererTestAccess;
+
+/// Image a renderer with no drawing history produces for the same target
+std::vector<uint32_t> fresh_solid_image(const ParsedGCodeFile& gcode, int target_layer,
+                                        uint64_t file_position) {
+    GCodeLayerRenderer renderer;
+    renderer.set_gcode(&gcode);
+    renderer.set_canvas_size(RendererAccess::kWidth, RendererAccess::kHeight);
+    renderer.auto_fit();
+    return RendererAccess::raster_solid(renderer, target_layer, file_position);
+}
+
 } // namespace
 
 // =============================================================================
@@ -327,3 +435,99 @@ TEST_CASE("set_highlighted_objects with no gcode does not crash", "[layer_render
     std::unordered_set<std::string> highlighted = {"cube1"};
     REQUIRE_NOTHROW(renderer.set_highlighted_objects(highlighted));
 }
+
+// =============================================================================
+// Live print position
+// =============================================================================
+
+TEST_CASE("printed_segment_count scales the file position within the target layer",
+          "[layer_renderer][print_position]") {
+    ParsedGCodeFile gcode = make_byte_range_gcode(4);
+    GCodeLayerRenderer renderer;
+    renderer.set_gcode(&gcode);
+
+    // No position, or a layer other than the target, counts as fully printed
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 0, 2, 40) == 40);
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 2400, 1, 40) == 40);
+
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 1900, 2, 40) == 0);
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 2000, 2, 40) == 0);
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 2400, 2, 40) == 20);
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 2600, 2, 40) == 30);
+    CHECK(RendererAccess::printed_segment_count(renderer, 2, 2800, 2, 40) == 40);
+
+    SECTION("offsets past 4 GiB are not truncated") {
+        gcode.layers[2].file_offset = 5'000'000'000ULL;
+        CHECK(RendererAccess::printed_segment_count(renderer, 2, 5'000'000'400ULL, 2, 40) == 20);
+        CHECK(RendererAccess::printed_segment_count(renderer, 2, 705'032'704 + 400, 2, 40) == 0);
+    }
+
+    SECTION("layers without a byte range count as printed") {
+        gcode.layers[2].byte_length = 0;
+        CHECK(RendererAccess::printed_segment_count(renderer, 2, 2400, 2, 40) == 40);
+    }
+}
+
+TEST_CASE("Solid raster cursor follows the print position", "[layer_renderer][print_position]") {
+    ParsedGCodeFile gcode = make_byte_range_gcode(4);
+    GCodeLayerRenderer renderer;
+    renderer.set_gcode(&gcode);
+    renderer.set_canvas_size(RendererAccess::kWidth, RendererAccess::kHeight);
+    renderer.auto_fit();
+
+    // Half of layer 2 printed: layers 0-1 whole, cursor 20 segments into layer 2
+    auto image = RendererAccess::raster_solid(renderer, 2, 2400);
+    REQUIRE(RendererAccess::drawn_layer(renderer) == 1);
+    REQUIRE(RendererAccess::drawn_segments(renderer) == 20);
+    REQUIRE(image == fresh_solid_image(gcode, 2, 2400));
+
+    SECTION("resume within a layer draws only the new segments") {
+        image = RendererAccess::raster_solid(renderer, 2, 2600);
+        REQUIRE(RendererAccess::drawn_layer(renderer) == 1);
+        REQUIRE(RendererAccess::drawn_segments(renderer) == 30);
+        // Redrawing segments 0-19 on top would double their anti-aliased edges
+        REQUIRE(image == fresh_solid_image(gcode, 2, 2600));
+
+        // Same position again: nothing to draw, nothing published
+        REQUIRE(RendererAccess::raster_solid(renderer, 2, 2600).empty());
+        REQUIRE(RendererAccess::drawn_segments(renderer) == 30);
+    }
+
+    SECTION("stepping backwards within a layer restarts the image") {
+        image = RendererAccess::raster_solid(renderer, 2, 2200);
+        REQUIRE(RendererAccess::drawn_layer(renderer) == 1);
+        REQUIRE(RendererAccess::drawn_segments(renderer) == 10);
+        REQUIRE(image == fresh_solid_image(gcode, 2, 2200));
+    }
+
+    SECTION("advancing to the next layer finishes the partial one") {
+        image = RendererAccess::raster_solid(renderer, 3, 3200);
+        REQUIRE(RendererAccess::drawn_layer(renderer) == 2);
+        REQUIRE(RendererAccess::drawn_segments(renderer) == 10);
+        REQUIRE(image == fresh_solid_image(gcode, 3, 3200));
+    }
+
+    SECTION("clearing the position draws the target layer whole") {
+        image = RendererAccess::raster_solid(renderer, 2, 0);
+        REQUIRE(RendererAccess::drawn_layer(renderer) == 2);
+        REQUIRE(RendererAccess::drawn_segments(renderer) == 0);
+        REQUIRE(image == fresh_solid_image(gcode, 2, 0));
+    }
+}
+
+TEST_CASE("Solid frames copied row by row match a fresh image",
+          "[layer_renderer][print_position]") {
+    ParsedGCodeFile gcode = make_byte_range_gcode(4);
+    GCodeLayerRenderer renderer;
+    renderer.set_gcode(&gcode);
+    renderer.set_canvas_size(RendererAccess::kWidth, RendererAccess::kHeight);
+    renderer.auto_fit();
+
+    // Each tick only copies the rows the new segments touched into cache_buf_
+    for (uint64_t position : {2100u, 2400u, 2600u, 3200u, 3500u}) {
+        INFO("file position " << position);
+        int target = static_cast<int>(position / 1000);
+        REQUIRE(RendererAccess::raster_solid_to_cache(renderer, target, position) ==
+                fresh_solid_image(gcode, target, position));
+    }
+}
@@ -0,0 +1,158 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+namespace {
+
+ToolpathSegment make_segment(float x0, float y0, float x1, float y1, bool extrude = true) {
+    ToolpathSegment seg;
+    seg.start = glm::vec3(x0, y0, 0.2f);
+    seg.end = glm::vec3(x1, y1, 0.2f);
+    seg.is_extrusion = extrude;
+    return seg;
+}
+
+/// Chain of segments through @p points
+std::vector<ToolpathSegment> make_chain(const std::vector<glm::vec2>& points) {
+    std::vector<ToolpathSegment> chain;
+    for (size_t i = 1; i < points.size(); ++i) {
+        chain.push_back(
+            make_segment(points[i - 1].x, points[i - 1].y, points[i].x, points[i].y));
+    }
+    return chain;
+}
+
+LodLayer decimate(const std::vector<ToolpathSegment>& segments, float tolerance) {
+    PolylineDecimator decimator(tolerance);
+    for (const auto& seg : segments) {
+        decimator.add(seg);
+    }
+    return decimator.finish();
+}
+
+float distance_to_polyline(const glm::vec2& p, const std::vector<glm::vec2>& points) {
+    float best = INFINITY;
+    for (size_t i = 1; i < points.size(); ++i) {
+        glm::vec2 ab = points[i] - points[i - 1];
+        glm::vec2 ap = p - points[i - 1];
+        float len_sq = glm::dot(ab, ab);
+        float t = len_sq > 0.0f ? std::clamp(glm::dot(ap, ab) / len_sq, 0.0f, 1.0f) : 0.0f;
+        best = std::min(best, glm::length(ap - ab * t));
+    }
+    return best;
+}
+
+} // namespace
+
+TEST_CASE("LOD - Zoom buckets bound the pixel error", "[gcode][lod]") {
+    for (float scale : {0.3f, 1.0f, 2.5f, 4.0f, 7.9f, 40.0f}) {
+        INFO("scale " << scale);
+        int bucket = lod_zoom_bucket(scale);
+        REQUIRE(lod_bucket_scale(bucket) >= scale * 0.9999f);
+        REQUIRE(lod_bucket_scale(bucket) < scale * 1.2f); // Quarter-octave buckets
+        REQUIRE(lod_tolerance_mm(bucket) * scale <= LOD_MAX_ERROR_PX * 1.0001f);
+    }
+    REQUIRE(lod_zoom_bucket(4.0f) == lod_zoom_bucket(3.9f));
+    REQUIRE(lod_zoom_bucket(4.0f) != lod_zoom_bucket(4.2f));
+}
+
+TEST_CASE("LOD - Collinear and sub-tolerance segments merge", "[gcode][lod]") {
+    SECTION("Straight run becomes one edge") {
+        std::vector<glm::vec2> points;
+        for (int i = 0; i <= 20; ++i) {
+            points.emplace_back(static_cast<float>(i), 5.0f);
+        }
+        LodLayer lod = decimate(make_chain(points), 0.05f);
+        REQUIRE(lod.source_segments == 20);
+        REQUIRE(lod.polylines.size() == 1);
+        REQUIRE(lod.polylines[0].points == std::vector<glm::vec2>{{0.0f, 5.0f}, {20.0f, 5.0f}});
+        REQUIRE(lod.edge_count() == 1);
+    }
+
+    SECTION("Square keeps its corners") {
+        LodLayer lod = decimate(
+            make_chain({{0, 0}, {5, 0}, {10, 0}, {10, 5}, {10, 10}, {0, 10}, {0, 0}}), 0.05f);
+        REQUIRE(lod.polylines.size() == 1);
+        REQUIRE(lod.polylines[0].points ==
+                std::vector<glm::vec2>{{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}});
+    }
+
+    SECTION("Sub-pixel zig-zag collapses") {
+        std::vector<glm::vec2> points;
+        for (int i = 0; i <= 200; ++i) {
+            points.emplace_back(static_cast<float>(i) * 0.05f, (i % 2) ? 0.02f : 0.0f);
+        }
+        LodLayer lod = decimate(make_chain(points), 0.05f);
+        REQUIRE(lod.polylines.size() == 1);
+        // Held-back points are capped, so a long run still splits every MAX_SKIPPED
+        REQUIRE(lod.edge_count() <= 200 / PolylineDecimator::MAX_SKIPPED + 1);
+    }
+
+    SECTION("Doubling back is not merged away") {
+        LodLayer lod = decimate(make_chain({{0, 0}, {10, 0}, {2, 0}}), 0.05f);
+        REQUIRE(lod.polylines[0].points == std::vector<glm::vec2>{{0, 0}, {10, 0}, {2, 0}});
+    }
+}
+
+TEST_CASE("LOD - Polylines break on style and gaps", "[gcode][lod]") {
+    std::vector<ToolpathSegment> segments = make_chain({{0, 0}, {1, 0}, {2, 0}});
+    segments.push_back(make_segment(2, 0, 3, 0, false)); // Travel
+    ToolpathSegment tool = make_segment(3, 0, 4, 0);
+    tool.tool_index = 1;
+    segments.push_back(tool);
+    ToolpathSegment object = make_segment(4, 0, 5, 0);
+    object.tool_index = 1;
+    object.object_id = 0;
+    object.object_name = "cube";
+    segments.push_back(object);
+    segments.push_back(make_segment(8, 0, 9, 0)); // Jump
+    segments.push_back(make_segment(9, 0, 9, 0)); // Zero length, merges
+
+    LodLayer lod = decimate(segments, 0.05f);
+    REQUIRE(lod.source_segments == 7);
+    REQUIRE(lod.polylines.size() == 5);
+    REQUIRE_FALSE(lod.polylines[1].style.is_extrusion);
+    REQUIRE(lod.polylines[2].style.tool_index == 1);
+    REQUIRE(lod.polylines[3].style.object_name == "cube");
+    REQUIRE(lod.polylines[4].points == std::vector<glm::vec2>{{8, 0}, {9, 0}});
+    REQUIRE(lod.polylines[4].min == glm::vec2(8, 0));
+    REQUIRE(lod.polylines[4].max == glm::vec2(9, 0));
+    REQUIRE(lod.bounds.min.x == 0.0f);
+    REQUIRE(lod.bounds.max.x == 9.0f);
+
+    // A lone zero-length segment draws nothing
+    REQUIRE(decimate({make_segment(1, 1, 1, 1)}, 0.05f).polylines.empty());
+}
+
+TEST_CASE("LOD - Every source vertex stays within tolerance", "[gcode][lod]") {
+    // Densely sampled spiral: arcs as slicers emit them, plus noise
+    std::vector<glm::vec2> points;
+    for (int i = 0; i < 3000; ++i) {
+        float t = static_cast<float>(i) * 0.01f;
+        float r = 5.0f + t;
+        float noise = (i % 3 == 0) ? 0.004f : 0.0f;
+        points.emplace_back(r * std::cos(t) + noise, r * std::sin(t));
+    }
+
+    for (float tolerance : {0.01f, 0.05f, 0.25f}) {
+        INFO("tolerance " << tolerance);
+        LodLayer lod = decimate(make_chain(points), tolerance);
+        REQUIRE(lod.polylines.size() == 1);
+        const auto& result = lod.polylines[0].points;
+        REQUIRE(result.front() == points.front());
+        REQUIRE(result.back() == points.back());
+        REQUIRE(lod.edge_count() < points.size() / 2);
+        for (const auto& p : points) {
+            REQUIRE(distance_to_polyline(p, result) <= tolerance * 1.001f);
+        }
+    }
+}
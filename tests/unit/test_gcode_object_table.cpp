@@ -0,0 +1,82 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_object_table.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+TEST_CASE("ObjectSymbolTable - Interning", "[gcode][object_table]") {
+    ObjectSymbolTable table;
+    REQUIRE(table.empty());
+
+    REQUIRE(table.intern("cube") == 0);
+    REQUIRE(table.intern("cylinder") == 1);
+    REQUIRE(table.intern("cube") == 0);
+    REQUIRE(table.size() == 2);
+
+    REQUIRE(table.find("cylinder") == 1);
+    REQUIRE(table.find("missing") == NO_OBJECT_ID);
+    REQUIRE(table.name(1) == "cylinder");
+    REQUIRE(table.name(NO_OBJECT_ID).empty());
+
+    SECTION("Empty names have no id") {
+        REQUIRE(table.intern("") == NO_OBJECT_ID);
+        REQUIRE(table.size() == 2);
+    }
+
+    SECTION("Clear forgets every name") {
+        table.clear();
+        REQUIRE(table.empty());
+        REQUIRE(table.find("cube") == NO_OBJECT_ID);
+        REQUIRE(table.intern("cylinder") == 0);
+    }
+}
+
+TEST_CASE("ObjectSymbolTable - Name sets resolve to id sets", "[gcode][object_table]") {
+    ObjectSymbolTable table;
+    table.intern("a");
+    table.intern("b");
+    table.intern("c");
+
+    auto ids = table.to_id_set(std::unordered_set<std::string>{"a", "c", "unknown"});
+    REQUIRE(ids.test(0));
+    REQUIRE_FALSE(ids.test(1));
+    REQUIRE(ids.test(2));
+    REQUIRE(ids.count() == 2);
+}
+
+TEST_CASE("ObjectIdSet - Bit operations", "[gcode][object_table]") {
+    ObjectIdSet set;
+    REQUIRE_FALSE(set.any());
+    REQUIRE_FALSE(set.test(0));
+    REQUIRE_FALSE(set.test(NO_OBJECT_ID));
+
+    set.set(3);
+    set.set(200);
+    set.set(NO_OBJECT_ID); // Ignored
+    REQUIRE(set.test(3));
+    REQUIRE(set.test(200));
+    REQUIRE_FALSE(set.test(199));
+    REQUIRE_FALSE(set.test(NO_OBJECT_ID));
+    REQUIRE(set.count() == 2);
+
+    SECTION("Equality ignores trailing empty words") {
+        ObjectIdSet other;
+        other.set(3);
+        REQUIRE(set != other);
+        set.reset(200);
+        REQUIRE(set == other);
+        REQUIRE(other == set);
+    }
+
+    SECTION("Clear empties the set") {
+        set.clear();
+        REQUIRE_FALSE(set.any());
+        REQUIRE(set == ObjectIdSet{});
+    }
+}
@@ -60,6 +60,7 @@ ParsedGCodeFile make_single_object_gcode(const std::string& name = "cube1") {
     gcode.total_segments = 2;
     gcode.global_bounding_box.expand(glm::vec3(10.0f, 20.0f, 0.2f));
     gcode.global_bounding_box.expand(glm::vec3(90.0f, 80.0f, 0.2f));
+    gcode.index_objects();
 
     return gcode;
 }
@@ -114,6 +115,7 @@ ParsedGCodeFile make_multi_object_gcode() {
     gcode.total_segments = 8;
     gcode.global_bounding_box.expand(glm::vec3(10.0f, 10.0f, 0.2f));
     gcode.global_bounding_box.expand(glm::vec3(90.0f, 90.0f, 0.2f));
+    gcode.index_objects();
 
     return gcode;
 }
@@ -286,6 +288,7 @@ TEST_CASE("GCodeObjectThumbnailRenderer: object with no segments gets empty thum
     Layer layer;
     layer.z_height = 0.2f;
     gcode.layers.push_back(std::move(layer));
+    gcode.index_objects();
 
     GCodeObjectThumbnailRenderer renderer;
     auto result = renderer.render_sync(&gcode, 40, 40, kTestColor);
@@ -326,6 +329,7 @@ TEST_CASE("GCodeObjectThumbnailRenderer: segments without object_name are skippe
     layer.segments.push_back(named);
 
     gcode.layers.push_back(std::move(layer));
+    gcode.index_objects();
 
     GCodeObjectThumbnailRenderer renderer;
     auto result = renderer.render_sync(&gcode, 40, 40, kTestColor);
@@ -356,6 +360,7 @@ TEST_CASE("GCodeObjectThumbnailRenderer: travel moves are skipped", "[object-thu
     layer.segments.push_back(travel);
 
     gcode.layers.push_back(std::move(layer));
+    gcode.index_objects();
 
     GCodeObjectThumbnailRenderer renderer;
     auto result = renderer.render_sync(&gcode, 40, 40, kTestColor);
@@ -374,6 +379,7 @@ TEST_CASE("GCodeObjectThumbnailRenderer: object with empty bounding box is skipp
     obj.name = "degenerate";
     // Don't expand bounding box - it stays at infinity/-infinity
     gcode.objects["degenerate"] = obj;
+    gcode.index_objects();
 
     GCodeObjectThumbnailRenderer renderer;
     auto result = renderer.render_sync(&gcode, 40, 40, kTestColor);
@@ -464,6 +470,8 @@ TEST_CASE("GCodeObjectThumbnailRenderer: multiple layers are rendered", "[object
         gcode.layers.push_back(std::move(layer));
     }
 
+    gcode.index_objects();
+
     GCodeObjectThumbnailRenderer renderer;
     auto result = renderer.render_sync(&gcode, 40, 40, kTestColor);
 
@@ -0,0 +1,189 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_parallel_parser.h"
+#include "gcode_parser.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+namespace {
+
+ParsedGCodeFile parse_sequential(const std::string& gcode) {
+    GCodeParser parser;
+    parser.parse_buffer(gcode.data(), gcode.size());
+    return parser.finalize();
+}
+
+ParsedGCodeFile parse_in_parallel(const std::string& gcode, unsigned threads) {
+    ParallelGCodeParser parser;
+    parser.set_max_threads(threads);
+    parser.set_min_range_bytes(1); // Split even tiny inputs
+    return parser.parse(gcode.data(), gcode.size());
+}
+
+void require_same_bounds(const AABB& a, const AABB& b) {
+    REQUIRE(a.min == b.min);
+    REQUIRE(a.max == b.max);
+}
+
+void require_same_file(const ParsedGCodeFile& a, const ParsedGCodeFile& b) {
+    REQUIRE(a.layers.size() == b.layers.size());
+    for (size_t i = 0; i < a.layers.size(); ++i) {
+        INFO("layer " << i);
+        const Layer& la = a.layers[i];
+        const Layer& lb = b.layers[i];
+        REQUIRE(la.z_height == lb.z_height);
+        REQUIRE(la.segment_count_extrusion == lb.segment_count_extrusion);
+        REQUIRE(la.segment_count_travel == lb.segment_count_travel);
+        REQUIRE(la.file_offset == lb.file_offset);
+        REQUIRE(la.byte_length == lb.byte_length);
+        require_same_bounds(la.bounding_box, lb.bounding_box);
+        REQUIRE(la.segments.size() == lb.segments.size());
+        for (size_t s = 0; s < la.segments.size(); ++s) {
+            INFO("segment " << s);
+            const ToolpathSegment& sa = la.segments[s];
+            const ToolpathSegment& sb = lb.segments[s];
+            REQUIRE(sa.start == sb.start);
+            REQUIRE(sa.end == sb.end);
+            REQUIRE(sa.is_extrusion == sb.is_extrusion);
+            REQUIRE(sa.extrusion_amount == sb.extrusion_amount);
+            REQUIRE(sa.width == sb.width);
+            REQUIRE(sa.tool_index == sb.tool_index);
+            REQUIRE(sa.object_name == sb.object_name);
+            REQUIRE(sa.object_id == sb.object_id);
+        }
+    }
+    REQUIRE(a.total_segments == b.total_segments);
+    require_same_bounds(a.global_bounding_box, b.global_bounding_box);
+    REQUIRE(a.object_table.names() == b.object_table.names());
+    REQUIRE(a.objects.size() == b.objects.size());
+    for (const auto& [name, object] : a.objects) {
+        INFO("object " << name);
+        REQUIRE(b.objects.count(name) == 1);
+        const GCodeObject& other = b.objects.at(name);
+        REQUIRE(object.center == other.center);
+        REQUIRE(object.polygon.size() == other.polygon.size());
+        require_same_bounds(object.bounding_box, other.bounding_box);
+    }
+    REQUIRE(a.layer_height_mm == b.layer_height_mm);
+    REQUIRE(a.slicer_name == b.slicer_name);
+    REQUIRE(a.tool_color_palette == b.tool_color_palette);
+    REQUIRE(a.total_layer_count == b.total_layer_count);
+}
+
+/// Two objects, tool changes, a wipe tower and z-hops under G91, on marker layers
+std::string multi_object_gcode(bool relative_z_hops) {
+    std::string gcode = "; generated by TestSlicer 1.0\n"
+                        "; layer_height = 0.25\n"
+                        "EXCLUDE_OBJECT_DEFINE NAME=cube CENTER=10,10 "
+                        "POLYGON=[[5,5],[15,5],[15,15]]\n"
+                        "EXCLUDE_OBJECT_DEFINE NAME=cylinder CENTER=40,10\n"
+                        "G90\nM83\n";
+    float z = 0.0f;
+    for (int layer = 0; layer < 60; ++layer) {
+        z += 0.25f;
+        gcode += ";LAYER_CHANGE\n;Z:" + std::to_string(z) + "\n";
+        gcode += "G1 Z" + std::to_string(z) + " F600\n";
+        if (layer % 7 == 3) {
+            gcode += "T" + std::to_string(layer % 3) + "\n";
+        }
+        const char* objects[] = {"cube", "cylinder"};
+        for (int o = 0; o < 2; ++o) {
+            gcode += std::string("EXCLUDE_OBJECT_START NAME=") + objects[o] + "\n";
+            float x0 = 5.0f + 30.0f * static_cast<float>(o);
+            for (int i = 0; i < 12; ++i) {
+                gcode += "G1 X" + std::to_string(x0 + static_cast<float>(i % 5)) + " Y" +
+                         std::to_string(5.0f + static_cast<float>(i) * 0.8f) + " E0.04\n";
+            }
+            gcode += std::string("EXCLUDE_OBJECT_END NAME=") + objects[o] + "\n";
+            if (relative_z_hops) {
+                gcode += "G91\nG1 Z0.4\nG90\nG0 X" + std::to_string(x0 + 30.0f) + " Y5\n";
+                gcode += "G1 Z" + std::to_string(z) + "\n";
+            } else {
+                gcode += "G1 Z" + std::to_string(z + 0.4f) + "\n";
+                gcode += "G0 X" + std::to_string(x0 + 30.0f) + " Y5\nG1 Z" + std::to_string(z) +
+                         "\n";
+            }
+        }
+        gcode += "; WIPE_TOWER_START\nG1 X70 Y70 E0.1\nG1 X75 Y70 E0.1\n; WIPE_TOWER_END\n";
+    }
+    gcode += "; extruder_colour = #FF0000;#00FF00;#0000FF\n";
+    gcode += "; total layer number: 60\nM84"; // No trailing newline
+    return gcode;
+}
+
+} // namespace
+
+TEST_CASE("ParallelGCodeParser - Matches sequential parse", "[gcode][parallel_parser]") {
+    std::string gcode = multi_object_gcode(false);
+    ParsedGCodeFile expected = parse_sequential(gcode);
+    REQUIRE(expected.layers.size() == 60);
+    REQUIRE(expected.objects.size() == 2);
+    REQUIRE(expected.layer_height_mm == 0.25f);
+
+    for (unsigned threads : {2u, 3u, 7u, 32u}) {
+        INFO(threads << " threads");
+        require_same_file(parse_in_parallel(gcode, threads), expected);
+    }
+}
+
+TEST_CASE("ParallelGCodeParser - Relative moves across a seam", "[gcode][parallel_parser]") {
+    SECTION("G91 z-hops inside layers") {
+        std::string gcode = multi_object_gcode(true);
+        ParsedGCodeFile expected = parse_sequential(gcode);
+        for (unsigned threads : {2u, 5u, 16u}) {
+            INFO(threads << " threads");
+            require_same_file(parse_in_parallel(gcode, threads), expected);
+        }
+    }
+
+    SECTION("Relative positioning throughout falls back to one range") {
+        std::string gcode = "G91\nM83\n";
+        for (int layer = 0; layer < 30; ++layer) {
+            gcode += ";LAYER_CHANGE\nG1 Z0.2\n";
+            for (int i = 0; i < 10; ++i) {
+                gcode += (i % 2 == 0) ? "G1 X2 Y0.5 E0.1\n" : "G1 X-2 Y0.5 E0.1\n";
+            }
+        }
+        ParsedGCodeFile expected = parse_sequential(gcode);
+        REQUIRE(expected.layers.size() == 30);
+        require_same_file(parse_in_parallel(gcode, 4), expected);
+    }
+}
+
+TEST_CASE("ParallelGCodeParser - Z-based layers without markers", "[gcode][parallel_parser]") {
+    std::string gcode = "G90\nM82\n";
+    float e = 0.0f;
+    for (int layer = 1; layer <= 40; ++layer) {
+        gcode += "G1 Z" + std::to_string(0.2f * static_cast<float>(layer)) + "\n";
+        for (int i = 0; i < 15; ++i) {
+            e += 0.05f;
+            gcode += "G1 X" + std::to_string(i) + " Y" + std::to_string(i % 4) + " E" +
+                     std::to_string(e) + "\n";
+        }
+    }
+    ParsedGCodeFile expected = parse_sequential(gcode);
+    REQUIRE(expected.layers.size() == 40);
+    for (unsigned threads : {2u, 6u, 40u}) {
+        INFO(threads << " threads");
+        require_same_file(parse_in_parallel(gcode, threads), expected);
+    }
+}
+
+TEST_CASE("ParallelGCodeParser - Real file", "[gcode][parallel_parser][integration]") {
+    std::ifstream file("assets/test_gcodes/exclude_object_test.gcode", std::ios::binary);
+    if (!file.good()) {
+        SKIP("Test G-code file not found (run from project root)");
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string gcode = content.str();
+
+    ParsedGCodeFile expected = parse_sequential(gcode);
+    require_same_file(parse_in_parallel(gcode, 4), expected);
+}
@@ -162,6 +162,28 @@ TEST_CASE("GCodeParser - EXCLUDE_OBJECT commands", "[gcode][parser]") {
         REQUIRE(file.layers[0].segments[1].object_name == "part1");
         REQUIRE(file.layers[0].segments[2].object_name == "");
     }
+
+    SECTION("Assign object ids in definition order") {
+        parser.parse_line("EXCLUDE_OBJECT_DEFINE NAME=part1 CENTER=10,10");
+        parser.parse_line("EXCLUDE_OBJECT_DEFINE NAME=part2 CENTER=30,30");
+        parser.parse_line("EXCLUDE_OBJECT_START NAME=part2");
+        parser.parse_line("G1 X30 Y30 Z0.2 E1");
+        parser.parse_line("EXCLUDE_OBJECT_END NAME=part2");
+        parser.parse_line("EXCLUDE_OBJECT_START NAME=part1");
+        parser.parse_line("G1 X10 Y10 E2");
+        parser.parse_line("EXCLUDE_OBJECT_END NAME=part1");
+        parser.parse_line("G1 X0 Y0 E3");
+
+        auto file = parser.finalize();
+
+        REQUIRE(file.object_table.size() == 2);
+        REQUIRE(file.object_table.find("part1") == 0);
+        REQUIRE(file.object_table.find("part2") == 1);
+        REQUIRE(file.layers[0].segments[0].object_id == 1);
+        REQUIRE(file.layers[0].segments[1].object_id == 0);
+        REQUIRE(file.layers[0].segments[2].object_id == NO_OBJECT_ID);
+        REQUIRE(file.objects["part2"].bounding_box.max.x == Approx(30.0f));
+    }
 }
 
 TEST_CASE("GCodeParser - Bounding box calculation", "[gcode][parser]") {
@@ -993,6 +1015,41 @@ TEST_CASE("GCodeParser - Z-hop handling", "[gcode][parser][layers][zhop]") {
     }
 }
 
+TEST_CASE("GCodeParser - Layer file ranges", "[gcode][parser][layers]") {
+    const std::string gcode = "; header\n"
+                              "G1 Z0.2\nG1 X10 Y10 E1\nG1 X20 Y10 E2\n"
+                              "; next\nG1 Z0.4\nG1 X20 Y20 E3\n"
+                              "M84\n";
+    const size_t last_move_end = gcode.find("M84");
+
+    GCodeParser parser;
+    size_t expected_end = 0;
+    SECTION("Ranges cover the move lines, across buffer splits") {
+        // Split mid-line, so a move is assembled from two buffers
+        parser.parse_buffer(gcode.data(), 20);
+        parser.parse_buffer(gcode.data() + 20, gcode.size() - 20);
+        expected_end = last_move_end;
+    }
+    SECTION("A last line without newline ends at the end of the data") {
+        parser.parse_buffer(gcode.data(), last_move_end - 1);
+        expected_end = last_move_end - 1;
+    }
+    auto file = parser.finalize();
+
+    REQUIRE(file.layers.size() == 2);
+    const Layer& first = file.layers[0];
+    const Layer& second = file.layers[1];
+    REQUIRE(first.file_offset == gcode.find("G1 X10"));
+    REQUIRE(first.file_offset + first.byte_length == gcode.find("; next"));
+    REQUIRE(second.file_offset == gcode.find("G1 X20 Y20"));
+    REQUIRE(second.file_offset + second.byte_length == expected_end);
+
+    // Lines fed one by one have no known range
+    GCodeParser by_line;
+    by_line.parse_line("G1 X10 Y10 E1");
+    REQUIRE(by_line.finalize().layers[0].byte_length == 0);
+}
+
 // ============================================================================
 // Thumbnail Extraction from Content Tests
 // ============================================================================
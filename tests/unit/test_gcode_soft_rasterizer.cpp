@@ -0,0 +1,205 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_camera.h"
+#include "gcode_geometry_builder.h"
+#include "gcode_parser.h"
+#include "gcode_soft_rasterizer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+namespace {
+
+constexpr int W = 160;
+constexpr int H = 120;
+constexpr uint32_t BACKGROUND = 0xFF737378;
+constexpr int LAYERS = 4;
+
+/// Square perimeter per layer, each layer shifted along X so layers can be framed alone
+ParsedGCodeFile make_gcode() {
+    ParsedGCodeFile gcode;
+    for (int i = 0; i < LAYERS; ++i) {
+        Layer layer;
+        layer.z_height = 0.2f * static_cast<float>(i + 1);
+        float x0 = 10.0f + 20.0f * static_cast<float>(i);
+        glm::vec3 corners[] = {{x0, 10.0f, layer.z_height},
+                               {x0 + 12.0f, 10.0f, layer.z_height},
+                               {x0 + 12.0f, 22.0f, layer.z_height},
+                               {x0, 22.0f, layer.z_height}};
+        for (int c = 0; c < 4; ++c) {
+            ToolpathSegment seg;
+            seg.start = corners[c];
+            seg.end = corners[(c + 1) % 4];
+            seg.is_extrusion = true;
+            seg.extrusion_amount = 1.0f;
+            seg.width = 1.5f;
+            layer.segments.push_back(seg);
+            gcode.global_bounding_box.expand(seg.start);
+        }
+        gcode.layers.push_back(layer);
+    }
+    return gcode;
+}
+
+RibbonGeometry make_geometry() {
+    GeometryBuilder builder;
+    SimplificationOptions options;
+    options.enable_merging = false;
+    return builder.build(make_gcode(), options);
+}
+
+GCodeCamera make_camera(const AABB& bounds) {
+    GCodeCamera camera;
+    camera.set_viewport_size(W, H);
+    camera.fit_to_bounds(bounds);
+    return camera;
+}
+
+void render(RibbonRasterizer& raster, const RibbonGeometry& geometry, const GCodeCamera& camera,
+            int first = 0, int last = LAYERS - 1) {
+    raster.resize(W, H);
+    raster.begin_frame(geometry, make_soft_render_view(camera), first, last, BACKGROUND);
+    raster.draw_layers(first, last, SoftPassStyle{});
+}
+
+size_t covered_pixels(const RibbonRasterizer& raster) {
+    return static_cast<size_t>(std::count_if(raster.pixels().begin(), raster.pixels().end(),
+                                             [](uint32_t p) { return p != BACKGROUND; }));
+}
+
+} // namespace
+
+TEST_CASE("Soft Rasterizer: ribbons fill color and depth", "[gcode][soft_render]") {
+    RibbonGeometry geometry = make_geometry();
+    REQUIRE(geometry.layer_bboxes.size() == LAYERS);
+    GCodeCamera camera = make_camera(make_gcode().global_bounding_box);
+
+    RibbonRasterizer raster(2);
+    render(raster, geometry, camera);
+    REQUIRE(raster.triangles_drawn() > 0);
+    REQUIRE(raster.layers_culled() == 0);
+    REQUIRE(covered_pixels(raster) > 200);
+    REQUIRE(covered_pixels(raster) < static_cast<size_t>(W * H / 2));
+
+    // Every drawn pixel is opaque and has depth; the background has none
+    for (size_t i = 0; i < raster.pixels().size(); ++i) {
+        bool drawn = raster.pixels()[i] != BACKGROUND;
+        REQUIRE((raster.depth()[i] != SOFT_DEPTH_FAR) == drawn);
+        REQUIRE((raster.pixels()[i] >> 24) == 0xFF);
+    }
+
+    SECTION("A layer range draws a subset") {
+        size_t all = covered_pixels(raster);
+        render(raster, geometry, camera, 1, 1);
+        REQUIRE(covered_pixels(raster) > 0);
+        REQUIRE(covered_pixels(raster) < all);
+    }
+
+    SECTION("Vertex colors are lit, not flat") {
+        std::vector<uint32_t> colors;
+        for (uint32_t p : raster.pixels()) {
+            if (p != BACKGROUND && std::find(colors.begin(), colors.end(), p) == colors.end()) {
+                colors.push_back(p);
+            }
+        }
+        REQUIRE(colors.size() > 3);
+    }
+}
+
+TEST_CASE("Soft Rasterizer: image is independent of threads and chunking",
+          "[gcode][soft_render]") {
+    RibbonGeometry geometry = make_geometry();
+    GCodeCamera camera = make_camera(make_gcode().global_bounding_box);
+
+    RibbonRasterizer single(1);
+    render(single, geometry, camera);
+    REQUIRE(single.chunks_drawn() == 1);
+
+    RibbonRasterizer pooled(4);
+    pooled.set_chunk_vertices(16); // Below one layer: every layer is its own chunk
+    render(pooled, geometry, camera);
+    REQUIRE(pooled.chunks_drawn() == LAYERS);
+
+    REQUIRE(pooled.pixels() == single.pixels());
+    REQUIRE(pooled.depth() == single.depth());
+    REQUIRE(pooled.triangles_drawn() == single.triangles_drawn());
+}
+
+TEST_CASE("Soft Rasterizer: layers outside the frustum are culled", "[gcode][soft_render]") {
+    RibbonGeometry geometry = make_geometry();
+
+    // Frame layer 0 alone, zoomed in: the other squares sit far off to the side
+    GCodeCamera camera = make_camera(geometry.layer_bboxes[0]);
+    camera.zoom(2.0f);
+
+    RibbonRasterizer raster(2);
+    render(raster, geometry, camera, 0, 0);
+    std::vector<uint32_t> layer0 = raster.pixels();
+
+    render(raster, geometry, camera);
+    REQUIRE(raster.layers_culled() >= LAYERS - 2); // Layer 1's box may clip the view corner
+    REQUIRE(raster.chunks_drawn() == 1);
+    REQUIRE(raster.pixels() == layer0);
+}
+
+TEST_CASE("Soft Rasterizer: translucent passes blend without writing depth",
+          "[gcode][soft_render]") {
+    RibbonGeometry geometry = make_geometry();
+    GCodeCamera camera = make_camera(make_gcode().global_bounding_box);
+
+    RibbonRasterizer raster(2);
+    raster.resize(W, H);
+    raster.begin_frame(geometry, make_soft_render_view(camera), 0, LAYERS - 1, BACKGROUND);
+    raster.draw_layers(0, 0, SoftPassStyle{});
+    std::vector<uint16_t> solid_depth = raster.depth();
+    size_t solid_pixels = covered_pixels(raster);
+
+    SoftPassStyle ghost;
+    ghost.color_scale = 4.0f;
+    ghost.alpha = 64;
+    raster.draw_layers(1, LAYERS - 1, ghost);
+
+    REQUIRE(raster.depth() == solid_depth);
+    REQUIRE(covered_pixels(raster) > solid_pixels);
+    for (size_t i = 0; i < raster.pixels().size(); ++i) {
+        if (solid_depth[i] == SOFT_DEPTH_FAR) {
+            // Ghost-only pixels move at most alpha/255 of the way from the background
+            for (int shift : {0, 8, 16}) {
+                int ghost = static_cast<int>((raster.pixels()[i] >> shift) & 0xFF);
+                int background = static_cast<int>((BACKGROUND >> shift) & 0xFF);
+                REQUIRE(std::abs(ghost - background) <= 64);
+            }
+        }
+    }
+}
+
+TEST_CASE("Soft Rasterizer: back-face culling keeps the image", "[gcode][soft_render]") {
+    RibbonGeometry geometry = make_geometry();
+    GCodeCamera camera = make_camera(make_gcode().global_bounding_box);
+    SoftRenderView view = make_soft_render_view(camera);
+
+    RibbonRasterizer raster(2);
+    raster.resize(W, H);
+    raster.begin_frame(geometry, view, 0, LAYERS - 1, BACKGROUND);
+    raster.draw_layers(0, LAYERS - 1, SoftPassStyle{});
+    std::vector<uint32_t> culled = raster.pixels();
+    size_t culled_triangles = raster.triangles_drawn();
+
+    view.cull_back_faces = false;
+    raster.begin_frame(geometry, view, 0, LAYERS - 1, BACKGROUND);
+    raster.draw_layers(0, LAYERS - 1, SoftPassStyle{});
+    REQUIRE(culled_triangles < raster.triangles_drawn());
+
+    size_t differing = 0;
+    for (size_t i = 0; i < culled.size(); ++i) {
+        differing += culled[i] != raster.pixels()[i] ? 1 : 0;
+    }
+    REQUIRE(differing * 100 < covered_pixels(raster)); // Silhouette pixels at most
+}
@@ -3,8 +3,14 @@
 
 #include "gcode_streaming_controller.h"
 
+#include "gcode_layer_index_cache.h"
+#include "gcode_toolpath_cache.h"
+
+#include "../mocks/mock_http_server.h"
+
 #include <chrono>
 #include <cstdio>
+#include <filesystem>
 #include <fstream>
 #include <thread>
 #include <unistd.h>
@@ -245,6 +251,7 @@ TEST_CASE("GCodeStreamingController prefetch", "[gcode][streaming]") {
 
         // Access layer 10, which should prefetch layers 7-13
         controller.get_layer_segments(10);
+        REQUIRE(controller.wait_for_prefetch());
 
         // Nearby layers should be cached
         REQUIRE(controller.is_layer_cached(10));
@@ -259,6 +266,7 @@ TEST_CASE("GCodeStreamingController prefetch", "[gcode][streaming]") {
     SECTION("explicit prefetch works") {
         controller.clear_cache();
         controller.prefetch_around(5, 2);
+        REQUIRE(controller.wait_for_prefetch());
 
         // Layers 3-7 should be cached
         for (size_t i = 3; i <= 7; ++i) {
@@ -340,6 +348,134 @@ TEST_CASE("GCodeStreamingController async operations", "[gcode][streaming]") {
     }
 }
 
+TEST_CASE("GCodeStreamingController publishes first layers of a local file",
+          "[gcode][streaming]") {
+    // ~2.5MB, so the first layers complete well before the end of the file
+    std::string gcode;
+    for (int layer = 1; layer <= 400; ++layer) {
+        gcode += "G1 Z" + std::to_string(layer * 0.2) + " F600\n";
+        for (int i = 0; i < 200; ++i) {
+            gcode += "G1 X" + std::to_string(i % 50) + " Y10 E0.05\n";
+        }
+    }
+    TempGCodeFile temp_file(gcode);
+
+    GCodeStreamingController controller;
+    std::atomic<size_t> layers_at_first{0};
+    std::atomic<bool> segments_at_first{false};
+    std::atomic<int> result{0};
+    controller.open_file_async(
+        temp_file.path(), [&](bool success) { result = success ? 1 : 2; },
+        [&]() {
+            layers_at_first = controller.get_layer_count();
+            segments_at_first = controller.get_layer_segments(0) != nullptr;
+        });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (result.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(result == 1);
+    REQUIRE(layers_at_first > 0);
+    REQUIRE(layers_at_first < 400);
+    REQUIRE(segments_at_first);
+
+    // Layers shown early keep their byte ranges in the full index
+    REQUIRE(controller.is_index_complete());
+    REQUIRE(controller.get_layer_count() == 400);
+    auto first = controller.get_layer_segments(0);
+    REQUIRE(first != nullptr);
+    REQUIRE_FALSE(first->empty());
+}
+
+TEST_CASE("GCodeStreamingController indexes sources without a file", "[gcode][streaming]") {
+    GCodeStreamingController controller;
+    REQUIRE(controller.open_source(std::make_unique<MemoryDataSource>(SIMPLE_3_LAYER_GCODE)));
+
+    REQUIRE(controller.is_open());
+    REQUIRE(controller.is_index_complete());
+    REQUIRE(controller.get_layer_count() == 3);
+    REQUIRE(controller.get_index_stats().total_bytes == SIMPLE_3_LAYER_GCODE.size());
+
+    auto segments = controller.get_layer_segments(1);
+    REQUIRE(segments != nullptr);
+    REQUIRE_FALSE(segments->empty());
+}
+
+/// File source whose file is a throwaway copy, like a Moonraker fallback download
+class TemporaryFileSource : public FileDataSource {
+  public:
+    using FileDataSource::FileDataSource;
+
+    bool indexable_file_is_temporary() const override {
+        return true;
+    }
+};
+
+TEST_CASE("GCodeStreamingController keeps temporary downloads out of the disk caches",
+          "[gcode][streaming]") {
+    TempGCodeFile temp_file(SIMPLE_3_LAYER_GCODE);
+    std::string index_path = get_layer_index_cache().get_cache_path(temp_file.path());
+    std::string toolpath_path = get_toolpath_cache().get_cache_path(temp_file.path());
+
+    GCodeStreamingController controller;
+    REQUIRE(controller.open_source(std::make_unique<TemporaryFileSource>(temp_file.path())));
+    REQUIRE(controller.get_layer_count() == 3);
+    REQUIRE(controller.get_layer_segments(1) != nullptr);
+    controller.close(); // Waits for a toolpath digest, if one was started
+
+    REQUIRE_FALSE(std::filesystem::exists(index_path));
+    REQUIRE_FALSE(std::filesystem::exists(toolpath_path));
+}
+
+TEST_CASE("GCodeStreamingController streams from Moonraker", "[gcode][streaming][slow]") {
+    // ~2.5MB, so the download takes several range requests
+    std::string gcode;
+    for (int layer = 1; layer <= 400; ++layer) {
+        gcode += "G1 Z" + std::to_string(layer * 0.2) + " F600\n";
+        for (int i = 0; i < 200; ++i) {
+            gcode += "G1 X" + std::to_string(i % 50) + " Y10 E0.05\n";
+        }
+    }
+
+    MockHttpServer server;
+    server.add_file("gcodes/tall.gcode", gcode);
+    server.set_response_delay_ms(50);
+    REQUIRE(server.start() > 0);
+
+    GCodeStreamingController controller;
+    std::atomic<bool> first_layer{false};
+    std::atomic<bool> complete_at_first_layer{true};
+    std::atomic<int> result{0};
+    controller.open_moonraker_async(
+        server.base_url(), "tall.gcode",
+        [&]() {
+            complete_at_first_layer = controller.is_index_complete();
+            first_layer = true;
+        },
+        [&](bool success) { result = success ? 1 : 2; });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!first_layer.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(first_layer);
+    REQUIRE_FALSE(complete_at_first_layer);
+
+    // Layers are usable while the rest of the file downloads
+    REQUIRE(controller.is_open());
+    REQUIRE(controller.get_layer_segments(0) != nullptr);
+    server.fail_next_requests(2); // Dropped requests are resumed
+
+    while (result.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(result == 1);
+    REQUIRE(controller.is_index_complete());
+    REQUIRE(controller.get_layer_count() == 400);
+    REQUIRE(controller.get_index_stats().total_bytes == gcode.size());
+}
+
 TEST_CASE("GCodeStreamingController memory pressure", "[gcode][streaming]") {
     TempGCodeFile temp_file(SIMPLE_3_LAYER_GCODE);
     GCodeStreamingController controller;
@@ -420,7 +556,7 @@ TEST_CASE("BackgroundGhostBuilder basic operations", "[gcode][streaming][ghost]"
         std::atomic<size_t> layers_rendered{0};
         std::atomic<size_t> segments_received{0};
 
-        builder.start(&controller, [&](size_t layer_idx, const std::vector<ToolpathSegment>& segs) {
+        builder.start(&controller, [&](size_t layer_idx, const CompactSegments& segs) {
             layers_rendered++;
             segments_received += segs.size();
         });
@@ -0,0 +1,306 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_gcode_tokenizer.cpp
+ * @brief G-code tokenizer, GCodeParser::parse_buffer() and parser throughput
+ */
+
+#include "gcode_parser.h"
+#include "gcode_tokenizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+
+namespace {
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::vector<std::filesystem::path> test_gcode_files() {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("assets/test_gcodes", ec)) {
+        if (entry.path().extension() == ".gcode") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+ParsedGCodeFile parse_lines(const std::string& content) {
+    GCodeParser parser;
+    std::istringstream stream(content);
+    std::string line;
+    while (std::getline(stream, line)) {
+        parser.parse_line(line);
+    }
+    return parser.finalize();
+}
+
+ParsedGCodeFile parse_chunks(const std::string& content, size_t chunk_size) {
+    GCodeParser parser;
+    for (size_t offset = 0; offset < content.size(); offset += chunk_size) {
+        parser.parse_buffer(content.data() + offset,
+                            std::min(chunk_size, content.size() - offset));
+    }
+    return parser.finalize();
+}
+
+void require_same_toolpath(const ParsedGCodeFile& a, const ParsedGCodeFile& b) {
+    REQUIRE(a.layers.size() == b.layers.size());
+    REQUIRE(a.total_segments == b.total_segments);
+    REQUIRE(a.objects.size() == b.objects.size());
+    for (size_t i = 0; i < a.layers.size(); i++) {
+        const auto& la = a.layers[i].segments;
+        const auto& lb = b.layers[i].segments;
+        REQUIRE(la.size() == lb.size());
+        for (size_t j = 0; j < la.size(); j++) {
+            REQUIRE(la[j].end == lb[j].end);
+            REQUIRE(la[j].object_name == lb[j].object_name);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("GCode tokenizer - line classification", "[gcode][tokenizer]") {
+    SECTION("Movement commands") {
+        REQUIRE(tokenize_line("G1 X10 Y20").command == GCodeCommand::Move);
+        REQUIRE(tokenize_line("G0").command == GCodeCommand::Move);
+        REQUIRE(tokenize_line("  G1 X1 ; move").command == GCodeCommand::Move);
+        REQUIRE(tokenize_line("G10").command == GCodeCommand::Other);
+        REQUIRE(tokenize_line("G28").command == GCodeCommand::Other);
+    }
+
+    SECTION("Mode commands must match exactly") {
+        REQUIRE(tokenize_line("G90").command == GCodeCommand::Absolute);
+        REQUIRE(tokenize_line("G91\r").command == GCodeCommand::Relative);
+        REQUIRE(tokenize_line("M82").command == GCodeCommand::AbsoluteE);
+        REQUIRE(tokenize_line("M83 ; relative E").command == GCodeCommand::RelativeE);
+        REQUIRE(tokenize_line("M821").command == GCodeCommand::Other);
+    }
+
+    SECTION("Tool changes and objects") {
+        REQUIRE(tokenize_line("T1").command == GCodeCommand::ToolChange);
+        REQUIRE(tokenize_line("EXCLUDE_OBJECT_START NAME=a").command ==
+                GCodeCommand::ExcludeObject);
+        REQUIRE(tokenize_line("EXCLUDE_OBJECTS").command == GCodeCommand::ExcludeObject);
+        REQUIRE(tokenize_line("EXCLUDE").command == GCodeCommand::Other);
+    }
+
+    SECTION("Code and comment views") {
+        GCodeLine line = tokenize_line("  G1 X5  ;TYPE:Perimeter\r");
+        REQUIRE(line.code == "G1 X5");
+        REQUIRE(line.comment == ";TYPE:Perimeter\r");
+
+        GCodeLine comment_only = tokenize_line("; just a comment");
+        REQUIRE(comment_only.command == GCodeCommand::None);
+        REQUIRE(comment_only.code.empty());
+        REQUIRE(comment_only.comment == "; just a comment");
+
+        REQUIRE(tokenize_line("").command == GCodeCommand::None);
+    }
+}
+
+TEST_CASE("GCode tokenizer - number parsing", "[gcode][tokenizer]") {
+    float value = 0.0f;
+
+    REQUIRE(parse_float("12.5", value) == 4);
+    REQUIRE(value == 12.5f);
+    REQUIRE(parse_float("-0.04", value) == 5);
+    REQUIRE(value == -0.04f);
+    REQUIRE(parse_float("+.5", value) == 3);
+    REQUIRE(value == 0.5f);
+    REQUIRE(parse_float("7.", value) == 2);
+    REQUIRE(value == 7.0f);
+    REQUIRE(parse_float("1e-3", value) == 4);
+    REQUIRE(value == 0.001f);
+    REQUIRE(parse_float("2e", value) == 1); // Exponent needs digits
+    REQUIRE(value == 2.0f);
+    REQUIRE(parse_float("1.2.3", value) == 3);
+    REQUIRE(value == 1.2f);
+    REQUIRE(parse_float("0.10000000000000000000001", value) == 25);
+    REQUIRE(value == 0.1f);
+
+    SECTION("Rejects text that is not a number") {
+        value = 42.0f;
+        REQUIRE(parse_float("", value) == 0);
+        REQUIRE(parse_float("-", value) == 0);
+        REQUIRE(parse_float(".", value) == 0);
+        REQUIRE(parse_float("+-1", value) == 0);
+        REQUIRE(parse_float("1" + std::string(40, '0'), value) == 0); // Beyond float range
+        REQUIRE(value == 42.0f);
+    }
+
+    SECTION("Leading whitespace and integers") {
+        REQUIRE(parse_leading_float("  3.25mm", value));
+        REQUIRE(value == 3.25f);
+        REQUIRE_FALSE(parse_leading_float("   ", value));
+
+        int count = 0;
+        REQUIRE(parse_leading_int(" 245", count));
+        REQUIRE(count == 245);
+        REQUIRE(parse_int("-12.7", count) == 3);
+        REQUIRE(count == -12);
+        REQUIRE(parse_int("99999999999", count) == 0);
+    }
+}
+
+TEST_CASE("GCode tokenizer - move words", "[gcode][tokenizer]") {
+    SECTION("All axes") {
+        MoveWords words = scan_move_words("G1 X10.5 Y-20 Z0.2 E1.25 F1800");
+        REQUIRE(words.has(MoveWords::X));
+        REQUIRE(words.has(MoveWords::Y));
+        REQUIRE(words.has(MoveWords::Z));
+        REQUIRE(words.has(MoveWords::E));
+        REQUIRE(words.x == 10.5f);
+        REQUIRE(words.y == -20.0f);
+        REQUIRE(words.z == 0.2f);
+        REQUIRE(words.e == 1.25f);
+    }
+
+    SECTION("Only the first occurrence of a letter counts") {
+        MoveWords words = scan_move_words("G1 X1 X2");
+        REQUIRE(words.x == 1.0f);
+
+        // First X is glued to another word, so there is no X at all
+        REQUIRE_FALSE(scan_move_words("G1 AX1 X2").has(MoveWords::X));
+    }
+
+    SECTION("Tabs separate words, empty values are ignored") {
+        MoveWords words = scan_move_words("G1\tY3 X E");
+        REQUIRE(words.has(MoveWords::Y));
+        REQUIRE(words.y == 3.0f);
+        REQUIRE_FALSE(words.has(MoveWords::X));
+        REQUIRE_FALSE(words.has(MoveWords::E));
+    }
+}
+
+TEST_CASE("GCode tokenizer - string parameters", "[gcode][tokenizer]") {
+    std::string_view value;
+    std::string_view line = "EXCLUDE_OBJECT_DEFINE NAME=part_1 CENTER=10,20 POLYGON=[[0,0],[1,1]]";
+
+    REQUIRE(find_string_param(line, "NAME", value));
+    REQUIRE(value == "part_1");
+    REQUIRE(find_string_param(line, "POLYGON", value));
+    REQUIRE(value == "[[0,0],[1,1]]");
+    REQUIRE_FALSE(find_string_param(line, "MISSING", value));
+    REQUIRE_FALSE(find_string_param("EXCLUDE_OBJECT_START NAME=", "NAME", value));
+
+    // A name without '=' is skipped in favour of a later match
+    REQUIRE(find_string_param("NAMES NAME=b", "NAME", value));
+    REQUIRE(value == "b");
+}
+
+TEST_CASE("GCodeParser - parse_buffer splits lines", "[gcode][parser][tokenizer]") {
+    const std::string gcode = "G90\r\n"
+                              "M83\n"
+                              "EXCLUDE_OBJECT_DEFINE NAME=cube CENTER=5,5 POLYGON=[[0,0],[10,10]]\n"
+                              "EXCLUDE_OBJECT_START NAME=cube\n"
+                              "G1 X0 Y0 Z0.2\n"
+                              "G1 X10 Y0 E0.5 ; perimeter\n"
+                              "\n"
+                              "G1 X10 Y10 E0.5\n"
+                              "EXCLUDE_OBJECT_END NAME=cube\n"
+                              "G1 X20 Y20"; // No trailing newline
+
+    ParsedGCodeFile expected = parse_lines(gcode);
+    REQUIRE(expected.total_segments == 3);
+
+    SECTION("Whole buffer") {
+        require_same_toolpath(parse_chunks(gcode, gcode.size()), expected);
+    }
+
+    SECTION("Every chunk size splits lines somewhere") {
+        for (size_t chunk : {1, 2, 3, 7, 16, 64}) {
+            CAPTURE(chunk);
+            ParsedGCodeFile result = parse_chunks(gcode, chunk);
+            require_same_toolpath(result, expected);
+            REQUIRE(result.objects.at("cube").polygon.size() == 2);
+        }
+    }
+
+    SECTION("Line count matches getline") {
+        GCodeParser parser;
+        parser.parse_buffer(gcode.data(), gcode.size());
+        REQUIRE(parser.lines_parsed() == 9); // Last line waits for finalize()
+        parser.finalize();
+    }
+}
+
+TEST_CASE("GCodeParser - parse_buffer matches parse_line on real files",
+          "[gcode][parser][tokenizer][integration]") {
+    auto files = test_gcode_files();
+    if (files.empty()) {
+        SKIP("assets/test_gcodes not found");
+    }
+
+    for (const auto& path : files) {
+        CAPTURE(path.string());
+        std::string content = read_file(path);
+        ParsedGCodeFile by_line = parse_lines(content);
+        ParsedGCodeFile by_buffer = parse_chunks(content, 4093);
+
+        require_same_toolpath(by_buffer, by_line);
+        REQUIRE(by_buffer.slicer_name == by_line.slicer_name);
+        REQUIRE(by_buffer.layer_height_mm == by_line.layer_height_mm);
+        REQUIRE(by_buffer.estimated_print_time_minutes == by_line.estimated_print_time_minutes);
+        REQUIRE(by_buffer.tool_color_palette == by_line.tool_color_palette);
+    }
+}
+
+TEST_CASE("GCodeParser - throughput", "[.benchmark][gcode][parser]") {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ROUNDS = 5;
+
+    auto files = test_gcode_files();
+    REQUIRE_FALSE(files.empty());
+
+    std::vector<std::string> contents;
+    size_t total_bytes = 0;
+    for (const auto& path : files) {
+        contents.push_back(read_file(path));
+        total_bytes += contents.back().size();
+    }
+    double total_mb = total_bytes / (1024.0 * 1024.0);
+
+    auto measure = [&](auto&& parse) {
+        double best_s = 1e9;
+        for (int round = 0; round < ROUNDS; round++) {
+            auto start = Clock::now();
+            for (const auto& content : contents) {
+                parse(content);
+            }
+            best_s = std::min(best_s, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+        return total_mb / best_s;
+    };
+
+    size_t segments = 0;
+    double buffer_mbps = measure([&](const std::string& content) {
+        segments += parse_chunks(content, 64 * 1024).total_segments;
+    });
+    double line_mbps = measure([](const std::string& content) { parse_lines(content); });
+
+    WARN("G-code parser: " << files.size() << " files, " << total_mb << " MB, "
+                           << segments / ROUNDS << " segments");
+    WARN("parse_buffer (64 KiB chunks): " << buffer_mbps << " MB/s");
+    WARN("getline + parse_line: " << line_mbps << " MB/s");
+
+    REQUIRE(segments > 0);
+}
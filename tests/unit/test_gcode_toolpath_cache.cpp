@@ -0,0 +1,257 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gcode_toolpath_cache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::gcode;
+namespace fs = std::filesystem;
+
+namespace {
+
+void write_file(const std::string& path, const std::string& content) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+}
+
+/// Fresh cache and G-code directories, removed afterwards
+class CacheDirs {
+  public:
+    CacheDirs() {
+        root_ = fs::temp_directory_path() / ("helix_toolpath_cache_" + std::to_string(rand()));
+        fs::create_directories(root_ / "gcodes");
+    }
+
+    ~CacheDirs() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    std::string cache_dir() const {
+        return (root_ / "cache").string();
+    }
+
+    std::string gcode(const std::string& name) const {
+        return (root_ / "gcodes" / name).string();
+    }
+
+  private:
+    fs::path root_;
+};
+
+ToolpathSegment make_segment(float x0, float y0, float x1, float y1, float z, bool extrude) {
+    ToolpathSegment seg;
+    seg.start = glm::vec3(x0, y0, z);
+    seg.end = glm::vec3(x1, y1, z);
+    seg.is_extrusion = extrude;
+    seg.extrusion_amount = extrude ? 0.04f : 0.0f;
+    seg.width = extrude ? 0.45f : 0.0f;
+    return seg;
+}
+
+/// A layer with chained perimeters, a travel jump, a z-hop, two objects and a tool change
+CompactSegments make_layer(int layer) {
+    float z = 0.2f * static_cast<float>(layer + 1);
+    CompactSegments segments;
+    const char* objects[] = {"cube", "cylinder"};
+    for (int o = 0; o < 2; ++o) {
+        float x0 = 10.0f + 50.0f * static_cast<float>(o);
+        for (int i = 0; i < 8; ++i) {
+            ToolpathSegment seg = make_segment(x0 + i, 10.0f, x0 + i + 1, 10.5f, z, true);
+            seg.object_name = objects[o];
+            seg.tool_index = (layer % 3 == 2 && o == 1) ? 1 : 0;
+            seg.extrusion_amount = 0.04f + 0.001f * static_cast<float>(i % 3);
+            segments.push_back(seg);
+        }
+        ToolpathSegment hop = make_segment(x0 + 8, 10.5f, x0 + 8, 10.5f, z, false);
+        hop.end.z = z + 0.4f;
+        segments.push_back(hop);
+        segments.push_back(make_segment(x0 + 8, 10.5f, x0 + 50.0f, 10.0f, z + 0.4f, false));
+    }
+    // Wipe tower far away: a delta too long for CompactSegments' int16 path
+    segments.push_back(make_segment(250.0f, 250.0f, 255.0f, 250.0f, z, true));
+    segments.shrink_to_fit();
+    return segments;
+}
+
+void require_same_segments(const CompactSegments& a, const CompactSegments& b,
+                           const std::vector<std::string>& names) {
+    std::vector<ToolpathSegment> va = a.to_vector();
+    std::vector<ToolpathSegment> vb = b.to_vector();
+    REQUIRE(va.size() == vb.size());
+    for (size_t i = 0; i < va.size(); ++i) {
+        INFO("segment " << i);
+        REQUIRE(va[i].start == vb[i].start);
+        REQUIRE(va[i].end == vb[i].end);
+        REQUIRE(va[i].is_extrusion == vb[i].is_extrusion);
+        REQUIRE(va[i].extrusion_amount == vb[i].extrusion_amount);
+        REQUIRE(va[i].width == vb[i].width);
+        REQUIRE(va[i].tool_index == vb[i].tool_index);
+        REQUIRE(va[i].object_name == vb[i].object_name);
+        if (!vb[i].object_name.empty()) {
+            REQUIRE(names.at(vb[i].object_id) == vb[i].object_name);
+        }
+    }
+}
+
+/// Store @p layers of make_layer() for @p path
+bool store_layers(ToolpathDiskCache& cache, const std::string& path, int layers) {
+    auto writer = cache.begin_store(path);
+    if (!writer) {
+        return false;
+    }
+    for (int layer = 0; layer < layers; ++layer) {
+        writer->add_layer(0.2f * static_cast<float>(layer + 1), make_layer(layer));
+    }
+    GCodeHeaderMetadata metadata;
+    metadata.slicer = "OrcaSlicer";
+    metadata.filament_type = "PETG";
+    metadata.estimated_time_seconds = 3600.0;
+    metadata.layer_count = static_cast<uint32_t>(layers);
+    metadata.tool_colors = {"#ED1C24", "#00C1AE"};
+    return cache.finish_store(*writer, metadata);
+}
+
+} // namespace
+
+TEST_CASE("ToolpathDiskCache - Round trip", "[gcode][toolpath_cache]") {
+    CacheDirs dirs;
+    std::string path = dirs.gcode("part.gcode");
+    write_file(path, "; stand-in for the G-code the layers came from\n");
+
+    ToolpathDiskCache cache(dirs.cache_dir());
+    REQUIRE(cache.load(path) == nullptr);
+    REQUIRE(store_layers(cache, path, 12));
+    REQUIRE(fs::exists(cache.get_cache_path(path)));
+    REQUIRE_FALSE(fs::exists(cache.get_cache_path(path) + ".tmp"));
+
+    auto file = cache.load(path);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->layer_count() == 12);
+    REQUIRE(file->object_names() == std::vector<std::string>{"cube", "cylinder"});
+    REQUIRE(file->metadata().slicer == "OrcaSlicer");
+    REQUIRE(file->metadata().filament_type == "PETG");
+    REQUIRE(file->metadata().estimated_time_seconds == 3600.0);
+    REQUIRE(file->metadata().layer_count == 12);
+    REQUIRE(file->metadata().tool_colors == std::vector<std::string>{"#ED1C24", "#00C1AE"});
+
+    // Random access, top layer first
+    for (size_t layer : {11u, 0u, 5u}) {
+        INFO("layer " << layer);
+        CompactSegments expected = make_layer(static_cast<int>(layer));
+        CompactSegments loaded;
+        REQUIRE(file->load_layer(layer, loaded));
+        REQUIRE(file->layer_segment_count(layer) == expected.size());
+        REQUIRE(file->layer_z(layer) == 0.2f * static_cast<float>(layer + 1));
+        require_same_segments(expected, loaded, file->object_names());
+    }
+
+    CompactSegments none;
+    REQUIRE_FALSE(file->load_layer(12, none));
+    REQUIRE(none.empty());
+}
+
+TEST_CASE("ToolpathDiskCache - Stale or damaged files are ignored", "[gcode][toolpath_cache]") {
+    CacheDirs dirs;
+    std::string path = dirs.gcode("part.gcode");
+    write_file(path, "G1 X1 Y1\n");
+
+    ToolpathDiskCache cache(dirs.cache_dir());
+    REQUIRE(store_layers(cache, path, 4));
+    std::string cache_path = cache.get_cache_path(path);
+
+    SECTION("G-code changed with the same size and mtime") {
+        auto mtime = fs::last_write_time(path);
+        write_file(path, "G1 X2 Y1\n");
+        fs::last_write_time(path, mtime);
+        REQUIRE(cache.load(path) == nullptr);
+        REQUIRE_FALSE(fs::exists(cache_path)); // Dropped on mismatch
+    }
+
+    SECTION("truncated file") {
+        fs::resize_file(cache_path, fs::file_size(cache_path) - 3);
+        REQUIRE(cache.load(path) == nullptr);
+    }
+
+    SECTION("damaged layer") {
+        {
+            std::fstream file(cache_path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(2);
+            file.put('\x7f');
+        }
+        auto file = cache.load(path);
+        REQUIRE(file != nullptr); // Tables are intact
+        CompactSegments segments;
+        REQUIRE_FALSE(file->load_layer(0, segments));
+        REQUIRE(file->load_layer(1, segments));
+    }
+
+    SECTION("abandoned writer leaves nothing behind") {
+        cache.remove(path);
+        {
+            auto writer = cache.begin_store(path);
+            REQUIRE(writer != nullptr);
+            writer->add_layer(0.2f, make_layer(0));
+        }
+        REQUIRE_FALSE(fs::exists(cache_path));
+        REQUIRE_FALSE(fs::exists(cache_path + ".tmp"));
+    }
+}
+
+TEST_CASE("ToolpathDiskCache - Size limit", "[gcode][toolpath_cache]") {
+    CacheDirs dirs;
+    std::vector<std::string> paths;
+    for (const char* name : {"a.gcode", "b.gcode", "c.gcode"}) {
+        paths.push_back(dirs.gcode(name));
+        write_file(paths.back(), std::string("; ") + name + "\n");
+    }
+
+    size_t file_size = 0;
+    {
+        ToolpathDiskCache sizing((fs::path(dirs.cache_dir()) / "sizing").string());
+        REQUIRE(store_layers(sizing, paths[0], 12));
+        file_size = sizing.get_cache_size();
+        REQUIRE(file_size > 0);
+    }
+
+    SECTION("the new file is kept and the oldest evicted") {
+        ToolpathDiskCache cache(dirs.cache_dir(), file_size * 5 / 2);
+        REQUIRE(store_layers(cache, paths[0], 12));
+        REQUIRE(store_layers(cache, paths[1], 12));
+        auto old_time = fs::file_time_type::clock::now() - std::chrono::hours(1);
+        fs::last_write_time(cache.get_cache_path(paths[0]), old_time);
+        fs::last_write_time(cache.get_cache_path(paths[1]), old_time + std::chrono::minutes(1));
+
+        REQUIRE(store_layers(cache, paths[2], 12));
+        REQUIRE_FALSE(fs::exists(cache.get_cache_path(paths[0])));
+        REQUIRE(fs::exists(cache.get_cache_path(paths[1])));
+        REQUIRE(fs::exists(cache.get_cache_path(paths[2])));
+    }
+
+    SECTION("the new file is kept even when it is the oldest") {
+        ToolpathDiskCache cache(dirs.cache_dir(), file_size * 3 / 2);
+        REQUIRE(store_layers(cache, paths[0], 12));
+        // A later mtime on the existing file than the one being stored
+        fs::last_write_time(cache.get_cache_path(paths[0]),
+                            fs::file_time_type::clock::now() + std::chrono::hours(1));
+
+        REQUIRE(store_layers(cache, paths[1], 12));
+        REQUIRE_FALSE(fs::exists(cache.get_cache_path(paths[0])));
+        REQUIRE(fs::exists(cache.get_cache_path(paths[1])));
+    }
+
+    SECTION("a file larger than the whole cache is not stored") {
+        ToolpathDiskCache cache(dirs.cache_dir(), file_size * 3 / 2);
+        REQUIRE(store_layers(cache, paths[0], 1));
+        REQUIRE_FALSE(store_layers(cache, paths[1], 24));
+        REQUIRE_FALSE(fs::exists(cache.get_cache_path(paths[1])));
+        REQUIRE_FALSE(fs::exists(cache.get_cache_path(paths[1]) + ".tmp"));
+        REQUIRE(fs::exists(cache.get_cache_path(paths[0])));
+    }
+}
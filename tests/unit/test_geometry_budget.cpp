@@ -110,6 +110,16 @@ TEST_CASE("Budget: tier selection - tiny budget forces high tier", "[gcode][budg
     REQUIRE(config.tier >= 3);
 }
 
+TEST_CASE("Budget: tier selection - minimum tier skips cheaper tiers", "[gcode][budget]") {
+    GeometryBudgetManager mgr;
+    REQUIRE(mgr.select_tier(50000, 256 * 1024 * 1024, 2).tier == 2);
+    REQUIRE(mgr.select_tier(50000, 256 * 1024 * 1024, 2).tube_sides == 8);
+    REQUIRE(mgr.select_tier(0, 256 * 1024 * 1024, 2).tier == 2);
+    REQUIRE(mgr.select_tier(150000, 150 * 1024 * 1024, 3).tier == 3);
+    // A floor never rescues a file that does not fit at all
+    REQUIRE(mgr.select_tier(2000000, 75 * 1024 * 1024, 2).tier == 4);
+}
+
 TEST_CASE("Budget: tier selection - 0 segments gets Tier 1", "[gcode][budget]") {
     GeometryBudgetManager mgr;
     auto config = mgr.select_tier(0, 256 * 1024 * 1024);
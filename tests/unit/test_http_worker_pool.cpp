@@ -0,0 +1,345 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_http_worker_pool.cpp
+ * @brief Unit tests for the HTTP worker pool behind MoonrakerFileTransferAPI
+ *
+ * Scheduling tests use jobs that never touch the network. Transfer tests run
+ * against MockHttpServer, a local stand-in for Moonraker's /server/files.
+ */
+
+#include "../../include/http_worker_pool.h"
+#include "../../include/moonraker_client_mock.h"
+#include "../../include/moonraker_file_transfer_api.h"
+#include "../mocks/mock_http_server.h"
+
+#include "hv/HttpMessage.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+
+namespace {
+
+/// Holds a worker inside a job until released (declare before the pool)
+class Gate {
+  public:
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entered_++;
+        changed_.notify_all();
+        changed_.wait(lock, [this]() { return open_; });
+    }
+
+    void wait_entered(int count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait_for(lock, std::chrono::seconds(5), [&]() { return entered_ >= count; });
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        changed_.notify_all();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    int entered_ = 0;
+    bool open_ = false;
+};
+
+/// Poll until @p done returns true or a 5 second timeout expires
+template <typename Pred> bool wait_until(Pred done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+std::shared_ptr<HttpRequest> get_request(const std::string& url) {
+    auto req = std::make_shared<HttpRequest>();
+    req->method = HTTP_GET;
+    req->url = url;
+    req->timeout = 5;
+    return req;
+}
+
+} // namespace
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST_CASE("HttpWorkerPool: higher lanes run first", "[http_pool]") {
+    Gate gate;
+    HttpWorkerPool pool(1);
+    pool.submit(HttpPriority::VISIBLE, [&gate](HttpWorkerPool::Context&) { gate.wait(); });
+    gate.wait_entered(1);
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    auto record = [&](std::string name) {
+        return [&, name](HttpWorkerPool::Context&) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(name);
+        };
+    };
+    pool.submit(HttpPriority::BACKGROUND, record("background"));
+    pool.submit(HttpPriority::PREFETCH, record("prefetch-1"));
+    pool.submit(HttpPriority::VISIBLE, record("visible"));
+    pool.submit(HttpPriority::PREFETCH, record("prefetch-2"));
+
+    gate.open();
+    REQUIRE(wait_until([&]() {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        return order.size() == 4;
+    }));
+    REQUIRE(order ==
+            std::vector<std::string>{"visible", "prefetch-1", "prefetch-2", "background"});
+}
+
+TEST_CASE("HttpWorkerPool: background transfers leave a worker free", "[http_pool]") {
+    Gate gate;
+    HttpWorkerPool pool(2);
+    std::atomic<int> background_started{0};
+    for (int i = 0; i < 2; ++i) {
+        pool.submit(HttpPriority::BACKGROUND, [&](HttpWorkerPool::Context&) {
+            background_started++;
+            gate.wait();
+        });
+    }
+    gate.wait_entered(1);
+
+    std::atomic<bool> visible_ran{false};
+    pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { visible_ran = true; });
+    REQUIRE(wait_until([&]() { return visible_ran.load(); }));
+    REQUIRE(background_started == 1);
+
+    gate.open();
+    REQUIRE(wait_until([&]() { return background_started.load() == 2; }));
+}
+
+TEST_CASE("HttpWorkerPool: cancellation", "[http_pool]") {
+    Gate gate;
+    HttpWorkerPool pool(1);
+    std::atomic<bool> saw_cancel{false};
+    std::atomic<bool> running_reported{false};
+    auto running = pool.submit(
+        HttpPriority::VISIBLE,
+        [&](HttpWorkerPool::Context& ctx) {
+            gate.wait();
+            saw_cancel = ctx.cancelled();
+        },
+        {}, [&]() { running_reported = true; });
+    gate.wait_entered(1);
+
+    std::atomic<int> ran{0};
+    auto queued = pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { ran++; });
+    pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { ran++; }, "cube.png");
+    pool.submit(HttpPriority::PREFETCH, [&](HttpWorkerPool::Context&) { ran++; }, "cube.png");
+    pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { ran++; }, "other.png");
+
+    std::atomic<int> cancel_handlers{0};
+    pool.submit(
+        HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { ran++; }, "cube.png",
+        [&]() { cancel_handlers++; });
+
+    REQUIRE(pool.cancel(queued));
+    REQUIRE_FALSE(pool.cancel(queued));
+    REQUIRE(pool.cancel_key("cube.png") == 3);
+    REQUIRE(cancel_handlers == 1); // Called on this thread, before cancel_key() returns
+    REQUIRE(pool.cancel_key("") == 0);
+    REQUIRE(pool.cancel(running)); // Running jobs are flagged
+
+    REQUIRE_FALSE(running_reported); // Reported once the running job returns
+
+    gate.open();
+    REQUIRE(wait_until([&]() { return ran.load() == 1 && running_reported.load(); }));
+    pool.shutdown(std::chrono::seconds(2)); // Joins workers so every job is accounted for
+    REQUIRE(saw_cancel);
+
+    auto stats = pool.take_stats();
+    const auto& visible = stats.lanes[static_cast<size_t>(HttpPriority::VISIBLE)];
+    const auto& prefetch = stats.lanes[static_cast<size_t>(HttpPriority::PREFETCH)];
+    REQUIRE(visible.cancelled == 4);
+    REQUIRE(visible.completed == 2); // The flagged job still ran to completion
+    REQUIRE(prefetch.cancelled == 1);
+    REQUIRE(prefetch.completed == 0);
+}
+
+TEST_CASE("HttpWorkerPool: queue wait and run time metrics", "[http_pool]") {
+    Gate gate;
+    HttpWorkerPool pool(1);
+    pool.submit(HttpPriority::VISIBLE, [&gate](HttpWorkerPool::Context&) { gate.wait(); });
+    gate.wait_entered(1);
+
+    std::atomic<bool> done{false};
+    pool.submit(HttpPriority::PREFETCH, [&](HttpWorkerPool::Context&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        done = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate.open();
+    REQUIRE(wait_until([&]() { return done.load(); }));
+    pool.shutdown(std::chrono::seconds(2));
+
+    auto stats = pool.take_stats();
+    const auto& prefetch = stats.lanes[static_cast<size_t>(HttpPriority::PREFETCH)];
+    REQUIRE(stats.peak_queued == 1);
+    REQUIRE(stats.active == 0);
+    REQUIRE(prefetch.completed == 1);
+    REQUIRE(prefetch.wait_max_us >= 20'000);
+    REQUIRE(prefetch.run_max_us >= 20'000);
+    REQUIRE(prefetch.avg_run_ms() >= 20.0);
+}
+
+TEST_CASE("HttpWorkerPool: shutdown drops queued jobs", "[http_pool]") {
+    Gate gate;
+    HttpWorkerPool pool(1);
+    pool.submit(HttpPriority::VISIBLE, [&gate](HttpWorkerPool::Context&) { gate.wait(); });
+    gate.wait_entered(1);
+
+    std::atomic<bool> ran{false};
+    pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context&) { ran = true; });
+
+    std::thread opener([&gate]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        gate.open();
+    });
+    pool.shutdown(std::chrono::seconds(2));
+    opener.join();
+
+    REQUIRE_FALSE(ran);
+    REQUIRE(pool.submit(HttpPriority::VISIBLE, [](HttpWorkerPool::Context&) {}) == 0);
+}
+
+// ============================================================================
+// Transfers against the stand-in server
+// ============================================================================
+
+TEST_CASE("HttpWorkerPool: transfers reuse keep-alive connections", "[http_pool][slow]") {
+    MockHttpServer server;
+    server.add_file("gcodes/.thumbs/cube.png", std::string(4096, 'x'));
+    REQUIRE(server.start() > 0);
+    std::string url = server.base_url() + "/server/files/gcodes/.thumbs/cube.png";
+
+    HttpWorkerPool pool(1);
+    constexpr int REQUESTS = 20;
+    std::atomic<int> ok{0};
+    for (int i = 0; i < REQUESTS; ++i) {
+        pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context& ctx) {
+            auto resp = ctx.send(get_request(url));
+            if (resp && resp->status_code == 200 && resp->body.size() == 4096) {
+                ok++;
+            }
+        });
+    }
+
+    REQUIRE(wait_until([&]() { return server.request_count() == REQUESTS; }));
+    REQUIRE(wait_until([&]() { return ok.load() == REQUESTS; }));
+    REQUIRE(server.connection_count() == 1);
+}
+
+TEST_CASE("HttpWorkerPool: range requests and errors", "[http_pool][slow]") {
+    MockHttpServer server;
+    server.add_file("gcodes/benchy.gcode", "; preamble\nG28\nG1 X10\n");
+    REQUIRE(server.start() > 0);
+
+    HttpWorkerPool pool(2);
+    std::atomic<int> partial_status{0};
+    std::string partial_body;
+    std::atomic<bool> missing_done{false};
+    int missing_status = 0;
+
+    pool.submit(HttpPriority::PREFETCH, [&](HttpWorkerPool::Context& ctx) {
+        auto req = get_request(server.base_url() + "/server/files/gcodes/benchy.gcode");
+        req->SetHeader("Range", "bytes=0-9");
+        auto resp = ctx.send(req);
+        partial_body = resp ? resp->body : "";
+        partial_status = resp ? static_cast<int>(resp->status_code) : -1;
+    });
+    pool.submit(HttpPriority::PREFETCH, [&](HttpWorkerPool::Context& ctx) {
+        auto resp = ctx.send(get_request(server.base_url() + "/server/files/gcodes/nope.gcode"));
+        missing_status = resp ? static_cast<int>(resp->status_code) : -1;
+        missing_done = true;
+    });
+
+    REQUIRE(wait_until([&]() { return partial_status.load() != 0 && missing_done.load(); }));
+    REQUIRE(partial_status == 206);
+    REQUIRE(partial_body == "; preamble");
+    REQUIRE(missing_status == 404);
+
+    SECTION("a stopped server yields a null response") {
+        server.stop();
+        std::atomic<int> result{0};
+        pool.submit(HttpPriority::VISIBLE, [&](HttpWorkerPool::Context& ctx) {
+            result = ctx.send(get_request(server.base_url() + "/server/files/gcodes/x")) ? 1 : 2;
+        });
+        REQUIRE(wait_until([&]() { return result.load() != 0; }));
+        REQUIRE(result == 2);
+    }
+}
+
+TEST_CASE("MoonrakerFileTransferAPI: thumbnail cancellation is scoped to its requester",
+          "[http_pool][slow]") {
+    MockHttpServer server;
+    server.add_file("gcodes/.thumbs/cube.png", std::string(1024, 'x'));
+    server.set_response_delay_ms(100);
+    REQUIRE(server.start() > 0);
+    std::string base_url = server.base_url();
+
+    MoonrakerClientMock client(MoonrakerClientMock::PrinterType::VORON_24);
+    MoonrakerFileTransferAPI api(client, base_url);
+
+    auto dir = std::filesystem::temp_directory_path() / "helix_test_thumb_cancel";
+    std::filesystem::create_directories(dir);
+
+    // Occupy every worker so both requests below are still queued when one cancels
+    std::atomic<int> fillers{0};
+    for (size_t i = 0; i < MoonrakerFileTransferAPI::HTTP_WORKERS; ++i) {
+        api.download_thumbnail(
+            ".thumbs/cube.png", (dir / ("filler" + std::to_string(i))).string(),
+            [&](const std::string&) { fillers++; }, [&](const MoonrakerError&) { fillers++; });
+    }
+
+    std::atomic<MoonrakerErrorType> panel_error{MoonrakerErrorType::NONE};
+    std::atomic<bool> panel_success{false};
+    std::atomic<bool> media_success{false};
+    api.download_thumbnail(
+        ".thumbs/cube.png", (dir / "panel.png").string(),
+        [&](const std::string&) { panel_success = true; },
+        [&](const MoonrakerError& err) { panel_error = err.type; }, HttpPriority::VISIBLE,
+        "print_select:.thumbs/cube.png");
+    api.download_thumbnail(
+        ".thumbs/cube.png", (dir / "media.png").string(),
+        [&](const std::string&) { media_success = true; }, [](const MoonrakerError&) {},
+        HttpPriority::VISIBLE, "active_media:.thumbs/cube.png");
+
+    REQUIRE(api.cancel_thumbnail("print_select:.thumbs/cube.png"));
+    REQUIRE_FALSE(api.cancel_thumbnail(".thumbs/cube.png")); // Bare paths match nothing
+
+    REQUIRE(wait_until([&]() { return media_success.load(); }));
+    const int workers = static_cast<int>(MoonrakerFileTransferAPI::HTTP_WORKERS);
+    REQUIRE(wait_until([&]() { return fillers.load() == workers; }));
+    REQUIRE(panel_error == MoonrakerErrorType::CANCELLED);
+    REQUIRE_FALSE(panel_success);
+    REQUIRE(std::filesystem::exists(dir / "media.png"));
+
+    std::filesystem::remove_all(dir);
+}
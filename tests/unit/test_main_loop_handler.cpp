@@ -148,13 +148,34 @@ TEST_CASE("MainLoopHandler: benchmark mode", "[mainloop][application]") {
         REQUIRE(final_report.total_runtime_sec == Catch::Approx(5.0).epsilon(0.01));
     }
 
+    SECTION("reports status dispatch timing") {
+        handler.init(config, 0);
+        handler.benchmark_record_dispatch(3, 30000, 20000);
+        handler.benchmark_record_dispatch(1, 10000, 10000);
+        handler.on_frame(1000);
+
+        auto report = handler.benchmark_get_report();
+        REQUIRE(report.dispatch_count == 4);
+        REQUIRE(report.dispatch_avg_us == Catch::Approx(10.0f));
+        REQUIRE(report.dispatch_max_us == Catch::Approx(20.0f));
+
+        // Consumed with the report
+        handler.on_frame(2000);
+        auto next = handler.benchmark_get_report();
+        REQUIRE(next.dispatch_count == 0);
+        REQUIRE(next.dispatch_avg_us == 0.0f);
+        REQUIRE(next.dispatch_max_us == 0.0f);
+    }
+
     SECTION("benchmark disabled doesn't track") {
         config.benchmark_mode = false;
         handler.init(config, 0);
         handler.on_frame(100);
         handler.on_frame(200);
+        handler.benchmark_record_dispatch(1, 1000, 1000);
         REQUIRE(handler.benchmark_frame_count() == 0);
         REQUIRE_FALSE(handler.benchmark_should_report());
+        REQUIRE(handler.benchmark_get_report().dispatch_count == 0);
     }
 }
 
@@ -0,0 +1,170 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_moonraker_frame_log.cpp
+ * @brief Moonraker frame log format, client recording and replay
+ */
+
+#include "../../include/moonraker_client.h"
+#include "../../include/moonraker_frame_log.h"
+#include "../mocks/frame_replayer.h"
+#include "../mocks/mock_websocket_server.h"
+#include "hv/EventLoopThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+
+namespace {
+
+std::string temp_log_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<LoggedFrame> read_all(const std::string& path) {
+    std::vector<LoggedFrame> frames;
+    FrameLogReader reader;
+    if (!reader.open(path)) {
+        return frames;
+    }
+    LoggedFrame frame;
+    while (reader.next(frame)) {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+/// Poll until @p done returns true or a 5 second timeout expires
+template <typename Pred> bool wait_until(Pred done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("FrameLog: round trip", "[moonraker][frame_log]") {
+    std::string path = temp_log_path("helix_test_frames.hxframes");
+    std::string big(300, 'x'); // Multi-byte length varint
+
+    FrameLogWriter writer;
+    REQUIRE(writer.open(path));
+    writer.append(R"({"jsonrpc":"2.0","method":"notify_status_update"})", 0);
+    writer.append("", 150);
+    writer.append(big, 1'000'000);
+    writer.append("late", 900'000); // Clamped to the previous timestamp
+    REQUIRE(writer.frame_count() == 4);
+    REQUIRE(writer.byte_count() == 49 + big.size() + 4);
+    writer.close();
+
+    auto frames = read_all(path);
+    REQUIRE(frames.size() == 4);
+    REQUIRE(frames[0].payload == R"({"jsonrpc":"2.0","method":"notify_status_update"})");
+    REQUIRE(frames[0].time_us == 0);
+    REQUIRE(frames[1].payload.empty());
+    REQUIRE(frames[1].time_us == 150);
+    REQUIRE(frames[2].payload == big);
+    REQUIRE(frames[2].time_us == 1'000'000);
+    REQUIRE(frames[3].time_us == 1'000'000);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FrameLog: damaged logs", "[moonraker][frame_log]") {
+    std::string path = temp_log_path("helix_test_frames_damaged.hxframes");
+
+    SECTION("truncated final record keeps the frames before it") {
+        {
+            FrameLogWriter writer;
+            REQUIRE(writer.open(path));
+            writer.append("first", 10);
+            writer.append("second", 20);
+        }
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+        auto frames = read_all(path);
+        REQUIRE(frames.size() == 1);
+        REQUIRE(frames[0].payload == "first");
+    }
+
+    SECTION("wrong magic is rejected") {
+        std::ofstream(path, std::ios::binary) << "NOTFRAMES";
+        FrameLogReader reader;
+        REQUIRE_FALSE(reader.open(path));
+    }
+
+    SECTION("missing file") {
+        std::filesystem::remove(path);
+        FrameLogReader reader;
+        REQUIRE_FALSE(reader.open(path));
+        LoggedFrame frame;
+        REQUIRE_FALSE(reader.next(frame));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FrameLog: client recording replays identically", "[moonraker][frame_log][slow]") {
+    std::string recorded = temp_log_path("helix_test_frames_recorded.hxframes");
+    std::string replayed = temp_log_path("helix_test_frames_replayed.hxframes");
+
+    MockWebSocketServer server;
+    REQUIRE(server.start(0) > 0);
+    auto loop_thread = std::make_shared<hv::EventLoopThread>();
+    loop_thread->start();
+    auto client = std::make_unique<MoonrakerClient>(loop_thread->loop());
+    client->setReconnect(nullptr);
+
+    std::atomic<bool> connected{false};
+    client->connect(server.url().c_str(), [&connected]() { connected = true; }, []() {});
+    REQUIRE(wait_until([&]() { return connected.load(); }));
+
+    REQUIRE(client->start_frame_recording(recorded));
+    uint64_t base = client->frames_received();
+    for (int i = 0; i < 3; ++i) {
+        server.send_notification("notify_gcode_response", json::array({"ok " + std::to_string(i)}));
+    }
+    REQUIRE(wait_until([&]() { return client->frames_received() == base + 3; }));
+    client->stop_frame_recording();
+
+    auto frames = read_all(recorded);
+    REQUIRE(frames.size() == 3);
+    REQUIRE(frames[2].payload.find("ok 2") != std::string::npos);
+    REQUIRE(frames[0].time_us <= frames[2].time_us);
+
+    // Play the recording back into the same client while recording again
+    REQUIRE(client->start_frame_recording(replayed));
+    FrameReplayer replayer(server);
+    FrameReplayer::Options options;
+    options.speed = 0.0;
+    auto result = replayer.replay_file(recorded, options);
+    REQUIRE(result.frames_sent == 3);
+    REQUIRE(wait_until([&]() { return client->frames_received() == base + 6; }));
+    client->stop_frame_recording();
+
+    auto again = read_all(replayed);
+    REQUIRE(again.size() == 3);
+    for (size_t i = 0; i < again.size(); ++i) {
+        REQUIRE(again[i].payload == frames[i].payload);
+    }
+
+    loop_thread->stop();
+    loop_thread->join();
+    client.reset();
+    server.stop();
+    std::filesystem::remove(recorded);
+    std::filesystem::remove(replayed);
+}
@@ -586,6 +586,55 @@ TEST_CASE("MoonrakerClientMock callback invocation", "[connection][slow][callbac
     }
 }
 
+TEST_CASE("MoonrakerClient shared notify subscribers share one document",
+          "[connection][callbacks]") {
+    TestableMoonrakerMock mock(MoonrakerClientMock::PrinterType::VORON_24);
+
+    std::vector<SharedJson> received_a;
+    std::vector<SharedJson> received_b;
+    std::vector<json> received_legacy;
+
+    SubscriptionId id_a = mock.register_notify_update_shared(
+        [&received_a](const SharedJson& n) { received_a.push_back(n); });
+    SubscriptionId id_b = mock.register_notify_update_shared(
+        [&received_b](const SharedJson& n) { received_b.push_back(n); });
+    SubscriptionId id_legacy =
+        mock.register_notify_update([&received_legacy](json n) { received_legacy.push_back(n); });
+    REQUIRE(id_a != INVALID_SUBSCRIPTION_ID);
+    REQUIRE(id_b != INVALID_SUBSCRIPTION_ID);
+    REQUIRE(id_legacy != INVALID_SUBSCRIPTION_ID);
+
+    SECTION("every shared subscriber receives the same parsed instance") {
+        mock.dispatch_status_update({{"extruder", {{"temperature", 201.5}}}});
+
+        REQUIRE(received_a.size() == 1);
+        REQUIRE(received_b.size() == 1);
+        REQUIRE(received_a[0].get() == received_b[0].get());
+        REQUIRE((*received_a[0])["params"][0]["extruder"]["temperature"].get<double>() ==
+                Catch::Approx(201.5));
+    }
+
+    SECTION("legacy by-value subscribers still receive the full notification") {
+        mock.dispatch_status_update({{"heater_bed", {{"target", 60.0}}}});
+
+        REQUIRE(received_legacy.size() == 1);
+        REQUIRE(received_legacy[0]["method"] == "notify_status_update");
+        REQUIRE(received_legacy[0] == *received_a[0]);
+    }
+
+    SECTION("unsubscribed shared callbacks are not invoked") {
+        REQUIRE(mock.unsubscribe_notify_update(id_b));
+        mock.dispatch_status_update({{"toolhead", {{"homed_axes", "xyz"}}}});
+
+        REQUIRE(received_a.size() == 1);
+        REQUIRE(received_b.empty());
+    }
+
+    SECTION("null shared callback is rejected") {
+        REQUIRE(mock.register_notify_update_shared(nullptr) == INVALID_SUBSCRIPTION_ID);
+    }
+}
+
 // ============================================================================
 // G-code Temperature Parsing Tests
 // ============================================================================
@@ -0,0 +1,265 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_moonraker_replay_benchmark.cpp
+ * @brief Deterministic Moonraker throughput benchmark (make bench-replay)
+ *
+ * Streams Moonraker traffic through a real MoonrakerClient into PrinterState
+ * and a headless LVGL screen, the same path a printer's status updates take in
+ * the application: WebSocket thread -> StatusFrameDecoder -> UpdateQueue ->
+ * subjects -> render.
+ *
+ * The traffic is a synthetic print by default, or a HELIX_RECORD_FRAMES capture
+ * given in HELIX_REPLAY_LOG. HELIX_REPLAY_SPEED paces it against the recording
+ * (1 = real time, 10 = ten times faster, 0 or unset = as fast as the client
+ * keeps up).
+ *
+ * Reports frames parsed per second, UI queue latency percentiles, LVGL
+ * refresh time and RSS.
+ */
+
+#include "../../include/memory_utils.h"
+#include "../../include/moonraker_client.h"
+#include "../../include/printer_state.h"
+#include "../lvgl_test_fixture.h"
+#include "../mocks/frame_replayer.h"
+#include "../mocks/mock_websocket_server.h"
+#include "../test_helpers/printer_state_test_access.h"
+#include "../test_helpers/update_queue_test_access.h"
+#include "app_globals.h"
+#include "hv/EventLoopThread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+using namespace helix::ui;
+
+namespace {
+
+constexpr int SYNTHETIC_FRAMES = 20000;
+constexpr uint64_t SYNTHETIC_INTERVAL_US = 20000; // Klipper's 50 Hz status rate while printing
+
+/**
+ * @brief A print's worth of traffic: status updates plus the odd reply and
+ *        proc_stat notification, identical on every run
+ */
+std::vector<LoggedFrame> synthetic_print() {
+    std::vector<LoggedFrame> frames;
+    frames.reserve(SYNTHETIC_FRAMES + SYNTHETIC_FRAMES / 50);
+    for (int i = 0; i < SYNTHETIC_FRAMES; ++i) {
+        double t = i * (SYNTHETIC_INTERVAL_US / 1e6);
+        double x = 100.0 + 80.0 * ((i % 200) / 200.0);
+        json status = {
+            {"extruder", {{"temperature", 215.0 + (i % 7) * 0.1}, {"target", 215.0}}},
+            {"heater_bed", {{"temperature", 60.0 + (i % 5) * 0.1}, {"target", 60.0}}},
+            {"toolhead", {{"position", {x, 120.0, 0.2 + (i / 2000) * 0.2, i * 0.05}}}},
+            {"motion_report", {{"live_position", {x, 120.0, 0.2, i * 0.05}},
+                               {"live_velocity", 150.0}}},
+            {"virtual_sdcard", {{"progress", static_cast<double>(i) / SYNTHETIC_FRAMES}}},
+            {"print_stats", {{"print_duration", t}, {"filament_used", i * 0.05}}},
+        };
+        if (i % 10 == 0) {
+            status["fan"] = {{"speed", (i % 100) / 100.0}};
+        }
+        json frame = {{"jsonrpc", "2.0"},
+                      {"method", "notify_status_update"},
+                      {"params", {status, 1000.0 + t}}};
+        uint64_t time_us = static_cast<uint64_t>(i) * SYNTHETIC_INTERVAL_US;
+        frames.push_back({time_us, frame.dump()});
+
+        if (i % 100 == 50) {
+            json proc = {{"jsonrpc", "2.0"},
+                         {"method", "notify_proc_stat_update"},
+                         {"params", {{{"moonraker_stats", {{"cpu_usage", 2.5}}}}}}};
+            frames.push_back({time_us + 1, proc.dump()});
+        }
+        if (i % 100 == 75) {
+            // Reply to a request this client never sent; the replayer skips it
+            frames.push_back({time_us + 1, R"({"jsonrpc": "2.0", "result": "ok", "id": 1})"});
+        }
+    }
+    return frames;
+}
+
+double env_double(const char* name, double fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? std::atof(value) : fallback;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(p / 100.0 * samples.size()));
+    return samples[index];
+}
+
+class ReplayBenchmarkFixture : public LVGLTestFixture {
+  public:
+    ReplayBenchmarkFixture() {
+        PrinterStateTestAccess::reset(get_printer_state());
+        get_printer_state().init_subjects(false);
+
+        server_ = std::make_unique<MockWebSocketServer>();
+        if (server_->start(0) <= 0) {
+            throw std::runtime_error("Failed to start mock server");
+        }
+        loop_thread_ = std::make_shared<hv::EventLoopThread>();
+        loop_thread_->start();
+        client_ = std::make_unique<MoonrakerClient>(loop_thread_->loop());
+        client_->setReconnect(nullptr);
+    }
+
+    ~ReplayBenchmarkFixture() override {
+        loop_thread_->stop();
+        loop_thread_->join();
+        client_.reset();
+        server_->stop();
+        UpdateQueueTestAccess::drain(UpdateQueue::instance());
+    }
+
+    /// Widgets bound to the subjects a status frame touches, so updates cost a redraw
+    void build_screen() {
+        PrinterState& state = get_printer_state();
+        lv_subject_t* subjects[] = {state.get_active_extruder_temp_subject(),
+                                    state.get_bed_temp_subject(),
+                                    state.get_print_progress_subject(),
+                                    state.get_position_x_subject()};
+        int y = 0;
+        for (lv_subject_t* subject : subjects) {
+            lv_obj_t* label = lv_label_create(test_screen());
+            lv_obj_set_pos(label, 10, y);
+            lv_label_bind_text(label, subject, "%d");
+            y += 40;
+        }
+    }
+
+    std::unique_ptr<MockWebSocketServer> server_;
+    std::shared_ptr<hv::EventLoopThread> loop_thread_;
+    std::unique_ptr<MoonrakerClient> client_;
+};
+
+} // namespace
+
+TEST_CASE_METHOD(ReplayBenchmarkFixture, "Moonraker replay throughput",
+                 "[.benchmark][replay][moonraker]") {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<LoggedFrame> frames;
+    const char* log_path = std::getenv("HELIX_REPLAY_LOG");
+    if (log_path && *log_path) {
+        FrameLogReader reader;
+        REQUIRE(reader.open(log_path));
+        LoggedFrame frame;
+        while (reader.next(frame)) {
+            frames.push_back(std::move(frame));
+        }
+    } else {
+        frames = synthetic_print();
+    }
+    REQUIRE_FALSE(frames.empty());
+
+    build_screen();
+
+    // Same hand-off as MoonrakerManager: frames go straight to PrinterState from the WS thread
+    std::atomic<uint64_t> status_frames{0};
+    auto subscription = client_->register_status_frame_callback([&](const SharedStatusFrame& f) {
+        get_printer_state().update_from_frame_shared(f);
+        status_frames++;
+    });
+
+    std::atomic<bool> connected{false};
+    client_->connect(server_->url().c_str(), [&connected]() { connected = true; }, []() {});
+    for (int i = 0; i < 50 && !connected; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    REQUIRE(connected);
+
+    int64_t rss_start_kb = 0;
+    int64_t hwm_kb = 0;
+    read_memory_stats(rss_start_kb, hwm_kb);
+    UpdateQueue::instance().take_stats(); // Start the counters from zero
+
+    FrameReplayer::Options options;
+    options.speed = env_double("HELIX_REPLAY_SPEED", 0.0);
+    options.frames_consumed = [this]() { return client_->frames_received(); };
+    uint64_t received_base = client_->frames_received();
+    std::atomic<bool> keep_running{true};
+    options.keep_running = &keep_running;
+
+    FrameReplayer replayer(*server_);
+    FrameReplayer::Result result;
+    std::atomic<bool> replay_done{false};
+    auto start = Clock::now();
+    std::thread replay_thread([&]() {
+        result = replayer.replay(frames, options);
+        replay_done = true;
+    });
+
+    // Main loop: run queued UI updates, render at most every 33ms (LVGL's default refresh period)
+    std::vector<double> refresh_ms;
+    auto next_refresh = Clock::now();
+    auto deadline = Clock::now() + std::chrono::minutes(30);
+    std::optional<Clock::time_point> caught_up_at;
+    while (Clock::now() < deadline) {
+        if (!caught_up_at && replay_done &&
+            client_->frames_received() - received_base >= result.frames_sent) {
+            caught_up_at = Clock::now();
+        }
+        // The last frames are still being dispatched when the counter catches up
+        if (caught_up_at && Clock::now() - *caught_up_at > std::chrono::milliseconds(100)) {
+            break;
+        }
+        UpdateQueue::instance().wait_for_work(5);
+        UpdateQueueTestAccess::drain(UpdateQueue::instance());
+        if (Clock::now() >= next_refresh) {
+            auto refresh_start = Clock::now();
+            lv_refr_now(nullptr);
+            refresh_ms.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - refresh_start).count());
+            next_refresh = refresh_start + std::chrono::milliseconds(33);
+        }
+    }
+    keep_running = false;
+    replay_thread.join();
+    UpdateQueueTestAccess::drain(UpdateQueue::instance());
+    double elapsed_s =
+        std::chrono::duration<double>(caught_up_at.value_or(Clock::now()) - start).count();
+
+    int64_t rss_end_kb = 0;
+    read_memory_stats(rss_end_kb, hwm_kb);
+    auto queue = UpdateQueue::instance().take_stats();
+    client_->unsubscribe_notify_update(subscription);
+
+    uint64_t parsed = client_->frames_received() - received_base;
+    WARN("replay: " << result.frames_sent << " frames (" << result.bytes_sent / 1024
+                    << " KiB, " << result.frames_skipped << " replies skipped) at speed "
+                    << options.speed << "x in " << elapsed_s << " s");
+    WARN("client: " << parsed / elapsed_s << " frames/s parsed, " << status_frames
+                    << " status frames");
+    WARN("UI queue: " << queue.executed << " run, " << queue.coalesced << " coalesced, latency p50 "
+                      << queue.latency_percentile_us(50) << " us, p95 "
+                      << queue.latency_percentile_us(95) << " us, p99 "
+                      << queue.latency_percentile_us(99) << " us, max "
+                      << queue.latency_max_ns / 1000 << " us");
+    WARN("LVGL refresh: " << refresh_ms.size() << " refreshes, p50 "
+                          << percentile(refresh_ms, 50) << " ms, p95 "
+                          << percentile(refresh_ms, 95) << " ms, max "
+                          << percentile(refresh_ms, 100) << " ms");
+    WARN("RSS: " << rss_start_kb << " KiB -> " << rss_end_kb << " KiB (peak " << hwm_kb
+                 << " KiB)");
+
+    REQUIRE(result.frames_sent > 0);
+    REQUIRE(parsed >= result.frames_sent);
+}
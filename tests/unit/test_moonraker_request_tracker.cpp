@@ -0,0 +1,59 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_moonraker_request_tracker.cpp
+ * @brief Unit tests for request batching policy and latency histograms
+ */
+
+#include "../../include/moonraker_request_tracker.h"
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+using Catch::Approx;
+
+TEST_CASE("MoonrakerRequestTracker: batchable methods", "[moonraker][request_tracker]") {
+    REQUIRE(MoonrakerRequestTracker::is_batchable("server.files.metadata"));
+    REQUIRE(MoonrakerRequestTracker::is_batchable("printer.objects.query"));
+    REQUIRE(MoonrakerRequestTracker::is_batchable("server.spoolman.proxy"));
+
+    // Commands the user is waiting on are never held back
+    REQUIRE_FALSE(MoonrakerRequestTracker::is_batchable("printer.gcode.script"));
+    REQUIRE_FALSE(MoonrakerRequestTracker::is_batchable("printer.emergency_stop"));
+    REQUIRE_FALSE(MoonrakerRequestTracker::is_batchable("printer.print.start"));
+    REQUIRE_FALSE(MoonrakerRequestTracker::is_batchable("printer.firmware_restart"));
+    REQUIRE_FALSE(MoonrakerRequestTracker::is_batchable("machine.reboot"));
+}
+
+TEST_CASE("RequestLatencyHistogram: buckets and percentiles", "[moonraker][request_tracker]") {
+    RequestLatencyHistogram histogram;
+    REQUIRE(histogram.percentile_ms(50) == 0);
+
+    histogram.record(500, false);     // < 1ms
+    histogram.record(1500, false);    // [1, 2)
+    histogram.record(3000, false);    // [2, 4)
+    histogram.record(3500, true);     // [2, 4)
+    histogram.record(900'000, false); // [512, 1024)
+
+    REQUIRE(histogram.count == 5);
+    REQUIRE(histogram.errors == 1);
+    REQUIRE(histogram.buckets[0] == 1);
+    REQUIRE(histogram.buckets[1] == 1);
+    REQUIRE(histogram.buckets[2] == 2);
+    REQUIRE(histogram.buckets[10] == 1);
+    REQUIRE(histogram.max_us == 900'000);
+    REQUIRE(histogram.avg_ms() == Approx(181.7));
+
+    REQUIRE(histogram.percentile_ms(20) == 1);
+    REQUIRE(histogram.percentile_ms(50) == 4);
+    REQUIRE(histogram.percentile_ms(80) == 4);
+    REQUIRE(histogram.percentile_ms(95) == 1024);
+
+    SECTION("the last bucket reports the observed maximum") {
+        RequestLatencyHistogram slow;
+        slow.record(100'000'000, false); // 100s
+        REQUIRE(slow.buckets[RequestLatencyHistogram::BUCKETS - 1] == 1);
+        REQUIRE(slow.percentile_ms(99) == 100'000);
+    }
+}
@@ -0,0 +1,239 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_moonraker_status_decoder.cpp
+ * @brief Unit tests for StatusFrameDecoder (SAX notify_status_update decoding)
+ */
+
+#include "../../include/moonraker_status_decoder.h"
+
+#include <string>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+using Catch::Approx;
+
+namespace {
+
+std::string wrap_status(const std::string& status, double eventtime = 1234.5) {
+    return R"({"jsonrpc": "2.0", "method": "notify_status_update", "params": [)" + status +
+           ", " + std::to_string(eventtime) + "]}";
+}
+
+const char* SAMPLE_STATUS = R"({
+    "extruder": {"temperature": 201.5, "target": 210, "pressure_advance": 0.04},
+    "extruder1": {"temperature": 25.0},
+    "heater_bed": {"temperature": 60.1, "power": 0.5},
+    "toolhead": {"position": [1.5, 2, 3, 4], "homed_axes": "xyz", "print_time": 12.5},
+    "gcode_move": {"homing_origin": [0, 0, 0.12, 0], "speed_factor": 1.5},
+    "print_stats": {"state": "printing", "print_duration": 100, "info": {"current_layer": 3}},
+    "fan": {"speed": 0.5},
+    "motion_report": {"live_position": [1, 2, 3, 4], "live_velocity": 30},
+    "temperature_sensor mcu": {"temperature": 40}
+})";
+
+} // namespace
+
+TEST_CASE("StatusFrameDecoder decodes typed objects", "[moonraker][status_decoder]") {
+    StatusFrameDecoder decoder;
+    StatusFrame frame;
+
+    REQUIRE(decoder.decode(wrap_status(SAMPLE_STATUS), frame));
+
+    REQUIRE(frame.eventtime == Approx(1234.5));
+
+    SECTION("heaters") {
+        REQUIRE(frame.has(StatusFrame::EXTRUDER));
+        REQUIRE(frame.has_extruder(0));
+        REQUIRE(frame.has_extruder(1));
+        REQUIRE_FALSE(frame.has_extruder(2));
+
+        const HeaterSample& ext = frame.extruders[0];
+        REQUIRE(ext.has(HeaterSample::TEMPERATURE));
+        REQUIRE(ext.has(HeaterSample::TARGET));
+        REQUIRE_FALSE(ext.has(HeaterSample::POWER));
+        REQUIRE(ext.temperature == Approx(201.5));
+        REQUIRE(ext.target == Approx(210.0));
+
+        REQUIRE(frame.extruders[1].temperature == Approx(25.0));
+        REQUIRE_FALSE(frame.extruders[1].has(HeaterSample::TARGET));
+
+        REQUIRE(frame.has(StatusFrame::HEATER_BED));
+        REQUIRE(frame.heater_bed.temperature == Approx(60.1));
+        REQUIRE(frame.heater_bed.power == Approx(0.5));
+    }
+
+    SECTION("motion") {
+        REQUIRE(frame.toolhead.has(ToolheadSample::POSITION));
+        REQUIRE(frame.toolhead.position[0] == Approx(1.5));
+        REQUIRE(frame.toolhead.position[3] == Approx(4.0));
+        REQUIRE(frame.toolhead.print_time == Approx(12.5));
+
+        REQUIRE(frame.gcode_move.has(GcodeMoveSample::HOMING_ORIGIN));
+        REQUIRE(frame.gcode_move.homing_origin[2] == Approx(0.12));
+        REQUIRE(frame.gcode_move.speed_factor == Approx(1.5));
+        REQUIRE_FALSE(frame.gcode_move.has(GcodeMoveSample::EXTRUDE_FACTOR));
+
+        REQUIRE(frame.motion_report.has(MotionReportSample::LIVE_VELOCITY));
+        REQUIRE(frame.motion_report.live_velocity == Approx(30.0));
+    }
+
+    SECTION("fan and print stats") {
+        REQUIRE(frame.fan.has(FanSample::SPEED));
+        REQUIRE(frame.fan.speed == Approx(0.5));
+        REQUIRE(frame.print_stats.has(PrintStatsSample::PRINT_DURATION));
+        REQUIRE(frame.print_stats.print_duration == Approx(100.0));
+        REQUIRE_FALSE(frame.has(StatusFrame::VIRTUAL_SDCARD));
+    }
+
+    SECTION("untyped data is kept in other") {
+        REQUIRE(frame.other.is_object());
+        REQUIRE(frame.other["toolhead"]["homed_axes"] == "xyz");
+        REQUIRE(frame.other["extruder"]["pressure_advance"].get<double>() == Approx(0.04));
+        REQUIRE(frame.other["temperature_sensor mcu"]["temperature"] == 40);
+
+        // print_stats is retained whole for PrinterPrintState
+        REQUIRE(frame.other["print_stats"]["state"] == "printing");
+        REQUIRE(frame.other["print_stats"]["print_duration"] == 100);
+        REQUIRE(frame.other["print_stats"]["info"]["current_layer"] == 3);
+
+        // Fully typed objects are not duplicated
+        REQUIRE_FALSE(frame.other.contains("heater_bed"));
+        REQUIRE_FALSE(frame.other.contains("fan"));
+        REQUIRE_FALSE(frame.other["toolhead"].contains("position"));
+    }
+}
+
+TEST_CASE("StatusFrameDecoder rejects other messages", "[moonraker][status_decoder]") {
+    StatusFrameDecoder decoder;
+    StatusFrame frame;
+
+    SECTION("response with id") {
+        std::string msg = R"({"jsonrpc": "2.0", "result": {"status": {}}, "id": 4})";
+        REQUIRE_FALSE(StatusFrameDecoder::is_status_update(msg));
+        REQUIRE_FALSE(decoder.decode(msg, frame));
+    }
+
+    SECTION("other notification") {
+        std::string msg = R"({"jsonrpc": "2.0", "method": "notify_gcode_response",
+                              "params": ["ok"]})";
+        REQUIRE_FALSE(StatusFrameDecoder::is_status_update(msg));
+        REQUIRE_FALSE(decoder.decode(msg, frame));
+    }
+
+    SECTION("truncated frame") {
+        std::string msg =
+            R"({"jsonrpc": "2.0", "method": "notify_status_update", "params": [{"extruder": {"te)";
+        REQUIRE(StatusFrameDecoder::is_status_update(msg));
+        REQUIRE_FALSE(decoder.decode(msg, frame));
+    }
+
+    SECTION("null position is not marked present") {
+        REQUIRE(decoder.decode(wrap_status(R"({"toolhead": {"position": [null, null, null, 0]}})"),
+                               frame));
+        REQUIRE_FALSE(frame.toolhead.has(ToolheadSample::POSITION));
+    }
+}
+
+TEST_CASE("StatusFrameDecoder DOM and SAX paths agree", "[moonraker][status_decoder]") {
+    StatusFrameDecoder decoder;
+    StatusFrame sax;
+    REQUIRE(decoder.decode(wrap_status(SAMPLE_STATUS), sax));
+
+    json status = json::parse(SAMPLE_STATUS);
+
+    SECTION("decode_status") {
+        StatusFrame dom;
+        StatusFrameDecoder::decode_status(status, dom);
+
+        REQUIRE(dom.objects == sax.objects);
+        REQUIRE(dom.extruder_mask == sax.extruder_mask);
+        REQUIRE(dom.extruders[0].temperature == Approx(sax.extruders[0].temperature));
+        REQUIRE(dom.toolhead.fields == sax.toolhead.fields);
+        REQUIRE(dom.gcode_move.fields == sax.gcode_move.fields);
+        REQUIRE(dom.other == sax.other);
+    }
+
+    SECTION("decode_typed leaves other empty") {
+        StatusFrame typed;
+        StatusFrameDecoder::decode_typed(status, typed);
+
+        REQUIRE(typed.objects == sax.objects);
+        REQUIRE(typed.heater_bed.temperature == Approx(sax.heater_bed.temperature));
+        REQUIRE(typed.other.is_null());
+    }
+}
+
+TEST_CASE("StatusFrame extruder naming", "[moonraker][status_decoder]") {
+    REQUIRE(StatusFrame::extruder_index("extruder") == 0);
+    REQUIRE(StatusFrame::extruder_index("extruder1") == 1);
+    REQUIRE(StatusFrame::extruder_index("extruder7") == 7);
+    REQUIRE(StatusFrame::extruder_index("extruder8") == -1);
+    REQUIRE(StatusFrame::extruder_index("extruder_stepper foo") == -1);
+    REQUIRE(StatusFrame::extruder_index("heater_bed") == -1);
+
+    REQUIRE(StatusFrame::extruder_name(0) == "extruder");
+    REQUIRE(StatusFrame::extruder_name(3) == "extruder3");
+}
+
+TEST_CASE("StatusFrame merge folds later frames in", "[moonraker][status_decoder]") {
+    StatusFrame older;
+    StatusFrameDecoder::decode_status(
+        json::parse(R"({"extruder": {"temperature": 200, "target": 210},
+                        "toolhead": {"position": [1, 2, 3, 4], "homed_axes": "xy"},
+                        "webhooks": {"state": "ready", "state_message": "ok"}})"),
+        older);
+    older.eventtime = 1.0;
+
+    StatusFrame newer;
+    StatusFrameDecoder::decode_status(
+        json::parse(R"({"extruder": {"temperature": 205},
+                        "fan": {"speed": 0.3},
+                        "webhooks": {"state_message": "still ok"}})"),
+        newer);
+    newer.eventtime = 2.0;
+
+    REQUIRE(older.merge(newer));
+    REQUIRE(older.eventtime == 2.0);
+    REQUIRE(older.extruders[0].temperature == Approx(205));
+    REQUIRE(older.extruders[0].target == Approx(210)); // Kept from the older frame
+    REQUIRE(older.toolhead.has(ToolheadSample::POSITION));
+    REQUIRE(older.has(StatusFrame::FAN));
+    REQUIRE(older.fan.speed == Approx(0.3));
+    REQUIRE(older.other["toolhead"]["homed_axes"] == "xy");
+    REQUIRE(older.other["webhooks"]["state"] == "ready");
+    REQUIRE(older.other["webhooks"]["state_message"] == "still ok");
+}
+
+TEST_CASE("StatusFrame merge keeps print state transitions apart",
+          "[moonraker][status_decoder]") {
+    StatusFrame printing;
+    StatusFrameDecoder::decode_status(json::parse(R"({"print_stats": {"state": "printing"}})"),
+                                      printing);
+    StatusFrame complete;
+    StatusFrameDecoder::decode_status(json::parse(R"({"print_stats": {"state": "complete"}})"),
+                                      complete);
+    StatusFrame progress;
+    StatusFrameDecoder::decode_status(
+        json::parse(R"({"print_stats": {"print_duration": 12}, "extruder": {"temperature": 1}})"),
+        progress);
+
+    REQUIRE(printing.merge(progress));
+    REQUIRE_FALSE(printing.merge(complete));
+    REQUIRE(printing.other["print_stats"]["state"] == "printing");
+    REQUIRE(printing.print_stats.print_duration == Approx(12));
+}
+
+TEST_CASE("StatusFrameDecoder decode_heater reads any heater object",
+          "[moonraker][status_decoder]") {
+    json chamber = {{"temperature", 35.5}, {"target", 40}, {"state", "on"}};
+    HeaterSample sample = StatusFrameDecoder::decode_heater(chamber);
+    REQUIRE(sample.has(HeaterSample::TEMPERATURE));
+    REQUIRE(sample.temperature == Approx(35.5));
+    REQUIRE(sample.target == Approx(40.0));
+
+    HeaterSample empty = StatusFrameDecoder::decode_heater(json("not an object"));
+    REQUIRE(empty.fields == 0);
+}
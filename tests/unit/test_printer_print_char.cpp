@@ -8,7 +8,7 @@
  * These tests capture the CURRENT behavior of print-related subjects
  * in PrinterState before extraction to a dedicated PrinterPrintState class.
  *
- * Print subjects (17 total):
+ * Print subjects (18 total):
  *
  * Core State (4):
  * - print_state_ (string): "standby", "printing", "paused", "complete", "cancelled", "error"
@@ -21,8 +21,9 @@
  * - print_display_filename_ (string): set via API, cleaned name
  * - print_thumbnail_path_ (string): set via API, LVGL path
  *
- * Progress (2):
+ * Progress (3):
  * - print_progress_ (int 0-100): from virtual_sdcard.progress (float 0.0-1.0)
+ * - print_file_position_version_ (int): bumped when virtual_sdcard.file_position changes
  * - print_show_progress_ (int): derived = print_active && print_start_phase == IDLE
  *
  * Layer Tracking (2):
@@ -391,6 +392,48 @@ TEST_CASE("Print characterization: progress from JSON", "[characterization][prin
     }
 }
 
+TEST_CASE("Print characterization: file position from JSON", "[characterization][print][progress]") {
+    lv_init_safe();
+
+    PrinterState& state = get_printer_state();
+    PrinterStateTestAccess::reset(state);
+    state.init_subjects(false);
+
+    REQUIRE(state.get_print_file_position() == 0);
+    int version = lv_subject_get_int(state.get_print_file_position_version_subject());
+
+    SECTION("file_position is stored in bytes") {
+        json status = {{"virtual_sdcard", {{"file_position", 123456}}}};
+        state.update_from_status(status);
+
+        REQUIRE(state.get_print_file_position() == 123456);
+        REQUIRE(lv_subject_get_int(state.get_print_file_position_version_subject()) ==
+                version + 1);
+
+        // An unchanged position does not notify
+        state.update_from_status(status);
+        REQUIRE(lv_subject_get_int(state.get_print_file_position_version_subject()) ==
+                version + 1);
+    }
+
+    SECTION("positions past 2 GiB are kept exactly") {
+        json status = {{"virtual_sdcard", {{"file_position", 5000000000ULL}}}};
+        state.update_from_status(status);
+
+        REQUIRE(state.get_print_file_position() == 5000000000ULL);
+    }
+
+    SECTION("reset_for_new_print clears file position") {
+        json status = {{"virtual_sdcard", {{"file_position", 4096}}}};
+        state.update_from_status(status);
+        state.reset_for_new_print();
+
+        REQUIRE(state.get_print_file_position() == 0);
+        REQUIRE(lv_subject_get_int(state.get_print_file_position_version_subject()) ==
+                version + 2);
+    }
+}
+
 TEST_CASE("Print characterization: terminal state progress guard",
           "[characterization][print][progress][guard]") {
     lv_init_safe();
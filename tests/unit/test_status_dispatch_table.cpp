@@ -0,0 +1,105 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "moonraker_status_decoder.h"
+#include "status_dispatch_table.h"
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+
+namespace {
+
+StatusConsumerMask bit(StatusConsumer consumer) {
+    return status_consumer_bit(consumer);
+}
+
+} // namespace
+
+// ============================================================================
+// StatusDispatchTable tests
+// ============================================================================
+
+TEST_CASE("StatusDispatchTable: handles", "[status_dispatch][printer_state]") {
+    StatusDispatchTable table({"extruder", "heater_bed", "toolhead", "extruder"});
+
+    REQUIRE(table.size() == 3); // Duplicate ignored
+
+    auto handle = table.handle_of("heater_bed");
+    REQUIRE(handle != StatusDispatchTable::INVALID_HANDLE);
+    REQUIRE(table.name_of(handle) == "heater_bed");
+    REQUIRE(table.consumers_of(handle) == bit(StatusConsumer::TEMPERATURE));
+
+    REQUIRE(table.handle_of("gcode_move") == StatusDispatchTable::INVALID_HANDLE);
+}
+
+TEST_CASE("StatusDispatchTable: classifies core objects", "[status_dispatch][printer_state]") {
+    REQUIRE(StatusDispatchTable::classify("extruder") == bit(StatusConsumer::TEMPERATURE));
+    REQUIRE(StatusDispatchTable::classify("extruder1") == bit(StatusConsumer::TEMPERATURE));
+    REQUIRE(StatusDispatchTable::classify("heater_generic chamber") ==
+            bit(StatusConsumer::TEMPERATURE));
+    REQUIRE(StatusDispatchTable::classify("temperature_sensor mcu_temp") ==
+            (bit(StatusConsumer::TEMPERATURE) | bit(StatusConsumer::TEMPERATURE_SENSORS)));
+
+    REQUIRE(StatusDispatchTable::classify("toolhead") ==
+            (bit(StatusConsumer::MOTION) | bit(StatusConsumer::TOOLHEAD) |
+             bit(StatusConsumer::CALIBRATION)));
+    REQUIRE(StatusDispatchTable::classify("gcode_move") == bit(StatusConsumer::MOTION));
+    REQUIRE(StatusDispatchTable::classify("print_stats") == bit(StatusConsumer::PRINT));
+    REQUIRE(StatusDispatchTable::classify("display_status") == bit(StatusConsumer::PRINT));
+
+    REQUIRE(StatusDispatchTable::classify("fan") == bit(StatusConsumer::FAN));
+    REQUIRE(StatusDispatchTable::classify("heater_fan hotend_fan") == bit(StatusConsumer::FAN));
+
+    REQUIRE(StatusDispatchTable::classify("led_effect rainbow") ==
+            bit(StatusConsumer::LED_CONTROLLER));
+    REQUIRE(StatusDispatchTable::classify("neopixel chamber") ==
+            (bit(StatusConsumer::LED) | bit(StatusConsumer::LED_CONTROLLER)));
+
+    REQUIRE(StatusDispatchTable::classify("exclude_object") ==
+            bit(StatusConsumer::EXCLUDE_OBJECT));
+    REQUIRE(StatusDispatchTable::classify("webhooks") == bit(StatusConsumer::WEBHOOKS));
+    REQUIRE(StatusDispatchTable::classify("stepper_enable") == bit(StatusConsumer::CALIBRATION));
+}
+
+TEST_CASE("StatusDispatchTable: classifies sensor objects", "[status_dispatch][printer_state]") {
+    REQUIRE(StatusDispatchTable::classify("filament_switch_sensor runout") ==
+            bit(StatusConsumer::FILAMENT_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("bme280 chamber") ==
+            bit(StatusConsumer::HUMIDITY_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("hall_filament_width_sensor") ==
+            bit(StatusConsumer::WIDTH_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("probe_eddy_current btt") ==
+            bit(StatusConsumer::PROBE_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("beacon") == bit(StatusConsumer::PROBE_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("adxl345") == bit(StatusConsumer::ACCEL_SENSORS));
+    REQUIRE(StatusDispatchTable::classify("td1_sensor default") ==
+            bit(StatusConsumer::COLOR_SENSORS));
+}
+
+TEST_CASE("StatusDispatchTable: objects outside PrinterState route nowhere",
+          "[status_dispatch][printer_state]") {
+    REQUIRE(StatusDispatchTable::classify("bed_mesh") == 0);
+    REQUIRE(StatusDispatchTable::classify("motion_report") == 0);
+    REQUIRE(StatusDispatchTable::classify("gcode_macro _HELIX_STATE") == 0);
+    REQUIRE(StatusDispatchTable::classify("tool T0") == 0);
+}
+
+TEST_CASE("StatusDispatchTable: unknown objects route everywhere",
+          "[status_dispatch][printer_state]") {
+    REQUIRE(StatusDispatchTable::classify("some_plugin_object") == ALL_STATUS_CONSUMERS);
+
+    StatusDispatchTable table({"extruder"});
+    REQUIRE(table.route("some_plugin_object") == ALL_STATUS_CONSUMERS);
+    // Unsubscribed but known objects still route precisely
+    REQUIRE(table.route("webhooks") == bit(StatusConsumer::WEBHOOKS));
+}
+
+TEST_CASE("StatusDispatchTable: typed frame objects", "[status_dispatch][printer_state]") {
+    REQUIRE(StatusDispatchTable::classify_typed(0) == 0);
+    REQUIRE(StatusDispatchTable::classify_typed(StatusFrame::EXTRUDER) ==
+            bit(StatusConsumer::TEMPERATURE));
+    REQUIRE(StatusDispatchTable::classify_typed(StatusFrame::TOOLHEAD | StatusFrame::FAN) ==
+            (bit(StatusConsumer::MOTION) | bit(StatusConsumer::FAN)));
+    REQUIRE(StatusDispatchTable::classify_typed(StatusFrame::MOTION_REPORT) == 0);
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_status_subscription_manager.cpp
+ * @brief Unit tests for field-level status subscription building
+ */
+
+#include "../../include/app_globals.h"
+#include "../../include/moonraker_client_mock.h"
+#include "../../include/plugin_api.h"
+#include "../../include/status_subscription_manager.h"
+
+#include <algorithm>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix;
+
+namespace {
+
+const std::vector<std::string> DISCOVERED = {"toolhead",
+                                             "gcode_move",
+                                             "extruder",
+                                             "heater_bed",
+                                             "print_stats",
+                                             "motion_report",
+                                             "system_stats",
+                                             "temperature_sensor mcu",
+                                             "fan",
+                                             "heater_fan hotend",
+                                             "exclude_object"};
+
+} // namespace
+
+TEST_CASE("StatusSubscriptionManager: base field policy", "[moonraker][status_subscription]") {
+    auto toolhead = StatusSubscriptionManager::base_fields("toolhead");
+    REQUIRE(toolhead.has_value());
+    REQUIRE(std::find(toolhead->begin(), toolhead->end(), "homed_axes") != toolhead->end());
+    REQUIRE(std::find(toolhead->begin(), toolhead->end(), "position") == toolhead->end());
+
+    REQUIRE(StatusSubscriptionManager::base_fields("extruder1") ==
+            std::vector<std::string>{"temperature", "target"});
+    REQUIRE(StatusSubscriptionManager::base_fields("fan_generic aux") ==
+            std::vector<std::string>{"speed"});
+
+    // Unread objects are dropped, unknown objects keep every field
+    REQUIRE(StatusSubscriptionManager::base_fields("motion_report")->empty());
+    REQUIRE_FALSE(StatusSubscriptionManager::base_fields("print_stats").has_value());
+    REQUIRE_FALSE(StatusSubscriptionManager::base_fields("some_plugin_object").has_value());
+}
+
+TEST_CASE("StatusSubscriptionManager: builds field lists", "[moonraker][status_subscription]") {
+    MoonrakerClientMock client(MoonrakerClientMock::PrinterType::VORON_24);
+    auto& manager = client.status_subscriptions();
+
+    json objects = manager.begin_subscription(DISCOVERED);
+
+    REQUIRE(objects["print_stats"].is_null());
+    REQUIRE(objects["exclude_object"].is_null());
+    REQUIRE(objects["extruder"] == json::array({"target", "temperature"}));
+    REQUIRE(objects["temperature_sensor mcu"] == json::array({"temperature"}));
+    REQUIRE(objects["heater_fan hotend"] == json::array({"speed"}));
+    REQUIRE_FALSE(objects.contains("motion_report"));
+    REQUIRE_FALSE(objects.contains("system_stats"));
+    REQUIRE(objects.size() == DISCOVERED.size() - 2);
+
+    SECTION("owner fields are merged while registered") {
+        int motion_panel = 0;
+        manager.set_owner_fields(&motion_panel,
+                                 {{"toolhead", {"position"}}, {"gcode_move", {"gcode_position"}}});
+
+        json merged = manager.build_objects();
+        REQUIRE(merged["toolhead"] ==
+                json::array({"extruder", "homed_axes", "kinematics", "position"}));
+        REQUIRE(merged["gcode_move"] == json::array({"extrude_factor", "gcode_position",
+                                                     "homing_origin", "speed_factor"}));
+
+        manager.clear_owner(&motion_panel);
+        REQUIRE(manager.build_objects() == objects);
+    }
+
+    SECTION("empty owner list requests every field") {
+        int owner = 0;
+        manager.set_owner_fields(&owner, {{"motion_report", {}}, {"extruder", {}}});
+
+        json merged = manager.build_objects();
+        REQUIRE(merged.contains("motion_report"));
+        REQUIRE(merged["motion_report"].is_null());
+        REQUIRE(merged["extruder"].is_null());
+    }
+
+    SECTION("objects outside the discovered list are ignored") {
+        int owner = 0;
+        manager.set_owner_fields(&owner, {{"heater_generic chamber", {"power"}}});
+        REQUIRE_FALSE(manager.build_objects().contains("heater_generic chamber"));
+    }
+}
+
+TEST_CASE("StatusSubscriptionManager: owners registered before discovery",
+          "[moonraker][status_subscription]") {
+    MoonrakerClientMock client(MoonrakerClientMock::PrinterType::VORON_24);
+    auto& manager = client.status_subscriptions();
+
+    int controls_panel = 0;
+    manager.set_owner_fields(&controls_panel, {{"gcode_move", {"gcode_position"}}});
+
+    json objects = manager.begin_subscription(DISCOVERED);
+    const auto& gcode_move = objects["gcode_move"];
+    REQUIRE(std::find(gcode_move.begin(), gcode_move.end(), "gcode_position") != gcode_move.end());
+}
+
+TEST_CASE("StatusSubscriptionManager: plugin subscriptions request all fields",
+          "[moonraker][status_subscription][plugin]") {
+    MoonrakerClientMock client(MoonrakerClientMock::PrinterType::VORON_24);
+    auto& manager = client.status_subscriptions();
+    json objects = manager.begin_subscription(DISCOVERED);
+
+    SECTION("immediate subscription") {
+        helix::plugin::PluginAPI api(nullptr, &client, get_printer_state(), nullptr, "test");
+        auto id = api.subscribe_moonraker({"toolhead", "motion_report"}, [](const json&) {});
+
+        json merged = manager.build_objects();
+        REQUIRE(merged["toolhead"].is_null());
+        REQUIRE(merged.contains("motion_report"));
+        REQUIRE(merged["motion_report"].is_null());
+        REQUIRE(merged["extruder"] == objects["extruder"]);
+
+        REQUIRE(api.unsubscribe_moonraker(id));
+        REQUIRE(manager.build_objects() == objects);
+    }
+
+    SECTION("deferred subscription is released on cleanup") {
+        helix::plugin::PluginAPI api(nullptr, nullptr, get_printer_state(), nullptr, "test");
+        api.subscribe_moonraker({"heater_bed"}, [](const json&) {});
+        REQUIRE(manager.build_objects() == objects);
+
+        api.set_moonraker(nullptr, &client);
+        api.apply_deferred_subscriptions();
+        REQUIRE(manager.build_objects()["heater_bed"].is_null());
+
+        api.cleanup();
+        REQUIRE(manager.build_objects() == objects);
+    }
+}
@@ -0,0 +1,334 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_ui_callback_queue.cpp
+ * @brief Unit tests for the lock-free MPSC queue behind helix::ui::UpdateQueue
+ */
+
+#include "../../include/ui_callback_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::ui;
+
+// ============================================================================
+// SmallCallback
+// ============================================================================
+
+TEST_CASE("SmallCallback: small captures are stored inline", "[ui][update_queue]") {
+    int calls = 0;
+    std::string text = "hello";
+    SmallCallback callback([&calls, text]() { calls += static_cast<int>(text.size()); });
+
+    REQUIRE(callback);
+    REQUIRE(callback.is_inline());
+    callback();
+    REQUIRE(calls == 5);
+
+    SmallCallback moved(std::move(callback));
+    REQUIRE_FALSE(callback);
+    moved();
+    REQUIRE(calls == 10);
+}
+
+TEST_CASE("SmallCallback: large captures fall back to the heap", "[ui][update_queue]") {
+    std::array<char, 128> big{};
+    big[0] = 7;
+    int result = 0;
+    SmallCallback callback([big, &result]() { result = big[0]; });
+
+    REQUIRE_FALSE(callback.is_inline());
+    SmallCallback moved = std::move(callback);
+    moved();
+    REQUIRE(result == 7);
+}
+
+TEST_CASE("SmallCallback: move-only captures and destruction", "[ui][update_queue]") {
+    auto token = std::make_shared<int>(1);
+    std::weak_ptr<int> weak = token;
+    {
+        auto owned = std::make_unique<std::shared_ptr<int>>(std::move(token));
+        SmallCallback callback([owned = std::move(owned)]() {});
+        REQUIRE_FALSE(weak.expired());
+    }
+    REQUIRE(weak.expired());
+}
+
+// ============================================================================
+// CallbackQueue
+// ============================================================================
+
+TEST_CASE("CallbackQueue: executes in FIFO order", "[ui][update_queue]") {
+    CallbackQueue<8> queue;
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(queue.push([&order, i]() { order.push_back(i); }));
+    }
+    REQUIRE(queue.has_pending());
+
+    REQUIRE(queue.pop_batch([](SmallCallback& callback) { callback(); }) == 5);
+    REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE_FALSE(queue.has_pending());
+}
+
+TEST_CASE("CallbackQueue: overflow keeps submission order", "[ui][update_queue]") {
+    CallbackQueue<4> queue;
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {
+        queue.push([&order, i]() { order.push_back(i); });
+    }
+
+    auto stats = queue.take_stats();
+    REQUIRE(stats.enqueued == 10);
+    REQUIRE(stats.overflowed == 6);
+    REQUIRE(stats.depth == 10);
+    REQUIRE(stats.max_depth == 10);
+
+    queue.pop_batch([](SmallCallback& callback) { callback(); });
+    REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+    // Ring is used again once the overflow has been drained
+    REQUIRE(queue.push([]() {}));
+}
+
+TEST_CASE("CallbackQueue: callbacks queued during a batch run next batch", "[ui][update_queue]") {
+    CallbackQueue<8> queue;
+    int runs = 0;
+    std::function<void()> requeue = [&]() {
+        ++runs;
+        queue.push([&]() { requeue(); });
+    };
+    queue.push([&]() { requeue(); });
+
+    REQUIRE(queue.pop_batch([](SmallCallback& callback) { callback(); }) == 1);
+    REQUIRE(runs == 1);
+    REQUIRE(queue.has_pending());
+    REQUIRE(queue.pop_batch([](SmallCallback& callback) { callback(); }) == 1);
+    REQUIRE(runs == 2);
+
+    queue.discard();
+}
+
+TEST_CASE("CallbackQueue: discard counts drops", "[ui][update_queue]") {
+    CallbackQueue<4> queue;
+    int runs = 0;
+    for (int i = 0; i < 6; ++i) {
+        queue.push([&runs]() { ++runs; });
+    }
+    queue.note_dropped();
+
+    REQUIRE(queue.discard() == 6);
+    REQUIRE(runs == 0);
+
+    auto stats = queue.take_stats();
+    REQUIRE(stats.dropped == 7);
+    REQUIRE(stats.executed == 0);
+    REQUIRE(stats.depth == 0);
+}
+
+TEST_CASE("CallbackQueue: concurrent producers keep per-producer order", "[ui][update_queue]") {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 5000;
+
+    CallbackQueue<64> queue; // Small ring so the overflow path is exercised
+    std::array<int, PRODUCERS> next{};
+    bool in_order = true;
+    int executed = 0;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push([&, p, i]() {
+                    in_order = in_order && next[p] == i;
+                    next[p] = i + 1;
+                    ++executed;
+                });
+            }
+        });
+    }
+
+    while (executed < PRODUCERS * PER_PRODUCER) {
+        if (queue.pop_batch([](SmallCallback& callback) { callback(); }) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    REQUIRE(in_order);
+    REQUIRE_FALSE(queue.has_pending());
+
+    auto stats = queue.take_stats();
+    REQUIRE(stats.enqueued == PRODUCERS * PER_PRODUCER);
+    REQUIRE(stats.executed == PRODUCERS * PER_PRODUCER);
+    REQUIRE(stats.latency_samples > 0);
+    REQUIRE(stats.latency_max_ns >= stats.latency_total_ns / stats.latency_samples);
+
+    uint64_t bucketed = 0;
+    for (uint64_t count : stats.latency_buckets) {
+        bucketed += count;
+    }
+    REQUIRE(bucketed == stats.latency_samples);
+    REQUIRE(stats.latency_percentile_us(50) <= stats.latency_percentile_us(99));
+}
+
+TEST_CASE("CallbackQueueStats: latency percentiles", "[ui][update_queue]") {
+    CallbackQueueStats stats;
+    REQUIRE(stats.latency_percentile_us(50) == 0);
+
+    // 0.5us, 3us, 3us, 100us
+    for (uint64_t ns : {500u, 3000u, 3000u, 100000u}) {
+        stats.latency_buckets[CallbackQueueStats::latency_bucket(ns)]++;
+        stats.latency_samples++;
+        stats.latency_max_ns = std::max<uint64_t>(stats.latency_max_ns, ns);
+    }
+    REQUIRE(CallbackQueueStats::latency_bucket(0) == 0);
+    REQUIRE(CallbackQueueStats::latency_bucket(1000) == 1);
+    REQUIRE(CallbackQueueStats::latency_bucket(uint64_t{1} << 62) ==
+            CallbackQueueStats::LATENCY_BUCKETS - 1);
+
+    REQUIRE(stats.latency_percentile_us(25) == 1);
+    REQUIRE(stats.latency_percentile_us(50) == 4);
+    REQUIRE(stats.latency_percentile_us(75) == 4);
+    REQUIRE(stats.latency_percentile_us(99) == 128);
+}
+
+// ============================================================================
+// Benchmark: mutex + std::queue<std::function> vs CallbackQueue
+// ============================================================================
+
+namespace {
+
+/// The previous UpdateQueue storage
+class MutexFunctionQueue {
+  public:
+    void push(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push(std::move(callback));
+    }
+
+    size_t pop_batch() {
+        std::queue<std::function<void()>> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(batch, pending_);
+        }
+        size_t count = batch.size();
+        while (!batch.empty()) {
+            batch.front()();
+            batch.pop();
+        }
+        return count;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::queue<std::function<void()>> pending_;
+};
+
+template <typename Push, typename Pop>
+double run_producers(int producers, int per_producer, Push&& push, Pop&& pop) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                push(p, i);
+            }
+        });
+    }
+
+    size_t total = static_cast<size_t>(producers) * per_producer;
+    size_t done = 0;
+    while (done < total) {
+        size_t popped = pop();
+        if (popped == 0) {
+            std::this_thread::yield();
+        }
+        done += popped;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+} // namespace
+
+TEST_CASE("UpdateQueue storage: ring vs mutex queue", "[ui][update_queue][.benchmark]") {
+    // Typical capture: a value, a pointer and a string
+    std::atomic<uint64_t> sink{0};
+    std::string label = "extruder_temp";
+
+    MutexFunctionQueue legacy;
+    CallbackQueue<1024> ring;
+    auto legacy_push = [&](int p, int i) {
+        legacy.push([&sink, p, i, label]() { sink += p + i + label.size(); });
+    };
+    auto ring_push = [&](int p, int i) {
+        ring.push([&sink, p, i, label]() { sink += p + i + label.size(); });
+    };
+    auto legacy_pop = [&]() { return legacy.pop_batch(); };
+    auto ring_pop = [&]() {
+        return ring.pop_batch([](SmallCallback& callback) { callback(); });
+    };
+
+    SECTION("frame-sized bursts") {
+        // One producer queues a burst, the main loop drains it: the steady-state UI pattern
+        constexpr int ROUNDS = 20000;
+        constexpr int BURST = 64;
+        auto run = [&](auto& push, auto& pop) {
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < ROUNDS; ++r) {
+                for (int i = 0; i < BURST; ++i) {
+                    push(0, i);
+                }
+                pop();
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * BURST);
+        };
+
+        double legacy_ns = run(legacy_push, legacy_pop);
+        double ring_ns = run(ring_push, ring_pop);
+        auto stats = ring.take_stats();
+
+        WARN("burst: mutex + std::function " << legacy_ns << " ns/update, lock-free ring "
+                                             << ring_ns << " ns/update, overflowed "
+                                             << stats.overflowed);
+        REQUIRE(stats.overflowed == 0);
+        REQUIRE(stats.executed == static_cast<uint64_t>(ROUNDS) * BURST);
+    }
+
+    SECTION("saturating producers") {
+        constexpr int PRODUCERS = 4;
+        constexpr int PER_PRODUCER = 200000;
+
+        double legacy_ms = run_producers(PRODUCERS, PER_PRODUCER, legacy_push, legacy_pop);
+        double ring_ms = run_producers(PRODUCERS, PER_PRODUCER, ring_push, ring_pop);
+        auto stats = ring.take_stats();
+
+        double total = static_cast<double>(PRODUCERS) * PER_PRODUCER;
+        WARN("saturated: mutex + std::function " << legacy_ms << " ms, lock-free ring " << ring_ms
+                                                 << " ms (" << total / ring_ms / 1000.0 << " M/s)");
+        WARN("ring overflowed " << stats.overflowed << ", max depth " << stats.max_depth
+                                << ", avg latency " << stats.latency_avg_us() << " us");
+        REQUIRE(stats.executed == static_cast<uint64_t>(total));
+    }
+}
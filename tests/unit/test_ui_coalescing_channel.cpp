@@ -0,0 +1,132 @@
+// Copyright (C) 2025-2026 356C LLC
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/**
+ * @file test_ui_coalescing_channel.cpp
+ * @brief Unit tests for keyed "latest value wins" UI updates
+ */
+
+#include "../../include/ui_coalescing_channel.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch_amalgamated.hpp"
+
+using namespace helix::ui;
+
+namespace {
+
+/// Channel feeding a plain CallbackQueue, as UpdateQueue does
+struct ChannelFixture {
+    CallbackQueue<64> queue;
+    CoalescingChannel channel{[this](SmallCallback drain) { queue.push(std::move(drain)); }};
+
+    size_t drain() {
+        return queue.pop_batch([](SmallCallback& callback) { callback(); });
+    }
+};
+
+} // namespace
+
+TEST_CASE("CoalescingChannel: only the newest update per key runs", "[ui][update_queue]") {
+    ChannelFixture f;
+    std::vector<int> seen;
+    for (int i = 0; i < 5; ++i) {
+        f.channel.post("status", [&seen, i]() { seen.push_back(i); });
+    }
+
+    REQUIRE(f.drain() == 1);
+    REQUIRE(seen == std::vector<int>{4});
+    REQUIRE(f.channel.take_coalesced() == 4);
+    REQUIRE(f.channel.take_coalesced() == 0);
+    REQUIRE_FALSE(f.channel.has_pending());
+}
+
+TEST_CASE("CoalescingChannel: keys are independent", "[ui][update_queue]") {
+    ChannelFixture f;
+    std::vector<std::string> seen;
+    f.channel.post("ams:sync:0", [&seen]() { seen.push_back("ams0-old"); });
+    f.channel.post("print_media:thumbnail", [&seen]() { seen.push_back("thumb"); });
+    f.channel.post("ams:sync:0", [&seen]() { seen.push_back("ams0-new"); });
+
+    // Each key runs at the position of its first post
+    f.drain();
+    REQUIRE(seen == std::vector<std::string>{"ams0-new", "thumb"});
+}
+
+TEST_CASE("CoalescingChannel: posts after a run schedule again", "[ui][update_queue]") {
+    ChannelFixture f;
+    int runs = 0;
+    f.channel.post("status", [&runs]() { ++runs; });
+    f.drain();
+    f.channel.post("status", [&runs]() { ++runs; });
+    REQUIRE(f.queue.has_pending());
+    f.drain();
+    REQUIRE(runs == 2);
+
+    SECTION("a callback re-posting its own key runs on the next drain") {
+        std::function<void()> again = [&]() {
+            ++runs;
+            f.channel.post("status", [&]() { ++runs; });
+        };
+        f.channel.post("status", again);
+        REQUIRE(f.drain() == 1);
+        REQUIRE(runs == 3);
+        REQUIRE(f.drain() == 1);
+        REQUIRE(runs == 4);
+    }
+}
+
+TEST_CASE("CoalescingChannel: discard drops pending updates", "[ui][update_queue]") {
+    ChannelFixture f;
+    int runs = 0;
+    f.channel.post("a", [&runs]() { ++runs; });
+    f.channel.post("b", [&runs]() { ++runs; });
+
+    REQUIRE(f.channel.discard() == 2);
+    f.drain(); // Drain callbacks still queued find nothing
+    REQUIRE(runs == 0);
+
+    // Keys are usable again after a discard
+    f.channel.post("a", [&runs]() { ++runs; });
+    f.drain();
+    REQUIRE(runs == 1);
+}
+
+TEST_CASE("CoalescingChannel: concurrent producers deliver the final value",
+          "[ui][update_queue]") {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 5000;
+
+    ChannelFixture f;
+    std::vector<int> last(PRODUCERS, -1);
+    std::atomic<int> finished{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            std::string key = "producer:" + std::to_string(p);
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                f.channel.post(key, [&last, p, i]() { last[p] = i; });
+            }
+            finished++;
+        });
+    }
+
+    while (finished.load() < PRODUCERS) {
+        if (f.drain() == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    f.drain();
+
+    for (int p = 0; p < PRODUCERS; ++p) {
+        REQUIRE(last[p] == PER_PRODUCER - 1);
+    }
+    REQUIRE_FALSE(f.channel.has_pending());
+}